@@ -12,6 +12,124 @@ import numpy
 
 import freud
 
+try:
+    import resource
+except ImportError:
+    # The resource module is not available on Windows.
+    resource = None
+
+
+def get_thread_counts():
+    """Get the numbers of threads of the thread scaling benchmarks.
+
+    The numbers of threads are read from the comma separated list in the
+    :code:`BENCHMARK_THREADS` environment variable if it is set. Otherwise,
+    they are every :code:`BENCHMARK_NPROC_INCREMENT`-th number of threads up
+    to :code:`BENCHMARK_NPROC` if the increment is set, and else the powers
+    of two up to :code:`BENCHMARK_NPROC` followed by :code:`BENCHMARK_NPROC`
+    itself. :code:`BENCHMARK_NPROC` defaults to the number of CPUs.
+
+    Returns:
+        list of int: Sorted numbers of threads.
+    """
+    if "BENCHMARK_THREADS" in os.environ:
+        threads = os.environ["BENCHMARK_THREADS"].split(",")
+        return sorted({int(n) for n in threads})
+
+    nprocs = int(os.environ.get("BENCHMARK_NPROC", multiprocessing.cpu_count()))
+    if "BENCHMARK_NPROC_INCREMENT" in os.environ:
+        nproc_increment = int(os.environ["BENCHMARK_NPROC_INCREMENT"])
+        return list(range(1, nprocs + 1, nproc_increment))
+
+    thread_counts = []
+    n = 1
+    while n < nprocs:
+        thread_counts.append(n)
+        n *= 2
+    thread_counts.append(nprocs)
+    return thread_counts
+
+
+def reset_peak_memory():
+    """Reset the high-water mark of the resident memory of this process.
+
+    This is only supported on Linux. On other platforms, the high-water mark
+    is that of the whole lifetime of the process.
+    """
+    try:
+        with open("/proc/self/clear_refs", "w") as f:
+            f.write("5")
+    except OSError:
+        pass
+
+
+def get_peak_memory():
+    """Get the high-water mark of the resident memory of this process.
+
+    Returns:
+        float: The high-water mark in MiB, or :code:`None` if it is unknown.
+    """
+    try:
+        with open("/proc/self/status") as f:
+            for line in f:
+                if line.startswith("VmHWM:"):
+                    return int(line.split()[1]) / 1024
+    except OSError:
+        pass
+    if resource is None:
+        return None
+    max_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # The maximum resident set size is in bytes on macOS and in KiB elsewhere.
+    return max_rss / 2**20 if sys.platform == "darwin" else max_rss / 1024
+
+
+def parallel_efficiency(thread_counts, times, weak=False):
+    """Compute the parallel efficiencies of a thread scaling benchmark.
+
+    Args:
+        thread_counts (list of int):
+            Numbers of threads of the runs.
+        times (list of float):
+            Runtimes with each number of threads.
+        weak (bool):
+            Whether the work grows with the number of threads
+            (Default value = :code:`False`).
+
+    Returns:
+        list of float: The speedups relative to the first run divided by the
+            ratios of the numbers of threads for strong scaling, or the
+            runtime of the first run divided by the runtimes for weak scaling.
+    """
+    if weak:
+        return [times[0] / t for t in times]
+    return [
+        times[0] / t * thread_counts[0] / n for n, t in zip(thread_counts, times)
+    ]
+
+
+def scaling_limit(thread_counts, efficiencies, threshold=0.5):
+    """Find the number of threads up to which a compute scales.
+
+    Args:
+        thread_counts (list of int):
+            Numbers of threads of the runs.
+        efficiencies (list of float):
+            Parallel efficiencies of the runs, see
+            :func:`parallel_efficiency`.
+        threshold (float):
+            Minimum parallel efficiency (Default value = 0.5).
+
+    Returns:
+        int: The largest number of threads before the first number of
+            threads whose efficiency is below the threshold.
+    """
+    limit = thread_counts[0]
+    for n, efficiency in zip(thread_counts, efficiencies):
+        if efficiency < threshold:
+            break
+        limit = n
+    return limit
+
 
 class Benchmark:
     """The freud Benchmark class for running benchmarks and showing results.
@@ -38,6 +156,8 @@ class Benchmark:
         """
         self._N = None
         self._t = 0
+        self._samples = []
+        self._peak_memory = None
 
     def bench_setup(self, N):
         """Setup function for benchmark.
@@ -113,23 +233,42 @@ class Benchmark:
                 (Default value = 0).
 
         Returns:
-            float: The minimum time out of :code:`repeat` many calls to
+            float: The median time out of :code:`repeat` many calls to
                 :py:meth:`~.bench_run`.
         """
         # Initialize timer
         timer = self.setup_timer(N, num_threads)
 
         # Run benchmark
-        t = numpy.median(timer.repeat(repeat, number))
+        reset_peak_memory()
+        samples = [t / number for t in timer.repeat(repeat, number)]
 
         # Save results for later summarization
         self._N = N
-        self._t = t / number
+        self._t = numpy.median(samples)
+        self._samples = samples
+        self._peak_memory = get_peak_memory()
         if print_stats:
             self.print_stats()
 
         return self._t
 
+    def get_measurement(self):
+        """Get the results of the last benchmark run.
+
+        Returns:
+            dict: The median time per call of :py:meth:`~.bench_run` in
+                seconds (:code:`"time"`), the times per call of each repeat
+                (:code:`"samples"`) and the high-water mark of the resident
+                memory of the process in MiB during the run, including its
+                setup (:code:`"peak_memory"`).
+        """
+        return {
+            "time": self._t,
+            "samples": self._samples,
+            "peak_memory": self._peak_memory,
+        }
+
     def print_stats(self):
         """Print statistics from the last benchmark run.
 
@@ -208,12 +347,21 @@ class Benchmark:
         return results
 
     def run_thread_scaling_benchmark(
-        self, N_list, number=1000, print_stats=True, repeat=1
+        self,
+        N_list,
+        number=1000,
+        print_stats=True,
+        repeat=1,
+        thread_counts=None,
+        weak=False,
     ):
         """Thread scaling benchmark.
 
-        The size scaling benchmark autoscales number down linearly with problem
-        size (down to a minimum of 1).
+        For strong scaling, each problem size is run with every number of
+        threads. For weak scaling, each problem size is the size per thread,
+        i.e. the benchmark is run with :math:`N` times the number of threads.
+        The number of calls autoscales down linearly with the problem size
+        (down to a minimum of 1).
 
         Args:
             N_list (list of ints):
@@ -226,52 +374,64 @@ class Benchmark:
             repeat (int):
                 Number of times to repeat time measurement of
                 :py:meth:`~.bench_run` (Default value = 1).
+            thread_counts (list of ints):
+                Numbers of threads to run, or :code:`None` for
+                :func:`get_thread_counts` (Default value = :code:`None`).
+            weak (bool):
+                Whether to run a weak scaling benchmark
+                (Default value = :code:`False`).
 
         Returns:
-            :math:`(N_{cores}, len(N_{list}))` :class:`numpy.ndarray`:
-                All the per iteration timings with respect to the number of
-                cores used (in seconds).
-        """  # noqa: E501
+            list of list of dict: For each number of threads, the
+                measurements of each problem size, see
+                :py:meth:`~.get_measurement`.
+        """
         if len(N_list) == 0:
             raise TypeError("N_list must be iterable")
+        if thread_counts is None:
+            thread_counts = get_thread_counts()
 
         # compute benchmark size
         size = number * N_list[0]
 
         # print the header
         if print_stats:
+            print("Weak scaling" if weak else "Strong scaling")
             print("Threads ", end="")
             for N in N_list:
-                print(f"{N:^22d}", end=" | ")
+                print(f"{N:^32d}", end=" | ")
             print()
 
-        nproc_increment = int(os.environ.get("BENCHMARK_NPROC_INCREMENT", 1))
-        nprocs = int(os.environ.get("BENCHMARK_NPROC", multiprocessing.cpu_count()))
-
-        # loop over the cores
-        times = numpy.zeros(shape=(nprocs + 1, len(N_list)))
-
-        for ncores in range(1, nprocs + 1, nproc_increment):
+        measurements = []
+        for ncores in thread_counts:
             if print_stats:
                 print(f"{ncores:7d}", end=" ")
 
             # Loop over N and run the benchmarks
+            measurements.append([])
             for j, N in enumerate(N_list):
-                current_number = max(int(size // N), 1)
+                N_run = N * ncores if weak else N
+                current_number = max(int(size // N_run), 1)
 
                 with freud.parallel.NumThreads(ncores):
-                    times[ncores, j] = self.run_benchmark(
-                        N,
+                    self.run_benchmark(
+                        N_run,
                         number=current_number,
                         print_stats=False,
                         repeat=repeat,
                         num_threads=ncores,
                     )
+                measurements[-1].append(self.get_measurement())
 
                 if print_stats:
-                    speedup = times[1, j] / times[ncores, j]
+                    times = [m[j]["time"] for m in measurements]
+                    efficiency = parallel_efficiency(
+                        thread_counts[: len(times)], times, weak
+                    )[-1]
+                    peak_memory = self._peak_memory or 0
                     print(
-                        f"{times[ncores, j] * 1000:8.3f} ms {speedup:9.2f}x",
+                        f"{self._t * 1000:8.3f} ms {efficiency:6.1%} "
+                        f"{peak_memory:8.1f} MiB",
                         end=" | ",
                     )
                     sys.stdout.flush()
@@ -279,4 +439,4 @@ class Benchmark:
             if print_stats:
                 print()
 
-        return times
+        return measurements
@@ -0,0 +1,40 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import subprocess
+import sys
+
+from benchmark import Benchmark
+from benchmarker import run_benchmarks
+
+
+class BenchmarkImport(Benchmark):
+    """Time the import of a module in a new interpreter, including its startup."""
+
+    def __init__(self, module):
+        self.module = module
+
+    def bench_run(self, N):
+        for _ in range(N):
+            subprocess.run([sys.executable, "-c", f"import {self.module}"], check=True)
+
+
+def run():
+    Ns = [1]
+    number = 20
+
+    # Workers that only need neighbor queries import freud.locality, which
+    # must not load the other compiled modules.
+    name = "import"
+    return run_benchmarks(
+        name,
+        Ns,
+        number,
+        BenchmarkImport,
+        thread_scaling=False,
+        module="freud.locality",
+    )
+
+
+if __name__ == "__main__":
+    run()
@@ -8,6 +8,8 @@ import os
 import sys
 
 import git
+import numpy as np
+from benchmark import get_thread_counts, parallel_efficiency, scaling_limit
 
 
 def get_report_filename(filename):
@@ -59,7 +61,9 @@ def benchmark_desc(name, params):
     return s
 
 
-def run_benchmarks(name, Ns, number, classobj, print_stats=True, **kwargs):
+def run_benchmarks(
+    name, Ns, number, classobj, print_stats=True, thread_scaling=True, **kwargs
+):
     """Function to run benchmark.
 
     Args:
@@ -68,6 +72,7 @@ def run_benchmarks(name, Ns, number, classobj, print_stats=True, **kwargs):
         number (int): Number of times to run to measure the time.
         classobj (Benchmark): Benchmark class to run benchmark.
         print_stats (bool): Print stats if true.
+        thread_scaling (bool): Run the thread scaling benchmarks if true.
         **kwargs: Initializer variables for classobj.
 
     Returns:
@@ -92,18 +97,34 @@ def run_benchmarks(name, Ns, number, classobj, print_stats=True, **kwargs):
     # run benchmark with repeat
     repeat = 5
     ssr = b.run_size_scaling_benchmark(Ns, number, print_stats, repeat)
-    tsr = b.run_thread_scaling_benchmark(Ns, number, print_stats, repeat)
-
-    if print_stats:
-        print("\n ----------------")
-
-    return {
+    result = {
         "name": name,
         "params": kwargs,
         "Ns": Ns,
         "size_scale": {N: r for N, r in zip(Ns, ssr)},
-        "thread_scale": tsr.tolist(),
     }
+    if not thread_scaling:
+        if print_stats:
+            print("\n ----------------")
+        return result
+
+    thread_counts = get_thread_counts()
+    result["threads"] = thread_counts
+    result["strong_scale"] = b.run_thread_scaling_benchmark(
+        Ns, number, print_stats, repeat, thread_counts
+    )
+
+    # The smallest size is the size per thread of the weak scaling benchmark,
+    # since the largest run has that many times the number of threads.
+    if os.environ.get("BENCHMARK_WEAK_SCALING", "1") != "0":
+        result["weak_scale"] = b.run_thread_scaling_benchmark(
+            Ns[:1], number, print_stats, repeat, thread_counts, weak=True
+        )
+
+    if print_stats:
+        print("\n ----------------")
+
+    return result
 
 
 def main_report(args):
@@ -151,7 +172,25 @@ def print_benchmark_results_in_human_readable_way(data):
                 )
             )
 
-        # print thread scaling benchmark
+        if "strong_scale" in bresult:
+            print_scaling_results(
+                "Strong scaling",
+                bresult["threads"],
+                bresult["Ns"],
+                bresult["strong_scale"],
+            )
+        if "weak_scale" in bresult:
+            print_scaling_results(
+                "Weak scaling",
+                bresult["threads"],
+                bresult["Ns"][:1],
+                bresult["weak_scale"],
+                weak=True,
+            )
+        if "thread_scale" not in bresult:
+            continue
+
+        # print thread scaling benchmark of reports without measurements
         print("Threads ", end="")
         for N in bresult["Ns"]:
             print(f"{N:10d}", end=" | ")
@@ -166,6 +205,76 @@ def print_benchmark_results_in_human_readable_way(data):
             print()
 
 
+def print_scaling_results(title, thread_counts, Ns, measurements, weak=False):
+    """Helper function to print a thread scaling benchmark nicely.
+
+    Args:
+        title (str): Title of the benchmark.
+        thread_counts (list of int): Numbers of threads of the runs.
+        Ns (list of int): Problem sizes, per thread for weak scaling.
+        measurements (list of list of dict): Measurements of each number of
+            threads and problem size.
+        weak (bool): Whether the benchmark is a weak scaling benchmark.
+
+    Returns:
+        None.
+
+    """
+    efficiencies = [
+        parallel_efficiency(
+            thread_counts, [m[j]["time"] for m in measurements], weak
+        )
+        for j in range(len(Ns))
+    ]
+    print(title)
+    print("Threads ", end="")
+    for N in Ns:
+        print(f"{N:^32d}", end=" | ")
+    print()
+    for i, ncores in enumerate(thread_counts):
+        print(f"{ncores:7d}", end=" ")
+        for j in range(len(Ns)):
+            measurement = measurements[i][j]
+            peak_memory = measurement["peak_memory"] or 0
+            print(
+                "{:8.3f} ms {:6.1%} {:8.1f} MiB".format(
+                    measurement["time"] / 1e-3, efficiencies[j][i], peak_memory
+                ),
+                end=" | ",
+            )
+        print()
+    # Runs scale up to the last number of threads with 50% efficiency.
+    print("Limit  ", end=" ")
+    for j in range(len(Ns)):
+        limit = scaling_limit(thread_counts, efficiencies[j])
+        print("{:^31}".format(f"{limit} threads"), end=" | ")
+    print()
+
+
+def welch_p_value(this_samples, other_samples):
+    """Function to test whether two sets of runtimes differ.
+
+    Args:
+        this_samples (list of float): Runtimes of one revision.
+        other_samples (list of float): Runtimes of the other revision.
+
+    Returns:
+        float: The p-value of Welch's t-test of the logarithms of the
+            runtimes, or :code:`None` with fewer than two runtimes each.
+
+    """
+    if len(this_samples) < 2 or len(other_samples) < 2:
+        return None
+
+    from scipy import stats
+
+    p_value = stats.ttest_ind(
+        np.log(this_samples), np.log(other_samples), equal_var=False
+    ).pvalue
+    # Identical samples have no variance and are not significantly different.
+    return 1.0 if np.isnan(p_value) else float(p_value)
+
+
 def save_benchmark_result(bresults, filename):
     """Function to save benchmark result.
 
@@ -252,6 +361,11 @@ def main_run(args):
     containing this script with name benchmark_*
 
     """
+    if args.threads is not None:
+        os.environ["BENCHMARK_THREADS"] = args.threads
+    if args.no_weak_scaling:
+        os.environ["BENCHMARK_WEAK_SCALING"] = "0"
+
     results = []
     modules = list_benchmark_modules()
     for m in modules:
@@ -269,10 +383,13 @@ def main_run(args):
 def main_compare(args):
     """Function to compare benchmark results.
 
+    Differences between measurements with repeated runtimes are only
+    reported if they are significant at the level :code:`args.alpha`.
+
     Exits:
         1: If the runtime of any one result of rev_this is
-            slower than that of the runtime of rev_other by
-            more than the threshold ratio.
+            significantly slower than that of the runtime of rev_other by
+            more than the ratio :code:`args.fail_above`.
 
     Returns:
         None: If does not exit.
@@ -288,8 +405,11 @@ def main_compare(args):
 
     with open(filename) as infile:
         data = json.load(infile)
-
     rev_this_benchmark = data[rev_this]
+
+    if args.baseline is not None:
+        with open(get_report_filename(args.baseline)) as infile:
+            data = json.load(infile)
     rev_other_benchmark = data[rev_other]
 
     # lists to store results
@@ -298,7 +418,7 @@ def main_compare(args):
     sames = []
 
     # helper function to print and store results
-    def compare_helper(_this_t, _other_t, _N, _thread):
+    def compare_helper(_this_t, _other_t, _N, _thread, _p_value=None, _kind=None):
         ratio = _other_t / _this_t
         info = {
             "name": this_res["name"],
@@ -306,25 +426,37 @@ def main_compare(args):
             "N": _N,
             "ratio": ratio,
         }
+        if _kind:
+            info["scaling"] = _kind
         if _thread:
             info["threads"] = _thread
             print(
-                "Threads: {}, N: {}, " "ratio: {:0.2f}".format(str(_thread), _N, ratio)
+                "Threads: {}, N: {}, " "ratio: {:0.2f}".format(str(_thread), _N, ratio),
+                end="",
             )
         else:
-            print(f"N: {_N}, ratio: {ratio:0.2f}")
+            print(f"N: {_N}, ratio: {ratio:0.2f}", end="")
+        if _p_value is not None:
+            info["p_value"] = _p_value
+            print(f", p-value: {_p_value:0.3f}", end="")
+        print()
 
-        if ratio < 1:
+        if _p_value is not None and _p_value >= args.alpha:
+            print(
+                "\t{:6.6} and {:6.6} " "are not significantly different".format(rt, ro)
+            )
+            sames.append(info)
+        elif ratio < 1:
             print(
                 "\t{:6.6} is {:0.2f} times " "slower than {:6.6}".format(rt, ratio, ro)
             )
             slowers.append(info)
-        if ratio > 1:
+        elif ratio > 1:
             print(
                 "\t{:6.6} is {:0.2f} times " "faster than {:6.6}".format(rt, ratio, ro)
             )
             fasters.append(info)
-        if ratio == 1:
+        else:
             print("\t{:6.6} and {:6.6} " "have the same speed".format(rt, ro))
             sames.append(info)
 
@@ -349,13 +481,39 @@ def main_compare(args):
                     other_t = other_res["size_scale"][N]
                     compare_helper(this_t, other_t, N, None)
 
-                # compare thread scaling behavior
-                num_threads = len(this_res["thread_scale"]) - 1
-                for i in range(1, num_threads + 1):
-                    for j, N in enumerate(this_res["Ns"]):
-                        this_t = this_res["thread_scale"][i][j]
-                        other_t = other_res["thread_scale"][i][j]
-                        compare_helper(this_t, other_t, N, i)
+                # compare strong and weak scaling behavior
+                for kind in ["strong", "weak"]:
+                    key = kind + "_scale"
+                    if key not in this_res or key not in other_res:
+                        continue
+                    for i, ncores in enumerate(this_res["threads"]):
+                        if ncores not in other_res["threads"]:
+                            continue
+                        other_i = other_res["threads"].index(ncores)
+                        for j, N in enumerate(this_res["Ns"][: len(this_res[key][i])]):
+                            this_m = this_res[key][i][j]
+                            other_m = other_res[key][other_i][j]
+                            p_value = welch_p_value(
+                                this_m["samples"], other_m["samples"]
+                            )
+                            compare_helper(
+                                this_m["time"],
+                                other_m["time"],
+                                N,
+                                ncores,
+                                p_value,
+                                kind,
+                            )
+
+                # compare thread scaling behavior of reports without
+                # measurements
+                if "thread_scale" in this_res and "thread_scale" in other_res:
+                    num_threads = len(this_res["thread_scale"]) - 1
+                    for i in range(1, num_threads + 1):
+                        for j, N in enumerate(this_res["Ns"]):
+                            this_t = this_res["thread_scale"][i][j]
+                            other_t = other_res["thread_scale"][i][j]
+                            compare_helper(this_t, other_t, N, i)
 
                 print("\n ----------------")
 
@@ -370,6 +528,10 @@ def main_compare(args):
             print("\t" + desc)
             print("\t\tratio = {}".format(info["ratio"]))
 
+    if args.fail_above is not None:
+        if any(1 / info["ratio"] > args.fail_above for info in slowers):
+            sys.exit(1)
+
 
 if __name__ == "__main__":
     parser = argparse.ArgumentParser()
@@ -389,6 +551,16 @@ if __name__ == "__main__":
         "to or '-' for None, "
         "default='benchmark.json'.",
     )
+    parser_run.add_argument(
+        "--threads",
+        help="Comma separated numbers of threads of the thread scaling "
+        "benchmarks, default: powers of two up to the number of CPUs.",
+    )
+    parser_run.add_argument(
+        "--no-weak-scaling",
+        action="store_true",
+        help="Skip the weak scaling benchmarks.",
+    )
     parser_run.set_defaults(func=main_run)
 
     parser_report = subparsers.add_parser(
@@ -440,6 +612,18 @@ if __name__ == "__main__":
         help="The collection that contains the benchmark data"
         "default='benchmark.json'.",
     )
+    parser_compare.add_argument(
+        "--baseline",
+        help="The collection that contains the benchmark data of rev_other, "
+        "e.g. a stored baseline of a release, default: --filename.",
+    )
+    parser_compare.add_argument(
+        "--alpha",
+        type=float,
+        default=0.05,
+        help="Significance level of the differences between measurements "
+        "with repeated runtimes, default=0.05.",
+    )
     parser_compare.add_argument(
         "-f",
         "--fail-above",
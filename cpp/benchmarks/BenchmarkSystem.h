@@ -0,0 +1,100 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BENCHMARK_SYSTEM_H
+#define BENCHMARK_SYSTEM_H
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Box.h"
+#include "VectorMath.h"
+#include "tbb_config.h"
+
+/*! \file BenchmarkSystem.h
+    \brief Random systems and shared arguments of the benchmarks of the C++ kernels.
+*/
+
+namespace freud { namespace benchmarks {
+
+//! Number density of the random systems of the benchmarks.
+constexpr float DENSITY = 1.0;
+
+//! Points uniformly distributed in a cubic box.
+struct BenchmarkSystem
+{
+    //! Constructor
+    /*! \param n_points The number of points.
+     *  \param seed The seed of the random positions.
+     *  \param is2D Whether to make a square 2D system.
+     */
+    explicit BenchmarkSystem(unsigned int n_points, unsigned int seed = 0, bool is2D = false)
+    {
+        const float L = is2D ? std::sqrt(float(n_points) / DENSITY) : std::cbrt(float(n_points) / DENSITY);
+        box = box::Box(L, is2D);
+
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> position(-L / float(2.0), L / float(2.0));
+        points.resize(n_points);
+        for (auto& point : points)
+        {
+            point.x = position(rng);
+            point.y = position(rng);
+            point.z = is2D ? float(0.0) : position(rng);
+        }
+    }
+
+    box::Box box;                    //!< The simulation box
+    std::vector<vec3<float>> points; //!< The point coordinates
+};
+
+//! Set the number of threads of freud for the lifetime of a benchmark run.
+class ScopedNumThreads
+{
+public:
+    //! Constructor
+    /*! \param num_threads The number of threads, or 0 for all threads.
+     */
+    explicit ScopedNumThreads(int64_t num_threads)
+    {
+        parallel::setNumThreads(static_cast<unsigned int>(num_threads));
+    }
+
+    //! Destructor, restoring the default number of threads.
+    ~ScopedNumThreads()
+    {
+        parallel::setNumThreads(0);
+    }
+
+    ScopedNumThreads(const ScopedNumThreads&) = delete;
+    ScopedNumThreads& operator=(const ScopedNumThreads&) = delete;
+};
+
+//! Run a benchmark for each combination of numbers of points and threads.
+/*! Benchmarks read the number of points from state.range(0) and the number
+ *  of threads from state.range(1). Since the work runs on the threads of
+ *  TBB, the wall clock time is reported.
+ *
+ *  \param benchmark The benchmark to configure.
+ *  \param sizes The numbers of points.
+ */
+inline void systemArguments(benchmark::internal::Benchmark* benchmark, const std::vector<int64_t>& sizes)
+{
+    benchmark->ArgsProduct({sizes, {1, 2, 4, 8}})
+        ->ArgNames({"N", "threads"})
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+}
+
+//! Run a benchmark at the numbers of points used by most kernels.
+inline void systemArguments(benchmark::internal::Benchmark* benchmark)
+{
+    systemArguments(benchmark, {1 << 10, 1 << 13, 1 << 16});
+}
+
+}; }; // end namespace freud::benchmarks
+
+#endif // BENCHMARK_SYSTEM_H
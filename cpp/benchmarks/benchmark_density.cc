@@ -0,0 +1,69 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <benchmark/benchmark.h>
+
+#include "AABBQuery.h"
+#include "BenchmarkSystem.h"
+#include "GaussianDensity.h"
+#include "RDF.h"
+
+/*! \file benchmark_density.cc
+    \brief Benchmarks of the computes of freud::density.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Spread the points of a system onto a grid of width^3 voxels.
+/*! \param state The benchmark state, with the number of points, the number
+ *         of threads and the width of the grid as arguments.
+ */
+void BM_GaussianDensity(benchmark::State& state)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    const auto width = static_cast<unsigned int>(state.range(2));
+    const locality::AABBQuery nq(system.box, system.points.data(), system.points.size());
+
+    density::GaussianDensity gaussian_density(vec3<unsigned int>(width, width, width), 2, 0.5);
+    for (auto _ : state)
+    {
+        gaussian_density.compute(&nq);
+        benchmark::DoNotOptimize(gaussian_density.getDensity().get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//! Accumulate and normalize the radial distribution function of a system.
+void BM_RDF(benchmark::State& state)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    const locality::AABBQuery nq(system.box, system.points.data(), system.points.size());
+    locality::QueryArgs args;
+    args.mode = locality::QueryType::ball;
+    args.r_max = 4;
+    args.exclude_ii = true;
+
+    density::RDF rdf(100, args.r_max);
+    for (auto _ : state)
+    {
+        rdf.reset();
+        rdf.accumulate(&nq, system.points.data(), system.points.size(), nullptr, args);
+        benchmark::DoNotOptimize(rdf.getRDF().get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_GaussianDensity)
+    ->ArgsProduct({{1 << 10, 1 << 13, 1 << 16}, {1, 2, 4, 8}, {32, 64}})
+    ->ArgNames({"N", "threads", "width"})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_RDF)->Apply(systemArguments);
+
+}; }; // end namespace freud::benchmarks
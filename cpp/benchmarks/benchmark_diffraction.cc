@@ -0,0 +1,73 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <benchmark/benchmark.h>
+
+#include "AABBQuery.h"
+#include "BenchmarkSystem.h"
+#include "StaticStructureFactorDebye.h"
+#include "StaticStructureFactorDirect.h"
+
+/*! \file benchmark_diffraction.cc
+    \brief Benchmarks of the static structure factors of freud::diffraction.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Number of k bins of the structure factors.
+constexpr unsigned int NUM_K_BINS = 100;
+
+//! Largest k of the structure factors.
+constexpr float K_MAX = 10;
+
+//! Accumulate the structure factor of the points of a system onto themselves.
+void benchmarkStructureFactor(benchmark::State& state, diffraction::StaticStructureFactor& sf)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    const locality::AABBQuery nq(system.box, system.points.data(), system.points.size());
+    for (auto _ : state)
+    {
+        sf.reset();
+        sf.accumulate(&nq, system.points.data(), system.points.size(), system.points.size());
+        benchmark::DoNotOptimize(sf.getStructureFactor().get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//! Evaluate the Debye formula for every pair of points.
+void BM_StaticStructureFactorDebyeExact(benchmark::State& state)
+{
+    diffraction::StaticStructureFactorDebye sf(NUM_K_BINS, K_MAX);
+    benchmarkStructureFactor(state, sf);
+}
+
+//! Evaluate the Debye formula from a histogram of the pair distances.
+void BM_StaticStructureFactorDebyeHistogram(benchmark::State& state)
+{
+    diffraction::StaticStructureFactorDebye sf(NUM_K_BINS, K_MAX, 0, 10000);
+    benchmarkStructureFactor(state, sf);
+}
+
+//! Evaluate the direct formula at a random sample of the k points.
+void BM_StaticStructureFactorDirect(benchmark::State& state)
+{
+    diffraction::StaticStructureFactorDirect sf(NUM_K_BINS, K_MAX, 0, 10000);
+    benchmarkStructureFactor(state, sf);
+}
+
+//! The Debye formula sums over all pairs, so it is run on smaller systems.
+void debyeArguments(benchmark::internal::Benchmark* benchmark)
+{
+    systemArguments(benchmark, {1 << 8, 1 << 10, 1 << 12});
+}
+
+} // namespace
+
+BENCHMARK(BM_StaticStructureFactorDebyeExact)->Apply(debyeArguments);
+BENCHMARK(BM_StaticStructureFactorDebyeHistogram)->Apply(debyeArguments);
+BENCHMARK(BM_StaticStructureFactorDirect)->Apply(systemArguments);
+
+}; }; // end namespace freud::benchmarks
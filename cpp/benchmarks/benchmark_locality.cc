@@ -0,0 +1,124 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+
+#include "AABBQuery.h"
+#include "BenchmarkSystem.h"
+#include "LinkCell.h"
+#include "NeighborList.h"
+
+/*! \file benchmark_locality.cc
+    \brief Benchmarks of building and querying the neighbor queries of freud::locality.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Cutoff distance of the ball queries, with about 14 neighbors per point at DENSITY.
+constexpr float R_MAX = 1.5;
+
+//! Number of neighbors of the nearest neighbor queries.
+constexpr unsigned int NUM_NEIGHBORS = 12;
+
+//! Query arguments of a ball query excluding self-neighbors.
+locality::QueryArgs ballQueryArgs()
+{
+    locality::QueryArgs args;
+    args.mode = locality::QueryType::ball;
+    args.r_max = R_MAX;
+    args.exclude_ii = true;
+    return args;
+}
+
+//! Query arguments of a nearest neighbor query excluding self-neighbors.
+locality::QueryArgs nearestQueryArgs()
+{
+    locality::QueryArgs args;
+    args.mode = locality::QueryType::nearest;
+    args.num_neighbors = NUM_NEIGHBORS;
+    args.exclude_ii = true;
+    return args;
+}
+
+//! Find the neighbors of all points of a system, as computes do.
+void benchmarkQuery(benchmark::State& state, const locality::NeighborQuery& nq, const BenchmarkSystem& system,
+                    const locality::QueryArgs& args)
+{
+    for (auto _ : state)
+    {
+        std::unique_ptr<locality::NeighborList> nlist(
+            nq.query(system.points.data(), system.points.size(), args)->toNeighborList());
+        benchmark::DoNotOptimize(nlist->getNumBonds());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_LinkCellBuild(benchmark::State& state)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    for (auto _ : state)
+    {
+        locality::LinkCell nq(system.box, system.points.data(), system.points.size(), R_MAX);
+        benchmark::DoNotOptimize(nq.getNumCells());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_LinkCellBallQuery(benchmark::State& state)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    const locality::LinkCell nq(system.box, system.points.data(), system.points.size(), R_MAX);
+    benchmarkQuery(state, nq, system, ballQueryArgs());
+}
+
+void BM_LinkCellNearestQuery(benchmark::State& state)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    const locality::LinkCell nq(system.box, system.points.data(), system.points.size());
+    benchmarkQuery(state, nq, system, nearestQueryArgs());
+}
+
+void BM_AABBQueryBuild(benchmark::State& state)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    for (auto _ : state)
+    {
+        locality::AABBQuery nq(system.box, system.points.data(), system.points.size(), false, true);
+        benchmark::DoNotOptimize(nq.getNPoints());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_AABBQueryBallQuery(benchmark::State& state)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    const locality::AABBQuery nq(system.box, system.points.data(), system.points.size());
+    benchmarkQuery(state, nq, system, ballQueryArgs());
+}
+
+void BM_AABBQueryNearestQuery(benchmark::State& state)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    const locality::AABBQuery nq(system.box, system.points.data(), system.points.size());
+    benchmarkQuery(state, nq, system, nearestQueryArgs());
+}
+
+} // namespace
+
+BENCHMARK(BM_LinkCellBuild)->Apply(systemArguments);
+BENCHMARK(BM_LinkCellBallQuery)->Apply(systemArguments);
+BENCHMARK(BM_LinkCellNearestQuery)->Apply(systemArguments);
+BENCHMARK(BM_AABBQueryBuild)->Apply(systemArguments);
+BENCHMARK(BM_AABBQueryBallQuery)->Apply(systemArguments);
+BENCHMARK(BM_AABBQueryNearestQuery)->Apply(systemArguments);
+
+}; }; // end namespace freud::benchmarks
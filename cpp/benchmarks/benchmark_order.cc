@@ -0,0 +1,111 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <benchmark/benchmark.h>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "AABBQuery.h"
+#include "BenchmarkSystem.h"
+#include "NeighborList.h"
+#include "SphericalHarmonics.h"
+#include "Steinhardt.h"
+
+/*! \file benchmark_order.cc
+    \brief Benchmarks of the spherical harmonics and the Steinhardt order parameters of freud::order.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Largest spherical harmonic number l of the harmonic benchmarks.
+constexpr unsigned int L_MAX = 12;
+
+//! Number of neighbors of each point in the Steinhardt benchmarks.
+constexpr unsigned int NUM_NEIGHBORS = 12;
+
+//! Evaluate the harmonics of all l up to L_MAX of random bonds in blocks, on one thread.
+void BM_SphericalHarmonics(benchmark::State& state)
+{
+    const auto n_bonds = static_cast<size_t>(state.range(0));
+    std::mt19937 rng(0);
+    std::normal_distribution<float> component;
+    std::vector<vec3<float>> bonds(n_bonds);
+    for (auto& bond : bonds)
+    {
+        bond = vec3<float>(component(rng), component(rng), component(rng));
+    }
+
+    order::SphericalHarmonicBlock block(L_MAX);
+    std::vector<std::complex<float>> qlm(2 * L_MAX + 1);
+    for (auto _ : state)
+    {
+        for (size_t begin = 0; begin < n_bonds; begin += order::SphericalHarmonicBlock::BLOCK_SIZE)
+        {
+            block.clear();
+            for (size_t bond = begin; bond < n_bonds && !block.full(); ++bond)
+            {
+                block.push_back(bonds[bond], std::sqrt(dot(bonds[bond], bonds[bond])), 1);
+            }
+            block.evaluate();
+            block.accumulate(L_MAX, qlm.data());
+        }
+        benchmark::DoNotOptimize(qlm.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//! Compute a Steinhardt order parameter from a precomputed neighbor list.
+void benchmarkSteinhardt(benchmark::State& state, unsigned int l, bool average, bool wl)
+{
+    const BenchmarkSystem system(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    const locality::AABBQuery nq(system.box, system.points.data(), system.points.size());
+    locality::QueryArgs args;
+    args.mode = locality::QueryType::nearest;
+    args.num_neighbors = NUM_NEIGHBORS;
+    args.exclude_ii = true;
+    const std::unique_ptr<locality::NeighborList> nlist(
+        nq.query(system.points.data(), system.points.size(), args)->toNeighborList());
+
+    order::Steinhardt steinhardt(l, average, wl);
+    for (auto _ : state)
+    {
+        steinhardt.compute(nlist.get(), &nq, args);
+        benchmark::DoNotOptimize(steinhardt.getParticleOrder().get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_SteinhardtQl(benchmark::State& state)
+{
+    benchmarkSteinhardt(state, 6, false, false);
+}
+
+void BM_SteinhardtQlAverage(benchmark::State& state)
+{
+    benchmarkSteinhardt(state, 6, true, false);
+}
+
+void BM_SteinhardtWl(benchmark::State& state)
+{
+    benchmarkSteinhardt(state, 6, false, true);
+}
+
+} // namespace
+
+BENCHMARK(BM_SphericalHarmonics)
+    ->Arg(1 << 10)
+    ->Arg(1 << 14)
+    ->Arg(1 << 18)
+    ->ArgName("bonds")
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_SteinhardtQl)->Apply(systemArguments);
+BENCHMARK(BM_SteinhardtQlAverage)->Apply(systemArguments);
+BENCHMARK(BM_SteinhardtWl)->Apply(systemArguments);
+
+}; }; // end namespace freud::benchmarks
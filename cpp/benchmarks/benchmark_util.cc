@@ -0,0 +1,146 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "BenchmarkSystem.h"
+#include "Histogram.h"
+#include "VectorMath.h"
+#include "utils.h"
+
+/*! \file benchmark_util.cc
+    \brief Benchmarks of the histograms and vector math of freud::util.
+*/
+
+namespace freud { namespace benchmarks {
+
+namespace {
+
+//! Bin random values into a histogram with thread-local storage.
+/*! \param state The benchmark state, with the number of values, the number of
+ *         threads and the number of bins as arguments.
+ *  \param storage The storage of the bin counts of the threads.
+ */
+void benchmarkHistogram(benchmark::State& state, util::BinStorage storage)
+{
+    const auto n_values = static_cast<size_t>(state.range(0));
+    const ScopedNumThreads num_threads(state.range(1));
+    const auto n_bins = static_cast<size_t>(state.range(2));
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> uniform(0, 1);
+    std::vector<float> values(n_values);
+    for (auto& value : values)
+    {
+        value = uniform(rng);
+    }
+
+    util::Histogram<unsigned int> histogram(util::Axes {std::make_shared<util::RegularAxis>(n_bins, 0, 1)});
+    util::Histogram<unsigned int>::ThreadLocalHistogram local_histograms(histogram, storage);
+    for (auto _ : state)
+    {
+        local_histograms.reset();
+        util::forLoopWrapper(0, n_values, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                local_histograms(values[i]);
+            }
+        });
+        histogram.reduceOverThreads(local_histograms);
+        benchmark::DoNotOptimize(histogram.getBinCounts().get());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_HistogramCopies(benchmark::State& state)
+{
+    benchmarkHistogram(state, util::BinStorage::copies);
+}
+
+void BM_HistogramShared(benchmark::State& state)
+{
+    benchmarkHistogram(state, util::BinStorage::shared);
+}
+
+void BM_HistogramBlocks(benchmark::State& state)
+{
+    benchmarkHistogram(state, util::BinStorage::blocks);
+}
+
+//! Bin 2^16 to 2^22 values into histograms of 100 and 10^5 bins.
+void histogramArguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgsProduct({{1 << 16, 1 << 19, 1 << 22}, {1, 2, 4, 8}, {100, 100000}})
+        ->ArgNames({"N", "threads", "bins"})
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+}
+
+//! Bin 2^10 to 2^16 values into histograms of 10^6 bins, most of which stay empty.
+void sparselyFilledHistogramArguments(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgsProduct({{1 << 10, 1 << 13, 1 << 16}, {1, 2, 4, 8}, {1000000}})
+        ->ArgNames({"N", "threads", "bins"})
+        ->UseRealTime()
+        ->Unit(benchmark::kMillisecond);
+}
+
+//! Get random unit quaternions.
+std::vector<quat<float>> randomOrientations(size_t n)
+{
+    std::mt19937 rng(0);
+    std::normal_distribution<float> normal;
+    std::vector<quat<float>> orientations(n);
+    for (auto& orientation : orientations)
+    {
+        const quat<float> q(normal(rng), vec3<float>(normal(rng), normal(rng), normal(rng)));
+        orientation = (float(1.0) / std::sqrt(norm2(q))) * q;
+    }
+    return orientations;
+}
+
+//! Rotate a vector by many quaternions one at a time.
+void BM_Rotate(benchmark::State& state)
+{
+    const std::vector<quat<float>> orientations = randomOrientations(state.range(0));
+    std::vector<vec3<float>> rotated(orientations.size());
+    const vec3<float> u(1, 0, 0);
+    for (auto _ : state)
+    {
+        for (size_t i = 0; i < orientations.size(); ++i)
+        {
+            rotated[i] = rotate(orientations[i], u);
+        }
+        benchmark::DoNotOptimize(rotated.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+//! Rotate a vector by many quaternions with rotateBatch.
+void BM_RotateBatch(benchmark::State& state)
+{
+    const std::vector<quat<float>> orientations = randomOrientations(state.range(0));
+    std::vector<vec3<float>> rotated(orientations.size());
+    const vec3<float> u(1, 0, 0);
+    for (auto _ : state)
+    {
+        rotateBatch(orientations.data(), u, orientations.size(), rotated.data());
+        benchmark::DoNotOptimize(rotated.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK(BM_HistogramCopies)->Apply(histogramArguments);
+BENCHMARK(BM_HistogramShared)->Apply(histogramArguments);
+BENCHMARK(BM_HistogramBlocks)->Apply(histogramArguments);
+BENCHMARK(BM_HistogramCopies)->Apply(sparselyFilledHistogramArguments);
+BENCHMARK(BM_HistogramBlocks)->Apply(sparselyFilledHistogramArguments);
+BENCHMARK(BM_Rotate)->Arg(1 << 16)->ArgName("N");
+BENCHMARK(BM_RotateBatch)->Arg(1 << 16)->ArgName("N");
+
+}; }; // end namespace freud::benchmarks
@@ -4,11 +4,17 @@
 #ifndef BOX_H
 #define BOX_H
 
+#include "GrainTuner.h"
 #include "utils.h"
 #include <algorithm>
+#include <array>
 #include <complex>
 #include <sstream>
 #include <stdexcept>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #include "VectorMath.h"
 
@@ -232,12 +238,11 @@ public:
      */
     void makeAbsolute(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out) const
     {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                out[i] = makeAbsolute(vecs[i]);
-            }
-        });
+        const auto make_absolute = [&](size_t begin, size_t end) {
+            makeAbsoluteBatch(vecs + begin, end - begin, out + begin);
+        };
+        static const util::GrainTuner tuner("Box::makeAbsolute");
+        util::forLoopWrapper(0, Nvecs, make_absolute, tuner);
     }
 
     //! Convert a point's coordinate from absolute to fractional box coordinates.
@@ -265,12 +270,11 @@ public:
      */
     void makeFractional(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out) const
     {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                out[i] = makeFractional(vecs[i]);
-            }
-        });
+        const auto make_fractional = [&](size_t begin, size_t end) {
+            makeFractionalBatch(vecs + begin, end - begin, out + begin);
+        };
+        static const util::GrainTuner tuner("Box::makeFractional");
+        util::forLoopWrapper(0, Nvecs, make_fractional, tuner);
     }
 
     //! Get periodic image of a vector.
@@ -296,12 +300,11 @@ public:
      */
     void getImages(vec3<float>* vecs, unsigned int Nvecs, vec3<int>* res) const
     {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                getImage(vecs[i], res[i]);
-            }
-        });
+        const auto get_images = [&](size_t begin, size_t end) {
+            getImagesBatch(vecs + begin, end - begin, res + begin);
+        };
+        static const util::GrainTuner tuner("Box::getImages");
+        util::forLoopWrapper(0, Nvecs, get_images, tuner);
     }
 
     //! Wrap a vector back into the box
@@ -339,12 +342,11 @@ public:
      */
     void wrap(const vec3<float>* vecs, unsigned int Nvecs, vec3<float>* out) const
     {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
-            {
-                out[i] = wrap(vecs[i]);
-            }
-        });
+        const auto wrap_range = [&](size_t begin, size_t end) {
+            wrapBatch(vecs + begin, end - begin, out + begin);
+        };
+        static const util::GrainTuner tuner("Box::wrap");
+        util::forLoopWrapper(0, Nvecs, wrap_range, tuner);
     }
 
     //! Unwrap given positions to their absolute location in place
@@ -355,17 +357,162 @@ public:
     */
     void unwrap(const vec3<float>* vecs, const vec3<int>* images, unsigned int Nvecs, vec3<float>* out) const
     {
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
+        const auto unwrap_range = [&](size_t begin, size_t end) {
+            unwrapBatch(vecs + begin, images + begin, end - begin, out + begin);
+        };
+        static const util::GrainTuner tuner("Box::unwrap");
+        util::forLoopWrapper(0, Nvecs, unwrap_range, tuner);
+    }
+
+    //! Number of vectors converted at once by loops that process vectors in batches.
+    static constexpr size_t BATCH_SIZE = 256;
+
+    //! Convert fractional coordinates into absolute coordinates on the calling thread.
+    /*! The vectors are converted four at a time with SSE2 when available,
+     *  with the same results as makeAbsolute on each vector.
+     *  \param vecs Vectors of fractional coordinates
+     *  \param n Number of vectors
+     *  \param out The array in which to place the converted vectors, which may be vecs.
+     */
+    void makeAbsoluteBatch(const vec3<float>* vecs, size_t n, vec3<float>* out) const
+    {
+        size_t i = 0;
+#ifdef __SSE2__
+        for (; i + 4 <= n; i += 4)
+        {
+            store4(makeAbsolute4(load4(&vecs[i].x)), &out[i].x);
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            out[i] = makeAbsolute(vecs[i]);
+        }
+    }
+
+    //! Convert point coordinates from absolute to fractional box coordinates on the calling thread.
+    /*! The vectors are converted four at a time with SSE2 when available,
+     *  with the same results as makeFractional on each vector.
+     *  \param vecs Vectors to convert
+     *  \param n Number of vectors
+     *  \param out The array in which to place the converted vectors, which may be vecs.
+     */
+    void makeFractionalBatch(const vec3<float>* vecs, size_t n, vec3<float>* out) const
+    {
+        size_t i = 0;
+#ifdef __SSE2__
+        for (; i + 4 <= n; i += 4)
+        {
+            store4(makeFractional4(load4(&vecs[i].x)), &out[i].x);
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            out[i] = makeFractional(vecs[i]);
+        }
+    }
+
+    //! Get the periodic images of vectors on the calling thread.
+    /*! The vectors are processed four at a time with SSE2 when available,
+     *  with the same results as getImage on each vector.
+     *  \param vecs The vectors to check
+     *  \param n Number of vectors
+     *  \param res Array to save the images
+     */
+    void getImagesBatch(const vec3<float>* vecs, size_t n, vec3<int>* res) const
+    {
+        size_t i = 0;
+#ifdef __SSE2__
+        for (; i + 4 <= n; i += 4)
+        {
+            store4(getImage4(load4(&vecs[i].x)), &res[i].x);
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            getImage(vecs[i], res[i]);
+        }
+    }
+
+    //! Wrap vectors back into the box on the calling thread.
+    /*! The vectors are wrapped four at a time with SSE2 when available,
+     *  with the same results as wrap on each vector.
+     *  \param vecs Vectors to wrap
+     *  \param n Number of vectors
+     *  \param out The array in which to place the wrapped vectors, which may be vecs.
+     */
+    void wrapBatch(const vec3<float>* vecs, size_t n, vec3<float>* out) const
+    {
+        if (!m_periodic.x && !m_periodic.y && !m_periodic.z)
+        {
+            std::copy(vecs, vecs + n, out);
+            return;
+        }
+        size_t i = 0;
+#ifdef __SSE2__
+        for (; i + 4 <= n; i += 4)
+        {
+            Vec3x4 f = makeFractional4(load4(&vecs[i].x));
+            if (m_periodic.x)
             {
-                out[i] = vecs[i] + getLatticeVector(0) * float(images[i].x)
-                    + getLatticeVector(1) * float(images[i].y);
-                if (!m_2d)
-                {
-                    out[i] += getLatticeVector(2) * float(images[i].z);
-                }
+                f.x = modulusPositive4(f.x);
+            }
+            if (m_periodic.y)
+            {
+                f.y = modulusPositive4(f.y);
             }
-        });
+            if (m_periodic.z)
+            {
+                f.z = modulusPositive4(f.z);
+            }
+            store4(makeAbsolute4(f), &out[i].x);
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            out[i] = wrap(vecs[i]);
+        }
+    }
+
+    //! Unwrap positions to their absolute location on the calling thread.
+    /*! The vectors are unwrapped four at a time with SSE2 when available,
+     *  with the same results as unwrap.
+     *  \param vecs Vectors of coordinates to unwrap
+     *  \param images Image flags of the vectors
+     *  \param n Number of vectors
+     *  \param out The array in which to place the unwrapped vectors, which may be vecs.
+     */
+    void unwrapBatch(const vec3<float>* vecs, const vec3<int>* images, size_t n, vec3<float>* out) const
+    {
+        const vec3<float> a0 = getLatticeVector(0);
+        const vec3<float> a1 = getLatticeVector(1);
+        const vec3<float> a2 = m_2d ? vec3<float>() : getLatticeVector(2);
+        size_t i = 0;
+#ifdef __SSE2__
+        for (; i + 4 <= n; i += 4)
+        {
+            const Vec3x4 v = load4(&vecs[i].x);
+            const Vec3x4 image = load4(reinterpret_cast<const float*>(&images[i].x));
+            const __m128 ix = _mm_cvtepi32_ps(_mm_castps_si128(image.x));
+            const __m128 iy = _mm_cvtepi32_ps(_mm_castps_si128(image.y));
+            const __m128 iz = _mm_cvtepi32_ps(_mm_castps_si128(image.z));
+            const auto unwrap4 = [&](__m128 component, float l0, float l1, float l2) {
+                component = _mm_add_ps(_mm_add_ps(component, _mm_mul_ps(_mm_set1_ps(l0), ix)),
+                                       _mm_mul_ps(_mm_set1_ps(l1), iy));
+                return m_2d ? component : _mm_add_ps(component, _mm_mul_ps(_mm_set1_ps(l2), iz));
+            };
+            store4({unwrap4(v.x, a0.x, a1.x, a2.x), unwrap4(v.y, a0.y, a1.y, a2.y),
+                    unwrap4(v.z, a0.z, a1.z, a2.z)},
+                   &out[i].x);
+        }
+#endif
+        for (; i < n; ++i)
+        {
+            out[i] = vecs[i] + a0 * float(images[i].x) + a1 * float(images[i].y);
+            if (!m_2d)
+            {
+                out[i] += a2 * float(images[i].z);
+            }
+        }
     }
 
     //! Compute center of mass for vectors
@@ -404,12 +551,14 @@ public:
     void center(vec3<float>* vecs, unsigned int Nvecs, const float* masses = nullptr) const
     {
         vec3<float> com(centerOfMass(vecs, Nvecs, masses));
-        util::forLoopWrapper(0, Nvecs, [&](size_t begin, size_t end) {
+        const auto center_range = [&](size_t begin, size_t end) {
             for (size_t i = begin; i < end; ++i)
             {
                 vecs[i] = wrap(vecs[i] - com);
             }
-        });
+        };
+        static const util::GrainTuner tuner("Box::center");
+        util::forLoopWrapper(0, Nvecs, center_range, tuner);
     }
 
     //! Calculate distance between two points using boundary conditions
@@ -437,12 +586,25 @@ public:
         {
             throw std::invalid_argument("The number of query points and points must match.");
         }
-        util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
-            for (size_t i = begin; i < end; ++i)
+        const auto compute_distances = [&](size_t begin, size_t end) {
+            // The separations are wrapped in batches, as by computeDistance.
+            std::array<vec3<float>, BATCH_SIZE> separations;
+            for (size_t batch = begin; batch < end; batch += BATCH_SIZE)
             {
-                distances[i] = computeDistance(query_points[i], points[i]);
+                const size_t n = std::min(BATCH_SIZE, end - batch);
+                for (size_t k = 0; k < n; ++k)
+                {
+                    separations[k] = points[batch + k] - query_points[batch + k];
+                }
+                wrapBatch(separations.data(), n, separations.data());
+                for (size_t k = 0; k < n; ++k)
+                {
+                    distances[batch + k] = std::sqrt(dot(separations[k], separations[k]));
+                }
             }
-        });
+        };
+        static const util::GrainTuner tuner("Box::computeDistances");
+        util::forLoopWrapper(0, n_query_points, compute_distances, tuner);
     }
 
     //! Calculate all pairwise distances between a set of query points and points.
@@ -458,14 +620,88 @@ public:
     {
         util::forLoopWrapper2D(
             0, n_query_points, 0, n_points, [&](size_t begin_n, size_t end_n, size_t begin_m, size_t end_m) {
-                for (size_t i = begin_n; i < end_n; ++i)
+                computeDistanceTile(query_points + begin_n, end_n - begin_n, points + begin_m,
+                                    end_m - begin_m, distances + begin_n * n_points + begin_m, n_points);
+            });
+    }
+
+    //! Calculate the distances between a tile of query points and points on the calling thread.
+    /*! The separations are wrapped in batches, four at a time with SSE2 when
+        available, with the same results as computeAllDistances.
+        \param query_points Query point positions.
+        \param n_query_points The number of query points.
+        \param points Point positions.
+        \param n_points The number of points.
+        \param distances Array in which the distance between query point i and point j is stored at
+       i * stride + j.
+        \param stride Distance between the rows of consecutive query points in distances.
+    */
+    void computeDistanceTile(const vec3<float>* query_points, size_t n_query_points,
+                             const vec3<float>* points, size_t n_points, float* distances,
+                             size_t stride) const
+    {
+        std::array<vec3<float>, BATCH_SIZE> separations;
+        for (size_t i = 0; i < n_query_points; ++i)
+        {
+            float* const row = distances + i * stride;
+            for (size_t batch = 0; batch < n_points; batch += BATCH_SIZE)
+            {
+                const size_t n = std::min(BATCH_SIZE, n_points - batch);
+                for (size_t k = 0; k < n; ++k)
                 {
-                    for (size_t j = begin_m; j < end_m; ++j)
-                    {
-                        distances[i * n_points + j] = computeDistance(query_points[i], points[j]);
-                    }
+                    separations[k] = points[batch + k] - query_points[i];
                 }
-            });
+                wrapBatch(separations.data(), n, separations.data());
+                for (size_t k = 0; k < n; ++k)
+                {
+                    row[batch + k] = std::sqrt(dot(separations[k], separations[k]));
+                }
+            }
+        }
+    }
+
+    //! Number of query points in the tiles of forEachDistanceTile.
+    static constexpr size_t TILE_QUERY_POINTS = 64;
+
+    //! Number of points in the tiles of forEachDistanceTile.
+    static constexpr size_t TILE_POINTS = 1024;
+
+    //! Pass the distances between all query points and points to a callback, one tile at a time.
+    /*! This computes the same distances as computeAllDistances without
+        storing all of them, so that they can be reduced as they are
+        computed. The tiles of at most TILE_QUERY_POINTS query points and
+        TILE_POINTS points are computed in parallel, so the callback must be
+        safe to call concurrently, e.g. by reducing into util::ThreadStorage.
+        \param query_points Query point positions.
+        \param n_query_points The number of query points.
+        \param points Point positions.
+        \param n_points The number of points.
+        \param callback An object with operator(size_t query_begin, size_t query_end, size_t point_begin,
+       size_t point_end, const float* distances), where distances holds the distance between query point i
+       and point j at (i - query_begin) * (point_end - point_begin) + j - point_begin.
+    */
+    template<typename Callback>
+    void forEachDistanceTile(const vec3<float>* query_points, const unsigned int n_query_points,
+                             const vec3<float>* points, const unsigned int n_points,
+                             const Callback& callback) const
+    {
+        const size_t n_query_tiles = (n_query_points + TILE_QUERY_POINTS - 1) / TILE_QUERY_POINTS;
+        const size_t n_point_tiles = (n_points + TILE_POINTS - 1) / TILE_POINTS;
+        const auto compute_tiles = [&](size_t begin, size_t end) {
+            std::vector<float> distances(TILE_QUERY_POINTS * TILE_POINTS);
+            for (size_t tile = begin; tile < end; ++tile)
+            {
+                const size_t query_begin = (tile / n_point_tiles) * TILE_QUERY_POINTS;
+                const size_t query_end = std::min<size_t>(query_begin + TILE_QUERY_POINTS, n_query_points);
+                const size_t point_begin = (tile % n_point_tiles) * TILE_POINTS;
+                const size_t point_end = std::min<size_t>(point_begin + TILE_POINTS, n_points);
+                computeDistanceTile(query_points + query_begin, query_end - query_begin, points + point_begin,
+                                    point_end - point_begin, distances.data(), point_end - point_begin);
+                callback(query_begin, query_end, point_begin, point_end,
+                         static_cast<const float*>(distances.data()));
+            }
+        };
+        util::forLoopWrapper(0, n_query_tiles * n_point_tiles, compute_tiles);
     }
 
     //! Get mask of points that fit inside the box.
@@ -475,14 +711,16 @@ public:
     */
     void contains(const vec3<float>* points, const unsigned int n_points, bool* contains_mask) const
     {
-        util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        const auto contains_range = [&](size_t begin, size_t end) {
             std::transform(&points[begin], &points[end], &contains_mask[begin],
                            [this](const vec3<float>& point) -> bool {
                                vec3<int> image(0, 0, 0);
                                getImage(point, image);
                                return image == vec3<int>(0, 0, 0);
                            });
-        });
+        };
+        static const util::GrainTuner tuner("Box::contains");
+        util::forLoopWrapper(0, n_points, contains_range, tuner);
     }
 
     //! Get the shortest distance between opposite boundary planes of the box
@@ -597,6 +835,114 @@ public:
     }
 
 private:
+#ifdef __SSE2__
+    //! The components of four vectors, each in a register.
+    struct Vec3x4
+    {
+        __m128 x; //!< x components
+        __m128 y; //!< y components
+        __m128 z; //!< z components
+    };
+
+    //! Load four consecutive vectors of three floats (or bit patterns of ints) starting at v.
+    static Vec3x4 load4(const float* v)
+    {
+        // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+        const __m128 a = _mm_loadu_ps(v);
+        const __m128 b = _mm_loadu_ps(v + 4);
+        const __m128 c = _mm_loadu_ps(v + 8);
+        const __m128 x2x3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+        const __m128 y0y1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+        const __m128 y2y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+        const __m128 z0z1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+        return {_mm_shuffle_ps(a, x2x3, _MM_SHUFFLE(2, 0, 3, 0)),
+                _mm_shuffle_ps(y0y1, y2y3, _MM_SHUFFLE(2, 0, 2, 0)),
+                _mm_shuffle_ps(z0z1, c, _MM_SHUFFLE(3, 0, 2, 0))};
+    }
+
+    //! Store four vectors as consecutive vectors of three floats starting at v.
+    static void store4(const Vec3x4& v, float* out)
+    {
+        const __m128 x0y0 = _mm_shuffle_ps(v.x, v.y, _MM_SHUFFLE(0, 0, 0, 0));
+        const __m128 z0x1 = _mm_shuffle_ps(v.z, v.x, _MM_SHUFFLE(1, 1, 0, 0));
+        const __m128 y1z1 = _mm_shuffle_ps(v.y, v.z, _MM_SHUFFLE(1, 1, 1, 1));
+        const __m128 x2y2 = _mm_shuffle_ps(v.x, v.y, _MM_SHUFFLE(2, 2, 2, 2));
+        const __m128 z2x3 = _mm_shuffle_ps(v.z, v.x, _MM_SHUFFLE(3, 3, 2, 2));
+        const __m128 y3z3 = _mm_shuffle_ps(v.y, v.z, _MM_SHUFFLE(3, 3, 3, 3));
+        _mm_storeu_ps(out, _mm_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(out + 4, _mm_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+        _mm_storeu_ps(out + 8, _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+    }
+
+    //! Store the four images in the x, y and z registers as consecutive vectors of three ints.
+    static void store4(const Vec3x4& image, int* out)
+    {
+        store4(image, reinterpret_cast<float*>(out));
+    }
+
+    //! Truncate four values towards zero, as std::trunc.
+    static __m128 truncate4(__m128 a)
+    {
+        // Floats of magnitude 2^23 or more are integers, and may not fit in an int.
+        const __m128 magnitude = _mm_andnot_ps(_mm_set1_ps(-0.0F), a);
+        const __m128 small = _mm_cmplt_ps(magnitude, _mm_set1_ps(8388608.0F));
+        const __m128 truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+        return _mm_or_ps(_mm_and_ps(small, truncated), _mm_andnot_ps(small, a));
+    }
+
+    //! Compute util::modulusPositive(a, 1) of four values.
+    /*! fmod(x, 1) is exactly x - trunc(x), so this gives the same results as
+     *  the two calls of fmod of the scalar version.
+     */
+    static __m128 modulusPositive4(__m128 a)
+    {
+        const __m128 one = _mm_set1_ps(1.0F);
+        const __m128 shifted = _mm_add_ps(_mm_sub_ps(a, truncate4(a)), one);
+        return _mm_sub_ps(shifted, truncate4(shifted));
+    }
+
+    //! Convert four vectors to fractional coordinates, as makeFractional.
+    Vec3x4 makeFractional4(const Vec3x4& v) const
+    {
+        const __m128 x_tilt = _mm_set1_ps(m_xz - m_yz * m_xy);
+        __m128 x = _mm_sub_ps(v.x, _mm_set1_ps(m_lo.x));
+        __m128 y = _mm_sub_ps(v.y, _mm_set1_ps(m_lo.y));
+        __m128 z = _mm_sub_ps(v.z, _mm_set1_ps(m_lo.z));
+        x = _mm_sub_ps(x, _mm_add_ps(_mm_mul_ps(x_tilt, v.z), _mm_mul_ps(_mm_set1_ps(m_xy), v.y)));
+        y = _mm_sub_ps(y, _mm_mul_ps(_mm_set1_ps(m_yz), v.z));
+        x = _mm_div_ps(x, _mm_set1_ps(m_L.x));
+        y = _mm_div_ps(y, _mm_set1_ps(m_L.y));
+        z = m_2d ? _mm_setzero_ps() : _mm_div_ps(z, _mm_set1_ps(m_L.z));
+        return {x, y, z};
+    }
+
+    //! Convert four vectors of fractional coordinates to absolute coordinates, as makeAbsolute.
+    Vec3x4 makeAbsolute4(const Vec3x4& f) const
+    {
+        __m128 x = _mm_add_ps(_mm_set1_ps(m_lo.x), _mm_mul_ps(f.x, _mm_set1_ps(m_L.x)));
+        __m128 y = _mm_add_ps(_mm_set1_ps(m_lo.y), _mm_mul_ps(f.y, _mm_set1_ps(m_L.y)));
+        __m128 z = _mm_add_ps(_mm_set1_ps(m_lo.z), _mm_mul_ps(f.z, _mm_set1_ps(m_L.z)));
+        x = _mm_add_ps(x, _mm_add_ps(_mm_mul_ps(_mm_set1_ps(m_xy), y), _mm_mul_ps(_mm_set1_ps(m_xz), z)));
+        y = _mm_add_ps(y, _mm_mul_ps(_mm_set1_ps(m_yz), z));
+        return {x, y, m_2d ? _mm_setzero_ps() : z};
+    }
+
+    //! Get the periodic images of four vectors, as getImage, in the bit patterns of the registers.
+    Vec3x4 getImage4(const Vec3x4& v) const
+    {
+        const __m128 half = _mm_set1_ps(0.5F);
+        const Vec3x4 f = makeFractional4(v);
+        const auto round4 = [&half](__m128 a) {
+            const __m128 non_negative = _mm_cmpge_ps(a, _mm_setzero_ps());
+            const __m128 rounded = _mm_or_ps(_mm_and_ps(non_negative, _mm_add_ps(a, half)),
+                                             _mm_andnot_ps(non_negative, _mm_sub_ps(a, half)));
+            return _mm_castsi128_ps(_mm_cvttps_epi32(rounded));
+        };
+        return {round4(_mm_sub_ps(f.x, half)), round4(_mm_sub_ps(f.y, half)),
+                m_2d ? _mm_setzero_ps() : round4(_mm_sub_ps(f.z, half))};
+    }
+#endif
+
     vec3<float> m_lo;      //!< Minimum coords in the box
     vec3<float> m_hi;      //!< Maximum coords in the box
     vec3<float> m_L;       //!< L precomputed (used to avoid subtractions in boundary conditions)
@@ -0,0 +1,179 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BOX_KERNEL_H
+#define BOX_KERNEL_H
+
+#include <cmath>
+
+#include "Box.h"
+#include "VectorMath.h"
+#include "utils.h"
+
+/*! \file BoxKernel.h
+    \brief Box operations specialized at compile time for the shape and periodicity of a box.
+*/
+
+namespace freud { namespace box {
+
+//! Box operations specialized for the shape and periodicity of a box.
+/*! Box checks its tilt factors, dimensionality and periodicity on every
+ *  call. A kernel fixes them at compile time, so that orthorhombic boxes
+ *  skip the tilt terms, 2D boxes skip the z components and fully periodic
+ *  boxes skip the periodicity checks. Loops over many pairs select the kernel
+ *  of their box once with dispatchBoxKernel and call it for each pair. All
+ *  methods give the same results as the corresponding methods of Box.
+ *
+ *  \tparam Triclinic Whether the box has nonzero tilt factors.
+ *  \tparam TwoD Whether the box is 2D.
+ *  \tparam Periodic Whether the box is periodic along all of its dimensions.
+ *          Otherwise, the periodicity along each dimension is checked at run time.
+ */
+template<bool Triclinic, bool TwoD, bool Periodic> class BoxKernel
+{
+public:
+    //! Constructor
+    /*! \param box The box, which must match the template parameters.
+     */
+    explicit BoxKernel(const Box& box)
+        : m_L(box.getL()), m_lo(-(box.getL() / float(2.0))), m_xy(box.getTiltFactorXY()),
+          m_xz(box.getTiltFactorXZ()), m_yz(box.getTiltFactorYZ()),
+          m_x_tilt(box.getTiltFactorXZ() - box.getTiltFactorYZ() * box.getTiltFactorXY()),
+          m_periodic(box.getPeriodic())
+    {}
+
+    //! Check if the box is aperiodic along all dimensions.
+    bool isAperiodic() const
+    {
+        return !Periodic && !m_periodic.x && !m_periodic.y && !m_periodic.z;
+    }
+
+    //! Check if the box is periodic along x.
+    bool isPeriodicX() const
+    {
+        return Periodic || m_periodic.x;
+    }
+
+    //! Check if the box is periodic along y.
+    bool isPeriodicY() const
+    {
+        return Periodic || m_periodic.y;
+    }
+
+    //! Check if the z components of fractional coordinates are wrapped, which they never are in 2D.
+    bool isPeriodicZ() const
+    {
+        return !TwoD && (Periodic || m_periodic.z);
+    }
+
+    //! Convert a point's coordinate from absolute to fractional box coordinates, as Box::makeFractional.
+    vec3<float> makeFractional(const vec3<float>& v) const
+    {
+        vec3<float> delta = v - m_lo;
+        if (Triclinic)
+        {
+            delta.x -= m_x_tilt * v.z + m_xy * v.y;
+            delta.y -= m_yz * v.z;
+        }
+        delta.x /= m_L.x;
+        delta.y /= m_L.y;
+        delta.z = TwoD ? float(0.0) : delta.z / m_L.z;
+        return delta;
+    }
+
+    //! Convert fractional coordinates into absolute coordinates, as Box::makeAbsolute.
+    vec3<float> makeAbsolute(const vec3<float>& f) const
+    {
+        vec3<float> v = m_lo + f * m_L;
+        if (Triclinic)
+        {
+            v.x += m_xy * v.y + m_xz * v.z;
+            v.y += m_yz * v.z;
+        }
+        if (TwoD)
+        {
+            v.z = float(0.0);
+        }
+        return v;
+    }
+
+    //! Wrap a vector back into the box, as Box::wrap.
+    vec3<float> wrap(const vec3<float>& v) const
+    {
+        if (isAperiodic())
+        {
+            return v;
+        }
+
+        vec3<float> v_frac = makeFractional(v);
+        if (isPeriodicX())
+        {
+            v_frac.x = util::modulusPositive(v_frac.x, float(1.0));
+        }
+        if (isPeriodicY())
+        {
+            v_frac.y = util::modulusPositive(v_frac.y, float(1.0));
+        }
+        if (isPeriodicZ())
+        {
+            v_frac.z = util::modulusPositive(v_frac.z, float(1.0));
+        }
+        return makeAbsolute(v_frac);
+    }
+
+    //! Wrap a fractional coordinate into [0, 1).
+    /*! This reproduces util::modulusPositive(f, 1) with operations that the
+     *  compiler can vectorize, for loops over arrays of one component.
+     */
+    static float wrapFractional(float f)
+    {
+        const float wrapped = (f - std::trunc(f)) + float(1.0);
+        return (wrapped >= float(1.0)) ? wrapped - float(1.0) : wrapped;
+    }
+
+private:
+    vec3<float> m_L;       //!< Box lengths
+    vec3<float> m_lo;      //!< Minimum coords in the box
+    float m_xy;            //!< xy tilt factor
+    float m_xz;            //!< xz tilt factor
+    float m_yz;            //!< yz tilt factor
+    float m_x_tilt;        //!< Coefficient of z in the x component of fractional coordinates
+    vec3<bool> m_periodic; //!< Periodicity along each dimension
+};
+
+//! Call a function with the kernel of a box.
+/*! \param box The box.
+ *  \param function An object with a templated operator(const BoxKernel<...>&),
+ *         such as a generic lambda, which is instantiated for every kernel.
+ *  \returns The result of function.
+ */
+template<typename Function> auto dispatchBoxKernel(const Box& box, const Function& function)
+{
+    const bool triclinic
+        = box.getTiltFactorXY() != 0 || box.getTiltFactorXZ() != 0 || box.getTiltFactorYZ() != 0;
+    const vec3<bool> periodic = box.getPeriodic();
+    const bool two_d = box.is2D();
+    const bool fully_periodic = periodic.x && periodic.y && (two_d || periodic.z);
+
+    if (triclinic)
+    {
+        if (two_d)
+        {
+            return fully_periodic ? function(BoxKernel<true, true, true>(box))
+                                  : function(BoxKernel<true, true, false>(box));
+        }
+        return fully_periodic ? function(BoxKernel<true, false, true>(box))
+                              : function(BoxKernel<true, false, false>(box));
+    }
+    if (two_d)
+    {
+        return fully_periodic ? function(BoxKernel<false, true, true>(box))
+                              : function(BoxKernel<false, true, false>(box));
+    }
+    return fully_periodic ? function(BoxKernel<false, false, true>(box))
+                          : function(BoxKernel<false, false, false>(box));
+}
+
+}; }; // end namespace freud::box
+
+#endif // BOX_KERNEL_H
@@ -2,12 +2,18 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <atomic>
+#include <functional>
 #include <numeric>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_scan.h>
+#include <tbb/parallel_sort.h>
 
 #include "Cluster.h"
 #include "NeighborBond.h"
 #include "NeighborComputeFunctional.h"
 #include "dset/dset.h"
+#include "utils.h"
 
 //! Finds clusters using a network of neighbors.
 namespace freud { namespace cluster {
@@ -19,6 +25,8 @@ void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::loc
     m_cluster_idx.prepare(num_points);
     DisjointSets dj(num_points);
 
+    // Merging the sets of a bond also merges those of its reverse bond, so
+    // half neighbor lists find the same clusters.
     freud::locality::loopOverNeighbors(
         nq, nq->getPoints(), num_points, qargs, nlist,
         [&dj](const freud::locality::NeighborBond& neighbor_bond) {
@@ -27,66 +35,121 @@ void Cluster::compute(const freud::locality::NeighborQuery* nq, const freud::loc
             {
                 dj.unite(neighbor_bond.point_idx, neighbor_bond.query_point_idx);
             }
-        });
+        },
+        true, freud::locality::HalfListPolicy::symmetric);
 
     // Done looping over points. All clusters are now determined.
     // Next, we renumber clusters from zero to num_clusters-1.
     // These new cluster indexes are then sorted by cluster size from largest
     // to smallest, with equally-sized clusters sorted based on their minimum
     // point index.
-    std::vector<size_t> cluster_label(num_points, num_points);
-    std::vector<size_t> cluster_label_count(num_points);
-    std::vector<size_t> cluster_min_id(num_points, num_points);
 
-    // Loop over every point.
-    m_num_clusters = 0;
-    for (size_t i = 0; i < num_points; i++)
-    {
-        size_t s = dj.find(i);
-
-        // Label this cluster if we haven't seen it yet.
-        if (cluster_label[s] == num_points)
+    // Find the root of every point. Finds may run concurrently once all sets
+    // are merged.
+    std::vector<uint32_t> roots(num_points);
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
         {
-            // Label this cluster uniquely.
-            cluster_label[s] = m_num_clusters;
-            // Track the smallest point index in this cluster.
-            cluster_min_id[cluster_label[s]] = i;
-            // Increment the count of unique clusters.
-            m_num_clusters++;
+            roots[i] = dj.find(i);
         }
+    });
 
-        // Increment the counter for this cluster label.
-        cluster_label_count[cluster_label[s]]++;
-    }
+    // Label the clusters by a scan over their roots.
+    std::vector<size_t> root_label(num_points);
+    m_num_clusters = util::executeInThreadArena([&]() {
+        return tbb::parallel_scan(
+            tbb::blocked_range<size_t>(0, num_points), 0U,
+            [&](const tbb::blocked_range<size_t>& r, unsigned int num_labels, bool is_final_scan) {
+                for (size_t i = r.begin(); i != r.end(); ++i)
+                {
+                    if (roots[i] == i)
+                    {
+                        if (is_final_scan)
+                        {
+                            root_label[i] = num_labels;
+                        }
+                        ++num_labels;
+                    }
+                }
+                return num_labels;
+            },
+            std::plus<>());
+    });
 
-    // Resize label counts and min ids to the number of unique clusters found.
-    cluster_label_count.resize(m_num_clusters);
-    cluster_label_count.shrink_to_fit();
-    cluster_min_id.resize(m_num_clusters);
-    cluster_min_id.shrink_to_fit();
+    // Count the points and track the smallest point index of each cluster.
+    // Consecutive points often belong to the same cluster, so each run of
+    // points in a cluster is added at once, which keeps threads from
+    // contending for the counters of large clusters.
+    std::vector<std::atomic<size_t>> label_counts(m_num_clusters);
+    std::vector<std::atomic<size_t>> label_min_ids(m_num_clusters);
+    util::forLoopWrapper(0, m_num_clusters, [&](size_t begin, size_t end) {
+        for (size_t label = begin; label < end; ++label)
+        {
+            label_counts[label].store(0, std::memory_order_relaxed);
+            label_min_ids[label].store(num_points, std::memory_order_relaxed);
+        }
+    });
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        size_t i = begin;
+        while (i < end)
+        {
+            const size_t label = root_label[roots[i]];
+            const size_t run_start = i;
+            ++i;
+            while (i < end && root_label[roots[i]] == label)
+            {
+                ++i;
+            }
+            label_counts[label].fetch_add(i - run_start, std::memory_order_relaxed);
+
+            // The first point of the run is the smallest point index of the run.
+            size_t min_id = label_min_ids[label].load(std::memory_order_relaxed);
+            while (run_start < min_id
+                   && !label_min_ids[label].compare_exchange_weak(min_id, run_start,
+                                                                  std::memory_order_relaxed))
+            {}
+        }
+    });
+
+    std::vector<size_t> cluster_label_count(m_num_clusters);
+    std::vector<size_t> cluster_min_id(m_num_clusters);
+    util::forLoopWrapper(0, m_num_clusters, [&](size_t begin, size_t end) {
+        for (size_t label = begin; label < end; ++label)
+        {
+            cluster_label_count[label] = label_counts[label].load(std::memory_order_relaxed);
+            cluster_min_id[label] = label_min_ids[label].load(std::memory_order_relaxed);
+        }
+    });
 
     // Get a permutation that reorders clusters, largest to smallest.
     std::vector<size_t> cluster_reindex = sort_indexes_inverse(cluster_label_count, cluster_min_id);
 
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_cluster_idx[i] = cluster_reindex[root_label[roots[i]]];
+        }
+    });
+
     // Clear the cluster keys
     m_cluster_keys = std::vector<std::vector<unsigned int>>(m_num_clusters, std::vector<unsigned int>());
+    for (size_t label = 0; label < m_num_clusters; ++label)
+    {
+        m_cluster_keys[cluster_reindex[label]].reserve(cluster_label_count[label]);
+    }
 
-    /* Loop over all points, set their cluster ids and add them to a list of
-     * sets. Each set contains all the keys that are part of that cluster. If
-     * no keys are provided, the keys use point ids. Get the computed list
-     * with getClusterKeys().
+    /* Loop over all points and add them to a list of sets. Each set contains
+     * all the keys that are part of that cluster. If no keys are provided, the
+     * keys use point ids. Get the computed list with getClusterKeys().
      */
     for (size_t i = 0; i < num_points; i++)
     {
-        size_t s = dj.find(i);
-        size_t cluster_idx = cluster_reindex[cluster_label[s]];
-        m_cluster_idx[i] = cluster_idx;
         unsigned int key = i;
         if (keys != nullptr)
         {
             key = keys[i];
         }
-        m_cluster_keys[cluster_idx].push_back(key);
+        m_cluster_keys[m_cluster_idx[i]].push_back(key);
     }
 }
 
@@ -100,23 +163,27 @@ std::vector<size_t> Cluster::sort_indexes_inverse(const std::vector<size_t>& cou
     std::iota(idx.begin(), idx.end(), 0);
 
     // Sort indexes based on comparing values in counts, min_ids.
-    std::sort(idx.begin(), idx.end(), [&counts, &min_ids](size_t i1, size_t i2) {
-        if (counts[i1] != counts[i2])
-        {
-            // If the counts are unequal, return the largest cluster first.
-            return counts[i1] > counts[i2];
-        }
-        // If the counts are equal, return the cluster with the smallest
-        // point id first.
-        return min_ids[i1] < min_ids[i2];
+    util::executeInThreadArena([&]() {
+        tbb::parallel_sort(idx.begin(), idx.end(), [&counts, &min_ids](size_t i1, size_t i2) {
+            if (counts[i1] != counts[i2])
+            {
+                // If the counts are unequal, return the largest cluster first.
+                return counts[i1] > counts[i2];
+            }
+            // If the counts are equal, return the cluster with the smallest
+            // point id first.
+            return min_ids[i1] < min_ids[i2];
+        });
     });
 
     // Invert the permutation.
     std::vector<size_t> inv_idx(idx.size());
-    for (size_t i = 0; i < idx.size(); i++)
-    {
-        inv_idx[idx[i]] = i;
-    }
+    util::forLoopWrapper(0, idx.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            inv_idx[idx[i]] = i;
+        }
+    });
     return inv_idx;
 }
 
@@ -33,7 +33,17 @@ class ClusterProperties
 {
 public:
     //! Constructor
-    ClusterProperties() = default;
+    /*! \param compute_tensors Whether to compute the gyration and moment of
+     *         inertia tensors. If false, only the centers, sizes, and masses
+     *         are computed.
+     */
+    explicit ClusterProperties(bool compute_tensors = true) : m_compute_tensors(compute_tensors) {}
+
+    //! Return whether the gyration and moment of inertia tensors are computed.
+    bool getComputeTensors() const
+    {
+        return m_compute_tensors;
+    }
 
     //! Compute properties of the point clusters
     void compute(const freud::locality::NeighborQuery* nq, const unsigned int* cluster_idx,
@@ -76,6 +86,8 @@ public:
     }
 
 private:
+    bool m_compute_tensors; //!< Whether the tensors are computed
+
     util::ManagedArray<vec3<float>> m_cluster_centers; //!< Unweighted center of mass computed for each
                                                        //!< cluster (length: m_num_clusters)
     util::ManagedArray<vec3<float>> m_cluster_centers_of_mass; //!< Center of mass computed for each cluster
@@ -0,0 +1,164 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <cstdint>
+#include <stdexcept>
+#include <tbb/parallel_sort.h>
+#include <utility>
+
+#include "ClusterTracker.h"
+#include "utils.h"
+
+/*! \file ClusterTracker.cc
+    \brief Tracks clusters of points across frames.
+*/
+
+namespace freud { namespace cluster {
+
+namespace {
+//! Number of points shared by a cluster of the current frame and a cluster of the previous frame.
+struct ClusterOverlap
+{
+    unsigned int current;  //!< Cluster index in the current frame
+    unsigned int previous; //!< Cluster index in the previous frame
+    unsigned int count;    //!< Number of shared points
+};
+
+//! Write pairs of IDs to a two-column array.
+void storeEvents(util::ManagedArray<unsigned int>& target,
+                 const std::vector<std::pair<unsigned int, unsigned int>>& events)
+{
+    target.prepare({events.size(), 2});
+    for (size_t event = 0; event < events.size(); ++event)
+    {
+        target(event, 0) = events[event].first;
+        target(event, 1) = events[event].second;
+    }
+}
+} // namespace
+
+void ClusterTracker::reset()
+{
+    m_frame_counter = 0;
+    m_next_id = 0;
+    m_prev_labels.clear();
+    m_prev_ids.clear();
+}
+
+void ClusterTracker::compute(const freud::locality::NeighborQuery* nq,
+                             const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
+{
+    const unsigned int num_points = nq->getNPoints();
+    if (m_frame_counter > 0 && num_points != m_prev_labels.size())
+    {
+        throw std::invalid_argument("ClusterTracker requires the same number of points in every frame. Call "
+                                    "reset before tracking a different system.");
+    }
+
+    m_cluster.compute(nq, nlist, qargs);
+    const auto& labels = m_cluster.getClusterIdx();
+    const unsigned int num_clusters = m_cluster.getNumClusters();
+
+    m_cluster_ids.prepare(num_clusters);
+    std::vector<std::pair<unsigned int, unsigned int>> merges;
+    std::vector<std::pair<unsigned int, unsigned int>> splits;
+
+    if (m_frame_counter == 0)
+    {
+        for (unsigned int cluster = 0; cluster < num_clusters; ++cluster)
+        {
+            m_cluster_ids[cluster] = m_next_id++;
+        }
+    }
+    else
+    {
+        // Count the points shared by each pair of current and previous
+        // clusters by sorting the pairs of cluster indices of all points.
+        std::vector<uint64_t> pairs(num_points);
+        util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                pairs[i] = (uint64_t(labels[i]) << 32) | m_prev_labels[i];
+            }
+        });
+        util::executeInThreadArena([&]() { tbb::parallel_sort(pairs.begin(), pairs.end()); });
+
+        std::vector<ClusterOverlap> overlaps;
+        for (size_t i = 0; i < num_points;)
+        {
+            const uint64_t pair = pairs[i];
+            const size_t run_start = i;
+            while (i < num_points && pairs[i] == pair)
+            {
+                ++i;
+            }
+            overlaps.push_back({static_cast<unsigned int>(pair >> 32), static_cast<unsigned int>(pair),
+                                static_cast<unsigned int>(i - run_start)});
+        }
+
+        // Find the cluster of the other frame sharing the most points with
+        // each cluster. The overlaps are sorted by current and then previous
+        // cluster index, so ties go to the smaller index.
+        const auto num_prev_clusters = static_cast<unsigned int>(m_prev_ids.size());
+        std::vector<unsigned int> best_previous(num_clusters);
+        std::vector<unsigned int> best_previous_count(num_clusters, 0);
+        std::vector<unsigned int> best_current(num_prev_clusters);
+        std::vector<unsigned int> best_current_count(num_prev_clusters, 0);
+        for (const auto& overlap : overlaps)
+        {
+            if (overlap.count > best_previous_count[overlap.current])
+            {
+                best_previous[overlap.current] = overlap.previous;
+                best_previous_count[overlap.current] = overlap.count;
+            }
+            if (overlap.count > best_current_count[overlap.previous])
+            {
+                best_current[overlap.previous] = overlap.current;
+                best_current_count[overlap.previous] = overlap.count;
+            }
+        }
+
+        // Clusters that are each other's best match keep their ID, and
+        // current clusters without a match have split.
+        for (unsigned int cluster = 0; cluster < num_clusters; ++cluster)
+        {
+            const unsigned int previous = best_previous[cluster];
+            if (best_current[previous] == cluster)
+            {
+                m_cluster_ids[cluster] = m_prev_ids[previous];
+            }
+            else
+            {
+                m_cluster_ids[cluster] = m_next_id++;
+                splits.emplace_back(m_prev_ids[previous], m_cluster_ids[cluster]);
+            }
+        }
+
+        // Previous clusters without a match have merged.
+        for (unsigned int previous = 0; previous < num_prev_clusters; ++previous)
+        {
+            const unsigned int cluster = best_current[previous];
+            if (best_previous[cluster] != previous)
+            {
+                merges.emplace_back(m_prev_ids[previous], m_cluster_ids[cluster]);
+            }
+        }
+    }
+
+    m_cluster_idx.prepare(num_points);
+    m_prev_labels.resize(num_points);
+    util::forLoopWrapper(0, num_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_cluster_idx[i] = m_cluster_ids[labels[i]];
+            m_prev_labels[i] = labels[i];
+        }
+    });
+    m_prev_ids.assign(m_cluster_ids.get(), m_cluster_ids.get() + num_clusters);
+
+    storeEvents(m_merges, merges);
+    storeEvents(m_splits, splits);
+    ++m_frame_counter;
+}
+
+}; }; // end namespace freud::cluster
@@ -0,0 +1,105 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef CLUSTER_TRACKER_H
+#define CLUSTER_TRACKER_H
+
+#include <vector>
+
+#include "Cluster.h"
+#include "ManagedArray.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+
+/*! \file ClusterTracker.h
+    \brief Tracks clusters of points across frames.
+*/
+
+namespace freud { namespace cluster {
+
+//! Finds clusters in consecutive frames and assigns them IDs that persist across frames.
+/*! Each call to compute finds the clusters of a frame like Cluster, then
+ *  matches them to the clusters of the previous frame by the number of points
+ *  they share. A cluster of the current frame and a cluster of the previous
+ *  frame are matched if each shares more points with the other than with any
+ *  other cluster, with ties broken by the smaller cluster index. A matched
+ *  cluster inherits the ID of the previous cluster, and all other clusters are
+ *  given new IDs.
+ *
+ *  Clusters that are not matched are reported as events. A previous cluster
+ *  that is not matched has merged into the current cluster holding most of
+ *  its points, and a current cluster that is not matched has split from the
+ *  previous cluster holding most of its points.
+ *
+ *  The points must be the same, in the same order, in every frame.
+ */
+class ClusterTracker
+{
+public:
+    //! Constructor
+    ClusterTracker() = default;
+
+    //! Compute the clusters of the next frame and match them to the previous frame.
+    void compute(const freud::locality::NeighborQuery* nq, const freud::locality::NeighborList* nlist,
+                 freud::locality::QueryArgs qargs);
+
+    //! Forget the previous frame, so that the next frame assigns new IDs.
+    void reset();
+
+    //! Get the number of clusters in the last frame.
+    unsigned int getNumClusters() const
+    {
+        return m_cluster.getNumClusters();
+    }
+
+    //! Get the number of frames computed since the last reset.
+    unsigned int getFrameCounter() const
+    {
+        return m_frame_counter;
+    }
+
+    //! Get a reference to the cluster ID of each point.
+    const util::ManagedArray<unsigned int>& getClusterIdx() const
+    {
+        return m_cluster_idx;
+    }
+
+    //! Get a reference to the ID of each cluster, ordered like the clusters of Cluster.
+    const util::ManagedArray<unsigned int>& getClusterIds() const
+    {
+        return m_cluster_ids;
+    }
+
+    //! Get a reference to the merge events of the last frame.
+    /*! Each row holds the ID of a previous cluster and the ID of the current
+     *  cluster it merged into.
+     */
+    const util::ManagedArray<unsigned int>& getMerges() const
+    {
+        return m_merges;
+    }
+
+    //! Get a reference to the split events of the last frame.
+    /*! Each row holds the ID of a previous cluster and the ID of the new
+     *  current cluster that split from it.
+     */
+    const util::ManagedArray<unsigned int>& getSplits() const
+    {
+        return m_splits;
+    }
+
+private:
+    Cluster m_cluster;                              //!< Clusters of the last frame
+    unsigned int m_frame_counter {0};               //!< Number of frames since the last reset
+    unsigned int m_next_id {0};                     //!< ID given to the next new cluster
+    std::vector<unsigned int> m_prev_labels;        //!< Cluster index of each point in the previous frame
+    std::vector<unsigned int> m_prev_ids;           //!< ID of each cluster of the previous frame
+    util::ManagedArray<unsigned int> m_cluster_idx; //!< Cluster ID of each point
+    util::ManagedArray<unsigned int> m_cluster_ids; //!< ID of each cluster
+    util::ManagedArray<unsigned int> m_merges;      //!< Previous and current IDs of each merge
+    util::ManagedArray<unsigned int> m_splits;      //!< Previous and current IDs of each split
+};
+
+}; }; // end namespace freud::cluster
+
+#endif // CLUSTER_TRACKER_H
@@ -38,6 +38,11 @@ CorrelationFunction<T>::CorrelationFunction(unsigned int bins, float r_max) : Bo
 
     m_correlation_function = util::Histogram<T>(axes);
     m_local_correlation_function = CFThreadHistogram(m_correlation_function);
+    if constexpr (COMPENSATED)
+    {
+        m_compensation = util::Histogram<T>(axes);
+        m_local_compensation = CFThreadHistogram(m_compensation);
+    }
 }
 
 //! \internal
@@ -50,7 +55,16 @@ template<typename T> void CorrelationFunction<T>::reduce()
     // Reduce the bin counts over all threads, then use them to normalize the
     // RDF when computing.
     m_histogram.reduceOverThreads(m_local_histograms);
+    if constexpr (COMPENSATED)
+    {
+        m_compensation.prepare(getAxisSizes()[0]);
+        m_compensation.reduceOverThreads(m_local_compensation);
+    }
     m_correlation_function.reduceOverThreadsPerBin(m_local_correlation_function, [&](size_t i) {
+        if constexpr (COMPENSATED)
+        {
+            m_correlation_function[i] -= m_compensation[i];
+        }
         if (m_histogram[i])
         {
             m_correlation_function[i] /= m_histogram[i];
@@ -65,6 +79,10 @@ template<typename T> void CorrelationFunction<T>::reset()
     // Zero the correlation function in addition to the bin counts that are
     // reset by the parent.
     m_local_correlation_function.reset();
+    if constexpr (COMPENSATED)
+    {
+        m_local_compensation.reset();
+    }
 }
 
 // Define an overloaded pair of product functions to deal with complex conjugation if necessary.
@@ -78,6 +96,16 @@ inline double product(double x, double y)
     return x * y;
 }
 
+inline std::complex<float> product(std::complex<float> x, std::complex<float> y)
+{
+    return std::conj(x) * y;
+}
+
+inline float product(float x, float y)
+{
+    return x * y;
+}
+
 template<typename T>
 void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* neighbor_query, const T* values,
                                         const vec3<float>* query_points, const T* query_values,
@@ -85,18 +113,74 @@ void CorrelationFunction<T>::accumulate(const freud::locality::NeighborQuery* ne
                                         const freud::locality::NeighborList* nlist,
                                         freud::locality::QueryArgs qargs)
 {
-    accumulateGeneral(
-        neighbor_query, query_points, n_query_points, nlist, qargs,
-        [&](const freud::locality::NeighborBond& neighbor_bond) {
-            size_t value_bin = m_histogram.bin({neighbor_bond.distance});
-            m_local_histograms.increment(value_bin);
-            m_local_correlation_function.increment(
-                value_bin,
-                product(values[neighbor_bond.point_idx], query_values[neighbor_bond.query_point_idx]));
-        });
+    const util::StaticAxes<util::RegularAxis> axes(m_histogram.getAxes());
+
+    // Each bond of a half neighbor list also stands for its reverse bond,
+    // whose contribution is added explicitly.
+    const bool half_list = freud::locality::isHalfList(neighbor_query, query_points, n_query_points, nlist, qargs);
+    const unsigned int bond_count = half_list ? 2 : 1;
+
+    // The thread local histograms are looked up once for each range of bonds
+    // rather than for each bond.
+    const auto make_cf = [&]() {
+        auto& local_counts = m_local_histograms.local();
+        auto& local_sums = m_local_correlation_function.local();
+        util::Histogram<T>* local_compensation = COMPENSATED ? &m_local_compensation.local() : nullptr;
+        return [&axes, &local_counts, &local_sums, local_compensation, values, query_values, half_list,
+                bond_count](const freud::locality::NeighborBond& neighbor_bond) {
+            const size_t value_bin = axes.bin(neighbor_bond.distance);
+            if (value_bin == util::Axis::OVERFLOW_BIN)
+            {
+                return;
+            }
+            T value = product(values[neighbor_bond.point_idx], query_values[neighbor_bond.query_point_idx]);
+            if (half_list)
+            {
+                value += product(values[neighbor_bond.query_point_idx], query_values[neighbor_bond.point_idx]);
+            }
+            local_counts.increment(value_bin, bond_count);
+            if constexpr (COMPENSATED)
+            {
+                // Kahan summation, where the compensation holds the negated
+                // low order part lost from the sum.
+                T& sum = local_sums[value_bin];
+                T& compensation = (*local_compensation)[value_bin];
+                const T corrected_value = value - compensation;
+                const T new_sum = sum + corrected_value;
+                compensation = (new_sum - sum) - corrected_value;
+                sum = new_sum;
+            }
+            else
+            {
+                local_sums[value_bin] += value;
+            }
+        };
+    };
+    accumulateGeneralRanges(neighbor_query, query_points, n_query_points, nlist, qargs, make_cf,
+                            freud::locality::HalfListPolicy::symmetric);
+}
+
+template<typename T>
+void CorrelationFunction<T>::accumulateBinned(const box::Box& box, const T* correlation_sums,
+                                              const unsigned int* bin_counts, unsigned int n_points,
+                                              unsigned int n_query_points)
+{
+    m_box = box;
+    const size_t n_bins = getAxisSizes()[0];
+    for (size_t bin = 0; bin < n_bins; ++bin)
+    {
+        m_local_histograms.increment(bin, bin_counts[bin]);
+        m_local_correlation_function.increment(bin, correlation_sums[bin]);
+    }
+    m_frame_counter++;
+    m_n_points = n_points;
+    m_n_query_points = n_query_points;
+    m_reduce = true;
 }
 
 template class CorrelationFunction<std::complex<double>>;
 template class CorrelationFunction<double>;
+template class CorrelationFunction<std::complex<float>>;
+template class CorrelationFunction<float>;
 
 }; }; // end namespace freud::density
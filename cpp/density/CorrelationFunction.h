@@ -4,6 +4,9 @@
 #ifndef CORRELATION_FUNCTION_H
 #define CORRELATION_FUNCTION_H
 
+#include <complex>
+#include <type_traits>
+
 #include "BondHistogramCompute.h"
 #include "Box.h"
 #include "Histogram.h"
@@ -42,6 +45,11 @@ namespace freud { namespace density {
     for both points and ref_points, we omit accumulating the
     self-correlation value in the first bin.
 
+    <b>Precision:</b><br>
+    For single precision types, the products are accumulated in each bin with
+    Kahan compensation, so the sums of many small products keep nearly the
+    accuracy of double precision while the values take half the memory.
+
 */
 template<typename T> class CorrelationFunction : public locality::BondHistogramCompute
 {
@@ -60,6 +68,20 @@ public:
                     const vec3<float>* query_points, const T* query_values, unsigned int n_query_points,
                     const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
 
+    //! Accumulate sums of products of values and counts of bonds that are already binned.
+    /*! This adds a frame to the correlation function that is computed
+     *  without enumerating bonds, e.g. from the Fourier transforms of values
+     *  deposited on a mesh.
+     *
+     *  \param box Simulation box of the frame.
+     *  \param correlation_sums Sum of the products of values of the bonds in each bin.
+     *  \param bin_counts Number of bonds in each bin.
+     *  \param n_points Number of points.
+     *  \param n_query_points Number of query points.
+     */
+    void accumulateBinned(const box::Box& box, const T* correlation_sums, const unsigned int* bin_counts,
+                          unsigned int n_points, unsigned int n_query_points);
+
     //! \internal
     //! helper function to reduce the thread specific arrays into one array
     void reduce() override;
@@ -74,8 +96,14 @@ private:
     // Typedef thread local histogram type for use in code.
     using CFThreadHistogram = typename util::Histogram<T>::ThreadLocalHistogram;
 
+    //! Whether the sums in each bin are accumulated with Kahan compensation.
+    static constexpr bool COMPENSATED
+        = std::is_same<T, float>::value || std::is_same<T, std::complex<float>>::value;
+
     util::Histogram<T> m_correlation_function;      //!< The correlation function
     CFThreadHistogram m_local_correlation_function; //!< Thread local copy of the correlation function
+    util::Histogram<T> m_compensation;              //!< Kahan compensation of the correlation function
+    CFThreadHistogram m_local_compensation;         //!< Thread local Kahan compensation
 };
 
 }; }; // end namespace freud::density
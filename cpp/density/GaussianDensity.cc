@@ -1,10 +1,14 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cmath>
 #include <stdexcept>
+#include <vector>
 
 #include "GaussianDensity.h"
+#include "GridSlabs.h"
+#include "Instrumentation.h"
 
 /*! \file GaussianDensity.cc
     \brief Routines for computing Gaussian smeared densities from points.
@@ -12,6 +16,60 @@
 
 namespace freud { namespace density {
 
+namespace {
+//! Get a component of a vector by the index of its axis.
+float& component(vec3<float>& v, unsigned int axis)
+{
+    return (axis == 0) ? v.x : ((axis == 1) ? v.y : v.z);
+}
+
+//! Squared distances and Gaussian factors of the grid indices near a point along one axis.
+struct AxisWeights
+{
+    //! Compute the grid indices within bin_cut of bin and their squared distances and Gaussian factors.
+    /*! The distances are wrapped along the axis with the box, which matches
+     *  the corresponding component of wrapping the full distance vector in a
+     *  box without tilt.
+     */
+    void compute(const box::Box& box, unsigned int axis, int bin, int bin_cut, unsigned int width,
+                 bool periodic, float grid_size, float L, float position, float inv_two_sigmasq)
+    {
+        bins.clear();
+        r_sq.clear();
+        weights.clear();
+        for (int i = bin - bin_cut; i <= bin + bin_cut; i++)
+        {
+            // Reject bins that are outside the box in aperiodic directions
+            if (!periodic && (i < 0 || i >= int(width)))
+            {
+                continue;
+            }
+            vec3<float> delta(0, 0, 0);
+            component(delta, axis) = (grid_size * static_cast<float>(i)) + (grid_size / float(2.0)) - position
+                - (L / float(2.0));
+            vec3<float> wrapped_delta = box.wrap(delta);
+            const float wrapped = component(wrapped_delta, axis);
+
+            // Assure that out of range indices are corrected for storage
+            // in the array i.e. bin -1 is actually bin 29 for nbins = 30
+            bins.push_back((i + width) % width);
+            r_sq.push_back(wrapped * wrapped);
+            weights.push_back(std::exp(-wrapped * wrapped * inv_two_sigmasq));
+        }
+    }
+
+    //! Get the number of grid indices.
+    size_t size() const
+    {
+        return bins.size();
+    }
+
+    std::vector<unsigned int> bins; //!< Grid indices along the axis
+    std::vector<float> r_sq;        //!< Squared distance along the axis
+    std::vector<float> weights;     //!< Gaussian factor along the axis
+};
+} // namespace
+
 GaussianDensity::GaussianDensity(vec3<unsigned int> width, float r_max, float sigma)
     : m_box(), m_width(width), m_r_max(r_max), m_sigma(sigma), m_has_computed(false)
 {
@@ -36,6 +94,9 @@ vec3<unsigned int> GaussianDensity::getWidth()
 //! Compute the density array.
 void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const float* values)
 {
+    const util::ScopedPhase phase("GaussianDensity::compute");
+    const util::ScopedMemoryOwner owner("GaussianDensity");
+
     // set the number of dimensions for the calculation the first time it is done
     if (!m_has_computed || nq->getBox().is2D() == m_box.is2D())
     {
@@ -58,8 +119,14 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
         m_width.z = 1;
     }
 
-    m_density_array.prepare({m_width.x, m_width.y, m_width.z});
-    util::ThreadStorage<float> local_bin_counts({m_width.x, m_width.y, m_width.z});
+    // The slabs are reset by the tasks writing them below, which also places
+    // the pages of a new density array near the threads accumulating them.
+    m_density_array.prepareForOverwrite({m_width.x, m_width.y, m_width.z});
+    float* density = m_density_array.get();
+    const size_t slab_size = size_t(m_width.y) * m_width.z;
+    const auto reset_slabs = [density, slab_size](unsigned int slab_begin, unsigned int slab_end) {
+        std::fill(density + slab_begin * slab_size, density + slab_end * slab_size, 0.0f);
+    };
 
     // set up some constants first
     const float Lx = m_box.getLx();
@@ -81,9 +148,83 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
     const float dimensions = m_box.is2D() ? float(2.0) : float(3.0);
     const float normalization = std::pow(normalization_base, dimensions);
 
-    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
-        // for each reference point
-        for (size_t idx = begin; idx < end; ++idx)
+    const float inv_two_sigmasq = float(1.0) / (float(2.0) * sigmasq);
+
+    // Each range of slabs along x is written by a single task, which sums the
+    // contributions of the points near the range directly into the density
+    // array without per-thread copies of the grid.
+    GridSlabs slabs(m_width.x, bin_cut_x, periodic.x);
+    slabs.sort(n_points, [&](size_t idx) { return int(((*nq)[idx].x + Lx / float(2.0)) / grid_size_x); });
+
+    // In boxes without tilt, the wrapped distance along each axis only
+    // depends on the grid index along that axis and the Gaussian factorizes
+    // into a product of one dimensional Gaussians. The squared distances and
+    // Gaussian factors along each axis are then computed once for each point,
+    // which replaces an exp for every grid cell within r_max with an exp for
+    // every grid index within r_max along each axis.
+    const bool separable = m_box.getTiltFactorXY() == 0 && m_box.getTiltFactorXZ() == 0
+        && m_box.getTiltFactorYZ() == 0;
+    if (separable)
+    {
+        slabs.forEachRange([&](unsigned int slab_begin, unsigned int slab_end,
+                               const std::vector<size_t>& points) {
+            reset_slabs(slab_begin, slab_end);
+            AxisWeights x_weights;
+            AxisWeights y_weights;
+            AxisWeights z_weights;
+            for (const size_t idx : points)
+            {
+                const vec3<float> point = (*nq)[idx];
+                const float value = (values != nullptr) ? values[idx] : 1.0f;
+
+                // Find which bin the particle is in
+                const int bin_x = int((point.x + Lx / float(2.0)) / grid_size_x);
+                const int bin_y = int((point.y + Ly / float(2.0)) / grid_size_y);
+                // In 2D, only loop over the z=0 plane
+                const int bin_z = m_box.is2D() ? 0 : int((point.z + Lz / float(2.0)) / grid_size_z);
+
+                x_weights.compute(m_box, 0, bin_x, bin_cut_x, m_width.x, periodic.x, grid_size_x, Lx,
+                                  point.x, inv_two_sigmasq);
+                y_weights.compute(m_box, 1, bin_y, bin_cut_y, m_width.y, periodic.y, grid_size_y, Ly,
+                                  point.y, inv_two_sigmasq);
+                z_weights.compute(m_box, 2, bin_z, bin_cut_z, m_width.z, periodic.z, grid_size_z, Lz,
+                                  point.z, inv_two_sigmasq);
+
+                // The innermost loop runs along z, which is contiguous in the grid.
+                const float point_weight = value * normalization;
+                for (size_t i = 0; i < x_weights.size(); ++i)
+                {
+                    // Only write the slabs owned by this task
+                    if (x_weights.bins[i] < slab_begin || x_weights.bins[i] >= slab_end)
+                    {
+                        continue;
+                    }
+                    const float x_weight = point_weight * x_weights.weights[i];
+                    for (size_t j = 0; j < y_weights.size(); ++j)
+                    {
+                        const float r_sq_xy = x_weights.r_sq[i] + y_weights.r_sq[j];
+                        const float xy_weight = x_weight * y_weights.weights[j];
+                        for (size_t k = 0; k < z_weights.size(); ++k)
+                        {
+                            // Check to see if this distance is within the specified r_max
+                            if (r_sq_xy + z_weights.r_sq[k] < r_max_sq)
+                            {
+                                m_density_array(x_weights.bins[i], y_weights.bins[j], z_weights.bins[k])
+                                    += xy_weight * z_weights.weights[k];
+                            }
+                        }
+                    }
+                }
+            }
+        });
+        return;
+    }
+
+    slabs.forEachRange([&](unsigned int slab_begin, unsigned int slab_end, const std::vector<size_t>& points) {
+        reset_slabs(slab_begin, slab_end);
+
+        // for each reference point near the slabs
+        for (const size_t idx : points)
         {
             const vec3<float> point = (*nq)[idx];
             const float value = (values != nullptr) ? values[idx] : 1.0f;
@@ -125,6 +266,16 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
                         {
                             continue;
                         }
+
+                        // Assure that out of range indices are corrected for storage
+                        // in the array i.e. bin -1 is actually bin 29 for nbins = 30
+                        const unsigned int ni = (i + m_width.x) % m_width.x;
+
+                        // Only write the slabs owned by this task
+                        if (ni < slab_begin || ni >= slab_end)
+                        {
+                            continue;
+                        }
                         const float dx = (grid_size_x * static_cast<float>(i)) + (grid_size_x / float(2.0))
                             - point.x - (Lx / float(2.0));
 
@@ -140,23 +291,17 @@ void GaussianDensity::compute(const freud::locality::NeighborQuery* nq, const fl
                             const float gaussian
                                 = value * normalization * std::exp(-r_sq / (float(2.0) * sigmasq));
 
-                            // Assure that out of range indices are corrected for storage
-                            // in the array i.e. bin -1 is actually bin 29 for nbins = 30
-                            const unsigned int ni = (i + m_width.x) % m_width.x;
                             const unsigned int nj = (j + m_width.y) % m_width.y;
                             const unsigned int nk = (k + m_width.z) % m_width.z;
 
                             // Store the gaussian contribution
-                            local_bin_counts.local()(ni, nj, nk) += gaussian;
+                            m_density_array(ni, nj, nk) += gaussian;
                         }
                     }
                 }
             }
         }
     });
-
-    // Parallel reduction over thread storage
-    local_bin_counts.reduceInto(m_density_array);
 }
 
 }; }; // end namespace freud::density
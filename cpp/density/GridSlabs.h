@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef GRID_SLABS_H
+#define GRID_SLABS_H
+
+#include <algorithm>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <vector>
+
+#include "utils.h"
+
+/*! \file GridSlabs.h
+    \brief Decomposition of a grid into slabs that are written by a single thread.
+*/
+
+namespace freud { namespace density {
+
+//! Points sorted by the slab of a grid along its first axis that contains them.
+/*! Computes that spread the contributions of points onto the cells of a grid
+ *  within bin_cut cells of each point can use this class to split the grid
+ *  into ranges of slabs along the first axis, which are contiguous in memory.
+ *  Each range is processed by a single task that visits all points near the
+ *  range, including the halo of bin_cut slabs on either side and its
+ *  periodic images, and writes only the cells inside the range. Every cell is
+ *  therefore written by one task, so the grid is written directly without
+ *  per-thread copies or atomics.
+ *
+ *  The points near a range are visited in order of their slab and then of
+ *  their index, so the contributions to each cell are summed in the same
+ *  order independently of the number of threads.
+ */
+class GridSlabs
+{
+public:
+    //! Constructor
+    /*! \param width Number of slabs of the grid.
+     *  \param bin_cut Number of slabs on either side of its own slab that a point contributes to.
+     *  \param periodic Whether the grid is periodic along the axis of the slabs.
+     */
+    GridSlabs(unsigned int width, int bin_cut, bool periodic)
+        : m_width(width), m_bin_cut(std::max(bin_cut, 0)), m_periodic(periodic)
+    {}
+
+    //! Sort the points into their slabs.
+    /*! \param n_points Number of points.
+     *  \param get_bin Function returning the slab index of a point, which may be outside the grid.
+     */
+    template<typename BinFunction> void sort(size_t n_points, const BinFunction& get_bin)
+    {
+        std::vector<int> bins(n_points);
+        m_offsets.assign(m_width + 1, 0);
+        m_outside.clear();
+        for (size_t idx = 0; idx < n_points; ++idx)
+        {
+            bins[idx] = get_bin(idx);
+            if (bins[idx] >= 0 && bins[idx] < int(m_width))
+            {
+                ++m_offsets[bins[idx] + 1];
+            }
+        }
+        for (unsigned int slab = 0; slab < m_width; ++slab)
+        {
+            m_offsets[slab + 1] += m_offsets[slab];
+        }
+
+        // Counting sort of the points, keeping points outside of the grid
+        // (e.g. on its upper boundary) in a separate list visited by every range.
+        m_sorted.resize(m_offsets[m_width]);
+        std::vector<size_t> cursors(m_offsets.begin(), m_offsets.end() - 1);
+        for (size_t idx = 0; idx < n_points; ++idx)
+        {
+            if (bins[idx] >= 0 && bins[idx] < int(m_width))
+            {
+                m_sorted[cursors[bins[idx]]++] = idx;
+            }
+            else
+            {
+                m_outside.push_back(idx);
+            }
+        }
+    }
+
+    //! Get the points that may contribute to the slabs in [begin, end).
+    void getPoints(unsigned int begin, unsigned int end, std::vector<size_t>& points) const
+    {
+        points.clear();
+        for (unsigned int slab = 0; slab < m_width; ++slab)
+        {
+            if (isNear(slab, begin, end))
+            {
+                points.insert(points.end(), m_sorted.begin() + m_offsets[slab],
+                              m_sorted.begin() + m_offsets[slab + 1]);
+            }
+        }
+        points.insert(points.end(), m_outside.begin(), m_outside.end());
+    }
+
+    //! Process ranges of slabs in parallel.
+    /*! \param body An object with operator(unsigned int begin, unsigned int end,
+     *         const std::vector<size_t>& points) writing the cells of the slabs in
+     *         [begin, end) given the points that may contribute to them.
+     */
+    template<typename Body> void forEachRange(const Body& body) const
+    {
+        // Ranges of at least 2 * bin_cut + 1 slabs limit the number of ranges
+        // that visit each point to three.
+        const size_t grain_size = 2 * size_t(m_bin_cut) + 1;
+        util::executeInThreadArena([&]() {
+            tbb::parallel_for(tbb::blocked_range<size_t>(0, m_width, grain_size),
+                              [&](const tbb::blocked_range<size_t>& r) {
+                                  std::vector<size_t> points;
+                                  getPoints(r.begin(), r.end(), points);
+                                  body(static_cast<unsigned int>(r.begin()),
+                                       static_cast<unsigned int>(r.end()), points);
+                              });
+        });
+    }
+
+private:
+    //! Whether a point in slab contributes to any of the slabs in [begin, end).
+    bool isNear(unsigned int slab, unsigned int begin, unsigned int end) const
+    {
+        const int lower = int(begin) - m_bin_cut;
+        const int upper = int(end) - 1 + m_bin_cut;
+        if (!m_periodic)
+        {
+            return int(slab) >= lower && int(slab) <= upper;
+        }
+        if (upper - lower + 1 >= int(m_width))
+        {
+            return true;
+        }
+        // Distance from the lower end of the halo to the slab, wrapped into the grid
+        const int shift = ((int(slab) - lower) % int(m_width) + int(m_width)) % int(m_width);
+        return shift <= upper - lower;
+    }
+
+    unsigned int m_width;          //!< Number of slabs
+    int m_bin_cut;                 //!< Number of slabs on either side of a point that it contributes to
+    bool m_periodic;               //!< Whether the grid is periodic along the axis of the slabs
+    std::vector<size_t> m_offsets; //!< Offset of the points of each slab in m_sorted
+    std::vector<size_t> m_sorted;  //!< Indices of the points inside the grid sorted by slab
+    std::vector<size_t> m_outside; //!< Indices of the points outside the grid
+};
+
+}; }; // end namespace freud::density
+
+#endif // GRID_SLABS_H
@@ -1,6 +1,9 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <stdexcept>
+
+#include "GrainTuner.h"
 #include "LocalDensity.h"
 #include "NeighborComputeFunctional.h"
 
@@ -26,49 +29,121 @@ LocalDensity::LocalDensity(float r_max, float diameter)
 
 void LocalDensity::compute(const freud::locality::NeighborQuery* neighbor_query,
                            const vec3<float>* query_points, unsigned int n_query_points,
-                           const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
+                           const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs,
+                           bool aggregate)
 {
     m_box = neighbor_query->getBox();
 
     m_density_array.prepare(n_query_points);
     m_num_neighbors_array.prepare(n_query_points);
 
+    // Count particles that are fully in the r_max sphere, and partially count
+    // particles that intersect the r_max sphere. This is not particularly
+    // accurate for a single particle, but works well on average for lots of
+    // them. It smooths out the neighbor count distributions and avoids noisy
+    // spikes that obscure data.
+    if (nlist != nullptr)
+    {
+        // Sum the counts of the contiguous bonds of each query point directly
+        // from the arrays of the neighbor list.
+        const auto count_neighbors = [&](size_t begin, size_t end) {
+            countNeighbors(*nlist, begin, end, nlist->find_first_index(begin));
+        };
+        static const util::GrainTuner count_tuner("LocalDensity::countNeighbors");
+        util::forLoopWrapper(0, n_query_points, count_neighbors, count_tuner);
+    }
+    else if (aggregate)
+    {
+        // A node of the tree whose points are all farther than a diameter
+        // inside of r_max counts every point fully. The bonds of the other
+        // nodes are counted one by one, as below.
+        const float r_inner = m_r_max - m_diameter / float(2.0);
+        const auto count_bond = [&](const freud::locality::NeighborBond& nb) {
+            m_num_neighbors_array[nb.query_point_idx] += smoothedCount(nb.distance);
+        };
+        freud::locality::loopOverBallNeighborsOrNodes(
+            neighbor_query, query_points, n_query_points, qargs, 2 * r_inner,
+            [&]() {
+                return [&](unsigned int query_point_idx, float /*d_min*/, float d_max,
+                           unsigned int n_node_points) {
+                    if (d_max >= r_inner)
+                    {
+                        return false;
+                    }
+                    m_num_neighbors_array[query_point_idx] += static_cast<float>(n_node_points);
+                    return true;
+                };
+            },
+            [&]() -> const decltype(count_bond)& { return count_bond; });
+    }
+    else
+    {
+        // All bonds of a query point are found by the same task, so the
+        // counts are accumulated without synchronization. Ball queries on
+        // LinkCell and AABBQuery objects are performed in bulk.
+        freud::locality::loopOverNeighbors(
+            neighbor_query, query_points, n_query_points, qargs, nullptr,
+            [&](const freud::locality::NeighborBond& nb) {
+                m_num_neighbors_array[nb.query_point_idx] += smoothedCount(nb.distance);
+            });
+    }
+
+    computeDensity();
+}
+
+void LocalDensity::beginBonds(const freud::locality::NeighborQuery* neighbor_query,
+                              const vec3<float>* /*query_points*/, unsigned int n_query_points,
+                              const freud::locality::NeighborList& /*nlist*/)
+{
+    m_box = neighbor_query->getBox();
+    m_density_array.prepare(n_query_points);
+    m_num_neighbors_array.prepare(n_query_points);
+}
+
+void LocalDensity::consumeBonds(const freud::locality::NeighborList& nlist, size_t begin, size_t end,
+                                size_t first_bond, size_t /*end_bond*/)
+{
+    countNeighbors(nlist, begin, end, first_bond);
+}
+
+void LocalDensity::endBonds(const freud::locality::NeighborList& /*nlist*/)
+{
+    computeDensity();
+}
+
+void LocalDensity::countNeighbors(const freud::locality::NeighborList& nlist, size_t begin, size_t end,
+                                  size_t first_bond)
+{
+    const unsigned int* neighbors = nlist.getNeighbors().get();
+    const float* distances = nlist.getDistances().get();
+    const size_t n_bonds = nlist.getNumBonds();
+    size_t bond = first_bond;
+    for (size_t i = begin; i < end; ++i)
+    {
+        float num_neighbors = 0;
+        for (; bond < n_bonds && neighbors[2 * bond] == i; ++bond)
+        {
+            num_neighbors += smoothedCount(distances[bond]);
+        }
+        m_num_neighbors_array[i] = num_neighbors;
+    }
+}
+
+void LocalDensity::computeDensity()
+{
+    // local density is the area (volume) of particles divided by the area
+    // (volume) of the circle (sphere)
     const float area = M_PI * m_r_max * m_r_max;
     const float volume = static_cast<float>(4.0 / 3.0 * M_PI) * m_r_max * m_r_max * m_r_max;
-    // compute the local density
-    freud::locality::loopOverNeighborsIterator(
-        neighbor_query, query_points, n_query_points, qargs, nlist,
-        [&](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
-            float num_neighbors = 0;
-            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
-            {
-                // count particles that are fully in the r_max sphere
-                if (nb.distance < (m_r_max - m_diameter / float(2.0)))
-                {
-                    num_neighbors += float(1.0);
-                }
-                else
-                {
-                    // partially count particles that intersect the r_max sphere
-                    // this is not particularly accurate for a single particle, but works well on average for
-                    // lots of them. It smooths out the neighbor count distributions and avoids noisy spikes
-                    // that obscure data
-                    num_neighbors
-                        += float(1.0) + (m_r_max - (nb.distance + m_diameter / float(2.0))) / m_diameter;
-                }
-                m_num_neighbors_array[i] = num_neighbors;
-                if (m_box.is2D())
-                {
-                    // local density is area of particles divided by the area of the circle
-                    m_density_array[i] = m_num_neighbors_array[i] / area;
-                }
-                else
-                {
-                    // local density is volume of particles divided by the volume of the sphere
-                    m_density_array[i] = m_num_neighbors_array[i] / volume;
-                }
-            }
-        });
+    const float size = m_box.is2D() ? area : volume;
+    const auto compute_density = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_density_array[i] = m_num_neighbors_array[i] / size;
+        }
+    };
+    static const util::GrainTuner density_tuner("LocalDensity::density");
+    util::forLoopWrapper(0, m_density_array.size(), compute_density, density_tuner);
 }
 
 }; }; // end namespace freud::density
@@ -4,6 +4,7 @@
 #ifndef LOCAL_DENSITY_H
 #define LOCAL_DENSITY_H
 
+#include "BondPipeline.h"
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborList.h"
@@ -19,14 +20,14 @@ namespace freud { namespace density {
 //! Compute the local density at each point
 /*!
  */
-class LocalDensity
+class LocalDensity : public locality::BondStage
 {
 public:
     //! Constructor
     LocalDensity(float r_max, float diameter);
 
     //! Destructor
-    ~LocalDensity() = default;
+    ~LocalDensity() override = default;
 
     //! Get the simulation box
     const box::Box& getBox() const
@@ -47,9 +48,26 @@ public:
     }
 
     //! Compute the local density
+    /*! If aggregate is true and the bonds are found by a ball query of an
+     *  AABBQuery, every node of the tree whose points are all fully inside of
+     *  r_max is counted as a whole without visiting its bonds (see
+     *  AABBQuery::forEachBallNeighborOrNode), which only changes the order
+     *  in which the counts are summed.
+     */
     void compute(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                  unsigned int n_query_points, const freud::locality::NeighborList* nlist,
-                 freud::locality::QueryArgs qargs);
+                 freud::locality::QueryArgs qargs, bool aggregate = false);
+
+    //! Prepare the density of the query points of the bonds consumed by computeBondStages.
+    void beginBonds(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                    unsigned int n_query_points, const freud::locality::NeighborList& nlist) override;
+
+    //! Count the neighbors of a block of query points.
+    void consumeBonds(const freud::locality::NeighborList& nlist, size_t begin, size_t end, size_t first_bond,
+                      size_t end_bond) override;
+
+    //! Compute the density from the counted neighbors.
+    void endBonds(const freud::locality::NeighborList& nlist) override;
 
     //! Get a reference to the last computed density
     const util::ManagedArray<float>& getDensity() const
@@ -64,6 +82,22 @@ public:
     }
 
 private:
+    //! Count particles that are fully in the r_max sphere, and partially count particles that intersect it.
+    float smoothedCount(float distance) const
+    {
+        const float r_inner = m_r_max - m_diameter / float(2.0);
+        return (distance < r_inner)
+            ? float(1.0)
+            : float(1.0) + (m_r_max - (distance + m_diameter / float(2.0))) / m_diameter;
+    }
+
+    //! Sum the counts of the bonds of the query points [begin, end), which start at first_bond.
+    void countNeighbors(const freud::locality::NeighborList& nlist, size_t begin, size_t end,
+                        size_t first_bond);
+
+    //! Compute the density of the query points from their counted neighbors.
+    void computeDensity();
+
     box::Box m_box;   //!< Simulation box where the particles belong
     float m_r_max;    //!< Maximum neighbor distance
     float m_diameter; //!< Diameter of the particles
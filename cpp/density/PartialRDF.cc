@@ -0,0 +1,178 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <stdexcept>
+
+#include "PartialRDF.h"
+
+/*! \file PartialRDF.cc
+    \brief Routines for computing partial radial density functions of all pairs of types.
+*/
+
+namespace freud { namespace density {
+
+namespace {
+//! Count the points of each type, checking that all types are valid.
+std::vector<unsigned int> countTypes(const unsigned int* types, unsigned int n, unsigned int num_types)
+{
+    std::vector<unsigned int> counts(num_types, 0);
+    for (unsigned int i = 0; i < n; ++i)
+    {
+        if (types[i] >= num_types)
+        {
+            throw std::invalid_argument("PartialRDF requires all types to be less than num_types.");
+        }
+        ++counts[types[i]];
+    }
+    return counts;
+}
+} // namespace
+
+PartialRDF::PartialRDF(unsigned int num_types, unsigned int bins, float r_max, float r_min, bool normalize)
+    : BondHistogramCompute(), m_num_types(num_types), m_normalize(normalize)
+{
+    if (num_types == 0)
+    {
+        throw std::invalid_argument("PartialRDF requires a nonzero number of types.");
+    }
+    if (bins == 0)
+    {
+        throw std::invalid_argument("PartialRDF requires a nonzero number of bins.");
+    }
+    if (r_max <= 0)
+    {
+        throw std::invalid_argument("PartialRDF requires r_max to be positive.");
+    }
+    if (r_min < 0)
+    {
+        throw std::invalid_argument("PartialRDF requires r_min to be non-negative.");
+    }
+    if (r_max <= r_min)
+    {
+        throw std::invalid_argument("PartialRDF requires that r_max must be greater than r_min.");
+    }
+
+    // The types are binned on unit-width axes, so that the histogram stores
+    // the counts of bond distances of each pair of types contiguously.
+    const auto type_axis = std::make_shared<util::RegularAxis>(num_types, 0, static_cast<float>(num_types));
+    const auto axes
+        = util::Axes {type_axis, type_axis, std::make_shared<util::RegularAxis>(bins, r_min, r_max)};
+    m_histogram = BondHistogram(axes);
+    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+
+    // Precompute the cell volumes to speed up later calculations.
+    m_vol_array2D.prepare(bins);
+    m_vol_array3D.prepare(bins);
+    float volume_prefactor = (float(4.0) / float(3.0)) * M_PI;
+    std::vector<float> bin_boundaries = getBinEdges()[2];
+
+    for (unsigned int i = 0; i < bins; i++)
+    {
+        float r = bin_boundaries[i];
+        float nextr = bin_boundaries[i + 1];
+        m_vol_array2D[i] = M_PI * (nextr * nextr - r * r);
+        m_vol_array3D[i] = volume_prefactor * (nextr * nextr * nextr - r * r * r);
+    }
+}
+
+void PartialRDF::reduce()
+{
+    const auto shape = getAxisSizes();
+    const size_t bins = shape[2];
+    m_pcf.prepare(shape);
+    m_histogram.prepare(shape);
+    m_N_r.prepare(shape);
+
+    const util::ManagedArray<float>& vol_array = m_box.is2D() ? m_vol_array2D : m_vol_array3D;
+
+    // The normalization is computed in the precision of the accumulation.
+    util::dispatchAccumulator(false, [&](auto zero) {
+        using Accumulator = decltype(zero);
+        const auto nf = static_cast<Accumulator>(m_frame_counter);
+        const auto volume = static_cast<Accumulator>(m_box.getVolume());
+
+        // Each partial RDF is normalized by the number of query points of the
+        // first type and the number density of points of the second type. Pairs
+        // of types without points are left at zero.
+        std::vector<Accumulator> pcf_prefactor(m_num_types * m_num_types, 0);
+        std::vector<Accumulator> nr_prefactor(m_num_types * m_num_types, 0);
+        for (unsigned int a = 0; a < m_num_types; ++a)
+        {
+            const auto nqp = static_cast<Accumulator>(m_n_query_points_of_type[a]);
+            for (unsigned int b = 0; b < m_num_types; ++b)
+            {
+                const auto np = static_cast<Accumulator>(m_n_points_of_type[b]);
+                if (nqp == 0 || np == 0)
+                {
+                    continue;
+                }
+                Accumulator number_density = np / volume;
+                if (m_normalize && a == b)
+                {
+                    number_density *= (np - Accumulator(1.0)) / np;
+                }
+                pcf_prefactor[a * m_num_types + b] = Accumulator(1.0) / (nqp * number_density * nf);
+                nr_prefactor[a * m_num_types + b] = Accumulator(1.0) / (nqp * nf);
+            }
+        }
+
+        m_histogram.reduceOverThreadsPerBin(m_local_histograms, [&](size_t i) {
+            m_pcf[i] = static_cast<float>(static_cast<Accumulator>(m_histogram[i]) * pcf_prefactor[i / bins]
+                                          / static_cast<Accumulator>(vol_array[i % bins]));
+        });
+
+        // The accumulation of the cumulative density must be performed in
+        // sequence, so it is done after the reduction.
+        for (size_t pair = 0; pair < pcf_prefactor.size(); ++pair)
+        {
+            const size_t offset = pair * bins;
+            Accumulator N_r = static_cast<Accumulator>(m_histogram[offset]) * nr_prefactor[pair];
+            m_N_r[offset] = static_cast<float>(N_r);
+            for (size_t i = 1; i < bins; i++)
+            {
+                N_r += static_cast<Accumulator>(m_histogram[offset + i]) * nr_prefactor[pair];
+                m_N_r[offset + i] = static_cast<float>(N_r);
+            }
+        }
+    });
+}
+
+void PartialRDF::accumulate(const freud::locality::NeighborQuery* neighbor_query,
+                            const unsigned int* point_types, const vec3<float>* query_points,
+                            const unsigned int* query_point_types, unsigned int n_query_points,
+                            const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
+{
+    m_n_points_of_type = countTypes(point_types, neighbor_query->getNPoints(), m_num_types);
+    m_n_query_points_of_type = countTypes(query_point_types, n_query_points, m_num_types);
+
+    // Each bond of a half neighbor list also stands for its reverse bond,
+    // which connects the types in the opposite order.
+    const bool half_list = freud::locality::isHalfList(neighbor_query, query_points, n_query_points, nlist, qargs);
+
+    const size_t bins = getAxisSizes()[2];
+    const auto bounds = getBounds()[2];
+    const util::RegularAxis axis(bins, bounds.first, bounds.second);
+    const size_t num_types = m_num_types;
+    const auto make_cf = [&]() {
+        auto& local_histogram = m_local_histograms.local();
+        return [&local_histogram, &axis, point_types, query_point_types, num_types, bins,
+                half_list](const freud::locality::NeighborBond& neighbor_bond) {
+            const size_t bin = axis.bin(neighbor_bond.distance);
+            if (bin == util::Axis::OVERFLOW_BIN)
+            {
+                return;
+            }
+            const size_t query_type = query_point_types[neighbor_bond.query_point_idx];
+            const size_t point_type = point_types[neighbor_bond.point_idx];
+            local_histogram.increment((query_type * num_types + point_type) * bins + bin);
+            if (half_list)
+            {
+                local_histogram.increment((point_type * num_types + query_type) * bins + bin);
+            }
+        };
+    };
+    accumulateGeneralRanges(neighbor_query, query_points, n_query_points, nlist, qargs, make_cf,
+                            freud::locality::HalfListPolicy::symmetric);
+}
+
+}; }; // end namespace freud::density
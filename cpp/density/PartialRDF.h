@@ -0,0 +1,87 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef PARTIAL_RDF_H
+#define PARTIAL_RDF_H
+
+#include <vector>
+
+#include "BondHistogramCompute.h"
+#include "Box.h"
+#include "Histogram.h"
+
+/*! \file PartialRDF.h
+    \brief Routines for computing partial radial density functions of all pairs of types.
+*/
+
+namespace freud { namespace density {
+
+//! Computes the partial RDFs of all pairs of point types in a single pass over the bonds.
+/*! The histogram has the axes (query point type, point type, distance), so
+ *  that all partial RDFs are accumulated during one neighbor traversal. The
+ *  partial RDF of types a and b is normalized by the number of query points
+ *  of type a and the number density of points of type b.
+ */
+class PartialRDF : public locality::BondHistogramCompute
+{
+public:
+    //! Constructor
+    PartialRDF(unsigned int num_types, unsigned int bins, float r_max, float r_min = 0,
+               bool normalize = false);
+
+    //! Destructor
+    ~PartialRDF() override = default;
+
+    //! Compute the partial RDFs
+    /*! Accumulate the given points to the histogram. Accumulation is performed
+     * in parallel on thread-local copies of the data, which are reduced into
+     * the primary data arrays when the user requests outputs.
+     */
+    void accumulate(const freud::locality::NeighborQuery* neighbor_query, const unsigned int* point_types,
+                    const vec3<float>* query_points, const unsigned int* query_point_types,
+                    unsigned int n_query_points, const freud::locality::NeighborList* nlist,
+                    freud::locality::QueryArgs qargs);
+
+    //! Reduce thread-local arrays onto the primary data arrays.
+    void reduce() override;
+
+    //! Get the number of point types.
+    unsigned int getNumTypes() const
+    {
+        return m_num_types;
+    }
+
+    //! Get the partial RDFs, indexed by query point type, point type, and bin.
+    const util::ManagedArray<float>& getRDF()
+    {
+        return reduceAndReturn(m_pcf);
+    }
+
+    //! Get a reference to the N_r array.
+    /*! Mathematically, m_N_r(a, b, i) is the average number of points of type
+     * b contained within a ball of radius getBinEdges()[2][i+1] centered at a
+     * query_point of type a, averaged over all query_points of type a.
+     */
+    const util::ManagedArray<float>& getNr()
+    {
+        return reduceAndReturn(m_N_r);
+    }
+
+private:
+    unsigned int m_num_types;                     //!< Number of point types.
+    bool m_normalize;                             //!< Whether to enforce that the partial RDFs of
+                                                  //!< identical types should tend to 1.
+    std::vector<unsigned int> m_n_points_of_type; //!< Number of points of each type.
+    std::vector<unsigned int> m_n_query_points_of_type; //!< Number of query points of each type.
+    util::ManagedArray<float> m_pcf;                    //!< The computed partial pair correlation functions.
+    util::ManagedArray<float>
+        m_N_r; //!< Cumulative bin sums N(r) (the average number of points in a ball of radius r).
+    util::ManagedArray<float>
+        m_vol_array2D; //!< Areas of concentric rings corresponding to the histogram bins in 2D.
+    util::ManagedArray<float>
+        m_vol_array3D; //!< Areas of concentric spherical shells corresponding to the histogram bins in 3D.
+};
+
+}; }; // end namespace freud::density
+
+#endif // PARTIAL_RDF_H
@@ -1,9 +1,12 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "RDF.h"
+#include "Instrumentation.h"
+#include "NeighborComputeFunctional.h"
 
 /*! \file RDF.cc
     \brief Routines for computing radial density functions.
@@ -32,7 +35,8 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
     }
 
     // Construct the Histogram object that will be used to keep track of counts of bond distances found.
-    const auto axes = util::Axes {std::make_shared<util::RegularAxis>(bins, r_min, r_max)};
+    m_distance_axis = std::make_shared<util::RegularAxis>(bins, r_min, r_max);
+    const auto axes = util::Axes {m_distance_axis};
     m_histogram = BondHistogram(axes);
     m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
 
@@ -53,44 +57,227 @@ RDF::RDF(unsigned int bins, float r_max, float r_min, bool normalize)
 
 void RDF::reduce()
 {
+    const util::ScopedPhase phase("RDF::reduce");
+    const util::ScopedMemoryOwner owner("RDF");
     m_pcf.prepare(getAxisSizes()[0]);
     m_histogram.prepare(getAxisSizes()[0]);
     m_N_r.prepare(getAxisSizes()[0]);
 
-    // Define prefactors with appropriate types to simplify and speed later code.
-    auto const nqp = static_cast<float>(m_n_query_points);
-    float number_density = nqp / m_box.getVolume();
-    if (m_normalize)
+    // The normalization is computed in the precision of the accumulation,
+    // since bin counts of more than 2^24 bonds are not exact in single
+    // precision.
+    util::dispatchAccumulator(false, [&](auto zero) {
+        using Accumulator = decltype(zero);
+
+        // Define prefactors with appropriate types to simplify and speed later code.
+        auto const nqp = static_cast<Accumulator>(m_n_query_points);
+        Accumulator number_density = nqp / static_cast<Accumulator>(m_box.getVolume());
+        if (m_normalize)
+        {
+            number_density *= static_cast<Accumulator>(m_n_query_points - 1)
+                / static_cast<Accumulator>(m_n_query_points);
+        }
+        auto np = static_cast<Accumulator>(m_n_points);
+        auto nf = static_cast<Accumulator>(m_frame_counter);
+        Accumulator prefactor = Accumulator(1.0) / (np * number_density * nf);
+
+        util::ManagedArray<float> vol_array = m_box.is2D() ? m_vol_array2D : m_vol_array3D;
+        m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &vol_array](size_t i) {
+            m_pcf[i] = static_cast<float>(static_cast<Accumulator>(m_histogram[i]) * prefactor
+                                          / static_cast<Accumulator>(vol_array[i]));
+        });
+
+        // The accumulation of the cumulative density must be performed in
+        // sequence, so it is done after the reduction.
+        prefactor = Accumulator(1.0) / (nqp * static_cast<Accumulator>(m_frame_counter));
+        Accumulator N_r = static_cast<Accumulator>(m_histogram[0]) * prefactor;
+        m_N_r[0] = static_cast<float>(N_r);
+        for (unsigned int i = 1; i < getAxisSizes()[0]; i++)
+        {
+            N_r += static_cast<Accumulator>(m_histogram[i]) * prefactor;
+            m_N_r[i] = static_cast<float>(N_r);
+        }
+    });
+}
+
+void RDF::accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                     unsigned int n_query_points, const freud::locality::NeighborList* nlist,
+                     freud::locality::QueryArgs qargs, bool aggregate)
+{
+    const util::ScopedPhase phase("RDF::accumulate");
+    const util::ScopedMemoryOwner owner("RDF");
+
+    // Each bond of a half neighbor list also stands for its reverse bond.
+    const unsigned int bond_count
+        = freud::locality::isHalfList(neighbor_query, query_points, n_query_points, nlist, qargs) ? 2 : 1;
+
+    // Bin with a concrete copy of the regular distance axis, which avoids the
+    // virtual call and the temporary vectors of Histogram::bin for each bond
+    // while giving identical bins. The thread local histogram is looked up
+    // once for each range of bonds rather than for each bond.
+    const auto bounds = m_histogram.getBounds()[0];
+    const util::RegularAxis axis(getAxisSizes()[0], bounds.first, bounds.second);
+    const auto make_bond_cf = [&]() {
+        auto& local_histogram = m_local_histograms.local();
+        return [&local_histogram, &axis, bond_count](const freud::locality::NeighborBond& neighbor_bond) {
+            local_histogram.increment(axis.bin(neighbor_bond.distance), bond_count);
+        };
+    };
+    if (!aggregate || nlist != nullptr)
     {
-        number_density *= static_cast<float>(m_n_query_points - 1) / static_cast<float>(m_n_query_points);
+        accumulateGeneralRanges(neighbor_query, query_points, n_query_points, nlist, qargs, make_bond_cf,
+                                freud::locality::HalfListPolicy::symmetric);
+        return;
     }
-    auto np = static_cast<float>(m_n_points);
-    auto nf = static_cast<float>(m_frame_counter);
-    float prefactor = float(1.0) / (np * number_density * nf);
 
-    util::ManagedArray<float> vol_array = m_box.is2D() ? m_vol_array2D : m_vol_array3D;
-    m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &vol_array](size_t i) {
-        m_pcf[i] = m_histogram[i] * prefactor / vol_array[i];
-    });
+    // A node of the tree whose bond distances all fall into one bin adds all
+    // of its points to that bin at once, and a node whose bond distances all
+    // fall outside of the histogram is skipped.
+    // Half neighbor lists are not aggregated, so every bond is counted once.
+    m_box = neighbor_query->getBox();
+    // Only nodes whose diagonal is shorter than a bin are offered, since the
+    // distances to the points of larger nodes rarely fall into a single bin.
+    const float bin_width = (bounds.second - bounds.first) / static_cast<float>(getAxisSizes()[0]);
+    freud::locality::loopOverBallNeighborsOrNodes(
+        neighbor_query, query_points, n_query_points, qargs, bin_width,
+        [&]() {
+            auto& local_histogram = m_local_histograms.local();
+            return [&local_histogram, &axis, &bounds](unsigned int /*query_point_idx*/, float d_min,
+                                                      float d_max, unsigned int n_node_points) {
+                if (d_max < bounds.first || d_min >= bounds.second)
+                {
+                    return true;
+                }
+                const size_t bin = axis.bin(d_min);
+                if (bin == util::Axis::OVERFLOW_BIN || bin != axis.bin(d_max))
+                {
+                    return false;
+                }
+                local_histogram.increment(bin, n_node_points);
+                return true;
+            };
+        },
+        make_bond_cf, freud::locality::HalfListPolicy::symmetric);
+    finishFrame(neighbor_query, n_query_points);
+}
+
+void RDF::beginBonds(const freud::locality::NeighborQuery* neighbor_query,
+                     const vec3<float>* query_points, unsigned int n_query_points,
+                     const freud::locality::NeighborList& nlist)
+{
+    m_box = neighbor_query->getBox();
+    m_stage_neighbor_query = neighbor_query;
+    m_stage_n_query_points = n_query_points;
+    // Each bond of a half neighbor list also stands for its reverse bond.
+    const bool half_list = freud::locality::isHalfList(neighbor_query, query_points, n_query_points, &nlist,
+                                                       freud::locality::QueryArgs());
+    m_stage_bond_count = half_list ? 2 : 1;
+}
 
-    // The accumulation of the cumulative density must be performed in
-    // sequence, so it is done after the reduction.
-    prefactor = float(1.0) / (nqp * static_cast<float>(m_frame_counter));
-    m_N_r[0] = m_histogram[0] * prefactor;
-    for (unsigned int i = 1; i < getAxisSizes()[0]; i++)
+void RDF::consumeBonds(const freud::locality::NeighborList& nlist, size_t /*begin*/, size_t /*end*/,
+                       size_t first_bond, size_t end_bond)
+{
+    auto& local_histogram = m_local_histograms.local();
+    const float* distances = nlist.getDistances().get();
+    for (size_t bond = first_bond; bond < end_bond; ++bond)
     {
-        m_N_r[i] = m_N_r[i - 1] + m_histogram[i] * prefactor;
+        // The qualified call avoids the virtual call of Axis::bin for each bond.
+        local_histogram.increment(m_distance_axis->util::RegularAxis::bin(distances[bond]),
+                                  m_stage_bond_count);
     }
 }
 
-void RDF::accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
-                     unsigned int n_query_points, const freud::locality::NeighborList* nlist,
-                     freud::locality::QueryArgs qargs)
+void RDF::endBonds(const freud::locality::NeighborList& /*nlist*/)
 {
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          m_local_histograms(neighbor_bond.distance);
-                      });
+    finishFrame(m_stage_neighbor_query, m_stage_n_query_points);
+}
+
+unsigned int RDF::accumulateFrames(const freud::locality::FrameReader& read_frame,
+                                   freud::locality::QueryArgs qargs)
+{
+    return freud::locality::accumulateFrames(
+        read_frame,
+        [this, &qargs](const freud::locality::NeighborQuery* neighbor_query) {
+            accumulate(neighbor_query, neighbor_query->getPoints(), neighbor_query->getNPoints(), nullptr,
+                       qargs);
+        },
+        true);
+}
+
+void RDF::accumulateSlabs(const freud::locality::SlabDecomposition& slabs, freud::locality::QueryArgs qargs)
+{
+    if (qargs.mode != freud::locality::QueryType::ball || qargs.r_max > slabs.getHalo())
+    {
+        throw std::invalid_argument("RDF::accumulateSlabs requires a ball query whose r_max is at most "
+                                    "the width of the halos of the slabs.");
+    }
+    const unsigned int frame_counter = m_frame_counter;
+    slabs.accumulate([this, &qargs](const freud::locality::NeighborQuery* neighbor_query,
+                                    const freud::locality::Slab& slab) {
+        accumulate(neighbor_query, neighbor_query->getPoints(), slab.n_core, nullptr, qargs);
+    });
+
+    // The slabs are a single frame of all points.
+    m_box = slabs.getBox();
+    m_frame_counter = frame_counter + 1;
+    m_n_points = static_cast<unsigned int>(slabs.getNPoints());
+    m_n_query_points = m_n_points;
+    m_reduce = true;
+}
+
+void RDF::accumulateSystems(const freud::locality::SystemBatch& batch, freud::locality::QueryArgs qargs)
+{
+    const util::ScopedPhase phase("RDF::accumulateSystems");
+    const util::ScopedMemoryOwner owner("RDF");
+    const unsigned int bins = getAxisSizes()[0];
+    const auto bounds = m_histogram.getBounds()[0];
+    m_system_pcf.prepare({batch.getNumSystems(), bins});
+    m_system_N_r.prepare({batch.getNumSystems(), bins});
+    m_system_bin_counts.prepare({batch.getNumSystems(), bins});
+
+    // Every system is accumulated by its own RDF object, since the systems
+    // are accumulated concurrently, and its bin counts are added to the
+    // histogram as a frame.
+    batch.forEachSystem([&](unsigned int system, const freud::locality::NeighborQuery* neighbor_query) {
+        RDF rdf(bins, bounds.second, bounds.first, m_normalize);
+        rdf.accumulate(neighbor_query, neighbor_query->getPoints(), neighbor_query->getNPoints(), nullptr,
+                       qargs);
+        const util::ManagedArray<float>& pcf = rdf.getRDF();
+        const util::ManagedArray<float>& N_r = rdf.getNr();
+        const util::ManagedArray<unsigned int>& bin_counts = rdf.getBinCounts();
+        std::copy(pcf.get(), pcf.get() + bins, &m_system_pcf(system, 0));
+        std::copy(N_r.get(), N_r.get() + bins, &m_system_N_r(system, 0));
+        std::copy(bin_counts.get(), bin_counts.get() + bins, &m_system_bin_counts(system, 0));
+        for (unsigned int bin = 0; bin < bins; ++bin)
+        {
+            if (bin_counts[bin] != 0)
+            {
+                m_local_histograms.increment(bin, bin_counts[bin]);
+            }
+        }
+    });
+
+    // The normalization of the frames uses the box and number of points of
+    // the last system, as for the last accumulated frame.
+    for (unsigned int system = batch.getNumSystems(); system > 0; --system)
+    {
+        const freud::locality::NeighborQuery* neighbor_query = batch.getNeighborQuery(system - 1);
+        if (neighbor_query != nullptr)
+        {
+            m_box = neighbor_query->getBox();
+            m_n_points = neighbor_query->getNPoints();
+            m_n_query_points = m_n_points;
+            break;
+        }
+    }
+    for (unsigned int system = 0; system < batch.getNumSystems(); ++system)
+    {
+        if (batch.getNeighborQuery(system) != nullptr)
+        {
+            ++m_frame_counter;
+        }
+    }
+    m_reduce = true;
 }
 
 }; }; // end namespace freud::density
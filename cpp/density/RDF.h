@@ -5,15 +5,19 @@
 #define RDF_H
 
 #include "BondHistogramCompute.h"
+#include "BondPipeline.h"
 #include "Box.h"
+#include "FramePipeline.h"
 #include "Histogram.h"
+#include "SlabDecomposition.h"
+#include "SystemBatch.h"
 
 /*! \file RDF.h
     \brief Routines for computing radial density functions.
 */
 
 namespace freud { namespace density {
-class RDF : public locality::BondHistogramCompute
+class RDF : public locality::BondHistogramCompute, public locality::BondStage
 {
 public:
     //! Constructor
@@ -26,10 +30,66 @@ public:
     /*! Accumulate the given points to the histogram. Accumulation is performed
      * in parallel on thread-local copies of the data, which are reduced into
      * the primary data arrays when the user requests outputs.
+     *
+     * If aggregate is true and the bonds are found by a ball query of an
+     * AABBQuery, every node of the tree whose bond distances all fall into
+     * one bin is added to that bin as a whole without visiting its bonds
+     * (see AABBQuery::forEachBallNeighborOrNode). The bin counts are the
+     * same, but the number of bonds visited for large r_max with wide bins
+     * grows with the area of the bin edges rather than the volume of the ball.
      */
     void accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                     unsigned int n_query_points, const freud::locality::NeighborList* nlist,
-                    freud::locality::QueryArgs qargs);
+                    freud::locality::QueryArgs qargs, bool aggregate = false);
+
+    //! Accumulate the RDF of each frame read from a trajectory.
+    /*! Each frame is accumulated with its points as query points, and the
+     *  next frame is read and its AABBQuery is built while the current one is
+     *  accumulated.
+     *
+     *  \return The number of frames accumulated.
+     */
+    unsigned int accumulateFrames(const freud::locality::FrameReader& read_frame,
+                                  freud::locality::QueryArgs qargs);
+
+    //! Accumulate the RDF of a point set slab by slab.
+    /*! The points of each slab are the query points, so the bonds of every
+     *  point are accumulated once and the result is that of accumulate with
+     *  all points as query points, accumulated as a single frame. The width
+     *  of the halos of the slabs must be at least r_max.
+     *
+     *  \param slabs Decomposition of the point set into slabs.
+     *  \param qargs Query arguments, which must be those of a ball query.
+     */
+    void accumulateSlabs(const freud::locality::SlabDecomposition& slabs, freud::locality::QueryArgs qargs);
+
+    //! Compute the RDF of every system of a batch.
+    /*! The RDF of each system, with its points as query points, is stored in
+     *  getSystemRDF, getSystemNr and getSystemBinCounts. The systems are also
+     *  accumulated to the histogram as frames, as if accumulate was called
+     *  for each system in order.
+     *
+     *  \param batch The systems.
+     *  \param qargs Query arguments of every system.
+     */
+    void accumulateSystems(const freud::locality::SystemBatch& batch, freud::locality::QueryArgs qargs);
+
+    //! Each bond of a half neighbor list is counted for both directions.
+    bool acceptsHalfLists() const override
+    {
+        return true;
+    }
+
+    //! Prepare the accumulation of the bonds consumed by computeBondStages as a frame.
+    void beginBonds(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                    unsigned int n_query_points, const freud::locality::NeighborList& nlist) override;
+
+    //! Add the bonds of a block of query points to the histogram.
+    void consumeBonds(const freud::locality::NeighborList& nlist, size_t begin, size_t end, size_t first_bond,
+                      size_t end_bond) override;
+
+    //! Count the frame of the consumed bonds.
+    void endBonds(const freud::locality::NeighborList& nlist) override;
 
     //! Reduce thread-local arrays onto the primary data arrays.
     void reduce() override;
@@ -50,6 +110,24 @@ public:
         return reduceAndReturn(m_N_r);
     }
 
+    //! Get the positional correlation function of each system of the last call to accumulateSystems.
+    const util::ManagedArray<float>& getSystemRDF() const
+    {
+        return m_system_pcf;
+    }
+
+    //! Get the N_r array of each system of the last call to accumulateSystems.
+    const util::ManagedArray<float>& getSystemNr() const
+    {
+        return m_system_N_r;
+    }
+
+    //! Get the bin counts of each system of the last call to accumulateSystems.
+    const util::ManagedArray<unsigned int>& getSystemBinCounts() const
+    {
+        return m_system_bin_counts;
+    }
+
 private:
     bool m_normalize;                //!< Whether to enforce that the RDF should tend to 1 (instead of
                                      //!< num_query_points/num_points).
@@ -60,6 +138,13 @@ private:
         m_vol_array2D; //!< Areas of concentric rings corresponding to the histogram bins in 2D.
     util::ManagedArray<float>
         m_vol_array3D; //!< Areas of concentric spherical shells corresponding to the histogram bins in 3D.
+    util::ManagedArray<float> m_system_pcf;                //!< The pair correlation function of each system.
+    util::ManagedArray<float> m_system_N_r;                //!< Cumulative bin sum N(r) of each system.
+    util::ManagedArray<unsigned int> m_system_bin_counts; //!< Bin counts of each system.
+    std::shared_ptr<util::RegularAxis> m_distance_axis;   //!< The axis of the bond distances.
+    const freud::locality::NeighborQuery* m_stage_neighbor_query {nullptr}; //!< Points of the consumed bonds
+    unsigned int m_stage_n_query_points {0}; //!< Number of query points of the consumed bonds
+    unsigned int m_stage_bond_count {1};     //!< Number of bonds counted for each consumed bond
 };
 
 }; }; // end namespace freud::density
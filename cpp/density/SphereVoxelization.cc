@@ -3,7 +3,9 @@
 
 #include <cmath>
 #include <stdexcept>
+#include <vector>
 
+#include "GridSlabs.h"
 #include "SphereVoxelization.h"
 
 /*! \file SphereVoxelization.cc
@@ -12,8 +14,8 @@
 
 namespace freud { namespace density {
 
-SphereVoxelization::SphereVoxelization(vec3<unsigned int> width, float r_max)
-    : m_box(), m_width(width), m_r_max(r_max), m_has_computed(false)
+SphereVoxelization::SphereVoxelization(vec3<unsigned int> width, float r_max, bool packed)
+    : m_box(), m_width(width), m_r_max(r_max), m_has_computed(false), m_packed(packed)
 {
     if (r_max <= 0)
     {
@@ -27,6 +29,12 @@ const util::ManagedArray<unsigned int>& SphereVoxelization::getVoxels() const
     return m_voxels_array;
 }
 
+//! Get a reference to the last computed voxels packed into bits.
+const util::ManagedArray<unsigned char>& SphereVoxelization::getPackedVoxels() const
+{
+    return m_packed_voxels_array;
+}
+
 //! Get width.
 vec3<unsigned int> SphereVoxelization::getWidth() const
 {
@@ -58,7 +66,17 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
         m_width.z = 1;
     }
 
-    m_voxels_array.prepare({m_width.x, m_width.y, m_width.z});
+    // Each slab along x is packed into its own bytes, so the bytes of a slab
+    // are only written by the task that owns the slab.
+    const size_t slab_size = size_t(m_width.y) * m_width.z;
+    if (m_packed)
+    {
+        m_packed_voxels_array.prepare({m_width.x, (slab_size + 7) / 8});
+    }
+    else
+    {
+        m_voxels_array.prepare({m_width.x, m_width.y, m_width.z});
+    }
 
     // set up some constants first
     const float Lx = m_box.getLx();
@@ -76,9 +94,14 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
     const int bin_cut_z = m_box.is2D() ? 0 : int(m_r_max / grid_size_z);
     const float r_max_sq = m_r_max * m_r_max;
 
-    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
-        // for each reference point
-        for (size_t idx = begin; idx < end; ++idx)
+    // Each range of slabs along x is written by a single task, so every voxel
+    // is written by one thread.
+    GridSlabs slabs(m_width.x, bin_cut_x, periodic.x);
+    slabs.sort(n_points, [&](size_t idx) { return int(((*nq)[idx].x + Lx / float(2.0)) / grid_size_x); });
+
+    slabs.forEachRange([&](unsigned int slab_begin, unsigned int slab_end, const std::vector<size_t>& points) {
+        // for each reference point near the slabs
+        for (const size_t idx : points)
         {
             const vec3<float> point = (*nq)[idx];
             // Find which bin the particle is in
@@ -113,6 +136,15 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
                         {
                             continue;
                         }
+                        // Assure that out of range indices are corrected for storage
+                        // in the array i.e. bin -1 is actually bin 29 for nbins = 30
+                        const unsigned int ni = (i + m_width.x) % m_width.x;
+
+                        // Only write the slabs owned by this task
+                        if (ni < slab_begin || ni >= slab_end)
+                        {
+                            continue;
+                        }
                         const float dx = ((grid_size_x * static_cast<float>(i)) + (grid_size_x / 2.0f)
                                           - point.x - (Lx / float(2.0)));
 
@@ -124,15 +156,19 @@ void SphereVoxelization::compute(const freud::locality::NeighborQuery* nq)
                         // Check to see if this distance is within the specified r_max
                         if (r_sq < r_max_sq)
                         {
-                            // Assure that out of range indices are corrected for storage
-                            // in the array i.e. bin -1 is actually bin 29 for nbins = 30
-                            const unsigned int ni = (i + m_width.x) % m_width.x;
                             const unsigned int nj = (j + m_width.y) % m_width.y;
                             const unsigned int nk = (k + m_width.z) % m_width.z;
 
-                            // This array value could be written by multiple threads in parallel.
-                            // This is only safe because all threads are writing the same value (1).
-                            m_voxels_array(ni, nj, nk) = 1;
+                            if (m_packed)
+                            {
+                                const size_t bit = size_t(nj) * m_width.z + nk;
+                                m_packed_voxels_array(ni, bit / 8)
+                                    |= static_cast<unsigned char>(0x80U >> (bit % 8));
+                            }
+                            else
+                            {
+                                m_voxels_array(ni, nj, nk) = 1;
+                            }
                         }
                     }
                 }
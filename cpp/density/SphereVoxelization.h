@@ -22,12 +22,17 @@ namespace freud { namespace density {
     otherwise. The dimensions of the grid are set in the constructor, and can
     either be set equally for all dimensions or for each dimension
     independently.
+
+    In packed mode, the voxels are stored with one bit per voxel instead of
+    being written to a dense array. The bits of the voxels in each slab of
+    the grid along x are packed in row-major order into bytes, with the first
+    voxel in the most significant bit, which matches numpy.packbits.
 */
 class SphereVoxelization
 {
 public:
     //! Constructor
-    SphereVoxelization(vec3<unsigned int> width, float r_max);
+    SphereVoxelization(vec3<unsigned int> width, float r_max, bool packed = false);
 
     // Destructor
     ~SphereVoxelization() = default;
@@ -50,6 +55,15 @@ public:
     //! Get a reference to the last computed voxels.
     const util::ManagedArray<unsigned int>& getVoxels() const;
 
+    //! Get a reference to the last computed voxels packed into bits, with shape (w_x, ceil(w_y * w_z / 8)).
+    const util::ManagedArray<unsigned char>& getPackedVoxels() const;
+
+    //! Whether the voxels are stored packed into bits.
+    bool isPacked() const
+    {
+        return m_packed;
+    }
+
     vec3<unsigned int> getWidth() const;
 
 private:
@@ -57,8 +71,10 @@ private:
     vec3<unsigned int> m_width; //!< Number of bins in the grid in each dimension.
     float m_r_max;              //!< Sphere radius used for voxelization.
     bool m_has_computed;        //!< Tracks whether a call to compute has been made.
+    bool m_packed;              //!< Whether the voxels are stored packed into bits.
 
-    util::ManagedArray<unsigned int> m_voxels_array; //! Computed voxels array.
+    util::ManagedArray<unsigned int> m_voxels_array;         //! Computed voxels array.
+    util::ManagedArray<unsigned char> m_packed_voxels_array; //! Computed voxels packed into bits.
 };
 
 }; }; // end namespace freud::density
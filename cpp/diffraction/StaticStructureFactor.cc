@@ -22,4 +22,14 @@ StaticStructureFactor::StaticStructureFactor(unsigned int bins, float k_max, flo
     // lowest bin center, not the lowest bin's lower edge.
 }
 
+unsigned int StaticStructureFactor::accumulateFrames(const freud::locality::FrameReader& read_frame)
+{
+    return freud::locality::accumulateFrames(
+        read_frame,
+        [this](const freud::locality::NeighborQuery* neighbor_query) {
+            accumulate(neighbor_query, nullptr, 0, neighbor_query->getNPoints());
+        },
+        false);
+}
+
 }; }; // namespace freud::diffraction
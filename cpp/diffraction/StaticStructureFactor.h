@@ -7,6 +7,7 @@
 #include <limits>
 #include <vector>
 
+#include "FramePipeline.h"
 #include "Histogram.h"
 #include "ManagedArray.h"
 #include "NeighborQuery.h"
@@ -34,6 +35,15 @@ public:
 
     virtual void reset() = 0;
 
+    //! Accumulate the structure factor of each frame read from a trajectory.
+    /*! Each frame is accumulated as if passed to accumulate without query
+     *  points, and the next frame is read while the current one is
+     *  accumulated.
+     *
+     *  \return The number of frames accumulated.
+     */
+    unsigned int accumulateFrames(const freud::locality::FrameReader& read_frame);
+
     //! Get the structure factor
     const util::ManagedArray<float>& getStructureFactor()
     {
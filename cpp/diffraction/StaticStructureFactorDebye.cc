@@ -8,9 +8,12 @@
 #include <cmath>
 #include <limits>
 #include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
 
+#include "Instrumentation.h"
 #include "NeighborQuery.h"
 #include "StaticStructureFactorDebye.h"
+#include "ThreadStorage.h"
 #include "utils.h"
 
 /*! \file StaticStructureFactorDebye.cc
@@ -31,11 +34,131 @@ float k_min_center_to_lower_edge(unsigned int bins, float k_min, float k_max)
 {
     return k_min - (k_max - k_min) / static_cast<float>(2 * (bins - 1));
 }
+
+//! Number of query points in a tile of pairs.
+constexpr unsigned int query_tile_size = 256;
+
+//! Number of points in a tile of pairs.
+constexpr unsigned int point_tile_size = 1024;
+
+//! Accumulate sums over the tiles of pairs in parallel.
+/*! body(query_begin, query_end, point_begin, point_end, sums) adds the
+ *  contributions of a tile of pairs to the local array sums of storage.
+ */
+template<typename Body>
+void forEachTile(unsigned int n_query_points, unsigned int n_points, util::ThreadStorage<double>& storage,
+                 const Body& body)
+{
+    const size_t n_query_tiles = (n_query_points + query_tile_size - 1) / query_tile_size;
+    const size_t n_point_tiles = (n_points + point_tile_size - 1) / point_tile_size;
+    const auto add_tiles = [&](size_t begin, size_t end, util::ManagedArray<double>& sums) {
+        for (size_t tile = begin; tile < end; ++tile)
+        {
+            const size_t query_begin = (tile / n_point_tiles) * query_tile_size;
+            const size_t point_begin = (tile % n_point_tiles) * point_tile_size;
+            body(query_begin, std::min<size_t>(query_begin + query_tile_size, n_query_points), point_begin,
+                 std::min<size_t>(point_begin + point_tile_size, n_points), sums);
+        }
+    };
+    // Each tile has many pairs, so deterministic sums use ranges of one tile.
+    storage.accumulate(0, n_query_tiles * n_point_tiles, add_tiles, 1);
+}
+
+//! Evaluate the term of the Debye equation for a pair of points at the given distance.
+double debyeTerm(bool is2D, float k, float distance)
+{
+    if (is2D)
+    {
+        // floating point precision errors can cause k to be slightly
+        // negative, and make evaluating the cylindrical bessel function
+        // impossible.
+        auto nonnegative_k = std::max(float(0.0), k);
+
+#ifdef __clang__
+        // clang doesn't support the special math functions in C++17, so we
+        // use another library instead. The cast is needed because the other
+        // library's implementation is unique only for complex numbers,
+        // otherwise it just tries to call std::cyl_bessel_j.
+        return std::real(bessel::cyl_j0(std::complex<double>(nonnegative_k * distance)));
+#else
+        return std::cyl_bessel_j(0, nonnegative_k * distance);
+#endif
+    }
+    return util::sinc(k * distance);
+}
+
+//! Sum the terms of the Debye equation at a wave number over the distances of the pairs of a tile.
+template<typename Accumulator>
+Accumulator sumDebyeTerms(bool is2D, float k, const float* distances, size_t n_pairs)
+{
+    Accumulator sum = 0;
+    if (is2D)
+    {
+        for (size_t pair = 0; pair < n_pairs; ++pair)
+        {
+            sum += static_cast<Accumulator>(debyeTerm(true, k, distances[pair]));
+        }
+    }
+    else
+    {
+        for (size_t pair = 0; pair < n_pairs; ++pair)
+        {
+            sum += static_cast<Accumulator>(util::sinc(k * distances[pair]));
+        }
+    }
+    return sum;
+}
+
+//! Find an upper bound on the distance between any point and query point.
+/*! Wrapped separation vectors have fractional coordinates in [-0.5, 0.5)
+ *  along periodic directions. Along aperiodic directions, the fractional
+ *  coordinates are bounded by the extent of the points themselves.
+ */
+float maxPairDistance(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                      const vec3<float>* query_points, unsigned int n_query_points)
+{
+    const vec3<bool> periodic = box.getPeriodic();
+    const bool aperiodic = !periodic.x || !periodic.y || (!box.is2D() && !periodic.z);
+    vec3<float> min_fraction(0, 0, 0);
+    vec3<float> max_fraction(0, 0, 0);
+    if (aperiodic)
+    {
+        min_fraction = vec3<float>(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(),
+                                   std::numeric_limits<float>::max());
+        max_fraction = -min_fraction;
+        const auto update_extent = [&](const vec3<float>* pts, unsigned int n) {
+            for (unsigned int i = 0; i < n; ++i)
+            {
+                const vec3<float> fraction = box.makeFractional(pts[i]);
+                min_fraction.x = std::min(min_fraction.x, fraction.x);
+                min_fraction.y = std::min(min_fraction.y, fraction.y);
+                min_fraction.z = std::min(min_fraction.z, fraction.z);
+                max_fraction.x = std::max(max_fraction.x, fraction.x);
+                max_fraction.y = std::max(max_fraction.y, fraction.y);
+                max_fraction.z = std::max(max_fraction.z, fraction.z);
+            }
+        };
+        update_extent(points, n_points);
+        update_extent(query_points, n_query_points);
+    }
+    const vec3<float> extent = max_fraction - min_fraction;
+    const float fractional_bound[3] = {periodic.x ? float(0.5) : extent.x, periodic.y ? float(0.5) : extent.y,
+                                       periodic.z ? float(0.5) : extent.z};
+    float r_max = 0;
+    for (unsigned int i = 0; i < (box.is2D() ? 2 : 3); ++i)
+    {
+        const vec3<float> lattice_vector = box.getLatticeVector(i);
+        r_max += fractional_bound[i] * std::sqrt(dot(lattice_vector, lattice_vector));
+    }
+    return r_max;
+}
 } // namespace
 
-StaticStructureFactorDebye::StaticStructureFactorDebye(unsigned int bins, float k_max, float k_min)
+StaticStructureFactorDebye::StaticStructureFactorDebye(unsigned int bins, float k_max, float k_min,
+                                                       unsigned int num_distance_bins)
     : StaticStructureFactor(bins, k_max_center_to_upper_edge(bins, k_min, k_max),
-                            k_min_center_to_lower_edge(bins, k_min, k_max))
+                            k_min_center_to_lower_edge(bins, k_min, k_max)),
+      m_num_distance_bins(num_distance_bins)
 {
     if (bins == 0)
     {
@@ -60,6 +183,8 @@ void StaticStructureFactorDebye::accumulate(const freud::locality::NeighborQuery
                                             const vec3<float>* query_points, unsigned int n_query_points,
                                             unsigned int n_total)
 {
+    const util::ScopedPhase phase("StaticStructureFactorDebye::accumulate");
+    const util::ScopedMemoryOwner owner("StaticStructureFactorDebye");
     const auto& box = neighbor_query->getBox();
     // The minimum valid k value is 4 * pi / L, where L is the smallest side length.
     const auto box_L = box.getL();
@@ -70,51 +195,140 @@ void StaticStructureFactorDebye::accumulate(const freud::locality::NeighborQuery
     const auto* const points = neighbor_query->getPoints();
     const auto n_points = neighbor_query->getNPoints();
 
-    std::vector<float> distances(n_points * n_query_points);
-    box.computeAllDistances(points, n_points, query_points, n_query_points, distances.data());
+    // Without query points, the points are also used as query points.
+    if (query_points == nullptr)
+    {
+        query_points = points;
+        n_query_points = n_points;
+    }
+
+    const std::vector<double> S_k = (m_num_distance_bins == 0)
+        ? computeExact(box, points, n_points, query_points, n_query_points)
+        : computeHistogram(box, points, n_points, query_points, n_query_points);
+    for (size_t k_index = 0; k_index < S_k.size(); ++k_index)
+    {
+        m_local_structure_factor.increment(k_index, S_k[k_index] / static_cast<double>(n_total));
+    }
+    m_frame_counter++;
+    m_reduce = true;
+}
 
+std::vector<double> StaticStructureFactorDebye::computeExact(const box::Box& box, const vec3<float>* points,
+                                                             unsigned int n_points,
+                                                             const vec3<float>* query_points,
+                                                             unsigned int n_query_points) const
+{
     const auto k_bin_centers = m_structure_factor.getBinCenters()[0];
+    const size_t num_k = k_bin_centers.size();
+    const bool is2D = box.is2D();
+    // The terms of each tile are summed in double precision unless single precision sums are requested.
+    const bool double_sums = util::accumulateInDouble(true);
+
+    // The distances of each tile of pairs are computed once and reused for
+    // all k values while they are in cache.
+    tbb::enumerable_thread_specific<std::vector<float>> local_distances(
+        (std::vector<float>(query_tile_size * point_tile_size)));
+    util::ThreadStorage<double> local_S_k(num_k);
+    forEachTile(n_query_points, n_points, local_S_k,
+                [&](size_t query_begin, size_t query_end, size_t point_begin, size_t point_end, auto& S_k) {
+                    auto& distances = local_distances.local();
+                    const size_t n_pairs = (query_end - query_begin) * (point_end - point_begin);
+                    box.computeDistanceTile(query_points + query_begin, query_end - query_begin,
+                                            points + point_begin, point_end - point_begin, distances.data(),
+                                            point_end - point_begin);
+                    for (size_t k_index = 0; k_index < num_k; ++k_index)
+                    {
+                        const auto k = k_bin_centers[k_index];
+                        const float* pair_distances = distances.data();
+                        S_k[k_index] += double_sums ? sumDebyeTerms<double>(is2D, k, pair_distances, n_pairs)
+                                                    : sumDebyeTerms<float>(is2D, k, pair_distances, n_pairs);
+                    }
+                });
+
+    util::ManagedArray<double> S_k_sum(num_k);
+    local_S_k.reduceInto(S_k_sum);
+    return std::vector<double>(S_k_sum.get(), S_k_sum.get() + num_k);
+}
+
+std::vector<double> StaticStructureFactorDebye::computeHistogram(const box::Box& box,
+                                                                 const vec3<float>* points,
+                                                                 unsigned int n_points,
+                                                                 const vec3<float>* query_points,
+                                                                 unsigned int n_query_points) const
+{
+    const size_t num_bins = m_num_distance_bins;
+    const float r_max = maxPairDistance(box, points, n_points, query_points, n_query_points);
+    const float inverse_bin_width = (r_max > 0) ? static_cast<float>(num_bins) / r_max : 0;
+
+    // Each bin records the number of pairs and the sum of their distances, so
+    // that the Debye equation can be evaluated at the mean distance of the
+    // pairs within each bin.
+    tbb::enumerable_thread_specific<std::vector<size_t>> local_counts((std::vector<size_t>(num_bins, 0)));
+    tbb::enumerable_thread_specific<std::vector<float>> local_distances(
+        (std::vector<float>(query_tile_size * point_tile_size)));
+    util::ThreadStorage<double> local_distance_sums(num_bins);
+    forEachTile(n_query_points, n_points, local_distance_sums,
+                [&](size_t query_begin, size_t query_end, size_t point_begin, size_t point_end,
+                    auto& distance_sums) {
+                    auto& counts = local_counts.local();
+                    auto& distances = local_distances.local();
+                    const size_t n_pairs = (query_end - query_begin) * (point_end - point_begin);
+                    box.computeDistanceTile(query_points + query_begin, query_end - query_begin,
+                                            points + point_begin, point_end - point_begin, distances.data(),
+                                            point_end - point_begin);
+                    for (size_t pair = 0; pair < n_pairs; ++pair)
+                    {
+                        const float distance = distances[pair];
+                        const size_t bin
+                            = std::min(static_cast<size_t>(distance * inverse_bin_width), num_bins - 1);
+                        ++counts[bin];
+                        distance_sums[bin] += distance;
+                    }
+                });
 
-    util::forLoopWrapper(0, m_structure_factor.getAxisSizes()[0], [&](size_t begin, size_t end) {
+    std::vector<size_t> counts(num_bins, 0);
+    std::vector<float> mean_distances(num_bins, 0);
+    local_counts.combine_each([&](const std::vector<size_t>& local) {
+        for (size_t bin = 0; bin < num_bins; ++bin)
+        {
+            counts[bin] += local[bin];
+        }
+    });
+    util::ManagedArray<double> distance_sums(num_bins);
+    local_distance_sums.reduceInto(distance_sums);
+    for (size_t bin = 0; bin < num_bins; ++bin)
+    {
+        if (counts[bin] != 0)
+        {
+            mean_distances[bin] = static_cast<float>(distance_sums[bin] / static_cast<double>(counts[bin]));
+        }
+    }
+
+    const auto k_bin_centers = m_structure_factor.getBinCenters()[0];
+    const bool is2D = box.is2D();
+    std::vector<double> S_k(k_bin_centers.size(), 0);
+    util::forLoopWrapper(0, k_bin_centers.size(), [&](size_t begin, size_t end) {
         for (size_t k_index = begin; k_index < end; ++k_index)
         {
             const auto k = k_bin_centers[k_index];
-            double S_k = 0.0;
-            for (const auto& distance : distances)
+            double sum = 0.0;
+            for (size_t bin = 0; bin < num_bins; ++bin)
             {
-                if (box.is2D())
-                {
-                    // floating point precision errors can cause k to be
-                    // slightly negative, and make evaluating the cylindrical
-                    // bessel function impossible.
-                    auto nonnegative_k = std::max(float(0.0), k);
-
-#ifdef __clang__
-                    // clang doesn't support the special math functions in
-                    // C++17, so we use another library instead. The cast is
-                    // needed because the other library's implementation is
-                    // unique only for complex numbers, otherwise it just tries
-                    // to call std::cyl_bessel_j.
-                    S_k += std::real(bessel::cyl_j0(std::complex<double>(nonnegative_k * distance)));
-#else
-                    S_k += std::cyl_bessel_j(0, nonnegative_k * distance);
-#endif
-                }
-                else
+                if (counts[bin] != 0)
                 {
-                    S_k += util::sinc(k * distance);
+                    sum += static_cast<double>(counts[bin]) * debyeTerm(is2D, k, mean_distances[bin]);
                 }
             }
-            S_k /= static_cast<double>(n_total);
-            m_local_structure_factor.increment(k_index, S_k);
-        };
+            S_k[k_index] = sum;
+        }
     });
-    m_frame_counter++;
-    m_reduce = true;
+    return S_k;
 }
 
 void StaticStructureFactorDebye::reduce()
 {
+    const util::ScopedPhase phase("StaticStructureFactorDebye::reduce");
+    const util::ScopedMemoryOwner owner("StaticStructureFactorDebye");
     m_structure_factor.prepare(m_structure_factor.getAxisSizes()[0]);
     m_structure_factor.reduceOverThreadsPerBin(m_local_structure_factor, [&](size_t i) {
         m_structure_factor[i] /= static_cast<float>(m_frame_counter);
@@ -5,6 +5,7 @@
 #define STATIC_STRUCTURE_FACTOR_DEBYE_H
 
 #include <limits>
+#include <vector>
 
 #include "Histogram.h"
 #include "NeighborQuery.h"
@@ -19,13 +20,24 @@
 
 namespace freud { namespace diffraction {
 
+//! Computes the static structure factor using the Debye scattering equation.
+/*! Pair distances are computed in tiles of query points and points, so the
+ *  memory required does not grow with the square of the number of points. If
+ *  num_distance_bins is nonzero, the pair distances are first accumulated into
+ *  a histogram of that many bins spanning all possible distances, and the
+ *  Debye sum is evaluated once per histogram bin at the mean distance of the
+ *  pairs in that bin. Otherwise, the Debye sum is evaluated for every pair.
+ */
 class StaticStructureFactorDebye : public StaticStructureFactor
 {
 public:
     //! Constructor
-    StaticStructureFactorDebye(unsigned int bins, float k_max, float k_min = 0);
+    StaticStructureFactorDebye(unsigned int bins, float k_max, float k_min = 0,
+                               unsigned int num_distance_bins = 0);
 
     //! Compute the structure factor S(k) using the Debye formula
+    /*! If query_points is nullptr, the points are used as query points.
+     */
     void accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                     unsigned int n_query_points, unsigned int n_total) override;
 
@@ -38,11 +50,27 @@ public:
         m_reduce = true;
     }
 
+    //! Get the number of bins of the pair distance histogram, or 0 if pairs are summed exactly.
+    unsigned int getNumDistanceBins() const
+    {
+        return m_num_distance_bins;
+    }
+
 private:
     //! Reduce thread-local arrays onto the primary data arrays.
     void reduce() override;
 
+    //! Sum the Debye equation over every pair of points.
+    std::vector<double> computeExact(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                                     const vec3<float>* query_points, unsigned int n_query_points) const;
+
+    //! Sum the Debye equation over a histogram of the pair distances.
+    std::vector<double> computeHistogram(const box::Box& box, const vec3<float>* points,
+                                         unsigned int n_points, const vec3<float>* query_points,
+                                         unsigned int n_query_points) const;
+
     unsigned int m_frame_counter {0}; //!< Number of frames calculated
+    unsigned int m_num_distance_bins; //!< Number of bins of the pair distance histogram
 };
 
 }; }; // namespace freud::diffraction
@@ -1,19 +1,21 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <array>
 #include <cmath>
 #include <complex>
+#include <cstdint>
 #include <limits>
-#include <random>
 #include <stdexcept>
-#include <tbb/concurrent_vector.h>
 
 #include "Eigen/Eigen/Dense"
 
 #include "Box.h"
+#include "Instrumentation.h"
 #include "ManagedArray.h"
 #include "NeighborQuery.h"
 #include "StaticStructureFactorDirect.h"
+#include "ThreadStorage.h"
 #include "utils.h"
 
 /*! \file StaticStructureFactorDirect.cc
@@ -23,8 +25,8 @@
 namespace freud { namespace diffraction {
 
 StaticStructureFactorDirect::StaticStructureFactorDirect(unsigned int bins, float k_max, float k_min,
-                                                         unsigned int num_sampled_k_points)
-    : StaticStructureFactor(bins, k_max, k_min), m_num_sampled_k_points(num_sampled_k_points),
+                                                         unsigned int num_sampled_k_points, unsigned int seed)
+    : StaticStructureFactor(bins, k_max, k_min), m_num_sampled_k_points(num_sampled_k_points), m_seed(seed),
       m_k_histogram(KBinHistogram(m_structure_factor.getAxes())),
       m_local_k_histograms(KBinHistogram::ThreadLocalHistogram(m_k_histogram))
 {
@@ -51,6 +53,9 @@ void StaticStructureFactorDirect::accumulate(const freud::locality::NeighborQuer
                                              const vec3<float>* query_points, unsigned int n_query_points,
                                              unsigned int n_total)
 {
+    const util::ScopedPhase phase("StaticStructureFactorDirect::accumulate");
+    const util::ScopedMemoryOwner owner("StaticStructureFactorDirect");
+
     // Compute k vectors by sampling reciprocal space.
     const auto& box = neighbor_query->getBox();
     if (box.is2D())
@@ -63,8 +68,7 @@ void StaticStructureFactorDirect::accumulate(const freud::locality::NeighborQuer
     if ((!box_assigned) || (box != previous_box))
     {
         previous_box = box;
-        m_k_points
-            = StaticStructureFactorDirect::reciprocal_isotropic(box, k_max, k_min, m_num_sampled_k_points);
+        update_k_points(box, k_min, k_max);
         box_assigned = true;
     }
 
@@ -75,15 +79,13 @@ void StaticStructureFactorDirect::accumulate(const freud::locality::NeighborQuer
     m_min_valid_k = std::min(m_min_valid_k, freud::constants::TWO_PI / min_box_length);
 
     // Compute F_k for the points.
-    const auto F_k_points = StaticStructureFactorDirect::compute_F_k(
-        neighbor_query->getPoints(), neighbor_query->getNPoints(), n_total, m_k_points);
+    const auto F_k_points = compute_F_k(neighbor_query->getPoints(), neighbor_query->getNPoints(), n_total);
 
     // Compute F_k for the query points (if necessary) and compute the product S_k.
     std::vector<float> S_k_all_points;
     if (query_points != nullptr)
     {
-        const auto F_k_query_points
-            = StaticStructureFactorDirect::compute_F_k(query_points, n_query_points, n_total, m_k_points);
+        const auto F_k_query_points = compute_F_k(query_points, n_query_points, n_total);
         S_k_all_points = StaticStructureFactorDirect::compute_S_k(F_k_points, F_k_query_points);
     }
     else
@@ -92,13 +94,11 @@ void StaticStructureFactorDirect::accumulate(const freud::locality::NeighborQuer
     }
 
     // Bin the S_k values and track the number of k values in each bin.
-    util::forLoopWrapper(0, m_k_points.size(), [&](size_t begin, size_t end) {
+    m_local_structure_factor.accumulate(0, m_k_points.size(), [&](size_t begin, size_t end, auto& histogram) {
         for (size_t k_index = begin; k_index < end; ++k_index)
         {
-            const auto& k_vec = m_k_points[k_index];
-            const auto k_magnitude = std::sqrt(dot(k_vec, k_vec));
-            const auto k_bin = m_structure_factor.bin({k_magnitude});
-            m_local_structure_factor.increment(k_bin, S_k_all_points[k_index]);
+            const auto k_bin = m_k_bins[k_index];
+            histogram.increment(k_bin, S_k_all_points[k_index]);
             m_local_k_histograms.increment(k_bin);
         };
     });
@@ -107,6 +107,8 @@ void StaticStructureFactorDirect::accumulate(const freud::locality::NeighborQuer
 
 void StaticStructureFactorDirect::reduce()
 {
+    const util::ScopedPhase phase("StaticStructureFactorDirect::reduce");
+    const util::ScopedMemoryOwner owner("StaticStructureFactorDirect");
     const auto axis_size = m_structure_factor.getAxisSizes()[0];
     m_k_histogram.prepare(axis_size);
     m_structure_factor.prepare(axis_size);
@@ -120,26 +122,178 @@ void StaticStructureFactorDirect::reduce()
                                                [&](size_t i) { m_structure_factor[i] /= m_k_histogram[i]; });
 }
 
-std::vector<std::complex<float>>
-StaticStructureFactorDirect::compute_F_k(const vec3<float>* points, unsigned int n_points,
-                                         unsigned int n_total, const std::vector<vec3<float>>& k_points)
+inline Eigen::Matrix3f box_to_matrix(const box::Box& box)
 {
-    const auto n_k_points = k_points.size();
-    auto F_k = std::vector<std::complex<float>>(n_k_points);
-    const std::complex<float> normalization(1.0F / std::sqrt(static_cast<float>(n_total)));
+    // Build an Eigen matrix from the provided box.
+    Eigen::Matrix3f mat;
+    for (unsigned int i = 0; i < 3; i++)
+    {
+        const auto box_vector = box.getLatticeVector(i);
+        mat(i, 0) = box_vector.x;
+        mat(i, 1) = box_vector.y;
+        mat(i, 2) = box_vector.z;
+    }
+    return mat;
+}
 
-    util::forLoopWrapper(0, n_k_points, [&](size_t begin, size_t end) {
-        for (size_t k_index = begin; k_index < end; ++k_index)
+void StaticStructureFactorDirect::update_k_points(const box::Box& box, float k_min, float k_max)
+{
+    // The k points lie on the reciprocal lattice of the box, k = n_x b_x +
+    // n_y b_y + n_z b_z with integer n. The indices n and the bins of the k
+    // points only depend on the box, so they are reused by all frames
+    // accumulated with the same box.
+    m_k_indices = reciprocal_isotropic(box, k_max, k_min, m_num_sampled_k_points, m_seed);
+    const auto n_k_points = m_k_indices.size();
+    const auto box_matrix = box_to_matrix(box);
+    const Eigen::Matrix3f B = box_matrix.transpose().inverse();
+    const Eigen::Matrix3d B_double
+        = freud::constants::TWO_PI * box_matrix.cast<double>().transpose().inverse();
+    std::array<vec3<float>, 3> b_vecs;
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+        b_vecs[j] = freud::constants::TWO_PI * vec3<float>(B(j, 0), B(j, 1), B(j, 2));
+        m_reciprocal_vectors[j] = vec3<double>(B_double(j, 0), B_double(j, 1), B_double(j, 2));
+    }
+
+    m_k_points.resize(n_k_points);
+    m_min_k_index = {0, 0, 0};
+    m_max_k_index = {0, 0, 0};
+    for (size_t k_index = 0; k_index < n_k_points; ++k_index)
+    {
+        const auto& n = m_k_indices[k_index];
+        m_k_points[k_index] = static_cast<float>(n[0]) * b_vecs[0] + static_cast<float>(n[1]) * b_vecs[1]
+            + static_cast<float>(n[2]) * b_vecs[2];
+        for (unsigned int j = 0; j < 3; ++j)
         {
-            std::complex<float> F_ki(0);
-            for (size_t r_index = 0; r_index < n_points; ++r_index)
+            m_min_k_index[j] = std::min(m_min_k_index[j], n[j]);
+            m_max_k_index[j] = std::max(m_max_k_index[j], n[j]);
+        }
+    }
+
+    m_k_bins.resize(n_k_points);
+    for (size_t k_index = 0; k_index < n_k_points; ++k_index)
+    {
+        const auto& k_vec = m_k_points[k_index];
+        const auto k_magnitude = std::sqrt(dot(k_vec, k_vec));
+        m_k_bins[k_index] = m_structure_factor.bin({k_magnitude});
+    }
+}
+
+std::vector<std::complex<float>> StaticStructureFactorDirect::compute_F_k(const vec3<float>* points,
+                                                                          unsigned int n_points,
+                                                                          unsigned int n_total) const
+{
+    // Since k = n_x b_x + n_y b_y + n_z b_z, exp(i k.r) is the product of the
+    // phase factors exp(i n_j b_j.r) along each reciprocal lattice vector.
+    // For each point, these factors are tabulated for the range of n along
+    // each axis by repeated multiplication, which replaces the complex
+    // exponential per k point and point by two complex products.
+    const auto n_k_points = m_k_points.size();
+    const auto& k_indices = m_k_indices;
+    const auto& min_index = m_min_k_index;
+    const auto& max_index = m_max_k_index;
+    const auto& b_vecs = m_reciprocal_vectors;
+
+    // Points are processed in blocks, with the phase factors of the points of
+    // a block stored contiguously for each n so that the sums over the block
+    // vectorize. Blocks are padded with zero phase factors.
+    constexpr unsigned int block_size = 64;
+    constexpr unsigned int lane_width = 8;
+    const auto n_blocks = (n_points + block_size - 1) / block_size;
+    util::ThreadStorage<std::complex<double>> local_F_k(n_k_points);
+
+    // Each range of a deterministic sum has a few blocks, so that adding the
+    // sums of the ranges is cheap compared to the sums over their points.
+    constexpr size_t blocks_per_range = 4;
+    const auto add_blocks = [&](size_t begin, size_t end, auto& F_k_local) {
+        std::array<std::vector<float>, 3> phase_re;
+        std::array<std::vector<float>, 3> phase_im;
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+            phase_re[j].resize(static_cast<size_t>(max_index[j] - min_index[j] + 1) * block_size);
+            phase_im[j].resize(phase_re[j].size());
+        }
+
+        for (size_t block = begin; block < end; ++block)
+        {
+            const size_t block_start = block * block_size;
+            const auto block_points = static_cast<unsigned int>(
+                std::min(static_cast<size_t>(block_size), n_points - block_start));
+
+            for (unsigned int j = 0; j < 3; ++j)
+            {
+                const auto n_range = static_cast<unsigned int>(max_index[j] - min_index[j] + 1);
+                for (unsigned int p = 0; p < block_size; ++p)
+                {
+                    if (p >= block_points)
+                    {
+                        for (unsigned int n = 0; n < n_range; ++n)
+                        {
+                            phase_re[j][n * block_size + p] = 0;
+                            phase_im[j][n * block_size + p] = 0;
+                        }
+                        continue;
+                    }
+                    const auto& r_vec = points[block_start + p];
+                    const double theta = dot(b_vecs[j], vec3<double>(r_vec.x, r_vec.y, r_vec.z));
+                    const std::complex<double> step = std::polar(1.0, theta);
+                    std::complex<double> phase = std::polar(1.0, theta * min_index[j]);
+                    for (unsigned int n = 0; n < n_range; ++n, phase *= step)
+                    {
+                        phase_re[j][n * block_size + p] = static_cast<float>(phase.real());
+                        phase_im[j][n * block_size + p] = static_cast<float>(phase.imag());
+                    }
+                }
+            }
+
+            for (size_t k_index = 0; k_index < n_k_points; ++k_index)
             {
-                const auto& k_vec(k_points[k_index]);
-                const auto& r_vec(points[r_index]);
-                const auto alpha(dot(k_vec, r_vec));
-                F_ki += std::exp(std::complex<float>(0, alpha));
+                const auto& n = k_indices[k_index];
+                const size_t x_offset = static_cast<size_t>(n[0] - min_index[0]) * block_size;
+                const size_t y_offset = static_cast<size_t>(n[1] - min_index[1]) * block_size;
+                const size_t z_offset = static_cast<size_t>(n[2] - min_index[2]) * block_size;
+                const float* x_re = &phase_re[0][x_offset];
+                const float* x_im = &phase_im[0][x_offset];
+                const float* y_re = &phase_re[1][y_offset];
+                const float* y_im = &phase_im[1][y_offset];
+                const float* z_re = &phase_re[2][z_offset];
+                const float* z_im = &phase_im[2][z_offset];
+
+                // Independent partial sums per lane allow the sum to be
+                // vectorized without reassociating floating point additions.
+                float lane_re[lane_width] = {};
+                float lane_im[lane_width] = {};
+                for (unsigned int p = 0; p < block_size; p += lane_width)
+                {
+                    for (unsigned int l = 0; l < lane_width; ++l)
+                    {
+                        const float xy_re = x_re[p + l] * y_re[p + l] - x_im[p + l] * y_im[p + l];
+                        const float xy_im = x_re[p + l] * y_im[p + l] + x_im[p + l] * y_re[p + l];
+                        lane_re[l] += xy_re * z_re[p + l] - xy_im * z_im[p + l];
+                        lane_im[l] += xy_re * z_im[p + l] + xy_im * z_re[p + l];
+                    }
+                }
+                float sum_re(0);
+                float sum_im(0);
+                for (unsigned int l = 0; l < lane_width; ++l)
+                {
+                    sum_re += lane_re[l];
+                    sum_im += lane_im[l];
+                }
+                F_k_local[k_index] += std::complex<double>(sum_re, sum_im);
             }
-            F_k[k_index] = F_ki * normalization;
+        }
+    };
+    local_F_k.accumulate(0, n_blocks, add_blocks, blocks_per_range);
+    util::ManagedArray<std::complex<double>> F_k_sum(n_k_points);
+    local_F_k.reduceInto(F_k_sum);
+
+    const double normalization(1.0 / std::sqrt(static_cast<double>(n_total)));
+    auto F_k = std::vector<std::complex<float>>(n_k_points);
+    util::forLoopWrapper(0, n_k_points, [&](size_t begin, size_t end) {
+        for (size_t k_index = begin; k_index < end; ++k_index)
+        {
+            F_k[k_index] = std::complex<float>(F_k_sum[k_index] * normalization);
         }
     });
     return F_k;
@@ -160,18 +314,21 @@ StaticStructureFactorDirect::compute_S_k(const std::vector<std::complex<float>>&
     return S_k;
 }
 
-inline Eigen::Matrix3f box_to_matrix(const box::Box& box)
+//! Get a uniform random number in [0, 1) determined by a seed and the indices of a reciprocal lattice point.
+inline float lattice_point_random(unsigned int seed, unsigned int kx, unsigned int ky, unsigned int kz)
 {
-    // Build an Eigen matrix from the provided box.
-    Eigen::Matrix3f mat;
-    for (unsigned int i = 0; i < 3; i++)
-    {
-        const auto box_vector = box.getLatticeVector(i);
-        mat(i, 0) = box_vector.x;
-        mat(i, 1) = box_vector.y;
-        mat(i, 2) = box_vector.z;
-    }
-    return mat;
+    // The indices are combined with the splitmix64 finalizer.
+    auto mix = [](uint64_t z) {
+        z += 0x9e3779b97f4a7c15ULL;
+        z = (z ^ (z >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+        z = (z ^ (z >> 27U)) * 0x94d049bb133111ebULL;
+        return z ^ (z >> 31U);
+    };
+    uint64_t hash = mix(seed);
+    hash = mix(hash ^ kx);
+    hash = mix(hash ^ ky);
+    hash = mix(hash ^ kz);
+    return static_cast<float>(hash >> 40U) * (1.0F / static_cast<float>(1U << 24U));
 }
 
 inline float get_prune_distance(unsigned int num_sampled_k_points, float q_max, float q_volume)
@@ -193,9 +350,9 @@ inline float get_prune_distance(unsigned int num_sampled_k_points, float q_max,
     return std::real(x) + q_max / 2.0F;
 }
 
-std::vector<vec3<float>> StaticStructureFactorDirect::reciprocal_isotropic(const box::Box& box, float k_max,
-                                                                           float k_min,
-                                                                           unsigned int num_sampled_k_points)
+std::vector<std::array<int, 3>>
+StaticStructureFactorDirect::reciprocal_isotropic(const box::Box& box, float k_max, float k_min,
+                                                  unsigned int num_sampled_k_points, unsigned int seed)
 {
     const auto box_matrix = box_to_matrix(box);
     // B holds "crystallographic" reciprocal box vectors that lack the factor of 2 pi.
@@ -223,27 +380,15 @@ std::vector<vec3<float>> StaticStructureFactorDirect::reciprocal_isotropic(const
 
     // The maximum number of k points is a guideline. The true number of sampled
     // k points can be less or greater than num_sampled_k_points, depending on the
-    // result of the random pruning procedure. Therefore, we cannot allocate a
-    // fixed size for the data. Also, reserving capacity for the concurrent
-    // vector had no measureable effect on performance.
-    tbb::concurrent_vector<vec3<float>> k_points;
-
-    // This is a 3D loop but we parallelize in 1D because we only need to seed
-    // the random number generators once per block and there is no benefit of
-    // locality if we parallelize in 2D or 3D.
-    util::forLoopWrapper(0, N_kx, [&](size_t begin, size_t end) {
-        // Set up thread-local random number generator for k point pruning.
-        const auto thread_start = static_cast<unsigned int>(begin);
-        std::random_device rd;
-        std::seed_seq seed {thread_start, rd(), rd(), rd()};
-        std::mt19937 rng(seed);
-        std::uniform_real_distribution<float> base_dist(0, 1);
-        auto random_prune = [&]() { return base_dist(rng); };
-
-        const auto add_all_k_points = std::isinf(q_prune_distance);
+    // result of the random pruning procedure. Therefore, the k points of each
+    // kx are collected separately and concatenated in order.
+    std::vector<std::vector<std::array<int, 3>>> k_indices_of_kx(N_kx);
+    const auto add_all_k_points = std::isinf(q_prune_distance);
 
+    util::forLoopWrapper(0, N_kx, [&](size_t begin, size_t end) {
         for (unsigned int kx = begin; kx < end; ++kx)
         {
+            auto& k_indices = k_indices_of_kx[kx];
             const auto k_vec_x = static_cast<float>(kx) * bx;
             for (unsigned int ky = 0; ky < N_ky; ++ky)
             {
@@ -276,20 +421,29 @@ std::vector<vec3<float>> StaticStructureFactorDirect::reciprocal_isotropic(const
 
                     // The k vector is kept with probability min(1, (q_prune_distance / q_distance)^2).
                     // This sampling scheme aims to have a constant density of k vectors with respect to
-                    // radial distance.
+                    // radial distance. The random number of each k vector only depends on the seed and
+                    // its reciprocal lattice indices, so the sample is reproducible and changes little
+                    // when the box changes slightly.
                     if (q_distance_sq <= q_max_sq && q_distance_sq >= q_min_sq)
                     {
                         const auto prune_probability = q_prune_distance_sq / q_distance_sq;
-                        if (add_all_k_points || prune_probability > random_prune())
+                        if (add_all_k_points || prune_probability > lattice_point_random(seed, kx, ky, kz))
                         {
-                            k_points.emplace_back(k_vec);
+                            k_indices.push_back({static_cast<int>(kx), static_cast<int>(ky),
+                                                 static_cast<int>(kz)});
                         }
                     }
                 }
             }
         }
     });
-    return std::vector<vec3<float>>(k_points.cbegin(), k_points.cend());
+
+    std::vector<std::array<int, 3>> k_indices;
+    for (const auto& k_indices_x : k_indices_of_kx)
+    {
+        k_indices.insert(k_indices.end(), k_indices_x.begin(), k_indices_x.end());
+    }
+    return k_indices;
 }
 
 }; }; // namespace freud::diffraction
@@ -4,6 +4,7 @@
 #ifndef STATIC_STRUCTURE_FACTOR_DIRECT_H
 #define STATIC_STRUCTURE_FACTOR_DIRECT_H
 
+#include <array>
 #include <complex>
 #include <limits>
 #include <vector>
@@ -48,20 +49,22 @@ class StaticStructureFactorDirect : public StaticStructureFactor
 public:
     //! Constructor
     StaticStructureFactorDirect(unsigned int bins, float k_max, float k_min = 0,
-                                unsigned int num_sampled_k_points = 0);
+                                unsigned int num_sampled_k_points = 0, unsigned int seed = 0);
 
     //! Compute the structure factor S(k) using the direct formula
     void accumulate(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                     unsigned int n_query_points, unsigned int n_total) override;
 
     //! Reset the histogram to all zeros
+    /*! The k points sampled for the last box are kept, since they are
+     *  determined by the box and the seed.
+     */
     void reset() override
     {
         m_local_structure_factor.reset();
         m_local_k_histograms.reset();
         m_min_valid_k = std::numeric_limits<float>::infinity();
         m_reduce = true;
-        box_assigned = false;
     }
 
     //! Get the number of sampled k points
@@ -70,6 +73,12 @@ public:
         return m_num_sampled_k_points;
     }
 
+    //! Get the seed used to sample k points
+    unsigned int getSeed() const
+    {
+        return m_seed;
+    }
+
     //! Get the k points last used
     std::vector<vec3<float>> getKPoints() const
     {
@@ -80,22 +89,31 @@ private:
     //! Reduce thread-local arrays onto the primary data arrays.
     void reduce() override;
 
-    //! Compute the complex amplitude F(k) for a set of points and k points
-    static std::vector<std::complex<float>> compute_F_k(const vec3<float>* points, unsigned int n_points,
-                                                        unsigned int n_total,
-                                                        const std::vector<vec3<float>>& k_points);
+    //! Sample the k points for a new box and precompute the data derived from them
+    void update_k_points(const box::Box& box, float k_min, float k_max);
+
+    //! Compute the complex amplitude F(k) for a set of points at the current k points
+    std::vector<std::complex<float>> compute_F_k(const vec3<float>* points, unsigned int n_points,
+                                                 unsigned int n_total) const;
 
     //! Compute the static structure factor S(k) for all k points
     static std::vector<float> compute_S_k(const std::vector<std::complex<float>>& F_k_points,
                                           const std::vector<std::complex<float>>& F_k_query_points);
 
-    //! Sample reciprocal space isotropically to get k points
-    static std::vector<vec3<float>> reciprocal_isotropic(const box::Box& box, float k_max, float k_min,
-                                                         unsigned int num_sampled_k_points);
-
-    unsigned int m_num_sampled_k_points; //!< Target number of k-vectors to sample
-    std::vector<vec3<float>> m_k_points; //!< k-vectors used for sampling
-    KBinHistogram m_k_histogram;         //!< Histogram of sampled k bins, used to normalize S(q)
+    //! Sample reciprocal space isotropically to get the reciprocal lattice indices of k points
+    static std::vector<std::array<int, 3>> reciprocal_isotropic(const box::Box& box, float k_max, float k_min,
+                                                                unsigned int num_sampled_k_points,
+                                                                unsigned int seed);
+
+    unsigned int m_num_sampled_k_points;              //!< Target number of k-vectors to sample
+    unsigned int m_seed;                              //!< Seed of the random pruning of k-vectors
+    std::vector<vec3<float>> m_k_points;              //!< k-vectors used for sampling
+    std::array<vec3<double>, 3> m_reciprocal_vectors; //!< Reciprocal lattice vectors of the box
+    std::vector<std::array<int, 3>> m_k_indices;      //!< Reciprocal lattice indices of each k-vector
+    std::array<int, 3> m_min_k_index {};              //!< Smallest reciprocal lattice index along each axis
+    std::array<int, 3> m_max_k_index {};              //!< Largest reciprocal lattice index along each axis
+    std::vector<size_t> m_k_bins;                     //!< Bin of the magnitude of each k-vector
+    KBinHistogram m_k_histogram;                      //!< Histogram of sampled k bins, used to normalize S(q)
     KBinHistogram::ThreadLocalHistogram
         m_local_k_histograms;  //!< Thread local histograms of sampled k bins for TBB parallelism
     box::Box previous_box;     //!< box assigned to the system
@@ -0,0 +1,245 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+
+#include "DistributedCompute.h"
+#include "Instrumentation.h"
+
+/*! \file DistributedCompute.cc
+    \brief Computes of point sets decomposed over the ranks of an MPI communicator.
+*/
+
+namespace freud { namespace distributed {
+
+namespace {
+//! Check that the ghosts of a decomposition hold all neighbors found by a ball query.
+void checkBallQuery(const DomainDecomposition& decomposition, const locality::QueryArgs& qargs,
+                    float ghost_range, const char* compute)
+{
+    if (qargs.mode != locality::QueryType::ball || ghost_range * qargs.r_max > decomposition.getGhostWidth())
+    {
+        throw std::invalid_argument(std::string(compute)
+                                    + " requires a ball query whose neighbors are all within the ghost width "
+                                      "of the decomposition.");
+    }
+}
+
+//! Union-find over global cluster ids, which are only stored once merged.
+class GlobalDisjointSets
+{
+public:
+    //! Find the root of the set of id.
+    uint64_t find(uint64_t id)
+    {
+        for (auto parent = m_parents.find(id); parent != m_parents.end(); parent = m_parents.find(id))
+        {
+            // Path halving.
+            const auto grandparent = m_parents.find(parent->second);
+            if (grandparent != m_parents.end())
+            {
+                parent->second = grandparent->second;
+            }
+            id = parent->second;
+        }
+        return id;
+    }
+
+    //! Merge the sets of a and b, whose root is the smaller root.
+    void unite(uint64_t a, uint64_t b)
+    {
+        a = find(a);
+        b = find(b);
+        if (a != b)
+        {
+            m_parents[std::max(a, b)] = std::min(a, b);
+        }
+    }
+
+    //! Get the ids of all merged sets that are not roots.
+    std::vector<uint64_t> getMergedIds() const
+    {
+        std::vector<uint64_t> ids;
+        ids.reserve(m_parents.size());
+        for (const auto& parent : m_parents)
+        {
+            ids.push_back(parent.first);
+        }
+        return ids;
+    }
+
+private:
+    std::unordered_map<uint64_t, uint64_t> m_parents; //!< Parent of every merged id that is not a root
+};
+
+//! Gather the values of all ranks on all ranks, in rank order.
+std::vector<uint64_t> allGather(const std::vector<uint64_t>& values, MPI_Comm comm, int n_ranks)
+{
+    const int count = static_cast<int>(values.size());
+    std::vector<int> counts(n_ranks);
+    MPI_Allgather(&count, 1, MPI_INT, counts.data(), 1, MPI_INT, comm);
+    std::vector<int> displacements(n_ranks, 0);
+    for (int rank = 1; rank < n_ranks; ++rank)
+    {
+        displacements[rank] = displacements[rank - 1] + counts[rank - 1];
+    }
+    std::vector<uint64_t> gathered(displacements.back() + counts.back());
+    MPI_Allgatherv(values.data(), count, MPI_UINT64_T, gathered.data(), counts.data(), displacements.data(),
+                   MPI_UINT64_T, comm);
+    return gathered;
+}
+
+//! Get the sum of the values of the lower ranks.
+uint64_t exclusiveSum(uint64_t value, MPI_Comm comm)
+{
+    uint64_t sum = 0;
+    MPI_Exscan(&value, &sum, 1, MPI_UINT64_T, MPI_SUM, comm);
+    int rank;
+    MPI_Comm_rank(comm, &rank);
+    return (rank == 0) ? 0 : sum;
+}
+} // namespace
+
+void accumulateRDF(density::RDF& rdf, const DomainDecomposition& decomposition, locality::QueryArgs qargs)
+{
+    const util::ScopedPhase phase("distributed::accumulateRDF");
+    checkBallQuery(decomposition, qargs, 1, "accumulateRDF");
+
+    // The bin counts of previous frames are already the sums over all ranks,
+    // so only the counts of this frame are summed.
+    const util::ManagedArray<unsigned int>& bin_counts = rdf.getBinCounts();
+    const std::vector<unsigned int> previous(bin_counts.get(), bin_counts.get() + bin_counts.size());
+    const locality::NeighborQuery* neighbor_query = decomposition.getNeighborQuery();
+    rdf.accumulate(neighbor_query, neighbor_query->getPoints(), decomposition.getNOwned(), nullptr, qargs);
+
+    const util::ManagedArray<unsigned int>& frame_counts = rdf.getBinCounts();
+    std::vector<uint64_t> counts(previous.size());
+    for (size_t bin = 0; bin < counts.size(); ++bin)
+    {
+        counts[bin] = frame_counts[bin] - previous[bin];
+    }
+    MPI_Allreduce(MPI_IN_PLACE, counts.data(), static_cast<int>(counts.size()), MPI_UINT64_T, MPI_SUM,
+                  decomposition.getCommunicator());
+
+    std::vector<unsigned int> total(previous.size());
+    for (size_t bin = 0; bin < total.size(); ++bin)
+    {
+        total[bin] = previous[bin] + static_cast<unsigned int>(counts[bin]);
+    }
+    const auto n_points = static_cast<unsigned int>(decomposition.getNTotal());
+    rdf.setBinCounts(total, n_points, n_points);
+}
+
+void computeSteinhardt(order::Steinhardt& steinhardt, const DomainDecomposition& decomposition,
+                       locality::QueryArgs qargs)
+{
+    // Averaging over the neighbors of neighbors requires the order parameters
+    // of the ghosts within the neighbor distance of the domain.
+    checkBallQuery(decomposition, qargs, steinhardt.isAverage() ? 2 : 1, "computeSteinhardt");
+    steinhardt.compute(nullptr, decomposition.getNeighborQuery(), qargs);
+}
+
+uint64_t computeClusters(cluster::Cluster& cluster, const DomainDecomposition& decomposition,
+                         locality::QueryArgs qargs, std::vector<uint64_t>& cluster_idx)
+{
+    const util::ScopedPhase phase("distributed::computeClusters");
+    checkBallQuery(decomposition, qargs, 1, "computeClusters");
+    const MPI_Comm comm = decomposition.getCommunicator();
+    const unsigned int n_owned = decomposition.getNOwned();
+    const unsigned int n_ghosts = decomposition.getNGhosts();
+
+    // Number the local clusters of all ranks consecutively.
+    cluster.compute(decomposition.getNeighborQuery(), nullptr, qargs);
+    const util::ManagedArray<unsigned int>& local_idx = cluster.getClusterIdx();
+    const uint64_t n_local_clusters = cluster.getNumClusters();
+    const uint64_t first_id = exclusiveSum(n_local_clusters, comm);
+
+    // Every ghost links its local cluster to the cluster of its owner.
+    std::vector<uint64_t> owned_ids(n_owned);
+    for (unsigned int i = 0; i < n_owned; ++i)
+    {
+        owned_ids[i] = first_id + local_idx[i];
+    }
+    std::vector<uint64_t> owner_ids(n_ghosts);
+    decomposition.exchangeGhosts(owned_ids.data(), owner_ids.data());
+    std::vector<std::pair<uint64_t, uint64_t>> links(n_ghosts);
+    for (unsigned int i = 0; i < n_ghosts; ++i)
+    {
+        links[i] = {first_id + local_idx[n_owned + i], owner_ids[i]};
+    }
+    std::sort(links.begin(), links.end());
+    links.erase(std::unique(links.begin(), links.end()), links.end());
+    std::vector<uint64_t> flat_links;
+    flat_links.reserve(2 * links.size());
+    for (const auto& link : links)
+    {
+        flat_links.push_back(link.first);
+        flat_links.push_back(link.second);
+    }
+
+    // All ranks merge the links of all ranks in the same order, and hence
+    // find the same roots.
+    const std::vector<uint64_t> all_links = allGather(flat_links, comm, decomposition.getNumRanks());
+    GlobalDisjointSets sets;
+    for (size_t i = 0; i < all_links.size(); i += 2)
+    {
+        sets.unite(all_links[i], all_links[i + 1]);
+    }
+
+    // The clusters are numbered by their roots, and the numbers of the roots
+    // of merged clusters are shared with all ranks.
+    std::vector<uint64_t> local_labels(n_local_clusters);
+    uint64_t n_roots = 0;
+    for (uint64_t id = 0; id < n_local_clusters; ++id)
+    {
+        if (sets.find(first_id + id) == first_id + id)
+        {
+            local_labels[id] = n_roots++;
+        }
+    }
+    const uint64_t first_label = exclusiveSum(n_roots, comm);
+    std::vector<uint64_t> merged_roots;
+    for (const uint64_t id : sets.getMergedIds())
+    {
+        const uint64_t root = sets.find(id);
+        if (root >= first_id && root < first_id + n_local_clusters)
+        {
+            merged_roots.push_back(root);
+        }
+    }
+    std::sort(merged_roots.begin(), merged_roots.end());
+    merged_roots.erase(std::unique(merged_roots.begin(), merged_roots.end()), merged_roots.end());
+    std::vector<uint64_t> flat_root_labels;
+    flat_root_labels.reserve(2 * merged_roots.size());
+    for (const uint64_t root : merged_roots)
+    {
+        flat_root_labels.push_back(root);
+        flat_root_labels.push_back(first_label + local_labels[root - first_id]);
+    }
+    const std::vector<uint64_t> all_root_labels
+        = allGather(flat_root_labels, comm, decomposition.getNumRanks());
+    std::unordered_map<uint64_t, uint64_t> root_labels;
+    for (size_t i = 0; i < all_root_labels.size(); i += 2)
+    {
+        root_labels[all_root_labels[i]] = all_root_labels[i + 1];
+    }
+
+    cluster_idx.resize(n_owned);
+    for (unsigned int i = 0; i < n_owned; ++i)
+    {
+        const uint64_t root = sets.find(owned_ids[i]);
+        cluster_idx[i] = (root >= first_id && root < first_id + n_local_clusters)
+            ? first_label + local_labels[root - first_id]
+            : root_labels.at(root);
+    }
+
+    uint64_t n_clusters = 0;
+    MPI_Allreduce(&n_roots, &n_clusters, 1, MPI_UINT64_T, MPI_SUM, comm);
+    return n_clusters;
+}
+
+}; }; // end namespace freud::distributed
@@ -0,0 +1,64 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DISTRIBUTED_COMPUTE_H
+#define DISTRIBUTED_COMPUTE_H
+
+#include <cstdint>
+#include <vector>
+
+#include "Cluster.h"
+#include "DomainDecomposition.h"
+#include "RDF.h"
+#include "Steinhardt.h"
+
+/*! \file DistributedCompute.h
+    \brief Computes of point sets decomposed over the ranks of an MPI communicator.
+*/
+
+namespace freud { namespace distributed {
+
+//! Accumulate the RDF of the points of all ranks as a single frame.
+/*! Every rank accumulates the bonds of the points it owns, and the bin counts
+ *  of all ranks are summed, so that the RDF is the same on all ranks and
+ *  equal to the RDF of the whole point set. Collective.
+ *
+ *  \param rdf RDF accumulating the frame on this rank.
+ *  \param decomposition Decomposition of the points.
+ *  \param qargs Ball query whose r_max is at most the ghost width.
+ */
+void accumulateRDF(density::RDF& rdf, const DomainDecomposition& decomposition, locality::QueryArgs qargs);
+
+//! Compute the Steinhardt order parameters of the points owned by this rank.
+/*! The first decomposition.getNOwned() values of the particle order are the
+ *  order parameters of the points owned by this rank, which are computed
+ *  from their neighbors among all points. The system-wide order is not summed
+ *  over the ranks. Not collective.
+ *
+ *  \param steinhardt Steinhardt order parameter computing the points of this rank.
+ *  \param decomposition Decomposition of the points.
+ *  \param qargs Ball query whose r_max is at most the ghost width, or half of it for neighbor averaging.
+ */
+void computeSteinhardt(order::Steinhardt& steinhardt, const DomainDecomposition& decomposition,
+                       locality::QueryArgs qargs);
+
+//! Find the clusters of the points of all ranks.
+/*! Every rank finds the clusters of its points and ghosts. The clusters of
+ *  all ranks that share a point, which is a ghost on one rank and owned by
+ *  another, are then merged with a union-find over the pairs of clusters
+ *  sharing ghosts, which are gathered on all ranks. Clusters are numbered
+ *  consecutively from zero, but unlike in Cluster::compute they are not
+ *  sorted by size. Collective.
+ *
+ *  \param cluster Cluster finding the clusters of the points of this rank.
+ *  \param decomposition Decomposition of the points.
+ *  \param qargs Ball query whose r_max is at most the ghost width.
+ *  \param cluster_idx Output cluster of each point owned by this rank.
+ *  \return Number of clusters of all points.
+ */
+uint64_t computeClusters(cluster::Cluster& cluster, const DomainDecomposition& decomposition,
+                         locality::QueryArgs qargs, std::vector<uint64_t>& cluster_idx);
+
+}; }; // end namespace freud::distributed
+
+#endif // DISTRIBUTED_COMPUTE_H
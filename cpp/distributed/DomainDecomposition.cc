@@ -0,0 +1,172 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+
+#include "AABBQuery.h"
+#include "DomainDecomposition.h"
+#include "SlabDecomposition.h"
+
+/*! \file DomainDecomposition.cc
+    \brief Spatial decomposition of a point set over the ranks of an MPI communicator.
+*/
+
+namespace freud { namespace distributed {
+
+namespace {
+//! Get the fractional x coordinates of points, wrapped into [0, 1) along periodic x.
+std::vector<float> getFractionalX(const box::Box& box, const vec3<float>* points, unsigned int n_points)
+{
+    std::vector<vec3<float>> fractional(n_points);
+    box.makeFractional(points, n_points, fractional.data());
+    std::vector<float> fractional_x(n_points);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        fractional_x[i]
+            = box.getPeriodicX() ? fractional[i].x - std::floor(fractional[i].x) : fractional[i].x;
+    }
+    return fractional_x;
+}
+
+//! Get the offsets of the elements sent to or received from each rank.
+std::vector<int> getDisplacements(const std::vector<int>& counts)
+{
+    std::vector<int> displacements(counts.size(), 0);
+    std::partial_sum(counts.begin(), counts.end() - 1, displacements.begin() + 1);
+    return displacements;
+}
+} // namespace
+
+DomainDecomposition::DomainDecomposition(MPI_Comm comm, const box::Box& box, float ghost_width)
+    : m_comm(comm), m_box(box), m_ghost_width(ghost_width)
+{
+    if (ghost_width < 0)
+    {
+        throw std::invalid_argument("DomainDecomposition requires that the ghost width must be nonnegative.");
+    }
+    MPI_Comm_rank(comm, &m_rank);
+    MPI_Comm_size(comm, &m_num_ranks);
+    // As for the halos of slabs, the planes of constant fractional x are
+    // spaced by the nearest plane distance along x.
+    m_fractional_ghost_width = ghost_width / m_box.getNearestPlaneDistance().x;
+}
+
+void DomainDecomposition::exchangeBytes(const void* send, const std::vector<int>& send_counts, void* receive,
+                                        const std::vector<int>& receive_counts, size_t size) const
+{
+    // Elements are sent as a contiguous type so that the counts are numbers
+    // of elements rather than of bytes, which would overflow sooner.
+    MPI_Datatype element;
+    MPI_Type_contiguous(static_cast<int>(size), MPI_BYTE, &element);
+    MPI_Type_commit(&element);
+    const std::vector<int> send_displacements = getDisplacements(send_counts);
+    const std::vector<int> receive_displacements = getDisplacements(receive_counts);
+    MPI_Alltoallv(send, send_counts.data(), send_displacements.data(), element, receive,
+                  receive_counts.data(), receive_displacements.data(), element, m_comm);
+    MPI_Type_free(&element);
+}
+
+std::vector<int> DomainDecomposition::exchangeCounts(const std::vector<int>& send_counts) const
+{
+    std::vector<int> receive_counts(m_num_ranks);
+    MPI_Alltoall(send_counts.data(), 1, MPI_INT, receive_counts.data(), 1, MPI_INT, m_comm);
+    return receive_counts;
+}
+
+void DomainDecomposition::distribute(const vec3<float>* points, unsigned int n_points, const uint64_t* tags)
+{
+    const auto n_ranks = static_cast<unsigned int>(m_num_ranks);
+    const bool periodic = m_box.getPeriodicX();
+
+    // Points are tagged by their index in the points of all ranks by default.
+    uint64_t first_tag = 0;
+    const uint64_t n_local = n_points;
+    MPI_Exscan(&n_local, &first_tag, 1, MPI_UINT64_T, MPI_SUM, m_comm);
+    if (m_rank == 0)
+    {
+        first_tag = 0;
+    }
+
+    // Migrate the points to the ranks owning their domains, grouped by rank.
+    const std::vector<float> fractional_x = getFractionalX(m_box, points, n_points);
+    std::vector<unsigned int> owners(n_points);
+    std::vector<int> send_counts(n_ranks, 0);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        owners[i] = locality::SlabDecomposition::getCoreSlab(fractional_x[i], n_ranks);
+        ++send_counts[owners[i]];
+    }
+    std::vector<int> offsets = getDisplacements(send_counts);
+    std::vector<vec3<float>> send_points(n_points);
+    std::vector<uint64_t> send_tags(n_points);
+    for (unsigned int i = 0; i < n_points; ++i)
+    {
+        const int offset = offsets[owners[i]]++;
+        send_points[offset] = points[i];
+        send_tags[offset] = (tags != nullptr) ? tags[i] : first_tag + i;
+    }
+    const std::vector<int> receive_counts = exchangeCounts(send_counts);
+    m_n_owned = static_cast<unsigned int>(std::accumulate(receive_counts.begin(), receive_counts.end(), 0));
+    m_points.resize(m_n_owned);
+    m_tags.resize(m_n_owned);
+    exchangeBytes(send_points.data(), send_counts, m_points.data(), receive_counts, sizeof(vec3<float>));
+    exchangeBytes(send_tags.data(), send_counts, m_tags.data(), receive_counts, sizeof(uint64_t));
+    const uint64_t n_owned = m_n_owned;
+    MPI_Allreduce(&n_owned, &m_n_total, 1, MPI_UINT64_T, MPI_SUM, m_comm);
+
+    // Only the domains within the ghost width of this domain can receive its
+    // points as ghosts, which are all other domains if the ghost layers are
+    // wider than about half of the box. A domain separated by k domains is
+    // (k - 1) domain widths away.
+    const auto reach
+        = static_cast<int>(std::ceil(m_fractional_ghost_width * static_cast<float>(n_ranks))) + 1;
+    std::vector<unsigned int> neighbor_ranks;
+    for (int rank = 0; rank < m_num_ranks; ++rank)
+    {
+        int separation = std::abs(rank - m_rank);
+        if (periodic)
+        {
+            separation = std::min(separation, m_num_ranks - separation);
+        }
+        if (rank != m_rank && separation <= reach)
+        {
+            neighbor_ranks.push_back(rank);
+        }
+    }
+
+    // Send the owned points within the ghost width of other domains to their owners.
+    const std::vector<float> owned_fractional_x = getFractionalX(m_box, m_points.data(), m_n_owned);
+    std::vector<std::vector<unsigned int>> ghost_sends(n_ranks);
+    for (unsigned int i = 0; i < m_n_owned; ++i)
+    {
+        for (const unsigned int rank : neighbor_ranks)
+        {
+            if (locality::SlabDecomposition::getSlabDistance(owned_fractional_x[i], rank, n_ranks, periodic)
+                <= m_fractional_ghost_width)
+            {
+                ghost_sends[rank].push_back(i);
+            }
+        }
+    }
+    m_ghost_sends.clear();
+    m_ghost_send_counts.assign(n_ranks, 0);
+    for (unsigned int rank = 0; rank < n_ranks; ++rank)
+    {
+        m_ghost_sends.insert(m_ghost_sends.end(), ghost_sends[rank].begin(), ghost_sends[rank].end());
+        m_ghost_send_counts[rank] = static_cast<int>(ghost_sends[rank].size());
+    }
+    m_ghost_receive_counts = exchangeCounts(m_ghost_send_counts);
+    const auto n_ghosts = static_cast<unsigned int>(
+        std::accumulate(m_ghost_receive_counts.begin(), m_ghost_receive_counts.end(), 0));
+    m_points.resize(m_n_owned + n_ghosts);
+    m_tags.resize(m_n_owned + n_ghosts);
+    exchangeGhosts(m_points.data(), m_points.data() + m_n_owned);
+    exchangeGhosts(m_tags.data(), m_tags.data() + m_n_owned);
+
+    m_neighbor_query = std::make_unique<locality::AABBQuery>(m_box, m_points.data(),
+                                                             static_cast<unsigned int>(m_points.size()));
+}
+
+}; }; // end namespace freud::distributed
@@ -0,0 +1,167 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DOMAIN_DECOMPOSITION_H
+#define DOMAIN_DECOMPOSITION_H
+
+#include <cstdint>
+#include <memory>
+#include <mpi.h>
+#include <vector>
+
+#include "Box.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file DomainDecomposition.h
+    \brief Spatial decomposition of a point set over the ranks of an MPI communicator.
+*/
+
+namespace freud { namespace distributed {
+
+//! Decomposition of a point set into domains of the box owned by the ranks of an MPI communicator.
+/*! The box is split into one slab per rank along the fractional x coordinate,
+ *  as in locality::SlabDecomposition. Each rank passes the points it holds,
+ *  which may lie anywhere in the box, and the points are migrated to the
+ *  ranks owning their domains. Every rank then also receives the ghosts of
+ *  its domain, i.e. the points of the other ranks within ghost_width of the
+ *  domain, so that the points owned by a rank have all their neighbors within
+ *  ghost_width among its points and ghosts. Neither the migration nor the
+ *  ghost exchange gathers the point set on any rank.
+ *
+ *  The NeighborQuery of a rank holds its owned points followed by its ghosts
+ *  and has the box of the whole point set, so that ghosts are found through
+ *  the periodic boundaries without being translated. Every point carries a
+ *  global tag, by default its index in the concatenation of the points
+ *  passed by all ranks in rank order.
+ *
+ *  All methods taking the communicator are collective and must be called on
+ *  all ranks.
+ */
+class DomainDecomposition
+{
+public:
+    //! Constructor
+    /*! \param comm Communicator of the ranks, which must outlive the decomposition.
+     *  \param box Box of the point set.
+     *  \param ghost_width Width of the ghost layers, i.e. the largest distance of the neighbors to be found.
+     */
+    DomainDecomposition(MPI_Comm comm, const box::Box& box, float ghost_width);
+
+    //! Migrate the points held by this rank to their owners and exchange the ghosts.
+    /*! \param points Points held by this rank.
+     *  \param n_points Number of points held by this rank.
+     *  \param tags Global tags of the points, or nullptr to tag points by their global index.
+     */
+    void distribute(const vec3<float>* points, unsigned int n_points, const uint64_t* tags = nullptr);
+
+    //! Get the communicator of the ranks.
+    MPI_Comm getCommunicator() const
+    {
+        return m_comm;
+    }
+
+    //! Get the rank of this process.
+    int getRank() const
+    {
+        return m_rank;
+    }
+
+    //! Get the number of ranks.
+    int getNumRanks() const
+    {
+        return m_num_ranks;
+    }
+
+    //! Get the box of the point set.
+    const box::Box& getBox() const
+    {
+        return m_box;
+    }
+
+    //! Get the width of the ghost layers.
+    float getGhostWidth() const
+    {
+        return m_ghost_width;
+    }
+
+    //! Get the points owned by this rank, followed by its ghosts.
+    const std::vector<vec3<float>>& getPoints() const
+    {
+        return m_points;
+    }
+
+    //! Get the global tags of the points owned by this rank, followed by those of its ghosts.
+    const std::vector<uint64_t>& getTags() const
+    {
+        return m_tags;
+    }
+
+    //! Get the number of points owned by this rank.
+    unsigned int getNOwned() const
+    {
+        return m_n_owned;
+    }
+
+    //! Get the number of ghosts of this rank.
+    unsigned int getNGhosts() const
+    {
+        return static_cast<unsigned int>(m_points.size()) - m_n_owned;
+    }
+
+    //! Get the number of points owned by all ranks.
+    uint64_t getNTotal() const
+    {
+        return m_n_total;
+    }
+
+    //! Get the NeighborQuery of the points owned by this rank and its ghosts.
+    const locality::NeighborQuery* getNeighborQuery() const
+    {
+        return m_neighbor_query.get();
+    }
+
+    //! Send a value of each point owned by this rank to its ghost copies on the other ranks.
+    /*! \param owned_values Values of the points owned by this rank.
+     *  \param ghost_values Output values of the ghosts of this rank.
+     */
+    template<typename T> void exchangeGhosts(const T* owned_values, T* ghost_values) const
+    {
+        std::vector<T> send_values(m_ghost_sends.size());
+        for (size_t i = 0; i < m_ghost_sends.size(); ++i)
+        {
+            send_values[i] = owned_values[m_ghost_sends[i]];
+        }
+        exchangeBytes(send_values.data(), m_ghost_send_counts, ghost_values, m_ghost_receive_counts,
+                      sizeof(T));
+    }
+
+private:
+    //! Exchange elements of size bytes between all ranks, given the numbers of elements per rank.
+    void exchangeBytes(const void* send, const std::vector<int>& send_counts, void* receive,
+                       const std::vector<int>& receive_counts, size_t size) const;
+
+    //! Get the numbers of elements received from all ranks, given the numbers sent to all ranks.
+    std::vector<int> exchangeCounts(const std::vector<int>& send_counts) const;
+
+    MPI_Comm m_comm;                //!< Communicator of the ranks
+    int m_rank;                     //!< Rank of this process
+    int m_num_ranks;                //!< Number of ranks
+    box::Box m_box;                 //!< Box of the point set
+    float m_ghost_width;            //!< Width of the ghost layers
+    float m_fractional_ghost_width; //!< Width of the ghost layers in fractional coordinates
+
+    std::vector<vec3<float>> m_points; //!< Points owned by this rank, followed by its ghosts
+    std::vector<uint64_t> m_tags;      //!< Global tags of the points and ghosts
+    unsigned int m_n_owned {0};        //!< Number of points owned by this rank
+    uint64_t m_n_total {0};            //!< Number of points owned by all ranks
+    std::unique_ptr<locality::NeighborQuery> m_neighbor_query; //!< NeighborQuery of the points and ghosts
+
+    std::vector<unsigned int> m_ghost_sends; //!< Owned points sent as ghosts, grouped by rank
+    std::vector<int> m_ghost_send_counts;    //!< Number of ghosts sent to each rank
+    std::vector<int> m_ghost_receive_counts; //!< Number of ghosts received from each rank
+};
+
+}; }; // end namespace freud::distributed
+
+#endif // DOMAIN_DECOMPOSITION_H
@@ -1,6 +1,9 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <cmath>
+#include <vector>
+
 #include "AngularSeparation.h"
 #include "NeighborComputeFunctional.h"
 #include "utils.h"
@@ -11,43 +14,87 @@
 
 namespace freud { namespace environment {
 
-float computeSeparationAngle(const quat<float>& ref_q, const quat<float>& q)
+namespace {
+//! Rotation angle 2 acos(<a, b>) between two unit quaternions, evaluated stably for small angles.
+double separationAngle(const quat<double>& a, const quat<double>& b)
 {
-    quat<float> R = q * conj(ref_q);
-    auto theta = float(2.0 * std::acos(util::clamp(R.s, -1, 1)));
-    return theta;
+    const quat<double> difference(a.s - b.s, a.v - b.v);
+    const quat<double> sum(a.s + b.s, a.v + b.v);
+    return 4 * std::atan2(std::sqrt(norm2(difference)), std::sqrt(norm2(sum)));
 }
 
-// The set of all equivalent quaternions equiv_qs is the set that takes the particle as it
-// is defined to some global reference orientation. Thus, to be safe, we must include
-// a rotation by qconst as defined below when doing the calculation.
-// Important: equiv_qs must include both q and -q, for all included quaternions
-float computeMinSeparationAngle(const quat<float>& ref_q, const quat<float>& q, const quat<float>* equiv_qs,
-                                unsigned int n_equiv_quats)
+//! Equivalent orientations searched for the one closest to a reference orientation.
+/*! The separation angle between ref_q and q rotated by an equivalent
+ *  orientation qe is 2 acos(<q qconst^* qe, ref_q>), where <a, b> is the inner
+ *  product of the quaternions as 4-vectors. Since <a b, c> = <b, a^* c>, this
+ *  is 2 acos(<qe, p>) with p = (q qconst^*)^* ref_q, which is computed once for
+ *  each pair of orientations. The closest equivalent orientation is then the
+ *  one with the largest inner product with p, found with four multiply-adds
+ *  per equivalent orientation over components stored contiguously, and only
+ *  its angle is evaluated.
+ */
+class EquivalentOrientations
 {
-    quat<float> qconst = equiv_qs[0];
-    // here we undo a rotation represented by one of the equivalent orientations
-    quat<float> qtemp = q * conj(qconst);
-
-    // start with the quaternion before it has been rotated by equivalent rotations
-    float min_angle = computeSeparationAngle(ref_q, q);
-
-    // loop through all equivalent rotations and see if they have smaller angles with ref_q
-    for (unsigned int i = 0; i < n_equiv_quats; ++i)
+public:
+    //! Constructor
+    /*! The set of all equivalent quaternions equiv_qs is the set that takes the particle as it
+     *  is defined to some global reference orientation. Thus, to be safe, we must include
+     *  a rotation by qconst = equiv_qs[0] when doing the calculation.
+     *  Important: equiv_qs must include both q and -q, for all included quaternions
+     */
+    EquivalentOrientations(const quat<float>* equiv_qs, unsigned int n_equiv_quats)
+        : m_equiv_qs(equiv_qs, equiv_qs + n_equiv_quats), m_s(n_equiv_quats), m_x(n_equiv_quats),
+          m_y(n_equiv_quats), m_z(n_equiv_quats), m_qconst(n_equiv_quats > 0 ? equiv_qs[0] : quat<float>())
     {
-        quat<float> qe = equiv_qs[i];
-        quat<float> qtest = qtemp * qe;
+        for (unsigned int i = 0; i < n_equiv_quats; ++i)
+        {
+            m_s[i] = equiv_qs[i].s;
+            m_x[i] = equiv_qs[i].v.x;
+            m_y[i] = equiv_qs[i].v.y;
+            m_z[i] = equiv_qs[i].v.z;
+        }
+    }
 
-        float angle_test = computeSeparationAngle(ref_q, qtest);
+    //! Minimum separation angle between ref_q and q rotated by any of the equivalent orientations.
+    float minSeparationAngle(const quat<float>& ref_q, const quat<float>& q) const
+    {
+        // here we undo a rotation represented by one of the equivalent orientations
+        const quat<double> qtemp = quat<double>(q) * conj(quat<double>(m_qconst));
+        const quat<double> p = conj(qtemp) * quat<double>(ref_q);
+        const auto p_s = static_cast<float>(p.s);
+        const auto p_x = static_cast<float>(p.v.x);
+        const auto p_y = static_cast<float>(p.v.y);
+        const auto p_z = static_cast<float>(p.v.z);
+
+        // start with the quaternion before it has been rotated by equivalent rotations
+        float max_product = dot(q.v, ref_q.v) + q.s * ref_q.s;
+        int closest = -1;
+        for (unsigned int i = 0; i < m_s.size(); ++i)
+        {
+            const float product = m_s[i] * p_s + m_x[i] * p_x + m_y[i] * p_y + m_z[i] * p_z;
+            if (product > max_product)
+            {
+                max_product = product;
+                closest = static_cast<int>(i);
+            }
+        }
 
-        if (angle_test < min_angle)
+        if (closest < 0)
         {
-            min_angle = angle_test;
+            return static_cast<float>(separationAngle(quat<double>(q), quat<double>(ref_q)));
         }
+        return static_cast<float>(separationAngle(quat<double>(m_equiv_qs[closest]), p));
     }
 
-    return min_angle;
-}
+private:
+    std::vector<quat<float>> m_equiv_qs; //!< Equivalent orientations
+    std::vector<float> m_s;              //!< Scalar components of the equivalent orientations
+    std::vector<float> m_x;              //!< x components of the equivalent orientations
+    std::vector<float> m_y;              //!< y components of the equivalent orientations
+    std::vector<float> m_z;              //!< z components of the equivalent orientations
+    quat<float> m_qconst;                //!< Equivalent orientation undone before applying the others
+};
+} // namespace
 
 void AngularSeparationNeighbor::compute(const locality::NeighborQuery* nq, const quat<float>* orientations,
                                         const vec3<float>* query_points,
@@ -61,6 +108,7 @@ void AngularSeparationNeighbor::compute(const locality::NeighborQuery* nq, const
 
     const size_t tot_num_neigh = m_nlist.getNumBonds();
     m_angles.prepare(tot_num_neigh);
+    const EquivalentOrientations equivalents(equiv_orientations, n_equiv_orientations);
 
     util::forLoopWrapper(0, nq->getNPoints(), [&](size_t begin, size_t end) {
         size_t bond(m_nlist.find_first_index(begin));
@@ -73,8 +121,7 @@ void AngularSeparationNeighbor::compute(const locality::NeighborQuery* nq, const
                 const size_t j(m_nlist.getNeighbors()(bond, 1));
                 quat<float> query_q = query_orientations[j];
 
-                float theta = computeMinSeparationAngle(q, query_q, equiv_orientations, n_equiv_orientations);
-                m_angles[bond] = theta;
+                m_angles[bond] = equivalents.minSeparationAngle(q, query_q);
             }
         }
     });
@@ -86,6 +133,7 @@ void AngularSeparationGlobal::compute(const quat<float>* global_orientations, un
                                       unsigned int n_equiv_orientations)
 {
     m_angles.prepare({n_points, n_global});
+    const EquivalentOrientations equivalents(equiv_orientations, n_equiv_orientations);
 
     util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
         for (size_t i = begin; i < end; ++i)
@@ -93,10 +141,7 @@ void AngularSeparationGlobal::compute(const quat<float>* global_orientations, un
             quat<float> q = orientations[i];
             for (unsigned int j = 0; j < n_global; j++)
             {
-                quat<float> global_q = global_orientations[j];
-                float theta
-                    = computeMinSeparationAngle(q, global_q, equiv_orientations, n_equiv_orientations);
-                m_angles(i, j) = theta;
+                m_angles(i, j) = equivalents.minSeparationAngle(q, global_orientations[j]);
             }
         }
     });
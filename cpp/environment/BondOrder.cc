@@ -8,6 +8,7 @@
 #endif
 
 #include "BondOrder.h"
+#include "DirectionBins.h"
 #include "NeighborComputeFunctional.h"
 #include "utils.h"
 
@@ -68,8 +69,14 @@ void BondOrder::reduce()
     m_histogram.prepare(m_histogram.shape());
     m_bo_array.prepare(m_histogram.shape());
 
-    m_histogram.reduceOverThreadsPerBin(m_local_histograms, [&](size_t i) {
-        m_bo_array[i] = m_histogram[i] / m_sa_array[i] / static_cast<float>(m_frame_counter);
+    // The normalization is computed in the precision of the accumulation.
+    util::dispatchAccumulator(false, [&](auto zero) {
+        using Accumulator = decltype(zero);
+        m_histogram.reduceOverThreadsPerBin(m_local_histograms, [&](size_t i) {
+            m_bo_array[i] = static_cast<float>(static_cast<Accumulator>(m_histogram[i])
+                                               / static_cast<Accumulator>(m_sa_array[i])
+                                               / static_cast<Accumulator>(m_frame_counter));
+        });
     });
 }
 
@@ -83,48 +90,88 @@ void BondOrder::accumulate(const locality::NeighborQuery* neighbor_query, quat<f
                            unsigned int n_query_points, const freud::locality::NeighborList* nlist,
                            freud::locality::QueryArgs qargs)
 {
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          const quat<float>& ref_q(orientations[neighbor_bond.point_idx]);
-                          vec3<float> v(bondVector(neighbor_bond, neighbor_query, query_points));
-                          const quat<float>& q = query_orientations[neighbor_bond.query_point_idx];
-                          if (m_mode == obcd)
-                          {
-                              // give bond directions of neighboring particles rotated by the matrix
-                              // that takes the orientation of particle neighbor_bond.id to the orientation of
-                              // particle neighbor_bond.ref_id.
-                              v = rotate(conj(ref_q), v);
-                              v = rotate(q, v);
-                          }
-                          else if (m_mode == lbod)
-                          {
-                              // give bond directions of neighboring particles rotated into the
-                              // local orientation of the central particle.
-                              v = rotate(conj(ref_q), v);
-                          }
-                          else if (m_mode == oocd)
-                          {
-                              // give the directors of neighboring particles rotated into the local
-                              // orientation of the central particle. pick a (random vector)
-                              vec3<float> z(0, 0, 1);
-                              // rotate that vector by the orientation of the neighboring particle
-                              z = rotate(q, z);
-                              // get the direction of this vector with respect to the orientation of
-                              // the central particle
-                              v = rotate(conj(ref_q), z);
-                          }
-
-                          // NOTE that angles are defined in the "mathematical" way, rather than how
-                          // most physics textbooks do it. get theta (azimuthal angle), phi (polar
-                          // angle)
-                          float theta = std::atan2(v.y, v.x); //-Pi..Pi
-                          theta = util::modulusPositive(theta, constants::TWO_PI);
-
-                          // NOTE that the below has replaced the commented out expression for phi.
-                          float phi = std::acos(v.z / std::sqrt(dot(v, v))); // 0..Pi
-
-                          m_local_histograms(theta, phi);
-                      });
+    const DirectionBins bins(m_histogram.getAxes());
+    accumulateGeneralRanges(neighbor_query, query_points, n_query_points, nlist, qargs, [&]() {
+        auto& local_histogram = m_local_histograms.local();
+        return [&](const freud::locality::NeighborBond& neighbor_bond) {
+            const vec3<float> v(
+                bondDirection(neighbor_bond, neighbor_query, query_points, orientations, query_orientations));
+            local_histogram.increment(bins.bin(v));
+        };
+    });
+}
+
+void BondOrder::beginBonds(const locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                           unsigned int n_query_points, const locality::NeighborList& /*nlist*/)
+{
+    if (m_stage_orientations == nullptr || m_stage_query_orientations == nullptr)
+    {
+        throw std::invalid_argument("BondOrder requires orientations to consume bonds.");
+    }
+    m_box = neighbor_query->getBox();
+    m_stage_neighbor_query = neighbor_query;
+    m_stage_query_points = query_points;
+    m_stage_n_query_points = n_query_points;
+    m_stage_bins = std::make_unique<DirectionBins>(m_histogram.getAxes());
+}
+
+void BondOrder::consumeBonds(const locality::NeighborList& nlist, size_t /*begin*/, size_t /*end*/,
+                             size_t first_bond, size_t end_bond)
+{
+    auto& local_histogram = m_local_histograms.local();
+    const unsigned int* neighbors = nlist.getNeighbors().get();
+    const float* distances = nlist.getDistances().get();
+    const float* weights = nlist.getWeights().get();
+    for (size_t bond = first_bond; bond < end_bond; ++bond)
+    {
+        const freud::locality::NeighborBond neighbor_bond(neighbors[2 * bond], neighbors[2 * bond + 1],
+                                                          distances[bond], weights[bond]);
+        local_histogram.increment(
+            m_stage_bins->bin(bondDirection(neighbor_bond, m_stage_neighbor_query, m_stage_query_points,
+                                            m_stage_orientations, m_stage_query_orientations)));
+    }
+}
+
+void BondOrder::endBonds(const locality::NeighborList& /*nlist*/)
+{
+    m_stage_bins.reset();
+    finishFrame(m_stage_neighbor_query, m_stage_n_query_points);
+}
+
+vec3<float> BondOrder::bondDirection(const locality::NeighborBond& neighbor_bond,
+                                     const locality::NeighborQuery* neighbor_query,
+                                     const vec3<float>* query_points, const quat<float>* orientations,
+                                     const quat<float>* query_orientations) const
+{
+    const quat<float>& ref_q(orientations[neighbor_bond.point_idx]);
+    vec3<float> v(bondVector(neighbor_bond, neighbor_query, query_points));
+    const quat<float>& q = query_orientations[neighbor_bond.query_point_idx];
+    if (m_mode == obcd)
+    {
+        // give bond directions of neighboring particles rotated by the matrix
+        // that takes the orientation of particle neighbor_bond.id to the orientation of
+        // particle neighbor_bond.ref_id.
+        v = rotate(conj(ref_q), v);
+        v = rotate(q, v);
+    }
+    else if (m_mode == lbod)
+    {
+        // give bond directions of neighboring particles rotated into the
+        // local orientation of the central particle.
+        v = rotate(conj(ref_q), v);
+    }
+    else if (m_mode == oocd)
+    {
+        // give the directors of neighboring particles rotated into the local
+        // orientation of the central particle. pick a (random vector)
+        vec3<float> z(0, 0, 1);
+        // rotate that vector by the orientation of the neighboring particle
+        z = rotate(q, z);
+        // get the direction of this vector with respect to the orientation of
+        // the central particle
+        v = rotate(conj(ref_q), z);
+    }
+    return v;
 }
 
 }; }; // end namespace freud::environment
@@ -4,8 +4,12 @@
 #ifndef BOND_ORDER_H
 #define BOND_ORDER_H
 
+#include <memory>
+
 #include "BondHistogramCompute.h"
+#include "BondPipeline.h"
 #include "Box.h"
+#include "DirectionBins.h"
 #include "Histogram.h"
 #include "ManagedArray.h"
 #include "NeighborList.h"
@@ -30,7 +34,7 @@ typedef enum // NOLINT(modernize-use-using)
 //! Compute the bond order parameter for a set of points
 /*!
  */
-class BondOrder : public locality::BondHistogramCompute
+class BondOrder : public locality::BondHistogramCompute, public locality::BondStage
 {
 public:
     //! Constructor
@@ -44,6 +48,27 @@ public:
                     vec3<float>* query_points, quat<float>* query_orientations, unsigned int n_query_points,
                     const freud::locality::NeighborList* nlist, freud::locality::QueryArgs qargs);
 
+    //! Set the orientations of the points and query points of the bonds consumed by computeBondStages.
+    /*! The orientations are used by every following call to computeBondStages
+     *  or computeBondStagesFrames, and must outlive those calls.
+     */
+    void setOrientations(const quat<float>* orientations, const quat<float>* query_orientations)
+    {
+        m_stage_orientations = orientations;
+        m_stage_query_orientations = query_orientations;
+    }
+
+    //! Prepare the accumulation of the bonds consumed by computeBondStages as a frame.
+    void beginBonds(const locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                    unsigned int n_query_points, const locality::NeighborList& nlist) override;
+
+    //! Add the bonds of a block of query points to the histogram.
+    void consumeBonds(const locality::NeighborList& nlist, size_t begin, size_t end, size_t first_bond,
+                      size_t end_bond) override;
+
+    //! Count the frame of the consumed bonds.
+    void endBonds(const locality::NeighborList& nlist) override;
+
     void reduce() override;
 
     //! Get a reference to the last computed bond order
@@ -55,9 +80,21 @@ public:
     }
 
 private:
+    //! Get the direction of a bond binned in the mode of the bond order.
+    vec3<float> bondDirection(const locality::NeighborBond& neighbor_bond,
+                              const locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                              const quat<float>* orientations, const quat<float>* query_orientations) const;
+
     util::ManagedArray<float> m_bo_array; //!< bond order array computed
     util::ManagedArray<float> m_sa_array; //!< surface area array computed
     BondOrderMode m_mode;                 //!< The mode to calculate with.
+
+    const quat<float>* m_stage_orientations {nullptr};       //!< Orientations of the consumed bonds' points
+    const quat<float>* m_stage_query_orientations {nullptr}; //!< Orientations of their query points
+    const locality::NeighborQuery* m_stage_neighbor_query {nullptr}; //!< Points of the consumed bonds
+    const vec3<float>* m_stage_query_points {nullptr};               //!< Query points of the consumed bonds
+    unsigned int m_stage_n_query_points {0};          //!< Number of query points of the consumed bonds
+    std::unique_ptr<DirectionBins> m_stage_bins;      //!< Bins of the directions of the consumed bonds
 };
 
 }; }; // end namespace freud::environment
@@ -0,0 +1,91 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef DIRECTION_BINS_H
+#define DIRECTION_BINS_H
+
+#include <cmath>
+#include <vector>
+
+#include "AngleBins.h"
+#include "Histogram.h"
+#include "VectorMath.h"
+#include "utils.h"
+
+/*! \file DirectionBins.h
+    \brief Bins of the spherical angles of directions computed from their Cartesian components.
+*/
+
+namespace freud { namespace environment {
+
+//! Bins of the azimuthal and polar angles of directions on regular axes of (0, 2pi) and (0, pi).
+/*! The angles are not evaluated for most directions. The azimuthal angle is
+ *  mapped monotonically to the "diamond angle" y / (|x| + |y|) shifted by the
+ *  quadrant, and the polar angle to its cosine, which are binned with lookup
+ *  tables of the edges of the bins transformed the same way. The derivatives
+ *  of both maps with respect to the angles are at most one, so directions
+ *  farther than EDGE_MARGIN from all transformed edges are farther from the
+ *  edges of the angles than any rounding error of evaluating and binning
+ *  the angles, and get the same bins as the angles would. The angles of the
+ *  remaining directions, including those along the z axis, are evaluated and
+ *  binned as before.
+ */
+class DirectionBins
+{
+public:
+    //! Constructor
+    /*! \param axes The axes of the azimuthal and polar angles.
+     */
+    explicit DirectionBins(const util::Axes& axes)
+        : m_axes(axes), m_theta_bins(axes[0]->size()), m_phi_edges(phiEdges(axes[1]->size())),
+          m_n_bins_phi(axes[1]->size())
+    {}
+
+    //! Find the linear bin of a nonzero direction.
+    size_t bin(const vec3<float>& v) const
+    {
+        // Same expression as for the angle below
+        const float cos_phi = v.z / std::sqrt(dot(v, v));
+        size_t theta_bin = 0;
+        size_t phi_bin = 0;
+        if (m_theta_bins.find(v.x, v.y, EDGE_MARGIN, theta_bin)
+            && m_phi_edges.find(-cos_phi, EDGE_MARGIN, phi_bin))
+        {
+            return theta_bin * m_n_bins_phi + phi_bin;
+        }
+
+        // NOTE that angles are defined in the "mathematical" way, rather than how
+        // most physics textbooks do it. get theta (azimuthal angle), phi (polar
+        // angle)
+        float theta = std::atan2(v.y, v.x); //-Pi..Pi
+        theta = util::modulusPositive(theta, constants::TWO_PI);
+        const float phi = std::acos(cos_phi); // 0..Pi
+        return m_axes.bin(theta, phi);
+    }
+
+private:
+    //! Distance from the transformed edges within which the angles are evaluated.
+    static constexpr double EDGE_MARGIN = 1e-5;
+
+    //! Negative cosines of the edges of the bins of the polar angle, which are increasing.
+    static util::EdgeLookup phiEdges(size_t n_bins)
+    {
+        std::vector<double> edges(n_bins + 1);
+        for (size_t j = 0; j <= n_bins; ++j)
+        {
+            edges[j] = -std::cos(M_PI * static_cast<double>(j) / static_cast<double>(n_bins));
+        }
+        edges.front() = -1;
+        edges.back() = 1;
+        return util::EdgeLookup(edges);
+    }
+
+    util::StaticAxes<util::RegularAxis, util::RegularAxis> m_axes; //!< Axes of the angles
+    util::AzimuthBins m_theta_bins;                                 //!< Bins of the azimuthal angle
+    util::EdgeLookup m_phi_edges;                                   //!< Edges of the polar bins
+    size_t m_n_bins_phi;                                            //!< Number of bins of the polar angle
+};
+
+}; }; // end namespace freud::environment
+
+#endif // DIRECTION_BINS_H
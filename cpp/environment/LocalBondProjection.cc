@@ -1,6 +1,8 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <vector>
+
 #include "LocalBondProjection.h"
 #include "NeighborComputeFunctional.h"
 
@@ -46,6 +48,70 @@ float computeMaxProjection(const vec3<float>& proj_vec, const vec3<float>& local
     return max_proj;
 }
 
+namespace {
+//! The projection vectors rotated by all equivalent orientations.
+/*! The rotated vectors of computeMaxProjection only depend on the projection
+ *  vectors and the equivalent orientations, so they are computed once for all
+ *  bonds. The maximal projections of a bond onto all projection vectors then
+ *  reduce to dot products with the components of the rotated vectors, which
+ *  are stored contiguously for each projection vector.
+ */
+class EquivalentProjections
+{
+public:
+    EquivalentProjections(const vec3<float>* proj_vecs, unsigned int n_proj, const quat<float>* equiv_qs,
+                          unsigned int n_equiv_qs)
+        : m_n_candidates(n_equiv_qs + 1)
+    {
+        const size_t n_vectors = size_t(n_proj) * m_n_candidates;
+        m_x.resize(n_vectors);
+        m_y.resize(n_vectors);
+        m_z.resize(n_vectors);
+        for (unsigned int k = 0; k < n_proj; ++k)
+        {
+            // start with the reference vector before it has been rotated by equivalent quaternions
+            set(size_t(k) * m_n_candidates, proj_vecs[k]);
+            for (unsigned int i = 0; i < n_equiv_qs; ++i)
+            {
+                // here we undo a rotation represented by one of the equivalent orientations
+                const quat<float> qtest = conj(equiv_qs[0]) * equiv_qs[i];
+                set(size_t(k) * m_n_candidates + i + 1, rotate(qtest, proj_vecs[k]));
+            }
+        }
+    }
+
+    //! Maximal projection of a bond onto the equivalent vectors of projection vector k.
+    float maxProjection(unsigned int k, const vec3<float>& local_bond) const
+    {
+        const size_t begin = size_t(k) * m_n_candidates;
+        const float x = local_bond.x;
+        const float y = local_bond.y;
+        const float z = local_bond.z;
+        float max_proj = m_x[begin] * x + m_y[begin] * y + m_z[begin] * z;
+        for (size_t idx = begin + 1; idx < begin + m_n_candidates; ++idx)
+        {
+            const float proj_test = m_x[idx] * x + m_y[idx] * y + m_z[idx] * z;
+            max_proj = (proj_test > max_proj) ? proj_test : max_proj;
+        }
+        return max_proj;
+    }
+
+private:
+    //! Store a rotated vector.
+    void set(size_t idx, const vec3<float>& v)
+    {
+        m_x[idx] = v.x;
+        m_y[idx] = v.y;
+        m_z[idx] = v.z;
+    }
+
+    size_t m_n_candidates;  //!< Number of equivalent vectors of each projection vector
+    std::vector<float> m_x; //!< x components of the equivalent vectors
+    std::vector<float> m_y; //!< y components of the equivalent vectors
+    std::vector<float> m_z; //!< z components of the equivalent vectors
+};
+} // namespace
+
 void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<float>* orientations,
                                   const vec3<float>* query_points, unsigned int n_query_points,
                                   const vec3<float>* proj_vecs, unsigned int n_proj,
@@ -56,19 +122,26 @@ void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<
     m_nlist = locality::makeDefaultNlist(nq, nlist, query_points, n_query_points, qargs);
 
     // Get the maximum total number of bonds in the neighbor list
-    const unsigned int tot_num_neigh = m_nlist.getNumBonds();
+    const size_t tot_num_neigh = m_nlist.getNumBonds();
 
     m_local_bond_proj.prepare({tot_num_neigh, n_proj});
     m_local_bond_proj_norm.prepare({tot_num_neigh, n_proj});
+    const EquivalentProjections equivalents(proj_vecs, n_proj, equiv_orientations, n_equiv_orientations);
+
+    // Read and write the per-bond arrays directly to avoid the indirection
+    // and bounds checks of ManagedArray indexing in the inner loop.
+    const unsigned int* neighbors = m_nlist.getNeighbors().get();
+    float* local_bond_proj = m_local_bond_proj.get();
+    float* local_bond_proj_norm = m_local_bond_proj_norm.get();
 
     // compute the order parameter
     util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
         size_t bond(m_nlist.find_first_index(begin));
         for (size_t i = begin; i < end; ++i)
         {
-            for (; bond < tot_num_neigh && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+            for (; bond < tot_num_neigh && neighbors[2 * bond] == i; ++bond)
             {
-                const size_t j(m_nlist.getNeighbors()(bond, 1));
+                const size_t j(neighbors[2 * bond + 1]);
 
                 // compute bond vector between the two particles
                 vec3<float> local_bond(bondVector(locality::NeighborBond(i, j), nq, query_points));
@@ -79,11 +152,9 @@ void LocalBondProjection::compute(const locality::NeighborQuery* nq, const quat<
 
                 for (unsigned int k = 0; k < n_proj; k++)
                 {
-                    vec3<float> proj_vec = proj_vecs[k];
-                    float max_proj = computeMaxProjection(proj_vec, local_bond, equiv_orientations,
-                                                          n_equiv_orientations);
-                    m_local_bond_proj(bond, k) = max_proj;
-                    m_local_bond_proj_norm(bond, k) = max_proj / local_bond_len;
+                    const float max_proj = equivalents.maxProjection(k, local_bond);
+                    local_bond_proj[bond * n_proj + k] = max_proj;
+                    local_bond_proj_norm[bond * n_proj + k] = max_proj / local_bond_len;
                 }
             }
         }
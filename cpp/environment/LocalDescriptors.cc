@@ -1,10 +1,14 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include "LocalDescriptors.h"
 #include "NeighborComputeFunctional.h"
+#include "SphericalHarmonics.h"
 #include "diagonalize.h"
 
 /*! \file LocalDescriptors.cc
@@ -14,9 +18,54 @@
 namespace freud { namespace environment {
 
 LocalDescriptors::LocalDescriptors(unsigned int l_max, bool negative_m,
-                                   LocalDescriptorOrientation orientation)
-    : m_l_max(l_max), m_negative_m(negative_m), m_nSphs(0), m_orientation(orientation)
-{}
+                                   LocalDescriptorOrientation orientation, bool packed)
+    : m_l_max(l_max), m_negative_m(negative_m), m_packed(packed), m_nSphs(0), m_orientation(orientation)
+{
+    if (packed && negative_m)
+    {
+        throw std::invalid_argument(
+            "LocalDescriptors can only pack the spherical harmonics if negative_m is false.");
+    }
+}
+
+void LocalDescriptors::storeHarmonics(const order::SphericalHarmonicBlock& block, size_t first_bond)
+{
+    // The harmonics of m > 0 are stored without the Condon-Shortley phase,
+    // and those of negative m are their complex conjugates.
+    const unsigned int width = getSphWidth();
+    for (unsigned int b = 0; b < block.size(); ++b)
+    {
+        const size_t offset = (first_bond + b) * width;
+        for (unsigned int l = 0; l <= m_l_max; ++l)
+        {
+            if (m_packed)
+            {
+                float* ylm = &m_sphPackedArray[offset + l * l];
+                ylm[0] = block.getHarmonic(b, l, 0).real();
+                for (unsigned int m = 1; m <= l; ++m)
+                {
+                    const float sign = (m % 2 == 1) ? float(-1) : float(1);
+                    const std::complex<float> y = sign * block.getHarmonic(b, l, m);
+                    ylm[2 * m - 1] = y.real();
+                    ylm[2 * m] = y.imag();
+                }
+                continue;
+            }
+
+            std::complex<float>* ylm
+                = &m_sphArray[offset + (m_negative_m ? l * l : l * (l + 1) / 2)];
+            for (unsigned int m = 0; m <= l; ++m)
+            {
+                const float sign = (m % 2 == 1) ? float(-1) : float(1);
+                ylm[m] = sign * block.getHarmonic(b, l, m);
+                if (m_negative_m && m > 0)
+                {
+                    ylm[l + m] = std::conj(ylm[m]);
+                }
+            }
+        }
+    }
+}
 
 void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<float>* query_points,
                                unsigned int n_query_points, const quat<float>* orientations,
@@ -30,10 +79,20 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
     {
         max_num_neighbors = std::numeric_limits<unsigned int>::max();
     }
-    m_sphArray.prepare({m_nlist.getNumBonds(), getSphWidth()});
+    if (m_packed)
+    {
+        m_sphArray.prepare(0);
+        m_sphPackedArray.prepare({m_nlist.getNumBonds(), getSphWidth()});
+    }
+    else
+    {
+        m_sphArray.prepare({m_nlist.getNumBonds(), getSphWidth()});
+        m_sphPackedArray.prepare(0);
+    }
 
     util::forLoopWrapper(0, nq->getNPoints(), [&](size_t begin, size_t end) {
-        fsph::PointSPHEvaluator<float> sph_eval(m_l_max);
+        // The harmonics of the bonds of each point are evaluated in blocks.
+        order::SphericalHarmonicBlock block(m_l_max);
 
         for (size_t i = begin; i < end; ++i)
         {
@@ -100,11 +159,12 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
             }
 
             neighbor_count = 0;
+            block.clear();
+            size_t block_first_bond(bond);
             for (; bond < m_nlist.getNumBonds() && m_nlist.getNeighbors()(bond, 0) == i
                  && neighbor_count < max_num_neighbors;
                  ++bond, ++neighbor_count)
             {
-                const unsigned int sphCount(bond * getSphWidth());
                 const size_t j(m_nlist.getNeighbors()(bond, 1));
                 const vec3<float> r_ij(bondVector(locality::NeighborBond(i, j), nq, query_points));
                 const float r_sq(dot(r_ij, r_ij));
@@ -113,23 +173,28 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
 
                 const float magR(std::sqrt(r_sq));
 
-                // Wrap theta into [0, 2*pi]
-                float theta(std::atan2(bond_ij.y, bond_ij.x));
-                theta = util::modulusPositive(theta, constants::TWO_PI);
-
-                // Phi in [0, pi]
-                float phi(std::acos(bond_ij.z / magR));
-
-                // catch cases where bond_ij.z/magR falls outside [-1, 1]
-                // due to numerical issues
-                if (std::isnan(phi))
+                // Bonds of zero length have a polar angle of pi.
+                if (magR == float(0))
                 {
-                    phi = bond_ij.z > 0 ? 0 : M_PI;
+                    block.push_back(vec3<float>(0, 0, -1), 1, 1);
+                }
+                else
+                {
+                    block.push_back(bond_ij, magR, 1);
                 }
 
-                sph_eval.compute(phi, theta);
-
-                std::copy(sph_eval.begin(m_negative_m), sph_eval.end(), &m_sphArray[sphCount]);
+                if (block.full())
+                {
+                    block.evaluate();
+                    storeHarmonics(block, block_first_bond);
+                    block.clear();
+                    block_first_bond = bond + 1;
+                }
+            }
+            if (!block.empty())
+            {
+                block.evaluate();
+                storeHarmonics(block, block_first_bond);
             }
         }
     });
@@ -138,4 +203,67 @@ void LocalDescriptors::compute(const locality::NeighborQuery* nq, const vec3<flo
     m_nSphs = m_nlist.getNumBonds();
 }
 
+void LocalDescriptors::computeSystems(const locality::SystemBatch& batch, const quat<float>* orientations,
+                                      locality::QueryArgs qargs, unsigned int max_num_neighbors)
+{
+    // Every system is computed by its own LocalDescriptors object, since the
+    // computes of the systems run concurrently, and their bonds and harmonics
+    // are then concatenated.
+    std::vector<std::unique_ptr<LocalDescriptors>> systems(batch.getNumSystems());
+    const std::vector<unsigned int>& offsets = batch.getOffsets();
+    batch.forEachSystem([&](unsigned int system, const locality::NeighborQuery* neighbor_query) {
+        systems[system] = std::make_unique<LocalDescriptors>(m_l_max, m_negative_m, m_orientation, m_packed);
+        systems[system]->compute(neighbor_query, neighbor_query->getPoints(), neighbor_query->getNPoints(),
+                                 (orientations != nullptr) ? orientations + offsets[system] : nullptr,
+                                 nullptr, qargs, max_num_neighbors);
+    });
+
+    std::vector<const locality::NeighborList*> system_nlists(batch.getNumSystems(), nullptr);
+    std::vector<size_t> bond_offsets(batch.getNumSystems() + 1, 0);
+    for (unsigned int system = 0; system < batch.getNumSystems(); ++system)
+    {
+        if (systems[system] != nullptr)
+        {
+            system_nlists[system] = systems[system]->getNList();
+        }
+        bond_offsets[system + 1]
+            = bond_offsets[system] + ((systems[system] != nullptr) ? systems[system]->getNSphs() : 0);
+    }
+    const std::unique_ptr<locality::NeighborList> nlist(batch.concatenate(system_nlists));
+    m_nlist = *nlist;
+
+    const unsigned int width = getSphWidth();
+    if (m_packed)
+    {
+        m_sphArray.prepare(0);
+        m_sphPackedArray.prepare({bond_offsets.back(), width});
+    }
+    else
+    {
+        m_sphArray.prepare({bond_offsets.back(), width});
+        m_sphPackedArray.prepare(0);
+    }
+    util::forLoopWrapper(0, batch.getNumSystems(), [&](size_t begin, size_t end) {
+        for (size_t system = begin; system < end; ++system)
+        {
+            if (systems[system] == nullptr)
+            {
+                continue;
+            }
+            const size_t first = bond_offsets[system] * width;
+            if (m_packed)
+            {
+                const util::ManagedArray<float>& sph = systems[system]->getPackedSph();
+                std::copy(sph.get(), sph.get() + sph.size(), m_sphPackedArray.get() + first);
+            }
+            else
+            {
+                const util::ManagedArray<std::complex<float>>& sph = systems[system]->getSph();
+                std::copy(sph.get(), sph.get() + sph.size(), m_sphArray.get() + first);
+            }
+        }
+    });
+    m_nSphs = bond_offsets.back();
+}
+
 }; }; // end namespace freud::environment
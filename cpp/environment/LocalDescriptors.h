@@ -10,13 +10,17 @@
 #include "ManagedArray.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
+#include "SystemBatch.h"
 #include "VectorMath.h"
-#include "fsph/src/spherical_harmonics.hpp"
 
 /*! \file LocalDescriptors.h
   \brief Computes local descriptors.
 */
 
+namespace freud { namespace order {
+class SphericalHarmonicBlock;
+}; }; // end namespace freud::order
+
 namespace freud { namespace environment {
 
 enum LocalDescriptorOrientation
@@ -36,7 +40,9 @@ public:
     //!
     //! \param l_max Maximum spherical harmonic l to consider
     //! \param negative_m whether to calculate Ylm for negative m
-    LocalDescriptors(unsigned int l_max, bool negative_m, LocalDescriptorOrientation orientation);
+    //! \param packed whether to store the Ylm with m >= 0 as real numbers, see getPackedSph
+    LocalDescriptors(unsigned int l_max, bool negative_m, LocalDescriptorOrientation orientation,
+                     bool packed = false);
 
     //! Get the last number of spherical harmonics computed
     unsigned int getNSphs() const
@@ -57,16 +63,52 @@ public:
                  const freud::locality::NeighborList* nlist, locality::QueryArgs qargs,
                  unsigned int max_num_neighbors = 0);
 
+    //! Compute the local neighborhood descriptors of every system of a batch
+    /*! The neighbor list and the harmonics of the bonds of all systems are
+     *  concatenated in the order of the systems, and the indices of the bonds
+     *  are those of the points of all systems.
+     *
+     *  \param batch The systems, whose points are also the query points.
+     *  \param orientations Orientations of the points of all systems, or nullptr.
+     *  \param qargs Query arguments of every system.
+     *  \param max_num_neighbors Maximum number of neighbors of each point, or 0 for no maximum.
+     */
+    void computeSystems(const locality::SystemBatch& batch, const quat<float>* orientations,
+                        locality::QueryArgs qargs, unsigned int max_num_neighbors = 0);
+
     //! Get a reference to the last computed spherical harmonic array
+    /*! This array is empty if the harmonics are packed.
+     */
     const util::ManagedArray<std::complex<float>>& getSph() const
     {
         return m_sphArray;
     }
 
-    //! Return the number of spherical harmonics that will be computed for each bond.
+    //! Get a reference to the last computed packed spherical harmonic array
+    /*! If the harmonics are packed, the harmonics with negative m, which are
+     *  the complex conjugates of those with positive m, are not stored, and
+     *  the harmonics with m >= 0 are stored as real numbers. For each l, the
+     *  array holds the real part of Ylm for m = 0 followed by the real and
+     *  imaginary parts of Ylm for m = 1, ..., l, so each bond has
+     *  (l_max + 1)^2 values, half the size of the complex array including
+     *  negative m. Otherwise, this array is empty.
+     */
+    const util::ManagedArray<float>& getPackedSph() const
+    {
+        return m_sphPackedArray;
+    }
+
+    //! Return the number of values of spherical harmonics that will be computed for each bond.
+    /*! This is the number of complex harmonics, or the number of real values
+     *  if the harmonics are packed.
+     */
     unsigned int getSphWidth() const
     {
-        return fsph::sphCount(m_l_max) + (m_l_max > 0 && m_negative_m ? fsph::sphCount(m_l_max - 1) : 0);
+        if (m_packed)
+        {
+            return (m_l_max + 1) * (m_l_max + 1);
+        }
+        return (m_l_max + 1) * (m_l_max + 2) / 2 + (m_negative_m ? m_l_max * (m_l_max + 1) / 2 : 0);
     }
 
     //! Return a pointer to the NeighborList used in the last call to compute.
@@ -80,20 +122,32 @@ public:
         return m_negative_m;
     }
 
+    bool getPacked() const
+    {
+        return m_packed;
+    }
+
     LocalDescriptorOrientation getMode() const
     {
         return m_orientation;
     }
 
 private:
+    //! Store the harmonics of the bonds in an evaluated block, the first of which has index first_bond.
+    void storeHarmonics(const order::SphericalHarmonicBlock& block, size_t first_bond);
+
     unsigned int m_l_max;                     //!< Maximum spherical harmonic l to calculate
     bool m_negative_m;                        //!< true if we should compute Ylm for negative m
+    bool m_packed;                            //!< true if we should store packed real Ylm
     unsigned int m_nSphs;                     //!< Last number of bond spherical harmonics computed
     locality::NeighborList m_nlist;           //!< The NeighborList used in the last call to compute.
     LocalDescriptorOrientation m_orientation; //!< The orientation mode to compute with.
 
     //! Spherical harmonics for each neighbor
     util::ManagedArray<std::complex<float>> m_sphArray;
+
+    //! Packed real spherical harmonics for each neighbor
+    util::ManagedArray<float> m_sphPackedArray;
 };
 
 }; }; // end namespace freud::environment
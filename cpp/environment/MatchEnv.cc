@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <sstream>
 #include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
 
 #include "MatchEnv.h"
 
@@ -12,27 +13,42 @@
 
 namespace freud { namespace environment {
 
+namespace {
+//! Number of particles whose environments are compared to a motif in parallel before merging.
+constexpr unsigned int motif_block_size = 1024;
+
+//! Schedule of loops over environments, whose registrations are expensive and of very uneven cost.
+constexpr util::LoopSchedule environment_schedule {1, util::Partitioner::simple};
+} // namespace
+
 /*****************
  * EnvDisjoinSet *
  *****************/
-EnvDisjointSet::EnvDisjointSet(unsigned int Np) : rank(std::vector<unsigned int>(Np, 0)), m_max_num_neigh(0)
-{}
+EnvDisjointSet::EnvDisjointSet(unsigned int Np)
+    : rank(std::vector<unsigned int>(Np, 0)), members(Np), m_max_num_neigh(0)
+{
+    for (unsigned int i = 0; i < Np; i++)
+    {
+        members[i].push_back(i);
+    }
+}
 
 void EnvDisjointSet::merge(const unsigned int a, const unsigned int b,
-                           BiMap<unsigned int, unsigned int> vec_map, rotmat3<float>& rotation)
+                           const util::IndexBiMap& vec_map, const rotmat3<float>& rotation)
 {
     // if tree heights are equal, merge b to a
     if (rank[s[a].env_ind] == rank[s[b].env_ind])
     {
         // Get the ENTIRE set that corresponds to head_b.
         unsigned int head_b = find(b);
-        std::vector<unsigned int> m_set = findSet(head_b);
+        std::vector<unsigned int> m_set;
+        m_set.swap(members[head_b]);
         for (unsigned int node : m_set)
         {
             // Go through the entire tree/set.
             // Make a copy of the old set of vector indices for this
             // particular node.
-            std::vector<unsigned int> old_node_vec_ind = s[node].vec_ind;
+            const auto old_node_vec_ind = s[node].vec_ind;
 
             // Set the vector indices properly.
             // Take the LEFT MAP view of the proper_a<->proper_b bimap.
@@ -41,7 +57,7 @@ void EnvDisjointSet::merge(const unsigned int a, const unsigned int b,
             // and set it properly.
             for (unsigned int proper_a_ind = 0; proper_a_ind < vec_map.size(); proper_a_ind++)
             {
-                unsigned int proper_b_ind = vec_map.left[proper_a_ind];
+                unsigned int proper_b_ind = vec_map.getRight(proper_a_ind);
 
                 // old_node_vec_ind[proper_b_ind] is "relative_b_ind"
                 s[node].vec_ind[proper_a_ind] = old_node_vec_ind[proper_b_ind];
@@ -57,6 +73,8 @@ void EnvDisjointSet::merge(const unsigned int a, const unsigned int b,
             // we've added another leaf to the tree or whatever the lingo is.
             rank[s[a].env_ind]++;
         }
+        std::vector<unsigned int>& head_members = members[s[a].env_ind];
+        head_members.insert(head_members.end(), m_set.begin(), m_set.end());
     }
     else
     {
@@ -65,13 +83,14 @@ void EnvDisjointSet::merge(const unsigned int a, const unsigned int b,
         {
             // Get the ENTIRE set that corresponds to head_b.
             unsigned int head_b = find(b);
-            std::vector<unsigned int> m_set = findSet(head_b);
+            std::vector<unsigned int> m_set;
+            m_set.swap(members[head_b]);
             for (unsigned int node : m_set)
             {
                 // Go through the entire tree/set.
                 // Make a copy of the old set of vector indices for this
                 // particular node. This is complicated and weird.
-                std::vector<unsigned int> old_node_vec_ind = s[node].vec_ind;
+                const auto old_node_vec_ind = s[node].vec_ind;
 
                 // Set the vector indices properly.
                 // Take the LEFT MAP view of the proper_a<->proper_b bimap.
@@ -80,7 +99,7 @@ void EnvDisjointSet::merge(const unsigned int a, const unsigned int b,
                 // and set it properly.
                 for (unsigned int proper_a_ind = 0; proper_a_ind < vec_map.size(); proper_a_ind++)
                 {
-                    unsigned int proper_b_ind = vec_map.left[proper_a_ind];
+                    unsigned int proper_b_ind = vec_map.getRight(proper_a_ind);
 
                     // old_node_vec_ind[proper_b_ind] is "relative_b_ind"
                     s[node].vec_ind[proper_a_ind] = old_node_vec_ind[proper_b_ind];
@@ -95,19 +114,22 @@ void EnvDisjointSet::merge(const unsigned int a, const unsigned int b,
                 // we've added another leaf to the tree or whatever the lingo is.
                 rank[s[a].env_ind]++;
             }
+            std::vector<unsigned int>& head_members = members[s[a].env_ind];
+            head_members.insert(head_members.end(), m_set.begin(), m_set.end());
         }
         else
         {
             rotmat3<float> rotationT = transpose(rotation);
             // Get the ENTIRE set that corresponds to head_a.
             unsigned int head_a = find(a);
-            std::vector<unsigned int> m_set = findSet(head_a);
+            std::vector<unsigned int> m_set;
+            m_set.swap(members[head_a]);
             for (unsigned int node : m_set)
             {
                 // Go through the entire tree/set.
                 // Make a copy of the old set of vector indices for this
                 // particular node. This is complicated and weird.
-                std::vector<unsigned int> old_node_vec_ind = s[node].vec_ind;
+                const auto old_node_vec_ind = s[node].vec_ind;
 
                 // Set the vector indices properly.
                 // Take the RIGHT MAP view of the proper_a<->proper_b bimap.
@@ -116,7 +138,7 @@ void EnvDisjointSet::merge(const unsigned int a, const unsigned int b,
                 // and set it properly.
                 for (unsigned int proper_b_ind = 0; proper_b_ind < vec_map.size(); proper_b_ind++)
                 {
-                    unsigned int proper_a_ind = vec_map.right[proper_b_ind];
+                    unsigned int proper_a_ind = vec_map.getLeft(proper_b_ind);
 
                     // old_node_vec_ind[proper_a_ind] is "relative_a_ind"
                     s[node].vec_ind[proper_b_ind] = old_node_vec_ind[proper_a_ind];
@@ -135,6 +157,8 @@ void EnvDisjointSet::merge(const unsigned int a, const unsigned int b,
                 // we've added another leaf to the tree or whatever the lingo is.
                 rank[s[b].env_ind]++;
             }
+            std::vector<unsigned int>& head_members = members[s[b].env_ind];
+            head_members.insert(head_members.end(), m_set.begin(), m_set.end());
         }
     }
 }
@@ -238,6 +262,13 @@ std::vector<vec3<float>> EnvDisjointSet::getAvgEnv(const unsigned int m)
 }
 
 std::vector<vec3<float>> EnvDisjointSet::getIndividualEnv(const unsigned int m)
+{
+    std::vector<vec3<float>> env(m_max_num_neigh);
+    getIndividualEnv(m, env.data());
+    return env;
+}
+
+void EnvDisjointSet::getIndividualEnv(const unsigned int m, vec3<float>* env) const
 {
     if (m >= s.size())
     {
@@ -246,41 +277,53 @@ std::vector<vec3<float>> EnvDisjointSet::getIndividualEnv(const unsigned int m)
         throw std::invalid_argument(msg.str());
     }
 
-    std::vector<vec3<float>> env;
-    for (unsigned int n = 0; n < m_max_num_neigh; n++)
-    {
-        env.emplace_back(0.0, 0.0, 0.0);
-    }
+    std::fill(env, env + m_max_num_neigh, vec3<float>(0.0, 0.0, 0.0));
 
     // loop through the vectors, getting them properly indexed
     // add them to env
-    for (unsigned int proper_ind = 0; proper_ind < s[m].vecs.size(); proper_ind++)
+    const size_t num_vecs = std::min(s[m].vecs.size(), size_t(m_max_num_neigh));
+    for (unsigned int proper_ind = 0; proper_ind < num_vecs; proper_ind++)
     {
         unsigned int relative_ind = s[m].vec_ind[proper_ind];
         env[proper_ind] += s[m].proper_rot * s[m].vecs[relative_ind];
     }
-
-    return env;
 }
 
 /*************************
  * Convenience functions *
  *************************/
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environment& e1, Environment& e2,
-                                                                       float threshold_sq, bool registration)
+RegisterBruteForce makeRegistration(const Environment& e)
+{
+    util::SmallVector<vec3<float>, Environment::INLINE_SIZE> vecs(e.vecs.size(), vec3<float>());
+    for (unsigned int m = 0; m < e.vecs.size(); m++)
+    {
+        vecs[m] = e.proper_rot * e.vecs[e.vec_ind[m]];
+    }
+    return RegisterBruteForce(vecs.data(), vecs.size());
+}
+
+std::pair<rotmat3<float>, util::IndexBiMap> isSimilar(Environment& e1, Environment& e2, float threshold_sq,
+                                                      bool registration)
 {
-    BiMap<unsigned int, unsigned int> vec_map;
+    RegisterBruteForce reference = makeRegistration(e1);
+    return isSimilar(reference, e1, e2, threshold_sq, registration);
+}
+
+std::pair<rotmat3<float>, util::IndexBiMap> isSimilar(RegisterBruteForce& reference, Environment& e1,
+                                                      Environment& e2, float threshold_sq, bool registration)
+{
+    util::IndexBiMap vec_map;
     rotmat3<float> rotation = rotmat3<float>(); // this initializes to the identity matrix
 
     // If the vector sets do not have equal numbers of vectors, just return
     // an empty map since the 1-1 bimapping will be too weird in this case.
     if (e1.vecs.size() != e2.vecs.size())
     {
-        return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
+        return std::pair<rotmat3<float>, util::IndexBiMap>(rotation, vec_map);
     }
 
-    std::vector<vec3<float>> v1(e1.vecs.size());
-    std::vector<vec3<float>> v2(e2.vecs.size());
+    util::SmallVector<vec3<float>, Environment::INLINE_SIZE> v1(e1.vecs.size(), vec3<float>());
+    util::SmallVector<vec3<float>, Environment::INLINE_SIZE> v2(e2.vecs.size(), vec3<float>());
 
     // get the vectors into the proper orientation and order with respect to
     // their parent environment
@@ -294,25 +337,27 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environme
     // to v1. The Fit operation CHANGES v2.
     if (registration)
     {
-        RegisterBruteForce r = RegisterBruteForce(v1);
-        r.Fit(v2);
+        reference.Fit(v2.data(), v2.size());
         // get the optimal rotation to take v2 to v1
-        std::vector<vec3<float>> rot = r.getRotation();
-        // rot must be a 3x3 matrix. if it isn't, something has gone wrong.
-        rotation = rotmat3<float>(rot[0], rot[1], rot[2]);
-        BiMap<unsigned int, unsigned int> tmp_vec_map = r.getVecMap();
+        rotation = reference.getRotationMatrix();
+        const util::IndexBiMap& tmp_vec_map = reference.getVecMap();
 
-        for (const auto* registered_pair : tmp_vec_map)
+        for (unsigned int i = 0; i < tmp_vec_map.getLeftExtent(); i++)
         {
+            const unsigned int j = tmp_vec_map.getRight(i);
+            if (j == util::IndexBiMap::INVALID_INDEX)
+            {
+                continue;
+            }
             // RegisterBruteForce has found the vector mapping that results in
             // minimal RMSD, as best as it can figure out.
             // Does this vector mapping pass the more stringent criterion
             // imposed by the threshold?
-            vec3<float> delta = v1[registered_pair->first] - v2[registered_pair->second];
+            vec3<float> delta = v1[i] - v2[j];
             float r_sq = dot(delta, delta);
             if (r_sq < threshold_sq)
             {
-                vec_map.emplace(registered_pair->first, registered_pair->second);
+                vec_map.emplace(i, j);
             }
         }
     }
@@ -338,14 +383,13 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environme
         }
     }
 
-    // if every vector has been paired with every other vector, return this bimap
-    if (vec_map.size() == e1.vecs.size())
+    // if every vector has been paired with every other vector, return this
+    // bimap, otherwise return an empty bimap
+    if (vec_map.size() != e1.vecs.size())
     {
-        return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
+        vec_map.clear();
     }
-    // otherwise, return an empty bimap
-    BiMap<unsigned int, unsigned int> empty_map;
-    return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, empty_map);
+    return std::pair<rotmat3<float>, util::IndexBiMap>(rotation, vec_map);
 }
 
 std::map<unsigned int, unsigned int> isSimilar(const box::Box& box, const vec3<float>* refPoints1,
@@ -357,10 +401,10 @@ std::map<unsigned int, unsigned int> isSimilar(const box::Box& box, const vec3<f
     std::tie(e0, e1) = makeEnvironments(box, refPoints1, refPoints2, numRef);
 
     // call isSimilar for e0 and e1
-    std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
+    std::pair<rotmat3<float>, util::IndexBiMap> mapping
         = isSimilar(e0, e1, threshold_sq, registration);
     rotmat3<float> rotation = mapping.first;
-    BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+    util::IndexBiMap vec_map = mapping.second;
 
     // update refPoints2 in case registration has taken place
     for (unsigned int i = 0; i < numRef; i++)
@@ -400,10 +444,17 @@ std::pair<Environment, Environment> makeEnvironments(const box::Box& box, const
     return std::pair<Environment, Environment>(e0, e1);
 }
 
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Environment& e1, Environment& e2,
-                                                                          float& min_rmsd, bool registration)
+std::pair<rotmat3<float>, util::IndexBiMap> minimizeRMSD(Environment& e1, Environment& e2, float& min_rmsd,
+                                                         bool registration)
+{
+    RegisterBruteForce reference = makeRegistration(e1);
+    return minimizeRMSD(reference, e1, e2, min_rmsd, registration);
+}
+
+std::pair<rotmat3<float>, util::IndexBiMap> minimizeRMSD(RegisterBruteForce& reference, Environment& e1,
+                                                         Environment& e2, float& min_rmsd, bool registration)
 {
-    BiMap<unsigned int, unsigned int> vec_map;
+    util::IndexBiMap vec_map;
     rotmat3<float> rotation = rotmat3<float>(); // this initializes to the identity matrix
 
     // If the vector sets do not have equal numbers of vectors, force the map
@@ -412,42 +463,37 @@ std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Enviro
     if (e1.vecs.size() != e2.vecs.size())
     {
         min_rmsd = -1.0;
-        return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
+        return std::pair<rotmat3<float>, util::IndexBiMap>(rotation, vec_map);
     }
 
-    std::vector<vec3<float>> v1(e1.vecs.size());
-    std::vector<vec3<float>> v2(e2.vecs.size());
+    util::SmallVector<vec3<float>, Environment::INLINE_SIZE> v2(e2.vecs.size(), vec3<float>());
 
     // Get the vectors into the proper orientation and order with respect
-    // to their parent environment
-    for (unsigned int m = 0; m < e1.vecs.size(); m++)
+    // to their parent environment. The reference holds those of e1.
+    for (unsigned int m = 0; m < e2.vecs.size(); m++)
     {
-        v1[m] = e1.proper_rot * e1.vecs[e1.vec_ind[m]];
         v2[m] = e2.proper_rot * e2.vecs[e2.vec_ind[m]];
     }
 
     // call RegisterBruteForce::Fit and update min_rmsd accordingly
-    RegisterBruteForce r = RegisterBruteForce(v1);
     // If we have to register, first find the rotated set of v2 that best
     // maps to v1. The Fit operation CHANGES v2.
     if (registration)
     {
-        r.Fit(v2);
+        reference.Fit(v2.data(), v2.size());
         // get the optimal rotation to take v2 to v1
-        std::vector<vec3<float>> rot = r.getRotation();
-        // rot must be a 3x3 matrix. if it isn't, something has gone wrong.
-        rotation = rotmat3<float>(rot[0], rot[1], rot[2]);
-        min_rmsd = r.getRMSD();
-        vec_map = r.getVecMap();
+        rotation = reference.getRotationMatrix();
+        min_rmsd = reference.getRMSD();
+        vec_map = reference.getVecMap();
     }
     else
     {
         // this will populate vec_map with the correct mapping
-        min_rmsd = r.AlignedRMSDTree(makeEigenMatrix(v2), vec_map);
+        min_rmsd = reference.AlignedRMSDTree(v2.data(), v2.size(), vec_map);
     }
 
     // return the rotation matrix and bimap
-    return std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>>(rotation, vec_map);
+    return std::pair<rotmat3<float>, util::IndexBiMap>(rotation, vec_map);
 }
 
 std::map<unsigned int, unsigned int> minimizeRMSD(const box::Box& box, const vec3<float>* refPoints1,
@@ -459,10 +505,10 @@ std::map<unsigned int, unsigned int> minimizeRMSD(const box::Box& box, const vec
     std::tie(e0, e1) = makeEnvironments(box, refPoints1, refPoints2, numRef);
 
     float tmp_min_rmsd = -1.0;
-    std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
+    std::pair<rotmat3<float>, util::IndexBiMap> mapping
         = minimizeRMSD(e0, e1, tmp_min_rmsd, registration);
     rotmat3<float> rotation = mapping.first;
-    BiMap<unsigned int, unsigned int> vec_map = mapping.second;
+    util::IndexBiMap vec_map = mapping.second;
     min_rmsd = tmp_min_rmsd;
 
     // update refPoints2 in case registration has taken place
@@ -533,6 +579,7 @@ void EnvironmentCluster::compute(const freud::locality::NeighborQuery* nq,
 
     // create a disjoint set where all particles belong in their own cluster
     EnvDisjointSet dj(Np);
+    dj.s.reserve(Np);
 
     // add all the environments to the set
     // take care, here: set things up s.t. the env_ind of every environment
@@ -549,58 +596,91 @@ void EnvironmentCluster::compute(const freud::locality::NeighborQuery* nq,
     // reallocate the m_point_environments array
     m_point_environments.prepare({Np, dj.m_max_num_neigh});
 
+    // Generate the pairs of points whose environments are compared, in the
+    // order in which they are merged: the bonds of nlist, or all pairs of
+    // points if global is true.
+    const size_t num_bonds(nlist.getNumBonds());
     size_t bond(0);
-    // loop through points
-    for (unsigned int i = 0; i < Np; i++)
-    {
-        if (!global)
+    unsigned int pair_i(0);
+    unsigned int pair_j(1);
+    auto next_pair = [&](std::pair<unsigned int, unsigned int>& pair) {
+        for (; pair_i < Np; ++pair_i, pair_j = pair_i + 1)
         {
-            // loop over the neighbors
-            for (; bond < nlist.getNumBonds() && nlist.getNeighbors()(bond, 0) == i; ++bond)
+            if (!global && bond < num_bonds && nlist.getNeighbors()(bond, 0) == pair_i)
             {
-                const size_t j(nlist.getNeighbors()(bond, 1));
-                std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-                    = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
-                rotmat3<float> rotation = mapping.first;
-                BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-                // if the mapping between the vectors of the environments
-                // is NOT empty, then the environments are similar, so
-                // merge them.
-                if (!vec_map.empty())
-                {
-                    // merge the two sets using the disjoint set
-                    unsigned int a = dj.find(i);
-                    unsigned int b = dj.find(j);
-                    if (a != b)
-                    {
-                        dj.merge(i, j, vec_map, rotation);
-                    }
-                }
+                pair = {pair_i, nlist.getNeighbors()(bond, 1)};
+                ++bond;
+                return true;
+            }
+            if (global && pair_j < Np)
+            {
+                pair = {pair_i, pair_j++};
+                return true;
             }
         }
-        else
+        return false;
+    };
+
+    // The similarity of the environments of the pairs in a block is
+    // evaluated in parallel, after which the pairs are merged in order.
+    // Merging rotates and reorders the environments of a whole cluster,
+    // which changes their similarity to other environments, so pairs with a
+    // point in a cluster that was merged earlier in the same block are
+    // evaluated again. This finds the same clusters as evaluating and merging
+    // every pair in sequence.
+    constexpr size_t block_size = 1024;
+    std::vector<std::pair<unsigned int, unsigned int>> pairs;
+    pairs.reserve(block_size);
+    std::vector<std::pair<rotmat3<float>, util::IndexBiMap>> mappings(block_size);
+    std::vector<char> evaluated(block_size);
+    std::vector<size_t> merged_in_block(Np, 0);
+    std::pair<unsigned int, unsigned int> pair;
+    for (size_t block = 1; next_pair(pair); ++block)
+    {
+        pairs.clear();
+        pairs.push_back(pair);
+        while (pairs.size() < block_size && next_pair(pair))
         {
-            // loop over all other particles
-            for (unsigned int j = i + 1; j < Np; j++)
+            pairs.push_back(pair);
+        }
+
+        // Every environment points directly to the head of its set between
+        // merges, so pairs in the same set can be skipped without find.
+        const auto compare_pairs = [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k)
             {
-                std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-                    = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
-                rotmat3<float> rotation = mapping.first;
-                BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-                // if the mapping between the vectors of the environments
-                // is NOT empty, then the environments are similar, so
-                // merge them.
-                if (!vec_map.empty())
+                Environment& ei = dj.s[pairs[k].first];
+                Environment& ej = dj.s[pairs[k].second];
+                evaluated[k] = static_cast<char>(ei.env_ind != ej.env_ind);
+                if (evaluated[k] != 0)
                 {
-                    // merge the two sets using the disjoint set
-                    unsigned int a = dj.find(i);
-                    unsigned int b = dj.find(j);
-                    if (a != b)
-                    {
-                        dj.merge(i, j, vec_map, rotation);
-                    }
+                    mappings[k] = isSimilar(ei, ej, m_threshold_sq, registration);
                 }
             }
+        };
+        util::forLoopWrapper(0, pairs.size(), compare_pairs, environment_schedule);
+
+        for (size_t k = 0; k < pairs.size(); ++k)
+        {
+            const unsigned int i = pairs[k].first;
+            const unsigned int j = pairs[k].second;
+            unsigned int a = dj.find(i);
+            unsigned int b = dj.find(j);
+            if (a == b)
+            {
+                continue;
+            }
+            if (evaluated[k] == 0 || merged_in_block[a] == block || merged_in_block[b] == block)
+            {
+                mappings[k] = isSimilar(dj.s[i], dj.s[j], m_threshold_sq, registration);
+            }
+            // if the mapping between the vectors of the environments is NOT
+            // empty, then the environments are similar, so merge them.
+            if (!mappings[k].second.empty())
+            {
+                dj.merge(i, j, mappings[k].second, mappings[k].first);
+                merged_in_block[dj.find(i)] = block;
+            }
         }
     }
 
@@ -712,6 +792,7 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
     }
 
     // add this environment to the set
+    dj.s.reserve(Np + 1);
     dj.s.push_back(e0);
 
     size_t bond(0);
@@ -723,30 +804,43 @@ void EnvironmentMotifMatch::compute(const freud::locality::NeighborQuery* nq,
     // take care, here: set things up s.t. the env_ind of every environment
     // matches its location in the disjoint set.
     // if you don't do this, things will get screwy.
-    for (unsigned int i = 0; i < Np; i++)
-    {
-        unsigned int dummy = i + 1;
-        Environment ei = buildEnv(nq, &nlist, num_bonds, bond, i, dummy);
-        dj.s.push_back(ei);
-
-        // if the environment matches e0, merge it into the e0 environment set
-        std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-            = isSimilar(dj.s[0], dj.s[dummy], m_threshold_sq, registration);
-        rotmat3<float> rotation = mapping.first;
-        BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-        // if the mapping between the vectors of the environments is NOT empty,
-        // then the environments are similar.
-        if (!vec_map.empty())
+    // Every environment is merged into the set of the motif, which is never
+    // modified by these merges, so the environments of a block of particles
+    // are compared to the motif in parallel and then merged in order. Each
+    // thread registers all of its environments to the same motif.
+    tbb::enumerable_thread_specific<RegisterBruteForce> references(
+        [&]() { return makeRegistration(dj.s[0]); });
+    std::vector<std::pair<rotmat3<float>, util::IndexBiMap>> mappings(std::min(Np, motif_block_size));
+    for (unsigned int block_start = 0; block_start < Np; block_start += motif_block_size)
+    {
+        const unsigned int block_end = std::min(Np, block_start + motif_block_size);
+        for (unsigned int i = block_start; i < block_end; i++)
         {
-            dj.merge(0, dummy, vec_map, rotation);
-            m_matches[i] = true;
+            dj.s.push_back(buildEnv(nq, &nlist, num_bonds, bond, i, i + 1));
         }
-        // grab the set of vectors that define this individual environment
-        std::vector<vec3<float>> part_vecs = dj.getIndividualEnv(dummy);
 
-        for (unsigned int m = 0; m < part_vecs.size(); m++)
+        const auto compare_to_motif = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                mappings[i - block_start]
+                    = isSimilar(references.local(), dj.s[0], dj.s[i + 1], m_threshold_sq, registration);
+            }
+        };
+        util::forLoopWrapper(block_start, block_end, compare_to_motif, environment_schedule);
+
+        for (unsigned int i = block_start; i < block_end; i++)
         {
-            m_point_environments(i, m) = part_vecs[m];
+            unsigned int dummy = i + 1;
+            const std::pair<rotmat3<float>, util::IndexBiMap>& mapping = mappings[i - block_start];
+            // if the mapping between the vectors of the environments is NOT empty,
+            // then the environments are similar.
+            if (!mapping.second.empty())
+            {
+                dj.merge(0, dummy, mapping.second, mapping.first);
+                m_matches[i] = true;
+            }
+            // grab the set of vectors that define this individual environment
+            dj.getIndividualEnv(dummy, &m_point_environments(i, 0));
         }
     }
 }
@@ -789,6 +883,7 @@ void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
     }
 
     // add this environment to the set
+    dj.s.reserve(Np + 1);
     dj.s.push_back(e0);
 
     size_t bond(0);
@@ -800,36 +895,46 @@ void EnvironmentRMSDMinimizer::compute(const freud::locality::NeighborQuery* nq,
     // take care, here: set things up s.t. the env_ind of every environment
     // matches its location in the disjoint set.
     // if you don't do this, things will get screwy.
-    for (unsigned int i = 0; i < Np; i++)
-    {
-        unsigned int dummy = i + 1;
-        Environment ei = buildEnv(nq, &nlist, num_bonds, bond, i, dummy);
-        dj.s.push_back(ei);
-
-        // if the environment matches e0, merge it into the e0 environment set
-        float min_rmsd = -1.0;
-        std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> mapping
-            = minimizeRMSD(dj.s[0], dj.s[dummy], min_rmsd, registration);
-        rotmat3<float> rotation = mapping.first;
-        BiMap<unsigned int, unsigned int> vec_map = mapping.second;
-        // populate the min_rmsd vector
-        m_rmsds[i] = min_rmsd;
-
-        // if the mapping between the vectors of the environments is NOT
-        // empty, then the environments are similar.
-        // minimizeRMSD should always return a non-empty vec_map, except if
-        // e0 and e1 have different numbers of vectors.
-        if (!vec_map.empty())
+    // As in EnvironmentMotifMatch, the environments of a block of particles
+    // are compared to the motif in parallel and then merged in order.
+    tbb::enumerable_thread_specific<RegisterBruteForce> references(
+        [&]() { return makeRegistration(dj.s[0]); });
+    std::vector<std::pair<rotmat3<float>, util::IndexBiMap>> mappings(std::min(Np, motif_block_size));
+    for (unsigned int block_start = 0; block_start < Np; block_start += motif_block_size)
+    {
+        const unsigned int block_end = std::min(Np, block_start + motif_block_size);
+        for (unsigned int i = block_start; i < block_end; i++)
         {
-            dj.merge(0, dummy, vec_map, rotation);
+            dj.s.push_back(buildEnv(nq, &nlist, num_bonds, bond, i, i + 1));
         }
 
-        // grab the set of vectors that define this individual environment
-        std::vector<vec3<float>> part_vecs = dj.getIndividualEnv(dummy);
+        // populate the min_rmsd vector
+        const auto minimize_rmsds = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                float min_rmsd = -1.0;
+                mappings[i - block_start]
+                    = minimizeRMSD(references.local(), dj.s[0], dj.s[i + 1], min_rmsd, registration);
+                m_rmsds[i] = min_rmsd;
+            }
+        };
+        util::forLoopWrapper(block_start, block_end, minimize_rmsds, environment_schedule);
 
-        for (unsigned int m = 0; m < part_vecs.size(); m++)
+        for (unsigned int i = block_start; i < block_end; i++)
         {
-            m_point_environments(i, m) = part_vecs[m];
+            unsigned int dummy = i + 1;
+            const std::pair<rotmat3<float>, util::IndexBiMap>& mapping = mappings[i - block_start];
+            // if the mapping between the vectors of the environments is NOT
+            // empty, then the environments are similar.
+            // minimizeRMSD should always return a non-empty vec_map, except if
+            // e0 and e1 have different numbers of vectors.
+            if (!mapping.second.empty())
+            {
+                dj.merge(0, dummy, mapping.second, mapping.first);
+            }
+
+            // grab the set of vectors that define this individual environment
+            dj.getIndividualEnv(dummy, &m_point_environments(i, 0));
         }
     }
 }
@@ -7,12 +7,13 @@
 #include <map>
 #include <vector>
 
-#include "BiMap.h"
 #include "Box.h"
+#include "IndexBiMap.h"
 #include "ManagedArray.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
 #include "Registration.h"
+#include "SmallVector.h"
 #include "VectorMath.h"
 
 /*! \file MatchEnv.h
@@ -24,8 +25,14 @@ namespace freud { namespace environment {
 //! matching metrics
 
 //! My environment data structure
+/*! Environments with up to INLINE_SIZE vectors are stored without heap
+ *  allocations, so they can be built and copied cheaply.
+ */
 struct Environment
 {
+    //! Number of vectors stored without heap allocations.
+    static constexpr size_t INLINE_SIZE = util::IndexBiMap::INLINE_SIZE;
+
     //! Constructor.
     Environment(bool ghost = false) : ghost(ghost) {}
 
@@ -37,14 +44,14 @@ struct Environment
         num_vecs++;
     }
 
-    unsigned int env_ind {0};      //!< The index of the environment
-    std::vector<vec3<float>> vecs; //!< The vectors that define the environment
+    unsigned int env_ind {0};                         //!< The index of the environment
+    util::SmallVector<vec3<float>, INLINE_SIZE> vecs; //!< The vectors that define the environment
     //! Is this environment a ghost? Do we ignore it when we compute actual
     //  physical quantities associated with all environments?
     bool ghost;
     unsigned int num_vecs {0}; //!< The number of vectors currently defining the environment
     //! The order that the vectors must be in to define the environment
-    std::vector<unsigned int> vec_ind;
+    util::SmallVector<unsigned int, INLINE_SIZE> vec_ind;
     //! The rotation that defines the proper orientation of the environment
     rotmat3<float> proper_rot {};
 };
@@ -61,8 +68,8 @@ struct EnvDisjointSet
      * the right. The rotation must take the set of PROPERLY ROTATED vectors b
      * and rotate them to match the set of PROPERLY ROTATED vectors a
      */
-    void merge(const unsigned int a, const unsigned int b, BiMap<unsigned int, unsigned int> vec_map,
-               rotmat3<float>& rotation);
+    void merge(const unsigned int a, const unsigned int b, const util::IndexBiMap& vec_map,
+               const rotmat3<float>& rotation);
 
     //! Find the set with a given element (taken mostly from Cluster.cc).
     unsigned int find(const unsigned int c);
@@ -86,9 +93,13 @@ struct EnvDisjointSet
     //! Get the vectors corresponding to index m in the dj set (throw an error if it doesn't exist).
     std::vector<vec3<float>> getIndividualEnv(const unsigned int m);
 
-    std::vector<Environment> s;     //!< The disjoint set data
-    std::vector<unsigned int> rank; //!< The rank of each tree in the set
-    unsigned int m_max_num_neigh;   //!< The maximum number of neighbors in any environment in the set
+    //! Write the vectors corresponding to index m in the dj set to an array of m_max_num_neigh vectors.
+    void getIndividualEnv(const unsigned int m, vec3<float>* env) const;
+
+    std::vector<Environment> s;                     //!< The disjoint set data
+    std::vector<unsigned int> rank;                 //!< The rank of each tree in the set
+    std::vector<std::vector<unsigned int>> members; //!< The elements of the set of each head index
+    unsigned int m_max_num_neigh; //!< The maximum number of neighbors in any environment in the set
 };
 
 /*****************************************************************************
@@ -102,6 +113,9 @@ struct EnvDisjointSet
 std::pair<Environment, Environment> makeEnvironments(const box::Box& box, const vec3<float>* refPoints1,
                                                      vec3<float>* refPoints2, unsigned int numRef);
 
+//! Make the RegisterBruteForce that registers other environments to the properly oriented environment e.
+RegisterBruteForce makeRegistration(const Environment& e);
+
 // Get the somewhat-optimal RMSD between the (PROPERLY REGISTERED) environment e1 and the (PROPERLY
 // REGISTERED) environment e2.
 /*! This function returns an std::pair of the rotation matrix that takes
@@ -121,8 +135,15 @@ std::pair<Environment, Environment> makeEnvironments(const box::Box& box, const
  *                     orient the second set of vectors such that it
  *                     minimizes the RMSD between the two sets
  */
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> minimizeRMSD(Environment& e1, Environment& e2,
-                                                                          float& min_rmsd, bool registration);
+std::pair<rotmat3<float>, util::IndexBiMap> minimizeRMSD(Environment& e1, Environment& e2, float& min_rmsd,
+                                                         bool registration);
+
+//! Overload of the above minimizeRMSD function that reuses the registration of e1.
+/*! \param reference The RegisterBruteForce made for e1 by makeRegistration,
+ *                   which may be reused for many environments e2.
+ */
+std::pair<rotmat3<float>, util::IndexBiMap> minimizeRMSD(RegisterBruteForce& reference, Environment& e1,
+                                                         Environment& e2, float& min_rmsd, bool registration);
 
 //! Overload of the above minimizeRMSD function that provides an easier interface to Python.
 /*! Construct the environments accordingly, and utilize minimizeRMSD() as
@@ -163,8 +184,15 @@ std::map<unsigned int, unsigned int> minimizeRMSD(const box::Box& box, const vec
  *                     orient the second set of vectors such that it
  *                     minimizes the RMSD between the two sets
  */
-std::pair<rotmat3<float>, BiMap<unsigned int, unsigned int>> isSimilar(Environment& e1, Environment& e2,
-                                                                       float threshold_sq, bool registration);
+std::pair<rotmat3<float>, util::IndexBiMap> isSimilar(Environment& e1, Environment& e2, float threshold_sq,
+                                                      bool registration);
+
+//! Overload of the above isSimilar function that reuses the registration of e1.
+/*! \param reference The RegisterBruteForce made for e1 by makeRegistration,
+ *                   which may be reused for many environments e2.
+ */
+std::pair<rotmat3<float>, util::IndexBiMap> isSimilar(RegisterBruteForce& reference, Environment& e1,
+                                                      Environment& e2, float threshold_sq, bool registration);
 
 //! Overload of the above isSimilar function that provides an easier interface to Python.
 /*! If the two environments correspond, returns a std::pair of the rotation matrix that takes the
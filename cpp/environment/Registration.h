@@ -4,8 +4,11 @@
 #ifndef REGISTRATION_H
 #define REGISTRATION_H
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <iostream>
+#include <limits>
 #include <random>
 #include <sstream>
 #include <vector>
@@ -21,7 +24,8 @@
 #include "Eigen/Eigen/Dense"
 #include "Eigen/Eigen/Sparse"
 
-#include "BiMap.h"
+#include "IndexBiMap.h"
+#include "SmallVector.h"
 #include "VectorMath.h"
 
 namespace freud { namespace environment {
@@ -152,35 +156,83 @@ inline void AlignVectorSets(matrix& P, matrix& Q, matrix* pRotation = nullptr)
     }
 }
 
+//! Find the proper rotation that minimizes the MSD between two sets of at most 3 points.
+/*! This is the fixed-size counterpart of KabschAlgorithm used by
+ *  RegisterBruteForce. The rotation is computed from the 3x3 matrix A =
+ *  P^T Q of the points P and Q without any heap allocations.
+ *
+ *  \param A The 3x3 matrix P^T Q.
+ *  \return The rotation that takes the points of P to the points of Q.
+ */
+inline Eigen::Matrix3d KabschRotation(const Eigen::Matrix3d& A)
+{
+    // singular value decomposition (~ eigen decomposition), A = USV^T
+    Eigen::JacobiSVD<Eigen::Matrix3d> svd(A, Eigen::ComputeFullU | Eigen::ComputeFullV);
+    const Eigen::Matrix3d& U = svd.matrixU();
+    Eigen::Matrix3d V = svd.matrixV();
+
+    // if the rotation as we've found it, rot=VU^T, is IMPROPER, find the next best
+    // (proper) rotation by reflecting the smallest principal axis in rot:
+    if ((V * U.transpose()).determinant() < 0)
+    {
+        V.col(2) *= -1.0;
+    }
+    return V * U.transpose();
+}
+
 class RegisterBruteForce
 {
 public:
-    explicit RegisterBruteForce(std::vector<vec3<float>>& vecs) : m_ref_points(makeEigenMatrix(vecs)) {};
+    //! Number of points handled without heap allocations.
+    static constexpr size_t INLINE_SIZE = util::IndexBiMap::INLINE_SIZE;
+
+    explicit RegisterBruteForce(std::vector<vec3<float>>& vecs)
+        : RegisterBruteForce(vecs.data(), static_cast<unsigned int>(vecs.size()))
+    {}
+
+    //! Constructor
+    /*! The reference points are stored along with the quantities used to
+     *  register every set of points against them, so one RegisterBruteForce
+     *  may be reused to Fit many sets of points to the same reference, e.g.
+     *  the environments of all particles to a motif.
+     */
+    RegisterBruteForce(const vec3<float>* vecs, unsigned int num_vecs)
+    {
+        for (unsigned int i = 0; i < num_vecs; i++)
+        {
+            m_ref_points.push_back(vecs[i]);
+            m_ref_points_eigen.push_back(toEigen(vecs[i]));
+        }
+    }
 
     ~RegisterBruteForce() = default;
 
     void Fit(std::vector<vec3<float>>& pts)
     {
-        matrix points;
-        matrix p;
-        matrix q;
-        matrix r;
-        // make the Eigen matrix from pts
-        points = makeEigenMatrix(pts);
-        int num_pts;
-
-        int N = points.rows();
-        if (N != m_ref_points.rows())
+        Fit(pts.data(), static_cast<unsigned int>(pts.size()));
+    }
+
+    //! Rotate the points pts to best match the reference points.
+    /*! The candidate rotations are found by the Kabsch algorithm on sets of
+     *  at most 3 points, using fixed-size 3x3 matrices, so that the search
+     *  does not allocate for environments of up to INLINE_SIZE points.
+     */
+    void Fit(vec3<float>* pts, unsigned int num_points)
+    {
+        const int N = static_cast<int>(num_points);
+        if (N != static_cast<int>(m_ref_points.size()))
         {
             std::ostringstream msg;
-            msg << "There are " << m_ref_points.rows() << " reference points and " << N << " points. ";
+            msg << "There are " << m_ref_points.size() << " reference points and " << N << " points. ";
             msg << "Brute force matching requires the same number of reference points and points!"
                 << std::endl;
             throw std::invalid_argument(msg.str());
         }
 
-        RandomNumber<std::mt19937_64> rng;
         double rmsd_min = -1.0;
+        float r_sq_sum_min = std::numeric_limits<float>::infinity();
+        util::SmallVector<vec3<float>, INLINE_SIZE> rot_points(num_points, vec3<float>());
+        util::IndexBiMap vec_map;
         for (size_t shuffles = 0; shuffles < m_shuffles; shuffles++)
         {
             int p0 = 0;
@@ -188,14 +240,14 @@ public:
             int p2 = 0;
             while (p0 == p1 || p0 == p2 || p1 == p2)
             {
-                p0 = rng.random_int(0, N - 1);
+                p0 = m_rng.random_int(0, N - 1);
                 if (N == 1)
                 {
                     p1 = -2;
                 }
                 else
                 {
-                    p1 = rng.random_int(0, N - 1);
+                    p1 = m_rng.random_int(0, N - 1);
                 }
 
                 if (N == 2 || N == 1)
@@ -204,97 +256,57 @@ public:
                 }
                 else
                 {
-                    p2 = rng.random_int(0, N - 1);
+                    p2 = m_rng.random_int(0, N - 1);
                 }
             }
 
             // We should switch this to using something other than C-style
             // arrays, but we need to be careful to preserve the right behavior
             // (particularly wrt NextCombination).
+            const int num_pts = std::min(N, 3);
+            const std::array<int, 3> ref_inds = {p0, p1, p2};
             size_t comb[3] = {0, 1, 2}; // NOLINT(modernize-avoid-c-arrays)
-            if (N == 2)
-            {
-                num_pts = 2;
-                p.resize(num_pts, m_ref_points.cols());
-                p.row(0) = m_ref_points.row(p0);
-                p.row(1) = m_ref_points.row(p1);
-                q.resize(num_pts, m_ref_points.cols());
-            }
-            else if (N == int(1))
-            {
-                num_pts = 1;
-                p.resize(num_pts, m_ref_points.cols());
-                p.row(0) = m_ref_points.row(p0);
-                q.resize(num_pts, m_ref_points.cols());
-            }
-            else
-            {
-                num_pts = 3;
-                p.resize(num_pts, m_ref_points.cols());
-                p.row(0) = m_ref_points.row(p0);
-                p.row(1) = m_ref_points.row(p1);
-                p.row(2) = m_ref_points.row(p2);
-                q.resize(num_pts, m_ref_points.cols());
-            }
             do
             {
                 do
                 {
-                    if (N == int(2))
+                    // finds the optimal rotation of the selected points
+                    // such that they match the selected reference points
+                    Eigen::Matrix3d A = Eigen::Matrix3d::Zero();
+                    for (int k = 0; k < num_pts; k++)
                     {
-                        q.row(0) = points.row(comb[0]);
-                        q.row(1) = points.row(comb[1]);
+                        A += toEigen(pts[comb[k]]) * m_ref_points_eigen[ref_inds[k]].transpose();
                     }
-                    else if (N == int(1))
+                    const Eigen::Matrix3d r = KabschRotation(A);
+
+                    rotatePoints(r, pts, num_points, rot_points.data());
+                    // Candidates whose squared distances already add up to
+                    // those of the best candidate cannot improve on it, so
+                    // their matching is stopped early.
+                    const float r_sq_sum
+                        = alignedSquaredDistances(rot_points.data(), num_points, vec_map, r_sq_sum_min);
+                    if (r_sq_sum >= r_sq_sum_min)
                     {
-                        q.row(0) = points.row(comb[0]);
+                        continue;
                     }
-                    else
-                    {
-                        q.row(0) = points.row(comb[0]);
-                        q.row(1) = points.row(comb[1]);
-                        q.row(2) = points.row(comb[2]);
-                    }
-
-                    // finds the optimal rotation of the FIRST input set
-                    // of points such that they match the SECOND input
-                    // set of points
-                    KabschAlgorithm(q, p, r);
-
-                    // The rotation that we've found from the
-                    // KabschAlgorithm actually acts on P^T.
-                    matrix rot_points = Rotate(r, points.transpose());
-
-                    // feed back in the TRANSPOSE of rot_points such that
-                    // the input matrix is (Nx3).
-                    BiMap<unsigned int, unsigned int> vec_map;
-                    float rmsd = AlignedRMSDTree(rot_points.transpose(), vec_map);
+                    float rmsd = std::sqrt(r_sq_sum / static_cast<float>(num_points));
                     if (rmsd < rmsd_min || rmsd_min < 0.0)
                     {
+                        r_sq_sum_min = r_sq_sum;
                         m_rmsd = rmsd;
                         m_rotation = r;
                         m_vec_map = vec_map;
                         rmsd_min = m_rmsd;
                         if (rmsd_min < m_tol)
                         {
-                            // The rotation that we've found from the KabschAlgorithm
-                            // actually acts on P^T.
-                            matrix ptsT = Rotate(m_rotation, points.transpose());
-                            // Then we have to take the transpose again to get our matrix
-                            // back to its original dimensionality.
-                            pts = makeVec3Matrix(ptsT.transpose());
+                            rotatePoints(m_rotation, pts, num_points, pts);
                             return;
                         }
                     }
                 } while (std::next_permutation(comb, comb + num_pts));
             } while (NextCombination(comb, N, num_pts));
         } // end for loop over shuffles
-        // The rotation that we've found from the KabschAlgorithm
-        // actually acts on P^T.
-        matrix ptsT = Rotate(m_rotation, points.transpose());
-        // Then we have to take the transpose again to get our matrix
-        // back to its original dimensionality.
-        pts = makeVec3Matrix(ptsT.transpose());
+        rotatePoints(m_rotation, pts, num_points, pts);
     }
 
     std::vector<vec3<float>> getRotation()
@@ -303,6 +315,15 @@ public:
         return makeVec3Matrix(R);
     }
 
+    //! Get the rotation found by Fit as a rotation matrix.
+    rotmat3<float> getRotationMatrix() const
+    {
+        return rotmat3<float>(
+            vec3<float>(m_rotation(0, 0), m_rotation(0, 1), m_rotation(0, 2)),
+            vec3<float>(m_rotation(1, 0), m_rotation(1, 1), m_rotation(1, 2)),
+            vec3<float>(m_rotation(2, 0), m_rotation(2, 1), m_rotation(2, 2)));
+    }
+
     std::vector<vec3<float>> getTranslation()
     {
         matrix T = m_translation;
@@ -314,7 +335,7 @@ public:
         return m_rmsd;
     }
 
-    BiMap<unsigned int, unsigned int> getVecMap()
+    const util::IndexBiMap& getVecMap() const
     {
         return m_vec_map;
     }
@@ -329,6 +350,17 @@ public:
         m_tol = tol;
     }
 
+    //! Compute the RMSD of the rows of an Nx3 matrix of points, see below.
+    float AlignedRMSDTree(const matrix& points, util::IndexBiMap& m)
+    {
+        util::SmallVector<vec3<float>, INLINE_SIZE> vecs;
+        for (int r = 0; r < points.rows(); r++)
+        {
+            vecs.push_back(make_point(points.row(r)));
+        }
+        return AlignedRMSDTree(vecs.data(), static_cast<unsigned int>(vecs.size()), m);
+    }
+
     // This uses an R-tree to efficiently determine pairs of points that
     // are closest, next closest, etc to each other. NOTE that this does
     // not guarantee an absolutely minimal RMSD. It doesn't figure out the
@@ -337,51 +369,81 @@ public:
     // set, the vector set used in the argument below.
     // To fully solve this, we need to use the Hungarian algorithm or some
     // other way of solving the so-called assignment problem.
-    float AlignedRMSDTree(const matrix& points, BiMap<unsigned int, unsigned int>& m)
+    float AlignedRMSDTree(const vec3<float>* points, unsigned int num_points, util::IndexBiMap& m) const
+    {
+        const float r_sq_sum
+            = alignedSquaredDistances(points, num_points, m, std::numeric_limits<float>::infinity());
+        return std::sqrt(r_sq_sum / static_cast<float>(num_points));
+    }
+
+private:
+    //! Greedily match points to the reference points and sum their squared distances.
+    /*! The matching stops as soon as the sum reaches r_sq_sum_max, in which
+     *  case the partial sum is returned and m is incomplete.
+     */
+    float alignedSquaredDistances(const vec3<float>* points, unsigned int num_points, util::IndexBiMap& m,
+                                  float r_sq_sum_max) const
     {
         // Also brute force.
         float rmsd = 0.0;
 
         // a mapping between the vectors of m_ref_points and the vectors of points
-        BiMap<unsigned int, unsigned int> vec_map;
+        m.clear();
 
         // keeps track of whether m_ref_points have been matched to any point in points
         // guarantees 1-1 mapping
-        std::set<unsigned int> unused_indices;
-        for (int i = 0; i < m_ref_points.rows(); i++)
-        {
-            unused_indices.insert(i);
-        }
+        util::SmallVector<char, INLINE_SIZE> used(m_ref_points.size(), 0);
 
         // loop through all the points
-        for (int r = 0; r < points.rows(); r++)
+        for (unsigned int r = 0; r < num_points; r++)
         {
-            // get the rotated point
-            vec3<float> pfit = make_point(points.row(r));
-            // compute squared distances to all unused reference points
-            std::vector<std::pair<unsigned int, float>> ref_distances;
-            for (auto ref_index : unused_indices)
+            // find the nearest unused reference point and mark it as used
+            unsigned int nearest = util::IndexBiMap::INVALID_INDEX;
+            float nearest_r_sq = 0;
+            for (unsigned int ref_index = 0; ref_index < m_ref_points.size(); ref_index++)
             {
-                vec3<float> ref_point = make_point(m_ref_points.row(ref_index));
-                vec3<float> delta = ref_point - pfit;
+                if (used[ref_index] != 0)
+                {
+                    continue;
+                }
+                vec3<float> delta = m_ref_points[ref_index] - points[r];
                 float r_sq = dot(delta, delta);
-                ref_distances.emplace_back(ref_index, r_sq);
+                if (nearest == util::IndexBiMap::INVALID_INDEX || r_sq < nearest_r_sq)
+                {
+                    nearest = ref_index;
+                    nearest_r_sq = r_sq;
+                }
             }
-            // sort the ref_distances from nearest to farthest
-            sort(ref_distances.begin(), ref_distances.end(), compare_ref_distances);
-            // take the first (nearest) ref_point found and mark it as used
-            unused_indices.erase(ref_distances[0].first);
+            used[nearest] = 1;
             // add this pairing to the mapping between vectors
-            vec_map.emplace(ref_distances[0].first, r);
+            m.emplace(nearest, r);
             // add this squared distance to the rmsd
-            rmsd += ref_distances[0].second;
+            rmsd += nearest_r_sq;
+            if (rmsd >= r_sq_sum_max)
+            {
+                break;
+            }
         }
 
-        m = vec_map;
-        return std::sqrt(rmsd / static_cast<float>(points.rows()));
+        return rmsd;
+    }
+
+    static Eigen::Vector3d toEigen(const vec3<float>& v)
+    {
+        return Eigen::Vector3d(v.x, v.y, v.z);
+    }
+
+    //! Rotate num_points points by R into out, which may alias points.
+    static void rotatePoints(const Eigen::Matrix3d& R, const vec3<float>* points, unsigned int num_points,
+                             vec3<float>* out)
+    {
+        for (unsigned int i = 0; i < num_points; i++)
+        {
+            const Eigen::Vector3d rotated = R * toEigen(points[i]);
+            out[i] = vec3<float>(rotated[0], rotated[1], rotated[2]);
+        }
     }
 
-private:
     static vec3<float> make_point(const Eigen::VectorXd& row)
     {
         if (row.rows() == 2)
@@ -395,12 +457,6 @@ private:
         throw(std::runtime_error("points must 2 or 3 dimensions"));
     }
 
-    static bool compare_ref_distances(const std::pair<unsigned int, float>& a,
-                                      const std::pair<unsigned int, float>& b)
-    {
-        return (a.second < b.second);
-    }
-
     static inline bool NextCombination(size_t* comb, int N, int k)
     {
         // returns next combination.
@@ -431,12 +487,16 @@ private:
     template<class RNG> class RandomNumber
     {
     public:
-        RandomNumber() // NOLINT(cert-msc32-c,cert-msc51-cpp)
-        {
-            seed_generator();
-        }
+        // The generator is seeded on first use, so that objects which never
+        // draw random numbers do not query the random device.
+        RandomNumber() = default; // NOLINT(cert-msc32-c,cert-msc51-cpp)
         int random_int(int a, int b)
         {
+            if (!m_seeded)
+            {
+                seed_generator();
+                m_seeded = true;
+            }
             std::uniform_int_distribution<int> distribution(a, b);
             return distribution(m_generator);
         }
@@ -463,18 +523,20 @@ private:
             m_generator.seed(seq);
         }
         RNG m_generator;
+        bool m_seeded {false};
     };
 
-    matrix m_ref_points;
-    matrix m_rotation;
+    util::SmallVector<vec3<float>, INLINE_SIZE> m_ref_points;
+    util::SmallVector<Eigen::Vector3d, INLINE_SIZE> m_ref_points_eigen;
+    RandomNumber<std::mt19937_64> m_rng;
+    Eigen::Matrix3d m_rotation {Eigen::Matrix3d::Identity()};
     matrix m_translation;
     float m_rmsd {0.0};
     double m_tol {1e-6};
     size_t m_shuffles {1};
-    BiMap<unsigned int, unsigned int>
-        m_vec_map; //! The mapping between indices of the two sets of points ref_points->points (where
-                   //! "ref_points" are those that RegisterBruteForce was constructed with and "points" are
-                   //! those passed to Fit).
+    util::IndexBiMap m_vec_map; //! The mapping between indices of the two sets of points ref_points->points
+                                //! (where "ref_points" are those that RegisterBruteForce was constructed
+                                //! with and "points" are those passed to Fit).
 };
 
 }; }; // end namespace freud::environment
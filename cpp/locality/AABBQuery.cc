@@ -2,24 +2,262 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/parallel_sort.h>
 
 #include "AABBQuery.h"
+#include "BoxKernel.h"
+#include "Instrumentation.h"
+#include "utils.h"
 
 namespace freud { namespace locality {
 
-AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points)
-    : NeighborQuery(box, points, n_points)
+AABBQuery::AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+                     bool spatial_sort, bool parallel_build)
+    : NeighborQuery(box, points, n_points), m_parallel_build(parallel_build)
 {
+    if (spatial_sort)
+    {
+        sortPoints();
+    }
+
     // Allocate memory and create image vectors
     setupTree(m_n_points);
 
     // Build the tree
-    buildTree(m_points, m_n_points);
+    buildTree(m_search_points, m_n_points, parallel_build);
 }
 
 AABBQuery::~AABBQuery() = default;
 
+void AABBQuery::update(const vec3<float>* points, unsigned int n_points)
+{
+    if (n_points != m_n_points)
+    {
+        throw std::invalid_argument("AABBQuery can only be updated with the same number of points.");
+    }
+    validatePoints(points, n_points);
+    m_points = points;
+    // Spatially sorted points keep their original ordering, which remains a
+    // good approximation of a spatial sort for small displacements.
+    updateSortedPoints();
+
+    // A point that crosses a periodic boundary would stretch the bounds of its
+    // leaf and all of its ancestors across the box. Since every query searches
+    // all neighboring images, the tree instead follows each point continuously
+    // from its previous position, which is recovered from its AABB.
+    std::vector<vec3<float>> previous_points(m_n_points);
+    util::forLoopWrapper(0, m_n_points, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            previous_points[m_aabbs[i].tag] = m_aabbs[i].getPosition();
+        }
+    });
+    m_tracked_points.resize(m_n_points);
+    const float max_offset = float(0.5) + AABB_QUERY_UPDATE_MAX_DRIFT;
+    const auto track_points = [&](const auto& kernel) {
+        return [&, kernel](const tbb::blocked_range<size_t>& r, bool any_drifted) {
+            for (size_t i = r.begin(); i != r.end(); ++i)
+            {
+                m_tracked_points[i]
+                    = previous_points[i] + kernel.wrap(m_search_points[i] - previous_points[i]);
+                const vec3<float> f = kernel.makeFractional(m_tracked_points[i]);
+                any_drifted = any_drifted || (kernel.isPeriodicX() && std::abs(f.x - float(0.5)) > max_offset)
+                    || (kernel.isPeriodicY() && std::abs(f.y - float(0.5)) > max_offset)
+                    || (kernel.isPeriodicZ() && std::abs(f.z - float(0.5)) > max_offset);
+            }
+            return any_drifted;
+        };
+    };
+    const bool drifted = box::dispatchBoxKernel(m_box, [&](const auto& kernel) {
+        return util::executeInThreadArena([&]() {
+            return tbb::parallel_reduce(tbb::blocked_range<size_t>(0, m_n_points), false,
+                                        track_points(kernel), [](bool a, bool b) { return a || b; });
+        });
+    });
+
+    // Points too far outside of the box may have neighbors beyond the images
+    // searched, and refitting keeps the topology of the tree, which becomes
+    // less efficient to query as points move away from the positions it was
+    // built for. In either case the tree is rebuilt from the wrapped points.
+    if (!drifted)
+    {
+        computeAABBs(m_tracked_points.data(), m_n_points, true);
+        m_aabb_tree.refit(m_aabbs.data());
+        if (m_aabb_tree.getCost() <= AABB_QUERY_UPDATE_REBUILD_RATIO * m_build_cost)
+        {
+            m_search_points = m_tracked_points.data();
+            if (hasRadii())
+            {
+                buildSphereTree();
+            }
+            return;
+        }
+    }
+    buildTree(m_search_points, m_n_points, m_parallel_build);
+    if (hasRadii())
+    {
+        buildSphereTree();
+    }
+}
+
+void AABBQuery::setRadii(const float* radii)
+{
+    m_radii.resize(m_n_points);
+    for (unsigned int j = 0; j < m_n_points; ++j)
+    {
+        const float radius = radii[getPointIndex(j)];
+        if (!(radius >= 0) || std::isinf(radius))
+        {
+            m_radii.clear();
+            throw std::invalid_argument("AABBQuery requires that the radii must be finite and nonnegative.");
+        }
+        m_radii[j] = radius;
+    }
+    m_max_radius = m_radii.empty() ? 0 : *std::max_element(m_radii.begin(), m_radii.end());
+    buildSphereTree();
+}
+
+void AABBQuery::buildSphereTree()
+{
+    std::vector<AABB> sphere_aabbs(m_n_points);
+    util::forLoopWrapper(
+        0, m_n_points,
+        [&](size_t begin, size_t end) {
+            for (size_t j = begin; j < end; ++j)
+            {
+                vec3<float> pos(m_search_points[j]);
+                if (m_box.is2D())
+                {
+                    pos.z = 0;
+                }
+                sphere_aabbs[j] = AABB(pos, m_radii[j]);
+                sphere_aabbs[j].tag = static_cast<unsigned int>(j);
+            }
+        },
+        m_parallel_build);
+    if (m_parallel_build)
+    {
+        m_sphere_tree.buildTreeParallel(sphere_aabbs.data(), m_n_points);
+    }
+    else
+    {
+        m_sphere_tree.buildTree(sphere_aabbs.data(), m_n_points);
+    }
+}
+
+NeighborList* AABBQuery::queryContacts(const vec3<float>* query_points, const float* query_radii,
+                                       unsigned int n_query_points, float delta, bool exclude_ii) const
+{
+    util::ScopedPhase phase("AABBQuery::queryContacts");
+    const util::ScopedMemoryOwner owner("NeighborList");
+    if (!hasRadii() && m_n_points != 0)
+    {
+        throw std::runtime_error("AABBQuery requires radii to be set before querying contacts.");
+    }
+    if (!(delta >= 0) || std::isinf(delta))
+    {
+        throw std::invalid_argument(
+            "AABBQuery requires that the contact delta must be finite and nonnegative.");
+    }
+    validatePoints(query_points, n_query_points);
+    float max_query_radius = 0;
+    for (unsigned int i = 0; i < n_query_points; ++i)
+    {
+        if (!(query_radii[i] >= 0) || std::isinf(query_radii[i]))
+        {
+            throw std::invalid_argument(
+                "AABBQuery requires that the query radii must be finite and nonnegative.");
+        }
+        max_query_radius = std::max(max_query_radius, query_radii[i]);
+    }
+
+    std::vector<vec3<float>> image_list;
+    const unsigned int n_images
+        = computeImageVectors(max_query_radius + m_max_radius + delta, true, false, image_list);
+    const bool is2D = m_box.is2D();
+
+    using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
+    BondVector thread_bonds;
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        BondVector::reference local_bonds(thread_bonds.local());
+        for (size_t i = begin; i < end; ++i)
+        {
+            const auto query_point_idx = static_cast<unsigned int>(i);
+            vec3<float> pos_i(query_points[i]);
+            if (is2D)
+            {
+                pos_i.z = 0;
+            }
+            const float reach = query_radii[i] + delta;
+
+            for (unsigned int image = 0; image < n_images; ++image)
+            {
+                const vec3<float> pos_i_image = pos_i + image_list[image];
+                // Any sphere within reach of the query point overlaps this
+                // ball, so its AABB and those of all its ancestors do too.
+                const AABBSphere asphere(pos_i_image, reach);
+                for (unsigned int node = 0; node < m_sphere_tree.getNumNodes(); ++node)
+                {
+                    if (!overlap(m_sphere_tree.getNodeAABB(node), asphere))
+                    {
+                        node += m_sphere_tree.getNodeSkip(node);
+                        continue;
+                    }
+                    if (!m_sphere_tree.isNodeLeaf(node))
+                    {
+                        continue;
+                    }
+                    for (unsigned int p = 0; p < m_sphere_tree.getNodeNumParticles(node); ++p)
+                    {
+                        const unsigned int j = m_sphere_tree.getNodeParticleTag(node, p);
+                        const unsigned int point_idx = getPointIndex(j);
+                        if (exclude_ii && query_point_idx == point_idx)
+                        {
+                            continue;
+                        }
+                        vec3<float> pos_j(m_search_points[j]);
+                        if (is2D)
+                        {
+                            pos_j.z = 0;
+                        }
+                        const vec3<float> r_ij = pos_j - pos_i_image;
+                        const float r_sq = dot(r_ij, r_ij);
+                        const float contact = reach + m_radii[j];
+                        if (r_sq < contact * contact)
+                        {
+                            local_bonds.emplace_back(query_point_idx, point_idx, std::sqrt(r_sq));
+                        }
+                    }
+                }
+            }
+        }
+    });
+
+    tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(thread_bonds);
+    std::vector<NeighborBond> bonds(flat_bonds.begin(), flat_bonds.end());
+    util::executeInThreadArena(
+        [&]() { tbb::parallel_sort(bonds.begin(), bonds.end(), compareNeighborBond); });
+    phase.addBonds(bonds.size());
+
+    auto* nlist = new NeighborList();
+    nlist->setNumBonds(bonds.size(), n_query_points, m_n_points);
+    util::forLoopWrapper(0, bonds.size(), [&](size_t begin, size_t end) {
+        for (size_t bond = begin; bond < end; ++bond)
+        {
+            nlist->getNeighbors()(bond, 0) = bonds[bond].query_point_idx;
+            nlist->getNeighbors()(bond, 1) = bonds[bond].point_idx;
+            nlist->getDistances()[bond] = bonds[bond].distance;
+            nlist->getWeights()[bond] = float(1.0);
+        }
+    });
+    return nlist;
+}
+
 std::shared_ptr<NeighborQueryPerPointIterator>
 AABBQuery::querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const
 {
@@ -27,7 +265,8 @@ AABBQuery::querySingle(const vec3<float> query_point, unsigned int query_point_i
     if (args.mode == QueryType::ball)
     {
         return std::make_shared<AABBQueryBallIterator>(this, query_point, query_point_idx, args.r_max,
-                                                       args.r_min, args.exclude_ii);
+                                                       args.r_min, args.exclude_ii, args.half_list, true,
+                                                       args.all_images);
     }
     if (args.mode == QueryType::nearest)
     {
@@ -43,54 +282,111 @@ void AABBQuery::setupTree(unsigned int Np)
     m_aabbs.resize(Np);
 }
 
-void AABBQuery::buildTree(const vec3<float>* points, unsigned int Np)
+void AABBQuery::buildTree(const vec3<float>* points, unsigned int Np, bool parallel_build)
 {
-    // Construct a point AABB for each point
-    for (unsigned int i = 0; i < Np; ++i)
+    computeAABBs(points, Np, parallel_build);
+
+    // Call the tree build routine, one tree per type
+    if (parallel_build)
     {
-        // Make a point AABB
-        vec3<float> my_pos(points[i]);
-        if (m_box.is2D())
+        m_aabb_tree.buildTreeParallel(m_aabbs.data(), Np);
+    }
+    else
+    {
+        m_aabb_tree.buildTree(m_aabbs.data(), Np);
+    }
+    m_build_cost = m_aabb_tree.getCost();
+    countNodePoints();
+}
+
+void AABBQuery::countNodePoints()
+{
+    // The subtree of each node is stored in the nodes [node, node + skip], so
+    // its number of points is a difference of a prefix sum over the leaves.
+    const unsigned int n_nodes = m_aabb_tree.getNumNodes();
+    std::vector<unsigned int> preceding_points(n_nodes + 1, 0);
+    m_point_leaves.resize(m_n_points);
+    for (unsigned int node = 0; node < n_nodes; ++node)
+    {
+        unsigned int n_node_points = 0;
+        if (m_aabb_tree.isNodeLeaf(node))
         {
-            my_pos.z = 0;
+            n_node_points = m_aabb_tree.getNodeNumParticles(node);
+            for (unsigned int p = 0; p < n_node_points; ++p)
+            {
+                m_point_leaves[getPointIndex(m_aabb_tree.getNodeParticleTag(node, p))] = node;
+            }
         }
-        m_aabbs[i] = AABB(my_pos, i);
+        preceding_points[node + 1] = preceding_points[node] + n_node_points;
+    }
+    m_node_counts.resize(n_nodes);
+    for (unsigned int node = 0; node < n_nodes; ++node)
+    {
+        m_node_counts[node]
+            = preceding_points[node + m_aabb_tree.getNodeSkip(node) + 1] - preceding_points[node];
     }
+}
 
-    // Call the tree build routine, one tree per type
-    m_aabb_tree.buildTree(m_aabbs.data(), Np);
+void AABBQuery::computeAABBs(const vec3<float>* points, unsigned int Np, bool parallel)
+{
+    // Construct a point AABB for each point
+    util::forLoopWrapper(
+        0, Np,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                // Make a point AABB
+                vec3<float> my_pos(points[i]);
+                if (m_box.is2D())
+                {
+                    my_pos.z = 0;
+                }
+                m_aabbs[i] = AABB(my_pos, static_cast<unsigned int>(i));
+            }
+        },
+        parallel);
 }
 
-void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
+unsigned int AABBQuery::computeImageVectors(float r_max, bool check_r_max, bool all_images,
+                                            std::vector<vec3<float>>& image_list) const
 {
-    box::Box box = m_neighbor_query->getBox();
+    const box::Box& box = m_box;
     vec3<float> nearest_plane_distance = box.getNearestPlaneDistance();
     vec3<bool> periodic = box.getPeriodic();
-    if (_check_r_max)
+    periodic.z = periodic.z && !box.is2D();
+    if (check_r_max && !all_images)
     {
         if ((periodic.x && nearest_plane_distance.x <= r_max * 2.0)
             || (periodic.y && nearest_plane_distance.y <= r_max * 2.0)
-            || (!box.is2D() && periodic.z && nearest_plane_distance.z <= r_max * 2.0))
+            || (periodic.z && nearest_plane_distance.z <= r_max * 2.0))
         {
             throw std::runtime_error("The AABBQuery r_max is too large for this box.");
         }
     }
 
-    // Now compute the image vectors
-    // Each dimension increases by one power of 3
-    unsigned int n_dim_periodic = static_cast<unsigned int>(periodic.x)
-        + static_cast<unsigned int>(periodic.y)
-        + static_cast<unsigned int>(!box.is2D()) * static_cast<unsigned int>(periodic.z);
-    m_n_images = 1;
-    for (unsigned int dim = 0; dim < n_dim_periodic; ++dim)
-    {
-        m_n_images *= 3;
-    }
+    // Find the range of images to search along each dimension. Points are in
+    // the box, so without all images only the adjacent images can hold the
+    // nearest image of a point. Otherwise, an image n boxes away may be
+    // within r_max if n - 1 box lengths are shorter than r_max.
+    const auto image_range = [&](bool is_periodic, float plane_distance) {
+        if (!is_periodic)
+        {
+            return 0;
+        }
+        return all_images ? static_cast<int>(r_max / plane_distance) + 1 : 1;
+    };
+    const int range_x = image_range(periodic.x, nearest_plane_distance.x);
+    const int range_y = image_range(periodic.y, nearest_plane_distance.y);
+    const int range_z = image_range(periodic.z, nearest_plane_distance.z);
+
+    // Each dimension multiplies the number of images by its number of images
+    const auto n_images_total
+        = static_cast<unsigned int>((2 * range_x + 1) * (2 * range_y + 1) * (2 * range_z + 1));
 
     // Reallocate memory if necessary
-    if (m_n_images > m_image_list.size())
+    if (n_images_total > image_list.size())
     {
-        m_image_list.resize(m_n_images);
+        image_list.resize(n_images_total);
     }
 
     auto latt_a = vec3<float>(box.getLatticeVector(0));
@@ -102,31 +398,30 @@ void AABBIterator::updateImageVectors(float r_max, bool _check_r_max)
     }
 
     // There is always at least 1 image, which we put as our first thing to look at
-    m_image_list[0] = vec3<float>(0.0, 0.0, 0.0);
+    image_list[0] = vec3<float>(0.0, 0.0, 0.0);
 
     // Iterate over all other combinations of images
     unsigned int n_images = 1;
-    for (int i = -1; i <= 1 && n_images < m_n_images; ++i)
+    for (int i = -range_x; i <= range_x; ++i)
     {
-        for (int j = -1; j <= 1 && n_images < m_n_images; ++j)
+        for (int j = -range_y; j <= range_y; ++j)
         {
-            for (int k = -1; k <= 1 && n_images < m_n_images; ++k)
+            for (int k = -range_z; k <= range_z; ++k)
             {
                 if (!(i == 0 && j == 0 && k == 0))
                 {
-                    // Skip any periodic images if we don't have periodicity
-                    if ((i != 0 && !periodic.x) || (j != 0 && !periodic.y)
-                        || (k != 0 && (box.is2D() || !periodic.z)))
-                    {
-                        continue;
-                    }
-
-                    m_image_list[n_images] = float(i) * latt_a + float(j) * latt_b + float(k) * latt_c;
+                    image_list[n_images] = float(i) * latt_a + float(j) * latt_b + float(k) * latt_c;
                     ++n_images;
                 }
             }
         }
     }
+    return n_images_total;
+}
+
+void AABBIterator::updateImageVectors(float r_max, bool _check_r_max, bool all_images)
+{
+    m_n_images = m_aabb_query->computeImageVectors(r_max, _check_r_max, all_images, m_image_list);
 }
 
 NeighborBond AABBQueryBallIterator::next()
@@ -160,17 +455,18 @@ NeighborBond AABBQueryBallIterator::next()
                         // Neighbor j
                         const unsigned int j
                             = m_aabb_query->m_aabb_tree.getNodeParticleTag(cur_node_idx, cur_ref_p);
+                        const unsigned int point_idx = m_neighbor_query->getPointIndex(j);
                         // Increment before possible return.
                         cur_ref_p++;
 
-                        // Skip ii matches immediately if requested.
-                        if (m_exclude_ii && m_query_point_idx == j)
+                        // Skip excluded matches immediately if requested.
+                        if (isExcluded(point_idx))
                         {
                             continue;
                         }
 
                         // Read in the position of j
-                        vec3<float> pos_j((*m_neighbor_query)[j]);
+                        vec3<float> pos_j(m_neighbor_query->getSearchPoints()[j]);
                         if (m_neighbor_query->getBox().is2D())
                         {
                             pos_j.z = 0;
@@ -183,7 +479,7 @@ NeighborBond AABBQueryBallIterator::next()
                         // Check ii exclusion before including the pair.
                         if (r_sq < r_max_sq && r_sq >= r_min_sq)
                         {
-                            return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq));
+                            return NeighborBond(m_query_point_idx, point_idx, std::sqrt(r_sq));
                         }
                     }
                 }
@@ -234,7 +530,7 @@ NeighborBond AABBQueryIterator::next()
             m_query_points_below_r_min.clear();
             std::shared_ptr<NeighborQueryPerPointIterator> ball_it = std::make_shared<AABBQueryBallIterator>(
                 static_cast<const AABBQuery*>(m_neighbor_query), m_query_point, m_query_point_idx,
-                std::min(m_r_cur, m_r_max), 0, m_exclude_ii, false);
+                std::min(m_r_cur, m_r_max), 0, m_exclude_ii, false, false);
             while (!ball_it->end())
             {
                 NeighborBond nb = ball_it->next();
@@ -276,7 +572,7 @@ NeighborBond AABBQueryIterator::next()
 
             if (m_current_neighbors.size() >= m_num_neighbors)
             {
-                std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
+                keepNearestNeighbors(m_current_neighbors, m_num_neighbors);
                 break;
             }
 
@@ -295,7 +591,7 @@ NeighborBond AABBQueryIterator::next()
                                                          bond_distance.second);
                     }
                 }
-                std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
+                keepNearestNeighbors(m_current_neighbors, m_num_neighbors);
                 break;
             }
 
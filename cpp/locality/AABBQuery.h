@@ -4,14 +4,17 @@
 #ifndef AABBQUERY_H
 #define AABBQUERY_H
 
+#include <algorithm>
 #include <cmath>
 #include <map>
 #include <memory>
+#include <type_traits>
 #include <unordered_set>
 #include <vector>
 
 #include "AABBTree.h"
 #include "Box.h"
+#include "NeighborHeap.h"
 #include "NeighborQuery.h"
 
 /*! \file AABBQuery.h
@@ -29,6 +32,24 @@
 
 namespace freud { namespace locality {
 
+/*! \internal
+    \brief Updating an AABBQuery rebuilds the tree when refitting has increased
+    its cost (see AABBTree::getCost) by more than this factor since it was built.
+*/
+const double AABB_QUERY_UPDATE_REBUILD_RATIO = 1.5;
+
+/*! \internal
+    \brief Updating an AABBQuery rebuilds the tree when a point followed across
+    periodic boundaries has drifted more than this fraction of the box outside of it.
+*/
+const float AABB_QUERY_UPDATE_MAX_DRIFT = 0.25;
+
+/*! \internal
+    \brief The bounds of the distances to the points of a node offered by
+    AABBQuery::forEachBallNeighborOrNode are widened by this fraction of 1 + r_max.
+*/
+const float AABB_QUERY_NODE_DISTANCE_MARGIN = 1e-5;
+
 class AABBQuery : public NeighborQuery
 {
 public:
@@ -36,11 +57,53 @@ public:
     AABBQuery();
 
     //! New-style constructor.
-    AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points);
+    /*! \param box The simulation box.
+     *  \param points The point coordinates.
+     *  \param n_points The number of points.
+     *  \param spatial_sort If true, build the tree from a copy of the points reordered along a Morton curve.
+     *  \param parallel_build If true, build the tree in parallel. The resulting tree is identical.
+     */
+    AABBQuery(const box::Box& box, const vec3<float>* points, unsigned int n_points,
+              bool spatial_sort = false, bool parallel_build = false);
 
     //! Destructor
     ~AABBQuery() override;
 
+    //! Update the tree for new positions of the same points in the same box
+    void update(const vec3<float>* points, unsigned int n_points);
+
+    //! Set the radius of each point for contact queries.
+    /*! A second tree is built from the AABBs of the spheres of the points,
+     *  which is rebuilt whenever the points are updated.
+     *
+     *  \param radii The nonnegative radius of each point, which is copied.
+     */
+    void setRadii(const float* radii);
+
+    //! Whether the radii of the points have been set for contact queries.
+    bool hasRadii() const
+    {
+        return !m_radii.empty();
+    }
+
+    //! Find the pairs of query points and points whose spheres are within delta of contact.
+    /*! A query point i and a point j are bonded if r_ij < a_i + a_j + delta,
+     *  where a_i and a_j are their radii. The tree of sphere AABBs is searched
+     *  with a ball of radius a_i + delta around each query point, so that the
+     *  search of a small query point is not widened to the largest contact
+     *  distance of the system. The periodic images searched are those of the
+     *  largest contact distance.
+     *
+     *  \param query_points The points to find contacts for.
+     *  \param query_radii The nonnegative radius of each query point.
+     *  \param n_query_points The number of query points.
+     *  \param delta The nonnegative distance beyond contact within which spheres are bonded.
+     *  \param exclude_ii Whether to exclude bonds between query points and points with the same index.
+     *  \return A neighbor list sorted by query point and point, which the caller is responsible for deleting.
+     */
+    NeighborList* queryContacts(const vec3<float>* query_points, const float* query_radii,
+                                unsigned int n_query_points, float delta, bool exclude_ii) const;
+
     //! Implementation of per-particle query for AABBQuery (see NeighborQuery.h for documentation).
     /*! \param query_point The point to find neighbors for.
      *  \param n_query_points The number of query points.
@@ -49,6 +112,154 @@ public:
     std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const override;
 
+    //! Compute the periodic image vectors that must be searched for a given cutoff.
+    /*! \param r_max The query cutoff distance.
+     *  \param check_r_max Whether to raise an error if r_max is too large for the box.
+     *  \param all_images Whether to include every image within r_max, rather than the adjacent images
+     *                    that hold the nearest image of each point.
+     *  \param image_list Vector in which to store the image vectors, grown if necessary.
+     *  \returns The number of image vectors.
+     */
+    unsigned int computeImageVectors(float r_max, bool check_r_max, bool all_images,
+                                     std::vector<vec3<float>>& image_list) const;
+
+    //! Find the neighbors of a range of query points within a ball and pass each bond to a callback.
+    /*! This performs the same search as AABBQueryBallIterator, but without
+     *  creating an iterator object per query point and without a virtual call
+     *  per bond. The image vectors are computed once for the whole range. The
+     *  arguments are assumed to have already been validated, e.g. by a call
+     *  to query.
+     *
+     *  \param query_points The points to find neighbors for.
+     *  \param begin The first position in the range of query points.
+     *  \param end One past the last position in the range of query points.
+     *  \param order If not null, position k in the range refers to query point order[k].
+     *  \param qargs The validated query arguments of a ball query.
+     *  \param cb An object with operator(const NeighborBond&).
+     */
+    template<typename Callback>
+    void forEachBallNeighbor(const vec3<float>* query_points, size_t begin, size_t end,
+                             const unsigned int* order, const QueryArgs& qargs, const Callback& cb) const
+    {
+        forEachBallNeighborOrNode(query_points, begin, end, order, qargs, 0, RejectNodes(), cb);
+    }
+
+    //! Node callback of forEachBallNeighborOrNode that accepts no nodes.
+    struct RejectNodes
+    {
+        bool operator()(unsigned int /*query_point_idx*/, float /*d_min*/, float /*d_max*/,
+                        unsigned int /*n_node_points*/) const
+        {
+            return false;
+        }
+    };
+
+    //! Find the neighbors of a range of query points within a ball, passing whole nodes to a callback.
+    /*! This performs the search of forEachBallNeighbor, but every node of the
+     *  tree whose points are all bonded to the query point is first offered
+     *  to node_cb(query_point_idx, d_min, d_max, n_node_points), where d_min
+     *  and d_max bound the distances of all bonds to the points of the node.
+     *  If node_cb returns true, the node is consumed as a whole and none of
+     *  its bonds are passed to cb, so that computes that only depend on the
+     *  number of bonds in a range of distances, such as histograms of bond
+     *  distances, visit far fewer than all bonds of large balls.
+     *
+     *  The bounds are widened by a margin relative to r_max so that they also
+     *  bound the distances that would have been computed for the bonds in
+     *  single precision. Nodes are offered for the ranges [r_min, r_max) of
+     *  ball queries without half_list, and with exclude_ii only if the node
+     *  does not contain the point with the index of the query point. Nodes
+     *  whose AABB has a diagonal longer than max_extent are not offered, so
+     *  that computes cheaply skip nodes too large for them to accept.
+     *
+     *  \param query_points The points to find neighbors for.
+     *  \param begin The first position in the range of query points.
+     *  \param end One past the last position in the range of query points.
+     *  \param order If not null, position k in the range refers to query point order[k].
+     *  \param qargs The validated query arguments of a ball query.
+     *  \param max_extent The longest diagonal of the AABBs of the nodes offered to node_cb.
+     *  \param node_cb An object with bool operator()(unsigned int, float, float, unsigned int).
+     *  \param cb An object with operator(const NeighborBond&).
+     */
+    template<typename NodeCallback, typename Callback>
+    void forEachBallNeighborOrNode(const vec3<float>* query_points, size_t begin, size_t end,
+                                   const unsigned int* order, const QueryArgs& qargs, float max_extent,
+                                   const NodeCallback& node_cb, const Callback& cb) const
+    {
+        constexpr bool visit_nodes = !std::is_same<NodeCallback, RejectNodes>::value;
+        const bool accept_nodes = visit_nodes && !qargs.half_list;
+        const float margin = AABB_QUERY_NODE_DISTANCE_MARGIN * (float(1.0) + qargs.r_max);
+        const float r_max = qargs.r_max;
+        const float r_max_sq = r_max * r_max;
+        const float r_min_sq = qargs.r_min * qargs.r_min;
+        const bool is2D = m_box.is2D();
+
+        std::vector<vec3<float>> image_list;
+        const unsigned int n_images = computeImageVectors(r_max, true, qargs.all_images, image_list);
+
+        for (size_t k = begin; k != end; ++k)
+        {
+            const unsigned int query_point_idx = (order == nullptr) ? k : order[k];
+            vec3<float> pos_i(query_points[query_point_idx]);
+            if (is2D)
+            {
+                pos_i.z = 0;
+            }
+
+            for (unsigned int image = 0; image < n_images; ++image)
+            {
+                const vec3<float> pos_i_image = pos_i + image_list[image];
+                const AABBSphere asphere(pos_i_image, r_max);
+
+                // Stackless traversal of the tree, evaluating whole leaves at once.
+                for (unsigned int node = 0; node < m_aabb_tree.getNumNodes(); ++node)
+                {
+                    if (!overlap(m_aabb_tree.getNodeAABB(node), asphere))
+                    {
+                        node += m_aabb_tree.getNodeSkip(node);
+                        continue;
+                    }
+                    if constexpr (visit_nodes)
+                    {
+                        if (accept_nodes
+                            && acceptNode(node, query_point_idx, pos_i_image, is2D, margin, max_extent, qargs,
+                                          node_cb))
+                        {
+                            node += m_aabb_tree.getNodeSkip(node);
+                            continue;
+                        }
+                    }
+                    if (!m_aabb_tree.isNodeLeaf(node))
+                    {
+                        continue;
+                    }
+                    for (unsigned int p = 0; p < m_aabb_tree.getNodeNumParticles(node); ++p)
+                    {
+                        const unsigned int j = m_aabb_tree.getNodeParticleTag(node, p);
+                        const unsigned int point_idx = getPointIndex(j);
+                        if ((qargs.exclude_ii && query_point_idx == point_idx)
+                            || (qargs.half_list && point_idx <= query_point_idx))
+                        {
+                            continue;
+                        }
+
+                        vec3<float> pos_j(m_search_points[j]);
+                        if (is2D)
+                        {
+                            pos_j.z = 0;
+                        }
+                        const vec3<float> r_ij = pos_j - pos_i_image;
+                        const float r_sq = dot(r_ij, r_ij);
+                        if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                        {
+                            cb(NeighborBond(query_point_idx, point_idx, std::sqrt(r_sq)));
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     AABBTree m_aabb_tree; //!< AABB tree of points
 
 protected:
@@ -108,9 +319,71 @@ private:
     void mapParticlesByType();
 
     //! Driver to build AABB trees
-    void buildTree(const vec3<float>* points, unsigned int N);
+    void buildTree(const vec3<float>* points, unsigned int N, bool parallel_build);
+
+    //! Construct the point AABBs, indexed by point
+    void computeAABBs(const vec3<float>* points, unsigned int N, bool parallel);
+
+    //! Build the tree of the sphere AABBs of the search points from their radii
+    void buildSphereTree();
+
+    //! Count the points of every node and find the leaf of every point after the tree is built
+    void countNodePoints();
+
+    //! Offer a node whose points are all bonded to a query point to the node callback.
+    /*! \return Whether the node callback consumed the node.
+     */
+    template<typename NodeCallback>
+    bool acceptNode(unsigned int node, unsigned int query_point_idx, const vec3<float>& query_point,
+                    bool is2D, float margin, float max_extent, const QueryArgs& qargs,
+                    const NodeCallback& node_cb) const
+    {
+        // The subtree of a node is stored in the nodes [node, node + skip].
+        const unsigned int last_node = node + m_aabb_tree.getNodeSkip(node);
+        if (qargs.exclude_ii && query_point_idx < m_n_points && m_point_leaves[query_point_idx] >= node
+            && m_point_leaves[query_point_idx] <= last_node)
+        {
+            return false;
+        }
+
+        const AABB& aabb = m_aabb_tree.getNodeAABB(node);
+        const vec3<float> lower = aabb.getLower();
+        const vec3<float> upper = aabb.getUpper();
+        vec3<float> diagonal = upper - lower;
+        if (is2D)
+        {
+            diagonal.z = 0;
+        }
+        if (dot(diagonal, diagonal) > max_extent * max_extent)
+        {
+            return false;
+        }
+        vec3<float> nearest(std::max({lower.x - query_point.x, float(0), query_point.x - upper.x}),
+                            std::max({lower.y - query_point.y, float(0), query_point.y - upper.y}),
+                            std::max({lower.z - query_point.z, float(0), query_point.z - upper.z}));
+        vec3<float> farthest(std::max(std::abs(query_point.x - lower.x), std::abs(upper.x - query_point.x)),
+                             std::max(std::abs(query_point.y - lower.y), std::abs(upper.y - query_point.y)),
+                             std::max(std::abs(query_point.z - lower.z), std::abs(upper.z - query_point.z)));
+        if (is2D)
+        {
+            nearest.z = 0;
+            farthest.z = 0;
+        }
+        const float d_min = std::sqrt(dot(nearest, nearest)) - margin;
+        const float d_max = std::sqrt(dot(farthest, farthest)) + margin;
+        return d_min >= qargs.r_min && d_max < qargs.r_max
+            && node_cb(query_point_idx, d_min, d_max, m_node_counts[node]);
+    }
 
-    std::vector<AABB> m_aabbs; //!< Flat array of AABBs of all types
+    std::vector<AABB> m_aabbs;     //!< Flat array of AABBs of all types
+    bool m_parallel_build {false}; //!< Whether the tree is built in parallel
+    double m_build_cost {0};       //!< Cost of the tree when it was last built
+    std::vector<vec3<float>> m_tracked_points; //!< Points followed across periodic boundaries since the build
+    std::vector<float> m_radii;                //!< Radius of each search point for contact queries
+    float m_max_radius {0};                    //!< Largest radius of the points
+    AABBTree m_sphere_tree;                    //!< AABB tree of the spheres of the points
+    std::vector<unsigned int> m_node_counts;   //!< Number of points in the subtree of each node
+    std::vector<unsigned int> m_point_leaves;  //!< Leaf node of each point
 };
 
 //! Parent class of AABB iterators that knows how to traverse general AABB tree structures.
@@ -119,9 +392,10 @@ class AABBIterator : public NeighborQueryPerPointIterator
 public:
     //! Constructor
     AABBIterator(const AABBQuery* neighbor_query, const vec3<float>& query_point,
-                 unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
+                 unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
+                 bool half_list = false)
         : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, r_max, r_min,
-                                        exclude_ii),
+                                        exclude_ii, half_list),
           m_aabb_query(neighbor_query)
     {}
 
@@ -129,7 +403,7 @@ public:
     ~AABBIterator() override = default;
 
     //! Computes the image vectors to query for
-    void updateImageVectors(float r_max, bool _check_r_max = true);
+    void updateImageVectors(float r_max, bool _check_r_max = true, bool all_images = false);
 
 protected:
     const AABBQuery* m_aabb_query;         //!< Link to the AABBQuery object
@@ -180,11 +454,11 @@ public:
     //! Constructor
     AABBQueryBallIterator(const AABBQuery* neighbor_query, const vec3<float>& query_point,
                           unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
-                          bool _check_r_max = true)
-        : AABBIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii), cur_image(0),
-          cur_node_idx(0), cur_ref_p(0)
+                          bool half_list = false, bool _check_r_max = true, bool all_images = false)
+        : AABBIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii, half_list),
+          cur_image(0), cur_node_idx(0), cur_ref_p(0)
     {
-        updateImageVectors(m_r_max, _check_r_max);
+        updateImageVectors(m_r_max, _check_r_max, all_images);
     }
 
     //! Empty Destructor
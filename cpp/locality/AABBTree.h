@@ -6,12 +6,18 @@
 
 #include <array>
 #include <cstring>
+#include <memory>
+#include <numeric>
 #include <stack>
 #include <stdexcept>
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_invoke.h>
+#include <tbb/parallel_reduce.h>
 #include <vector>
 
 #include "AABB.h"
 #include "VectorMath.h"
+#include "utils.h"
 
 /*! \file AABBTree.h
     \brief AABBTree build and query methods
@@ -30,6 +36,9 @@ namespace freud { namespace locality {
 
 constexpr unsigned int NODE_CAPACITY = 16;        //!< Maximum number of particles in a node
 constexpr unsigned int INVALID_NODE = 0xffffffff; //!< Invalid node index sentinel
+constexpr unsigned int PARALLEL_BUILD_GRAIN
+    = 4096; //!< Largest particle range that buildTreeParallel builds without spawning tasks
+constexpr unsigned int PARALLEL_REFIT_GRAIN = 1024; //!< Largest number of nodes that refit updates serially
 
 //! Node in an AABBTree
 /*! Stores data for a node in the AABB tree
@@ -68,6 +77,8 @@ struct CACHE_ALIGN AABBNode
    will only increase the volume of nodes. The tree should be rebuilt periodically instead of continually
    updated.
     - buildTree : build an efficiently arranged tree given a complete set of AABBs, one for each particle.
+    - buildTreeParallel : build the same tree as buildTree, constructing independent subtrees in parallel.
+    - refit : update the bounds of all nodes for new particle AABBs without changing the tree topology.
 
     **Implementation details**
 
@@ -158,12 +169,21 @@ public:
     //! Build a tree smartly from a list of AABBs
     inline void buildTree(AABB* aabbs, unsigned int N);
 
+    //! Build the same tree as buildTree, constructing subtrees in parallel
+    inline void buildTreeParallel(AABB* aabbs, unsigned int N);
+
     //! Find all particles that overlap with the query AABB
     inline unsigned int query(std::vector<unsigned int>& hits, const AABB& aabb) const;
 
     //! Update the AABB of a particle
     inline void update(unsigned int idx, const AABB& aabb);
 
+    //! Recompute the bounds of all nodes from new AABBs of the particles
+    inline void refit(const AABB* aabbs);
+
+    //! Get the sum of the surface areas of all nodes
+    inline double getCost() const;
+
     //! Get the height of a given particle's leaf node
     inline unsigned int height(unsigned int idx);
 
@@ -248,13 +268,54 @@ private:
     //! Initialize the tree to hold N particles
     inline void init(unsigned int N);
 
+    //! A subtree produced by the first pass of buildTreeParallel
+    struct PendingNode
+    {
+        AABB aabb;                          //!< Bounding box of a node split in parallel
+        std::unique_ptr<PendingNode> left;  //!< Left child of a node split in parallel
+        std::unique_ptr<PendingNode> right; //!< Right child of a node split in parallel
+        std::vector<AABBNode> subtree;      //!< Serially built subtree, with indices local to this vector
+        unsigned int num_nodes {0};         //!< Total number of nodes in this subtree
+    };
+
     //! Build a node of the tree recursively
     inline unsigned int buildNode(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
                                   unsigned int len, unsigned int parent);
 
+    //! Build a subtree recursively into a separate array of nodes
+    static inline unsigned int buildSubtree(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
+                                            unsigned int len, unsigned int parent,
+                                            std::vector<AABBNode>& nodes);
+
+    //! Split large ranges in parallel and build the small ones serially
+    static inline void planSubtree(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
+                                   unsigned int len, PendingNode& node);
+
+    //! Sum the node counts of the split nodes in a planned subtree
+    static inline unsigned int countNodes(PendingNode& node);
+
+    //! Copy a planned subtree into the node array at its final position
+    inline void placeSubtree(const PendingNode& node, unsigned int offset, unsigned int parent);
+
+    //! Refit the subtree rooted at a node
+    inline void refitSubtree(const AABB* aabbs, unsigned int node);
+
+    //! Recompute the bounds of a single node from its particles or children
+    inline void refitNode(const AABB* aabbs, unsigned int node);
+
+    //! Merge the AABBs in a range into one
+    static inline AABB mergeRange(const AABB* aabbs, unsigned int start, unsigned int len);
+
+    //! Partition a range of AABBs into the left and right children of a node
+    static inline unsigned int partitionNode(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
+                                             unsigned int len, const AABB& my_aabb);
+
     //! Allocate a new node
     inline unsigned int allocateNode();
 
+    //! Make room for at least the given number of nodes
+    inline void reserveNodes(unsigned int capacity);
+
     //! Update the skip value for a node
     inline unsigned int updateSkip(unsigned int idx);
 };
@@ -349,6 +410,88 @@ inline void AABBTree::update(unsigned int idx, const AABB& aabb)
     }
 }
 
+/*! \param aabbs New AABBs of the particles, indexed by particle
+
+    Unlike update(), which only grows the bounds, refit() recomputes the bounds of every node bottom-up so
+   that they are tight for the new AABBs. The tree topology is unchanged, so the quality of the tree degrades
+   as the particles move away from the positions it was built with (see getCost()). Independent subtrees are
+   refit in parallel.
+*/
+inline void AABBTree::refit(const AABB* aabbs)
+{
+    if (m_num_nodes == 0)
+    {
+        return;
+    }
+    util::executeInThreadArena([&]() { refitSubtree(aabbs, m_root); });
+}
+
+/*! \returns The sum of the surface areas of all nodes
+
+    The number of nodes visited by a query is roughly proportional to the surface areas of the nodes, so
+   this is a measure of the expected query cost. In 2D, the areas of the nodes are used instead.
+*/
+inline double AABBTree::getCost() const
+{
+    const auto add_costs = [this](const tbb::blocked_range<unsigned int>& r, double cost) {
+        for (unsigned int i = r.begin(); i != r.end(); ++i)
+        {
+            const vec3<float> extent = m_nodes[i].aabb.getUpper() - m_nodes[i].aabb.getLower();
+            cost += double(extent.x) * extent.y + double(extent.y) * extent.z + double(extent.z) * extent.x;
+        }
+        return cost;
+    };
+    return util::executeInThreadArena([&]() {
+        return tbb::parallel_reduce(tbb::blocked_range<unsigned int>(0, m_num_nodes), 0.0, add_costs,
+                                    [](double a, double b) { return a + b; });
+    });
+}
+
+/*! \param aabbs New AABBs of the particles, indexed by particle
+    \param node Root of the subtree to refit
+
+    The nodes of a subtree occupy the contiguous range [node, node + skip] with all children after their
+   parents, so small subtrees are refit by a single reverse sweep over that range.
+*/
+inline void AABBTree::refitSubtree(const AABB* aabbs, unsigned int node)
+{
+    const unsigned int left = m_nodes[node].left;
+    const unsigned int right = m_nodes[node].right;
+    if (left != INVALID_NODE && m_nodes[left].skip >= PARALLEL_REFIT_GRAIN
+        && m_nodes[right].skip >= PARALLEL_REFIT_GRAIN)
+    {
+        tbb::parallel_invoke([&]() { refitSubtree(aabbs, left); }, [&]() { refitSubtree(aabbs, right); });
+        refitNode(aabbs, node);
+        return;
+    }
+
+    for (unsigned int i = node + m_nodes[node].skip + 1; i-- > node;)
+    {
+        refitNode(aabbs, i);
+    }
+}
+
+/*! \param aabbs New AABBs of the particles, indexed by particle
+    \param node Node to refit, whose children must already be refit
+*/
+inline void AABBTree::refitNode(const AABB* aabbs, unsigned int node)
+{
+    AABBNode& current = m_nodes[node];
+    if (current.left == INVALID_NODE)
+    {
+        AABB my_aabb = aabbs[current.particles[0]];
+        for (unsigned int i = 1; i < current.num_particles; i++)
+        {
+            my_aabb = merge(my_aabb, aabbs[current.particles[i]]);
+        }
+        current.aabb = my_aabb;
+    }
+    else
+    {
+        current.aabb = merge(m_nodes[current.left].aabb, m_nodes[current.right].aabb);
+    }
+}
+
 /*! \param idx Particle to get height for
     \returns Height of the node
 */
@@ -396,6 +539,38 @@ inline void AABBTree::buildTree(AABB* aabbs, unsigned int N)
     updateSkip(m_root);
 }
 
+/*! \param aabbs List of AABBs for each particle (must be 32-byte aligned)
+    \param N Number of AABBs in the list
+
+    Builds exactly the same tree as buildTree, with the same node order. The ranges of the upper levels of
+   the tree are bounded and partitioned in sequence, but the two halves of each range are then processed
+   concurrently, and ranges of at most PARALLEL_BUILD_GRAIN particles are built serially in separate arrays.
+   A second parallel pass copies these subtrees into their final positions. Data in \a aabbs will be
+   modified during the construction process.
+*/
+inline void AABBTree::buildTreeParallel(AABB* aabbs, unsigned int N)
+{
+    if (N <= PARALLEL_BUILD_GRAIN)
+    {
+        buildTree(aabbs, N);
+        return;
+    }
+
+    init(N);
+
+    std::vector<unsigned int> idx(N);
+    std::iota(idx.begin(), idx.end(), 0);
+
+    PendingNode root;
+    util::executeInThreadArena([&]() { planSubtree(aabbs, idx, 0, N, root); });
+
+    reserveNodes(root.num_nodes);
+    m_num_nodes = root.num_nodes;
+    util::executeInThreadArena([&]() { placeSubtree(root, 0, INVALID_NODE); });
+    m_root = 0;
+    updateSkip(m_root);
+}
+
 /*! \param aabbs List of AABBs
     \param idx List of indices
     \param start Start point in aabbs and idx to examine
@@ -415,12 +590,7 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs, std::vector<unsigned int>&
                                         unsigned int len, unsigned int parent)
 {
     // merge all the AABBs into one
-    AABB my_aabb = aabbs[start];
-    for (unsigned int i = 1; i < len; i++)
-    {
-        my_aabb = merge(my_aabb, aabbs[start + i]);
-    }
-    vec3<float> my_radius = my_aabb.getUpper() - my_aabb.getLower();
+    AABB my_aabb = mergeRange(aabbs, start, len);
 
     // handle the case of a leaf node creation
     if (len <= NODE_CAPACITY)
@@ -447,7 +617,234 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs, std::vector<unsigned int>&
     unsigned int my_idx = allocateNode();
 
     // need to split the list of aabbs into two sets for left and right
-    unsigned int start_left = 0;
+    unsigned int start_right = partitionNode(aabbs, idx, start, len, my_aabb);
+
+    // note: calling buildNode has side effects, the m_nodes array may be reallocated. So we need to determine
+    // the left and right children, then build our node (can't say m_nodes[my_idx].left = buildNode(...))
+    unsigned int new_left = buildNode(aabbs, idx, start, start_right, my_idx);
+    unsigned int new_right = buildNode(aabbs, idx, start + start_right, len - start_right, my_idx);
+
+    // now, create the children and connect them up
+    m_nodes[my_idx].aabb = my_aabb;
+    m_nodes[my_idx].parent = parent;
+    m_nodes[my_idx].left = new_left;
+    m_nodes[my_idx].right = new_right;
+
+    return my_idx;
+}
+
+/*! \param aabbs List of AABBs
+    \param idx List of indices
+    \param start Start point in aabbs and idx to examine
+    \param len Number of aabbs to examine
+    \param parent Index of the parent node within \a nodes
+    \param nodes Array to which the nodes of the subtree are appended
+    \returns The index of the subtree's root within \a nodes
+
+    buildSubtree performs the same splits as buildNode and appends the nodes in the same order, but writes
+   them to a separate array and does not update the reverse mapping. It is used by buildTreeParallel to build
+   independent subtrees concurrently.
+*/
+inline unsigned int AABBTree::buildSubtree(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
+                                           unsigned int len, unsigned int parent,
+                                           std::vector<AABBNode>& nodes)
+{
+    AABB my_aabb = mergeRange(aabbs, start, len);
+    const auto my_idx = static_cast<unsigned int>(nodes.size());
+    nodes.emplace_back();
+    nodes[my_idx].aabb = my_aabb;
+    nodes[my_idx].parent = parent;
+
+    if (len <= NODE_CAPACITY)
+    {
+        nodes[my_idx].num_particles = len;
+        for (unsigned int i = 0; i < len; i++)
+        {
+            nodes[my_idx].particles[i] = idx[start + i];
+            nodes[my_idx].particle_tags[i] = aabbs[start + i].tag;
+        }
+        return my_idx;
+    }
+
+    unsigned int start_right = partitionNode(aabbs, idx, start, len, my_aabb);
+    unsigned int new_left = buildSubtree(aabbs, idx, start, start_right, my_idx, nodes);
+    unsigned int new_right = buildSubtree(aabbs, idx, start + start_right, len - start_right, my_idx, nodes);
+    nodes[my_idx].left = new_left;
+    nodes[my_idx].right = new_right;
+    return my_idx;
+}
+
+/*! \param aabbs List of AABBs
+    \param idx List of indices
+    \param start Start point in aabbs and idx to examine
+    \param len Number of aabbs to examine
+    \param node Output description of the subtree
+
+    Ranges larger than PARALLEL_BUILD_GRAIN are bounded and partitioned exactly as in buildNode. When both
+   halves are large they are then planned concurrently. Otherwise the small half is built serially with
+   buildSubtree and the large one is split further in a loop, so that highly unbalanced splits (e.g. many
+   coincident points) do not nest tasks arbitrarily deep.
+*/
+inline void AABBTree::planSubtree(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
+                                  unsigned int len, PendingNode& node)
+{
+    PendingNode* current = &node;
+    while (len > PARALLEL_BUILD_GRAIN)
+    {
+        // merging is associative, so the bounding box may be reduced in parallel
+        current->aabb = tbb::parallel_reduce(
+            tbb::blocked_range<unsigned int>(start + 1, start + len, PARALLEL_BUILD_GRAIN), aabbs[start],
+            [aabbs](const tbb::blocked_range<unsigned int>& r, AABB my_aabb) {
+                for (unsigned int i = r.begin(); i != r.end(); ++i)
+                {
+                    my_aabb = merge(my_aabb, aabbs[i]);
+                }
+                return my_aabb;
+            },
+            [](const AABB& a, const AABB& b) { return merge(a, b); });
+
+        const unsigned int start_right = partitionNode(aabbs, idx, start, len, current->aabb);
+        const unsigned int len_right = len - start_right;
+        current->left = std::make_unique<PendingNode>();
+        current->right = std::make_unique<PendingNode>();
+        PendingNode& left = *current->left;
+        PendingNode& right = *current->right;
+
+        if (start_right > PARALLEL_BUILD_GRAIN && len_right > PARALLEL_BUILD_GRAIN)
+        {
+            tbb::parallel_invoke([&]() { planSubtree(aabbs, idx, start, start_right, left); },
+                                 [&]() { planSubtree(aabbs, idx, start + start_right, len_right, right); });
+            len = 0;
+        }
+        else if (start_right <= PARALLEL_BUILD_GRAIN)
+        {
+            planSubtree(aabbs, idx, start, start_right, left);
+            start += start_right;
+            len = len_right;
+            current = &right;
+        }
+        else
+        {
+            planSubtree(aabbs, idx, start + start_right, len_right, right);
+            len = start_right;
+            current = &left;
+        }
+    }
+
+    if (len > 0)
+    {
+        buildSubtree(aabbs, idx, start, len, INVALID_NODE, current->subtree);
+        current->num_nodes = static_cast<unsigned int>(current->subtree.size());
+    }
+    countNodes(node);
+}
+
+/*! \param node Planned subtree
+    \returns The number of nodes in the subtree
+*/
+inline unsigned int AABBTree::countNodes(PendingNode& node)
+{
+    if (node.left)
+    {
+        node.num_nodes = 1 + countNodes(*node.left) + countNodes(*node.right);
+    }
+    return node.num_nodes;
+}
+
+/*! \param node Subtree to place
+    \param offset Index in the node array of the subtree's root
+    \param parent Index of the parent of the subtree's root
+
+    Nodes are placed in the same depth-first order in which buildNode allocates them, so that the skip
+   values computed by updateSkip remain valid for the stackless traversal.
+*/
+inline void AABBTree::placeSubtree(const PendingNode& node, unsigned int offset, unsigned int parent)
+{
+    const PendingNode* current = &node;
+    while (current->left)
+    {
+        const unsigned int left = offset + 1;
+        const unsigned int right = left + current->left->num_nodes;
+        m_nodes[offset] = AABBNode();
+        m_nodes[offset].aabb = current->aabb;
+        m_nodes[offset].parent = parent;
+        m_nodes[offset].left = left;
+        m_nodes[offset].right = right;
+
+        if (current->left->left && current->right->left)
+        {
+            const PendingNode& split = *current;
+            const unsigned int split_idx = offset;
+            tbb::parallel_invoke([&]() { placeSubtree(*split.left, left, split_idx); },
+                                 [&]() { placeSubtree(*split.right, right, split_idx); });
+            return;
+        }
+
+        // copy the serially built child directly and continue down the other one
+        parent = offset;
+        if (!current->left->left)
+        {
+            placeSubtree(*current->left, left, parent);
+            offset = right;
+            current = current->right.get();
+        }
+        else
+        {
+            placeSubtree(*current->right, right, parent);
+            offset = left;
+            current = current->left.get();
+        }
+    }
+
+    for (unsigned int i = 0; i < current->num_nodes; ++i)
+    {
+        AABBNode& placed = m_nodes[offset + i];
+        placed = current->subtree[i];
+        placed.parent = (i == 0) ? parent : placed.parent + offset;
+        if (placed.left == INVALID_NODE)
+        {
+            for (unsigned int j = 0; j < placed.num_particles; ++j)
+            {
+                m_mapping[placed.particles[j]] = offset + i;
+            }
+        }
+        else
+        {
+            placed.left += offset;
+            placed.right += offset;
+        }
+    }
+}
+
+/*! \param aabbs List of AABBs
+    \param start Start point in aabbs to examine
+    \param len Number of aabbs to examine
+    \returns An AABB enclosing all of the AABBs in the range
+*/
+inline AABB AABBTree::mergeRange(const AABB* aabbs, unsigned int start, unsigned int len)
+{
+    AABB my_aabb = aabbs[start];
+    for (unsigned int i = 1; i < len; i++)
+    {
+        my_aabb = merge(my_aabb, aabbs[start + i]);
+    }
+    return my_aabb;
+}
+
+/*! \param aabbs List of AABBs
+    \param idx List of indices
+    \param start Start point in aabbs and idx to examine
+    \param len Number of aabbs to examine
+    \param my_aabb AABB enclosing the whole range
+    \returns The offset from \a start of the first AABB in the right child
+
+    The range is split at the center of the longest dimension of \a my_aabb, swapping AABBs and indices in
+   place like quick sort. Both children are guaranteed to be nonempty.
+*/
+inline unsigned int AABBTree::partitionNode(AABB* aabbs, std::vector<unsigned int>& idx, unsigned int start,
+                                            unsigned int len, const AABB& my_aabb)
+{
+    vec3<float> my_radius = my_aabb.getUpper() - my_aabb.getLower();
     unsigned int start_right = len;
 
     // if there are only 2 aabbs, put one on each side
@@ -458,73 +855,41 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs, std::vector<unsigned int>&
     if (len != 2)
     {
         // otherwise, we need to split them based on a heuristic. split the longest dimension in half
+        unsigned int axis = 2;
         if (my_radius.x > my_radius.y && my_radius.x > my_radius.z)
         {
-            // split on x direction
-            for (unsigned int i = 0; i < start_right; i++)
-            {
-                if (aabbs[start + i].getPosition().x < my_aabb.getPosition().x)
-                {
-                    // if on the left side, everything is happy, just continue on
-                }
-                else
-                {
-                    // if on the right side, need to swap the current aabb with the one at
-                    // start_right-1, subtract one off of start_right to indicate the addition
-                    // of one to the right side and subtract 1 from i to look at the current
-                    // index (new aabb). This is quick and easy to write, but will randomize
-                    // indices - might need to look into a stable partitioning algorithm!
-                    std::swap(aabbs[start + i], aabbs[start + start_right - 1]);
-                    std::swap(idx[start + i], idx[start + start_right - 1]);
-                    start_right--;
-                    i--;
-                }
-            }
+            axis = 0;
         }
         else if (my_radius.y > my_radius.z)
         {
-            // split on y direction
-            for (unsigned int i = 0; i < start_right; i++)
+            axis = 1;
+        }
+        const auto component = [axis](const vec3<float>& v) {
+            if (axis == 0)
             {
-                if (aabbs[start + i].getPosition().y < my_aabb.getPosition().y)
-                {
-                    // if on the left side, everything is happy, just continue on
-                }
-                else
-                {
-                    // if on the right side, need to swap the current aabb with the one at
-                    // start_right-1, subtract one off of start_right to indicate the addition
-                    // of one to the right side and subtract 1 from i to look at the current
-                    // index (new aabb). This is quick and easy to write, but will randomize
-                    // indices - might need to look into a stable partitioning algorithm!
-                    std::swap(aabbs[start + i], aabbs[start + start_right - 1]);
-                    std::swap(idx[start + i], idx[start + start_right - 1]);
-                    start_right--;
-                    i--;
-                }
+                return v.x;
             }
-        }
-        else
+            return (axis == 1) ? v.y : v.z;
+        };
+        const float split = component(my_aabb.getPosition());
+
+        for (unsigned int i = 0; i < start_right; i++)
         {
-            // split on z direction
-            for (unsigned int i = 0; i < start_right; i++)
+            if (component(aabbs[start + i].getPosition()) < split)
             {
-                if (aabbs[start + i].getPosition().z < my_aabb.getPosition().z)
-                {
-                    // if on the left side, everything is happy, just continue on
-                }
-                else
-                {
-                    // if on the right side, need to swap the current aabb with the one at
-                    // start_right-1, subtract one off of start_right to indicate the addition
-                    // of one to the right side and subtract 1 from i to look at the current
-                    // index (new aabb). This is quick and easy to write, but will randomize
-                    // indices - might need to look into a stable partitioning algorithm!
-                    std::swap(aabbs[start + i], aabbs[start + start_right - 1]);
-                    std::swap(idx[start + i], idx[start + start_right - 1]);
-                    start_right--;
-                    i--;
-                }
+                // if on the left side, everything is happy, just continue on
+            }
+            else
+            {
+                // if on the right side, need to swap the current aabb with the one at
+                // start_right-1, subtract one off of start_right to indicate the addition
+                // of one to the right side and subtract 1 from i to look at the current
+                // index (new aabb). This is quick and easy to write, but will randomize
+                // indices - might need to look into a stable partitioning algorithm!
+                std::swap(aabbs[start + i], aabbs[start + start_right - 1]);
+                std::swap(idx[start + i], idx[start + start_right - 1]);
+                start_right--;
+                i--;
             }
         }
     }
@@ -538,19 +903,7 @@ inline unsigned int AABBTree::buildNode(AABB* aabbs, std::vector<unsigned int>&
     {
         start_right = 1;
     }
-
-    // note: calling buildNode has side effects, the m_nodes array may be reallocated. So we need to determine
-    // the left and right children, then build our node (can't say m_nodes[my_idx].left = buildNode(...))
-    unsigned int new_left = buildNode(aabbs, idx, start + start_left, start_right - start_left, my_idx);
-    unsigned int new_right = buildNode(aabbs, idx, start + start_right, len - start_right, my_idx);
-
-    // now, create the children and connect them up
-    m_nodes[my_idx].aabb = my_aabb;
-    m_nodes[my_idx].parent = parent;
-    m_nodes[my_idx].left = new_left;
-    m_nodes[my_idx].right = new_right;
-
-    return my_idx;
+    return start_right;
 }
 
 /*! \param idx Index of the node to update
@@ -616,6 +969,35 @@ inline unsigned int AABBTree::allocateNode()
     return m_num_nodes - 1;
 }
 
+/*! \param capacity Number of nodes the array must be able to hold
+
+    Grows the node array if needed, preserving the nodes already allocated.
+*/
+inline void AABBTree::reserveNodes(unsigned int capacity)
+{
+    if (capacity <= m_node_capacity)
+    {
+        return;
+    }
+
+    AABBNode* m_new_nodes = nullptr;
+    // cppcheck-suppress AssignmentAddressToInteger
+    int retval = posix_memalign((void**) &m_new_nodes, 32, capacity * sizeof(AABBNode));
+    if (retval != 0)
+    {
+        throw std::runtime_error("Error allocating AABBTree memory");
+    }
+
+    if (m_nodes != nullptr)
+    {
+        // cppcheck-suppress nullPointer
+        std::memcpy((void*) m_new_nodes, (void*) m_nodes, sizeof(AABBNode) * m_num_nodes);
+        posix_memalign_free(m_nodes);
+    }
+    m_nodes = m_new_nodes;
+    m_node_capacity = capacity;
+}
+
 }; }; // end namespace freud::locality
 
 #endif // AABB_TREE_H
@@ -90,6 +90,30 @@ public:
         return m_histogram.getAxisSizes();
     }
 
+    //! \internal
+    // Replace the accumulated bin counts and the numbers of points of the last frame.
+    /*! Distributed computes accumulate the bonds of the points of each rank and
+        then replace the bin counts on every rank by their sums over all ranks.
+        \param bin_counts Bin counts of all frames, in the order of the bins of the histogram.
+        \param n_points Number of points of the last frame.
+        \param n_query_points Number of query points of the last frame.
+    */
+    void setBinCounts(const std::vector<unsigned int>& bin_counts, unsigned int n_points,
+                      unsigned int n_query_points)
+    {
+        m_local_histograms.reset();
+        for (size_t bin = 0; bin < bin_counts.size(); ++bin)
+        {
+            if (bin_counts[bin] != 0)
+            {
+                m_local_histograms.increment(bin, bin_counts[bin]);
+            }
+        }
+        m_n_points = n_points;
+        m_n_query_points = n_query_points;
+        m_reduce = true;
+    }
+
     //! \internal
     // Wrapper to do accumulation.
     /*! \param neighbor_query NeighborQuery object to iterate over
@@ -99,21 +123,54 @@ public:
            appropriately with given qargs.
         \param qargs Query arguments
         \param cf An object with operator(NeighborBond) as input.
+        \param policy Whether half neighbor lists are accepted.
     */
     template<typename Func>
     void accumulateGeneral(const locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
                            unsigned int n_query_points, const locality::NeighborList* nlist,
-                           locality::QueryArgs qargs, Func cf)
+                           locality::QueryArgs qargs, Func cf,
+                           locality::HalfListPolicy policy = locality::HalfListPolicy::reject)
+    {
+        accumulateGeneralRanges(
+            neighbor_query, query_points, n_query_points, nlist, qargs, [&cf]() -> const Func& { return cf; },
+            policy);
+    }
+
+    //! \internal
+    // Wrapper to do accumulation with a compute function per range of bonds.
+    /*! \param neighbor_query NeighborQuery object to iterate over
+        \param query_points Query points
+        \param n_query_points Number of query_points
+        \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query
+           appropriately with given qargs.
+        \param qargs Query arguments
+        \param make_cf An object with operator() returning an object with operator(NeighborBond), called
+           once for each range of bonds processed by a thread.
+        \param policy Whether half neighbor lists are accepted.
+    */
+    template<typename MakeFunc>
+    void accumulateGeneralRanges(const locality::NeighborQuery* neighbor_query,
+                                 const vec3<float>* query_points, unsigned int n_query_points,
+                                 const locality::NeighborList* nlist, locality::QueryArgs qargs,
+                                 MakeFunc make_cf,
+                                 locality::HalfListPolicy policy = locality::HalfListPolicy::reject)
     {
         m_box = neighbor_query->getBox();
-        locality::loopOverNeighbors(neighbor_query, query_points, n_query_points, qargs, nlist, cf);
+        locality::loopOverNeighborRanges(neighbor_query, query_points, n_query_points, qargs, nlist, make_cf,
+                                         true, policy);
+        finishFrame(neighbor_query, n_query_points);
+    }
+
+protected:
+    //! Count a frame whose bonds have been added to the thread local histograms.
+    void finishFrame(const locality::NeighborQuery* neighbor_query, unsigned int n_query_points)
+    {
         m_frame_counter++;
         m_n_points = neighbor_query->getNPoints();
         m_n_query_points = n_query_points;
         m_reduce = true;
     }
 
-protected:
     box::Box m_box;
     unsigned int m_frame_counter {0};  //!< Number of frames calculated.
     unsigned int m_n_points {0};       //!< The number of points.
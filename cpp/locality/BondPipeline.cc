@@ -0,0 +1,101 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+
+#include "AABBQuery.h"
+#include "BondPipeline.h"
+#include "Instrumentation.h"
+#include "NeighborComputeFunctional.h"
+#include "utils.h"
+
+/*! \file BondPipeline.cc
+    \brief Several computes consuming the bonds of a single traversal of a neighbor list.
+*/
+
+namespace freud { namespace locality {
+
+namespace {
+//! Number of bonds above which a block of query points is not extended, about 16 KB of bond data.
+constexpr size_t BOND_BLOCK_SIZE = 1024;
+} // namespace
+
+void computeBondStages(const std::vector<BondStage*>& stages, const NeighborQuery* neighbor_query,
+                       const vec3<float>* query_points, unsigned int n_query_points,
+                       const NeighborList* nlist, QueryArgs qargs)
+{
+    util::ScopedPhase phase("computeBondStages");
+
+    const bool accepts_half_lists = std::all_of(stages.cbegin(), stages.cend(), [](const BondStage* stage) {
+        return stage->acceptsHalfLists();
+    });
+    const HalfListPolicy policy = accepts_half_lists ? HalfListPolicy::symmetric : HalfListPolicy::reject;
+    checkHalfListPolicy(nlist, qargs, policy);
+
+    // The neighbors are found once for all stages.
+    NeighborList query_nlist;
+    if (nlist == nullptr)
+    {
+        query_nlist = makeDefaultNlist(neighbor_query, nlist, query_points, n_query_points, qargs, policy);
+        nlist = &query_nlist;
+    }
+    phase.addBonds(nlist->getNumBonds());
+
+    for (BondStage* stage : stages)
+    {
+        stage->beginBonds(neighbor_query, query_points, n_query_points, *nlist);
+    }
+
+    const unsigned int* neighbors = nlist->getNeighbors().get();
+    const size_t n_bonds = nlist->getNumBonds();
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        size_t first_bond = nlist->find_first_index(begin);
+        for (size_t block_begin = begin; block_begin < end;)
+        {
+            // Blocks hold whole query points, and at least one query point.
+            size_t block_end = block_begin;
+            size_t end_bond = first_bond;
+            do
+            {
+                for (; end_bond < n_bonds && neighbors[2 * end_bond] == block_end; ++end_bond) {}
+                ++block_end;
+            } while (block_end < end && end_bond - first_bond < BOND_BLOCK_SIZE);
+
+            for (BondStage* stage : stages)
+            {
+                stage->consumeBonds(*nlist, block_begin, block_end, first_bond, end_bond);
+            }
+            block_begin = block_end;
+            first_bond = end_bond;
+        }
+    });
+
+    for (BondStage* stage : stages)
+    {
+        stage->endBonds(*nlist);
+    }
+}
+
+void computeBondStagesFrames(const std::vector<BondStage*>& stages, const box::Box& box,
+                             const vec3<float>* frames, unsigned int n_frames, unsigned int n_points,
+                             QueryArgs qargs)
+{
+    util::ScopedPhase phase("computeBondStagesFrames");
+    if (n_frames == 0)
+    {
+        return;
+    }
+
+    AABBQuery neighbor_query(box, frames, n_points);
+    for (unsigned int frame = 0; frame < n_frames; ++frame)
+    {
+        const vec3<float>* points = frames + static_cast<size_t>(frame) * n_points;
+        if (frame != 0)
+        {
+            neighbor_query.update(points, n_points);
+        }
+        computeBondStages(stages, &neighbor_query, points, n_points, nullptr, qargs);
+    }
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,96 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BOND_PIPELINE_H
+#define BOND_PIPELINE_H
+
+#include <vector>
+
+#include "Box.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file BondPipeline.h
+    \brief Several computes consuming the bonds of a single traversal of a neighbor list.
+*/
+
+namespace freud { namespace locality {
+
+//! A compute consuming the bonds of ranges of query points, driven by computeBondStages.
+/*! The bonds of the neighbor list are consumed in blocks of consecutive
+ *  query points. Every stage consumes a block before the next block is read,
+ *  so that all stages after the first read the bonds of the block from the
+ *  cache rather than from memory.
+ */
+class BondStage
+{
+public:
+    //! Destructor
+    virtual ~BondStage() = default;
+
+    //! Get whether the stage accounts for the reverse bond of every bond of a half neighbor list.
+    virtual bool acceptsHalfLists() const
+    {
+        return false;
+    }
+
+    //! Prepare the outputs of the stage for the bonds of a neighbor list.
+    /*! \param neighbor_query NeighborQuery of the points.
+     *  \param query_points The query points.
+     *  \param n_query_points The number of query points.
+     *  \param nlist The neighbor list whose bonds are consumed.
+     */
+    virtual void beginBonds(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                            unsigned int n_query_points, const NeighborList& nlist)
+        = 0;
+
+    //! Consume the bonds of the query points [begin, end), which are the bonds [first_bond, end_bond).
+    /*! Called concurrently for disjoint ranges of query points.
+     */
+    virtual void consumeBonds(const NeighborList& nlist, size_t begin, size_t end, size_t first_bond,
+                              size_t end_bond)
+        = 0;
+
+    //! Finish the outputs of the stage once all bonds have been consumed.
+    virtual void endBonds(const NeighborList& nlist) = 0;
+};
+
+//! Compute several stages from a single traversal of the bonds of the query points.
+/*! If no neighbor list is provided, the neighbors of the query points are
+ *  found by a single query whose neighbor list is shared by all stages. Half
+ *  neighbor lists are rejected unless every stage accepts them.
+ *
+ *  \param stages The stages consuming the bonds, in order.
+ *  \param neighbor_query NeighborQuery of the points.
+ *  \param query_points The query points.
+ *  \param n_query_points The number of query points.
+ *  \param nlist Neighbor list of the bonds, or nullptr to query neighbor_query with qargs.
+ *  \param qargs Query arguments.
+ */
+void computeBondStages(const std::vector<BondStage*>& stages, const NeighborQuery* neighbor_query,
+                       const vec3<float>* query_points, unsigned int n_query_points,
+                       const NeighborList* nlist, QueryArgs qargs);
+
+//! Compute several stages from the bonds of every frame of a trajectory.
+/*! The frames hold the positions of the same points in the same box. The
+ *  AABBQuery of the first frame is updated for every following frame (see
+ *  AABBQuery::update) rather than rebuilt, and the bonds of every frame are
+ *  consumed by all stages as in computeBondStages, without returning to the
+ *  caller between frames. Histogram stages therefore accumulate all frames,
+ *  and the other stages hold the results of the last frame.
+ *
+ *  \param stages The stages consuming the bonds, in order.
+ *  \param box The box of all frames.
+ *  \param frames The points of all frames, one frame after the other.
+ *  \param n_frames The number of frames.
+ *  \param n_points The number of points of each frame, which are also the query points.
+ *  \param qargs Query arguments.
+ */
+void computeBondStagesFrames(const std::vector<BondStage*>& stages, const box::Box& box,
+                             const vec3<float>* frames, unsigned int n_frames, unsigned int n_points,
+                             QueryArgs qargs);
+
+}; }; // end namespace freud::locality
+
+#endif // BOND_PIPELINE_H
@@ -4,9 +4,16 @@
 #ifndef __FILTER_H__
 #define __FILTER_H__
 
+#include "NeighborBond.h"
+#include "NeighborComputeFunctional.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
+#include <algorithm>
 #include <iostream>
+#include <limits>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_sort.h>
+#include <vector>
 
 namespace freud { namespace locality {
 
@@ -17,8 +24,11 @@ namespace freud { namespace locality {
  * given neighborlist. Each filter will use information about the system to
  * determine which bonds need to be removed.
  *
- * After calling compute(), both the original Neighborlist and the new, filtered
- * neighborlist will be made available to users on the python side.
+ * After calling compute(), the new, filtered neighborlist will be made
+ * available to users on the python side. When the unfiltered bonds are found
+ * from query arguments, they are streamed through the filter one query point
+ * at a time and never stored, so the unfiltered neighborlist is only kept if
+ * one was passed to compute().
  * */
 class Filter
 {
@@ -39,12 +49,84 @@ public:
         return m_filtered_nlist;
     }
 
+    //! Get the unfiltered neighborlist, or nullptr if it was not passed to compute().
     std::shared_ptr<NeighborList> getUnfilteredNlist() const
     {
         return m_unfiltered_nlist;
     }
 
 protected:
+    //! Filter the neighbors of each query point and store the bonds that are kept.
+    /*! The candidate neighbors of each query point are passed to the filter
+     *  sorted by distance, either read from the given neighborlist or queried
+     *  directly from the NeighborQuery when no neighborlist is given. Only the
+     *  candidates of one query point per thread are held at any time, rather
+     *  than a sorted copy of all unfiltered bonds.
+     *
+     * \param filter_point Callable taking the query point index, its sorted
+     *                     candidate bonds, and a vector to append the kept
+     *                     bonds to, which returns whether the neighbor shell
+     *                     of the query point is filled.
+     * */
+    template<typename PointFilter>
+    void filterNeighbors(const NeighborQuery* nq, const vec3<float>* query_points,
+                         unsigned int num_query_points, const NeighborList* nlist, const QueryArgs& qargs,
+                         const PointFilter& filter_point)
+    {
+        if (nlist != nullptr)
+        {
+            m_unfiltered_nlist = std::make_shared<NeighborList>(*nlist);
+            m_unfiltered_nlist->validate(num_query_points, nq->getNPoints());
+        }
+        else
+        {
+            m_unfiltered_nlist = nullptr;
+        }
+
+        // hold the candidate bonds of the current query point and the kept bonds for each thread
+        using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
+        BondVector candidate_bonds;
+        BondVector filtered_bonds;
+
+        // hold index of query point for a thread if its neighbor shell isn't filled
+        std::vector<unsigned int> unfilled_qps(num_query_points, std::numeric_limits<unsigned int>::max());
+
+        loopOverNeighborsIterator(
+            nq, query_points, num_query_points, qargs, m_unfiltered_nlist.get(),
+            [&](size_t i, const std::shared_ptr<NeighborPerPointIterator>& ppiter) {
+                BondVector::reference local_candidates(candidate_bonds.local());
+                BondVector::reference local_bonds(filtered_bonds.local());
+
+                local_candidates.clear();
+                for (NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
+                {
+                    local_candidates.push_back(nb);
+                }
+                std::sort(local_candidates.begin(), local_candidates.end(), compareNeighborDistance);
+
+                if (!filter_point(i, local_candidates, local_bonds))
+                {
+                    // in principle, the incomplete shell exception can be raised here,
+                    // but the error is more informative if the exception raised
+                    // includes each query point with an unfilled neighbor shell
+                    unfilled_qps[i] = i;
+                }
+            });
+
+        // print warning/exception about query point indices with unfilled neighbor shells
+        warnAboutUnfilledNeighborShells(unfilled_qps);
+
+        // combine thread-local NeighborBond vectors into a single vector
+        tbb::flattened2d<BondVector> flat_filtered_bonds = tbb::flatten2d(filtered_bonds);
+        std::vector<NeighborBond> bonds(flat_filtered_bonds.begin(), flat_filtered_bonds.end());
+
+        // sort final bonds array by distance
+        util::executeInThreadArena(
+            [&]() { tbb::parallel_sort(bonds.begin(), bonds.end(), compareNeighborDistance); });
+
+        m_filtered_nlist = std::make_shared<NeighborList>(bonds);
+    }
+
     //!< The unfiltered neighborlist
     std::shared_ptr<NeighborList> m_unfiltered_nlist;
 
@@ -0,0 +1,96 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <memory>
+#include <tbb/task_group.h>
+#include <utility>
+
+#include "AABBQuery.h"
+#include "FramePipeline.h"
+#include "RawPoints.h"
+#include "utils.h"
+
+/*! \file FramePipeline.cc
+    \brief Accumulation of the frames of a trajectory with prefetching.
+*/
+
+namespace freud { namespace locality {
+
+namespace {
+//! A frame together with the NeighborQuery built on its points.
+struct PreparedFrame
+{
+    //! Read the next frame and build its NeighborQuery, returning false at the end of the trajectory.
+    bool read(const FrameReader& read_frame, bool build_tree)
+    {
+        neighbor_query.reset();
+        if (!read_frame(frame))
+        {
+            return false;
+        }
+        const auto n_points = static_cast<unsigned int>(frame.points.size());
+        if (build_tree)
+        {
+            neighbor_query = std::make_unique<AABBQuery>(frame.box, frame.points.data(), n_points);
+        }
+        else
+        {
+            neighbor_query = std::make_unique<RawPoints>(frame.box, frame.points.data(), n_points);
+        }
+        return true;
+    }
+
+    Frame frame;                                   //!< The box and points of the frame
+    std::unique_ptr<NeighborQuery> neighbor_query; //!< NeighborQuery of the points of the frame
+};
+} // namespace
+
+FrameReader makeFrameReader(FrameReadFunction read_function, void* source)
+{
+    return [read_function, source](Frame& frame) { return read_function(source, frame); };
+}
+
+unsigned int accumulateFrames(const FrameReader& read_frame, const FrameAccumulator& accumulate_frame,
+                              bool build_tree)
+{
+    // The reader runs on the threads of the arena of the caller, and must be
+    // waited for in that arena.
+    return util::executeInThreadArena([&]() {
+        // Two frames are kept alive: the one being accumulated and the one being
+        // read. The NeighborQuery objects point into the vectors of points of
+        // their frames, which are moved rather than reallocated by the swap.
+        PreparedFrame current;
+        PreparedFrame next;
+        unsigned int n_frames = 0;
+        bool has_current = current.read(read_frame, build_tree);
+        while (has_current)
+        {
+            bool has_next = false;
+            tbb::task_group prefetch;
+            prefetch.run([&]() { has_next = next.read(read_frame, build_tree); });
+            try
+            {
+                accumulate_frame(current.neighbor_query.get());
+            }
+            catch (...)
+            {
+                // The reader must finish before its frame goes out of scope. Its
+                // own errors are superseded by the error of the accumulation.
+                try
+                {
+                    prefetch.wait();
+                }
+                catch (...)
+                {}
+                throw;
+            }
+            prefetch.wait();
+            ++n_frames;
+            std::swap(current, next);
+            has_current = has_next;
+        }
+        return n_frames;
+    });
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,64 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef FRAME_PIPELINE_H
+#define FRAME_PIPELINE_H
+
+#include <functional>
+#include <vector>
+
+#include "Box.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file FramePipeline.h
+    \brief Accumulation of the frames of a trajectory with prefetching.
+*/
+
+namespace freud { namespace locality {
+
+//! The box and points of one frame of a trajectory.
+struct Frame
+{
+    //! Set the box and copy the points of the frame.
+    void assign(const box::Box& frame_box, const vec3<float>* frame_points, unsigned int n_points)
+    {
+        box = frame_box;
+        points.assign(frame_points, frame_points + n_points);
+    }
+
+    box::Box box;                    //!< Simulation box of the frame
+    std::vector<vec3<float>> points; //!< Point positions of the frame
+};
+
+//! Callable reading the next frame of a trajectory into its argument, returning false at the end.
+using FrameReader = std::function<bool(Frame&)>;
+
+//! Function reading the next frame of an opaque source, used to wrap readers implemented in Python.
+using FrameReadFunction = bool (*)(void*, Frame&);
+
+//! Make a FrameReader that calls read_function with source.
+FrameReader makeFrameReader(FrameReadFunction read_function, void* source);
+
+//! Callable accumulating a frame given a NeighborQuery of its points.
+using FrameAccumulator = std::function<void(const NeighborQuery*)>;
+
+//! Accumulate all frames of a reader, reading each frame while the previous one is accumulated.
+/*! The frames are accumulated in order. While accumulate_frame runs on a
+ *  frame, the next frame is read and its NeighborQuery is built in a separate
+ *  task, so the cost of reading and converting frames is hidden behind the
+ *  accumulation and all frames are processed in a single call.
+ *
+ *  \param read_frame Reader of the frames.
+ *  \param accumulate_frame Function accumulating a single frame.
+ *  \param build_tree If true, the NeighborQuery of each frame is an AABBQuery
+ *         whose tree is built during prefetching. Otherwise it is a RawPoints
+ *         object, for computes that do not query neighbors.
+ *  \return The number of frames accumulated.
+ */
+unsigned int accumulateFrames(const FrameReader& read_frame, const FrameAccumulator& accumulate_frame,
+                              bool build_tree);
+
+}; }; // end namespace freud::locality
+
+#endif // FRAME_PIPELINE_H
@@ -2,8 +2,13 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstdint>
 #include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+#include <utility>
+#include <vector>
 
 #include "LinkCell.h"
 
@@ -13,6 +18,83 @@
 
 namespace freud { namespace locality {
 
+namespace {
+//! Number of bits of the cell index sorted per radix sort pass.
+constexpr unsigned int CELL_SORT_RADIX_BITS = 8;
+//! Number of distinct digits in each radix sort pass.
+constexpr unsigned int CELL_SORT_RADIX = 1U << CELL_SORT_RADIX_BITS;
+//! Number of keys per independently counted block of a radix sort pass.
+constexpr size_t CELL_SORT_BLOCK_SIZE = size_t(1) << 16;
+
+//! Sort keys holding a cell index in their upper 32 bits, preserving the order of keys in the same cell.
+/*! This is a least significant digit radix sort in which each pass counts
+ *  the digits of fixed blocks of keys in parallel and then scatters every
+ *  block to its precomputed output offsets in parallel. Only as many passes
+ *  as there are significant digits in the largest cell index are performed.
+ *
+ *  \param keys The keys to sort.
+ *  \param num_cells The number of cells.
+ */
+void sortByCell(std::vector<uint64_t>& keys, unsigned int num_cells)
+{
+    const size_t num_keys = keys.size();
+    const size_t num_blocks = (num_keys + CELL_SORT_BLOCK_SIZE - 1) / CELL_SORT_BLOCK_SIZE;
+    std::vector<uint64_t> sorted_keys(num_keys);
+    std::vector<size_t> offsets(num_blocks * CELL_SORT_RADIX);
+
+    for (unsigned int shift = 32; shift < 64 && ((uint64_t(num_cells) - 1) << 32) >> shift != 0;
+         shift += CELL_SORT_RADIX_BITS)
+    {
+        const auto digit = [shift](uint64_t key) { return (key >> shift) & (CELL_SORT_RADIX - 1); };
+
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
+            {
+                size_t* const counts = &offsets[block * CELL_SORT_RADIX];
+                std::fill(counts, counts + CELL_SORT_RADIX, 0);
+                const size_t block_end = std::min(num_keys, (block + 1) * CELL_SORT_BLOCK_SIZE);
+                for (size_t k = block * CELL_SORT_BLOCK_SIZE; k < block_end; ++k)
+                {
+                    ++counts[digit(keys[k])];
+                }
+            }
+        });
+
+        // Keys with smaller digits come first, and keys with equal digits
+        // keep the order of their blocks.
+        size_t offset = 0;
+        for (unsigned int d = 0; d < CELL_SORT_RADIX; ++d)
+        {
+            for (size_t block = 0; block < num_blocks; ++block)
+            {
+                const size_t count = offsets[block * CELL_SORT_RADIX + d];
+                offsets[block * CELL_SORT_RADIX + d] = offset;
+                offset += count;
+            }
+        }
+
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
+            {
+                size_t* const block_offsets = &offsets[block * CELL_SORT_RADIX];
+                const size_t block_end = std::min(num_keys, (block + 1) * CELL_SORT_BLOCK_SIZE);
+                for (size_t k = block * CELL_SORT_BLOCK_SIZE; k < block_end; ++k)
+                {
+                    sorted_keys[block_offsets[digit(keys[k])]++] = keys[k];
+                }
+            }
+        });
+        keys.swap(sorted_keys);
+    }
+}
+} // namespace
+
+void computeDistancesSquared(const box::Box& box, const vec3<float>& query_point, CellDistanceBuffer& buffer)
+{
+    box::dispatchBoxKernel(
+        box, [&](const auto& kernel) { computeDistancesSquared(kernel, query_point, buffer); });
+}
+
 /********************
  * IteratorLinkCell *
  ********************/
@@ -211,30 +293,28 @@ void IteratorCellShell::reset(unsigned int range)
 // Default constructor
 LinkCell::LinkCell() : NeighborQuery() {}
 
-LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width)
+LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width,
+                   bool spatial_sort)
     : NeighborQuery(box, points, n_points), m_cell_width(cell_width)
 {
-    // If no cell width is provided, we calculate the system density and
-    // estimate the number of cells that would lead to 10 particles per cell.
-    // Want n_points/num_cells = 10
+    const vec3<float> nearest_plane_distance = box.getNearestPlaneDistance();
     if (cell_width == 0)
     {
-        // This number is arbitrary because there is no way to determine an
-        // appropriate cell density for an arbitrary triclinic box.
-        const unsigned int num_particle_per_cell = 10;
-        const unsigned int desired_num_cells
-            = std::max(n_points / num_particle_per_cell, static_cast<unsigned int>(1));
-        m_cell_width = std::cbrtf(box.getVolume() / static_cast<float>(desired_num_cells));
+        // If no cell width is provided, the number of cells along each
+        // dimension is chosen from the point density and the box shape.
+        m_celldim = computeDimensions(box, n_points, LINK_CELL_TARGET_OCCUPANCY);
     }
-
-    m_celldim = computeDimensions(box, m_cell_width);
-
-    // Check if box is too small!
-    vec3<float> nearest_plane_distance = box.getNearestPlaneDistance();
-    if ((m_cell_width * 2.0 > nearest_plane_distance.x) || (m_cell_width * 2.0 > nearest_plane_distance.y)
-        || (!box.is2D() && m_cell_width * 2.0 > nearest_plane_distance.z))
+    else
     {
-        throw std::runtime_error("Cannot generate a cell list where cell_width is larger than half the box.");
+        m_celldim = computeDimensions(box, m_cell_width);
+
+        // Check if box is too small!
+        if ((m_cell_width * 2.0 > nearest_plane_distance.x) || (m_cell_width * 2.0 > nearest_plane_distance.y)
+            || (!box.is2D() && m_cell_width * 2.0 > nearest_plane_distance.z))
+        {
+            throw std::runtime_error(
+                "Cannot generate a cell list where cell_width is larger than half the box.");
+        }
     }
     // Only 1 cell deep in 2D
     if (box.is2D())
@@ -242,13 +322,31 @@ LinkCell::LinkCell(const box::Box& box, const vec3<float>* points, unsigned int
         m_celldim.z = 1;
     }
 
+    // The cells are at least m_cell_width wide, but may be wider along some
+    // dimensions. Searches use the actual widths to bound shell distances.
+    m_cell_widths = vec3<float>(nearest_plane_distance.x / static_cast<float>(m_celldim.x),
+                                nearest_plane_distance.y / static_cast<float>(m_celldim.y),
+                                nearest_plane_distance.z / static_cast<float>(m_celldim.z));
+    if (cell_width == 0)
+    {
+        m_cell_width = std::min(m_cell_widths.x, m_cell_widths.y);
+        if (!box.is2D())
+        {
+            m_cell_width = std::min(m_cell_width, m_cell_widths.z);
+        }
+    }
+
     m_size = m_celldim.x * m_celldim.y * m_celldim.z;
     if (m_size < 1)
     {
         throw std::runtime_error("At least one cell must be present.");
     }
 
-    computeCellList(points, n_points);
+    if (spatial_sort)
+    {
+        sortPoints();
+    }
+    computeCellList(m_search_points, n_points);
 }
 
 unsigned int LinkCell::getCellIndex(const vec3<int> cellCoord) const
@@ -305,25 +403,136 @@ vec3<unsigned int> LinkCell::computeDimensions(const box::Box& box, float cell_w
     return dim;
 }
 
+vec3<unsigned int> LinkCell::computeDimensions(const box::Box& box, unsigned int n_points,
+                                               unsigned int occupancy)
+{
+    // Cubic cells of this width would hold the target number of points on
+    // average. This number is arbitrary because there is no way to determine
+    // an appropriate cell density for an arbitrary triclinic box.
+    const float desired_num_cells
+        = std::max(static_cast<float>(n_points) / static_cast<float>(occupancy), float(1.0));
+    const float cell_size = box.getVolume() / desired_num_cells;
+    const float cell_width = box.is2D() ? std::sqrt(cell_size) : std::cbrt(cell_size);
+
+    // Each dimension is split into cells no narrower than the cubic width,
+    // so dimensions thinner than a cell have a single layer of cells.
+    return computeDimensions(box, cell_width);
+}
+
 void LinkCell::computeCellList(const vec3<float>* points, unsigned int n_points)
 {
     // determine the number of cells and allocate memory
     unsigned int Nc = getNumCells();
     m_cell_list.prepare(n_points + Nc);
+    m_point_cells.prepare(n_points);
     m_n_points = n_points;
 
-    // initialize memory
-    for (unsigned int cell = 0; cell < Nc; cell++)
+    // Each cell is linked in order of increasing point index. Rather than
+    // inserting points into the lists one at a time, the points are sorted
+    // by cell (stably, so that points in a cell remain ordered by index),
+    // after which the successor of every point and the head of every cell can
+    // be found independently. Every step is parallel and streams through
+    // memory instead of chasing the head of a random cell for each point.
+    std::vector<uint64_t> keys(n_points);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        getCells(points + begin, end - begin, m_point_cells.get() + begin);
+        for (size_t i = begin; i < end; ++i)
+        {
+            keys[i] = (uint64_t(m_point_cells[i]) << 32) | i;
+        }
+    });
+    sortByCell(keys, Nc);
+
+    util::forLoopWrapper(0, Nc, [&](size_t begin, size_t end) {
+        std::fill(m_cell_list.get() + n_points + begin, m_cell_list.get() + n_points + end,
+                  LINK_CELL_TERMINATOR);
+    });
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k)
+        {
+            const auto cell = static_cast<unsigned int>(keys[k] >> 32);
+            const auto i = static_cast<unsigned int>(keys[k]);
+            if (k == 0 || (keys[k - 1] >> 32) != cell)
+            {
+                m_cell_list[n_points + cell] = i;
+            }
+            m_cell_list[i] = (k + 1 < n_points && (keys[k + 1] >> 32) == cell)
+                ? static_cast<unsigned int>(keys[k + 1])
+                : LINK_CELL_TERMINATOR;
+        }
+    });
+}
+
+void LinkCell::updateCellList(const vec3<float>* points, unsigned int n_points)
+{
+    if (n_points != m_n_points)
+    {
+        throw std::invalid_argument("LinkCell can only be updated with the same number of points.");
+    }
+    validatePoints(points, n_points);
+    m_points = points;
+    // Spatially sorted points keep their original ordering, which remains a
+    // good approximation of a spatial sort for small displacements.
+    updateSortedPoints();
+    points = m_search_points;
+
+    // Find the points that have moved to a different cell. The box (and
+    // therefore the cell dimensions and cached cell neighbors) is unchanged,
+    // so only these points need to be relinked.
+    using MovedPoints = tbb::enumerable_thread_specific<std::vector<std::pair<unsigned int, unsigned int>>>;
+    MovedPoints moved_points;
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        MovedPoints::reference local_moved_points(moved_points.local());
+        std::array<unsigned int, box::Box::BATCH_SIZE> cells;
+        for (size_t batch = begin; batch < end; batch += cells.size())
+        {
+            const size_t batch_size = std::min(cells.size(), end - batch);
+            getCells(points + batch, batch_size, cells.data());
+            for (size_t i = batch; i < batch + batch_size; ++i)
+            {
+                if (cells[i - batch] != m_point_cells[i])
+                {
+                    local_moved_points.emplace_back(i, cells[i - batch]);
+                }
+            }
+        }
+    });
+
+    tbb::flattened2d<MovedPoints> flat_moved_points = tbb::flatten2d(moved_points);
+    std::vector<std::pair<unsigned int, unsigned int>> linear_moved_points(flat_moved_points.begin(),
+                                                                           flat_moved_points.end());
+
+    // Relinking costs a walk over the occupants of two cells per moved point,
+    // so past some fraction of moved points a full rebuild is cheaper.
+    if (linear_moved_points.size() > n_points / LINK_CELL_UPDATE_REBUILD_FRACTION)
     {
-        m_cell_list[n_points + cell] = LINK_CELL_TERMINATOR;
+        computeCellList(points, n_points);
+        return;
     }
 
-    // Generate the cell list.
-    for (unsigned int i = n_points - 1; i != static_cast<unsigned int>(-1); --i)
+    for (const auto& moved_point : linear_moved_points)
     {
-        unsigned int cell = getCell(points[i]);
-        m_cell_list[i] = m_cell_list[n_points + cell];
-        m_cell_list[n_points + cell] = i;
+        const unsigned int i = moved_point.first;
+        const unsigned int new_cell = moved_point.second;
+
+        // Unlink the point from its old cell.
+        unsigned int prev = n_points + m_point_cells[i];
+        while (m_cell_list[prev] != i)
+        {
+            prev = m_cell_list[prev];
+        }
+        m_cell_list[prev] = m_cell_list[i];
+
+        // Link the point into its new cell, preserving the ascending order of
+        // point indices within each cell that a full rebuild generates.
+        prev = n_points + new_cell;
+        while (m_cell_list[prev] != LINK_CELL_TERMINATOR && m_cell_list[prev] < i)
+        {
+            prev = m_cell_list[prev];
+        }
+        m_cell_list[i] = m_cell_list[prev];
+        m_cell_list[prev] = i;
+        m_point_cells[i] = new_cell;
     }
 }
 
@@ -349,7 +558,11 @@ unsigned int LinkCell::coordToIndex(unsigned int x, unsigned int y, unsigned int
 
 vec3<unsigned int> LinkCell::getCellCoord(const vec3<float>& p) const
 {
-    vec3<float> alpha = m_box.makeFractional(p);
+    return getFractionalCellCoord(m_box.makeFractional(p));
+}
+
+vec3<unsigned int> LinkCell::getFractionalCellCoord(const vec3<float>& alpha) const
+{
     vec3<unsigned int> c;
     c.x = (unsigned int) std::floor(alpha.x * float(m_celldim.x));
     c.x %= m_celldim.x;
@@ -360,6 +573,21 @@ vec3<unsigned int> LinkCell::getCellCoord(const vec3<float>& p) const
     return c;
 }
 
+void LinkCell::getCells(const vec3<float>* points, size_t n, unsigned int* cells) const
+{
+    std::array<vec3<float>, box::Box::BATCH_SIZE> alphas;
+    for (size_t batch = 0; batch < n; batch += alphas.size())
+    {
+        const size_t batch_size = std::min(alphas.size(), n - batch);
+        m_box.makeFractionalBatch(points + batch, batch_size, alphas.data());
+        for (size_t k = 0; k < batch_size; ++k)
+        {
+            const vec3<unsigned int> c = getFractionalCellCoord(alphas[k]);
+            cells[batch + k] = coordToIndex(c.x, c.y, c.z);
+        }
+    }
+}
+
 const std::vector<unsigned int>& LinkCell::getCellNeighbors(unsigned int cell) const
 {
     // check if the list of neighbors has been already computed
@@ -477,7 +705,7 @@ LinkCell::querySingle(const vec3<float> query_point, unsigned int query_point_id
     if (args.mode == QueryType::ball)
     {
         return std::make_shared<LinkCellQueryBallIterator>(this, query_point, query_point_idx, args.r_max,
-                                                           args.r_min, args.exclude_ii);
+                                                           args.r_min, args.exclude_ii, args.half_list);
     }
     if (args.mode == QueryType::nearest)
     {
@@ -487,11 +715,45 @@ LinkCell::querySingle(const vec3<float> query_point, unsigned int query_point_id
     throw std::runtime_error("Invalid query mode provided to generic query function.");
 }
 
-NeighborBond LinkCellQueryBallIterator::next()
+void LinkCellQueryBallIterator::searchCurrentCell()
 {
-    float r_max_sq = m_r_max * m_r_max;
-    float r_min_sq = m_r_min * m_r_min;
+    thread_local CellDistanceBuffer buffer;
+
+    // Gather the positions of the cell's points into contiguous arrays so
+    // that the distances can be evaluated for the whole cell at once.
+    buffer.clear();
+    const vec3<float>* search_points = m_linkcell->getSearchPoints();
+    for (unsigned int j = m_cell_iter.next(); !m_cell_iter.atEnd(); j = m_cell_iter.next())
+    {
+        buffer.push_back(j, search_points[j]);
+    }
+    computeDistancesSquared(m_neighbor_query->getBox(), m_query_point, buffer);
+
+    const float r_max_sq = m_r_max * m_r_max;
+    const float r_min_sq = m_r_min * m_r_min;
+    m_cell_bonds.clear();
+    m_cell_bond_index = 0;
+    for (size_t k = 0; k < buffer.size(); ++k)
+    {
+        const unsigned int point_idx = m_linkcell->getPointIndex(buffer.indices[k]);
+
+        // Skip excluded matches immediately if requested.
+        if (isExcluded(point_idx))
+        {
+            continue;
+        }
 
+        const float r_sq = buffer.r_sq[k];
+        if (r_sq < r_max_sq && r_sq >= r_min_sq)
+        {
+            m_cell_bonds.emplace_back(m_query_point_idx, point_idx, std::sqrt(r_sq));
+        }
+    }
+    m_cell_searched = true;
+}
+
+NeighborBond LinkCellQueryBallIterator::next()
+{
     vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
     const unsigned int point_cell_index = m_linkcell->getCellIndex(
         vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
@@ -500,24 +762,15 @@ NeighborBond LinkCellQueryBallIterator::next()
     // Loop over cell list neighbor shells relative to this point's cell.
     while (true)
     {
-        // Iterate over the particles in that cell. Using a local counter
-        // variable is safe, because the IteratorLinkCell object is keeping
-        // track between calls to next.
-        for (unsigned int j = m_cell_iter.next(); !m_cell_iter.atEnd(); j = m_cell_iter.next())
+        // Evaluate the current cell in one pass, then return its bonds one
+        // at a time across calls to next.
+        if (!m_cell_searched)
         {
-            // Skip ii matches immediately if requested.
-            if (m_exclude_ii && m_query_point_idx == j)
-            {
-                continue;
-            }
-
-            const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
-            const float r_sq(dot(r_ij, r_ij));
-
-            if (r_sq < r_max_sq && r_sq >= r_min_sq)
-            {
-                return NeighborBond(m_query_point_idx, j, std::sqrt(r_sq));
-            }
+            searchCurrentCell();
+        }
+        if (m_cell_bond_index < m_cell_bonds.size())
+        {
+            return m_cell_bonds[m_cell_bond_index++];
         }
 
         bool out_of_range = false;
@@ -526,12 +779,10 @@ NeighborBond LinkCellQueryBallIterator::next()
         {
             // Determine the next neighbor cell to consider. We're done if we
             // reach a new shell and the closest point of approach to the new
-            // shell is greater than our r_max.
+            // shell is at least our r_max.
             ++m_neigh_cell_iter;
 
-            if (static_cast<float>(m_neigh_cell_iter.getRange() - m_extra_search_width)
-                    * m_linkcell->getCellWidth()
-                > m_r_max)
+            if (m_linkcell->getShellDistance(m_neigh_cell_iter.getRange()) >= m_r_max)
             {
                 out_of_range = true;
                 break;
@@ -548,6 +799,7 @@ NeighborBond LinkCellQueryBallIterator::next()
                 // over its contents. Otherwise, we loop back, increment
                 // the cell shell iterator, and try the next one.
                 m_cell_iter = m_linkcell->itercell(neighbor_cell_index);
+                m_cell_searched = false;
                 break;
             }
         }
@@ -566,15 +818,6 @@ NeighborBond LinkCellQueryIterator::next()
     float r_max_sq = m_r_max * m_r_max;
     float r_min_sq = m_r_min * m_r_min;
 
-    vec3<float> plane_distance = m_neighbor_query->getBox().getNearestPlaneDistance();
-    float min_plane_distance = std::min(plane_distance.x, plane_distance.y);
-    if (!m_neighbor_query->getBox().is2D())
-    {
-        min_plane_distance = std::min(min_plane_distance, plane_distance.z);
-    }
-    unsigned int max_range
-        = static_cast<unsigned int>(std::ceil(min_plane_distance / (2 * m_linkcell->getCellWidth()))) + 1;
-
     vec3<unsigned int> point_cell(m_linkcell->getCellCoord(m_query_point));
     const unsigned int point_cell_index = m_linkcell->getCellIndex(
         vec3<int>(point_cell.x, point_cell.y, point_cell.z) + (*m_neigh_cell_iter));
@@ -584,7 +827,8 @@ NeighborBond LinkCellQueryIterator::next()
     if (m_current_neighbors.empty())
     {
         // Expand search cell radius until termination conditions are met.
-        while (m_neigh_cell_iter != IteratorCellShell(max_range, m_neighbor_query->getBox().is2D()))
+        bool searched_all_cells = false;
+        while (!searched_all_cells)
         {
             // Iterate over the particles in that cell. Using a local counter
             // variable is safe, because the IteratorLinkCell object is keeping
@@ -595,16 +839,19 @@ NeighborBond LinkCellQueryIterator::next()
             {
                 for (unsigned int j = m_cell_iter.next(); !m_cell_iter.atEnd(); j = m_cell_iter.next())
                 {
+                    const unsigned int point_idx = m_linkcell->getPointIndex(j);
+
                     // Skip ii matches immediately if requested.
-                    if (m_exclude_ii && m_query_point_idx == j)
+                    if (m_exclude_ii && m_query_point_idx == point_idx)
                     {
                         continue;
                     }
-                    const vec3<float> r_ij(m_neighbor_query->getBox().wrap((*m_linkcell)[j] - m_query_point));
+                    const vec3<float> r_ij(
+                        m_neighbor_query->getBox().wrap(m_linkcell->getSearchPoints()[j] - m_query_point));
                     const float r_sq(dot(r_ij, r_ij));
                     if (r_sq < r_max_sq && r_sq >= r_min_sq)
                     {
-                        m_current_neighbors.emplace_back(m_query_point_idx, j, std::sqrt(r_sq));
+                        m_nearest.push(NeighborBond(m_query_point_idx, point_idx, std::sqrt(r_sq)));
                     }
                 }
             }
@@ -613,8 +860,11 @@ NeighborBond LinkCellQueryIterator::next()
             {
                 ++m_neigh_cell_iter;
 
-                if (m_neigh_cell_iter == IteratorCellShell(max_range, m_neighbor_query->getBox().is2D()))
+                // Every cell that may hold a neighbor has been searched once
+                // no new cell of the shell is within r_max.
+                if (m_linkcell->getShellDistance(m_neigh_cell_iter.getRange()) >= m_r_max)
                 {
+                    searched_all_cells = true;
                     break;
                 }
 
@@ -637,14 +887,14 @@ NeighborBond LinkCellQueryIterator::next()
             // We can terminate early if we determine when we reach a shell
             // such that we already have k neighbors closer than the
             // closest possible neighbor in the new shell.
-            std::sort(m_current_neighbors.begin(), m_current_neighbors.end());
-            if ((m_current_neighbors.size() >= m_num_neighbors)
-                && (m_current_neighbors[m_num_neighbors - 1].distance
-                    < static_cast<float>(m_neigh_cell_iter.getRange() - 1) * m_linkcell->getCellWidth()))
+            if (m_nearest.full()
+                && (m_nearest.farthest().distance
+                    < m_linkcell->getShellDistance(m_neigh_cell_iter.getRange())))
             {
                 break;
             }
         }
+        m_current_neighbors.swap(m_nearest.sort());
     }
 
     while ((m_count < m_num_neighbors) && (m_count < m_current_neighbors.size()))
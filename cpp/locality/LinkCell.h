@@ -4,12 +4,17 @@
 #ifndef LINKCELL_H
 #define LINKCELL_H
 
+#include <cmath>
+#include <limits>
 #include <memory>
+#include <stdexcept>
 #include <tbb/concurrent_hash_map.h>
 #include <unordered_set>
 #include <vector>
 
 #include "Box.h"
+#include "BoxKernel.h"
+#include "NeighborHeap.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
 
@@ -24,6 +29,17 @@ namespace freud { namespace locality {
 */
 const unsigned int LINK_CELL_TERMINATOR = 0xffffffff;
 
+/*! \internal
+    \brief Incremental cell list updates fall back to a full rebuild when more
+    than 1/LINK_CELL_UPDATE_REBUILD_FRACTION of the points change cells.
+*/
+const unsigned int LINK_CELL_UPDATE_REBUILD_FRACTION = 8;
+
+/*! \internal
+    \brief Average number of points per cell targeted when no cell width is given.
+*/
+const unsigned int LINK_CELL_TARGET_OCCUPANCY = 10;
+
 //! Iterates over particles in a link cell list generated by LinkCell
 /*! The link-cell structure is not trivial to iterate over. This helper class
  *  makes that easier both in C++ and provides a Python compatible interface
@@ -147,6 +163,113 @@ private:
     bool m_is2D;     //!< true if the cell list is 2D
 };
 
+//! Scratch storage holding the points of one cell in structure-of-arrays form.
+struct CellDistanceBuffer
+{
+    void clear()
+    {
+        indices.clear();
+        x.clear();
+        y.clear();
+        z.clear();
+    }
+
+    void push_back(unsigned int index, const vec3<float>& point)
+    {
+        indices.push_back(index);
+        x.push_back(point.x);
+        y.push_back(point.y);
+        z.push_back(point.z);
+    }
+
+    size_t size() const
+    {
+        return indices.size();
+    }
+
+    std::vector<unsigned int> indices; //!< Indices of the points in the search points array.
+    std::vector<float> x;              //!< x components, replaced by the fractional x components.
+    std::vector<float> y;              //!< y components, replaced by the fractional y components.
+    std::vector<float> z;              //!< z components, replaced by the fractional z components.
+    std::vector<float> r_sq;           //!< Squared minimum image distances to the query point.
+};
+
+//! Compute the squared minimum image distances from a query point to all points in a buffer.
+/*! This evaluates the same arithmetic as Box::wrap, but as a sequence of
+ *  simple loops over the buffer's component arrays that are amenable to
+ *  auto-vectorization.
+ *
+ *  \param kernel The box::BoxKernel of the box.
+ *  \param query_point The query point.
+ *  \param buffer The points, replaced by their fractional separations, and their distances.
+ */
+template<typename Kernel>
+void computeDistancesSquared(const Kernel& kernel, const vec3<float>& query_point, CellDistanceBuffer& buffer)
+{
+    const size_t n = buffer.size();
+    buffer.r_sq.resize(n);
+    float* const x = buffer.x.data();
+    float* const y = buffer.y.data();
+    float* const z = buffer.z.data();
+    float* const r_sq = buffer.r_sq.data();
+
+    if (kernel.isAperiodic())
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+            const float dx = x[k] - query_point.x;
+            const float dy = y[k] - query_point.y;
+            const float dz = z[k] - query_point.z;
+            r_sq[k] = dx * dx + dy * dy + dz * dz;
+        }
+        return;
+    }
+
+    // Convert the separation vectors into fractional coordinates.
+    for (size_t k = 0; k < n; ++k)
+    {
+        const vec3<float> f = kernel.makeFractional(vec3<float>(x[k], y[k], z[k]) - query_point);
+        x[k] = f.x;
+        y[k] = f.y;
+        z[k] = f.z;
+    }
+
+    if (kernel.isPeriodicX())
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+            x[k] = Kernel::wrapFractional(x[k]);
+        }
+    }
+    if (kernel.isPeriodicY())
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+            y[k] = Kernel::wrapFractional(y[k]);
+        }
+    }
+    if (kernel.isPeriodicZ())
+    {
+        for (size_t k = 0; k < n; ++k)
+        {
+            z[k] = Kernel::wrapFractional(z[k]);
+        }
+    }
+
+    // Convert back to absolute coordinates and take the squared norm.
+    for (size_t k = 0; k < n; ++k)
+    {
+        const vec3<float> v = kernel.makeAbsolute(vec3<float>(x[k], y[k], z[k]));
+        r_sq[k] = v.x * v.x + v.y * v.y + v.z * v.z;
+    }
+}
+
+//! Compute the squared minimum image distances from a query point to all points in a buffer.
+/*! This selects the kernel of the box on every call, so loops over many
+ *  cells should select it once and call the overload above.
+ */
+void computeDistancesSquared(const box::Box& box, const vec3<float>& query_point, CellDistanceBuffer& buffer);
+
 //! Computes a cell id for each particle and a link cell data structure for iterating through it
 /*! For simplicity in only needing a small number of arrays, the link cell
  *  algorithm is used to generate and store the cell list data for particles.
@@ -157,6 +280,15 @@ private:
  *  each dimension is stored in an Index3D which is also used to compute the
  *  cell index from (i,j,k).
 
+ *  If no cell width is given, the number of cells along each dimension is
+ *  chosen independently from the distance between the box planes, so that
+ *  cells are close to cubic and hold about LINK_CELL_TARGET_OCCUPANCY points
+ *  on average. Dimensions of the box that are thinner than such a cell, e.g.
+ *  the thickness of a film, are covered by a single layer of cells. Searches
+ *  bound the distance to each shell of cells with the actual width of the
+ *  cells along each dimension, so anisotropic cells are never searched
+ *  further than necessary.
+
  *  The cell coordinate (i,j,k) itself is computed like so:
  *  \code
  *  i = std::floor((x + Lx/2) / w) % Nw
@@ -182,11 +314,23 @@ public:
     LinkCell();
 
     //! Constructor
-    LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width = 0);
+    /*! \param box The simulation box.
+     *  \param points The point coordinates.
+     *  \param n_points The number of points.
+     *  \param cell_width The cell width, or 0 to size the cells along each dimension from the box
+     *                    shape and the point density.
+     *  \param spatial_sort If true, bin a copy of the points reordered along a Morton curve.
+     */
+    LinkCell(const box::Box& box, const vec3<float>* points, unsigned int n_points, float cell_width = 0,
+             bool spatial_sort = false);
 
     //! Compute LinkCell dimensions
     static vec3<unsigned int> computeDimensions(const box::Box& box, float cell_width);
 
+    //! Compute LinkCell dimensions holding a target number of points per cell on average
+    static vec3<unsigned int> computeDimensions(const box::Box& box, unsigned int n_points,
+                                                unsigned int occupancy);
+
     //! Compute cell id from cell coordinates
     unsigned int getCellIndex(const vec3<int> cellCoord) const;
 
@@ -202,6 +346,57 @@ public:
         return m_cell_width;
     }
 
+    //! Get the number of cells along each dimension
+    vec3<unsigned int> getCellDimensions() const
+    {
+        return m_celldim;
+    }
+
+    //! Get the width of the cells along each dimension, measured between the box planes
+    vec3<float> getCellWidths() const
+    {
+        return m_cell_widths;
+    }
+
+    //! Whether the cells form a single layer, so that shells of cells only extend in the plane
+    bool isSingleLayer() const
+    {
+        return m_celldim.z == 1;
+    }
+
+    //! Get a lower bound on the distance from a point to the new cells of a shell.
+    /*! A cell at an offset of \a range cells along some dimension is at
+     *  least range - 1 cell widths away from any point of the central cell.
+     *  Offsets along a dimension with fewer than 2 * range cells wrap onto
+     *  cells of smaller shells, so only the other dimensions bound the
+     *  distance to the new cells of the shell.
+     *
+     *  \param range The range of the shell.
+     *  \returns The lower bound, or infinity if all cells of the shell are in smaller shells.
+     */
+    float getShellDistance(int range) const
+    {
+        if (range == 0)
+        {
+            return 0;
+        }
+        float min_width = std::numeric_limits<float>::infinity();
+        const unsigned int min_cells = 2 * static_cast<unsigned int>(range);
+        if (m_celldim.x >= min_cells)
+        {
+            min_width = std::min(min_width, m_cell_widths.x);
+        }
+        if (m_celldim.y >= min_cells)
+        {
+            min_width = std::min(min_width, m_cell_widths.y);
+        }
+        if (m_celldim.z >= min_cells)
+        {
+            min_width = std::min(min_width, m_cell_widths.z);
+        }
+        return static_cast<float>(range - 1) * min_width;
+    }
+
     //! Compute the cell id for a given position
     unsigned int getCell(const vec3<float>& p) const
     {
@@ -218,6 +413,12 @@ public:
     //! Compute cell coordinates for a given position
     vec3<unsigned int> getCellCoord(const vec3<float>& p) const;
 
+    //! Compute cell coordinates for a given position in fractional coordinates of the box
+    vec3<unsigned int> getFractionalCellCoord(const vec3<float>& alpha) const;
+
+    //! Compute the cell ids of n points, converting them to fractional coordinates in batches
+    void getCells(const vec3<float>* points, size_t n, unsigned int* cells) const;
+
     //! Iterate over particles in a cell
     IteratorLinkCell itercell(unsigned int cell) const
     {
@@ -230,6 +431,9 @@ public:
     //! Compute the cell list
     void computeCellList(const vec3<float>* points, unsigned int n_points);
 
+    //! Update the cell list for new positions of the same points in the same box
+    void updateCellList(const vec3<float>* points, unsigned int n_points);
+
     //! Implementation of per-particle query for LinkCell (see NeighborQuery.h for documentation).
     /*! \param query_point The point to find neighbors for.
      *  \param n_query_points The number of query points.
@@ -238,15 +442,217 @@ public:
     std::shared_ptr<NeighborQueryPerPointIterator>
     querySingle(const vec3<float> query_point, unsigned int query_point_idx, QueryArgs args) const override;
 
+    //! Find the neighbors of a range of query points within a ball and pass each bond to a callback.
+    /*! This performs the same search as LinkCellQueryBallIterator, but
+     *  without creating an iterator object per query point and without a
+     *  virtual call per bond. The arguments are assumed to have already been
+     *  validated, e.g. by a call to query.
+     *
+     *  \param query_points The points to find neighbors for.
+     *  \param begin The first position in the range of query points.
+     *  \param end One past the last position in the range of query points.
+     *  \param order If not null, position k in the range refers to query point order[k].
+     *  \param qargs The validated query arguments of a ball query.
+     *  \param cb An object with operator(const NeighborBond&).
+     */
+    template<typename Callback>
+    void forEachBallNeighbor(const vec3<float>* query_points, size_t begin, size_t end,
+                             const unsigned int* order, const QueryArgs& qargs, const Callback& cb) const
+    {
+        box::dispatchBoxKernel(m_box, [&](const auto& kernel) {
+            forEachBallNeighbor(kernel, query_points, begin, end, order, qargs, cb);
+        });
+    }
+
+    //! Find the nearest neighbors of a range of query points and pass each bond to a callback.
+    /*! This finds the same neighbors as LinkCellQueryIterator, and passes the
+     *  bonds of each query point in order of increasing distance. Shells of
+     *  cells are searched outwards until the num_neighbors nearest candidates
+     *  found are all closer than the next shell. Candidates are kept in a
+     *  bounded heap, and cells are marked as searched in a per-thread array
+     *  rather than a hash set. The arguments are assumed to have already been
+     *  validated, e.g. by a call to query.
+     *
+     *  \param query_points The points to find neighbors for.
+     *  \param begin The first position in the range of query points.
+     *  \param end One past the last position in the range of query points.
+     *  \param order If not null, position k in the range refers to query point order[k].
+     *  \param qargs The validated query arguments of a nearest neighbor query.
+     *  \param cb An object with operator(const NeighborBond&).
+     */
+    template<typename Callback>
+    void forEachNearestNeighbor(const vec3<float>* query_points, size_t begin, size_t end,
+                                const unsigned int* order, const QueryArgs& qargs, const Callback& cb) const
+    {
+        box::dispatchBoxKernel(m_box, [&](const auto& kernel) {
+            forEachNearestNeighbor(kernel, query_points, begin, end, order, qargs, cb);
+        });
+    }
+
+private:
+    //! Implementation of forEachBallNeighbor with the box::BoxKernel of the box.
+    template<typename Kernel, typename Callback>
+    void forEachBallNeighbor(const Kernel& kernel, const vec3<float>* query_points, size_t begin, size_t end,
+                             const unsigned int* order, const QueryArgs& qargs, const Callback& cb) const
+    {
+        const float r_max = qargs.r_max;
+        const float r_max_sq = r_max * r_max;
+        const float r_min_sq = qargs.r_min * qargs.r_min;
+
+        CellDistanceBuffer buffer;
+        std::unordered_set<unsigned int> searched_cells;
+        for (size_t k = begin; k != end; ++k)
+        {
+            const unsigned int query_point_idx = (order == nullptr) ? k : order[k];
+            const vec3<float>& query_point = query_points[query_point_idx];
+            const vec3<unsigned int> point_cell(getCellCoord(query_point));
+            const vec3<int> point_cell_coord(point_cell.x, point_cell.y, point_cell.z);
+            searched_cells.clear();
+
+            for (IteratorCellShell shell(0, isSingleLayer()); getShellDistance(shell.getRange()) < r_max;
+                 ++shell)
+            {
+                const unsigned int cell = getCellIndex(point_cell_coord + (*shell));
+                if (!searched_cells.insert(cell).second)
+                {
+                    continue;
+                }
+
+                buffer.clear();
+                IteratorLinkCell cell_iter = itercell(cell);
+                for (unsigned int j = cell_iter.next(); !cell_iter.atEnd(); j = cell_iter.next())
+                {
+                    buffer.push_back(j, m_search_points[j]);
+                }
+                computeDistancesSquared(kernel, query_point, buffer);
+
+                for (size_t n = 0; n < buffer.size(); ++n)
+                {
+                    const unsigned int point_idx = getPointIndex(buffer.indices[n]);
+                    if ((qargs.exclude_ii && query_point_idx == point_idx)
+                        || (qargs.half_list && point_idx <= query_point_idx))
+                    {
+                        continue;
+                    }
+                    const float r_sq = buffer.r_sq[n];
+                    if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                    {
+                        cb(NeighborBond(query_point_idx, point_idx, std::sqrt(r_sq)));
+                    }
+                }
+            }
+        }
+    }
+
+    //! Implementation of forEachNearestNeighbor with the box::BoxKernel of the box.
+    template<typename Kernel, typename Callback>
+    void forEachNearestNeighbor(const Kernel& kernel, const vec3<float>* query_points, size_t begin,
+                                size_t end, const unsigned int* order, const QueryArgs& qargs,
+                                const Callback& cb) const
+    {
+        const float r_max_sq = qargs.r_max * qargs.r_max;
+        const float r_min_sq = qargs.r_min * qargs.r_min;
+
+        // Small boxes map several shell cells onto the same cell. Each query
+        // point marks the cells it has searched with a distinct value.
+        thread_local std::vector<unsigned int> cell_marks;
+        thread_local unsigned int mark = 0;
+        if (cell_marks.size() < getNumCells())
+        {
+            cell_marks.assign(getNumCells(), 0);
+            mark = 0;
+        }
+
+        CellDistanceBuffer buffer;
+        NearestNeighborHeap nearest;
+        for (size_t k = begin; k != end; ++k)
+        {
+            const unsigned int query_point_idx = (order == nullptr) ? k : order[k];
+            const vec3<float>& query_point = query_points[query_point_idx];
+            const vec3<unsigned int> point_cell(getCellCoord(query_point));
+            const vec3<int> point_cell_coord(point_cell.x, point_cell.y, point_cell.z);
+            nearest.reset(qargs.num_neighbors);
+            if (++mark == 0)
+            {
+                std::fill(cell_marks.begin(), cell_marks.end(), 0);
+                mark = 1;
+            }
+
+            for (IteratorCellShell shell(0, isSingleLayer());; ++shell)
+            {
+                // No point in this or any later shell is closer than the
+                // inner boundary of the shell. Every cell has been searched
+                // once the bound is infinite.
+                const float shell_distance = getShellDistance(shell.getRange());
+                if (shell_distance >= qargs.r_max
+                    || (nearest.full() && nearest.farthest().distance < shell_distance))
+                {
+                    break;
+                }
+
+                const unsigned int cell = getCellIndex(point_cell_coord + (*shell));
+                if (cell_marks[cell] == mark)
+                {
+                    continue;
+                }
+                cell_marks[cell] = mark;
+
+                buffer.clear();
+                IteratorLinkCell cell_iter = itercell(cell);
+                for (unsigned int j = cell_iter.next(); !cell_iter.atEnd(); j = cell_iter.next())
+                {
+                    buffer.push_back(j, m_search_points[j]);
+                }
+                computeDistancesSquared(kernel, query_point, buffer);
+
+                for (size_t n = 0; n < buffer.size(); ++n)
+                {
+                    const unsigned int point_idx = getPointIndex(buffer.indices[n]);
+                    if (qargs.exclude_ii && query_point_idx == point_idx)
+                    {
+                        continue;
+                    }
+                    const float r_sq = buffer.r_sq[n];
+                    if (r_sq < r_max_sq && r_sq >= r_min_sq)
+                    {
+                        nearest.push(NeighborBond(query_point_idx, point_idx, std::sqrt(r_sq)));
+                    }
+                }
+            }
+
+            for (const NeighborBond& bond : nearest.sort())
+            {
+                cb(bond);
+            }
+        }
+    }
+
+protected:
+    //! Validate the combination of specified arguments.
+    /*! Add to parent function to reject queries for bonds to all periodic
+     *  images, since shells of cells wrap onto the nearest image of each cell.
+     */
+    void validateQueryArgs(QueryArgs& args) const override
+    {
+        NeighborQuery::validateQueryArgs(args);
+        if (args.all_images)
+        {
+            throw std::runtime_error("LinkCell does not support bonds to all periodic images, use AABBQuery "
+                                     "instead.");
+        }
+    }
+
 private:
     //! Helper function to compute cell neighbors
     const std::vector<unsigned int>& computeCellNeighbors(unsigned int cell) const;
 
     float m_cell_width {0};                 //!< Minimum necessary cell width cutoff
     vec3<unsigned int> m_celldim {0, 0, 0}; //!< Cell dimensions
+    vec3<float> m_cell_widths {0, 0, 0};    //!< Cell widths along each dimension
     unsigned int m_size {0};                //!< The size of cell list.
 
-    util::ManagedArray<unsigned int> m_cell_list; //!< The cell list last computed
+    util::ManagedArray<unsigned int> m_cell_list;   //!< The cell list last computed
+    util::ManagedArray<unsigned int> m_point_cells; //!< The cell index of each point in the cell list
     using CellNeighbors = tbb::concurrent_hash_map<unsigned int, std::vector<unsigned int>>;
     mutable CellNeighbors m_cell_neighbors; //!< Hash map of cell neighbors for each cell
 };
@@ -260,10 +666,11 @@ public:
      *  iterate outwards from there.
      */
     LinkCellIterator(const LinkCell* neighbor_query, const vec3<float>& query_point,
-                     unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
+                     unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
+                     bool half_list = false)
         : NeighborQueryPerPointIterator(neighbor_query, query_point, query_point_idx, r_max, r_min,
-                                        exclude_ii),
-          m_linkcell(neighbor_query), m_neigh_cell_iter(0, neighbor_query->getBox().is2D()),
+                                        exclude_ii, half_list),
+          m_linkcell(neighbor_query), m_neigh_cell_iter(0, neighbor_query->isSingleLayer()),
           m_cell_iter(m_linkcell->itercell(m_linkcell->getCell(m_query_point)))
     {}
 
@@ -289,7 +696,9 @@ public:
                           bool exclude_ii)
         : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii),
           m_count(0), m_num_neighbors(num_neighbors)
-    {}
+    {
+        m_nearest.reset(num_neighbors);
+    }
 
     //! Empty Destructor
     ~LinkCellQueryIterator() override = default;
@@ -301,6 +710,7 @@ protected:
     unsigned int m_count;                          //!< Number of neighbors returned for the current point.
     unsigned int m_num_neighbors;                  //!< Number of nearest neighbors to find
     std::vector<NeighborBond> m_current_neighbors; //!< The current set of found neighbors.
+    NearestNeighborHeap m_nearest;                 //!< The nearest neighbors found while searching.
 };
 
 //! Iterator that gets neighbors in a ball of size r using LinkCell tree structures.
@@ -309,21 +719,11 @@ class LinkCellQueryBallIterator : public LinkCellIterator
 public:
     //! Constructor
     LinkCellQueryBallIterator(const LinkCell* neighbor_query, const vec3<float>& query_point,
-                              unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
-        : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii)
-    {
-        // Upon querying, if the search radius is equal to the cell width, we
-        // can guarantee that we don't need to search the cell shell past the
-        // query radius. For simplicity, we store this value as an integer.
-        if (m_r_max == neighbor_query->getCellWidth())
-        {
-            m_extra_search_width = 0;
-        }
-        else
-        {
-            m_extra_search_width = 1;
-        }
-    }
+                              unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
+                              bool half_list = false)
+        : LinkCellIterator(neighbor_query, query_point, query_point_idx, r_max, r_min, exclude_ii,
+                           half_list)
+    {}
 
     //! Empty Destructor
     ~LinkCellQueryBallIterator() override = default;
@@ -332,7 +732,12 @@ public:
     NeighborBond next() override;
 
 protected:
-    int m_extra_search_width; //!< The extra shell distance to search, always 0 or 1.
+    //! Evaluate all points of the current cell and buffer the bonds that fall in range.
+    void searchCurrentCell();
+
+    bool m_cell_searched {false};           //!< Whether the current cell has been evaluated.
+    std::vector<NeighborBond> m_cell_bonds; //!< Bonds found in the current cell.
+    size_t m_cell_bond_index {0};           //!< Index of the next bond in m_cell_bonds to return.
 };
 }; }; // end namespace freud::locality
 
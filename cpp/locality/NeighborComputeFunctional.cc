@@ -1,7 +1,13 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_sort.h>
+
 #include "NeighborComputeFunctional.h"
+#include "utils.h"
 
 /*! \file NeighborComputeFunctional.h
     \brief Implements logic for generic looping over neighbors and applying a compute function.
@@ -11,8 +17,9 @@ namespace freud { namespace locality {
 
 NeighborList makeDefaultNlist(const NeighborQuery* nq, const NeighborList* nlist,
                               const vec3<float>* query_points, unsigned int num_query_points,
-                              locality::QueryArgs qargs)
+                              locality::QueryArgs qargs, HalfListPolicy policy)
 {
+    checkHalfListPolicy(nlist, qargs, policy);
     bool requires_delete(false);
     if (nlist == nullptr)
     {
@@ -41,4 +48,153 @@ NeighborList makeDefaultNlist(const NeighborQuery* nq, const NeighborList* nlist
     return new_nlist;
 }
 
+std::vector<NeighborList*> makeBatchNlists(const NeighborQuery* nq, const vec3<float>* query_points,
+                                           unsigned int num_query_points, std::vector<QueryArgs> qargs)
+{
+    if (qargs.empty())
+    {
+        return {};
+    }
+
+    // Validating each query infers its mode and sets its default arguments.
+    for (auto& args : qargs)
+    {
+        args = nq->query(query_points, num_query_points, args)->getQueryArgs();
+        if (args.all_images != qargs[0].all_images)
+        {
+            throw std::invalid_argument("Batched queries must all use the same all_images setting.");
+        }
+    }
+
+    // The search finds a superset of the bonds of every query.
+    const bool any_ball = std::any_of(qargs.begin(), qargs.end(),
+                                      [](const QueryArgs& args) { return args.mode == QueryType::ball; });
+    QueryArgs search_args;
+    search_args.mode = any_ball ? QueryType::ball : QueryType::nearest;
+    search_args.r_max = 0;
+    search_args.r_min = qargs[0].r_min;
+    search_args.num_neighbors = 0;
+    search_args.exclude_ii = true;
+    search_args.half_list = true;
+    search_args.all_images = qargs[0].all_images;
+    for (const auto& args : qargs)
+    {
+        if (args.mode == search_args.mode)
+        {
+            search_args.r_max = std::max(search_args.r_max, args.r_max);
+        }
+        if (args.mode == QueryType::nearest)
+        {
+            search_args.num_neighbors = std::max(search_args.num_neighbors, args.num_neighbors);
+        }
+        search_args.r_min = std::min(search_args.r_min, args.r_min);
+        search_args.exclude_ii = search_args.exclude_ii && args.exclude_ii;
+        search_args.half_list = search_args.half_list && args.half_list;
+    }
+    if (any_ball)
+    {
+        search_args.num_neighbors = DEFAULT_NUM_NEIGHBORS;
+    }
+
+    using Bonds = std::vector<NeighborBond>;
+    using ThreadBonds = tbb::enumerable_thread_specific<std::vector<Bonds>>;
+    ThreadBonds query_bonds([&qargs]() { return std::vector<Bonds>(qargs.size()); });
+    tbb::enumerable_thread_specific<Bonds> candidate_bonds;
+    tbb::enumerable_thread_specific<Bonds> point_bonds;
+
+    loopOverNeighborsIterator(
+        nq, query_points, num_query_points, search_args, nullptr,
+        [&](size_t i, const std::shared_ptr<NeighborPerPointIterator>& ppiter) {
+            Bonds& candidates = candidate_bonds.local();
+            Bonds& bonds = point_bonds.local();
+            std::vector<Bonds>& local_bonds = query_bonds.local();
+
+            candidates.clear();
+            for (NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
+            {
+                candidates.emplace_back(nb.query_point_idx, nb.point_idx, nb.distance);
+            }
+            std::sort(candidates.begin(), candidates.end(), compareNeighborDistance);
+
+            // The candidates include every point closer than this distance.
+            float complete_distance = search_args.r_max;
+            if (!any_ball && candidates.size() == search_args.num_neighbors)
+            {
+                complete_distance = candidates.back().distance;
+            }
+
+            for (size_t q = 0; q < qargs.size(); ++q)
+            {
+                const QueryArgs& args = qargs[q];
+                const bool nearest = args.mode == QueryType::nearest;
+                bonds.clear();
+                for (const NeighborBond& nb : candidates)
+                {
+                    if (nb.distance >= args.r_max || (nearest && bonds.size() == args.num_neighbors))
+                    {
+                        break;
+                    }
+                    if (nb.distance < args.r_min || (args.exclude_ii && nb.point_idx == i)
+                        || (args.half_list && nb.point_idx <= i))
+                    {
+                        continue;
+                    }
+                    bonds.push_back(nb);
+                }
+
+                // A nearest neighbor query is answered by the candidates if
+                // its farthest neighbor is closer than any point the search
+                // may have missed, or if it found all points within r_max.
+                const bool complete = !nearest
+                    || (bonds.size() == args.num_neighbors ? bonds.back().distance < complete_distance
+                                                           : args.r_max <= complete_distance);
+                if (!complete)
+                {
+                    bonds.clear();
+                    std::shared_ptr<NeighborQueryPerPointIterator> it
+                        = nq->querySingle(query_points[i], i, args);
+                    for (NeighborBond nb = it->next(); !it->end(); nb = it->next())
+                    {
+                        bonds.emplace_back(nb.query_point_idx, nb.point_idx, nb.distance);
+                    }
+                }
+
+                std::sort(bonds.begin(), bonds.end(), compareNeighborBond);
+                local_bonds[q].insert(local_bonds[q].end(), bonds.begin(), bonds.end());
+            }
+        },
+        true, HalfListPolicy::symmetric);
+
+    std::vector<NeighborList*> nlists;
+    nlists.reserve(qargs.size());
+    for (size_t q = 0; q < qargs.size(); ++q)
+    {
+        Bonds bonds;
+        for (const auto& local_bonds : query_bonds)
+        {
+            bonds.insert(bonds.end(), local_bonds[q].begin(), local_bonds[q].end());
+        }
+        util::executeInThreadArena(
+            [&]() { tbb::parallel_sort(bonds.begin(), bonds.end(), compareNeighborBond); });
+
+        auto* nl = new NeighborList();
+        nl->setNumBonds(bonds.size(), num_query_points, nq->getNPoints());
+        nl->setHalfList(qargs[q].half_list);
+        unsigned int* neighbors = nl->getNeighbors().get();
+        float* distances = nl->getDistances().get();
+        float* weights = nl->getWeights().get();
+        util::forLoopWrapper(0, bonds.size(), [&](size_t begin, size_t end) {
+            for (size_t bond = begin; bond < end; ++bond)
+            {
+                neighbors[2 * bond] = bonds[bond].query_point_idx;
+                neighbors[2 * bond + 1] = bonds[bond].point_idx;
+                distances[bond] = bonds[bond].distance;
+                weights[bond] = float(1.0);
+            }
+        });
+        nlists.push_back(nl);
+    }
+    return nlists;
+}
+
 }; }; // end namespace freud::locality
@@ -4,12 +4,19 @@
 #ifndef NEIGHBOR_COMPUTE_FUNCTIONAL_H
 #define NEIGHBOR_COMPUTE_FUNCTIONAL_H
 
+#include <atomic>
 #include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 #include "AABBQuery.h"
+#include "Instrumentation.h"
+#include "LinkCell.h"
 #include "NeighborList.h"
 #include "NeighborPerPointIterator.h"
 #include "NeighborQuery.h"
+#include "RawPoints.h"
 #include "utils.h"
 
 /*! \file NeighborComputeFunctional.h
@@ -18,14 +25,63 @@
 
 namespace freud { namespace locality {
 
+//! Whether a compute accepts half neighbor lists.
+/*! A half neighbor list holds only one of the bonds (i, j) and (j, i), so
+ *  computes see only half of the neighbors of each point unless they account
+ *  for the reverse bond of every bond they receive.
+ */
+enum class HalfListPolicy
+{
+    reject,   //!< Half neighbor lists are rejected, since the compute needs both bonds of every pair.
+    symmetric //!< Half neighbor lists are accepted, since the compute accounts for the reverse bonds.
+};
+
+//! Throw if the bonds passed to a compute form a half neighbor list that the compute rejects.
+/*! The bonds form a half list if the provided NeighborList is marked as one,
+ *  or if no NeighborList is provided and the query arguments request one.
+ */
+inline void checkHalfListPolicy(const NeighborList* nlist, const QueryArgs& qargs, HalfListPolicy policy)
+{
+    const bool half_list = (nlist != nullptr) ? nlist->isHalfList() : qargs.half_list;
+    if (half_list && policy == HalfListPolicy::reject)
+    {
+        throw std::invalid_argument("This compute requires every bond in both directions and does not "
+                                    "support half neighbor lists.");
+    }
+}
+
 //! Make a default NeighborList object to use.
 /*! This function makes a NeighborList from the provided NeighborQuery object
  * if the provided NeighborList is NULL. Otherwise, it simply returns a copy of
- * the provided NeighborList.
+ * the provided NeighborList. Half neighbor lists are rejected unless the
+ * policy is HalfListPolicy::symmetric.
  */
 NeighborList makeDefaultNlist(const NeighborQuery* nq, const NeighborList* nlist,
                               const vec3<float>* query_points, unsigned int num_query_points,
-                              locality::QueryArgs qargs);
+                              locality::QueryArgs qargs, HalfListPolicy policy = HalfListPolicy::reject);
+
+//! Build the NeighborLists of several queries of the same query points with a single search.
+/*! Workflows often query the same points with several sets of query
+ *  arguments, e.g. short and long cutoffs and a number of nearest neighbors.
+ *  All queries are answered from one search whose arguments include every
+ *  bond of the individual queries: a ball query with the largest r_max if any
+ *  ball queries are given, and otherwise a nearest neighbor query with the
+ *  largest num_neighbors. The candidates of each query point are then
+ *  filtered for each query. Nearest neighbor queries that cannot be answered
+ *  from the candidates of a query point, because the search may have missed
+ *  closer points, repeat the query for that point only.
+ *
+ *  The returned NeighborLists are sorted like those of
+ *  NeighborQueryIterator::toNeighborList, and the caller is responsible for
+ *  deleting them.
+ *
+ *  \param nq The NeighborQuery object to query.
+ *  \param query_points The query points.
+ *  \param num_query_points The number of query points.
+ *  \param qargs The query arguments of each query, which must agree on all_images.
+ */
+std::vector<NeighborList*> makeBatchNlists(const NeighborQuery* nq, const vec3<float>* query_points,
+                                           unsigned int num_query_points, std::vector<QueryArgs> qargs);
 
 //! Compute the vector corresponding to a NeighborBond.
 /*! The primary purpose of this function is to standardize the directionality
@@ -38,6 +94,121 @@ inline vec3<float> bondVector(const NeighborBond& nb, const NeighborQuery* nq,
     return nq->getBox().wrap((*nq)[nb.point_idx] - query_points[nb.query_point_idx]);
 }
 
+//! Determine whether the bonds passed to a compute function form a half neighbor list.
+/*! The bonds form a half list if the provided NeighborList is marked as one,
+ *  or if no NeighborList is provided and the query arguments request one.
+ *  Computes over symmetric self-queries can then account for the bond (j, i)
+ *  of every bond (i, j) they receive. Since half lists only describe
+ *  self-queries, the query points must be the points of the NeighborQuery,
+ *  not merely as many points.
+ */
+inline bool isHalfList(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                       const NeighborList* nlist, const QueryArgs& qargs)
+{
+    const bool half_list = (nlist != nullptr) ? nlist->isHalfList() : qargs.half_list;
+    if (half_list && (query_points != nq->getPoints() || n_query_points != nq->getNPoints()))
+    {
+        throw std::invalid_argument("Half neighbor lists require the query points to be the points.");
+    }
+    return half_list;
+}
+
+//! Get the order in which to visit query points when querying a NeighborQuery.
+/*! When the query points are the points of a spatially sorted NeighborQuery,
+ *  visiting them in the sorted order means that consecutive queries touch
+ *  nearby regions of the search data structure. Returns nullptr when query
+ *  points should be visited in index order.
+ */
+inline const unsigned int* queryPointOrder(const NeighborQuery* nq, const vec3<float>* query_points,
+                                           unsigned int n_query_points)
+{
+    if (nq->isSpatiallySorted() && query_points == nq->getPoints() && n_query_points == nq->getNPoints())
+    {
+        return nq->getSpatialOrder().data();
+    }
+    return nullptr;
+}
+
+//! Apply a compute function to all bonds of a ball query using a bulk query.
+/*! LinkCell and AABBQuery provide a templated forEachBallNeighbor method that
+ *  finds the neighbors of a range of query points without allocating an
+ *  iterator per query point or making a virtual call per bond. This function
+ *  dispatches to that method when it is available. The query arguments must
+ *  already have been validated by NeighborQuery::query.
+ *
+ *  \returns Whether a bulk query was performed. If false, nothing was done.
+ */
+template<typename MakeComputePairType>
+bool loopOverBallNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                           unsigned int n_query_points, const QueryArgs& qargs, const unsigned int* order,
+                           const MakeComputePairType& make_cf, bool parallel)
+{
+    if (qargs.mode != QueryType::ball)
+    {
+        return false;
+    }
+
+    // RawPoints objects build an AABBQuery when they are first queried.
+    if (const auto* raw_points = dynamic_cast<const RawPoints*>(neighbor_query))
+    {
+        neighbor_query = raw_points->getAABBQuery();
+    }
+
+    if (const auto* linkcell = dynamic_cast<const LinkCell*>(neighbor_query))
+    {
+        util::forLoopWrapper(
+            0, n_query_points,
+            [&](size_t begin, size_t end) {
+                linkcell->forEachBallNeighbor(query_points, begin, end, order, qargs, make_cf());
+            },
+            parallel);
+        return true;
+    }
+    if (const auto* aabb_query = dynamic_cast<const AABBQuery*>(neighbor_query))
+    {
+        util::forLoopWrapper(
+            0, n_query_points,
+            [&](size_t begin, size_t end) {
+                aabb_query->forEachBallNeighbor(query_points, begin, end, order, qargs, make_cf());
+            },
+            parallel);
+        return true;
+    }
+    return false;
+}
+
+//! Apply a compute function to all bonds of a nearest neighbor query using a bulk query.
+/*! LinkCell provides a templated forEachNearestNeighbor method that finds the
+ *  nearest neighbors of a range of query points with a bounded heap per query
+ *  point instead of sorting all candidates in a per-point iterator. This
+ *  function dispatches to that method when it is available. The query
+ *  arguments must already have been validated by NeighborQuery::query.
+ *
+ *  \returns Whether a bulk query was performed. If false, nothing was done.
+ */
+template<typename MakeComputePairType>
+bool loopOverNearestNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                              unsigned int n_query_points, const QueryArgs& qargs, const unsigned int* order,
+                              const MakeComputePairType& make_cf, bool parallel)
+{
+    if (qargs.mode != QueryType::nearest)
+    {
+        return false;
+    }
+
+    if (const auto* linkcell = dynamic_cast<const LinkCell*>(neighbor_query))
+    {
+        util::forLoopWrapper(
+            0, n_query_points,
+            [&](size_t begin, size_t end) {
+                linkcell->forEachNearestNeighbor(query_points, begin, end, order, qargs, make_cf());
+            },
+            parallel);
+        return true;
+    }
+    return false;
+}
+
 //! Implementation of per-point finding logic for NeighborList objects.
 /*! This class provides a concrete implementation of the per-point neighbor
  *  finding interface specified by the NeighborPerPointIterator. In particular,
@@ -49,9 +220,13 @@ class NeighborListPerPointIterator : public NeighborPerPointIterator
 {
 public:
     NeighborListPerPointIterator(const NeighborList* nlist, size_t point_index)
-        : NeighborPerPointIterator(point_index), m_nlist(nlist)
+        : NeighborListPerPointIterator(nlist, point_index, nlist->find_first_index(point_index))
+    {}
+
+    //! Constructor starting at the first bond of the point, which avoids searching the neighbor list.
+    NeighborListPerPointIterator(const NeighborList* nlist, size_t point_index, size_t first_bond)
+        : NeighborPerPointIterator(point_index), m_nlist(nlist), m_current_index(first_bond)
     {
-        m_current_index = m_nlist->find_first_index(point_index);
         m_finished = m_current_index == m_nlist->getNumBonds();
         if (!m_finished)
         {
@@ -115,15 +290,21 @@ private:
  *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
  * given qargs. \param cf An object with operator(size_t point_index, std::shared_ptr<NeighborIterator>) as
  * input. It should implement iteration logic over the iterator.
+ *  \param policy Whether half neighbor lists are accepted.
  */
 template<typename ComputePairType>
 void loopOverNeighborsIterator(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
                                unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
-                               const ComputePairType& cf, bool parallel = true)
+                               const ComputePairType& cf, bool parallel = true,
+                               HalfListPolicy policy = HalfListPolicy::reject)
 {
+    checkHalfListPolicy(nlist, qargs, policy);
+    util::ScopedPhase phase("loopOverNeighbors");
+
     // check if nlist exists
     if (nlist != nullptr)
     {
+        phase.addBonds(nlist->getNumBonds());
         util::forLoopWrapper(
             0, n_query_points,
             [&](size_t begin, size_t end) {
@@ -141,12 +322,17 @@ void loopOverNeighborsIterator(const NeighborQuery* neighbor_query, const vec3<f
         std::shared_ptr<NeighborQueryIterator> iter
             = neighbor_query->query(query_points, n_query_points, qargs);
 
+        // Serial loops keep index order for computes that depend on it.
+        const unsigned int* order
+            = parallel ? queryPointOrder(neighbor_query, query_points, n_query_points) : nullptr;
+
         // iterate over the query object in parallel
         util::forLoopWrapper(
             0, n_query_points,
             [&](size_t begin, size_t end) {
-                for (size_t i = begin; i != end; ++i)
+                for (size_t k = begin; k != end; ++k)
                 {
+                    const size_t i = (order == nullptr) ? k : order[k];
                     std::shared_ptr<NeighborQueryPerPointIterator> it = iter->query(i);
                     cf(i, it);
                 }
@@ -155,42 +341,28 @@ void loopOverNeighborsIterator(const NeighborQuery* neighbor_query, const vec3<f
     }
 }
 
-//! Wrapper iterating looping over NeighborQuery or NeighborList.
-/*! This function dynamically determines whether or not the provided
- *  NeighborList is valid. If it is, it applies the provide compute function to
- *  all neighbor pairs in the NeighborList. If not, it attempts to use the
- *  provided NeighborQuery for iteration. If the NeighborQuery object is also
- *  not queryable (if it's a RawPoints object), a local NeighborQuery instance
- *  is created and iterated over.
- *
- *  This function is designed for computations that can simplify accumulate
- *  over all neighbor pairs. As a result, the provided compute function is
- *  simply applied to all pairs, allowing maximum parallelism. The actual logic
- *  for the NeighborList vs NeighborQuery code paths are handled in helper
- *  functions.
- *
- *  \param neighbor_query NeighborQuery object to iterate over.
- *  \param query_points Query points to perform computation on.
- *  \param n_query_points Number of query_points.
- *  \param qargs Query arguments.
- *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
- * given qargs. \param cf An object with operator(NeighborBond) as input.
- */
-template<typename ComputePairType>
-void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
-                       unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
-                       const ComputePairType& cf, bool parallel = true)
+//! Implementation of loopOverNeighborRanges, which does not count the bonds.
+template<typename MakeComputePairType>
+void loopOverNeighborRangesUncounted(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                                     unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                                     const MakeComputePairType& make_cf, bool parallel)
 {
     // check if nlist exists
     if (nlist != nullptr)
     {
+        // Read the per-bond arrays directly to avoid the indirection and
+        // bounds checks of ManagedArray indexing in the inner loop.
+        const unsigned int* neighbors = nlist->getNeighbors().get();
+        const float* distances = nlist->getDistances().get();
+        const float* weights = nlist->getWeights().get();
         util::forLoopWrapper(
             0, nlist->getNumBonds(),
             [&](size_t begin, size_t end) {
+                const auto& cf = make_cf();
                 for (size_t bond = begin; bond != end; ++bond)
                 {
-                    const NeighborBond nb(nlist->getNeighbors()(bond, 0), nlist->getNeighbors()(bond, 1),
-                                          nlist->getDistances()[bond], nlist->getWeights()[bond]);
+                    const NeighborBond nb(neighbors[2 * bond], neighbors[2 * bond + 1], distances[bond],
+                                          weights[bond]);
                     cf(nb);
                 }
             },
@@ -201,13 +373,28 @@ void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* q
         std::shared_ptr<NeighborQueryIterator> iter
             = neighbor_query->query(query_points, n_query_points, qargs);
 
+        // Serial loops keep index order for computes that depend on it.
+        const unsigned int* order
+            = parallel ? queryPointOrder(neighbor_query, query_points, n_query_points) : nullptr;
+
+        const QueryArgs& validated_qargs = iter->getQueryArgs();
+        if (loopOverBallNeighbors(neighbor_query, query_points, n_query_points, validated_qargs, order,
+                                  make_cf, parallel)
+            || loopOverNearestNeighbors(neighbor_query, query_points, n_query_points, validated_qargs, order,
+                                        make_cf, parallel))
+        {
+            return;
+        }
+
         // iterate over the query object in parallel
         util::forLoopWrapper(
             0, n_query_points,
-            [&iter, &cf](size_t begin, size_t end) {
+            [&iter, &make_cf, order](size_t begin, size_t end) {
+                const auto& cf = make_cf();
                 NeighborBond nb;
-                for (size_t i = begin; i != end; ++i)
+                for (size_t k = begin; k != end; ++k)
                 {
+                    const size_t i = (order == nullptr) ? k : order[k];
                     std::shared_ptr<NeighborQueryPerPointIterator> it = iter->query(i);
                     nb = it->next();
                     while (!it->end())
@@ -221,6 +408,160 @@ void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* q
     }
 }
 
+//! Compute function counting the bonds that it passes to the compute function of a range of bonds.
+/*! The count is added to a total shared by all ranges when the counter is destroyed.
+ */
+template<typename MakeComputePairType> class BondCounter
+{
+public:
+    //! Constructor
+    /*! \param make_cf An object with operator() returning an object with operator(NeighborBond).
+     *  \param bonds The total number of bonds of all ranges.
+     */
+    BondCounter(const MakeComputePairType& make_cf, std::atomic<size_t>& bonds)
+        : m_cf(make_cf()), m_bonds(bonds)
+    {}
+
+    ~BondCounter()
+    {
+        m_bonds.fetch_add(m_count, std::memory_order_relaxed);
+    }
+
+    BondCounter(const BondCounter&) = delete;
+    BondCounter& operator=(const BondCounter&) = delete;
+
+    void operator()(const NeighborBond& nb) const
+    {
+        ++m_count;
+        m_cf(nb);
+    }
+
+private:
+    decltype(std::declval<const MakeComputePairType&>()()) m_cf; //!< Compute function of the range
+    std::atomic<size_t>& m_bonds;                                 //!< Total number of bonds
+    mutable size_t m_count {0};                                   //!< Number of bonds of the range
+};
+
+//! Wrapper looping over NeighborQuery or NeighborList with a compute function per range of bonds.
+/*! This function behaves like loopOverNeighbors, but instead of a single
+ *  compute function it takes a function that creates the compute function
+ *  used for each range of bonds or query points processed by one thread.
+ *  Computes can use this to look up thread-local storage once per range
+ *  rather than once per bond. While instrumentation is enabled, the bonds
+ *  are counted.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ * given qargs. \param make_cf An object with operator() returning an object with operator(NeighborBond).
+ *  \param policy Whether half neighbor lists are accepted.
+ */
+template<typename MakeComputePairType>
+void loopOverNeighborRanges(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                            unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                            const MakeComputePairType& make_cf, bool parallel = true,
+                            HalfListPolicy policy = HalfListPolicy::reject)
+{
+    checkHalfListPolicy(nlist, qargs, policy);
+    util::ScopedPhase phase("loopOverNeighbors");
+    if (phase.isActive())
+    {
+        std::atomic<size_t> bonds {0};
+        loopOverNeighborRangesUncounted(
+            neighbor_query, query_points, n_query_points, qargs, nlist,
+            [&make_cf, &bonds]() { return BondCounter<MakeComputePairType>(make_cf, bonds); }, parallel);
+        phase.addBonds(bonds.load());
+        return;
+    }
+    loopOverNeighborRangesUncounted(neighbor_query, query_points, n_query_points, qargs, nlist, make_cf,
+                                    parallel);
+}
+
+//! Wrapper iterating looping over NeighborQuery or NeighborList.
+/*! This function dynamically determines whether or not the provided
+ *  NeighborList is valid. If it is, it applies the provide compute function to
+ *  all neighbor pairs in the NeighborList. If not, it attempts to use the
+ *  provided NeighborQuery for iteration. If the NeighborQuery object is also
+ *  not queryable (if it's a RawPoints object), a local NeighborQuery instance
+ *  is created and iterated over.
+ *
+ *  This function is designed for computations that can simplify accumulate
+ *  over all neighbor pairs. As a result, the provided compute function is
+ *  simply applied to all pairs, allowing maximum parallelism. The actual logic
+ *  for the NeighborList vs NeighborQuery code paths are handled in helper
+ *  functions.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param nlist Neighbor List. If not NULL, loop over it. Otherwise, use neighbor_query appropriately with
+ * given qargs. \param cf An object with operator(NeighborBond) as input.
+ *  \param policy Whether half neighbor lists are accepted.
+ */
+template<typename ComputePairType>
+void loopOverNeighbors(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                       unsigned int n_query_points, QueryArgs qargs, const NeighborList* nlist,
+                       const ComputePairType& cf, bool parallel = true,
+                       HalfListPolicy policy = HalfListPolicy::reject)
+{
+    loopOverNeighborRanges(
+        neighbor_query, query_points, n_query_points, qargs, nlist,
+        [&cf]() -> const ComputePairType& { return cf; }, parallel, policy);
+}
+
+//! Apply compute functions to the bonds of a ball query, consuming whole AABBQuery nodes where possible.
+/*! Nodes of the tree of an AABBQuery whose points are all bonded to a query
+ *  point are offered to the node compute function as described in
+ *  AABBQuery::forEachBallNeighborOrNode, and the bonds of the nodes it
+ *  rejects are passed to the bond compute function. Queries that are not
+ *  ball queries of an AABBQuery, or that use half_list, pass every bond to
+ *  the bond compute function as in loopOverNeighborRanges.
+ *
+ *  \param neighbor_query NeighborQuery object to iterate over.
+ *  \param query_points Query points to perform computation on.
+ *  \param n_query_points Number of query_points.
+ *  \param qargs Query arguments.
+ *  \param max_extent The longest diagonal of the AABBs of the nodes offered to the node compute function.
+ *  \param make_node_cf An object with operator() returning an object with
+ *                      bool operator()(unsigned int, float, float, unsigned int).
+ *  \param make_cf An object with operator() returning an object with operator(NeighborBond).
+ *  \param policy Whether half neighbor lists are accepted.
+ */
+template<typename MakeComputeNodeType, typename MakeComputePairType>
+void loopOverBallNeighborsOrNodes(const NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                                  unsigned int n_query_points, QueryArgs qargs, float max_extent,
+                                  const MakeComputeNodeType& make_node_cf, const MakeComputePairType& make_cf,
+                                  HalfListPolicy policy = HalfListPolicy::reject)
+{
+    checkHalfListPolicy(nullptr, qargs, policy);
+    std::shared_ptr<NeighborQueryIterator> iter = neighbor_query->query(query_points, n_query_points, qargs);
+    const QueryArgs& validated_qargs = iter->getQueryArgs();
+
+    // RawPoints objects build an AABBQuery when they are first queried.
+    const NeighborQuery* tree_query = neighbor_query;
+    if (const auto* raw_points = dynamic_cast<const RawPoints*>(neighbor_query))
+    {
+        tree_query = raw_points->getAABBQuery();
+    }
+    const auto* aabb_query = dynamic_cast<const AABBQuery*>(tree_query);
+    if (aabb_query == nullptr || validated_qargs.mode != QueryType::ball || validated_qargs.half_list)
+    {
+        loopOverNeighborRanges(neighbor_query, query_points, n_query_points, qargs, nullptr, make_cf, true,
+                               policy);
+        return;
+    }
+
+    util::ScopedPhase phase("loopOverBallNeighborsOrNodes");
+    const unsigned int* order = queryPointOrder(neighbor_query, query_points, n_query_points);
+    util::forLoopWrapper(0, n_query_points, [&](size_t begin, size_t end) {
+        aabb_query->forEachBallNeighborOrNode(query_points, begin, end, order, validated_qargs, max_extent,
+                                              make_node_cf(), make_cf());
+    });
+}
+
 }; }; // end namespace freud::locality
 
 #endif // NEIGHBOR_COMPUTE_FUNCTIONAL_H
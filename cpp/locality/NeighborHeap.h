@@ -0,0 +1,96 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef NEIGHBOR_HEAP_H
+#define NEIGHBOR_HEAP_H
+
+#include <algorithm>
+#include <vector>
+
+#include "NeighborBond.h"
+
+/*! \file NeighborHeap.h
+    \brief Bounded storage of the nearest neighbors found so far.
+*/
+
+namespace freud { namespace locality {
+
+//! Compare the bonds of one query point by distance, breaking ties by point index.
+inline bool compareNearestNeighbors(const NeighborBond& a, const NeighborBond& b)
+{
+    return a.less_as_distance(b);
+}
+
+//! Keep only the nearest neighbors among a set of candidates, sorted by increasing distance.
+/*! \param bonds The candidate bonds of a single query point.
+ *  \param num_neighbors The number of neighbors to keep.
+ */
+inline void keepNearestNeighbors(std::vector<NeighborBond>& bonds, unsigned int num_neighbors)
+{
+    const auto num_kept = std::min(static_cast<size_t>(num_neighbors), bonds.size());
+    std::partial_sort(bonds.begin(), bonds.begin() + num_kept, bonds.end(), compareNearestNeighbors);
+    bonds.resize(num_kept);
+}
+
+//! Fixed-capacity max-heap holding the nearest neighbors of a query point.
+/*! Nearest neighbor searches visit many more candidates than the number of
+ *  neighbors requested. Rather than collecting and sorting all of them, the
+ *  heap keeps only the best num_neighbors candidates seen so far, with the
+ *  farthest of them on top so that it can be replaced in logarithmic time.
+ *  The farthest kept distance also bounds how far the search must continue.
+ */
+class NearestNeighborHeap
+{
+public:
+    //! Remove all neighbors and set the number of neighbors to keep.
+    void reset(unsigned int num_neighbors)
+    {
+        m_num_neighbors = num_neighbors;
+        m_bonds.clear();
+    }
+
+    //! Whether num_neighbors neighbors have been found.
+    bool full() const
+    {
+        return m_bonds.size() >= m_num_neighbors;
+    }
+
+    //! The farthest neighbor kept (the heap must not be empty).
+    const NeighborBond& farthest() const
+    {
+        return m_bonds.front();
+    }
+
+    //! Offer a candidate neighbor, keeping it if it is among the nearest found so far.
+    void push(const NeighborBond& bond)
+    {
+        if (!full())
+        {
+            m_bonds.push_back(bond);
+            std::push_heap(m_bonds.begin(), m_bonds.end(), compareNearestNeighbors);
+        }
+        else if (m_num_neighbors != 0 && compareNearestNeighbors(bond, m_bonds.front()))
+        {
+            std::pop_heap(m_bonds.begin(), m_bonds.end(), compareNearestNeighbors);
+            m_bonds.back() = bond;
+            std::push_heap(m_bonds.begin(), m_bonds.end(), compareNearestNeighbors);
+        }
+    }
+
+    //! Sort the neighbors by increasing distance and return them.
+    /*! The heap must be reset before any further neighbors are pushed.
+     */
+    std::vector<NeighborBond>& sort()
+    {
+        std::sort_heap(m_bonds.begin(), m_bonds.end(), compareNearestNeighbors);
+        return m_bonds;
+    }
+
+private:
+    unsigned int m_num_neighbors {0};  //!< Number of neighbors to keep
+    std::vector<NeighborBond> m_bonds; //!< Neighbors kept, as a max-heap by distance
+};
+
+}; }; // end namespace freud::locality
+
+#endif // NEIGHBOR_HEAP_H
@@ -2,11 +2,29 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <stdexcept>
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_sort.h>
+#include <tuple>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #include "NeighborList.h"
+#include "utils.h"
 
 namespace freud { namespace locality {
 
@@ -15,7 +33,7 @@ NeighborList::NeighborList()
       m_segments_counts_updated(false)
 {}
 
-NeighborList::NeighborList(unsigned int num_bonds)
+NeighborList::NeighborList(size_t num_bonds)
     : m_num_query_points(0), m_num_points(0), m_neighbors({num_bonds, 2}), m_distances(num_bonds),
       m_weights(num_bonds), m_segments_counts_updated(false)
 {}
@@ -27,14 +45,14 @@ NeighborList::NeighborList(const NeighborList& other)
     copy(other);
 }
 
-NeighborList::NeighborList(unsigned int num_bonds, const unsigned int* query_point_index,
+NeighborList::NeighborList(size_t num_bonds, const unsigned int* query_point_index,
                            unsigned int num_query_points, const unsigned int* point_index,
                            unsigned int num_points, const float* distances, const float* weights)
     : m_num_query_points(num_query_points), m_num_points(num_points), m_neighbors({num_bonds, 2}),
       m_distances(num_bonds), m_weights(num_bonds), m_segments_counts_updated(false)
 {
     unsigned int last_index(0);
-    for (unsigned int i = 0; i < num_bonds; i++)
+    for (size_t i = 0; i < num_bonds; i++)
     {
         unsigned int index = query_point_index[i];
         if (index < last_index)
@@ -64,22 +82,25 @@ NeighborList::NeighborList(const vec3<float>* points, const vec3<float>* query_p
     : m_num_points(num_points), m_num_query_points(num_query_points), m_segments_counts_updated(false)
 {
     // prepare member arrays
-    const unsigned int num_ii = (exclude_ii ? std::min(num_points, num_query_points) : 0);
-    const unsigned int num_bonds = num_points * num_query_points - num_ii;
+    const size_t num_ii = (exclude_ii ? std::min(num_points, num_query_points) : 0);
+    const size_t num_bonds = size_t(num_points) * num_query_points - num_ii;
 
     m_neighbors.prepare({num_bonds, 2});
     m_distances.prepare(num_bonds);
     m_weights.prepare(num_bonds);
 
     util::forLoopWrapper(0, num_query_points, [&](size_t begin, size_t end) {
+        // The distances of each query point are computed in one tile.
+        std::vector<float> distances(num_points);
         for (unsigned int i = begin; i < end; ++i)
         {
             // set the starting value of the bond index
-            unsigned int bond_idx = i * num_points;
+            size_t bond_idx = size_t(i) * num_points;
             if (exclude_ii)
             {
                 bond_idx -= std::min(i, num_points);
             }
+            box.computeDistanceTile(query_points + i, 1, points, num_points, distances.data(), num_points);
 
             // loop over points
             for (unsigned int j = 0; j < num_points; ++j)
@@ -92,8 +113,7 @@ NeighborList::NeighborList(const vec3<float>* points, const vec3<float>* query_p
                 m_neighbors(bond_idx, 0) = i;
                 m_neighbors(bond_idx, 1) = j;
                 m_weights(bond_idx) = 1.0;
-                const auto dr = box.wrap(query_points[i] - points[j]);
-                m_distances(bond_idx) = sqrt(dot(dr, dr));
+                m_distances(bond_idx) = distances[j];
                 ++bond_idx;
             }
         }
@@ -144,7 +164,7 @@ NeighborList::NeighborList(std::vector<NeighborBond> bonds)
     m_segments_counts_updated = false;
 }
 
-unsigned int NeighborList::getNumBonds() const
+size_t NeighborList::getNumBonds() const
 {
     return m_neighbors.shape()[0];
 }
@@ -159,7 +179,7 @@ unsigned int NeighborList::getNumPoints() const
     return m_num_points;
 }
 
-void NeighborList::setNumBonds(unsigned int num_bonds, unsigned int num_query_points, unsigned int num_points)
+void NeighborList::setNumBonds(size_t num_bonds, unsigned int num_query_points, unsigned int num_points)
 {
     resize(num_bonds);
     m_num_query_points = num_query_points;
@@ -169,6 +189,7 @@ void NeighborList::setNumBonds(unsigned int num_bonds, unsigned int num_query_po
 
 void NeighborList::updateSegmentCounts() const
 {
+    const std::lock_guard<std::mutex> lock(m_segment_counts_mutex.get());
     if (!m_segments_counts_updated)
     {
         m_counts.prepare(m_num_query_points);
@@ -176,7 +197,8 @@ void NeighborList::updateSegmentCounts() const
         const unsigned int INDEX_TERMINATOR(0xffffffff);
         unsigned int last_index(INDEX_TERMINATOR);
         unsigned int counter(0);
-        for (unsigned int i = 0; i < getNumBonds(); i++)
+        const size_t num_bonds(getNumBonds());
+        for (size_t i = 0; i < num_bonds; i++)
         {
             const unsigned int index(m_neighbors(i, 0));
             if (index != last_index)
@@ -202,55 +224,189 @@ void NeighborList::updateSegmentCounts() const
     }
 }
 
-// We are currently assuming that the input iterator has the correct length;
-// however, this is compatible with the original assumptions of this function
-// (pre-iterator syntax), so we'll accept that level of type-safety for now. In
-// the future, if we expose a more appropriate iterator API then we'll need to
-// accept an "end" parameter as well.
-template<typename Iterator> unsigned int NeighborList::filter(Iterator begin)
+namespace {
+//! Number of bonds of the blocks compacted by a single task.
+constexpr size_t COMPACT_BLOCK_SIZE = size_t(1) << 14;
+
+//! The kept bonds of a block of a NeighborList being compacted.
+struct CompactBlock
+{
+    size_t num_kept {0};      //!< Number of kept bonds
+    size_t first_output {0};  //!< Index of the first kept bond among all kept bonds
+    unsigned int last_query_point {0}; //!< Query point of the last kept bond, if any
+    //! Query point of the last kept bond before the block, if any
+    unsigned int previous_query_point {0};
+    bool has_previous {false}; //!< Whether any bond before the block is kept
+    //! Query point and number of bonds of the first and last runs of kept
+    //! bonds of the same query point of the block, which may continue in
+    //! other blocks and are hence counted after all blocks are compacted
+    std::array<std::pair<unsigned int, unsigned int>, 2> boundary_runs {};
+};
+} // namespace
+
+// Bonds are compacted by a parallel prefix sum over blocks of bonds: the
+// kept bonds of each block are counted, their output offsets are the
+// exclusive sum of the counts of the previous blocks, and every block then
+// writes its kept bonds to the new arrays. The segments and counts of the
+// kept bonds, which are sorted by query point like all bonds, are written in
+// the same pass. Only the runs of kept bonds that start or end a block may
+// be shared with other blocks, so they are counted serially afterwards.
+template<typename Keep> size_t NeighborList::compact(const Keep& keep)
 {
-    const unsigned int old_size(getNumBonds());
-    const auto end = begin + old_size;
+    const size_t old_size(getNumBonds());
+    const size_t n_blocks = (old_size + COMPACT_BLOCK_SIZE - 1) / COMPACT_BLOCK_SIZE;
+    const unsigned int* neighbors = m_neighbors.get();
+    std::vector<CompactBlock> blocks(n_blocks);
+    util::forLoopWrapper(0, n_blocks, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block)
+        {
+            const size_t block_end = std::min((block + 1) * COMPACT_BLOCK_SIZE, old_size);
+            for (size_t i = block * COMPACT_BLOCK_SIZE; i < block_end; ++i)
+            {
+                if (keep(i))
+                {
+                    ++blocks[block].num_kept;
+                    blocks[block].last_query_point = neighbors[2 * i];
+                }
+            }
+        }
+    });
 
-    // new_size is the number of good (unfiltered-out) elements
-    const unsigned int new_size(std::count(begin, end, true));
+    size_t new_size(0);
+    for (size_t block = 0; block < n_blocks; ++block)
+    {
+        blocks[block].first_output = new_size;
+        if (block > 0)
+        {
+            const CompactBlock& previous = blocks[block - 1];
+            blocks[block].has_previous = previous.has_previous || previous.num_kept != 0;
+            blocks[block].previous_query_point
+                = (previous.num_kept != 0) ? previous.last_query_point : previous.previous_query_point;
+        }
+        new_size += blocks[block].num_kept;
+    }
 
-    // Arrays to hold filtered data - we use new arrays instead of writing over
-    // existing data to avoid requiring a second pass in resize().
-    auto new_neighbors = util::ManagedArray<unsigned int>({new_size, 2});
-    auto new_distances = util::ManagedArray<float>(new_size);
-    auto new_weights = util::ManagedArray<float>(new_size);
+    // The segments and counts are only written if every query point index
+    // is valid, otherwise they are left to updateSegmentCounts as before.
+    const bool update_segments = m_num_query_points != 0
+        && std::all_of(blocks.cbegin(), blocks.cend(), [&](const CompactBlock& block) {
+               return block.num_kept == 0 || block.last_query_point < m_num_query_points;
+           });
+
+    const util::ScopedMemoryOwner owner("NeighborList");
+    // The filtered bonds are written to new arrays, whose buffers are recycled
+    // from those of previously released arrays, rather than over the existing
+    // data, which may still be referenced by exported arrays.
+    util::ManagedArray<unsigned int> new_neighbors;
+    new_neighbors.prepareForOverwrite({new_size, 2});
+    util::ManagedArray<float> new_distances;
+    new_distances.prepareForOverwrite(new_size);
+    util::ManagedArray<float> new_weights;
+    new_weights.prepareForOverwrite(new_size);
+    if (update_segments)
+    {
+        m_counts.prepare(m_num_query_points);
+        m_segments.prepare(m_num_query_points);
+    }
+
+    unsigned int* out_neighbors = new_neighbors.get();
+    float* out_distances = new_distances.get();
+    float* out_weights = new_weights.get();
+    const float* distances = m_distances.get();
+    const float* weights = m_weights.get();
+    unsigned int* counts = m_counts.get();
+    size_t* segments = m_segments.get();
+    util::forLoopWrapper(0, n_blocks, [&](size_t begin, size_t end) {
+        for (size_t block = begin; block < end; ++block)
+        {
+            CompactBlock& compact_block = blocks[block];
+            size_t output = compact_block.first_output;
+            bool has_last = compact_block.has_previous;
+            unsigned int last_query_point = compact_block.previous_query_point;
+            size_t run_start = output;
+            bool first_run = true;
+            const auto end_run = [&]() {
+                const auto run_length = static_cast<unsigned int>(output - run_start);
+                if (first_run)
+                {
+                    compact_block.boundary_runs[0] = {last_query_point, run_length};
+                    first_run = false;
+                }
+                else
+                {
+                    counts[last_query_point] = run_length;
+                }
+            };
+
+            const size_t block_end = std::min((block + 1) * COMPACT_BLOCK_SIZE, old_size);
+            for (size_t i = block * COMPACT_BLOCK_SIZE; i < block_end; ++i)
+            {
+                if (!keep(i))
+                {
+                    continue;
+                }
+                const unsigned int query_point = neighbors[2 * i];
+                if (update_segments && (!has_last || query_point != last_query_point))
+                {
+                    if (output != compact_block.first_output)
+                    {
+                        end_run();
+                    }
+                    segments[query_point] = output;
+                    run_start = output;
+                }
+                has_last = true;
+                last_query_point = query_point;
+                out_neighbors[2 * output] = query_point;
+                out_neighbors[2 * output + 1] = neighbors[2 * i + 1];
+                out_distances[output] = distances[i];
+                out_weights[output] = weights[i];
+                ++output;
+            }
+            if (update_segments && output != compact_block.first_output)
+            {
+                const auto run_length = static_cast<unsigned int>(output - run_start);
+                compact_block.boundary_runs[first_run ? 0 : 1] = {last_query_point, run_length};
+            }
+        }
+    });
 
-    auto current_element = begin;
-    unsigned int num_good(0);
-    for (unsigned int i(0); i < old_size; ++i)
+    if (update_segments)
     {
-        if (*current_element)
+        for (const CompactBlock& block : blocks)
         {
-            new_neighbors(num_good, 0) = m_neighbors(i, 0);
-            new_neighbors(num_good, 1) = m_neighbors(i, 1);
-            new_weights[num_good] = m_weights[i];
-            new_distances[num_good] = m_distances[i];
-            ++num_good;
+            for (const auto& run : block.boundary_runs)
+            {
+                counts[run.first] += run.second;
+            }
         }
-        ++current_element;
     }
 
     m_neighbors = new_neighbors;
     m_distances = new_distances;
     m_weights = new_weights;
-    m_segments_counts_updated = false;
+    m_segments_counts_updated = update_segments;
     return old_size - new_size;
 }
 
+// We are currently assuming that the input iterator has the correct length;
+// however, this is compatible with the original assumptions of this function
+// (pre-iterator syntax), so we'll accept that level of type-safety for now. In
+// the future, if we expose a more appropriate iterator API then we'll need to
+// accept an "end" parameter as well.
+template<typename Iterator> size_t NeighborList::filter(Iterator begin)
+{
+    return compact([&](size_t i) { return static_cast<bool>(begin[i]); });
+}
+
 // Explicit template instantiation required for usage in dynamically linked
 // Cython code.
-template unsigned int NeighborList::filter(std::vector<bool>::const_iterator);
-template unsigned int NeighborList::filter(std::vector<bool>::iterator);
-template unsigned int NeighborList::filter(const bool*);
-template unsigned int NeighborList::filter(bool*);
+template size_t NeighborList::filter(std::vector<bool>::const_iterator);
+template size_t NeighborList::filter(std::vector<bool>::iterator);
+template size_t NeighborList::filter(const bool*);
+template size_t NeighborList::filter(bool*);
 
-unsigned int NeighborList::filter_r(float r_max, float r_min)
+size_t NeighborList::filter_r(float r_max, float r_min)
 {
     if (r_max <= 0)
     {
@@ -265,15 +421,12 @@ unsigned int NeighborList::filter_r(float r_max, float r_min)
         throw std::invalid_argument("NeighborList.filter_r requires that r_max must be greater than r_min.");
     }
 
-    std::vector<bool> dist_filter(getNumBonds());
-    for (unsigned int i(0); i < getNumBonds(); ++i)
-    {
-        dist_filter[i] = (m_distances[i] >= r_min && m_distances[i] < r_max);
-    }
-    return filter(dist_filter.cbegin());
+    // The distances are tested while compacting instead of building a mask.
+    const float* distances = m_distances.get();
+    return compact([&](size_t i) { return distances[i] >= r_min && distances[i] < r_max; });
 }
 
-unsigned int NeighborList::find_first_index(unsigned int i) const
+size_t NeighborList::find_first_index(unsigned int i) const
 {
     if (getNumBonds() != 0)
     {
@@ -282,8 +435,9 @@ unsigned int NeighborList::find_first_index(unsigned int i) const
     return 0;
 }
 
-void NeighborList::resize(unsigned int num_bonds)
+void NeighborList::resize(size_t num_bonds)
 {
+    const util::ScopedMemoryOwner owner("NeighborList");
     auto new_neighbors = util::ManagedArray<unsigned int>({num_bonds, 2});
     auto new_distances = util::ManagedArray<float>(num_bonds);
     auto new_weights = util::ManagedArray<float>(num_bonds);
@@ -291,7 +445,7 @@ void NeighborList::resize(unsigned int num_bonds)
     // On shrinking resizes, keep existing data.
     if (num_bonds <= getNumBonds())
     {
-        for (unsigned int i = 0; i < num_bonds; i++)
+        for (size_t i = 0; i < num_bonds; i++)
         {
             new_neighbors(i, 0) = m_neighbors(i, 0);
             new_neighbors(i, 1) = m_neighbors(i, 1);
@@ -308,10 +462,12 @@ void NeighborList::resize(unsigned int num_bonds)
 
 void NeighborList::copy(const NeighborList& other)
 {
+    const util::ScopedMemoryOwner owner("NeighborList");
     setNumBonds(other.getNumBonds(), other.getNumQueryPoints(), other.getNumPoints());
     m_neighbors = other.m_neighbors.copy();
     m_weights = other.m_weights.copy();
     m_distances = other.m_distances.copy();
+    m_half_list = other.m_half_list;
     m_segments_counts_updated = false;
 }
 
@@ -329,56 +485,447 @@ void NeighborList::validate(unsigned int num_query_points, unsigned int num_poin
 
 void NeighborList::sort(bool by_distance = false)
 {
-    // create a vector of NeighborBonds from the Neighborlist entries
-    auto bond_vector = std::move(toBondVector());
-    auto num_bonds = bond_vector.size();
+    // Bonds are bucketed by query point with a counting sort of a permutation
+    // of the bond indices, and the bonds of each query point are then sorted
+    // by the remaining keys. Each array is finally gathered into its sorted
+    // order. This matches the orderings defined by NeighborBond::less_as_tuple
+    // and NeighborBond::less_as_distance without building a vector of bonds
+    // or comparing the query points of all bonds.
+    const util::ScopedMemoryOwner owner("NeighborList");
+    const size_t num_bonds = getNumBonds();
+    const unsigned int* neighbors = m_neighbors.get();
+    const float* distances = m_distances.get();
+    const float* weights = m_weights.get();
+
+    // Find the range of query point indices and whether the bonds are
+    // already ordered by query point, as the bonds of queries are.
+    tbb::enumerable_thread_specific<unsigned int> local_max_query_point(0);
+    std::atomic<bool> bucketed(true);
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+        unsigned int& max_query_point = local_max_query_point.local();
+        for (size_t bond = begin; bond < end; ++bond)
+        {
+            max_query_point = std::max(max_query_point, neighbors[2 * bond]);
+        }
+        const size_t last = std::min(end, num_bonds - 1);
+        for (size_t bond = begin; bond < last; ++bond)
+        {
+            if (neighbors[2 * bond] > neighbors[2 * bond + 2])
+            {
+                bucketed = false;
+                break;
+            }
+        }
+    });
+    const unsigned int max_query_point = local_max_query_point.combine(
+        [](unsigned int left, unsigned int right) { return std::max(left, right); });
+    const size_t num_keys = (num_bonds == 0) ? 0 : size_t(max_query_point) + 1;
 
-    // do parallel sort with tbb
+    // Count the bonds of each query point once per run of equal query points.
+    std::vector<std::atomic<size_t>> key_counts(num_keys);
+    util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+        for (size_t bond = begin; bond < end;)
+        {
+            const unsigned int key = neighbors[2 * bond];
+            const size_t run_begin = bond;
+            for (; bond < end && neighbors[2 * bond] == key; ++bond) {}
+            key_counts[key].fetch_add(bond - run_begin, std::memory_order_relaxed);
+        }
+    });
+    std::vector<size_t> key_offsets(num_keys + 1, 0);
+    for (size_t key = 0; key < num_keys; ++key)
+    {
+        key_offsets[key + 1] = key_offsets[key] + key_counts[key].load(std::memory_order_relaxed);
+    }
+
+    std::vector<size_t> order(num_bonds);
+    if (bucketed)
+    {
+        std::iota(order.begin(), order.end(), 0);
+    }
+    else
+    {
+        // Bonds are scattered to their buckets in no particular order, which
+        // is resolved by sorting each bucket by all remaining keys.
+        std::vector<std::atomic<size_t>> key_cursors(num_keys);
+        for (size_t key = 0; key < num_keys; ++key)
+        {
+            key_cursors[key].store(key_offsets[key], std::memory_order_relaxed);
+        }
+        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
+            for (size_t bond = begin; bond < end; ++bond)
+            {
+                order[key_cursors[neighbors[2 * bond]].fetch_add(1, std::memory_order_relaxed)] = bond;
+            }
+        });
+    }
+
+    // Buckets of bonds of a single query point far larger than the others
+    // are themselves sorted in parallel.
+    constexpr size_t PARALLEL_BUCKET_SIZE = size_t(1) << 16;
+    const auto sort_buckets = [&](const auto& compare) {
+        util::forLoopWrapper(0, num_keys, [&](size_t begin, size_t end) {
+            for (size_t key = begin; key < end; ++key)
+            {
+                const auto bucket_begin = order.begin() + key_offsets[key];
+                const auto bucket_end = order.begin() + key_offsets[key + 1];
+                if (bucket_end - bucket_begin > static_cast<std::ptrdiff_t>(PARALLEL_BUCKET_SIZE))
+                {
+                    tbb::parallel_sort(bucket_begin, bucket_end, compare);
+                }
+                else
+                {
+                    std::sort(bucket_begin, bucket_end, compare);
+                }
+            }
+        });
+    };
     if (by_distance)
     {
-        tbb::parallel_sort(bond_vector.begin(), bond_vector.end(), compareNeighborDistance);
+        sort_buckets([&](size_t left, size_t right) {
+            return std::tie(distances[left], neighbors[2 * left + 1], weights[left])
+                < std::tie(distances[right], neighbors[2 * right + 1], weights[right]);
+        });
     }
     else
     {
-        tbb::parallel_sort(bond_vector.begin(), bond_vector.end(), compareNeighborBond);
+        sort_buckets([&](size_t left, size_t right) {
+            return std::tie(neighbors[2 * left + 1], weights[left], distances[left])
+                < std::tie(neighbors[2 * right + 1], weights[right], distances[right]);
+        });
     }
 
-    // put the results back into this neighborlist
+    // put the results into new arrays so that we can gather in parallel
+    util::ManagedArray<unsigned int> new_neighbors;
+    new_neighbors.prepareForOverwrite({num_bonds, 2});
+    util::ManagedArray<float> new_distances;
+    new_distances.prepareForOverwrite(num_bonds);
+    util::ManagedArray<float> new_weights;
+    new_weights.prepareForOverwrite(num_bonds);
     util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
         for (auto bond = begin; bond < end; ++bond)
         {
-            auto nb = bond_vector[bond];
-            m_neighbors(bond, 0) = nb.query_point_idx;
-            m_neighbors(bond, 1) = nb.point_idx;
-            m_distances(bond) = nb.distance;
-            m_weights(bond) = nb.weight;
+            const size_t old_bond = order[bond];
+            new_neighbors(bond, 0) = neighbors[2 * old_bond];
+            new_neighbors(bond, 1) = neighbors[2 * old_bond + 1];
+            new_distances[bond] = distances[old_bond];
+            new_weights[bond] = weights[old_bond];
         }
     });
+
+    m_neighbors = new_neighbors;
+    m_distances = new_distances;
+    m_weights = new_weights;
+
+    // The buckets are the segments and counts of the sorted bonds.
+    m_segments_counts_updated = m_num_query_points != 0 && num_keys <= m_num_query_points;
+    if (m_segments_counts_updated)
+    {
+        m_counts.prepare(m_num_query_points);
+        m_segments.prepare(m_num_query_points);
+        for (size_t key = 0; key < num_keys; ++key)
+        {
+            if (key_offsets[key + 1] != key_offsets[key])
+            {
+                m_counts[key] = static_cast<unsigned int>(key_offsets[key + 1] - key_offsets[key]);
+                m_segments[key] = key_offsets[key];
+            }
+        }
+    }
 }
 
-std::vector<NeighborBond> NeighborList::toBondVector() const
+namespace {
+
+//! Identifier at the start of every NeighborList file
+constexpr char NEIGHBOR_LIST_FILE_MAGIC[8] = {'F', 'R', 'E', 'U', 'D', 'N', 'L', '\0'};
+//! Version of the NeighborList file layout, incremented on any incompatible change
+constexpr uint32_t NEIGHBOR_LIST_FILE_VERSION = 1;
+//! Value whose stored representation reveals the byte order of the writing machine
+constexpr uint32_t NEIGHBOR_LIST_FILE_BYTE_ORDER = 0x01020304;
+//! Alignment of each array in the file, in bytes
+constexpr uint64_t NEIGHBOR_LIST_FILE_ALIGNMENT = 64;
+
+//! Arrays stored in a NeighborList file, in file order
+enum NeighborListFileArray
+{
+    NEIGHBORS,
+    DISTANCES,
+    WEIGHTS,
+    COUNTS,
+    SEGMENTS,
+    NUM_ARRAYS
+};
+
+//! Header at the start of a NeighborList file
+struct NeighborListFileHeader
 {
-    auto num_bonds = m_distances.size();
-    std::vector<NeighborBond> bond_vector(num_bonds);
+    char magic[8];                //!< NEIGHBOR_LIST_FILE_MAGIC
+    uint32_t version;             //!< NEIGHBOR_LIST_FILE_VERSION
+    uint32_t byte_order;          //!< NEIGHBOR_LIST_FILE_BYTE_ORDER
+    uint64_t file_size;           //!< Total size of the file, to detect truncation
+    uint64_t num_bonds;           //!< Number of bonds
+    uint32_t num_query_points;    //!< Number of query points
+    uint32_t num_points;          //!< Number of points
+    uint32_t half_list;           //!< Whether the list is a half list
+    uint32_t size_t_size;         //!< Width of the stored segments
+    uint64_t offsets[NUM_ARRAYS]; //!< Offset of each array from the start of the file
+    uint64_t sizes[NUM_ARRAYS];   //!< Size of each array in bytes
+};
+
+uint64_t alignFileOffset(uint64_t offset)
+{
+    return (offset + NEIGHBOR_LIST_FILE_ALIGNMENT - 1) / NEIGHBOR_LIST_FILE_ALIGNMENT
+        * NEIGHBOR_LIST_FILE_ALIGNMENT;
+}
+
+//! Read-write, private view of the contents of a file
+/*! On POSIX systems the file is memory-mapped copy-on-write, so that the
+ *  contents are paged in on demand and writes never reach the file. Elsewhere
+ *  the file is read into memory.
+ */
+class MappedFile
+{
+public:
+    explicit MappedFile(const std::string& filename)
+    {
+#ifdef _WIN32
+        std::ifstream file(filename, std::ios::binary | std::ios::ate);
+        if (!file)
+        {
+            throw std::runtime_error("Could not open NeighborList file " + filename + ".");
+        }
+        m_size = static_cast<size_t>(file.tellg());
+        m_buffer = std::make_unique<char[]>(m_size); // NOLINT(modernize-avoid-c-arrays)
+        file.seekg(0);
+        if (!file.read(m_buffer.get(), static_cast<std::streamsize>(m_size)))
+        {
+            throw std::runtime_error("Could not read NeighborList file " + filename + ".");
+        }
+        m_data = m_buffer.get();
+#else
+        const int fd = open(filename.c_str(), O_RDONLY);
+        if (fd == -1)
+        {
+            throw std::runtime_error("Could not open NeighborList file " + filename + ".");
+        }
+        struct stat file_stat;
+        if (fstat(fd, &file_stat) != 0)
+        {
+            close(fd);
+            throw std::runtime_error("Could not read NeighborList file " + filename + ".");
+        }
+        m_size = static_cast<size_t>(file_stat.st_size);
+        if (m_size != 0)
+        {
+            void* data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+            if (data == MAP_FAILED)
+            {
+                close(fd);
+                throw std::runtime_error("Could not map NeighborList file " + filename + ".");
+            }
+            m_data = static_cast<char*>(data);
+        }
+        // The mapping stays valid after the descriptor is closed.
+        close(fd);
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if (m_data != nullptr)
+        {
+            munmap(m_data, m_size);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    char* data() const
+    {
+        return m_data;
+    }
+
+    size_t size() const
+    {
+        return m_size;
+    }
+
+private:
+    char* m_data {nullptr}; //!< Start of the contents
+    size_t m_size {0};      //!< Size of the contents in bytes
+#ifdef _WIN32
+    std::unique_ptr<char[]> m_buffer; //!< Copy of the contents // NOLINT(modernize-avoid-c-arrays)
+#endif
+};
+
+//! Check that the bonds of a loaded file are sorted by query point, with valid indices, segments and counts.
+/*! The arrays of a file are used without copying them, so a corrupted file
+ *  must be rejected before out-of-bounds indices reach the computes.
+ */
+bool validBonds(const unsigned int* neighbors, const unsigned int* counts, const size_t* segments,
+                size_t num_bonds, unsigned int num_query_points, unsigned int num_points)
+{
+    // The bonds of each query point are consecutive, so only its first and
+    // last bonds are compared with its segment and count.
+    std::atomic<bool> valid {true};
     util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
-        for (auto bond_idx = begin; bond_idx < end; ++bond_idx)
+        for (size_t bond = begin; bond < end && valid.load(std::memory_order_relaxed); ++bond)
         {
-            NeighborBond nb(m_neighbors(bond_idx, 0), m_neighbors(bond_idx, 1), m_distances(bond_idx),
-                            m_weights(bond_idx));
-            bond_vector[bond_idx] = nb;
+            const unsigned int query_point_idx = neighbors[2 * bond];
+            const bool first = bond == 0 || neighbors[2 * (bond - 1)] != query_point_idx;
+            const bool last = bond + 1 == num_bonds || neighbors[2 * (bond + 1)] != query_point_idx;
+            if (query_point_idx >= num_query_points || neighbors[2 * bond + 1] >= num_points
+                || (bond != 0 && neighbors[2 * (bond - 1)] > query_point_idx)
+                || (first && segments[query_point_idx] != bond)
+                || (last && segments[query_point_idx] + counts[query_point_idx] != bond + 1))
+            {
+                valid.store(false, std::memory_order_relaxed);
+            }
         }
     });
-    return bond_vector;
+
+    // Query points without bonds must have no count.
+    const uint64_t total_count = std::accumulate(counts, counts + num_query_points, uint64_t(0));
+    return valid.load() && total_count == num_bonds;
+}
+
+//! Create an array sharing ownership of the file it points into.
+template<typename T>
+util::ManagedArray<T> mapArray(const std::shared_ptr<MappedFile>& file, uint64_t offset,
+                               const std::vector<size_t>& shape)
+{
+    return util::ManagedArray<T>(std::shared_ptr<T>(file, reinterpret_cast<T*>(file->data() + offset)),
+                                 shape);
+}
+
+} // namespace
+
+void NeighborList::save(const std::string& filename) const
+{
+    updateSegmentCounts();
+
+    NeighborListFileHeader header {};
+    std::memcpy(header.magic, NEIGHBOR_LIST_FILE_MAGIC, sizeof(header.magic));
+    header.version = NEIGHBOR_LIST_FILE_VERSION;
+    header.byte_order = NEIGHBOR_LIST_FILE_BYTE_ORDER;
+    header.num_bonds = getNumBonds();
+    header.num_query_points = m_num_query_points;
+    header.num_points = m_num_points;
+    header.half_list = static_cast<uint32_t>(m_half_list);
+    header.size_t_size = sizeof(size_t);
+
+    std::array<const char*, NUM_ARRAYS> data {};
+    data[NEIGHBORS] = reinterpret_cast<const char*>(m_neighbors.get());
+    data[DISTANCES] = reinterpret_cast<const char*>(m_distances.get());
+    data[WEIGHTS] = reinterpret_cast<const char*>(m_weights.get());
+    data[COUNTS] = reinterpret_cast<const char*>(m_counts.get());
+    data[SEGMENTS] = reinterpret_cast<const char*>(m_segments.get());
+    header.sizes[NEIGHBORS] = m_neighbors.size() * sizeof(unsigned int);
+    header.sizes[DISTANCES] = m_distances.size() * sizeof(float);
+    header.sizes[WEIGHTS] = m_weights.size() * sizeof(float);
+    header.sizes[COUNTS] = m_counts.size() * sizeof(unsigned int);
+    header.sizes[SEGMENTS] = m_segments.size() * sizeof(size_t);
+
+    uint64_t offset = sizeof(header);
+    for (unsigned int array = 0; array < NUM_ARRAYS; ++array)
+    {
+        header.offsets[array] = alignFileOffset(offset);
+        offset = header.offsets[array] + header.sizes[array];
+    }
+    header.file_size = offset;
+
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    offset = sizeof(header);
+    const std::array<char, NEIGHBOR_LIST_FILE_ALIGNMENT> padding {};
+    for (unsigned int array = 0; array < NUM_ARRAYS; ++array)
+    {
+        file.write(padding.data(), static_cast<std::streamsize>(header.offsets[array] - offset));
+        file.write(data[array], static_cast<std::streamsize>(header.sizes[array]));
+        offset = header.offsets[array] + header.sizes[array];
+    }
+    file.close();
+    if (!file)
+    {
+        throw std::runtime_error("Could not write NeighborList file " + filename + ".");
+    }
+}
+
+NeighborList* NeighborList::load(const std::string& filename)
+{
+    const auto file = std::make_shared<MappedFile>(filename);
+
+    NeighborListFileHeader header {};
+    if (file->size() < sizeof(header)
+        || std::memcmp(file->data(), NEIGHBOR_LIST_FILE_MAGIC, sizeof(header.magic)) != 0)
+    {
+        throw std::runtime_error(filename + " is not a NeighborList file.");
+    }
+    std::memcpy(&header, file->data(), sizeof(header));
+    if (header.byte_order != NEIGHBOR_LIST_FILE_BYTE_ORDER || header.size_t_size != sizeof(size_t))
+    {
+        throw std::runtime_error("NeighborList file " + filename
+                                 + " was written on a machine with an incompatible data layout.");
+    }
+    if (header.version != NEIGHBOR_LIST_FILE_VERSION)
+    {
+        throw std::runtime_error("NeighborList file " + filename + " has unsupported version "
+                                 + std::to_string(header.version) + ".");
+    }
+
+    const std::array<uint64_t, NUM_ARRAYS> expected_sizes {
+        header.num_bonds * 2 * sizeof(unsigned int), header.num_bonds * sizeof(float),
+        header.num_bonds * sizeof(float), uint64_t(header.num_query_points) * sizeof(unsigned int),
+        uint64_t(header.num_query_points) * sizeof(size_t)};
+    bool valid = header.file_size == file->size()
+        && header.num_bonds <= file->size() / (2 * sizeof(unsigned int));
+    for (unsigned int array = 0; array < NUM_ARRAYS; ++array)
+    {
+        valid = valid && header.sizes[array] == expected_sizes[array]
+            && header.offsets[array] % NEIGHBOR_LIST_FILE_ALIGNMENT == 0
+            && header.offsets[array] <= file->size()
+            && header.sizes[array] <= file->size() - header.offsets[array];
+    }
+    if (!valid)
+    {
+        throw std::runtime_error("NeighborList file " + filename + " is truncated or corrupted.");
+    }
+
+    const size_t num_bonds = header.num_bonds;
+    if (!validBonds(reinterpret_cast<const unsigned int*>(file->data() + header.offsets[NEIGHBORS]),
+                    reinterpret_cast<const unsigned int*>(file->data() + header.offsets[COUNTS]),
+                    reinterpret_cast<const size_t*>(file->data() + header.offsets[SEGMENTS]), num_bonds,
+                    header.num_query_points, header.num_points))
+    {
+        throw std::runtime_error("NeighborList file " + filename
+                                 + " has bonds that are unsorted, out of range, or inconsistent with "
+                                   "its segments.");
+    }
+
+    auto nlist = std::make_unique<NeighborList>();
+    nlist->m_num_query_points = header.num_query_points;
+    nlist->m_num_points = header.num_points;
+    nlist->m_half_list = header.half_list != 0;
+    nlist->m_neighbors = mapArray<unsigned int>(file, header.offsets[NEIGHBORS], {num_bonds, 2});
+    nlist->m_distances = mapArray<float>(file, header.offsets[DISTANCES], {num_bonds});
+    nlist->m_weights = mapArray<float>(file, header.offsets[WEIGHTS], {num_bonds});
+    nlist->m_counts = mapArray<unsigned int>(file, header.offsets[COUNTS], {header.num_query_points});
+    nlist->m_segments = mapArray<size_t>(file, header.offsets[SEGMENTS], {header.num_query_points});
+    nlist->m_segments_counts_updated = true;
+    return nlist.release();
 }
 
-unsigned int NeighborList::bisection_search(unsigned int val, unsigned int left, unsigned int right) const
+size_t NeighborList::bisection_search(unsigned int val, size_t left, size_t right) const
 {
     if (left + 1 >= right)
     {
         return left;
     }
 
-    unsigned int middle((left + right) / 2);
+    size_t middle(left + (right - left) / 2);
 
     if (m_neighbors(middle, 0) < val)
     {
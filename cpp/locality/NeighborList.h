@@ -4,6 +4,8 @@
 #ifndef NEIGHBOR_LIST_H
 #define NEIGHBOR_LIST_H
 
+#include <mutex>
+#include <string>
 #include <vector>
 
 #include "Box.h"
@@ -23,6 +25,10 @@ namespace freud { namespace locality {
 
     Query point and point indices are stored in a 2D array m_neighbors of shape
     (n_bonds, 2). The distances and weights arrays are flat per-bond arrays.
+    Bond counts and bond indices are 64-bit (size_t) so that lists with more
+    than 2^32 bonds can be represented, while point indices remain 32-bit.
+    Operations that reorder or filter bonds work on these arrays directly
+    rather than converting to and from vectors of NeighborBond.
  */
 class NeighborList
 {
@@ -30,11 +36,11 @@ public:
     //! Default constructor
     NeighborList();
     //! Create a NeighborList that can hold up to the given number of bonds
-    explicit NeighborList(unsigned int num_bonds);
+    explicit NeighborList(size_t num_bonds);
     //! Copy constructor (makes a deep copy)
     NeighborList(const NeighborList& other);
     //! Construct from arrays
-    NeighborList(unsigned int num_bonds, const unsigned int* query_point_index, unsigned int num_query_points,
+    NeighborList(size_t num_bonds, const unsigned int* query_point_index, unsigned int num_query_points,
                  const unsigned int* point_index, unsigned int num_points, const float* distances,
                  const float* weights);
     //! Make a neighborlist where all points, excluding ii, are pairs
@@ -45,17 +51,29 @@ public:
     explicit NeighborList(std::vector<NeighborBond> bonds);
 
     //! Return the number of bonds stored in this NeighborList
-    unsigned int getNumBonds() const;
+    size_t getNumBonds() const;
     //! Return the number of query points this NeighborList was built with
     unsigned int getNumQueryPoints() const;
     //! Return the number of points this NeighborList was built with
     unsigned int getNumPoints() const;
 
     //! Set the number of bonds, query points, and points for this NeighborList object
-    void setNumBonds(unsigned int num_bonds, unsigned int num_query_points, unsigned int num_points);
+    void setNumBonds(size_t num_bonds, unsigned int num_query_points, unsigned int num_points);
     //! Update the arrays of neighbor counts and segments
     void updateSegmentCounts() const;
 
+    //! Whether this NeighborList only contains one of the bonds (i, j) and (j, i) of a symmetric query
+    bool isHalfList() const
+    {
+        return m_half_list;
+    }
+
+    //! Set whether this NeighborList only contains one of the bonds (i, j) and (j, i) of a symmetric query
+    void setHalfList(bool half_list)
+    {
+        m_half_list = half_list;
+    }
+
     //! Access the neighbors array for reading and writing
     util::ManagedArray<unsigned int>& getNeighbors()
     {
@@ -78,7 +96,7 @@ public:
         return m_counts;
     }
     //! Access the segments array for reading
-    util::ManagedArray<unsigned int>& getSegments()
+    util::ManagedArray<size_t>& getSegments()
     {
         updateSegmentCounts();
         return m_segments;
@@ -106,7 +124,7 @@ public:
         return m_counts;
     }
     //! Access the segments array for reading
-    const util::ManagedArray<unsigned int>& getSegments() const
+    const util::ManagedArray<size_t>& getSegments() const
     {
         updateSegmentCounts();
         return m_segments;
@@ -114,17 +132,18 @@ public:
 
     //! Remove bonds in this object based on an array of boolean values. The
     //  array must be at least as long as the number of neighbor bonds.
-    //  Returns the number of bonds removed.
-    template<typename Iterator> unsigned int filter(Iterator begin);
+    //  Returns the number of bonds removed. The bonds are compacted in
+    //  parallel, and the segments and counts are updated in the same pass.
+    template<typename Iterator> size_t filter(Iterator begin);
     //! Remove bonds in this object based on minimum and maximum distance
     //  constraints. Returns the number of bonds removed.
-    unsigned int filter_r(float r_max, float r_min = 0);
+    size_t filter_r(float r_max, float r_min = 0);
 
     //! Return the first bond index corresponding to point i
-    unsigned int find_first_index(unsigned int i) const;
+    size_t find_first_index(unsigned int i) const;
 
     //! Resize member arrays to a different size
-    void resize(unsigned int num_bonds);
+    void resize(size_t num_bonds);
 
     //! Copy the bonds from another NeighborList object
     void copy(const NeighborList& other);
@@ -134,12 +153,63 @@ public:
     // sort the neighborlist
     void sort(bool by_distance);
 
+    //! Write the bonds, segments, and counts of this NeighborList to a binary file
+    /*! The file stores each array in its in-memory layout at an aligned
+     *  offset, so that load() can use the arrays directly from a memory
+     *  mapping of the file. Files are only portable between machines with the
+     *  same byte order and size_t width.
+     *
+     *  \param filename The file to write.
+     */
+    void save(const std::string& filename) const;
+
+    //! Read a NeighborList from a file written by save()
+    /*! Where supported, the file is memory-mapped privately and the arrays of
+     *  the returned NeighborList point directly into the mapping, so loading
+     *  does not read or copy any bonds. Pages are only read from disk when
+     *  they are accessed and are shared between all processes mapping the same
+     *  file. Modifying the returned NeighborList never changes the file. The
+     *  mapping remains valid until the NeighborList and all arrays sharing its
+     *  data have been destroyed, so the file must not be modified meanwhile.
+     *
+     *  \param filename The file to read.
+     *  \returns A new NeighborList owned by the caller.
+     */
+    static NeighborList* load(const std::string& filename);
+
 private:
+    //! Mutex serializing the lazy updates of the segments and counts of one list.
+    /*! NeighborLists may be shared by computes running concurrently in
+     *  different threads. Copies of a list update their own segments and
+     *  counts, so copying or assigning a list gives the target a mutex of
+     *  its own instead of copying the mutex.
+     */
+    class SegmentCountsMutex
+    {
+    public:
+        SegmentCountsMutex() = default;
+
+        SegmentCountsMutex(const SegmentCountsMutex& /*other*/) {}
+
+        SegmentCountsMutex& operator=(const SegmentCountsMutex& /*other*/)
+        {
+            return *this;
+        }
+
+        std::mutex& get() const
+        {
+            return m_mutex;
+        }
+
+    private:
+        mutable std::mutex m_mutex;
+    };
+
     //! Helper method for bisection search of the neighbor list, used in find_first_index
-    unsigned int bisection_search(unsigned int val, unsigned int left, unsigned int right) const;
+    size_t bisection_search(unsigned int val, size_t left, size_t right) const;
 
-    //! Helper method to get an equivalent list of NeighborBonds from the nlist
-    std::vector<NeighborBond> toBondVector() const;
+    //! Keep the bonds i for which keep(i) is true, preserving their order, and return the number removed
+    template<typename Keep> size_t compact(const Keep& keep);
 
     //! Number of query points
     unsigned int m_num_query_points;
@@ -151,13 +221,17 @@ private:
     util::ManagedArray<float> m_distances;
     //! Neighbor list per-bond weight array
     util::ManagedArray<float> m_weights;
+    //! Whether only bonds with query point index less than point index are stored
+    bool m_half_list {false};
 
     //! Track whether segments and counts are up to date
     mutable bool m_segments_counts_updated;
+    //! Serializes the lazy updates of the segments and counts of this list
+    SegmentCountsMutex m_segment_counts_mutex;
     //! Neighbor counts for each query point
     mutable util::ManagedArray<unsigned int> m_counts;
     //! Neighbor segments for each query point
-    mutable util::ManagedArray<unsigned int> m_segments;
+    mutable util::ManagedArray<size_t> m_segments;
 };
 
 bool compareNeighborBond(const NeighborBond& left, const NeighborBond& right);
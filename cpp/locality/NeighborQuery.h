@@ -4,13 +4,18 @@
 #ifndef NEIGHBOR_QUERY_H
 #define NEIGHBOR_QUERY_H
 
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <numeric>
 #include <stdexcept>
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_sort.h>
 #include <utility>
+#include <vector>
 
 #include "Box.h"
+#include "Instrumentation.h"
 #include "NeighborBond.h"
 #include "NeighborList.h"
 #include "NeighborPerPointIterator.h"
@@ -38,6 +43,8 @@ constexpr float DEFAULT_R_MIN(0);                         //!< Default minimum q
 constexpr float DEFAULT_R_GUESS(-1.0);                    //!< Default guess query distance.
 constexpr float DEFAULT_SCALE(-1.0);      //!< Default scaling parameter for AABB nearest neighbor queries.
 constexpr bool DEFAULT_EXCLUDE_II(false); //!< Default for whether or not to include self-neighbors.
+constexpr bool DEFAULT_HALF_LIST(false);  //!< Default for whether to only find bonds with i < j.
+constexpr bool DEFAULT_ALL_IMAGES(false); //!< Default for whether to find bonds to all periodic images.
 constexpr auto ITERATOR_TERMINATOR
     = NeighborBond(-1, -1, 0); //!< The object returned when iteration is complete.
 
@@ -60,12 +67,41 @@ struct QueryArgs
     float scale {DEFAULT_SCALE};          //! The scale factor to use when performing repeated ball queries
                                           //! to find a specified number of nearest neighbors.
     bool exclude_ii {DEFAULT_EXCLUDE_II}; //! If true, exclude self-neighbors.
+    bool half_list {DEFAULT_HALF_LIST};   //! If true, only find bonds whose query point index is less
+                                          //! than the point index (for symmetric self-queries).
+    bool all_images {DEFAULT_ALL_IMAGES}; //! If true, find a bond to every periodic image of a point within
+                                          //! r_max, which may then exceed half the box.
 };
 
 // Forward declare the iterators
 class NeighborQueryIterator;
 class NeighborQueryPerPointIterator;
 
+//! \internal
+//! Number of bits per dimension used for Morton codes when spatially sorting points.
+const unsigned int MORTON_BITS_PER_DIM = 21;
+
+//! \internal
+//! Compute the 3D Morton (Z-order) code of a point in fractional box coordinates.
+/*! Each fractional coordinate is clamped to [0, 1), quantized to
+ *  MORTON_BITS_PER_DIM bits, and the bits of the three coordinates are
+ *  interleaved.
+ */
+inline uint64_t mortonCode(const vec3<float>& fractional)
+{
+    const auto max_cell = static_cast<float>((uint64_t(1) << MORTON_BITS_PER_DIM) - 1);
+    const auto spread = [max_cell](float x) {
+        auto v = static_cast<uint64_t>(std::min(std::max(x, 0.0F), 1.0F) * max_cell);
+        v = (v | (v << 32)) & 0x1f00000000ffffULL;
+        v = (v | (v << 16)) & 0x1f0000ff0000ffULL;
+        v = (v | (v << 8)) & 0x100f00f00f00f00fULL;
+        v = (v | (v << 4)) & 0x10c30c30c30c30c3ULL;
+        v = (v | (v << 2)) & 0x1249249249249249ULL;
+        return v;
+    };
+    return spread(fractional.x) | (spread(fractional.y) << 1) | (spread(fractional.z) << 2);
+}
+
 //! Parent data structure for all neighbor finding algorithms.
 /*! This class defines the API for all data structures for accelerating
  *  neighbor finding. The object encapsulates a set of points and a system box
@@ -81,25 +117,9 @@ public:
 
     //! Constructor
     NeighborQuery(box::Box box, const vec3<float>* points, unsigned int n_points)
-        : m_box(std::move(box)), m_points(points), m_n_points(n_points)
+        : m_box(std::move(box)), m_points(points), m_n_points(n_points), m_search_points(points)
     {
-        // Reject systems with 0 particles
-        if (m_n_points == 0)
-        {
-            throw std::invalid_argument("Cannot create a NeighborQuery with 0 particles.");
-        }
-
-        // For 2D systems, check if any z-coordinates are outside some tolerance of z=0
-        if (m_box.is2D())
-        {
-            for (unsigned int i(0); i < n_points; i++)
-            {
-                if (std::abs(m_points[i].z) > 1e-6)
-                {
-                    throw std::invalid_argument("A point with z != 0 was provided in a 2D box.");
-                }
-            }
-        }
+        validatePoints(points, n_points);
     }
 
     //! Empty Destructor
@@ -174,7 +194,103 @@ public:
         return m_points[index];
     }
 
+    //! Get the points in the order used by the search data structure
+    /*! If the points are spatially sorted, this is a reordered copy of the
+     *  points; otherwise it is the same as getPoints. Indices into this array
+     *  must be mapped back to point indices with getPointIndex.
+     */
+    const vec3<float>* getSearchPoints() const
+    {
+        return m_search_points;
+    }
+
+    //! Map an index into the search points back to the index of the point
+    unsigned int getPointIndex(unsigned int search_index) const
+    {
+        return m_spatial_order.empty() ? search_index : m_spatial_order[search_index];
+    }
+
+    //! Whether the points have been reordered along a space-filling curve
+    bool isSpatiallySorted() const
+    {
+        return !m_spatial_order.empty();
+    }
+
+    //! Get the point indices in spatially sorted order (empty if not sorted)
+    const std::vector<unsigned int>& getSpatialOrder() const
+    {
+        return m_spatial_order;
+    }
+
 protected:
+    //! Reorder a copy of the points along a Morton curve.
+    /*! Subclasses that support spatial sorting call this before building
+     *  their search data structure from getSearchPoints. Neighbors that are
+     *  close in space are then also close in memory, which greatly reduces
+     *  cache misses when the input points are not spatially ordered.
+     */
+    void sortPoints()
+    {
+        std::vector<std::pair<uint64_t, unsigned int>> keys(m_n_points);
+        util::forLoopWrapper(0, m_n_points, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                keys[i] = {mortonCode(m_box.makeFractional(m_points[i])), i};
+            }
+        });
+        util::executeInThreadArena([&]() { tbb::parallel_sort(keys.begin(), keys.end()); });
+
+        m_spatial_order.resize(m_n_points);
+        for (unsigned int i = 0; i < m_n_points; ++i)
+        {
+            m_spatial_order[i] = keys[i].second;
+        }
+        updateSortedPoints();
+    }
+
+    //! Refresh the sorted copy of the points from m_points in the existing order.
+    void updateSortedPoints()
+    {
+        if (m_spatial_order.empty())
+        {
+            m_search_points = m_points;
+            return;
+        }
+        m_sorted_points.resize(m_n_points);
+        util::forLoopWrapper(0, m_n_points, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                m_sorted_points[i] = m_points[m_spatial_order[i]];
+            }
+        });
+        m_search_points = m_sorted_points.data();
+    }
+
+    //! Validate a set of points for use with this NeighborQuery's box.
+    /*! \param points The point coordinates.
+     *  \param n_points The number of points.
+     */
+    void validatePoints(const vec3<float>* points, unsigned int n_points) const
+    {
+        // Reject systems with 0 particles
+        if (n_points == 0)
+        {
+            throw std::invalid_argument("Cannot create a NeighborQuery with 0 particles.");
+        }
+
+        // For 2D systems, check if any z-coordinates are outside some tolerance of z=0
+        if (m_box.is2D())
+        {
+            for (unsigned int i(0); i < n_points; i++)
+            {
+                if (std::abs(points[i].z) > 1e-6)
+                {
+                    throw std::invalid_argument("A point with z != 0 was provided in a 2D box.");
+                }
+            }
+        }
+    }
+
     //! Validate the combination of specified arguments.
     /*! Before checking if the combination of parameters currently set is
      *  valid, this function first attempts to infer a mode if one is not set in
@@ -198,9 +314,21 @@ protected:
                 throw std::runtime_error(
                     "You cannot set num_neighbors in the query arguments when performing ball queries.");
             }
+            if (args.all_images && args.half_list)
+            {
+                throw std::runtime_error("Half neighbor lists cannot be found with all periodic images.");
+            }
         }
         else if (args.mode == QueryType::nearest)
         {
+            if (args.half_list)
+            {
+                throw std::runtime_error("Half neighbor lists are only supported for ball queries.");
+            }
+            if (args.all_images)
+            {
+                throw std::runtime_error("Bonds to all periodic images are only supported for ball queries.");
+            }
             if (args.num_neighbors == DEFAULT_NUM_NEIGHBORS)
             {
                 throw std::runtime_error("You must set num_neighbors in the query arguments when performing "
@@ -242,6 +370,10 @@ protected:
     const box::Box m_box;        //!< Simulation box where the particles belong.
     const vec3<float>* m_points; //!< Point coordinates.
     unsigned int m_n_points;     //!< Number of points.
+
+    const vec3<float>* m_search_points {nullptr};  //!< Points in the order used for searching.
+    std::vector<vec3<float>> m_sorted_points;      //!< Spatially sorted copy of the points.
+    std::vector<unsigned int> m_spatial_order;     //!< Point index of each spatially sorted point.
 };
 
 //! Implementation of per-point finding logic for NeighborQuery objects.
@@ -261,10 +393,11 @@ public:
 
     //! Constructor
     NeighborQueryPerPointIterator(const NeighborQuery* neighbor_query, const vec3<float>& query_point,
-                                  unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii)
+                                  unsigned int query_point_idx, float r_max, float r_min, bool exclude_ii,
+                                  bool half_list = false)
         : NeighborPerPointIterator(query_point_idx), m_neighbor_query(neighbor_query),
           m_query_point(query_point), m_finished(false), m_r_max(r_max), m_r_min(r_min),
-          m_exclude_ii(exclude_ii)
+          m_exclude_ii(exclude_ii), m_half_list(half_list)
     {
         if (r_max <= 0)
         {
@@ -289,12 +422,20 @@ public:
     NeighborBond next() override = 0;
 
 protected:
+    //! Whether the point with the given index is excluded by exclude_ii or half_list.
+    bool isExcluded(unsigned int point_idx) const
+    {
+        return (m_exclude_ii && m_query_point_idx == point_idx)
+            || (m_half_list && point_idx <= m_query_point_idx);
+    }
+
     const NeighborQuery* m_neighbor_query;       //!< Link to the NeighborQuery object.
     const vec3<float> m_query_point = {0, 0, 0}; //!< Coordinates of the query point.
     bool m_finished; //!< Flag to indicate that iteration is complete (must be set by next() on termination).
     float m_r_max;   //!< Cutoff distance for neighbors.
     float m_r_min;   //!< Minimum distance for neighbors.
     bool m_exclude_ii; //!< Flag to indicate whether or not to include self bonds.
+    bool m_half_list;  //!< Flag to indicate whether to only include bonds with query_point_idx < point_idx.
 };
 
 //! The iterator class for neighbor queries on NeighborQuery objects.
@@ -336,6 +477,12 @@ public:
         return m_neighbor_query->querySingle(m_query_points[i], i, m_qargs);
     }
 
+    //! Get the validated query arguments used by this iterator.
+    const QueryArgs& getQueryArgs() const
+    {
+        return m_qargs;
+    }
+
     //! Get the next element.
     NeighborBond next()
     {
@@ -367,12 +514,18 @@ public:
     }
 
     //! Generate a NeighborList from query.
-    /*! This function exploits parallelism by finding the neighbors for
-     *  each query point in parallel and adding them to a list, which is
-     *  then sorted in parallel as well before being added to the
-     *  NeighborList object. Right now this won't be backwards compatible
-     *  because the kn query is not symmetric, so even if we reverse the
-     *  output order here the actual neighbors found will be different.
+    /*! This function builds the NeighborList in a single parallel pass over
+     *  the query points. Each range of query points processed by a thread
+     *  buffers the bonds of its points in order, sorting the bonds of each
+     *  point as they are found, and records the number of bonds of each
+     *  point. An exclusive scan of these counts gives the first bond index of
+     *  every query point, and the buffered bonds of each range are then
+     *  copied into their contiguous segment of the output arrays in
+     *  parallel. Since segments are already ordered by query point, no
+     *  global sort is needed, and every query runs once.
+     *  Right now this won't be backwards compatible because the kn query is
+     *  not symmetric, so even if we reverse the output order here the actual
+     *  neighbors found will be different.
      *
      *  This function returns a pointer, not a shared pointer, so the
      *  caller is responsible for deleting it. The reason for this is that
@@ -381,49 +534,83 @@ public:
      */
     NeighborList* toNeighborList(bool sort_by_distance = false)
     {
-        using BondVector = tbb::enumerable_thread_specific<std::vector<NeighborBond>>;
-        BondVector bonds;
+        util::ScopedPhase phase("NeighborQuery::query");
+        const util::ScopedMemoryOwner owner("NeighborList");
+
+        // The bonds of a range of consecutive query points, in the order of
+        // the query points.
+        struct RangeBonds
+        {
+            size_t begin;
+            std::vector<NeighborBond> bonds;
+        };
+        using RangeBondsVector = tbb::enumerable_thread_specific<std::vector<RangeBonds>>;
+        RangeBondsVector range_bonds;
+
+        // Find and buffer the bonds of each query point, counting them.
+        std::vector<size_t> segments(m_num_query_points + 1, 0);
         util::forLoopWrapper(0, m_num_query_points, [&](size_t begin, size_t end) {
-            BondVector::reference local_bonds(bonds.local());
+            RangeBonds local_range {begin, {}};
+            std::vector<NeighborBond>& local_bonds = local_range.bonds;
             NeighborBond nb;
             for (size_t i = begin; i < end; ++i)
             {
+                const size_t first_bond = local_bonds.size();
                 std::shared_ptr<NeighborQueryPerPointIterator> it = this->query(i);
                 while (!it->end())
                 {
+                    // If we're excluding ii bonds, we have to check before storing.
                     nb = it->next();
-                    // If we're excluding ii bonds, we have to check before adding.
                     if (nb != ITERATOR_TERMINATOR)
                     {
                         local_bonds.emplace_back(nb.query_point_idx, nb.point_idx, nb.distance);
                     }
                 }
+                segments[i] = local_bonds.size() - first_bond;
+
+                if (sort_by_distance)
+                {
+                    std::sort(local_bonds.begin() + first_bond, local_bonds.end(), compareNeighborDistance);
+                }
+                else
+                {
+                    std::sort(local_bonds.begin() + first_bond, local_bonds.end(), compareNeighborBond);
+                }
             }
+            range_bonds.local().push_back(std::move(local_range));
         });
-
-        tbb::flattened2d<BondVector> flat_bonds = tbb::flatten2d(bonds);
-        std::vector<NeighborBond> linear_bonds(flat_bonds.begin(), flat_bonds.end());
-        if (sort_by_distance)
-        {
-            tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborDistance);
-        }
-        else
-        {
-            tbb::parallel_sort(linear_bonds.begin(), linear_bonds.end(), compareNeighborBond);
-        }
-
-        unsigned int num_bonds = linear_bonds.size();
+        std::exclusive_scan(segments.begin(), segments.end(), segments.begin(), size_t(0));
+        const size_t num_bonds = segments[m_num_query_points];
+        phase.addBonds(num_bonds);
 
         auto* nl = new NeighborList();
         nl->setNumBonds(num_bonds, m_num_query_points, m_neighbor_query->getNPoints());
-
-        util::forLoopWrapper(0, num_bonds, [&](size_t begin, size_t end) {
-            for (size_t bond = begin; bond < end; ++bond)
+        nl->setHalfList(m_qargs.half_list);
+        unsigned int* neighbors = nl->getNeighbors().get();
+        float* distances = nl->getDistances().get();
+        float* weights = nl->getWeights().get();
+
+        // Copy the bonds of each range into its segment of the output arrays.
+        std::vector<const RangeBonds*> ranges;
+        for (auto thread_ranges = range_bonds.begin(); thread_ranges != range_bonds.end(); ++thread_ranges)
+        {
+            for (const RangeBonds& range : *thread_ranges)
+            {
+                ranges.push_back(&range);
+            }
+        }
+        util::forLoopWrapper(0, ranges.size(), [&](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r)
             {
-                nl->getNeighbors()(bond, 0) = linear_bonds[bond].query_point_idx;
-                nl->getNeighbors()(bond, 1) = linear_bonds[bond].point_idx;
-                nl->getDistances()[bond] = linear_bonds[bond].distance;
-                nl->getWeights()[bond] = float(1.0);
+                size_t bond = segments[ranges[r]->begin];
+                for (const auto& local_bond : ranges[r]->bonds)
+                {
+                    neighbors[2 * bond] = local_bond.query_point_idx;
+                    neighbors[2 * bond + 1] = local_bond.point_idx;
+                    distances[bond] = local_bond.distance;
+                    weights[bond] = float(1.0);
+                    ++bond;
+                }
             }
         });
 
@@ -2,8 +2,10 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include <stdexcept>
+#include <vector>
 
 #include "PeriodicBuffer.h"
+#include "utils.h"
 
 /*! \file PeriodicBuffer.cc
     \brief Replicates points across periodic boundaries.
@@ -12,7 +14,7 @@
 namespace freud { namespace locality {
 
 void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>& buff,
-                             const bool use_images, const bool include_input_points)
+                             const bool use_images, const bool include_input_points, const bool compute_points)
 {
     m_box = neighbor_query->getBox();
     if (buff.x < 0)
@@ -55,12 +57,8 @@ void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_quer
         images.z = 0;
     }
 
-    m_buffer_points.clear();
-    m_buffer_ids.clear();
-
-    // for each point
-    for (unsigned int point_id = 0; point_id < neighbor_query->getNPoints(); point_id++)
-    {
+    // Call image_function(image, point_image) for every image of a point in the buffer.
+    const auto for_each_image = [&](unsigned int point_id, const auto& image_function) {
         for (int i = use_images ? 0 : -images.x; i <= images.x; i++)
         {
             for (int j = use_images ? 0 : -images.y; j <= images.y; j++)
@@ -91,8 +89,7 @@ void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_quer
                         // have the correct number of points instead of
                         // relying on the floating point precision of the
                         // fractional check below.
-                        m_buffer_points.push_back(m_buffer_box.wrap(point_image));
-                        m_buffer_ids.push_back(point_id);
+                        image_function(vec3<int>(i, j, k), m_buffer_box.wrap(point_image));
                     }
                     else
                     {
@@ -104,14 +101,53 @@ void PeriodicBuffer::compute(const freud::locality::NeighborQuery* neighbor_quer
                         if (0 <= buff_frac.x && buff_frac.x < 1 && 0 <= buff_frac.y && buff_frac.y < 1
                             && (is2D || (0 <= buff_frac.z && buff_frac.z < 1)))
                         {
-                            m_buffer_points.push_back(point_image);
-                            m_buffer_ids.push_back(point_id);
+                            image_function(vec3<int>(i, j, k), point_image);
                         }
                     }
                 }
             }
         }
+    };
+
+    // Count the buffer points of every point, then fill the buffer points of
+    // every point from the offset of its first buffer point.
+    const unsigned int n_points = neighbor_query->getNPoints();
+    std::vector<size_t> offsets(size_t(n_points) + 1, 0);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t point_id = begin; point_id < end; ++point_id)
+        {
+            size_t count = 0;
+            for_each_image(point_id, [&](const vec3<int>& /*image*/, const vec3<float>& /*point_image*/) {
+                ++count;
+            });
+            offsets[point_id + 1] = count;
+        }
+    });
+    for (size_t point_id = 0; point_id < n_points; ++point_id)
+    {
+        offsets[point_id + 1] += offsets[point_id];
     }
+
+    const size_t n_buffer = offsets.back();
+    m_compute_points = compute_points;
+    m_buffer_points.prepareForOverwrite(compute_points ? n_buffer : 0);
+    m_buffer_ids.prepareForOverwrite(n_buffer);
+    m_buffer_images.prepareForOverwrite(n_buffer);
+    util::forLoopWrapper(0, n_points, [&](size_t begin, size_t end) {
+        for (size_t point_id = begin; point_id < end; ++point_id)
+        {
+            size_t buffer_id = offsets[point_id];
+            for_each_image(point_id, [&](const vec3<int>& image, const vec3<float>& point_image) {
+                if (compute_points)
+                {
+                    m_buffer_points[buffer_id] = point_image;
+                }
+                m_buffer_ids[buffer_id] = static_cast<unsigned int>(point_id);
+                m_buffer_images[buffer_id] = image;
+                ++buffer_id;
+            });
+        }
+    });
 }
 
 }; }; // end namespace freud::locality
@@ -4,9 +4,8 @@
 #ifndef PERIODIC_BUFFER_H
 #define PERIODIC_BUFFER_H
 
-#include <vector>
-
 #include "Box.h"
+#include "ManagedArray.h"
 #include "NeighborQuery.h"
 #include "VectorMath.h"
 
@@ -35,26 +34,52 @@ public:
     }
 
     //! Compute the periodic buffer
+    /*! The buffer points are counted in parallel, and every point writes its
+     *  images to the offset given by the sum of the counts of the previous
+     *  points, so that the buffer points are ordered by point as in a serial
+     *  loop.
+     *
+     *  \param neighbor_query The points to replicate.
+     *  \param buff Buffer distance, or number of images, in each dimension.
+     *  \param use_images Whether buff is a number of images rather than a distance.
+     *  \param include_input_points Whether the points themselves are part of the buffer.
+     *  \param compute_points Whether the positions of the buffer points are stored, or only their
+     *         ids and images.
+     */
     void compute(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>& buff,
-                 const bool use_images, const bool include_input_points);
+                 const bool use_images, const bool include_input_points, const bool compute_points = true);
 
     //! Return the buffer points
-    std::vector<vec3<float>> getBufferPoints() const
+    const util::ManagedArray<vec3<float>>& getBufferPoints() const
     {
         return m_buffer_points;
     }
 
     //! Return the buffer ids
-    std::vector<unsigned int> getBufferIds() const
+    const util::ManagedArray<unsigned int>& getBufferIds() const
     {
         return m_buffer_ids;
     }
 
+    //! Return the images of the buffer points, in multiples of the lattice vectors of the box
+    const util::ManagedArray<vec3<int>>& getBufferImages() const
+    {
+        return m_buffer_images;
+    }
+
+    //! Return whether the positions of the buffer points were stored by the last compute
+    bool getComputePoints() const
+    {
+        return m_compute_points;
+    }
+
 private:
-    freud::box::Box m_box;                    //!< Simulation box of the original points
-    freud::box::Box m_buffer_box;             //!< Simulation box of the replicated points
-    std::vector<vec3<float>> m_buffer_points; //!< The replicated points
-    std::vector<unsigned int> m_buffer_ids;   //!< The replicated points' original point ids
+    freud::box::Box m_box;                         //!< Simulation box of the original points
+    freud::box::Box m_buffer_box;                  //!< Simulation box of the replicated points
+    util::ManagedArray<vec3<float>> m_buffer_points; //!< The replicated points
+    util::ManagedArray<unsigned int> m_buffer_ids; //!< The replicated points' original point ids
+    util::ManagedArray<vec3<int>> m_buffer_images; //!< The images of the replicated points
+    bool m_compute_points {true};                  //!< Whether the replicated points were stored
 };
 
 }; }; // end namespace freud::locality
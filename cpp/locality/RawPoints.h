@@ -5,6 +5,7 @@
 #define RAW_POINTS_H
 
 #include <memory>
+#include <mutex>
 #include <stdexcept>
 
 #include "AABBQuery.h"
@@ -48,9 +49,12 @@ public:
     std::shared_ptr<NeighborQueryIterator> query(const vec3<float>* query_points, unsigned int n_query_points,
                                                  QueryArgs query_args) const override
     {
-        if (!aq)
         {
-            aq = std::make_unique<AABBQuery>(m_box, m_points, m_n_points);
+            const std::lock_guard<std::mutex> lock(m_aq_mutex);
+            if (!aq)
+            {
+                aq = std::make_unique<AABBQuery>(m_box, m_points, m_n_points);
+            }
         }
 
         this->validateQueryArgs(query_args);
@@ -70,8 +74,16 @@ public:
         return aq->querySingle(query_point, query_point_idx, qargs);
     }
 
+    //! Get the underlying AABBQuery, or nullptr if this object has not been queried yet.
+    const AABBQuery* getAABBQuery() const
+    {
+        const std::lock_guard<std::mutex> lock(m_aq_mutex);
+        return aq.get();
+    }
+
 private:
     mutable std::unique_ptr<AABBQuery> aq; //!< The AABBQuery object that will be used to perform queries.
+    mutable std::mutex m_aq_mutex;         //!< Guard of the construction of aq by concurrent queries
 };
 
 }; }; // end namespace freud::locality
@@ -0,0 +1,186 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <tbb/task_group.h>
+#include <utility>
+
+#include "AABBQuery.h"
+#include "RawPoints.h"
+#include "SlabDecomposition.h"
+#include "utils.h"
+
+/*! \file SlabDecomposition.cc
+    \brief Processing of point sets that do not fit in memory in slabs of the box.
+*/
+
+namespace freud { namespace locality {
+
+namespace {
+//! A slab together with the NeighborQuery built on its points.
+struct PreparedSlab
+{
+    //! Read a slab and build its NeighborQuery.
+    void read(const SlabDecomposition& slabs, unsigned int index, bool build_tree)
+    {
+        neighbor_query.reset();
+        slabs.readSlab(index, slab);
+        const box::Box& box = slabs.getBox();
+        if (build_tree)
+        {
+            neighbor_query = std::make_unique<AABBQuery>(box, slab.points.data(), slab.getNPoints());
+        }
+        else
+        {
+            neighbor_query = std::make_unique<RawPoints>(box, slab.points.data(), slab.getNPoints());
+        }
+    }
+
+    Slab slab;                                     //!< The points of the slab and its halo
+    std::unique_ptr<NeighborQuery> neighbor_query; //!< NeighborQuery of the points of the slab
+};
+} // namespace
+
+PointReader makePointReader(PointReadFunction read_function, void* source)
+{
+    return [read_function, source](size_t begin, size_t end, vec3<float>* points) {
+        return read_function(source, begin, end, points);
+    };
+}
+
+SlabDecomposition::SlabDecomposition(const box::Box& box, size_t n_points, PointReader read_points,
+                                     unsigned int n_slabs, float halo, size_t chunk_size)
+    : m_box(box), m_n_points(n_points), m_read_points(std::move(read_points)), m_n_slabs(n_slabs),
+      m_halo(halo), m_chunk_size(chunk_size)
+{
+    if (n_slabs == 0)
+    {
+        throw std::invalid_argument("SlabDecomposition requires at least 1 slab.");
+    }
+    if (halo < 0)
+    {
+        throw std::invalid_argument("SlabDecomposition requires that the halo must be nonnegative.");
+    }
+    if (chunk_size == 0)
+    {
+        throw std::invalid_argument("SlabDecomposition requires that the chunk size must be positive.");
+    }
+    // The planes of constant fractional x are spaced by the nearest plane
+    // distance along x, also in tilted boxes.
+    m_fractional_halo = halo / m_box.getNearestPlaneDistance().x;
+}
+
+void SlabDecomposition::readSlab(unsigned int slab, Slab& out) const
+{
+    if (slab >= m_n_slabs)
+    {
+        throw std::invalid_argument("The slab index must be smaller than the number of slabs.");
+    }
+    out.points.clear();
+    out.indices.clear();
+    std::vector<vec3<float>> halo_points;
+    std::vector<size_t> halo_indices;
+
+    const bool periodic = m_box.getPeriodicX();
+    std::vector<vec3<float>> chunk(std::min(m_chunk_size, m_n_points));
+    std::vector<vec3<float>> fractional(chunk.size());
+    for (size_t begin = 0; begin < m_n_points; begin += m_chunk_size)
+    {
+        const size_t end = std::min(begin + m_chunk_size, m_n_points);
+        const size_t n = end - begin;
+        if (!m_read_points(begin, end, chunk.data()))
+        {
+            throw std::runtime_error("The points of a slab could not be read.");
+        }
+        m_box.makeFractional(chunk.data(), static_cast<unsigned int>(n), fractional.data());
+        for (size_t i = 0; i < n; ++i)
+        {
+            float f = fractional[i].x;
+            if (periodic)
+            {
+                f -= std::floor(f);
+            }
+            if (getCoreSlab(f, m_n_slabs) == slab)
+            {
+                out.points.push_back(chunk[i]);
+                out.indices.push_back(begin + i);
+            }
+            else if (getSlabDistance(f, slab, m_n_slabs, periodic) <= m_fractional_halo)
+            {
+                halo_points.push_back(chunk[i]);
+                halo_indices.push_back(begin + i);
+            }
+        }
+    }
+    out.n_core = static_cast<unsigned int>(out.points.size());
+    out.points.insert(out.points.end(), halo_points.begin(), halo_points.end());
+    out.indices.insert(out.indices.end(), halo_indices.begin(), halo_indices.end());
+}
+
+unsigned int SlabDecomposition::getCoreSlab(float fractional_x, unsigned int n_slabs)
+{
+    // Every point is in the core of exactly one slab, also if it lies on or
+    // slightly outside of the boundaries of a nonperiodic box.
+    return static_cast<unsigned int>(
+        std::clamp(static_cast<int>(fractional_x * static_cast<float>(n_slabs)), 0, int(n_slabs) - 1));
+}
+
+float SlabDecomposition::getSlabDistance(float fractional_x, unsigned int slab, unsigned int n_slabs,
+                                         bool periodic)
+{
+    const float width = float(1.0) / static_cast<float>(n_slabs);
+    const float lower = static_cast<float>(slab) * width;
+    if (periodic)
+    {
+        // The offset from the lower boundary is in [0, 1), so the point is
+        // either above the upper boundary or, through the periodic boundary,
+        // below the lower boundary.
+        const float offset = fractional_x - lower;
+        const float wrapped = offset - std::floor(offset);
+        return std::min(wrapped - width, float(1.0) - wrapped);
+    }
+    return (fractional_x < lower) ? lower - fractional_x : fractional_x - (lower + width);
+}
+
+void SlabDecomposition::accumulate(const SlabAccumulator& accumulate_slab, bool build_tree) const
+{
+    // As in accumulateFrames, the next slab is read while the current slab is
+    // accumulated, and the reader must be waited for in the arena of the caller.
+    util::executeInThreadArena([&]() {
+        PreparedSlab current;
+        PreparedSlab next;
+        current.read(*this, 0, build_tree);
+        for (unsigned int slab = 0; slab < m_n_slabs; ++slab)
+        {
+            const bool has_next = slab + 1 < m_n_slabs;
+            tbb::task_group prefetch;
+            if (has_next)
+            {
+                prefetch.run([&]() { next.read(*this, slab + 1, build_tree); });
+            }
+            try
+            {
+                accumulate_slab(current.neighbor_query.get(), current.slab);
+            }
+            catch (...)
+            {
+                // The reader must finish before its slab goes out of scope. Its
+                // own errors are superseded by the error of the accumulation.
+                try
+                {
+                    prefetch.wait();
+                }
+                catch (...)
+                {}
+                throw;
+            }
+            prefetch.wait();
+            std::swap(current, next);
+        }
+    });
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,150 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef SLAB_DECOMPOSITION_H
+#define SLAB_DECOMPOSITION_H
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "Box.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file SlabDecomposition.h
+    \brief Processing of point sets that do not fit in memory in slabs of the box.
+*/
+
+namespace freud { namespace locality {
+
+//! Callable reading the points [begin, end) of a point set into its last argument, returning false on errors.
+using PointReader = std::function<bool(size_t, size_t, vec3<float>*)>;
+
+//! Function reading points of an opaque source, used to wrap readers implemented in Python.
+using PointReadFunction = bool (*)(void*, size_t, size_t, vec3<float>*);
+
+//! Make a PointReader that calls read_function with source.
+PointReader makePointReader(PointReadFunction read_function, void* source);
+
+//! The points of a slab of the box and of its halo.
+struct Slab
+{
+    //! Get the number of points of the slab and its halo.
+    unsigned int getNPoints() const
+    {
+        return static_cast<unsigned int>(points.size());
+    }
+
+    std::vector<vec3<float>> points; //!< Points of the slab, followed by the points of its halo
+    std::vector<size_t> indices;     //!< Indices of the points in the point set
+    unsigned int n_core {0};         //!< Number of points of the slab, excluding its halo
+};
+
+//! Callable accumulating a slab given a NeighborQuery of the points of the slab and its halo.
+/*! The first slab.n_core points of the NeighborQuery are the points of the
+ *  slab. Since the NeighborQuery has the box of the whole point set,
+ *  querying the neighbors of the points of the slab within the halo width
+ *  finds the same neighbors as in the whole point set.
+ */
+using SlabAccumulator = std::function<void(const NeighborQuery*, const Slab&)>;
+
+//! Decomposition of a point set into slabs of the box along its first lattice vector.
+/*! Point sets too large to be kept in memory are processed slab by slab. The
+ *  box is split into slabs of equal width along the fractional x coordinate,
+ *  and each slab also holds the points within halo of it, including the
+ *  periodic images across the box boundaries. Each point therefore lies in
+ *  the core of exactly one slab, whose points have all their neighbors
+ *  within the halo among the points of the slab.
+ *
+ *  The points are never all in memory: every slab streams the whole point
+ *  set in chunks of chunk_size points from a PointReader, e.g. a memory
+ *  mapped file, and keeps only the points of the slab and its halo. The
+ *  memory used is proportional to the number of points of a slab, and the
+ *  point set is read once per slab.
+ */
+class SlabDecomposition
+{
+public:
+    //! Default number of points read at once from the reader.
+    static constexpr size_t DEFAULT_CHUNK_SIZE = size_t(1) << 20;
+
+    //! Constructor
+    /*! \param box Box of the point set.
+     *  \param n_points Number of points of the point set.
+     *  \param read_points Reader of the points.
+     *  \param n_slabs Number of slabs.
+     *  \param halo Width of the halos, i.e. the largest distance of the neighbors to be found.
+     *  \param chunk_size Number of points read at once.
+     */
+    SlabDecomposition(const box::Box& box, size_t n_points, PointReader read_points, unsigned int n_slabs,
+                      float halo, size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    //! Get the box of the point set.
+    const box::Box& getBox() const
+    {
+        return m_box;
+    }
+
+    //! Get the number of points of the point set.
+    size_t getNPoints() const
+    {
+        return m_n_points;
+    }
+
+    //! Get the number of slabs.
+    unsigned int getNumSlabs() const
+    {
+        return m_n_slabs;
+    }
+
+    //! Get the width of the halos.
+    float getHalo() const
+    {
+        return m_halo;
+    }
+
+    //! Read the points of a slab and its halo.
+    /*! \param slab Index of the slab.
+     *  \param out Slab whose points are replaced by those of the slab.
+     */
+    void readSlab(unsigned int slab, Slab& out) const;
+
+    //! Accumulate all slabs in order, reading each slab while the previous one is accumulated.
+    /*! \param accumulate_slab Function accumulating a single slab.
+     *  \param build_tree If true, the NeighborQuery of each slab is an
+     *         AABBQuery whose tree is built during prefetching. Otherwise it is
+     *         a RawPoints object, for computes that do not query neighbors.
+     */
+    void accumulate(const SlabAccumulator& accumulate_slab, bool build_tree = true) const;
+
+    //! Get the slab whose core holds a point.
+    /*! \param fractional_x Fractional x coordinate of the point, in [0, 1) if periodic.
+     *  \param n_slabs Number of slabs.
+     *
+     *  Points on or outside of the boundaries of a nonperiodic box are in the
+     *  first or last slab.
+     */
+    static unsigned int getCoreSlab(float fractional_x, unsigned int n_slabs);
+
+    //! Get the distance of a point outside of a slab to the slab in fractional coordinates.
+    /*! \param fractional_x Fractional x coordinate of the point, in [0, 1) if periodic.
+     *  \param slab Index of the slab, which must not be the core slab of the point.
+     *  \param n_slabs Number of slabs.
+     *  \param periodic Whether the box is periodic along x.
+     */
+    static float getSlabDistance(float fractional_x, unsigned int slab, unsigned int n_slabs, bool periodic);
+
+private:
+    box::Box m_box;            //!< Box of the point set
+    size_t m_n_points;         //!< Number of points of the point set
+    PointReader m_read_points; //!< Reader of the points
+    unsigned int m_n_slabs;    //!< Number of slabs
+    float m_halo;              //!< Width of the halos
+    float m_fractional_halo;   //!< Width of the halos in fractional coordinates
+    size_t m_chunk_size;       //!< Number of points read at once
+};
+
+}; }; // end namespace freud::locality
+
+#endif // SLAB_DECOMPOSITION_H
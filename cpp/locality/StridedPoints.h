@@ -0,0 +1,108 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef STRIDED_POINTS_H
+#define STRIDED_POINTS_H
+
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+#include "VectorMath.h"
+#include "utils.h"
+
+/*! \file StridedPoints.h
+    \brief A view of point coordinates stored with arbitrary strides.
+*/
+
+namespace freud { namespace locality {
+
+//! Read-only view of point coordinates in externally owned memory.
+/*! Trajectory readers commonly provide positions as double precision values,
+ *  or as a field of a larger per-particle record, e.g. a structured or
+ *  memory-mapped array. A StridedPoints object describes such data by the
+ *  address of the first coordinate, the number of bytes between consecutive
+ *  points and between the coordinates of a point, and the precision of the
+ *  coordinates, without copying it.
+ */
+class StridedPoints
+{
+public:
+    //! Constructor
+    /*! \param data Address of the x coordinate of the first point.
+     *  \param n_points The number of points.
+     *  \param point_stride The number of bytes between consecutive points.
+     *  \param coord_stride The number of bytes between consecutive coordinates of a point.
+     *  \param is_double Whether the coordinates are double (rather than single) precision.
+     */
+    StridedPoints(const void* data, unsigned int n_points, std::ptrdiff_t point_stride,
+                  std::ptrdiff_t coord_stride, bool is_double)
+        : m_data(static_cast<const char*>(data)), m_n_points(n_points), m_point_stride(point_stride),
+          m_coord_stride(coord_stride), m_is_double(is_double)
+    {
+        if (data == nullptr && n_points != 0)
+        {
+            throw std::invalid_argument("StridedPoints requires a valid data pointer.");
+        }
+    }
+
+    //! Get the number of points.
+    unsigned int getNPoints() const
+    {
+        return m_n_points;
+    }
+
+    //! Whether the points are already stored as contiguous vec3<float>.
+    bool isPacked() const
+    {
+        return !m_is_double && m_point_stride == static_cast<std::ptrdiff_t>(sizeof(vec3<float>))
+            && m_coord_stride == static_cast<std::ptrdiff_t>(sizeof(float));
+    }
+
+    //! Get a point, converted to single precision.
+    vec3<float> operator[](size_t i) const
+    {
+        const char* point = m_data + static_cast<std::ptrdiff_t>(i) * m_point_stride;
+        if (m_is_double)
+        {
+            return {static_cast<float>(load<double>(point)),
+                    static_cast<float>(load<double>(point + m_coord_stride)),
+                    static_cast<float>(load<double>(point + 2 * m_coord_stride))};
+        }
+        return {load<float>(point), load<float>(point + m_coord_stride),
+                load<float>(point + 2 * m_coord_stride)};
+    }
+
+    //! Copy the points into a contiguous array of vec3<float> in parallel.
+    /*! \param output Array of at least getNPoints() points to write to.
+     */
+    void copyTo(vec3<float>* output) const
+    {
+        util::forLoopWrapper(0, m_n_points, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                output[i] = (*this)[i];
+            }
+        });
+    }
+
+private:
+    //! Read a value that may not be aligned to its size.
+    template<typename Scalar>
+    static Scalar load(const char* address)
+    {
+        Scalar value;
+        std::memcpy(&value, address, sizeof(Scalar));
+        return value;
+    }
+
+    const char* m_data;            //!< Address of the x coordinate of the first point
+    unsigned int m_n_points;       //!< Number of points
+    std::ptrdiff_t m_point_stride; //!< Bytes between consecutive points
+    std::ptrdiff_t m_coord_stride; //!< Bytes between consecutive coordinates of a point
+    bool m_is_double;              //!< Whether coordinates are double precision
+};
+
+}; }; // end namespace freud::locality
+
+#endif // STRIDED_POINTS_H
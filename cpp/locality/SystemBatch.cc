@@ -0,0 +1,100 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+
+#include "AABBQuery.h"
+#include "SystemBatch.h"
+
+/*! \file SystemBatch.cc
+    \brief A batch of many small independent systems, each in its own box.
+*/
+
+namespace freud { namespace locality {
+
+SystemBatch::SystemBatch(std::vector<box::Box> boxes, const vec3<float>* points,
+                         std::vector<unsigned int> offsets)
+    : m_boxes(std::move(boxes)), m_points(points), m_offsets(std::move(offsets)),
+      m_neighbor_queries(m_boxes.size())
+{
+    if (m_offsets.size() != m_boxes.size() + 1 || m_offsets.front() != 0)
+    {
+        throw std::invalid_argument("SystemBatch requires the offset of the first point of each system, "
+                                    "starting with zero, followed by the number of points.");
+    }
+    for (size_t system = 0; system < m_boxes.size(); ++system)
+    {
+        if (m_offsets[system + 1] < m_offsets[system])
+        {
+            throw std::invalid_argument("SystemBatch requires that the offsets must be nondecreasing.");
+        }
+    }
+
+    util::forLoopWrapper(0, m_boxes.size(), [&](size_t begin, size_t end) {
+        for (size_t system = begin; system < end; ++system)
+        {
+            const unsigned int n_points = m_offsets[system + 1] - m_offsets[system];
+            if (n_points != 0)
+            {
+                m_neighbor_queries[system]
+                    = std::make_unique<AABBQuery>(m_boxes[system], m_points + m_offsets[system], n_points);
+            }
+        }
+    });
+}
+
+NeighborList* SystemBatch::query(QueryArgs qargs) const
+{
+    std::vector<std::unique_ptr<NeighborList>> system_nlists(getNumSystems());
+    forEachSystem([&](unsigned int system, const NeighborQuery* neighbor_query) {
+        system_nlists[system].reset(
+            neighbor_query->query(neighbor_query->getPoints(), neighbor_query->getNPoints(), qargs)
+                ->toNeighborList());
+    });
+    std::vector<const NeighborList*> nlists(getNumSystems());
+    std::transform(system_nlists.cbegin(), system_nlists.cend(), nlists.begin(),
+                   [](const auto& nlist) { return nlist.get(); });
+    NeighborList* nlist = concatenate(nlists);
+    nlist->setHalfList(qargs.half_list);
+    return nlist;
+}
+
+NeighborList* SystemBatch::concatenate(const std::vector<const NeighborList*>& system_nlists) const
+{
+    // The bonds of each system are copied to the bonds of all systems at the
+    // offset of its first bond, with the offset of its first point added to
+    // their indices.
+    std::vector<size_t> bond_offsets(getNumSystems() + 1, 0);
+    for (unsigned int system = 0; system < getNumSystems(); ++system)
+    {
+        bond_offsets[system + 1] = bond_offsets[system]
+            + ((system_nlists[system] != nullptr) ? system_nlists[system]->getNumBonds() : 0);
+    }
+
+    auto* nlist = new NeighborList(bond_offsets.back());
+    nlist->setNumBonds(bond_offsets.back(), getNPoints(), getNPoints());
+    util::forLoopWrapper(0, getNumSystems(), [&](size_t begin, size_t end) {
+        for (size_t system = begin; system < end; ++system)
+        {
+            if (system_nlists[system] == nullptr)
+            {
+                continue;
+            }
+            const NeighborList& system_nlist = *system_nlists[system];
+            const unsigned int offset = m_offsets[system];
+            for (size_t bond = 0; bond < system_nlist.getNumBonds(); ++bond)
+            {
+                const size_t batch_bond = bond_offsets[system] + bond;
+                nlist->getNeighbors()(batch_bond, 0) = system_nlist.getNeighbors()(bond, 0) + offset;
+                nlist->getNeighbors()(batch_bond, 1) = system_nlist.getNeighbors()(bond, 1) + offset;
+                nlist->getDistances()[batch_bond] = system_nlist.getDistances()[bond];
+                nlist->getWeights()[batch_bond] = system_nlist.getWeights()[bond];
+            }
+        }
+    });
+    return nlist;
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,114 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef SYSTEM_BATCH_H
+#define SYSTEM_BATCH_H
+
+#include <memory>
+#include <vector>
+
+#include "Box.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+#include "utils.h"
+
+/*! \file SystemBatch.h
+    \brief A batch of many small independent systems, each in its own box.
+*/
+
+namespace freud { namespace locality {
+
+//! The points of many independent systems, each in its own box.
+/*! The points of all systems are stored contiguously in the order of the
+ *  systems, and the points of system i are [offsets[i], offsets[i + 1]). The
+ *  NeighborQuery objects of all systems are built in a single parallel loop
+ *  when the batch is constructed, and computes of all systems run in a single
+ *  parallel loop over the systems, which removes the per-system overhead of
+ *  building a NeighborQuery and a compute object from the Python API.
+ */
+class SystemBatch
+{
+public:
+    //! Constructor
+    /*! \param boxes Box of each system.
+     *  \param points Points of all systems, which must outlive the batch.
+     *  \param offsets Index of the first point of each system, followed by the number of points.
+     */
+    SystemBatch(std::vector<box::Box> boxes, const vec3<float>* points, std::vector<unsigned int> offsets);
+
+    //! Get the number of systems.
+    unsigned int getNumSystems() const
+    {
+        return static_cast<unsigned int>(m_boxes.size());
+    }
+
+    //! Get the number of points of all systems.
+    unsigned int getNPoints() const
+    {
+        return m_offsets.back();
+    }
+
+    //! Get the points of all systems.
+    const vec3<float>* getPoints() const
+    {
+        return m_points;
+    }
+
+    //! Get the box of each system.
+    const std::vector<box::Box>& getBoxes() const
+    {
+        return m_boxes;
+    }
+
+    //! Get the index of the first point of each system, followed by the number of points.
+    const std::vector<unsigned int>& getOffsets() const
+    {
+        return m_offsets;
+    }
+
+    //! Get the NeighborQuery of the points of a system, or nullptr if the system has no points.
+    const NeighborQuery* getNeighborQuery(unsigned int system) const
+    {
+        return m_neighbor_queries[system].get();
+    }
+
+    //! Call function(system, neighbor_query) for every system with points, in parallel over the systems.
+    template<typename Function> void forEachSystem(const Function& function) const
+    {
+        util::forLoopWrapper(0, getNumSystems(), [&](size_t begin, size_t end) {
+            for (size_t system = begin; system < end; ++system)
+            {
+                if (m_neighbor_queries[system] != nullptr)
+                {
+                    function(static_cast<unsigned int>(system), m_neighbor_queries[system].get());
+                }
+            }
+        });
+    }
+
+    //! Find the neighbors of the points of each system among the points of the same system.
+    /*! The bonds of all systems are concatenated in the order of the systems,
+     *  and their indices are those of the points of all systems.
+     *
+     *  \param qargs The query arguments of every system.
+     *  \return A neighbor list the caller is responsible for deleting.
+     */
+    NeighborList* query(QueryArgs qargs) const;
+
+    //! Concatenate neighbor lists of the points of each system into a neighbor list of all points.
+    /*! \param system_nlists Neighbor list of each system, or nullptr for systems without bonds.
+     *  \return A neighbor list the caller is responsible for deleting.
+     */
+    NeighborList* concatenate(const std::vector<const NeighborList*>& system_nlists) const;
+
+private:
+    std::vector<box::Box> m_boxes;        //!< Box of each system
+    const vec3<float>* m_points;          //!< Points of all systems
+    std::vector<unsigned int> m_offsets;  //!< First point of each system, followed by the number of points
+    std::vector<std::unique_ptr<NeighborQuery>> m_neighbor_queries; //!< NeighborQuery of each system
+};
+
+}; }; // end namespace freud::locality
+
+#endif // SYSTEM_BATCH_H
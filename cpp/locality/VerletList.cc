@@ -0,0 +1,139 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
+
+#include "NeighborComputeFunctional.h"
+#include "VerletList.h"
+#include "utils.h"
+
+/*! \file VerletList.cc
+    \brief Reuse of a neighbor list across frames with a Verlet skin.
+*/
+
+namespace freud { namespace locality {
+
+namespace {
+//! Find the largest minimum-image displacement between two sets of positions.
+float maxDisplacement(const box::Box& box, const vec3<float>* ref, const vec3<float>* current,
+                      unsigned int n)
+{
+    tbb::enumerable_thread_specific<float> local_max_rsq(0);
+    util::forLoopWrapper(0, n, [&](size_t begin, size_t end) {
+        float& max_rsq = local_max_rsq.local();
+        for (size_t i = begin; i < end; ++i)
+        {
+            const vec3<float> delta = box.wrap(current[i] - ref[i]);
+            max_rsq = std::max(max_rsq, dot(delta, delta));
+        }
+    });
+    const float max_rsq = local_max_rsq.combine([](float a, float b) { return std::max(a, b); });
+    return std::sqrt(max_rsq);
+}
+} // namespace
+
+VerletList::VerletList(float skin) : m_skin(skin), m_nlist(std::make_shared<NeighborList>())
+{
+    if (skin < 0)
+    {
+        throw std::invalid_argument("VerletList requires skin to be non-negative.");
+    }
+}
+
+void VerletList::reset()
+{
+    m_has_cache = false;
+    m_rebuilt = false;
+    m_num_rebuilds = 0;
+    m_ref_points.clear();
+    m_ref_query_points.clear();
+    m_cached_nlist = NeighborList();
+    m_nlist = std::make_shared<NeighborList>();
+}
+
+bool VerletList::isCacheValid(const NeighborQuery* nq, const vec3<float>* query_points,
+                              unsigned int n_query_points, const QueryArgs& qargs) const
+{
+    if (!m_has_cache || nq->getBox() != m_ref_box || nq->getNPoints() != m_ref_points.size()
+        || n_query_points != m_ref_query_points.size() || qargs.r_max != m_ref_r_max
+        || qargs.exclude_ii != m_ref_exclude_ii || qargs.half_list != m_ref_half_list
+        || qargs.all_images != m_ref_all_images)
+    {
+        return false;
+    }
+
+    // A bond can shrink by at most the sum of the displacements of its two
+    // endpoints, so every pair now within r_max is in the cached list as long
+    // as that sum does not exceed the skin.
+    const float point_displacement
+        = maxDisplacement(m_ref_box, m_ref_points.data(), nq->getPoints(), nq->getNPoints());
+    if (point_displacement > m_skin)
+    {
+        return false;
+    }
+    const float query_point_displacement
+        = maxDisplacement(m_ref_box, m_ref_query_points.data(), query_points, n_query_points);
+    return point_displacement + query_point_displacement <= m_skin;
+}
+
+void VerletList::compute(const NeighborQuery* nq, const vec3<float>* query_points,
+                         unsigned int n_query_points, QueryArgs qargs)
+{
+    if (qargs.mode == QueryType::nearest || qargs.num_neighbors != DEFAULT_NUM_NEIGHBORS)
+    {
+        throw std::invalid_argument("VerletList only supports ball queries.");
+    }
+    if (qargs.all_images)
+    {
+        // The cached distances are refreshed with the minimum image, which
+        // is not the image of the bonds to farther periodic images.
+        throw std::invalid_argument("VerletList does not support bonds to all periodic images.");
+    }
+    if (qargs.r_max <= 0)
+    {
+        throw std::invalid_argument("VerletList requires r_max to be positive.");
+    }
+
+    m_rebuilt = !isCacheValid(nq, query_points, n_query_points, qargs);
+    if (m_rebuilt)
+    {
+        QueryArgs cache_qargs(qargs);
+        cache_qargs.mode = QueryType::ball;
+        cache_qargs.r_max = qargs.r_max + m_skin;
+        cache_qargs.r_min = DEFAULT_R_MIN;
+        m_cached_nlist = makeDefaultNlist(nq, nullptr, query_points, n_query_points, cache_qargs,
+                                          HalfListPolicy::symmetric);
+
+        m_ref_box = nq->getBox();
+        m_ref_points.assign(nq->getPoints(), nq->getPoints() + nq->getNPoints());
+        m_ref_query_points.assign(query_points, query_points + n_query_points);
+        m_ref_r_max = qargs.r_max;
+        m_ref_exclude_ii = qargs.exclude_ii;
+        m_ref_half_list = qargs.half_list;
+        m_ref_all_images = qargs.all_images;
+        m_has_cache = true;
+        ++m_num_rebuilds;
+    }
+
+    // Refresh the cached distances from the current positions, then drop the
+    // bonds that fall outside of the requested range.
+    m_nlist = std::make_shared<NeighborList>(m_cached_nlist);
+    const auto& neighbors = m_nlist->getNeighbors();
+    auto& distances = m_nlist->getDistances();
+    const box::Box& box = nq->getBox();
+    const vec3<float>* points = nq->getPoints();
+    util::forLoopWrapper(0, m_nlist->getNumBonds(), [&](size_t begin, size_t end) {
+        for (size_t bond = begin; bond < end; ++bond)
+        {
+            const vec3<float> delta
+                = box.wrap(points[neighbors(bond, 1)] - query_points[neighbors(bond, 0)]);
+            distances[bond] = std::sqrt(dot(delta, delta));
+        }
+    });
+    m_nlist->filter_r(qargs.r_max, qargs.r_min);
+}
+
+}; }; // end namespace freud::locality
@@ -0,0 +1,98 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef VERLET_LIST_H
+#define VERLET_LIST_H
+
+#include <memory>
+#include <vector>
+
+#include "Box.h"
+#include "NeighborList.h"
+#include "NeighborQuery.h"
+#include "VectorMath.h"
+
+/*! \file VerletList.h
+    \brief Reuse of a neighbor list across frames with a Verlet skin.
+*/
+
+namespace freud { namespace locality {
+
+//! Cache a neighbor list built with an extended cutoff and reuse it across frames
+/*! A VerletList performs a ball query out to r_max + skin and stores the
+ *  resulting bonds along with the positions used to find them. On subsequent
+ *  calls to compute, the largest displacement of any point and of any query
+ *  point relative to that reference frame is measured. As long as the two
+ *  together do not exceed the skin, no pair that is now closer than r_max can
+ *  be missing from the cached list, so the cached bonds are simply updated
+ *  with the current distances and refiltered with NeighborList::filter_r. A
+ *  new query is only performed when the displacement bound is violated or
+ *  when the box, the number of points, or the query arguments change.
+ *
+ *  When the points and query points are the same set, the criterion reduces
+ *  to the usual condition that no particle has moved more than skin / 2.
+ */
+class VerletList
+{
+public:
+    //! Constructor
+    /*! \param skin The extra distance added to r_max when building the cached list.
+     */
+    explicit VerletList(float skin);
+
+    //! Compute the neighbor list for the current positions
+    void compute(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                 QueryArgs qargs);
+
+    //! Discard the cached neighbor list so that the next compute performs a new query
+    void reset();
+
+    //! Get the neighbor list for the most recent frame
+    std::shared_ptr<NeighborList> getNeighborList() const
+    {
+        return m_nlist;
+    }
+
+    //! Get the skin distance
+    float getSkin() const
+    {
+        return m_skin;
+    }
+
+    //! Whether the most recent compute performed a new query
+    bool getRebuilt() const
+    {
+        return m_rebuilt;
+    }
+
+    //! Get the number of queries performed since construction or the last reset
+    unsigned int getNumRebuilds() const
+    {
+        return m_num_rebuilds;
+    }
+
+private:
+    //! Check whether the cached neighbor list may be reused for the given inputs
+    bool isCacheValid(const NeighborQuery* nq, const vec3<float>* query_points, unsigned int n_query_points,
+                      const QueryArgs& qargs) const;
+
+    float m_skin;             //!< Extra distance added to r_max for the cached list
+    bool m_has_cache {false}; //!< Whether a cached neighbor list exists
+    bool m_rebuilt {false};   //!< Whether the last compute performed a new query
+    unsigned int m_num_rebuilds {0}; //!< Number of queries performed
+
+    box::Box m_ref_box;                          //!< Box of the reference frame
+    std::vector<vec3<float>> m_ref_points;       //!< Points of the reference frame
+    std::vector<vec3<float>> m_ref_query_points; //!< Query points of the reference frame
+    float m_ref_r_max {0};                       //!< r_max used to build the cached list
+    bool m_ref_exclude_ii {false};               //!< exclude_ii used to build the cached list
+    bool m_ref_half_list {false};                //!< half_list used to build the cached list
+    bool m_ref_all_images {false};               //!< all_images used to build the cached list
+
+    NeighborList m_cached_nlist;           //!< Bonds found within r_max + skin in the reference frame
+    std::shared_ptr<NeighborList> m_nlist; //!< Bonds within the cutoff for the most recent frame
+};
+
+}; }; // end namespace freud::locality
+
+#endif // VERLET_LIST_H
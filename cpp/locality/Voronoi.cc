@@ -3,11 +3,16 @@
 
 #include <cmath>
 #include <iterator>
+#include <memory>
+#include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_sort.h>
+#include <utility>
 #include <vector>
 
+#include "BoxKernel.h"
 #include "NeighborBond.h"
 #include "Voronoi.h"
+#include "utils.h"
 
 /*! \file Voronoi.cc
     \brief Computes Voronoi neighbors for a set of points.
@@ -15,13 +20,166 @@
 
 namespace freud { namespace locality {
 
+namespace {
+//! Storage used by a single thread to compute Voronoi cells.
+/*! A voro++ container computes cells with a voro_compute object holding the
+ *  search masks and queues of the computation, so cells of one container can
+ *  be computed concurrently by giving each thread its own voro_compute, once
+ *  all periodic images have been created.
+ */
+struct VoronoiWorker
+{
+    explicit VoronoiWorker(voro::container_periodic& container)
+        : compute(container, 2 * container.nx + 1, 2 * container.ey + 1, 2 * container.ez + 1)
+    {}
+
+    voro::voro_compute<voro::container_periodic> compute; //!< Cell computation state
+    voro::voronoicell_neighbor cell;                     //!< Current cell
+    std::vector<double> face_areas;                      //!< Areas of the faces of the current cell
+    std::vector<int> neighbors;                          //!< Neighbors of the current cell
+    std::vector<double> normals;                         //!< Face normals of the current cell
+    std::vector<double> vertices;                        //!< Vertices of the current cell
+    std::vector<NeighborBond> bonds;                     //!< Bonds of all cells computed by this thread
+};
+
+//! Compute the vertices of a polytope in system coordinates from the vertices of a voro++ cell.
+/*! \param box The box of the tessellation.
+ *  \param vertices The flattened vertices of the cell in container coordinates.
+ *  \param query_point The position of the point of the cell in the container.
+ *  \param query_point_system_coords The position of the point of the cell in the system.
+ */
+std::vector<vec3<double>> computePolytope(const box::Box& box, const std::vector<double>& vertices,
+                                          const vec3<double>& query_point,
+                                          const vec3<double>& query_point_system_coords)
+{
+    // Compute polytope vertices in relative coordinates
+    std::vector<vec3<double>> relative_vertices;
+    auto vertex_iterator = vertices.begin();
+    while (vertex_iterator != vertices.end())
+    {
+        double vert_x = *vertex_iterator;
+        vertex_iterator++;
+        double vert_y = *vertex_iterator;
+        vertex_iterator++;
+        double vert_z = *vertex_iterator;
+        vertex_iterator++;
+
+        // In 2D systems, only use vertices from the upper plane
+        // to prevent double-counting, and set z=0 manually
+        if (box.is2D())
+        {
+            if (vert_z < 0)
+            {
+                continue;
+            }
+            vert_z = 0;
+        }
+        vec3<double> delta = vec3<double>(vert_x, vert_y, vert_z) - query_point;
+        relative_vertices.push_back(delta);
+    }
+
+    // Sort relative vertices by their angle in 2D systems
+    if (box.is2D())
+    {
+        std::sort(relative_vertices.begin(), relative_vertices.end(),
+                  [](const vec3<double>& a, const vec3<double>& b) {
+                      return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
+                  });
+    }
+
+    // Save polytope vertices in system coordinates
+    std::vector<vec3<double>> system_vertices;
+    system_vertices.reserve(relative_vertices.size());
+    std::transform(relative_vertices.begin(), relative_vertices.end(), std::back_inserter(system_vertices),
+                   [&](const auto& relative_vertex) { return relative_vertex + query_point_system_coords; });
+    return system_vertices;
+}
+
+//! Store the polytope, volume, and bonds of the cell most recently computed by a worker.
+/*! \param nq The points of the tessellation.
+ *  \param kernel The box::BoxKernel of the box of the points.
+ *  \param worker The worker that computed the cell.
+ *  \param query_point_id The index of the point of the cell.
+ *  \param query_point The position of the point in the container.
+ *  \param polytope The polytope vertices to set, or nullptr to skip computing them.
+ *  \param volume The cell volume to set.
+ */
+template<typename Kernel>
+void storeCell(const NeighborQuery* nq, const Kernel& kernel, VoronoiWorker& worker, int query_point_id,
+               const vec3<double>& query_point, std::vector<vec3<double>>* polytope, double& volume)
+{
+    const box::Box& box = nq->getBox();
+    voro::voronoicell_neighbor& cell = worker.cell;
+    std::vector<double>& face_areas = worker.face_areas;
+    std::vector<int>& neighbors = worker.neighbors;
+    std::vector<double>& normals = worker.normals;
+    std::vector<double>& vertices = worker.vertices;
+
+    // Get Voronoi cell properties
+    cell.face_areas(face_areas);
+    cell.neighbors(neighbors);
+    cell.normals(normals);
+
+    const vec3<double>& query_point_system_coords((*nq)[query_point_id]);
+    if (polytope != nullptr)
+    {
+        cell.vertices(query_point.x, query_point.y, query_point.z, vertices);
+        *polytope = computePolytope(box, vertices, query_point, query_point_system_coords);
+    }
+
+    // Save cell volume
+    volume = cell.volume();
+
+    // Compute cell neighbors
+    size_t neighbor_counter(0);
+    for (auto neighbor_iterator = neighbors.begin(); neighbor_iterator != neighbors.end();
+         neighbor_iterator++, neighbor_counter++)
+    {
+        // Get the normal to the current face
+        const vec3<double> normal(normals[3 * neighbor_counter], normals[3 * neighbor_counter + 1],
+                                  normals[3 * neighbor_counter + 2]);
+
+        // Ignore bonds in 2D systems that point up or down. This check
+        // should only be dealing with bonds whose normal vectors' z
+        // components are -1, 0, or +1 (within some tolerance). This
+        // also skips bonds where the normal vector is exactly zero.
+        // A normal vector of exactly zero seems to appear for certain
+        // particles in 2D systems where the neighbors are very close.
+        // It seems like an issue of numerical imprecision but could be
+        // some other pathological case.
+        if (box.is2D() && std::abs(normal.z) > 0.5 || (normal.x == 0 && normal.y == 0 && normal.z == 0))
+        {
+            continue;
+        }
+
+        // Fetch neighbor information
+        const int point_id = *neighbor_iterator;
+        const float weight(face_areas[neighbor_counter]);
+        const vec3<double> point_system_coords((*nq)[point_id]);
+
+        // Compute the distance from query_point to point.
+        const vec3<float> rij = kernel.wrap(point_system_coords - query_point_system_coords);
+        const float distance(std::sqrt(dot(rij, rij)));
+
+        worker.bonds.emplace_back(query_point_id, point_id, distance, weight);
+    }
+}
+} // namespace
+
 // Voronoi calculations should be kept in double precision.
 void Voronoi::compute(const freud::locality::NeighborQuery* nq)
 {
     const auto box = nq->getBox();
     const auto n_points = nq->getNPoints();
 
-    m_polytopes.resize(n_points);
+    if (m_compute_polytopes)
+    {
+        m_polytopes.resize(n_points);
+    }
+    else
+    {
+        std::vector<std::vector<vec3<double>>>().swap(m_polytopes);
+    }
     m_volumes.prepare(n_points);
 
     const vec3<float> v1 = box.getLatticeVector(0);
@@ -48,123 +206,62 @@ void Voronoi::compute(const freud::locality::NeighborQuery* nq)
         container.put(query_point_id, query_point.x, query_point.y, query_point.z);
     }
 
-    voro::voronoicell_neighbor cell;
-    voro::c_loop_all_periodic voronoi_loop(container);
-    std::vector<double> face_areas;
-    std::vector<int> face_vertices;
-    std::vector<int> neighbors;
-    std::vector<double> normals;
-    std::vector<double> vertices;
-    std::vector<NeighborBond> bonds;
+    // Periodic images are otherwise created on demand while computing cells,
+    // which would modify the container concurrently.
+    container.create_all_images();
 
-    if (voronoi_loop.start())
-    {
-        do
-        {
-            container.compute_cell(cell, voronoi_loop);
-
-            // Get id and position of current particle
-            const int query_point_id(voronoi_loop.pid());
-            vec3<double> query_point(voronoi_loop.x(), voronoi_loop.y(), voronoi_loop.z());
-
-            // Get Voronoi cell properties
-            cell.face_areas(face_areas);
-            cell.face_vertices(face_vertices);
-            cell.neighbors(neighbors);
-            cell.normals(normals);
-            cell.vertices(query_point.x, query_point.y, query_point.z, vertices);
-
-            // Compute polytope vertices in relative coordinates
-            std::vector<vec3<double>> relative_vertices;
-            auto vertex_iterator = vertices.begin();
-            while (vertex_iterator != vertices.end())
+    // The blocks of the primary domain are processed in parallel. They are
+    // indexed in the block grid of the container, which extends the primary
+    // domain by ey and ez blocks on each side in y and z to hold images.
+    const int blocks_x = container.nx;
+    const int blocks_y = container.ny;
+    const int num_blocks = container.nx * container.ny * container.nz;
+    using Workers = tbb::enumerable_thread_specific<std::unique_ptr<VoronoiWorker>>;
+    Workers workers([&container]() { return std::make_unique<VoronoiWorker>(container); });
+
+    // The box kernel is selected once for all bonds of the tessellation.
+    box::dispatchBoxKernel(box, [&](const auto& kernel) {
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            VoronoiWorker& worker = *workers.local();
+            for (size_t block = begin; block < end; ++block)
             {
-                double vert_x = *vertex_iterator;
-                vertex_iterator++;
-                double vert_y = *vertex_iterator;
-                vertex_iterator++;
-                double vert_z = *vertex_iterator;
-                vertex_iterator++;
-
-                // In 2D systems, only use vertices from the upper plane
-                // to prevent double-counting, and set z=0 manually
-                if (box.is2D())
+                const int block_i = static_cast<int>(block % blocks_x);
+                const int block_j = container.ey + static_cast<int>((block / blocks_x) % blocks_y);
+                const int block_k = container.ez + static_cast<int>(block / (blocks_x * blocks_y));
+                const int ijk = block_i + container.nx * (block_j + container.oy * block_k);
+
+                for (int q = 0; q < container.co[ijk]; ++q)
                 {
-                    if (vert_z < 0)
+                    if (!worker.compute.compute_cell(worker.cell, ijk, q, block_i, block_j, block_k))
                     {
                         continue;
                     }
-                    vert_z = 0;
-                }
-                vec3<double> delta = vec3<double>(vert_x, vert_y, vert_z) - query_point;
-                relative_vertices.push_back(delta);
-            }
 
-            // Sort relative vertices by their angle in 2D systems
-            if (box.is2D())
-            {
-                std::sort(relative_vertices.begin(), relative_vertices.end(),
-                          [](const vec3<double>& a, const vec3<double>& b) {
-                              return std::atan2(a.y, a.x) < std::atan2(b.y, b.x);
-                          });
-            }
-
-            // Save polytope vertices in system coordinates
-            const vec3<double>& query_point_system_coords((*nq)[query_point_id]);
-
-            std::vector<vec3<double>> system_vertices;
-            system_vertices.reserve(relative_vertices.size());
-            std::transform(
-                relative_vertices.begin(), relative_vertices.end(), std::back_inserter(system_vertices),
-                [&](const auto& relative_vertex) { return relative_vertex + query_point_system_coords; });
-            m_polytopes[query_point_id] = system_vertices;
-
-            // Save cell volume
-            m_volumes[query_point_id] = cell.volume();
-
-            // Compute cell neighbors
-            size_t neighbor_counter(0);
-            for (auto neighbor_iterator = neighbors.begin(); neighbor_iterator != neighbors.end();
-                 neighbor_iterator++, neighbor_counter++)
-            {
-                // Get the normal to the current face
-                const vec3<double> normal(normals[3 * neighbor_counter], normals[3 * neighbor_counter + 1],
-                                          normals[3 * neighbor_counter + 2]);
-
-                // Ignore bonds in 2D systems that point up or down. This check
-                // should only be dealing with bonds whose normal vectors' z
-                // components are -1, 0, or +1 (within some tolerance). This
-                // also skips bonds where the normal vector is exactly zero.
-                // A normal vector of exactly zero seems to appear for certain
-                // particles in 2D systems where the neighbors are very close.
-                // It seems like an issue of numerical imprecision but could be
-                // some other pathological case.
-                if (box.is2D() && std::abs(normal.z) > 0.5
-                    || (normal.x == 0 && normal.y == 0 && normal.z == 0))
-                {
-                    continue;
+                    // Get id and position of current particle
+                    const int query_point_id(container.id[ijk][q]);
+                    const double* const position = container.p[ijk] + 3 * q;
+                    const vec3<double> query_point(position[0], position[1], position[2]);
+                    storeCell(nq, kernel, worker, query_point_id, query_point,
+                              m_compute_polytopes ? &m_polytopes[query_point_id] : nullptr,
+                              m_volumes[query_point_id]);
                 }
-
-                // Fetch neighbor information
-                const int point_id = *neighbor_iterator;
-                const float weight(face_areas[neighbor_counter]);
-                const vec3<double> point_system_coords((*nq)[point_id]);
-
-                // Compute the distance from query_point to point.
-                const vec3<float> rij = box.wrap(point_system_coords - query_point_system_coords);
-                const float distance(std::sqrt(dot(rij, rij)));
-
-                bonds.emplace_back(query_point_id, point_id, distance, weight);
             }
+        });
+    });
 
-        } while (voronoi_loop.inc());
+    std::vector<NeighborBond> bonds;
+    for (const auto& worker : workers)
+    {
+        bonds.insert(bonds.end(), worker->bonds.begin(), worker->bonds.end());
     }
 
-    tbb::parallel_sort(bonds.begin(), bonds.end(), [](const NeighborBond& n1, const NeighborBond& n2) {
-        return n1.less_id_ref_weight(n2);
+    util::executeInThreadArena([&]() {
+        tbb::parallel_sort(bonds.begin(), bonds.end(), [](const NeighborBond& n1, const NeighborBond& n2) {
+            return n1.less_id_ref_weight(n2);
+        });
     });
 
-    unsigned int num_bonds = bonds.size();
+    const size_t num_bonds = bonds.size();
 
     m_neighbor_list->resize(num_bonds);
     m_neighbor_list->setNumBonds(num_bonds, n_points, n_points);
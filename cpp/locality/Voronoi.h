@@ -16,8 +16,14 @@ namespace freud { namespace locality {
 class Voronoi
 {
 public:
-    // default constructor
-    Voronoi() : m_neighbor_list(std::make_shared<NeighborList>()) {}
+    //! Constructor
+    /*! \param compute_polytopes Whether to compute the vertices of each cell. If false, only the
+     *         neighbors, face areas, and volumes of the cells are computed, which saves the time
+     *         and memory used to store a polytope per point.
+     */
+    explicit Voronoi(bool compute_polytopes = true)
+        : m_neighbor_list(std::make_shared<NeighborList>()), m_compute_polytopes(compute_polytopes)
+    {}
 
     void compute(const freud::locality::NeighborQuery* nq);
 
@@ -26,11 +32,16 @@ public:
         return m_neighbor_list;
     }
 
-    std::vector<std::vector<vec3<double>>> getPolytopes() const
+    const std::vector<std::vector<vec3<double>>>& getPolytopes() const
     {
         return m_polytopes;
     }
 
+    bool getComputePolytopes() const
+    {
+        return m_compute_polytopes;
+    }
+
     const util::ManagedArray<double>& getVolumes() const
     {
         return m_volumes;
@@ -41,6 +52,7 @@ private:
     std::shared_ptr<NeighborList> m_neighbor_list;      //!< Stored neighbor list
     std::vector<std::vector<vec3<double>>> m_polytopes; //!< Voronoi polytopes
     util::ManagedArray<double> m_volumes;               //!< Voronoi cell volumes
+    bool m_compute_polytopes;                           //!< Whether polytopes are computed
 };
 }; }; // end namespace freud::locality
 
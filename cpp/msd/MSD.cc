@@ -0,0 +1,243 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "MSD.h"
+#include "utils.h"
+
+/*! \file MSD.cc
+    \brief Mean squared displacement of the trajectories of particles.
+*/
+
+namespace freud { namespace msd {
+
+namespace {
+//! Iterative radix-2 FFT of complex sequences whose length is a power of two.
+class RadixTwoFFT
+{
+public:
+    //! Constructor
+    /*! \param size Length of the sequences, which must be a power of two.
+     */
+    explicit RadixTwoFFT(size_t size) : m_size(size), m_twiddles(size / 2), m_bit_reverse(size, 0)
+    {
+        for (size_t k = 0; k < size / 2; ++k)
+        {
+            const double angle = -2.0 * M_PI * static_cast<double>(k) / static_cast<double>(size);
+            m_twiddles[k] = std::complex<double>(std::cos(angle), std::sin(angle));
+        }
+        for (size_t i = 1; i < size; ++i)
+        {
+            m_bit_reverse[i] = (m_bit_reverse[i >> 1] >> 1) | ((i & 1) != 0 ? size >> 1 : 0);
+        }
+    }
+
+    //! Transform data in place.
+    /*! \param data Sequence of m_size values.
+     *  \param inverse If true, compute the inverse transform without the normalization by 1 / m_size.
+     */
+    void transform(std::complex<double>* data, bool inverse) const
+    {
+        for (size_t i = 0; i < m_size; ++i)
+        {
+            if (i < m_bit_reverse[i])
+            {
+                std::swap(data[i], data[m_bit_reverse[i]]);
+            }
+        }
+        const double sign = inverse ? -1.0 : 1.0;
+        for (size_t length = 2; length <= m_size; length <<= 1)
+        {
+            const size_t half = length / 2;
+            const size_t stride = m_size / length;
+            for (size_t start = 0; start < m_size; start += length)
+            {
+                for (size_t k = 0; k < half; ++k)
+                {
+                    // The products are written out to avoid the checks for
+                    // infinities of std::complex multiplication.
+                    const std::complex<double>& w = m_twiddles[k * stride];
+                    const std::complex<double>& b = data[start + k + half];
+                    const double w_imag = sign * w.imag();
+                    const std::complex<double> v(b.real() * w.real() - b.imag() * w_imag,
+                                                 b.real() * w_imag + b.imag() * w.real());
+                    const std::complex<double> u = data[start + k];
+                    data[start + k] = u + v;
+                    data[start + k + half] = u - v;
+                }
+            }
+        }
+    }
+
+private:
+    size_t m_size;                                //!< Length of the sequences
+    std::vector<std::complex<double>> m_twiddles; //!< Roots of unity exp(-2 pi i k / m_size)
+    std::vector<size_t> m_bit_reverse;            //!< Bit reversed index of each index
+};
+
+//! Smallest power of two that is at least n.
+size_t nextPowerOfTwo(size_t n)
+{
+    size_t power = 1;
+    while (power < n)
+    {
+        power <<= 1;
+    }
+    return power;
+}
+} // namespace
+
+MSD::MSD(MSDMode mode) : m_mode(mode)
+{
+    if (mode != Window && mode != Direct)
+    {
+        throw std::invalid_argument("Unknown MSD mode.");
+    }
+}
+
+void MSD::reset()
+{
+    m_n_frames = 0;
+    m_n_points = 0;
+    m_msd.prepare(0);
+    m_particle_msd.prepare({0, 0});
+}
+
+void MSD::compute(const box::Box* box, const vec3<float>* positions, const vec3<int>* images,
+                  unsigned int n_frames, unsigned int n_points, bool compute_particle_msd)
+{
+    if (m_n_points == 0)
+    {
+        m_n_frames = n_frames;
+        m_msd_sum_local.resize(n_frames);
+    }
+    else if (n_frames != m_n_frames)
+    {
+        throw std::invalid_argument("All accumulated trajectories must have the same number of frames.");
+    }
+    if (compute_particle_msd)
+    {
+        m_particle_msd.prepare({n_frames, n_points});
+    }
+    else
+    {
+        m_particle_msd.prepare({0, 0});
+    }
+
+    // The correlation of a trajectory of n_frames frames is computed without
+    // wrapping around by zero padding it to at least 2 n_frames - 1 frames.
+    const size_t fft_size = nextPowerOfTwo(2 * size_t(n_frames));
+    const RadixTwoFFT fft(fft_size);
+    const bool unwrap = box != nullptr && images != nullptr;
+
+    m_msd_sum_local.accumulate(0, n_points, [&](size_t begin, size_t end, auto& msd_sum) {
+        std::vector<vec3<double>> trajectory(n_frames);
+        std::vector<double> particle_msd(n_frames);
+        std::vector<std::complex<double>> xy;
+        std::vector<std::complex<double>> z;
+        if (m_mode == Window)
+        {
+            xy.resize(fft_size);
+            z.resize(fft_size);
+        }
+
+        for (size_t i = begin; i < end; ++i)
+        {
+            // Positions relative to the first frame, which leave the
+            // displacements unchanged and avoid the loss of precision of
+            // squaring large coordinates.
+            vec3<double> origin;
+            for (unsigned int frame = 0; frame < n_frames; ++frame)
+            {
+                const size_t idx = size_t(frame) * n_points + i;
+                vec3<float> position = positions[idx];
+                if (unwrap)
+                {
+                    position += box->getLatticeVector(0) * float(images[idx].x)
+                        + box->getLatticeVector(1) * float(images[idx].y);
+                    if (!box->is2D())
+                    {
+                        position += box->getLatticeVector(2) * float(images[idx].z);
+                    }
+                }
+                const vec3<double> r(position.x, position.y, position.z);
+                if (frame == 0)
+                {
+                    origin = r;
+                }
+                trajectory[frame] = r - origin;
+            }
+
+            if (m_mode == Direct)
+            {
+                for (unsigned int frame = 0; frame < n_frames; ++frame)
+                {
+                    particle_msd[frame] = dot(trajectory[frame], trajectory[frame]);
+                }
+            }
+            else
+            {
+                // The correlation of the positions is the real part of the
+                // correlation of x + iy plus the correlation of z.
+                for (unsigned int frame = 0; frame < n_frames; ++frame)
+                {
+                    xy[frame] = std::complex<double>(trajectory[frame].x, trajectory[frame].y);
+                    z[frame] = std::complex<double>(trajectory[frame].z, 0);
+                }
+                std::fill(xy.begin() + n_frames, xy.end(), std::complex<double>(0, 0));
+                std::fill(z.begin() + n_frames, z.end(), std::complex<double>(0, 0));
+                fft.transform(xy.data(), false);
+                fft.transform(z.data(), false);
+                for (size_t k = 0; k < fft_size; ++k)
+                {
+                    xy[k] = std::complex<double>(std::norm(xy[k]) + std::norm(z[k]), 0);
+                }
+                fft.transform(xy.data(), true);
+
+                // The sum of the squared positions at both ends of the
+                // windows of length m is reduced from all frames by removing
+                // the frames that are not the start or the end of a window.
+                double sum_squares = 0;
+                for (unsigned int frame = 0; frame < n_frames; ++frame)
+                {
+                    sum_squares += 2 * dot(trajectory[frame], trajectory[frame]);
+                }
+                for (unsigned int m = 0; m < n_frames; ++m)
+                {
+                    if (m > 0)
+                    {
+                        sum_squares -= dot(trajectory[m - 1], trajectory[m - 1])
+                            + dot(trajectory[n_frames - m], trajectory[n_frames - m]);
+                    }
+                    const double correlation = xy[m].real() / static_cast<double>(fft_size);
+                    particle_msd[m] = (sum_squares - 2 * correlation) / static_cast<double>(n_frames - m);
+                }
+            }
+
+            for (unsigned int frame = 0; frame < n_frames; ++frame)
+            {
+                msd_sum[frame] += particle_msd[frame];
+                if (compute_particle_msd)
+                {
+                    m_particle_msd[size_t(frame) * n_points + i] = particle_msd[frame];
+                }
+            }
+        }
+    });
+    m_n_points += n_points;
+
+    m_msd.prepare(n_frames);
+    m_msd_sum_local.reduceInto(m_msd);
+    for (unsigned int frame = 0; frame < n_frames; ++frame)
+    {
+        m_msd[frame] /= static_cast<double>(m_n_points);
+    }
+}
+
+}; }; // end namespace freud::msd
@@ -0,0 +1,90 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef MSD_H
+#define MSD_H
+
+#include "Box.h"
+#include "ManagedArray.h"
+#include "ThreadStorage.h"
+#include "VectorMath.h"
+
+/*! \file MSD.h
+    \brief Mean squared displacement of the trajectories of particles.
+*/
+
+namespace freud { namespace msd {
+
+//! Definitions of the mean squared displacement.
+enum MSDMode
+{
+    Window, //!< Average over all windows of each length
+    Direct  //!< Displacement from the first frame
+};
+
+//! Compute the mean squared displacement of full trajectories of particles.
+/*! The trajectory of each particle is processed independently and in
+ *  parallel over particles, so the memory used beyond the input and output
+ *  is a few buffers of the length of the trajectory per thread. In Window
+ *  mode, the sums over windows of each length are computed with the
+ *  algorithm of Calandrini et al., where the correlation of the positions is
+ *  computed by an FFT of the zero padded trajectory.
+ *
+ *  Computes may be accumulated over disjoint sets of particles with the same
+ *  number of frames, in which case the mean is taken over all particles.
+ */
+class MSD
+{
+public:
+    //! Constructor
+    /*! \param mode Definition of the mean squared displacement.
+     */
+    explicit MSD(MSDMode mode);
+
+    //! Destructor
+    ~MSD() = default;
+
+    //! Reset the accumulated mean squared displacement.
+    void reset();
+
+    //! Accumulate the mean squared displacement of the trajectories of a set of particles.
+    /*! \param box Box to unwrap the positions with, or nullptr if they are already unwrapped.
+     *  \param positions Positions of n_frames frames of n_points points each.
+     *  \param images Images of the positions, or nullptr if they are already unwrapped.
+     *  \param n_frames Number of frames, which must be the same for all accumulated computes.
+     *  \param n_points Number of points of each frame.
+     *  \param compute_particle_msd Whether to store the mean squared displacement of each particle.
+     */
+    void compute(const box::Box* box, const vec3<float>* positions, const vec3<int>* images,
+                 unsigned int n_frames, unsigned int n_points, bool compute_particle_msd = true);
+
+    //! Get the definition of the mean squared displacement.
+    MSDMode getMode() const
+    {
+        return m_mode;
+    }
+
+    //! Get the mean squared displacement averaged over all accumulated particles.
+    const util::ManagedArray<double>& getMSD() const
+    {
+        return m_msd;
+    }
+
+    //! Get the mean squared displacement of each particle of the last compute.
+    const util::ManagedArray<double>& getParticleMSD() const
+    {
+        return m_particle_msd;
+    }
+
+private:
+    MSDMode m_mode;                              //!< Definition of the mean squared displacement
+    unsigned int m_n_frames {0};                 //!< Number of frames of the accumulated computes
+    size_t m_n_points {0};                       //!< Number of particles accumulated since the last reset
+    util::ThreadStorage<double> m_msd_sum_local; //!< Thread-specific sums over particles
+    util::ManagedArray<double> m_msd;            //!< Mean squared displacement over all particles
+    util::ManagedArray<double> m_particle_msd;   //!< Mean squared displacement of each particle
+};
+
+}; }; // end namespace freud::msd
+
+#endif // MSD_H
@@ -0,0 +1,77 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <stdexcept>
+#include <vector>
+
+#include "MultipleTauMSD.h"
+#include "utils.h"
+
+/*! \file MultipleTauMSD.cc
+    \brief Mean squared displacement of a trajectory at logarithmically spaced lags.
+*/
+
+namespace freud { namespace msd {
+
+MultipleTauMSD::MultipleTauMSD(unsigned int points_per_level)
+    : m_points_per_level(points_per_level), m_frames(points_per_level)
+{}
+
+void MultipleTauMSD::reset()
+{
+    m_frames = util::MultipleTau<vec3<float>>(m_points_per_level);
+    m_lags.prepare(0);
+    m_msd.prepare(0);
+}
+
+void MultipleTauMSD::accumulate(const vec3<float>* positions, unsigned int n_frames, unsigned int n_points)
+{
+    if (m_frames.getNumFrames() == 0)
+    {
+        m_frames.reset(n_points);
+        m_lag_sums_local.resize(m_frames.getNumLags());
+    }
+    else if (n_points != m_frames.getNumValues())
+    {
+        throw std::invalid_argument("All frames must have the same number of points.");
+    }
+
+    using Pair = util::MultipleTau<vec3<float>>::Pair;
+    const auto add_pairs = [&](const std::vector<Pair>& pairs, const vec3<float>* latest) {
+        m_lag_sums_local.accumulate(0, n_points, [&](size_t begin, size_t end, auto& local_sums) {
+            std::vector<double> sums(pairs.size(), 0);
+            for (size_t p = 0; p < pairs.size(); ++p)
+            {
+                const vec3<float>* earlier = pairs[p].earlier;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    const vec3<float> delta = latest[i] - earlier[i];
+                    sums[p] += dot(delta, delta);
+                }
+            }
+            for (size_t p = 0; p < pairs.size(); ++p)
+            {
+                local_sums[pairs[p].lag_index] += sums[p];
+            }
+        });
+    };
+    for (unsigned int frame = 0; frame < n_frames; ++frame)
+    {
+        m_frames.addFrame(positions + size_t(frame) * n_points, add_pairs);
+    }
+
+    // Average over the pairs of frames and the points of each resolved lag.
+    util::ManagedArray<double> lag_sums(m_frames.getNumLags());
+    m_lag_sums_local.reduceInto(lag_sums);
+    const unsigned int n_lags = m_frames.getNumResolvedLags();
+    m_lags.prepare(n_lags);
+    m_msd.prepare(n_lags);
+    for (unsigned int lag_index = 0; lag_index < n_lags; ++lag_index)
+    {
+        m_lags[lag_index] = static_cast<unsigned int>(m_frames.getLag(lag_index));
+        m_msd[lag_index]
+            = lag_sums[lag_index] / (static_cast<double>(m_frames.getCounts()[lag_index]) * n_points);
+    }
+}
+
+}; }; // end namespace freud::msd
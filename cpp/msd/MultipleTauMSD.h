@@ -0,0 +1,74 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef MULTIPLE_TAU_MSD_H
+#define MULTIPLE_TAU_MSD_H
+
+#include "ManagedArray.h"
+#include "MultipleTau.h"
+#include "ThreadStorage.h"
+#include "VectorMath.h"
+
+/*! \file MultipleTauMSD.h
+    \brief Mean squared displacement of a trajectory at logarithmically spaced lags.
+*/
+
+namespace freud { namespace msd {
+
+//! Accumulate the mean squared displacement of a trajectory streamed in chunks of frames.
+/*! The frames are correlated with util::MultipleTau, so the mean squared
+ *  displacement is computed at the lags 0 to points_per_level - 1 and at
+ *  points_per_level / 2 lags per factor of two beyond, from pairs of actual
+ *  frames. The memory is bounded by points_per_level frames per level, so
+ *  trajectories of any length can be accumulated chunk by chunk.
+ */
+class MultipleTauMSD
+{
+public:
+    //! Constructor
+    /*! \param points_per_level Number of frames kept in each level of the correlator.
+     */
+    explicit MultipleTauMSD(unsigned int points_per_level);
+
+    //! Destructor
+    ~MultipleTauMSD() = default;
+
+    //! Remove all accumulated frames.
+    void reset();
+
+    //! Accumulate consecutive frames of unwrapped positions.
+    /*! \param positions Unwrapped positions of n_frames frames of n_points points each.
+     *  \param n_frames Number of frames.
+     *  \param n_points Number of points of each frame, which must be the same for all frames.
+     */
+    void accumulate(const vec3<float>* positions, unsigned int n_frames, unsigned int n_points);
+
+    //! Get the number of frames kept in each level of the correlator.
+    unsigned int getPointsPerLevel() const
+    {
+        return m_points_per_level;
+    }
+
+    //! Get the lags in frames resolved by the accumulated frames.
+    const util::ManagedArray<unsigned int>& getLags() const
+    {
+        return m_lags;
+    }
+
+    //! Get the mean squared displacement at each resolved lag.
+    const util::ManagedArray<double>& getMSD() const
+    {
+        return m_msd;
+    }
+
+private:
+    unsigned int m_points_per_level;              //!< Number of frames kept in each level
+    util::MultipleTau<vec3<float>> m_frames;      //!< Frames kept for correlations at all lags
+    util::ThreadStorage<double> m_lag_sums_local; //!< Thread-specific sums of squared displacements per lag
+    util::ManagedArray<unsigned int> m_lags;      //!< Lags resolved by the accumulated frames
+    util::ManagedArray<double> m_msd;             //!< Mean squared displacement at each resolved lag
+};
+
+}; }; // end namespace freud::msd
+
+#endif // MULTIPLE_TAU_MSD_H
@@ -1,11 +1,13 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <cstring>
 #include <functional>
 #include <stdexcept>
 
 #include "Cubatic.h"
+#include "ThreadStorage.h"
 #include "utils.h"
 
 /*! \file Cubatic.h
@@ -14,6 +16,155 @@
 
 namespace freud { namespace order {
 
+namespace {
+//! Number of distinct fourth order monomials of the components of a 3D vector.
+constexpr unsigned int N_MONOMIALS = 15;
+
+//! The fourth order monomials v_a v_b v_c v_d of the components of a vector.
+/*! The homogeneous tensor of a vector only depends on the multiset of its
+ *  indices, so sums of homogeneous tensors are accumulated as sums of the 15
+ *  distinct monomials, and the contraction of any tensor4 with a homogeneous
+ *  tensor is a linear combination of them.
+ */
+struct Monomials
+{
+    Monomials()
+    {
+        unsigned int m = 0;
+        for (unsigned int a = 0; a < 3; ++a)
+        {
+            for (unsigned int b = a; b < 3; ++b)
+            {
+                for (unsigned int c = b; c < 3; ++c)
+                {
+                    for (unsigned int d = c; d < 3; ++d)
+                    {
+                        components[m] = {a, b, c, d};
+                        ++m;
+                    }
+                }
+            }
+        }
+
+        unsigned int cnt = 0;
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+            for (unsigned int j = 0; j < 3; ++j)
+            {
+                for (unsigned int k = 0; k < 3; ++k)
+                {
+                    for (unsigned int l = 0; l < 3; ++l)
+                    {
+                        std::array<unsigned int, 4> sorted = {i, j, k, l};
+                        std::sort(sorted.begin(), sorted.end());
+                        index[cnt] = static_cast<unsigned int>(
+                            std::find(components.begin(), components.end(), sorted) - components.begin());
+                        ++cnt;
+                    }
+                }
+            }
+        }
+    }
+
+    //! Compute the monomials of a vector.
+    void evaluate(const vec3<float>& vector, std::array<float, N_MONOMIALS>& values) const
+    {
+        const std::array<float, 3> v = {vector.x, vector.y, vector.z};
+        for (unsigned int m = 0; m < N_MONOMIALS; ++m)
+        {
+            values[m] = v[components[m][0]] * v[components[m][1]] * v[components[m][2]] * v[components[m][3]];
+        }
+    }
+
+    std::array<std::array<unsigned int, 4>, N_MONOMIALS> components; //!< Component indices of each monomial
+    std::array<unsigned int, 81> index; //!< Monomial of each element of a tensor4
+};
+
+const Monomials& getMonomials()
+{
+    static const Monomials monomials;
+    return monomials;
+}
+
+//! The system vectors rotated by the orientations of a block of consecutive particles.
+struct RotatedSystemVectors
+{
+    //! Number of particles of a block.
+    static constexpr size_t BLOCK_SIZE = 64;
+
+    //! Get the index of particle i in its block, rotating the block if i is its first particle.
+    /*! The blocks start at the first particle of a range and end at most at end.
+     */
+    size_t get(const quat<float>* orientations, size_t i, size_t end,
+               const std::array<vec3<float>, 3>& system_vectors)
+    {
+        if (i >= block_end)
+        {
+            block_begin = i;
+            block_end = std::min(i + BLOCK_SIZE, end);
+            for (unsigned int a = 0; a < 3; ++a)
+            {
+                rotateBatch(orientations + i, system_vectors[a], block_end - i, vectors[a].data());
+            }
+        }
+        return i - block_begin;
+    }
+
+    std::array<std::array<vec3<float>, BLOCK_SIZE>, 3> vectors; //!< Rotated system vectors of the block
+    size_t block_begin {0};                                       //!< First particle of the block
+    size_t block_end {0};                                         //!< One past the last particle of the block
+};
+
+//! Maximum number of steps of the gradient ascent of each replicate.
+constexpr unsigned int MAX_GRADIENT_STEPS = 10000;
+
+//! Rotation angle below which the gradient ascent is converged.
+constexpr double MIN_GRADIENT_ANGLE = 1e-10;
+
+//! Sum of the contractions of a tensor with the homogeneous tensors of the rotated system vectors.
+/*! \param monomials The fourth order monomials.
+ *  \param coefficients Coefficient of each monomial in the contraction of the tensor.
+ *  \param orientation Rotation applied to the Euclidean basis vectors.
+ *  \param gradient Output gradient of the sum with respect to the rotation
+ *         vector of an infinitesimal rotation applied to orientation.
+ *
+ *  \return \sum_{v} \bar{M} \cdot v^{\otimes 4} over the rotated basis vectors v.
+ */
+double contractRotatedBasis(const Monomials& monomials, const std::array<double, N_MONOMIALS>& coefficients,
+                            const quat<double>& orientation, vec3<double>& gradient)
+{
+    double value = 0;
+    gradient = vec3<double>(0, 0, 0);
+    for (unsigned int a = 0; a < 3; ++a)
+    {
+        const vec3<double> v = rotate(orientation, vec3<double>(a == 0, a == 1, a == 2));
+        const std::array<double, 3> components = {v.x, v.y, v.z};
+        std::array<double, 3> form_gradient = {0, 0, 0};
+        for (unsigned int m = 0; m < N_MONOMIALS; ++m)
+        {
+            const auto& indices = monomials.components[m];
+            value += coefficients[m] * components[indices[0]] * components[indices[1]]
+                * components[indices[2]] * components[indices[3]];
+            for (unsigned int p = 0; p < 4; ++p)
+            {
+                double product = coefficients[m];
+                for (unsigned int o = 0; o < 4; ++o)
+                {
+                    if (o != p)
+                    {
+                        product *= components[indices[o]];
+                    }
+                }
+                form_gradient[indices[p]] += product;
+            }
+        }
+        // Rotating v by a small rotation vector w changes it by w x v.
+        gradient += cross(v, vec3<double>(form_gradient[0], form_gradient[1], form_gradient[2]));
+    }
+    return value;
+}
+} // namespace
+
 tensor4::tensor4(const vec3<float>& vector)
 {
     unsigned int cnt = 0;
@@ -129,8 +280,10 @@ tensor4 genR4Tensor()
     return r4;
 }
 
-Cubatic::Cubatic(float t_initial, float t_final, float scale, unsigned int n_replicates, unsigned int seed)
-    : m_t_initial(t_initial), m_t_final(t_final), m_scale(scale), m_n_replicates(n_replicates), m_seed(seed)
+Cubatic::Cubatic(float t_initial, float t_final, float scale, unsigned int n_replicates, unsigned int seed,
+                 CubaticOptimizer optimizer)
+    : m_t_initial(t_initial), m_t_final(t_final), m_scale(scale), m_n_replicates(n_replicates), m_seed(seed),
+      m_optimizer(optimizer)
 {
     if (m_t_initial < m_t_final)
     {
@@ -156,7 +309,7 @@ Cubatic::Cubatic(float t_initial, float t_final, float scale, unsigned int n_rep
     m_system_vectors[2] = vec3<float>(0, 0, 1);
 }
 
-tensor4 Cubatic::calcCubaticTensor(quat<float>& orientation)
+tensor4 Cubatic::calcCubaticTensor(const quat<float>& orientation) const
 {
     tensor4 calculated_tensor = tensor4();
     for (auto& m_system_vector : m_system_vectors)
@@ -184,56 +337,119 @@ template<typename T> quat<float> Cubatic::calcRandomQuaternion(T& dist, float an
     return quat<float>::fromAxisAngle(axis, angle);
 }
 
-util::ManagedArray<tensor4> Cubatic::calculatePerParticleTensor(const quat<float>* orientations) const
+tensor4 Cubatic::calculateGlobalTensor(quat<float>* orientations) const
 {
-    util::ManagedArray<tensor4> particle_tensor(m_n);
-
-    // calculate per-particle tensor
-    util::forLoopWrapper(0, m_n, [&](size_t begin, size_t end) {
+    // The global tensor is the average of the homogeneous tensors of the
+    // rotated system vectors, so the monomials of these vectors are summed
+    // directly rather than storing the tensor of each particle.
+    const Monomials& monomials = getMonomials();
+    util::ThreadStorage<double> monomial_sums_local(N_MONOMIALS);
+    monomial_sums_local.accumulate(0, m_n, [&](size_t begin, size_t end, auto& local_sums) {
+        std::array<double, N_MONOMIALS> range_sums {};
+        std::array<float, N_MONOMIALS> values {};
+        RotatedSystemVectors rotated;
         for (size_t i = begin; i < end; ++i)
         {
-            tensor4 l_mbar = tensor4();
-            for (const auto& m_system_vector : m_system_vectors)
+            const size_t block_index = rotated.get(orientations, i, end, m_system_vectors);
+            for (const auto& vectors : rotated.vectors)
             {
-                // Calculate the homogeneous tensor H for each vector then add
-                // to the per-particle value.
-                vec3<float> v_r = rotate(orientations[i], m_system_vector);
-                tensor4 r4_tensor(v_r);
-                l_mbar += r4_tensor;
+                monomials.evaluate(vectors[block_index], values);
+                for (unsigned int m = 0; m < N_MONOMIALS; ++m)
+                {
+                    range_sums[m] += values[m];
+                }
             }
-
-            // Apply the prefactor from the sum in equation 27 before assigning.
-            particle_tensor[i] = l_mbar * 2.0;
+        }
+        for (unsigned int m = 0; m < N_MONOMIALS; ++m)
+        {
+            local_sums[m] += range_sums[m];
         }
     });
-    return particle_tensor;
-}
+    util::ManagedArray<double> monomial_sums(N_MONOMIALS);
+    monomial_sums_local.reduceInto(monomial_sums);
 
-tensor4 Cubatic::calculateGlobalTensor(quat<float>* orientations) const
-{
+    // Apply the prefactor 2/N from the third equation in eq. 27.
+    const double prefactor = 2.0 / static_cast<double>(m_n);
     tensor4 global_tensor = tensor4();
-    util::ManagedArray<tensor4> particle_tensor = calculatePerParticleTensor(orientations);
+    for (unsigned int i = 0; i < 81; ++i)
+    {
+        global_tensor[i] = static_cast<float>(prefactor * monomial_sums[monomials.index[i]]);
+    }
+    return global_tensor - m_gen_r4_tensor;
+}
 
-    // now calculate the global tensor
-    float n_inv = float(1.0) / static_cast<float>(m_n);
+void Cubatic::optimizeByGradientAscent(const tensor4& global_tensor,
+                                       util::ManagedArray<tensor4>& p_cubatic_tensor,
+                                       util::ManagedArray<float>& p_cubatic_order_parameter,
+                                       util::ManagedArray<quat<float>>& p_cubatic_orientation) const
+{
+    // Maximizing the order parameter is equivalent to maximizing the
+    // contraction of the global tensor with M_{\omega}, which is a sum of
+    // quartic forms of the rotated basis vectors.
+    const Monomials& monomials = getMonomials();
+    std::array<double, N_MONOMIALS> coefficients {};
+    for (unsigned int i = 0; i < 81; ++i)
+    {
+        coefficients[monomials.index[i]] += global_tensor.data[i];
+    }
 
-    util::forLoopWrapper(0, 81, [&](size_t begin, size_t end) {
+    util::forLoopWrapper(0, m_n_replicates, [&](size_t begin, size_t end) {
         for (size_t i = begin; i < end; i++)
         {
-            float tensor_value = 0;
-            for (unsigned int j = 0; j < m_n; j++)
+            // Each replicate has its own generator for its starting
+            // orientation, so the result does not depend on the number of threads.
+            std::vector<unsigned int> seed_seq(3);
+            seed_seq[0] = m_seed;
+            seed_seq[1] = static_cast<unsigned int>(i);
+            seed_seq[2] = 0xffaabb;
+            std::seed_seq seed(seed_seq.begin(), seed_seq.end());
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> base_dist(0, 1);
+            auto dist = [&]() { return base_dist(rng); };
+            const quat<float> start = calcRandomQuaternion(dist);
+
+            // Steepest ascent on the rotation group with an adaptive step: a
+            // step is doubled after an increase and halved otherwise.
+            quat<double> orientation(start.s, vec3<double>(start.v.x, start.v.y, start.v.z));
+            vec3<double> gradient;
+            double value = contractRotatedBasis(monomials, coefficients, orientation, gradient);
+            double step = 0.1;
+            for (unsigned int n_steps = 0; n_steps < MAX_GRADIENT_STEPS; ++n_steps)
             {
-                tensor_value += particle_tensor[j][i];
+                const double gradient_norm = std::sqrt(dot(gradient, gradient));
+                const double angle = step * gradient_norm;
+                if (angle < MIN_GRADIENT_ANGLE)
+                {
+                    break;
+                }
+                quat<double> new_orientation
+                    = quat<double>::fromAxisAngle(gradient / gradient_norm, angle) * orientation;
+                new_orientation = new_orientation * (1.0 / std::sqrt(norm2(new_orientation)));
+                vec3<double> new_gradient;
+                const double new_value
+                    = contractRotatedBasis(monomials, coefficients, new_orientation, new_gradient);
+                if (new_value > value)
+                {
+                    orientation = new_orientation;
+                    gradient = new_gradient;
+                    value = new_value;
+                    step *= 2;
+                }
+                else
+                {
+                    step /= 2;
+                }
             }
-            // Note that in the third equation in eq. 27, the prefactor of the
-            // sum is 2/N, but the factor of 2 is already accounted for in the
-            // calculation of per particle calculation in
-            // calculatePerParticleTensor, so here we just need to apply the 1/N
-            // scaling.
-            global_tensor[i] = tensor_value * n_inv;
+
+            quat<float> cubatic_orientation(
+                static_cast<float>(orientation.s),
+                vec3<float>(static_cast<float>(orientation.v.x), static_cast<float>(orientation.v.y),
+                            static_cast<float>(orientation.v.z)));
+            p_cubatic_tensor[i] = calcCubaticTensor(cubatic_orientation);
+            p_cubatic_orientation[i] = cubatic_orientation;
+            p_cubatic_order_parameter[i] = calcCubaticOrderParameter(p_cubatic_tensor[i], global_tensor);
         }
     });
-    return global_tensor - m_gen_r4_tensor;
 }
 
 void Cubatic::compute(quat<float>* orientations, unsigned int num_orientations)
@@ -254,52 +470,49 @@ void Cubatic::compute(quat<float>* orientations, unsigned int num_orientations)
     util::ManagedArray<float> p_cubatic_order_parameter(m_n_replicates);
     util::ManagedArray<quat<float>> p_cubatic_orientation(m_n_replicates);
 
-    util::forLoopWrapper(0, m_n_replicates, [&](size_t begin, size_t end) {
-        // create thread-specific rng
-        const auto thread_start = static_cast<unsigned int>(begin);
-
-        std::vector<unsigned int> seed_seq(3);
-        seed_seq[0] = m_seed;
-        seed_seq[1] = thread_start;
-        seed_seq[2] = 0xffaabb;
-        std::seed_seq seed(seed_seq.begin(), seed_seq.end());
-        std::mt19937 rng(seed);
-        std::uniform_real_distribution<float> base_dist(0, 1);
-        auto dist = [&]() { return base_dist(rng); };
-
-        for (size_t i = begin; i < end; i++)
-        {
-            // need to generate random orientation
-            quat<float> cubatic_orientation = calcRandomQuaternion(dist);
-            quat<float> new_orientation = cubatic_orientation;
-
-            // now calculate the cubatic tensor
-            tensor4 cubatic_tensor = calcCubaticTensor(cubatic_orientation);
-            float cubatic_order_parameter = calcCubaticOrderParameter(cubatic_tensor, global_tensor);
-            float new_order_parameter = cubatic_order_parameter;
-
-            // set initial temperature and count
-            float t_current = m_t_initial;
-            unsigned int loop_count = 0;
-            // simulated annealing loop; loop counter to prevent inf loops
-            while ((t_current > m_t_final) && (loop_count < 10000))
+    if (m_optimizer == GradientAscent)
+    {
+        optimizeByGradientAscent(global_tensor, p_cubatic_tensor, p_cubatic_order_parameter,
+                                 p_cubatic_orientation);
+    }
+    else
+    {
+        util::forLoopWrapper(0, m_n_replicates, [&](size_t begin, size_t end) {
+            // create thread-specific rng
+            const auto thread_start = static_cast<unsigned int>(begin);
+
+            std::vector<unsigned int> seed_seq(3);
+            seed_seq[0] = m_seed;
+            seed_seq[1] = thread_start;
+            seed_seq[2] = 0xffaabb;
+            std::seed_seq seed(seed_seq.begin(), seed_seq.end());
+            std::mt19937 rng(seed);
+            std::uniform_real_distribution<float> base_dist(0, 1);
+            auto dist = [&]() { return base_dist(rng); };
+
+            for (size_t i = begin; i < end; i++)
             {
-                ++loop_count;
-                new_orientation = calcRandomQuaternion(dist, 0.1) * (cubatic_orientation);
+                // need to generate random orientation
+                quat<float> cubatic_orientation = calcRandomQuaternion(dist);
+                quat<float> new_orientation = cubatic_orientation;
+
                 // now calculate the cubatic tensor
-                tensor4 new_cubatic_tensor = calcCubaticTensor(new_orientation);
-                new_order_parameter = calcCubaticOrderParameter(new_cubatic_tensor, global_tensor);
-                if (new_order_parameter > cubatic_order_parameter)
+                tensor4 cubatic_tensor = calcCubaticTensor(cubatic_orientation);
+                float cubatic_order_parameter = calcCubaticOrderParameter(cubatic_tensor, global_tensor);
+                float new_order_parameter = cubatic_order_parameter;
+
+                // set initial temperature and count
+                float t_current = m_t_initial;
+                unsigned int loop_count = 0;
+                // simulated annealing loop; loop counter to prevent inf loops
+                while ((t_current > m_t_final) && (loop_count < 10000))
                 {
-                    cubatic_tensor = new_cubatic_tensor;
-                    cubatic_order_parameter = new_order_parameter;
-                    cubatic_orientation = new_orientation;
-                }
-                else
-                {
-                    float boltzmann_factor
-                        = std::exp(-(cubatic_order_parameter - new_order_parameter) / t_current);
-                    if (boltzmann_factor >= dist())
+                    ++loop_count;
+                    new_orientation = calcRandomQuaternion(dist, 0.1) * (cubatic_orientation);
+                    // now calculate the cubatic tensor
+                    tensor4 new_cubatic_tensor = calcCubaticTensor(new_orientation);
+                    new_order_parameter = calcCubaticOrderParameter(new_cubatic_tensor, global_tensor);
+                    if (new_order_parameter > cubatic_order_parameter)
                     {
                         cubatic_tensor = new_cubatic_tensor;
                         cubatic_order_parameter = new_order_parameter;
@@ -307,18 +520,29 @@ void Cubatic::compute(quat<float>* orientations, unsigned int num_orientations)
                     }
                     else
                     {
-                        continue;
+                        float boltzmann_factor
+                            = std::exp(-(cubatic_order_parameter - new_order_parameter) / t_current);
+                        if (boltzmann_factor >= dist())
+                        {
+                            cubatic_tensor = new_cubatic_tensor;
+                            cubatic_order_parameter = new_order_parameter;
+                            cubatic_orientation = new_orientation;
+                        }
+                        else
+                        {
+                            continue;
+                        }
                     }
+                    t_current *= m_scale;
                 }
-                t_current *= m_scale;
+                // set values
+                p_cubatic_tensor[i] = cubatic_tensor;
+                p_cubatic_orientation[i].s = cubatic_orientation.s;
+                p_cubatic_orientation[i].v = cubatic_orientation.v;
+                p_cubatic_order_parameter[i] = cubatic_order_parameter;
             }
-            // set values
-            p_cubatic_tensor[i] = cubatic_tensor;
-            p_cubatic_orientation[i].s = cubatic_orientation.s;
-            p_cubatic_orientation[i].v = cubatic_orientation.v;
-            p_cubatic_order_parameter[i] = cubatic_order_parameter;
-        }
-    });
+        });
+    }
 
     // Loop over threads and choose the replicate that found the highest order.
     unsigned int max_idx = 0;
@@ -337,15 +561,45 @@ void Cubatic::compute(quat<float>* orientations, unsigned int num_orientations)
     m_cubatic_orientation = p_cubatic_orientation[max_idx];
     m_cubatic_order_parameter = p_cubatic_order_parameter[max_idx];
 
-    // Now calculate the per-particle order parameters
+    // Now calculate the per-particle order parameters. The per-particle order
+    // parameter is defined as the value of the cubatic order parameter if the
+    // global orientation was the particle orientation. The norm of the cubatic
+    // tensor M_{\omega} does not depend on the orientation, and the contraction
+    // of the global tensor with M_{\omega} is a sum over the homogeneous
+    // tensors of the rotated system vectors, each of which is a linear
+    // combination of their monomials. Only the monomials are thus computed
+    // for each particle:
+    //   |\bar{M} - M_{\omega}|^2 = |\bar{M}|^2 + |M_{\omega}|^2 + 2 \bar{M} \cdot R4
+    //                              - 4 \sum_{v} \bar{M} \cdot v^{\otimes 4}
+    const Monomials& monomials = getMonomials();
+    std::array<float, N_MONOMIALS> coefficients {};
+    for (unsigned int i = 0; i < 81; ++i)
+    {
+        coefficients[monomials.index[i]] += global_tensor.data[i];
+    }
+    quat<float> identity(1, vec3<float>(0, 0, 0));
+    const tensor4 reference_tensor = calcCubaticTensor(identity);
+    const float cubatic_norm = dot(reference_tensor, reference_tensor);
+    const float constant_term
+        = dot(global_tensor, global_tensor) + cubatic_norm + float(2.0) * dot(global_tensor, m_gen_r4_tensor);
+
     util::forLoopWrapper(0, m_n, [&](size_t begin, size_t end) {
+        std::array<float, N_MONOMIALS> values {};
+        RotatedSystemVectors rotated;
         for (size_t i = begin; i < end; i++)
         {
-            // The per-particle order parameter is defined as the value of the
-            // cubatic order parameter if the global orientation was the
-            // particle orientation, so we can reuse the same machinery.
+            float contraction = 0;
+            const size_t block_index = rotated.get(orientations, i, end, m_system_vectors);
+            for (const auto& vectors : rotated.vectors)
+            {
+                monomials.evaluate(vectors[block_index], values);
+                for (unsigned int m = 0; m < N_MONOMIALS; ++m)
+                {
+                    contraction += coefficients[m] * values[m];
+                }
+            }
             m_particle_order_parameter[i]
-                = calcCubaticOrderParameter(calcCubaticTensor(orientations[i]), global_tensor);
+                = float(1.0) - (constant_term - float(4.0) * contraction) / cubatic_norm;
         }
     });
 }
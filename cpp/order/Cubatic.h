@@ -36,6 +36,13 @@ struct tensor4
     std::array<float, 81> data {0};
 };
 
+//! Method used to find the orientation that maximizes the cubatic order parameter.
+enum CubaticOptimizer
+{
+    Annealing,     //!< Simulated annealing from random orientations.
+    GradientAscent //!< Deterministic gradient ascent on the rotation group from random orientations.
+};
+
 //! Compute the cubatic order parameter for a set of points
 /*! The cubatic order parameter is defined according to the paper "Strong
  * orientational coordinates and orientational order parameters for symmetric
@@ -56,7 +63,8 @@ class Cubatic
 {
 public:
     //! Constructor
-    Cubatic(float t_initial, float t_final, float scale, unsigned int replicates, unsigned int seed);
+    Cubatic(float t_initial, float t_final, float scale, unsigned int replicates, unsigned int seed,
+            CubaticOptimizer optimizer = Annealing);
 
     //! Destructor
     ~Cubatic() = default;
@@ -123,6 +131,11 @@ public:
         return m_seed;
     }
 
+    CubaticOptimizer getOptimizer() const
+    {
+        return m_optimizer;
+    }
+
 private:
     //! Calculate the cubatic tensor
     /*! Implements the second line of eq. 27, the calculation of M_{\omega}.
@@ -132,7 +145,7 @@ private:
      *
      *  \return The cubatic tensor M_{\omega}.
      */
-    tensor4 calcCubaticTensor(quat<float>& orientation);
+    tensor4 calcCubaticTensor(const quat<float>& orientation) const;
 
     //! Calculate the scalar cubatic order parameter.
     /*! Implements eq. 22.
@@ -144,20 +157,22 @@ private:
      */
     static float calcCubaticOrderParameter(const tensor4& cubatic_tensor, const tensor4& global_tensor);
 
-    //! Calculate the per-particle tensor.
-    /*! Implements the first line of eq. 27, the calculation of M.
-     *
-     *  \param orientations The per-particle orientations.
-     *
-     *  \return The per-particle cubatic tensors value M^{ijkl}.
-     */
-    util::ManagedArray<tensor4> calculatePerParticleTensor(const quat<float>* orientations) const;
-
     //! Calculate the global tensor for the system.
-    /*! Implements the third line of eq. 27, the calculation of \bar{M}.
+    /*! Implements the first and third lines of eq. 27, the calculation of
+     *  \bar{M}, summing the per-particle tensors M without storing them.
      */
     tensor4 calculateGlobalTensor(quat<float>* orientations) const;
 
+    //! Find the cubatic orientation of each replicate by gradient ascent.
+    /*! The temperatures and scale of the annealing are not used. Each
+     *  replicate starts from a random orientation and follows the gradient of
+     *  the order parameter with respect to rotations until it converges, so
+     *  the result only depends on the seed.
+     */
+    void optimizeByGradientAscent(const tensor4& global_tensor, util::ManagedArray<tensor4>& p_cubatic_tensor,
+                                  util::ManagedArray<float>& p_cubatic_order_parameter,
+                                  util::ManagedArray<quat<float>>& p_cubatic_orientation) const;
+
     //! Calculate a random quaternion.
     /*! To calculate a random quaternion in a way that obeys the right
      *  distribution of angles, we cannot simply just choose 4 random numbers
@@ -167,12 +182,13 @@ private:
      */
     template<typename T> quat<float> calcRandomQuaternion(T& dist, float angle_multiplier = 1.0) const;
 
-    float m_t_initial;           //!< Initial temperature for simulated annealing.
-    float m_t_final;             //!< Final temperature for simulated annealing.
-    float m_scale;               //!< Scaling factor to reduce temperature.
-    unsigned int m_n_replicates; //!< Number of replicates.
-    unsigned int m_seed;         //!< Random seed.
-    unsigned int m_n {0};        //!< Last number of points computed.
+    float m_t_initial;            //!< Initial temperature for simulated annealing.
+    float m_t_final;              //!< Final temperature for simulated annealing.
+    float m_scale;                //!< Scaling factor to reduce temperature.
+    unsigned int m_n_replicates;  //!< Number of replicates.
+    unsigned int m_seed;          //!< Random seed.
+    CubaticOptimizer m_optimizer; //!< Method used to maximize the order parameter.
+    unsigned int m_n {0};         //!< Last number of points computed.
 
     float m_cubatic_order_parameter {0}; //!< The value of the order parameter.
     quat<float> m_cubatic_orientation;   //!< The cubatic orientation.
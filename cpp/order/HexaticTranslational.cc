@@ -1,11 +1,68 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
 #include "HexaticTranslational.h"
 
 namespace freud { namespace order {
 
+namespace {
+//! Number of bonds of a query point whose contributions are computed together.
+constexpr size_t BOND_BLOCK_SIZE = 64;
+
+//! Compute e^{ik theta} of a block of bond vectors, where theta is the angle of each bond.
+/*! The unit vector (x + iy) / r of each bond is raised to the power k by
+ *  repeated squaring, which replaces the atan2 and complex exponential of
+ *  each bond with a few complex multiplications. The exponent is the same
+ *  for all bonds, so the loops over the bonds of the block have no branches
+ *  and are vectorized by the compiler. Bonds of zero length have theta = 0,
+ *  matching atan2(0, 0).
+ */
+void unitVectorPowers(const float* x, const float* y, size_t n, unsigned int k, float* re, float* im)
+{
+    float base_re[BOND_BLOCK_SIZE];
+    float base_im[BOND_BLOCK_SIZE];
+    for (size_t b = 0; b < n; ++b)
+    {
+        const float r_sq = x[b] * x[b] + y[b] * y[b];
+        const float inv_r = (r_sq > 0) ? float(1.0) / std::sqrt(r_sq) : float(0.0);
+        base_re[b] = (r_sq > 0) ? x[b] * inv_r : float(1.0);
+        base_im[b] = y[b] * inv_r;
+        re[b] = 1;
+        im[b] = 0;
+    }
+    for (unsigned int exponent = k; exponent != 0; exponent >>= 1)
+    {
+        if ((exponent & 1U) != 0)
+        {
+            for (size_t b = 0; b < n; ++b)
+            {
+                const float new_re = re[b] * base_re[b] - im[b] * base_im[b];
+                im[b] = re[b] * base_im[b] + im[b] * base_re[b];
+                re[b] = new_re;
+            }
+        }
+        if (exponent > 1)
+        {
+            for (size_t b = 0; b < n; ++b)
+            {
+                const float new_re = base_re[b] * base_re[b] - base_im[b] * base_im[b];
+                base_im[b] = float(2.0) * base_re[b] * base_im[b];
+                base_re[b] = new_re;
+            }
+        }
+    }
+}
+} // namespace
+
 //! Compute the order parameter
+/*! \param func An object with operator()(const float* x, const float* y,
+ *         size_t n, float* re, float* im) writing the contributions of n
+ *         bond vectors, with n at most BOND_BLOCK_SIZE.
+ */
 template<typename T>
 template<typename Func>
 void HexaticTranslational<T>::computeGeneral(Func func, const freud::locality::NeighborList* nlist,
@@ -18,32 +75,97 @@ void HexaticTranslational<T>::computeGeneral(Func func, const freud::locality::N
     const unsigned int Np = points->getNPoints();
 
     m_psi_array.prepare(Np);
+    std::vector<float> total_weights(Np, 0);
 
-    freud::locality::loopOverNeighborsIterator(
-        points, points->getPoints(), Np, qargs, nlist,
-        [&](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
-            float total_weight(0);
-            const vec3<float> ref((*points)[i]);
-
-            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
-            {
+    if (nlist != nullptr)
+    {
+        // The bonds of each query point are contiguous in the neighbor list
+        // and are processed directly from its arrays in blocks.
+        util::forLoopWrapper(0, Np, [&](size_t begin, size_t end) {
+            computeRange(func, *nlist, points, begin, end, nlist->find_first_index(begin),
+                         total_weights.data());
+        });
+    }
+    else
+    {
+        // All bonds of a query point are found by the same task, so the
+        // sums are accumulated without synchronization.
+        freud::locality::loopOverNeighbors(
+            points, points->getPoints(), Np, qargs, nullptr, [&](const freud::locality::NeighborBond& nb) {
                 // Compute vector from query_point to point
-                const vec3<float> delta = box.wrap((*points)[nb.point_idx] - ref);
+                const vec3<float> delta = box.wrap((*points)[nb.point_idx] - (*points)[nb.query_point_idx]);
                 const float weight(m_weighted ? nb.weight : 1.0);
+                float re;
+                float im;
+                func(&delta.x, &delta.y, 1, &re, &im);
+                m_psi_array[nb.query_point_idx] += weight * std::complex<float>(re, im);
+                total_weights[nb.query_point_idx] += weight;
+            });
+    }
 
-                // Compute psi for this vector
-                m_psi_array[i] += weight * func(delta);
-                total_weight += weight;
+    normalize(total_weights.data(), normalize_by_k);
+}
+
+template<typename T>
+template<typename Func>
+void HexaticTranslational<T>::computeRange(Func func, const freud::locality::NeighborList& nlist,
+                                           const freud::locality::NeighborQuery* points, size_t begin,
+                                           size_t end, size_t first_bond, float* total_weights)
+{
+    const box::Box& box = points->getBox();
+    const unsigned int* neighbors = nlist.getNeighbors().get();
+    const float* weights = nlist.getWeights().get();
+    const size_t n_bonds = nlist.getNumBonds();
+    float x[BOND_BLOCK_SIZE];
+    float y[BOND_BLOCK_SIZE];
+    float re[BOND_BLOCK_SIZE];
+    float im[BOND_BLOCK_SIZE];
+    float bond_weights[BOND_BLOCK_SIZE];
+    size_t bond = first_bond;
+    for (size_t i = begin; i < end; ++i)
+    {
+        const vec3<float> ref((*points)[i]);
+        std::complex<float> psi(0);
+        float total_weight(0);
+        while (bond < n_bonds && neighbors[2 * bond] == i)
+        {
+            size_t n = 0;
+            for (; n < BOND_BLOCK_SIZE && bond < n_bonds && neighbors[2 * bond] == i; ++n, ++bond)
+            {
+                // Compute vector from query_point to point
+                const vec3<float> delta = box.wrap((*points)[neighbors[2 * bond + 1]] - ref);
+                x[n] = delta.x;
+                y[n] = delta.y;
+                bond_weights[n] = m_weighted ? weights[bond] : float(1.0);
+            }
+            func(x, y, n, re, im);
+            for (size_t b = 0; b < n; ++b)
+            {
+                psi += bond_weights[b] * std::complex<float>(re[b], im[b]);
+                total_weight += bond_weights[b];
             }
+        }
+        m_psi_array[i] = psi;
+        total_weights[i] = total_weight;
+    }
+}
+
+template<typename T>
+void HexaticTranslational<T>::normalize(const float* total_weights, bool normalize_by_k)
+{
+    util::forLoopWrapper(0, m_psi_array.size(), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
             if (normalize_by_k)
             {
                 m_psi_array[i] /= std::complex<float>(m_k);
             }
             else
             {
-                m_psi_array[i] /= std::complex<float>(total_weight);
+                m_psi_array[i] /= std::complex<float>(total_weights[i]);
             }
-        });
+        }
+    });
 }
 
 Hexatic::Hexatic(unsigned int k, bool weighted) : HexaticTranslational<unsigned int>(k, weighted) {}
@@ -52,20 +174,55 @@ void Hexatic::compute(const freud::locality::NeighborList* nlist,
                       const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
 {
     computeGeneral(
-        [this](const vec3<float>& delta) {
-            const float theta_ij = std::atan2(delta.y, delta.x);
-            return std::exp(std::complex<float>(0, static_cast<float>(m_k) * theta_ij));
+        [this](const float* x, const float* y, size_t n, float* re, float* im) {
+            unitVectorPowers(x, y, n, m_k, re, im);
         },
         nlist, points, qargs, false);
 }
 
+void Hexatic::beginBonds(const freud::locality::NeighborQuery* neighbor_query,
+                         const vec3<float>* query_points, unsigned int n_query_points,
+                         const freud::locality::NeighborList& /*nlist*/)
+{
+    if (query_points != neighbor_query->getPoints() || n_query_points != neighbor_query->getNPoints())
+    {
+        throw std::invalid_argument("Hexatic requires the query points to be the points.");
+    }
+    neighbor_query->getBox().enforce2D();
+    m_stage_points = neighbor_query;
+    m_psi_array.prepare(n_query_points);
+    m_stage_total_weights.assign(n_query_points, 0);
+}
+
+void Hexatic::consumeBonds(const freud::locality::NeighborList& nlist, size_t begin, size_t end,
+                           size_t first_bond, size_t /*end_bond*/)
+{
+    computeRange(
+        [this](const float* x, const float* y, size_t n, float* re, float* im) {
+            unitVectorPowers(x, y, n, m_k, re, im);
+        },
+        nlist, m_stage_points, begin, end, first_bond, m_stage_total_weights.data());
+}
+
+void Hexatic::endBonds(const freud::locality::NeighborList& /*nlist*/)
+{
+    normalize(m_stage_total_weights.data(), false);
+}
+
 Translational::Translational(float k, bool weighted) : HexaticTranslational<float>(k, weighted) {}
 
 void Translational::compute(const freud::locality::NeighborList* nlist,
                             const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
 {
-    computeGeneral([](const vec3<float>& delta) { return std::complex<float>(delta.x, delta.y); }, nlist,
-                   points, qargs, true);
+    computeGeneral(
+        [](const float* x, const float* y, size_t n, float* re, float* im) {
+            for (size_t b = 0; b < n; ++b)
+            {
+                re[b] = x[b];
+                im[b] = y[b];
+            }
+        },
+        nlist, points, qargs, true);
 }
 
 }; }; // namespace freud::order
@@ -5,7 +5,9 @@
 #define HEXATIC_TRANSLATIONAL_H
 
 #include <complex>
+#include <vector>
 
+#include "BondPipeline.h"
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborComputeFunctional.h"
@@ -54,6 +56,15 @@ protected:
                         const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs,
                         bool normalize_by_k);
 
+    //! Sum the contributions of the bonds of the points [begin, end), which start at first_bond.
+    template<typename Func>
+    void computeRange(Func func, const freud::locality::NeighborList& nlist,
+                      const freud::locality::NeighborQuery* points, size_t begin, size_t end,
+                      size_t first_bond, float* total_weights);
+
+    //! Normalize the order parameter of each point by k or by the total weight of its bonds.
+    void normalize(const float* total_weights, bool normalize_by_k);
+
     const T m_k; //!< The symmetry order for Hexatic, or normalization for Translational
     const bool
         m_weighted; //!< Whether to use neighbor weights in computing the order parameter (default false)
@@ -63,7 +74,7 @@ protected:
 //! Compute the hexatic order parameter for a set of points
 /*!
  */
-class Hexatic : public HexaticTranslational<unsigned int>
+class Hexatic : public HexaticTranslational<unsigned int>, public locality::BondStage
 {
 public:
     //! Constructor
@@ -75,6 +86,23 @@ public:
     //! Compute the hexatic order parameter
     void compute(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
                  freud::locality::QueryArgs qargs);
+
+    //! Prepare the order parameter of the points of the bonds consumed by computeBondStages.
+    /*! The query points must be the points.
+     */
+    void beginBonds(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                    unsigned int n_query_points, const freud::locality::NeighborList& nlist) override;
+
+    //! Sum the contributions of the bonds of a block of points.
+    void consumeBonds(const freud::locality::NeighborList& nlist, size_t begin, size_t end, size_t first_bond,
+                      size_t end_bond) override;
+
+    //! Normalize the order parameter of each point.
+    void endBonds(const freud::locality::NeighborList& nlist) override;
+
+private:
+    const freud::locality::NeighborQuery* m_stage_points {nullptr}; //!< Points of the consumed bonds
+    std::vector<float> m_stage_total_weights; //!< Total weight of the consumed bonds of each point
 };
 
 //! Compute the translational order parameter for a set of points
@@ -1,6 +1,8 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <array>
 #include <stdexcept>
 
 #include "Nematic.h"
@@ -12,6 +14,11 @@
 
 namespace freud { namespace order {
 
+namespace {
+//! Number of directors rotated at once, which are kept on the stack.
+constexpr size_t ROTATION_BLOCK_SIZE = 64;
+} // namespace
+
 // m_u is the molecular axis, normalized to a unit vector
 Nematic::Nematic(const vec3<float>& u) : m_u(u / std::sqrt(dot(u, u))) {}
 
@@ -45,42 +52,58 @@ vec3<float> Nematic::getU() const
     return m_u;
 }
 
-void Nematic::compute(quat<float>* orientations, unsigned int n)
+bool Nematic::hasParticleTensor() const
+{
+    return m_has_particle_tensor;
+}
+
+void Nematic::compute(quat<float>* orientations, unsigned int n, bool compute_particle_tensor)
 {
     m_n = n;
-    m_particle_tensor.prepare({m_n, 3, 3});
+    m_has_particle_tensor = compute_particle_tensor;
+    if (m_has_particle_tensor)
+    {
+        m_particle_tensor.prepare({m_n, 3, 3});
+    }
     m_nematic_tensor_local.reset();
 
-    // calculate per-particle tensor
-    util::forLoopWrapper(0, n, [&](size_t begin, size_t end) {
+    // Sum the per-particle tensors of each range on the stack and add them to
+    // the thread-local nematic tensor once per range.
+    m_nematic_tensor_local.accumulate(0, n, [&](size_t begin, size_t end, auto& local_tensor) {
+        float Q_sum[3][3] = {};
+        std::array<vec3<float>, ROTATION_BLOCK_SIZE> directors;
         for (size_t i = begin; i < end; ++i)
         {
-            // get the director of the particle
-            quat<float> q = orientations[i];
-            vec3<float> u_i = rotate(q, m_u);
-
-            util::ManagedArray<float> Q_ab({3, 3});
-
-            Q_ab(0, 0) = 1.5f * u_i.x * u_i.x - 0.5f;
-            Q_ab(0, 1) = 1.5f * u_i.x * u_i.y;
-            Q_ab(0, 2) = 1.5f * u_i.x * u_i.z;
-            Q_ab(1, 0) = 1.5f * u_i.y * u_i.x;
-            Q_ab(1, 1) = 1.5f * u_i.y * u_i.y - 0.5f;
-            Q_ab(1, 2) = 1.5f * u_i.y * u_i.z;
-            Q_ab(2, 0) = 1.5f * u_i.z * u_i.x;
-            Q_ab(2, 1) = 1.5f * u_i.z * u_i.y;
-            Q_ab(2, 2) = 1.5f * u_i.z * u_i.z - 0.5f;
-
-            // Set the values. The nematic tensor is reduced later.
+            // get the directors of a block of particles
+            const size_t block_index = (i - begin) % ROTATION_BLOCK_SIZE;
+            if (block_index == 0)
+            {
+                rotateBatch(orientations + i, m_u, std::min(ROTATION_BLOCK_SIZE, end - i), directors.data());
+            }
+            const vec3<float>& u_i = directors[block_index];
+            const float u[3] = {u_i.x, u_i.y, u_i.z};
+
             for (unsigned int j = 0; j < 3; j++)
             {
                 for (unsigned int k = 0; k < 3; k++)
                 {
-                    m_particle_tensor(i, j, k) += Q_ab(j, k);
-                    m_nematic_tensor_local.local()(j, k) += Q_ab(j, k);
+                    const float Q_jk = 1.5f * u[j] * u[k] - (j == k ? 0.5f : 0.0f);
+                    Q_sum[j][k] += Q_jk;
+                    if (compute_particle_tensor)
+                    {
+                        m_particle_tensor(i, j, k) = Q_jk;
+                    }
                 }
             }
         }
+
+        for (unsigned int j = 0; j < 3; j++)
+        {
+            for (unsigned int k = 0; k < 3; k++)
+            {
+                local_tensor(j, k) += Q_sum[j][k];
+            }
+        }
     });
 
     // Now calculate the sum of Q_ab's
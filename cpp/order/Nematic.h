@@ -29,13 +29,22 @@ public:
     virtual ~Nematic() = default;
 
     //! Compute the nematic order parameter
-    void compute(quat<float>* orientations, unsigned int n);
+    /*! \param orientations Orientations of the particles.
+     *  \param n Number of particles.
+     *  \param compute_particle_tensor Whether to store the tensor of each
+     *         particle. The nematic tensor is reduced directly from the
+     *         orientations, so the per-particle tensors are only needed as output.
+     */
+    void compute(quat<float>* orientations, unsigned int n, bool compute_particle_tensor = true);
 
     //! Get the value of the last computed nematic order parameter
     float getNematicOrderParameter() const;
 
     const util::ManagedArray<float>& getParticleTensor() const;
 
+    //! Whether the per-particle tensors were stored by the last call to compute
+    bool hasParticleTensor() const;
+
     const util::ManagedArray<float>& getNematicTensor() const;
 
     unsigned int getNumParticles() const;
@@ -49,6 +58,7 @@ private:
     vec3<float> m_u;                     //!< The molecular axis
     float m_nematic_order_parameter {0}; //!< Current value of the order parameter
     vec3<float> m_nematic_director;      //!< The director (eigenvector corresponding to the OP)
+    bool m_has_particle_tensor {false};  //!< Whether the per-particle tensors were stored
 
     util::ManagedArray<float> m_nematic_tensor {{3, 3}};        //!< The computed nematic tensor.
     util::ThreadStorage<float> m_nematic_tensor_local {{3, 3}}; //!< Thread-specific nematic tensor.
@@ -4,7 +4,10 @@
 #include "RotationalAutocorrelation.h"
 
 #include "utils.h"
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <vector>
 
 /*! \file RotationalAutocorrelation.cc
     \brief Implements the RotationalAutocorrelation class.
@@ -12,44 +15,81 @@
 
 namespace freud { namespace order {
 
-// This function wraps exponentiation for complex numbers to avoid
-// the case where pow((0,0), 0) returns (nan, nan). Additionally, it
-// serves as a micro-optimization since std::pow can be slow. We can take the
-// exponent to be an unsigned int since all the sums in the hyperspherical
-// harmonic below guarantee this.
-inline std::complex<float> cpow(std::complex<float> base, unsigned int p)
+namespace {
+//! Powers of the coordinates of a particle, reused by all terms of the sum.
+struct CoordinatePowers
 {
-    if (p == 0)
+    explicit CoordinatePowers(unsigned int l) : zeta(l + 1), zeta_conj(l + 1), xi_norm(l + 1) {}
+
+    std::vector<std::complex<float>> zeta;      //!< Powers of zeta
+    std::vector<std::complex<float>> zeta_conj; //!< Powers of the conjugate of zeta
+    std::vector<float> xi_norm;                 //!< Powers of -|xi|^2
+};
+
+//! Compute the autocorrelation of a single orientation with its reference orientation.
+std::complex<float> particleAutocorrelation(const util::ManagedArray<std::complex<float>>& coefficients,
+                                            unsigned int l, const quat<float>& ref_orientation,
+                                            const quat<float>& orientation, CoordinatePowers& powers)
+{
+    // Transform the orientation quaternions into Xi/Zeta coordinates;
+    quat<float> qq_1 = conj(ref_orientation) * orientation;
+    std::complex<float> xi = std::complex<float>(qq_1.v.x, qq_1.v.y);
+    std::complex<float> zeta = std::complex<float>(qq_1.v.z, qq_1.s);
+
+    powers.zeta[0] = powers.zeta_conj[0] = std::complex<float>(1, 0);
+    powers.xi_norm[0] = 1;
+    for (unsigned int p = 1; p <= l; ++p)
     {
-        return {1, 0};
+        powers.zeta[p] = powers.zeta[p - 1] * zeta;
+        powers.zeta_conj[p] = powers.zeta_conj[p - 1] * std::conj(zeta);
+        powers.xi_norm[p] = powers.xi_norm[p - 1] * -std::norm(xi);
     }
-    std::complex<float> val(base);
-    for (unsigned int i = 1; i < p; i++)
+
+    // Loop through the contributing quantum numbers.
+    std::complex<float> value(0, 0);
+    for (unsigned int m1 = 0; m1 <= l; ++m1)
     {
-        val *= base;
+        const unsigned int m2 = l - m1;
+        std::complex<float> sum_tracker(0, 0);
+        for (unsigned int k = 0; k <= std::min(m1, m2); ++k)
+        {
+            sum_tracker += coefficients(m1, k) * powers.xi_norm[k]
+                * (powers.zeta[m2 - k] * powers.zeta_conj[m1 - k]);
+        }
+        value += sum_tracker;
     }
-    return val;
+    return value;
 }
+} // namespace
 
-inline std::complex<float> RotationalAutocorrelation::hypersphere_harmonic(const std::complex<float> xi,
-                                                                           std::complex<float> zeta,
-                                                                           const unsigned int m1,
-                                                                           const unsigned int m2)
+RotationalAutocorrelation::RotationalAutocorrelation(unsigned int l)
+    : m_l(l), m_coefficients({m_l + 1, m_l + 1})
 {
-    const std::complex<float> xi_conj = std::conj(xi);
-    const std::complex<float> zeta_conj = std::conj(zeta);
-
-    // Doing a summation over non-negative exponents, which requires the additional inner conditional.
-    std::complex<float> sum_tracker(0, 0);
-    for (unsigned int k = (m1 + m2 < m_l ? 0 : m1 + m2 - m_l); k <= std::min(m1, m2); k++)
+    // The hyperspherical harmonics of the unit quaternion (xi = 0, zeta = i)
+    // vanish unless m1 + m2 = l, in which case they are equal to
+    // i^{m2} (-i)^{m1} / (m1! m2!). Only these harmonics contribute to the
+    // autocorrelation, and together with the normalization of the harmonics
+    // the autocorrelation of each particle reduces to
+    //   1/(l+1) \sum_{m1} i^{m1 - m2} \sum_{k} C(m1, k) C(m2, k)
+    //       (-|xi|^2)^k zeta^{m2 - k} conj(zeta)^{m1 - k}
+    // with m2 = l - m1. The binomial coefficients and phases are tabulated
+    // here, so no factorials are needed.
+    const std::complex<double> i_pow_minus_l = std::pow(std::complex<double>(0, -1), static_cast<int>(m_l));
+    for (unsigned int m1 = 0; m1 <= m_l; ++m1)
     {
-        float fact_product = static_cast<float>(m_factorials[k])
-            * static_cast<float>(m_factorials[m_l + k - m1 - m2]) * static_cast<float>(m_factorials[m1 - k])
-            * static_cast<float>(m_factorials[m2 - k]);
-        sum_tracker += cpow(xi_conj, k) * cpow(zeta, m2 - k) * cpow(zeta_conj, m1 - k)
-            * cpow(-xi, m_l + k - m1 - m2) / fact_product;
+        const unsigned int m2 = m_l - m1;
+        // i^{m1 - m2} = (-1)^{m1} i^{-l}
+        const std::complex<double> phase = (m1 % 2 == 0 ? 1.0 : -1.0) * i_pow_minus_l;
+        double binomial_product = 1;
+        for (unsigned int k = 0; k <= std::min(m1, m2); ++k)
+        {
+            m_coefficients(m1, k)
+                = std::complex<float>(phase * binomial_product / static_cast<double>(m_l + 1));
+            // C(m1, k + 1) C(m2, k + 1) from C(m1, k) C(m2, k)
+            binomial_product *= static_cast<double>(m1 - k) * static_cast<double>(m2 - k)
+                / (static_cast<double>(k + 1) * static_cast<double>(k + 1));
+        }
     }
-    return sum_tracker;
 }
 
 void RotationalAutocorrelation::compute(const quat<float>* ref_orientations, const quat<float>* orientations,
@@ -57,47 +97,13 @@ void RotationalAutocorrelation::compute(const quat<float>* ref_orientations, con
 {
     m_RA_array.prepare(N);
 
-    // Precompute the hyperspherical harmonics for the unit quaternion. The
-    // default quaternion constructor gives a unit quaternion. We will assume
-    // the same iteration order here as in the loop below to save ourselves
-    // from having to use a more expensive process (i.e. a map).
-    std::complex<float> xi = std::complex<float>(0, 0);
-    std::complex<float> zeta = std::complex<float>(0, 1);
-    std::vector<std::complex<float>> unit_harmonics;
-    std::vector<std::vector<float>> prefactors(m_l + 1, std::vector<float>(m_l + 1, float(0)));
-    for (unsigned int a = 0; a <= m_l; a++)
-    {
-        for (unsigned int b = 0; b <= m_l; b++)
-        {
-            unit_harmonics.push_back(std::conj(hypersphere_harmonic(xi, zeta, a, b)));
-            prefactors[a][b] = static_cast<float>(m_factorials[a] * m_factorials[m_l - a] * m_factorials[b]
-                                                  * m_factorials[m_l - b])
-                / (static_cast<float>(m_l + 1));
-        }
-    }
-
     // Parallel loop is over orientations (technically (ref_or, or) pairs).
     util::forLoopWrapper(0, N, [&](size_t begin, size_t end) {
+        CoordinatePowers powers(m_l);
         for (size_t i = begin; i < end; ++i)
         {
-            // Transform the orientation quaternions into Xi/Zeta coordinates;
-            quat<float> qq_1 = conj(ref_orientations[i]) * orientations[i];
-            std::complex<float> xi = std::complex<float>(qq_1.v.x, qq_1.v.y);
-            std::complex<float> zeta = std::complex<float>(qq_1.v.z, qq_1.s);
-
-            // Loop through the valid quantum numbers.
-            m_RA_array[i] = std::complex<float>(0, 0);
-            unsigned int uh_index = 0;
-            for (unsigned int a = 0; a <= m_l; a++)
-            {
-                for (unsigned int b = 0; b <= m_l; b++)
-                {
-                    std::complex<float> combined_value
-                        = unit_harmonics[uh_index] * hypersphere_harmonic(xi, zeta, a, b);
-                    m_RA_array[i] += prefactors[a][b] * combined_value;
-                    uh_index += 1;
-                }
-            }
+            m_RA_array[i]
+                = particleAutocorrelation(m_coefficients, m_l, ref_orientations[i], orientations[i], powers);
         }
     });
 
@@ -109,4 +115,62 @@ void RotationalAutocorrelation::compute(const quat<float>* ref_orientations, con
     m_Ft = RA_sum / static_cast<float>(N);
 };
 
+void RotationalAutocorrelation::resetFrames(unsigned int points_per_level)
+{
+    m_frames = util::MultipleTau<quat<float>>(points_per_level);
+    m_lags.prepare(0);
+    m_lag_autocorrelation.prepare(0);
+}
+
+void RotationalAutocorrelation::accumulateFrames(const quat<float>* orientations, unsigned int n_frames,
+                                                 unsigned int N)
+{
+    if (m_frames.getNumFrames() == 0)
+    {
+        m_frames.reset(N);
+        m_lag_sums_local.resize(m_frames.getNumLags());
+    }
+    else if (N != m_frames.getNumValues())
+    {
+        throw std::invalid_argument("All frames must have the same number of orientations.");
+    }
+
+    using Pair = util::MultipleTau<quat<float>>::Pair;
+    const auto add_pairs = [&](const std::vector<Pair>& pairs, const quat<float>* latest) {
+        m_lag_sums_local.accumulate(0, N, [&](size_t begin, size_t end, auto& local_sums) {
+            CoordinatePowers powers(m_l);
+            std::vector<double> sums(pairs.size(), 0);
+            for (size_t i = begin; i < end; ++i)
+            {
+                for (size_t p = 0; p < pairs.size(); ++p)
+                {
+                    sums[p] += std::real(
+                        particleAutocorrelation(m_coefficients, m_l, pairs[p].earlier[i], latest[i], powers));
+                }
+            }
+            for (size_t p = 0; p < pairs.size(); ++p)
+            {
+                local_sums[pairs[p].lag_index] += sums[p];
+            }
+        });
+    };
+    for (unsigned int frame = 0; frame < n_frames; ++frame)
+    {
+        m_frames.addFrame(orientations + size_t(frame) * N, add_pairs);
+    }
+
+    // Average over the pairs of frames and the particles of each resolved lag.
+    util::ManagedArray<double> lag_sums(m_frames.getNumLags());
+    m_lag_sums_local.reduceInto(lag_sums);
+    const unsigned int n_lags = m_frames.getNumResolvedLags();
+    m_lags.prepare(n_lags);
+    m_lag_autocorrelation.prepare(n_lags);
+    for (unsigned int lag_index = 0; lag_index < n_lags; ++lag_index)
+    {
+        m_lags[lag_index] = static_cast<unsigned int>(m_frames.getLag(lag_index));
+        m_lag_autocorrelation[lag_index] = static_cast<float>(
+            lag_sums[lag_index] / (static_cast<double>(m_frames.getCounts()[lag_index]) * N));
+    }
+}
+
 }; }; // end namespace freud::order
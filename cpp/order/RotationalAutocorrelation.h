@@ -7,6 +7,8 @@
 #include <complex>
 
 #include "ManagedArray.h"
+#include "MultipleTau.h"
+#include "ThreadStorage.h"
 #include "VectorMath.h"
 
 /*! \file RotationalAutocorrelation.h
@@ -50,17 +52,7 @@ public:
     //! Constructor
     /*! \param l The order of the spherical harmonic.
      */
-    explicit RotationalAutocorrelation(unsigned int l) : m_l(l)
-    {
-        // For efficiency, we precompute all required factorials for use during
-        // the per-particle computation.
-        m_factorials.prepare(m_l + 1);
-        m_factorials[0] = 1;
-        for (unsigned int i = 1; i <= m_l; i++)
-        {
-            m_factorials[i] = i * m_factorials[i - 1];
-        }
-    }
+    explicit RotationalAutocorrelation(unsigned int l);
 
     //! Destructor
     ~RotationalAutocorrelation() = default;
@@ -95,33 +87,63 @@ public:
      *  these two hyperspherical harmonics. The value of the autocorrelation
      *  for the whole system is then the average of the real parts of the
      *  autocorrelation for the whole system.
-     */
-    void compute(const quat<float>* ref_orientations, const quat<float>* orientations, unsigned int N);
-
-private:
-    //! Compute a hyperspherical harmonic.
-    /*! \param xi The first complex number coordinate.
-     *  \param zeta The second complex number coordinate.
-     *  \param l The azimuthal quantum number.
-     *  \param m1 The first magnetic quantum number.
-     *  \param m2 The second magnetic quantum number.
-     *  \return The value of the hyperspherical harmonic (l, m1, m2) at (xi, zeta).
      *
      *  The hyperspherical harmonic function is a generalization of spherical
      *  harmonics from the 2-sphere to the 3-sphere. For details, see Harmonic
      *  functions and matrix elements for hyperspherical quantum field models
-     *  (https://doi.org/10.1063/1.526210). The function needs to be a class
-     *  method to access the cached factorial values for the class's value of
-     *  m_l.
+     *  (https://doi.org/10.1063/1.526210). Since the orientations are
+     *  expressed relative to the reference orientations, only the harmonics
+     *  with m1 + m2 = l are nonzero for the reference, so the inner product
+     *  is a sum over (l + 1) harmonics computed from tabulated coefficients
+     *  and powers of xi and zeta.
      */
-    std::complex<float> hypersphere_harmonic(const std::complex<float> xi, std::complex<float> zeta,
-                                             const unsigned int m1, const unsigned int m2);
+    void compute(const quat<float>* ref_orientations, const quat<float>* orientations, unsigned int N);
 
+    //! Remove the frames accumulated by accumulateFrames.
+    /*! \param points_per_level Number of frames kept in each level of the
+     *         multiple-tau correlator, which sets the number of lags per
+     *         factor of two of the lag time.
+     */
+    void resetFrames(unsigned int points_per_level);
+
+    //! Accumulate the rotational autocorrelation of the frames of a trajectory at all lags.
+    /*! \param orientations Quaternions of n_frames consecutive frames of N
+     *         orientations each, continuing the frames accumulated since the
+     *         last call to resetFrames.
+     *  \param n_frames The number of frames.
+     *  \param N The number of orientations of each frame.
+     *
+     *  Each frame is correlated with previous frames at logarithmically
+     *  spaced lags using util::MultipleTau, so a trajectory can be
+     *  accumulated in chunks with memory bounded by the number of frames kept
+     *  per level. The autocorrelation at each lag is the average of the real
+     *  parts of the autocorrelations of all pairs of frames at that lag.
+     */
+    void accumulateFrames(const quat<float>* orientations, unsigned int n_frames, unsigned int N);
+
+    //! Get the lags in frames resolved by accumulateFrames.
+    const util::ManagedArray<unsigned int>& getLags() const
+    {
+        return m_lags;
+    }
+
+    //! Get the rotational autocorrelation at each lag resolved by accumulateFrames.
+    const util::ManagedArray<float>& getLagAutocorrelation() const
+    {
+        return m_lag_autocorrelation;
+    }
+
+private:
     unsigned int m_l; //!< Order of the hyperspherical harmonic.
     float m_Ft {0};   //!< Real value of calculated RA function.
 
-    util::ManagedArray<std::complex<float>> m_RA_array; //!< Array of RA values per particle
-    util::ManagedArray<unsigned int> m_factorials;      //!< Array of cached factorials
+    util::ManagedArray<std::complex<float>> m_RA_array;     //!< Array of RA values per particle
+    util::ManagedArray<std::complex<float>> m_coefficients; //!< Coefficient of each (m1, k) term of the sum
+
+    util::MultipleTau<quat<float>> m_frames;         //!< Frames kept for correlations at all lags
+    util::ThreadStorage<double> m_lag_sums_local;    //!< Thread-specific sums of the autocorrelation per lag
+    util::ManagedArray<unsigned int> m_lags;         //!< Lags resolved by accumulateFrames
+    util::ManagedArray<float> m_lag_autocorrelation; //!< Autocorrelation at each resolved lag
 };
 
 }; }; // end namespace freud::order
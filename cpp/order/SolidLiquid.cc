@@ -1,10 +1,12 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "NeighborComputeFunctional.h"
 #include "SolidLiquid.h"
+#include "dset/dset.h"
 
 namespace freud { namespace order {
 
@@ -29,13 +31,14 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
 
     // Compute Steinhardt using neighbor list (also gets ql for normalization)
     m_steinhardt.compute(&m_nlist, points, qargs);
-    // SolidLiquid only has one l value so we index the 2D array from Steinhardt.
-    const auto& qlm = m_steinhardt.getQlm()[0];
+    // SolidLiquid only has one l value, so the harmonics of each particle are
+    // the 2l+1 columns of the array from Steinhardt.
+    const auto& qlm = m_steinhardt.getQlm();
     const auto& ql = m_steinhardt.getQl();
 
     // Compute (normalized) dot products for each bond in the neighbor list
     const auto normalizationfactor = float(4.0 * M_PI / m_num_ms);
-    const unsigned int num_bonds(m_nlist.getNumBonds());
+    const size_t num_bonds(m_nlist.getNumBonds());
     m_ql_ij.prepare(num_bonds);
 
     util::forLoopWrapper(
@@ -43,7 +46,7 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
         [&](size_t begin, size_t end) {
             for (unsigned int i = begin; i != end; ++i)
             {
-                unsigned int bond(m_nlist.find_first_index(i));
+                size_t bond(m_nlist.find_first_index(i));
                 for (; bond < num_bonds && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
                 {
                     const unsigned int j(m_nlist.getNeighbors()(bond, 1));
@@ -69,7 +72,7 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
 
     // Filter neighbors to contain only solid-like bonds
     std::vector<bool> solid_filter(num_bonds);
-    for (unsigned int bond(0); bond < num_bonds; bond++)
+    for (size_t bond(0); bond < num_bonds; bond++)
     {
         solid_filter[bond] = (m_ql_ij[bond] > m_q_threshold);
     }
@@ -85,9 +88,9 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
 
     // Filter nlist to only bonds between solid-like particles
     // (particles with more than solid_threshold solid-like bonds)
-    const unsigned int num_solid_bonds(solid_nlist.getNumBonds());
+    const size_t num_solid_bonds(solid_nlist.getNumBonds());
     std::vector<bool> neighbor_count_filter(num_solid_bonds);
-    for (unsigned int bond(0); bond < num_solid_bonds; bond++)
+    for (size_t bond(0); bond < num_solid_bonds; bond++)
     {
         const unsigned int i(solid_nlist.getNeighbors()(bond, 0));
         const unsigned int j(solid_nlist.getNeighbors()(bond, 1));
@@ -101,4 +104,105 @@ void SolidLiquid::compute(const freud::locality::NeighborList* nlist,
     m_cluster.compute(points, &solid_neighbor_nlist, qargs);
 }
 
+std::vector<unsigned int>
+SolidLiquid::computeLargestClusterSizes(const std::vector<float>& q_thresholds,
+                                        const std::vector<unsigned int>& solid_thresholds) const
+{
+    if (q_thresholds.size() != solid_thresholds.size())
+    {
+        throw std::invalid_argument("The number of q_thresholds and solid_thresholds must be equal.");
+    }
+    if (std::any_of(q_thresholds.cbegin(), q_thresholds.cend(), [](float q) { return q < 0.0; }))
+    {
+        throw std::invalid_argument(
+            "SolidLiquid requires that the dot product cutoff q_threshold must be non-negative.");
+    }
+
+    if (q_thresholds.empty())
+    {
+        return {};
+    }
+
+    const unsigned int num_query_points(m_nlist.getNumQueryPoints());
+    const size_t num_bonds(m_nlist.getNumBonds());
+
+    // Each distinct dot product threshold is counted once.
+    std::vector<float> unique_thresholds(q_thresholds);
+    std::sort(unique_thresholds.begin(), unique_thresholds.end());
+    unique_thresholds.erase(std::unique(unique_thresholds.begin(), unique_thresholds.end()),
+                            unique_thresholds.end());
+    const size_t num_thresholds(unique_thresholds.size());
+
+    // A bond is solid-like for the thresholds below its dot product, i.e.
+    // for the first bin_index sorted thresholds.
+    const auto bin_index = [&](size_t bond) {
+        return static_cast<size_t>(std::lower_bound(unique_thresholds.cbegin(), unique_thresholds.cend(),
+                                                    m_ql_ij[bond])
+                                   - unique_thresholds.cbegin());
+    };
+
+    // Count the solid-like bonds of each point for all thresholds in a single
+    // pass over the bonds of the point.
+    util::ManagedArray<unsigned int> connections({num_query_points, num_thresholds});
+    util::forLoopWrapper(
+        0, num_query_points,
+        [&](size_t begin, size_t end) {
+            for (size_t i = begin; i != end; ++i)
+            {
+                unsigned int* point_connections = &connections[connections.getIndex({i, 0})];
+                size_t bond(m_nlist.find_first_index(i));
+                for (; bond < num_bonds && m_nlist.getNeighbors()(bond, 0) == i; ++bond)
+                {
+                    const size_t index(bin_index(bond));
+                    if (index > 0)
+                    {
+                        ++point_connections[index - 1];
+                    }
+                }
+                // Bonds solid-like for a threshold are solid-like for all smaller thresholds.
+                for (size_t k = num_thresholds - 1; k > 0; --k)
+                {
+                    point_connections[k - 1] += point_connections[k];
+                }
+            }
+        },
+        true);
+
+    std::vector<unsigned int> largest_cluster_sizes(q_thresholds.size());
+    std::vector<unsigned int> cluster_sizes(num_query_points);
+    for (size_t pair = 0; pair < q_thresholds.size(); ++pair)
+    {
+        const size_t k = std::lower_bound(unique_thresholds.cbegin(), unique_thresholds.cend(),
+                                          q_thresholds[pair])
+            - unique_thresholds.cbegin();
+        const unsigned int solid_threshold(solid_thresholds[pair]);
+        const auto is_solid = [&](unsigned int point) {
+            return connections(point, k) >= solid_threshold;
+        };
+
+        // Merge the solid-like bonds between solid-like particles.
+        DisjointSets dj(num_query_points);
+        for (size_t bond = 0; bond < num_bonds; ++bond)
+        {
+            const unsigned int i(m_nlist.getNeighbors()(bond, 0));
+            const unsigned int j(m_nlist.getNeighbors()(bond, 1));
+            if (m_ql_ij[bond] > q_thresholds[pair] && is_solid(i) && is_solid(j) && !dj.same(i, j))
+            {
+                dj.unite(i, j);
+            }
+        }
+
+        // As in the clusters from compute, particles that are not bonded
+        // form clusters of a single particle.
+        std::fill(cluster_sizes.begin(), cluster_sizes.end(), 0);
+        unsigned int largest_cluster_size(0);
+        for (unsigned int i = 0; i < num_query_points; ++i)
+        {
+            largest_cluster_size = std::max(largest_cluster_size, ++cluster_sizes[dj.find(i)]);
+        }
+        largest_cluster_sizes[pair] = largest_cluster_size;
+    }
+    return largest_cluster_sizes;
+}
+
 }; }; // end namespace freud::order
@@ -88,6 +88,21 @@ public:
     void compute(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
                  freud::locality::QueryArgs qargs);
 
+    //! Compute the largest cluster sizes for several pairs of thresholds
+    /*! The bond parameters and neighbors of the last call to compute are
+     *  reused, so the harmonics are not recomputed. The solid-like bonds of
+     *  every pair of thresholds are counted in a single pass over the bonds,
+     *  then the solid-like particles of each pair are clustered.
+     *
+     *  \param q_thresholds The dot product thresholds of each pair.
+     *  \param solid_thresholds The solid-like bond count thresholds of each pair.
+     *
+     *  \returns The largest cluster size for each pair of thresholds.
+     */
+    std::vector<unsigned int>
+    computeLargestClusterSizes(const std::vector<float>& q_thresholds,
+                               const std::vector<unsigned int>& solid_thresholds) const;
+
     //! Returns largest cluster size.
     unsigned int getLargestClusterSize() const
     {
@@ -132,7 +147,7 @@ public:
     //! Get the last calculated qlm for each particle
     const util::ManagedArray<std::complex<float>>& getQlm() const
     {
-        return m_steinhardt.getQlm()[0];
+        return m_steinhardt.getQlm();
     }
 
     //! Return the ql_ij values.
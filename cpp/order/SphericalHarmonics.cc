@@ -0,0 +1,164 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <cmath>
+
+#include "SphericalHarmonics.h"
+#include "utils.h"
+
+/*! \file SphericalHarmonics.cc
+ *  \brief Evaluates spherical harmonics of blocks of bonds with Cartesian recurrences.
+ */
+
+namespace freud { namespace order {
+
+SphericalHarmonicBlock::SphericalHarmonicBlock(unsigned int l_max)
+    : m_l_max(l_max), m_a(triangularIndex(l_max, l_max) + 1), m_b(triangularIndex(l_max, l_max) + 1),
+      m_diag(l_max + 1), m_poly(triangularIndex(l_max, l_max) + 1), m_phase_re(l_max + 1),
+      m_phase_im(l_max + 1)
+{
+    // The coefficients are computed in double precision. The recurrences
+    // follow from those of the associated Legendre polynomials, normalized by
+    // sqrt((2l+1)/(4 pi) (l-m)!/(l+m)!) and divided by sin(theta)^m. The
+    // signs of A_m^m are the Condon-Shortley phase.
+    double a_mm = 1.0 / std::sqrt(4.0 * M_PI);
+    m_diag[0] = static_cast<float>(a_mm);
+    for (unsigned int m = 1; m <= l_max; ++m)
+    {
+        a_mm *= -std::sqrt((2.0 * m + 1.0) / (2.0 * m));
+        m_diag[m] = static_cast<float>(a_mm);
+    }
+    for (unsigned int m = 0; m <= l_max; ++m)
+    {
+        for (unsigned int l = m + 1; l <= l_max; ++l)
+        {
+            const double l_sq = double(l) * double(l);
+            const double m_sq = double(m) * double(m);
+            const double l_prev_sq = double(l - 1) * double(l - 1);
+            m_a[triangularIndex(l, m)] = static_cast<float>(std::sqrt((4.0 * l_sq - 1.0) / (l_sq - m_sq)));
+            m_b[triangularIndex(l, m)]
+                = static_cast<float>(std::sqrt((l_prev_sq - m_sq) / (4.0 * l_prev_sq - 1.0)));
+        }
+    }
+}
+
+void SphericalHarmonicBlock::push_back(const vec3<float>& delta, float distance, float weight)
+{
+    // The polar angle is measured with the bond length. If the points are
+    // directly on top of each other, the bond is taken to point along z.
+    const float cos_theta = (distance == float(0)) ? float(1) : util::clamp(delta.z / distance, -1, 1);
+    const float sin_theta = std::sqrt(std::max(float(0), float(1) - cos_theta * cos_theta));
+
+    // The azimuthal angle is zero for bonds along z.
+    const float rho = std::sqrt(delta.x * delta.x + delta.y * delta.y);
+    const float cos_phi = (rho == float(0)) ? float(1) : delta.x / rho;
+    const float sin_phi = (rho == float(0)) ? float(0) : delta.y / rho;
+
+    m_x.values[m_size] = sin_theta * cos_phi;
+    m_y.values[m_size] = sin_theta * sin_phi;
+    m_z.values[m_size] = cos_theta;
+    m_weight.values[m_size] = weight;
+    ++m_size;
+}
+
+void SphericalHarmonicBlock::evaluate()
+{
+    // Pad the block to a multiple of the lane width with bonds of zero
+    // weight, so that all loops below run over whole lanes.
+    const unsigned int n = paddedSize();
+    std::fill(m_x.values + m_size, m_x.values + n, float(0));
+    std::fill(m_y.values + m_size, m_y.values + n, float(0));
+    std::fill(m_z.values + m_size, m_z.values + n, float(1));
+    std::fill(m_weight.values + m_size, m_weight.values + n, float(0));
+
+    const float* x = m_x.values;
+    const float* y = m_y.values;
+    const float* z = m_z.values;
+
+    // Weighted powers of x + iy, so that sums over bonds need no extra product.
+    std::copy(m_weight.values, m_weight.values + n, m_phase_re[0].values);
+    std::fill(m_phase_im[0].values, m_phase_im[0].values + n, float(0));
+    for (unsigned int m = 1; m <= m_l_max; ++m)
+    {
+        const float* prev_re = m_phase_re[m - 1].values;
+        const float* prev_im = m_phase_im[m - 1].values;
+        float* re = m_phase_re[m].values;
+        float* im = m_phase_im[m].values;
+        for (unsigned int b = 0; b < n; ++b)
+        {
+            re[b] = prev_re[b] * x[b] - prev_im[b] * y[b];
+            im[b] = prev_re[b] * y[b] + prev_im[b] * x[b];
+        }
+    }
+
+    for (unsigned int m = 0; m <= m_l_max; ++m)
+    {
+        // A_m^m is constant, and A_{m+1}^m has no A_{m-1}^m term.
+        float* diag = m_poly[triangularIndex(m, m)].values;
+        std::fill(diag, diag + n, m_diag[m]);
+        if (m == m_l_max)
+        {
+            break;
+        }
+        float* next = m_poly[triangularIndex(m + 1, m)].values;
+        const float a = m_a[triangularIndex(m + 1, m)] * m_diag[m];
+        for (unsigned int b = 0; b < n; ++b)
+        {
+            next[b] = a * z[b];
+        }
+
+        for (unsigned int l = m + 2; l <= m_l_max; ++l)
+        {
+            const float* prev = m_poly[triangularIndex(l - 1, m)].values;
+            const float* prev2 = m_poly[triangularIndex(l - 2, m)].values;
+            float* current = m_poly[triangularIndex(l, m)].values;
+            const float a_lm = m_a[triangularIndex(l, m)];
+            const float b_lm = m_b[triangularIndex(l, m)];
+            for (unsigned int b = 0; b < n; ++b)
+            {
+                current[b] = a_lm * (z[b] * prev[b] - b_lm * prev2[b]);
+            }
+        }
+    }
+}
+
+void SphericalHarmonicBlock::accumulate(unsigned int l, std::complex<float>* qlm) const
+{
+    const unsigned int n = paddedSize();
+    for (unsigned int m = 0; m <= l; ++m)
+    {
+        const float* poly = m_poly[triangularIndex(l, m)].values;
+        const float* re = m_phase_re[m].values;
+        const float* im = m_phase_im[m].values;
+
+        // Independent partial sums per lane allow the sum to be vectorized
+        // without reassociating floating point additions.
+        float lane_re[LANE_WIDTH] = {};
+        float lane_im[LANE_WIDTH] = {};
+        for (unsigned int b = 0; b < n; b += LANE_WIDTH)
+        {
+            for (unsigned int k = 0; k < LANE_WIDTH; ++k)
+            {
+                lane_re[k] += poly[b + k] * re[b + k];
+                lane_im[k] += poly[b + k] * im[b + k];
+            }
+        }
+        float sum_re(0);
+        float sum_im(0);
+        for (unsigned int k = 0; k < LANE_WIDTH; ++k)
+        {
+            sum_re += lane_re[k];
+            sum_im += lane_im[k];
+        }
+
+        qlm[m] += std::complex<float>(sum_re, sum_im);
+        if (m > 0)
+        {
+            const float sign = (m % 2 == 1) ? float(-1) : float(1);
+            qlm[l + m] += std::complex<float>(sign * sum_re, -sign * sum_im);
+        }
+    }
+}
+
+}; }; // end namespace freud::order
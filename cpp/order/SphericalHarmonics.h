@@ -0,0 +1,135 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef SPHERICAL_HARMONICS_H
+#define SPHERICAL_HARMONICS_H
+
+#include <complex>
+#include <vector>
+
+#include "VectorMath.h"
+
+/*! \file SphericalHarmonics.h
+ *  \brief Evaluates spherical harmonics of blocks of bonds with Cartesian recurrences.
+ */
+
+namespace freud { namespace order {
+
+//! Evaluates weighted sums of the spherical harmonics of a block of bond directions.
+/*! For m >= 0, the spherical harmonics (including the Condon-Shortley phase)
+ *  factor into \f$ Y_l^m = A_l^m(\cos\theta) (\sin\theta e^{i\phi})^m \f$,
+ *  where \f$ A_l^m \f$ is a normalized polynomial. Given the Cartesian
+ *  components of a unit bond vector, \f$ \cos\theta = z \f$ and
+ *  \f$ \sin\theta e^{i\phi} = x + iy \f$, both factors follow from
+ *  recurrences in l and m with precomputed coefficients, so no trigonometric
+ *  functions are evaluated. Harmonics with negative m follow from
+ *  \f$ Y_l^{-m} = (-1)^m \overline{Y_l^m} \f$.
+ *
+ *  Bonds are collected into blocks of up to BLOCK_SIZE bonds stored as
+ *  structure of arrays, and each step of the recurrences is a loop over the
+ *  bonds of a block that compilers can vectorize.
+ */
+class SphericalHarmonicBlock
+{
+public:
+    //! Maximum number of bonds in a block.
+    static constexpr unsigned int BLOCK_SIZE = 64;
+
+    //! Constructor
+    /*! \param l_max The largest spherical harmonic number l to evaluate.
+     */
+    explicit SphericalHarmonicBlock(unsigned int l_max);
+
+    //! Remove all bonds from the block.
+    void clear()
+    {
+        m_size = 0;
+    }
+
+    //! Whether the block holds no bonds.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    //! Whether no more bonds can be added to the block.
+    bool full() const
+    {
+        return m_size == BLOCK_SIZE;
+    }
+
+    //! Add a bond to the block.
+    /*! \param delta The bond vector.
+     *  \param distance The bond length, which determines the polar angle.
+     *  \param weight The weight of the bond in the sums of harmonics.
+     */
+    void push_back(const vec3<float>& delta, float distance, float weight);
+
+    //! Evaluate the factors of the harmonics of all bonds in the block for all l up to l_max.
+    void evaluate();
+
+    //! Add the weighted sums over the bonds of the block of the harmonics of one l.
+    /*! Must be called after evaluate.
+     *
+     *  \param l The spherical harmonic number, at most l_max.
+     *  \param qlm Array of 2l+1 sums to add to, indexed by m like [0, 1, ..., l, -1, -2, ..., -l].
+     */
+    void accumulate(unsigned int l, std::complex<float>* qlm) const;
+
+    //! Get the weighted harmonic of one l and m >= 0 of one bond in the block.
+    /*! Must be called after evaluate.
+     *
+     *  \param bond The index of the bond in the block.
+     *  \param l The spherical harmonic number, at most l_max.
+     *  \param m The nonnegative spherical harmonic number m, at most l.
+     */
+    std::complex<float> getHarmonic(unsigned int bond, unsigned int l, unsigned int m) const
+    {
+        const float poly = m_poly[triangularIndex(l, m)].values[bond];
+        return {poly * m_phase_re[m].values[bond], poly * m_phase_im[m].values[bond]};
+    }
+
+    //! Get the number of bonds in the block.
+    unsigned int size() const
+    {
+        return m_size;
+    }
+
+private:
+    //! Number of bonds that loops over a block process together.
+    static constexpr unsigned int LANE_WIDTH = 8;
+
+    //! Values of a quantity for each bond of a block.
+    struct alignas(64) Lanes
+    {
+        float values[BLOCK_SIZE];
+    };
+
+    //! Index of (l, m) with 0 <= m <= l in the triangular coefficient and polynomial arrays.
+    static unsigned int triangularIndex(unsigned int l, unsigned int m)
+    {
+        return l * (l + 1) / 2 + m;
+    }
+
+    //! Number of bonds in the block rounded up to a multiple of LANE_WIDTH.
+    unsigned int paddedSize() const
+    {
+        return (m_size + LANE_WIDTH - 1) / LANE_WIDTH * LANE_WIDTH;
+    }
+
+    unsigned int m_l_max;          //!< Largest spherical harmonic number l
+    unsigned int m_size {0};       //!< Number of bonds in the block
+    Lanes m_x {};                  //!< x components of the unit bond vectors
+    Lanes m_y {};                  //!< y components of the unit bond vectors
+    Lanes m_z {};                  //!< z components of the unit bond vectors
+    Lanes m_weight {};             //!< Weights of the bonds
+    std::vector<float> m_a;        //!< Coefficient of z A_{l-1}^m in the recurrence for A_l^m
+    std::vector<float> m_b;        //!< Coefficient of A_{l-2}^m in the recurrence for A_l^m
+    std::vector<float> m_diag;     //!< A_m^m, which is constant
+    std::vector<Lanes> m_poly;     //!< A_l^m of each bond
+    std::vector<Lanes> m_phase_re; //!< Real part of the weighted (x + iy)^m of each bond
+    std::vector<Lanes> m_phase_im; //!< Imaginary part of the weighted (x + iy)^m of each bond
+};
+
+}; };  // end namespace freud::order
+#endif // SPHERICAL_HARMONICS_H
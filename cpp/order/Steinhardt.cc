@@ -2,8 +2,13 @@
 // This file is from the freud project, released under the BSD 3-Clause License.
 
 #include "Steinhardt.h"
+#include "Instrumentation.h"
 #include "NeighborComputeFunctional.h"
+#include "SystemBatch.h"
 #include "utils.h"
+#include <limits>
+#include <stdexcept>
+#include <tbb/enumerable_thread_specific.h>
 #include <vector>
 
 /*! \file Steinhardt.cc
@@ -12,27 +17,32 @@
 
 namespace freud { namespace order {
 
-// Calculating Ylm using fsph module
-void Steinhardt::computeYlm(fsph::PointSPHEvaluator<float>& sph_eval, const float theta, const float phi,
-                            YlmsType& Ylms) const
+namespace {
+//! Sum the qlm of all particles, each divided by the number of particles, into the local arrays of qlm_local.
+template<typename Accumulator>
+void sumParticleQlm(const util::ManagedArray<std::complex<float>>& particle_qlm, size_t n_particles,
+                    size_t total_ms, util::ThreadStorage<std::complex<Accumulator>>& qlm_local)
 {
-    sph_eval.compute(theta, phi);
-
-    for (size_t i = 0; i < m_ls.size(); ++i)
-    {
-        auto& Ylm = Ylms[i];
-        const auto l = m_ls[i];
-        size_t m_index(0);
-
-        const auto end_iter(sph_eval.begin_l(l + 1, 0, true));
-        for (auto iter(sph_eval.begin_l(l, 0, true)); iter != end_iter; ++iter, ++m_index)
+    qlm_local.reset();
+    qlm_local.accumulate(0, n_particles, [&](size_t begin, size_t end, auto& local) {
+        for (size_t i = begin; i < end; ++i)
         {
-            // Manually add the Condon-Shortley phase, (-1)^m, to positive odd m
-            const float phase = (m_index <= l && m_index % 2 == 1) ? -1 : 1;
-            Ylm[m_index] = phase * (*iter);
+            const std::complex<float>* qlm_i = particle_qlm.get() + i * total_ms;
+            for (size_t k = 0; k < total_ms; ++k)
+            {
+                local[k] += std::complex<Accumulator>(qlm_i[k]) / static_cast<Accumulator>(n_particles);
+            }
         }
-    }
+    });
+}
+
+//! Copy the rows of source to the rows of target starting at first_row.
+template<typename T>
+void copyRows(const util::ManagedArray<T>& source, util::ManagedArray<T>& target, size_t first_row)
+{
+    std::copy(source.get(), source.get() + source.size(), target.get() + first_row * target.shape()[1]);
 }
+} // namespace
 
 void Steinhardt::reallocateArrays(unsigned int Np)
 {
@@ -45,169 +55,257 @@ void Steinhardt::reallocateArrays(unsigned int Np)
     {
         m_qliAve.prepare({Np, num_ls});
     }
-    if (m_wl)
-    {
-        m_wli.prepare({Np, num_ls});
-    }
+    // The wl of the particles are computed by updateParticleWl when requested.
+    m_wli_updated = !m_wl;
 
-    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+    m_qlmi.prepare({Np, m_total_ms});
+    m_qlm.prepare(m_total_ms);
+    if (m_average)
     {
-        const auto num_ms = m_num_ms[l_index];
-        m_qlmi[l_index].prepare({Np, num_ms});
-        m_qlm[l_index].prepare(num_ms);
-        if (m_average)
-        {
-            m_qlmiAve[l_index].prepare({Np, num_ms});
-        }
+        m_qlmiAve.prepare({Np, m_total_ms});
     }
 }
 
 void Steinhardt::compute(const freud::locality::NeighborList* nlist,
                          const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
 {
+    const util::ScopedPhase phase("Steinhardt::compute");
+    const util::ScopedMemoryOwner owner("Steinhardt");
+
     // Allocate and zero out arrays as necessary.
     reallocateArrays(points->getNPoints());
 
+    // The neighbor average traverses the neighbors of every point a second
+    // time, so the neighbors found by a query are stored once for both passes.
+    locality::NeighborList query_nlist;
+    if (m_average && nlist == nullptr)
+    {
+        query_nlist
+            = locality::makeDefaultNlist(points, nlist, points->getPoints(), points->getNPoints(), qargs);
+        nlist = &query_nlist;
+    }
+
     // Computes the base qlmi required for each specialized order parameter
-    baseCompute(nlist, points, qargs);
+    {
+        const util::ScopedPhase harmonics_phase("harmonics");
+        baseCompute(nlist, points, qargs);
+    }
 
+    finishCompute(nlist, points, qargs);
+}
+
+void Steinhardt::finishCompute(const freud::locality::NeighborList* nlist,
+                               const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
+{
     if (m_average)
     {
+        const util::ScopedPhase average_phase("average");
         computeAve(nlist, points, qargs);
     }
 
-    // Reduce qlm
-    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
     {
-        m_qlm_local[l_index].reduceInto(m_qlm[l_index]);
+        const util::ScopedPhase reduce_phase("reduce");
+        reduceSystemQlm();
     }
 
-    if (m_wl)
+    m_norm = normalizeSystem();
+}
+
+void Steinhardt::updateParticleWl() const
+{
+    if (m_wli_updated)
     {
-        if (m_average)
+        return;
+    }
+    const util::ScopedPhase wl_phase("wl");
+    const util::ScopedMemoryOwner owner("Steinhardt");
+    m_wli.prepare({m_Np, m_ls.size()});
+    if (m_average)
+    {
+        aggregatewl(m_wli, m_qlmiAve, m_qliAve);
+    }
+    else
+    {
+        aggregatewl(m_wli, m_qlmi, m_qli);
+    }
+    m_wli_updated = true;
+}
+
+void Steinhardt::reduceSystemQlm()
+{
+    // The system qlm is the mean of the (averaged) qlm of all particles,
+    // which is summed after the neighbor loops so that the sum can be
+    // deterministic.
+    const util::ManagedArray<std::complex<float>>& particle_qlm = m_average ? m_qlmiAve : m_qlmi;
+    if (util::accumulateInDouble(false))
+    {
+        sumParticleQlm(particle_qlm, m_Np, m_total_ms, m_qlm_local_double);
+        util::ManagedArray<std::complex<double>> qlm(m_total_ms);
+        m_qlm_local_double.reduceInto(qlm);
+        for (size_t k = 0; k < m_total_ms; ++k)
         {
-            aggregatewl(m_wli, m_qlmiAve, m_qliAve);
+            m_qlm[k] = std::complex<float>(qlm[k]);
         }
-        else
+    }
+    else
+    {
+        sumParticleQlm(particle_qlm, m_Np, m_total_ms, m_qlm_local);
+        m_qlm_local.reduceInto(m_qlm);
+    }
+}
+
+void Steinhardt::computeSystems(const freud::locality::SystemBatch& batch, freud::locality::QueryArgs qargs)
+{
+    const util::ScopedPhase phase("Steinhardt::computeSystems");
+    const util::ScopedMemoryOwner owner("Steinhardt");
+
+    reallocateArrays(batch.getNPoints());
+    m_system_order.prepare({batch.getNumSystems(), m_ls.size()});
+    const std::vector<unsigned int>& offsets = batch.getOffsets();
+    for (unsigned int system = 0; system < batch.getNumSystems(); ++system)
+    {
+        if (offsets[system] == offsets[system + 1])
         {
-            aggregatewl(m_wli, m_qlmi, m_qli);
+            std::fill_n(&m_system_order(system, 0), m_ls.size(), std::numeric_limits<float>::quiet_NaN());
         }
     }
+
+    // Every system is computed by its own Steinhardt object, since the
+    // computes of the systems run concurrently, and its arrays are copied to
+    // the rows of the points of the system. The wl of the particles are
+    // computed from the copied harmonics when requested.
+    batch.forEachSystem([&](unsigned int system, const freud::locality::NeighborQuery* neighbor_query) {
+        Steinhardt steinhardt(m_ls, m_average, m_wl, m_weighted, m_wl_normalize);
+        steinhardt.compute(nullptr, neighbor_query, qargs);
+        const size_t first = offsets[system];
+        copyRows(steinhardt.m_qli, m_qli, first);
+        copyRows(steinhardt.m_qlmi, m_qlmi, first);
+        if (m_average)
+        {
+            copyRows(steinhardt.m_qliAve, m_qliAve, first);
+            copyRows(steinhardt.m_qlmiAve, m_qlmiAve, first);
+        }
+        const std::vector<float> order = steinhardt.getOrder();
+        std::copy(order.cbegin(), order.cend(), &m_system_order(system, 0));
+    });
+
+    // The order of the batch is that of the points of all systems.
+    if (m_Np != 0)
+    {
+        reduceSystemQlm();
+    }
     m_norm = normalizeSystem();
 }
 
-void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
-                             const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
+void Steinhardt::beginBonds(const freud::locality::NeighborQuery* neighbor_query,
+                            const vec3<float>* query_points, unsigned int n_query_points,
+                            const freud::locality::NeighborList& /*nlist*/)
 {
-    std::vector<float> normalizationfactor(m_ls.size());
-    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+    if (query_points != neighbor_query->getPoints() || n_query_points != neighbor_query->getNPoints())
     {
-        normalizationfactor[l_index] = float(4.0 * M_PI / m_num_ms[l_index]);
+        throw std::invalid_argument("Steinhardt requires the query points to be the points.");
     }
-    // For consistency, this reset is done here regardless of whether the array
-    // is populated in baseCompute or computeAve.
-    for (auto& qlm_local : m_qlm_local)
+    reallocateArrays(n_query_points);
+    m_stage_points = neighbor_query;
+    const auto max_l = *std::max_element(m_ls.begin(), m_ls.end());
+    m_stage_harmonic_blocks = std::make_unique<tbb::enumerable_thread_specific<SphericalHarmonicBlock>>(
+        SphericalHarmonicBlock(max_l));
+}
+
+void Steinhardt::consumeBonds(const freud::locality::NeighborList& nlist, size_t begin, size_t end,
+                              size_t first_bond, size_t end_bond)
+{
+    SphericalHarmonicBlock& block = m_stage_harmonic_blocks->local();
+    const unsigned int* neighbors = nlist.getNeighbors().get();
+    size_t bond = first_bond;
+    for (size_t i = begin; i < end; ++i)
     {
-        qlm_local.reset();
+        freud::locality::NeighborListPerPointIterator ppiter(&nlist, i, bond);
+        computePointQlm(i, ppiter, m_stage_points, block);
+        for (; bond < end_bond && neighbors[2 * bond] == i; ++bond) {}
     }
+}
+
+void Steinhardt::endBonds(const freud::locality::NeighborList& nlist)
+{
+    m_stage_harmonic_blocks.reset();
+    finishCompute(&nlist, m_stage_points, freud::locality::QueryArgs());
+}
+
+void Steinhardt::baseCompute(const freud::locality::NeighborList* nlist,
+                             const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
+{
+    // Spherical harmonics are evaluated for blocks of bonds at once.
+    const auto max_l = *std::max_element(m_ls.begin(), m_ls.end());
+    tbb::enumerable_thread_specific<SphericalHarmonicBlock> harmonic_blocks((SphericalHarmonicBlock(max_l)));
 
     freud::locality::loopOverNeighborsIterator(
         points, points->getPoints(), m_Np, qargs, nlist,
         [&](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
-            float total_weight(0);
-            const vec3<float> ref((*points)[i]);
-            // Construct PointSPHEvaluator outside loop since the construction is costly.
-            auto max_l = *std::max_element(m_ls.begin(), m_ls.end());
-            fsph::PointSPHEvaluator<float> sph_eval(max_l);
-
-            // Alocate and instantiate this array before looping over particles to prevent N instantiations
-            // and N * m_l.size() allocations.
-            YlmsType Ylms(m_ls.size());
-            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
-            {
-                Ylms[l_index].resize(m_num_ms[l_index]);
-            }
+            computePointQlm(i, *ppiter, points, harmonic_blocks.local());
+        });
+}
 
-            for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
-            {
-                const vec3<float> delta = points->getBox().wrap((*points)[nb.point_idx] - ref);
-                const float weight(m_weighted ? nb.weight : float(1.0));
-
-                // phi is usually in range 0..2Pi, but
-                // it only appears in Ylm as exp(im\phi),
-                // so range -Pi..Pi will give same results.
-                const float phi = std::atan2(delta.y, delta.x); // -Pi..Pi
-
-                // This value must be clamped in cases where the particles are
-                // aligned along z, otherwise due to floating point error we
-                // could get delta.z/nb.distance = -1-eps, which is outside the
-                // valid range of std::acos.
-                float theta = std::acos(util::clamp(delta.z / nb.distance, -1, 1)); // 0..Pi
-
-                // If the points are directly on top of each other,
-                // theta should be zero instead of nan.
-                if (nb.distance == float(0))
-                {
-                    theta = 0;
-                }
+void Steinhardt::computePointQlm(size_t i, freud::locality::NeighborPerPointIterator& ppiter,
+                                 const freud::locality::NeighborQuery* points, SphericalHarmonicBlock& block)
+{
+    float total_weight(0);
+    const vec3<float> ref((*points)[i]);
+    block.clear();
+
+    // Add the harmonics of the bonds in the block to qlmi. A single
+    // evaluation up to the largest l provides the harmonics of all l.
+    std::complex<float>* qlmi = &m_qlmi[m_qlmi.getIndex({i, 0})];
+    const auto flush_block = [&]() {
+        block.evaluate();
+        for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+        {
+            block.accumulate(m_ls[l_index], qlmi + m_m_offsets[l_index]);
+        }
+        block.clear();
+    };
 
-                computeYlm(sph_eval, theta, phi, Ylms); // Fill up Ylm
+    for (freud::locality::NeighborBond nb = ppiter.next(); !ppiter.end(); nb = ppiter.next())
+    {
+        const vec3<float> delta = points->getBox().wrap((*points)[nb.point_idx] - ref);
+        const float weight(m_weighted ? nb.weight : float(1.0));
 
-                for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
-                {
-                    auto& qlmi = m_qlmi[l_index];
-                    const auto& Ylm = Ylms[l_index];
-                    // Get the initial index and iterate using ++ for faster iteration
-                    // Profiling showed using operator() to slow the code significantly.
-                    const size_t index = qlmi.getIndex({i, 0});
-                    for (size_t k = 0; k < m_num_ms[l_index]; ++k)
-                    {
-                        qlmi[index + k] += weight * Ylm[k];
-                    }
-                }
-                // Accumulate weight for normalization
-                total_weight += weight;
-            } // End loop going over neighbor bonds
+        block.push_back(delta, nb.distance, weight);
+        if (block.full())
+        {
+            flush_block();
+        }
 
-            // Normalize!
-            const size_t qli_i_start = m_qli.getIndex({i, 0});
-            for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
-            {
-                // get l specific vectors/arrays
-                auto& qlmi = m_qlmi[l_index];
-                auto& qlm_local = m_qlm_local[l_index];
-                const size_t first_qlmi_index = qlmi.getIndex({i, 0});
-                const size_t qli_index = qli_i_start + l_index;
+        // Accumulate weight for normalization
+        total_weight += weight;
+    } // End loop going over neighbor bonds
+    if (!block.empty())
+    {
+        flush_block();
+    }
 
-                for (size_t k = 0; k < m_num_ms[l_index]; ++k)
-                {
-                    // Cache the index for efficiency.
-                    const size_t qlmi_index = first_qlmi_index + k;
-
-                    qlmi[qlmi_index] /= total_weight;
-                    // Add the norm, which is the (complex) squared magnitude
-                    m_qli[qli_index] += norm(qlmi[qlmi_index]);
-                    // This array gets populated by computeAve in the averaging case.
-                    if (!m_average)
-                    {
-                        qlm_local.local()[k] += qlmi[qlmi_index] / float(m_Np);
-                    }
-                }
-                m_qli[qli_index] *= normalizationfactor[l_index];
-                m_qli[qli_index] = std::sqrt(m_qli[qli_index]);
-            }
-        });
+    // Normalize!
+    const size_t qli_i_start = m_qli.getIndex({i, 0});
+    for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+    {
+        const size_t first_m = m_m_offsets[l_index];
+        const size_t qli_index = qli_i_start + l_index;
+        const auto normalizationfactor = float(4.0 * M_PI / m_num_ms[l_index]);
+
+        for (size_t k = first_m; k < first_m + m_num_ms[l_index]; ++k)
+        {
+            qlmi[k] /= total_weight;
+            // Add the norm, which is the (complex) squared magnitude
+            m_qli[qli_index] += norm(qlmi[k]);
+        }
+        m_qli[qli_index] *= normalizationfactor;
+        m_qli[qli_index] = std::sqrt(m_qli[qli_index]);
+    }
 }
 
 void Steinhardt::computeAve(const freud::locality::NeighborList* nlist,
                             const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs)
 {
-    std::shared_ptr<locality::NeighborQueryIterator> iter;
-    if (nlist == nullptr)
-    {
-        iter = points->query(points->getPoints(), points->getNPoints(), qargs);
-    }
-
     std::vector<float> normalizationfactor(m_ls.size());
     for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
     {
@@ -218,46 +316,34 @@ void Steinhardt::computeAve(const freud::locality::NeighborList* nlist,
         points, points->getPoints(), m_Np, qargs, nlist,
         [&](size_t i, const std::shared_ptr<freud::locality::NeighborPerPointIterator>& ppiter) {
             unsigned int neighborcount(1);
+            std::complex<float>* qlmiAve = &m_qlmiAve[m_qlmiAve.getIndex({i, 0})];
             for (freud::locality::NeighborBond nb = ppiter->next(); !ppiter->end(); nb = ppiter->next())
             {
-                for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
+                // Adding all the qlm of the neighbors, for all l at once.
+                const std::complex<float>* qlmj = &m_qlmi[m_qlmi.getIndex({nb.point_idx, 0})];
+                for (size_t k = 0; k < m_total_ms; ++k)
                 {
-                    auto& qlmiAve = m_qlmiAve[l_index];
-                    auto& qlmi = m_qlmi[l_index];
-                    const auto ave_index = qlmiAve.getIndex({i, 0});
-                    const auto nb_index = qlmi.getIndex({nb.point_idx, 0});
-                    for (size_t k = 0; k < m_num_ms[l_index]; ++k)
-                    {
-                        // Adding all the qlm of the neighbors. We use the
-                        // vector function signature for indexing into the
-                        // arrays for speed.
-                        qlmiAve[ave_index + k] += qlmi[nb_index + k];
-                    }
+                    qlmiAve[k] += qlmj[k];
                 }
                 neighborcount++;
             } // End loop over particle's bonds
 
             // Normalize!
 
+            const std::complex<float>* qlmi = &m_qlmi[m_qlmi.getIndex({i, 0})];
             const size_t qliAve_i_start = m_qliAve.getIndex({i, 0});
             for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
             {
-                auto& qlmiAve = m_qlmiAve[l_index];
-                auto& qlmi = m_qlmi[l_index];
-                auto& qlm_local = m_qlm_local[l_index];
-                const size_t first_qlmi_index = qlmiAve.getIndex({i, 0});
+                const size_t first_m = m_m_offsets[l_index];
                 const size_t qliAve_index = qliAve_i_start + l_index;
 
-                for (size_t k = 0; k < m_num_ms[l_index]; ++k)
+                for (size_t k = first_m; k < first_m + m_num_ms[l_index]; ++k)
                 {
-                    // Cache the index for efficiency.
-                    const size_t qlmi_index = first_qlmi_index + k;
                     // Add the qlm of the particle i itself
-                    qlmiAve[qlmi_index] += qlmi[qlmi_index];
-                    qlmiAve[qlmi_index] /= static_cast<float>(neighborcount);
-                    qlm_local.local()[k] += qlmiAve[qlmi_index] / float(m_Np);
+                    qlmiAve[k] += qlmi[k];
+                    qlmiAve[k] /= static_cast<float>(neighborcount);
                     // Add the norm, which is the complex squared magnitude
-                    m_qliAve[qliAve_index] += norm(qlmiAve[qlmi_index]);
+                    m_qliAve[qliAve_index] += norm(qlmiAve[k]);
                 }
                 m_qliAve[qliAve_index] *= normalizationfactor[l_index];
                 m_qliAve[qliAve_index] = std::sqrt(m_qliAve[qliAve_index]);
@@ -270,8 +356,7 @@ std::vector<float> Steinhardt::normalizeSystem()
     std::vector<float> system_norms(m_ls.size());
     for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
     {
-        auto& qlm = m_qlm[l_index];
-        auto l = m_ls[l_index];
+        const std::complex<float>* qlm = &m_qlm[m_m_offsets[l_index]];
         float calc_norm(0);
         const auto normalizationfactor = static_cast<float>(4.0 * M_PI / m_num_ms[l_index]);
         for (size_t k = 0; k < m_num_ms[l_index]; ++k)
@@ -283,8 +368,7 @@ std::vector<float> Steinhardt::normalizeSystem()
 
         if (m_wl)
         {
-            const auto wigner3j_values = getWigner3j(l);
-            float wl_system_norm = reduceWigner3j(qlm.get(), l, wigner3j_values);
+            float wl_system_norm = reduceWigner3j(qlm, m_wigner3j_terms[l_index]);
 
             // The normalization factor of wl is calculated using qli, which is
             // equivalent to calculate the normalization factor from qlmi
@@ -304,7 +388,7 @@ std::vector<float> Steinhardt::normalizeSystem()
 }
 
 void Steinhardt::aggregatewl(util::ManagedArray<float>& target,
-                             const std::vector<util::ManagedArray<std::complex<float>>>& source,
+                             const util::ManagedArray<std::complex<float>>& source,
                              const util::ManagedArray<float>& normalization_source) const
 {
     util::forLoopWrapper(0, m_Np, [&](size_t begin, size_t end) {
@@ -314,14 +398,10 @@ void Steinhardt::aggregatewl(util::ManagedArray<float>& target,
             const auto norm_particle_index = normalization_source.getIndex({i, 0});
             for (size_t l_index = 0; l_index < m_ls.size(); ++l_index)
             {
-                const auto l = m_ls[l_index];
-                const auto& source_l = source[l_index];
-
                 const auto normalizationfactor = static_cast<float>(4.0 * M_PI / m_num_ms[l_index]);
-                const auto wigner3j_values = getWigner3j(l);
 
                 target[target_particle_index + l_index]
-                    = reduceWigner3j(&(source_l({i, 0})), l, wigner3j_values);
+                    = reduceWigner3j(&source({i, m_m_offsets[l_index]}), m_wigner3j_terms[l_index]);
                 if (m_wl_normalize)
                 {
                     const float normalization = std::sqrt(normalizationfactor)
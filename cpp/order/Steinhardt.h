@@ -6,15 +6,21 @@
 
 #include <algorithm>
 #include <complex>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <tbb/enumerable_thread_specific.h>
 
+#include "BondPipeline.h"
 #include "Box.h"
 #include "ManagedArray.h"
 #include "NeighborList.h"
 #include "NeighborQuery.h"
+#include "SphericalHarmonics.h"
+#include "SystemBatch.h"
 #include "ThreadStorage.h"
 #include "VectorMath.h"
 #include "Wigner3j.h"
-#include "fsph/src/spherical_harmonics.hpp"
 
 /*! \file Steinhardt.h
     \brief Computes variants of Steinhardt order parameters.
@@ -22,8 +28,6 @@
 
 namespace freud { namespace order {
 
-using YlmsType = std::vector<std::vector<std::complex<float>>>;
-
 //! Compute the Steinhardt local rotationally invariant ql or wl order parameter for a set of points
 /*!
  * Implements the rotationally invariant ql or wl order parameter described
@@ -56,7 +60,7 @@ using YlmsType = std::vector<std::vector<std::complex<float>>>;
  * - Wolfgang Lechner (2008) (DOI: 10.1063/Journal of Chemical Physics 129.114707)
  */
 
-class Steinhardt
+class Steinhardt : public locality::BondStage
 {
 public:
     //! Steinhardt Class Constructor
@@ -65,14 +69,21 @@ public:
      */
     explicit Steinhardt(const std::vector<unsigned int>& ls, bool average = false, bool wl = false,
                         bool weighted = false, bool wl_normalize = false)
-        : m_ls(ls), m_num_ms(m_ls.size()), m_average(average), m_wl(wl), m_weighted(weighted),
-          m_wl_normalize(wl_normalize), m_qlm_local(m_ls.size()), m_qlmi(ls.size()), m_qlm(ls.size()),
-          m_qlmiAve(ls.size()), m_qlmAve(ls.size())
+        : m_ls(ls), m_num_ms(m_ls.size()), m_m_offsets(m_ls.size()), m_average(average), m_wl(wl),
+          m_weighted(weighted), m_wl_normalize(wl_normalize)
 
     {
         std::transform(m_ls.cbegin(), m_ls.cend(), m_num_ms.begin(), [](const auto& l) { return 2 * l + 1; });
-        std::transform(m_ls.cbegin(), m_ls.cend(), m_qlm_local.begin(),
-                       [](const auto& l) { return util::ThreadStorage<std::complex<float>>(2 * l + 1); });
+        std::exclusive_scan(m_num_ms.cbegin(), m_num_ms.cend(), m_m_offsets.begin(), 0U);
+        m_total_ms = m_ls.empty() ? 0 : m_m_offsets.back() + m_num_ms.back();
+        m_qlm_local = util::ThreadStorage<std::complex<float>>(m_total_ms);
+        m_qlm_local_double = util::ThreadStorage<std::complex<double>>(m_total_ms);
+        m_system_order.prepare({0, m_ls.size()});
+        if (m_wl)
+        {
+            std::transform(m_ls.cbegin(), m_ls.cend(), std::back_inserter(m_wigner3j_terms),
+                           [](const auto& l) { return getWigner3jTerms(l); });
+        }
     }
 
     //! Steinhardt Class Constructor
@@ -85,7 +96,7 @@ public:
     {}
 
     //! Empty destructor
-    ~Steinhardt() = default;
+    ~Steinhardt() override = default;
 
     //! Get the number of particles used in the last compute
     unsigned int getNP() const
@@ -94,10 +105,14 @@ public:
     }
 
     //! Get the last calculated order parameter for each l
+    /*! The wl of the particles are only computed on the first call after a
+     *  compute, since the system order does not depend on them.
+     */
     const util::ManagedArray<float>& getParticleOrder() const
     {
         if (m_wl)
         {
+            updateParticleWl();
             return m_wli;
         }
         return getQl();
@@ -114,17 +129,34 @@ public:
     }
 
     //! Get the last calculated qlm for each particle and l
-    const std::vector<util::ManagedArray<std::complex<float>>>& getQlm() const
+    /*! The harmonics of each particle are stored contiguously for all l, in
+     *  the order of getL(). The harmonics of the l at position l_index start
+     *  at column getMOffsets()[l_index] and are indexed by m like
+     *  [0, 1, ..., l, -1, -2, ..., -l].
+     */
+    const util::ManagedArray<std::complex<float>>& getQlm() const
     {
         return m_qlmi;
     }
 
+    //! Get the first column of the harmonics of each l in the arrays of qlm
+    std::vector<unsigned int> getMOffsets() const
+    {
+        return m_m_offsets;
+    }
+
     //! Get system-normalized order for each l
     std::vector<float> getOrder() const
     {
         return m_norm;
     }
 
+    //! Get the system-normalized order of each system and l of the last call to computeSystems
+    const util::ManagedArray<float>& getSystemOrder() const
+    {
+        return m_system_order;
+    }
+
     //!< Whether to take a second shell average
     bool isAverage() const
     {
@@ -153,19 +185,32 @@ public:
     void compute(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
                  freud::locality::QueryArgs qargs);
 
+    //! Compute the order parameter of every system of a batch
+    /*! The per-particle arrays hold the points of all systems, the order of
+     *  each system is stored in getSystemOrder, and getOrder is the order of
+     *  the points of all systems.
+     */
+    void computeSystems(const freud::locality::SystemBatch& batch, freud::locality::QueryArgs qargs);
+
+    //! Prepare the order parameters of the points of the bonds consumed by computeBondStages.
+    /*! The query points must be the points.
+     */
+    void beginBonds(const freud::locality::NeighborQuery* neighbor_query, const vec3<float>* query_points,
+                    unsigned int n_query_points, const freud::locality::NeighborList& nlist) override;
+
+    //! Compute the qlm of a block of points from their bonds.
+    void consumeBonds(const freud::locality::NeighborList& nlist, size_t begin, size_t end, size_t first_bond,
+                      size_t end_bond) override;
+
+    //! Compute the neighbor averages, wl and the system order from the consumed bonds.
+    void endBonds(const freud::locality::NeighborList& nlist) override;
+
     std::vector<unsigned int> getL() const
     {
         return m_ls;
     }
 
 private:
-    //! \internal
-    //! Spherical harmonics calculation for Ylm filling a
-    //  std::vector<std::vector<std::complex<float> > > with values for m = 0, 1, ..., l, -1, ..., -l
-    //  for all l in m_ls
-    void computeYlm(fsph::PointSPHEvaluator<float>& sph_eval, const float theta, const float phi,
-                    YlmsType& Ylms) const;
-
     template<typename T> std::shared_ptr<T> makeArray(size_t size);
 
     //! Reallocates only the necessary arrays when the number of particles changes
@@ -176,24 +221,39 @@ private:
     void baseCompute(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
                      freud::locality::QueryArgs qargs);
 
+    //! Calculates the qlm and ql of point i from the bonds of an iterator over its neighbors
+    void computePointQlm(size_t i, freud::locality::NeighborPerPointIterator& ppiter,
+                         const freud::locality::NeighborQuery* points, SphericalHarmonicBlock& block);
+
+    //! Calculates the neighbor averages, wl and the system order once the qlm of all particles are known
+    void finishCompute(const freud::locality::NeighborList* nlist,
+                       const freud::locality::NeighborQuery* points, freud::locality::QueryArgs qargs);
+
     //! Calculates the neighbor average ql order parameter
     void computeAve(const freud::locality::NeighborList* nlist, const freud::locality::NeighborQuery* points,
                     freud::locality::QueryArgs qargs);
 
+    //! Sum the mean of the (averaged) qlm of all particles into m_qlm
+    void reduceSystemQlm();
+
     //! Compute the system-wide order by averaging over particles, then
     //  reducing over the m values to produce a single scalar.
     std::vector<float> normalizeSystem();
 
+    //! Compute the wl of the particles from their (averaged) qlm if they are not up to date
+    void updateParticleWl() const;
+
     //! Sum over Wigner 3j coefficients to compute third-order invariants
     //  wl from second-order invariants ql
-    void aggregatewl(util::ManagedArray<float>& target,
-                     const std::vector<util::ManagedArray<std::complex<float>>>& source,
+    void aggregatewl(util::ManagedArray<float>& target, const util::ManagedArray<std::complex<float>>& source,
                      const util::ManagedArray<float>& normalization_source) const;
 
     // Member variables used for compute
-    unsigned int m_Np {0};              //!< Last number of points computed
-    std::vector<unsigned int> m_ls;     //!< Spherical harmonic l values.
-    std::vector<unsigned int> m_num_ms; //!< The number of magnetic quantum numbers for each l (2*l+1).
+    unsigned int m_Np {0};                 //!< Last number of points computed
+    std::vector<unsigned int> m_ls;        //!< Spherical harmonic l values.
+    std::vector<unsigned int> m_num_ms;    //!< The number of magnetic quantum numbers for each l (2*l+1).
+    std::vector<unsigned int> m_m_offsets; //!< First column of the harmonics of each l in qlm arrays.
+    unsigned int m_total_ms {0};           //!< Number of harmonics of all l, the columns of qlm arrays.
 
     // Flags
     bool m_average;      //!< Whether to take a second shell average (default false)
@@ -201,19 +261,26 @@ private:
     bool m_weighted;     //!< Whether to use neighbor weights in computing qlmi (default false)
     bool m_wl_normalize; //!< Whether to normalize the third-order invariant wl (default false)
 
-    std::vector<util::ManagedArray<std::complex<float>>> m_qlmi; //!< qlm for each particle i
-    std::vector<util::ManagedArray<std::complex<float>>> m_qlm;  //!< Normalized qlm(Ave) for the whole system
-    std::vector<util::ThreadStorage<std::complex<float>>>
-        m_qlm_local;                    //!< Thread-specific m_qlm(Ave) for each l
+    std::vector<std::vector<Wigner3jTerm>> m_wigner3j_terms; //!< Nonzero Wigner 3j terms for each l if wl
+
+    util::ManagedArray<std::complex<float>> m_qlmi;       //!< qlm for each particle i and l
+    util::ManagedArray<std::complex<float>> m_qlm;        //!< Normalized qlm(Ave) for the whole system
+    util::ThreadStorage<std::complex<float>> m_qlm_local; //!< Thread-specific m_qlm(Ave)
+    util::ThreadStorage<std::complex<double>>
+        m_qlm_local_double; //!< Thread-specific m_qlm(Ave) summed in double precision
     util::ManagedArray<float> m_qli;    //!< ql locally invariant order parameter for each particle i
     util::ManagedArray<float> m_qliAve; //!< Averaged ql with 2nd neighbor shell for each particle i
-    std::vector<util::ManagedArray<std::complex<float>>>
-        m_qlmiAve; //!< Averaged qlm with 2nd neighbor shell for each particle i
-    std::vector<util::ManagedArray<std::complex<float>>>
-        m_qlmAve;                  //!< Normalized qlmiAve for the whole system
+    util::ManagedArray<std::complex<float>>
+        m_qlmiAve; //!< Averaged qlm with 2nd neighbor shell for each particle i and l
     std::vector<float> m_norm {0}; //!< System normalized order parameter
-    util::ManagedArray<float>
+    util::ManagedArray<float> m_system_order; //!< System normalized order parameter of each system
+    mutable util::ManagedArray<float>
         m_wli; //!< wl order parameter for each particle i, also used for wl averaged data
+    mutable bool m_wli_updated {true}; //!< Whether m_wli is up to date with the last compute
+
+    const freud::locality::NeighborQuery* m_stage_points {nullptr}; //!< Points of the consumed bonds
+    std::unique_ptr<tbb::enumerable_thread_specific<SphericalHarmonicBlock>>
+        m_stage_harmonic_blocks; //!< Harmonic blocks of the threads consuming bonds
 };
 
 }; };  // end namespace freud::order
@@ -8,7 +8,7 @@
 #include <vector>
 
 /*! \file Wigner3j.h
- *  \brief Stores and reduces over Wigner 3j coefficients for l from 0 to 20
+ *  \brief Computes and reduces over Wigner 3j coefficients
  */
 
 namespace freud { namespace order {
@@ -17,49 +17,35 @@ namespace freud { namespace order {
 //  [0, 1, ..., l, -1, -2, ..., -l]
 int lmIndex(int l, int m);
 
+//! A nonzero term of the sum over Wigner 3j coefficients.
+/*! The indices of the three m values are indices into arrays indexed like
+ *  [0, 1, ..., l, -1, -2, ..., -l].
+ */
+struct Wigner3jTerm
+{
+    unsigned int m1_index; //!< Index of m1
+    unsigned int m2_index; //!< Index of m2
+    unsigned int m3_index; //!< Index of m3 = -m1 - m2
+    float coefficient;     //!< Sum of the coefficients of all permutations of (m1, m2, m3)
+};
+
 //! Reduce an array using Wigner 3j coefficients to construct a
 //  third-order rotational invariant quantity.
 //  source array must be indexed by m, like [0, 1, ..., l, -1, -2, ..., -l].
-float reduceWigner3j(const std::complex<float>* source, unsigned int l_, const std::vector<double>& wigner3j);
-
+float reduceWigner3j(const std::complex<float>* source, const std::vector<Wigner3jTerm>& terms);
+
+//! Get the nonzero terms of the sum over Wigner 3j coefficients for l.
+//  Since the product of the three source values does not depend on the order
+//  of m1, m2, and m3, the coefficients of all permutations of a set of m
+//  values are combined into a single term, and terms that cancel are dropped.
+//  The terms of each l are computed once and cached.
+std::vector<Wigner3jTerm> getWigner3jTerms(unsigned int l);
+
+//! Get the Wigner 3j coefficients (l l l; m1 m2 m3) for all m1 + m2 + m3 = 0.
+//  The coefficients are ordered by m1 from -l to l, then by m2 from
+//  max(-l - m1, -l) to min(l - m1, l). They are computed with recursion
+//  relations, so any l is supported.
 std::vector<double> getWigner3j(unsigned int l);
-// All Wigner 3j coefficients created using sympy
-/*
-
-from sympy.physics.wigner import wigner_3j
-import numpy as np
-import json
-
-wigner = {}
-for l in range(21):
-    wigner[l] = []
-    for m1 in range(-l, l+1):
-        for m2 in range(max(-l-m1, -l), min(l-m1, l)+1):
-            m3 = -m1-m2
-            wigner[l].append(float(wigner_3j(l, l, l, m1, m2, m3)))
-
-with open('wigner3j.json', 'w') as jsonfile:
-    json.dump(wigner, jsonfile, sort_keys=True, indent=4)
-
-WIGNER_COEFF = """
-    case {l}:
-    {{
-        return {{
-{values}
-        }};
-    }}"""
-
-def format_values(values, per_line=4, spaces=12):
-    lines = []
-    for line in range(int(np.ceil(len(values)/per_line))):
-        lines.append(', '.join(
-            map(str, values[line*per_line:min(len(values), (line+1)*per_line)])))
-    return ' '*spaces + (',\n' + ' '*spaces).join(lines)
-
-for l in sorted(wigner.keys()):
-    print(WIGNER_COEFF.format(l=l, values=format_values(wigner[l])))
-
-*/
 
 }; };  // end namespace freud::order
 #endif // WIGNER3J_H
@@ -3,7 +3,14 @@
 
 #include "tbb_config.h"
 
-#include <thread>
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tbb/info.h>
+#include <tbb/task_arena.h>
+
+#include "utils.h"
 
 /*! \file tbb_config.cc
     \brief Helper functions to configure tbb
@@ -13,18 +20,27 @@ namespace freud { namespace parallel {
 
 std::unique_ptr<tbb::global_control> tbb_thread_control;
 
+namespace {
+//! Arenas pushed by the calling thread, the last of which runs its parallel computations.
+thread_local std::vector<std::unique_ptr<tbb::task_arena>> thread_arenas;
+} // namespace
+
 /*! \param N Number of threads to use for TBB computations
 
-    You do not need to call setTBBNumThreads. The default is to use the number of threads in the system. Use
-   \a N=0 to set back to the default.
+    You do not need to call setTBBNumThreads. The default is to use the number of threads available to the
+   process. Use \a N=0 to set back to the default.
 
     \note setTBBNumThreads should only be called from the main thread.
 */
 void setNumThreads(unsigned int N)
 {
+    // Without a global_control, TBB uses all threads available to the
+    // process, so the default does not initialize TBB before the first
+    // parallel computation.
     if (N == 0)
     {
-        N = std::thread::hardware_concurrency();
+        tbb_thread_control.reset();
+        return;
     }
 
     // then recreate it
@@ -32,4 +48,49 @@ void setNumThreads(unsigned int N)
         = std::make_unique<tbb::global_control>(tbb::global_control::parameter::max_allowed_parallelism, N);
 }
 
+void pushThreadArena(unsigned int max_concurrency, int numa_node, int max_threads_per_core)
+{
+    if (numa_node != -1)
+    {
+        const std::vector<int> numa_nodes = getNumaNodes();
+        if (std::find(numa_nodes.begin(), numa_nodes.end(), numa_node) == numa_nodes.end())
+        {
+            throw std::invalid_argument("NUMA node " + std::to_string(numa_node) + " is not available.");
+        }
+    }
+    if (max_threads_per_core == 0 || max_threads_per_core < -1)
+    {
+        throw std::invalid_argument("The maximum number of threads per core must be positive or -1.");
+    }
+
+    tbb::task_arena::constraints constraints;
+    constraints.set_numa_id(numa_node);
+    constraints.set_max_concurrency(max_concurrency == 0 ? tbb::task_arena::automatic
+                                                         : static_cast<int>(max_concurrency));
+    constraints.set_max_threads_per_core(max_threads_per_core);
+
+    // The arena is initialized here so that its threads are not created by
+    // the first compute.
+    auto arena = std::make_unique<tbb::task_arena>(constraints);
+    arena->initialize();
+    util::setThreadArena(arena.get());
+    thread_arenas.push_back(std::move(arena));
+}
+
+void popThreadArena()
+{
+    if (thread_arenas.empty())
+    {
+        return;
+    }
+    thread_arenas.pop_back();
+    util::setThreadArena(thread_arenas.empty() ? nullptr : thread_arenas.back().get());
+}
+
+std::vector<int> getNumaNodes()
+{
+    const auto numa_nodes = tbb::info::numa_nodes();
+    return std::vector<int>(numa_nodes.begin(), numa_nodes.end());
+}
+
 }; }; // end namespace freud::parallel
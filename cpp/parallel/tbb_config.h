@@ -4,7 +4,10 @@
 #ifndef TBB_CONFIG_H
 #define TBB_CONFIG_H
 
+#include <vector>
+
 #define TBB_PREVIEW_GLOBAL_CONTROL 1
+#define TBB_PREVIEW_TASK_ARENA_CONSTRAINTS_EXTENSION 1
 #include <tbb/global_control.h>
 
 /*! \file tbb_config.h
@@ -16,6 +19,23 @@ namespace freud { namespace parallel {
 //! Set the number of TBB threads
 void setNumThreads(unsigned int N);
 
+//! Run the parallel computations of the calling thread in a new task arena until popThreadArena.
+/*! Arenas are stacked, so that popThreadArena restores the arena of the
+ *  calling thread before this call.
+ *
+ *  \param max_concurrency Maximum number of threads of the arena, including the calling thread, or 0 for
+ *         the number of threads allowed by setNumThreads.
+ *  \param numa_node NUMA node to whose cores the threads of the arena are pinned, or -1 for any core.
+ *  \param max_threads_per_core Maximum number of threads of the arena on each core, or -1 for no limit.
+ */
+void pushThreadArena(unsigned int max_concurrency, int numa_node = -1, int max_threads_per_core = -1);
+
+//! Restore the task arena of the calling thread before the last pushThreadArena.
+void popThreadArena();
+
+//! Get the NUMA nodes that arenas can be pinned to, which are {-1} if the topology is unknown.
+std::vector<int> getNumaNodes();
+
 }; }; // end namespace freud::parallel
 
 #endif // TBB_CONFIG_H
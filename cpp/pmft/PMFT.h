@@ -4,11 +4,15 @@
 #ifndef PMFT_H
 #define PMFT_H
 
+#include <cmath>
+#include <vector>
+
 #include "BondHistogramCompute.h"
 #include "Box.h"
 #include "Histogram.h"
 #include "ManagedArray.h"
 #include "VectorMath.h"
+#include "utils.h"
 
 /*! \internal
     \file PMFT.h
@@ -28,7 +32,10 @@ class PMFT : public locality::BondHistogramCompute
 {
 public:
     //! Constructor
-    PMFT() : BondHistogramCompute() {}
+    /*! \param sparse If true, only the occupied bins are accumulated and
+     *         output, and the dense PCF and bin counts are not available.
+     */
+    explicit PMFT(bool sparse = false) : BondHistogramCompute(), m_sparse(sparse) {}
 
     //! Destructor
     ~PMFT() override = default;
@@ -39,7 +46,77 @@ public:
         return reduceAndReturn(m_pcf_array);
     }
 
+    //! Whether only the occupied bins are accumulated and output.
+    bool isSparse() const
+    {
+        return m_sparse;
+    }
+
+    //! Get the indices along each axis of the occupied bins in sparse mode, in row-major order.
+    const util::ManagedArray<unsigned int>& getSparseBins()
+    {
+        return reduceAndReturn(m_sparse_bins);
+    }
+
+    //! Get the bin counts of the occupied bins in sparse mode.
+    const util::ManagedArray<unsigned int>& getSparseBinCounts()
+    {
+        return reduceAndReturn(m_sparse_bin_counts);
+    }
+
+    //! Get the PCF of the occupied bins in sparse mode.
+    const util::ManagedArray<float>& getSparsePCF()
+    {
+        return reduceAndReturn(m_sparse_pcf);
+    }
+
 protected:
+    //! Number of bins above which all threads accumulate into shared bin counts.
+    /*! Thread local copies of histograms with more bins would use an amount of
+     *  memory proportional to the number of threads.
+     */
+    static constexpr size_t MAX_THREAD_LOCAL_BINS = size_t(1) << 20;
+
+    //! Get the cosine and sine of an orientation, with which angles to it are binned without atan2.
+    static vec2<double> orientationFrame(float orientation)
+    {
+        return {std::cos(static_cast<double>(orientation)), std::sin(static_cast<double>(orientation))};
+    }
+
+    //! Distance from the edges of the angle bins within which angles to an orientation are evaluated.
+    /*! The margin exceeds the rounding errors of subtracting angles from the
+     *  orientation and wrapping the difference into [0, 2pi) in single precision.
+     */
+    static double angleMargin(float orientation)
+    {
+        return 1e-5 * (1 + std::abs(static_cast<double>(orientation)));
+    }
+
+    //! Create the histogram with the given axes and its thread local histograms.
+    /*! In sparse mode, the dense bin counts are never allocated. Otherwise,
+     *  the bin counts are shared among threads for large histograms and for
+     *  histograms whose thread local copies would exceed the memory budget.
+     *  The thread local copies track their written blocks of bins, since the
+     *  bonds found by each thread only reach a part of a fine grid.
+     */
+    void initializeHistograms(const util::Axes& axes)
+    {
+        m_histogram = BondHistogram(axes, !m_sparse);
+        // The PCF has already been allocated by the constructors of the PMFTs.
+        const size_t copies_bytes = m_histogram.size() * sizeof(unsigned int) * util::getThreadConcurrency();
+        util::BinStorage storage = util::BinStorage::blocks;
+        if (m_sparse)
+        {
+            storage = util::BinStorage::sparse;
+        }
+        else if (m_histogram.size() > MAX_THREAD_LOCAL_BINS
+                 || !util::BufferPool::getInstance().fitsMemoryBudget(copies_bytes))
+        {
+            storage = util::BinStorage::shared;
+        }
+        m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram, storage);
+    }
+
     //! Reduce the thread local histogram into the total pair correlation function.
     /*! The pair correlation function is computed by reducing the bin counts in
      * all of the thread local histograms and then multiplying these by the
@@ -61,22 +138,70 @@ protected:
      *  \param JacobFactor A function with one parameter (the histogram bin index) that returns the volume of
      * the element in the histogram bin corresponding to the index.
      */
-    template<typename JacobFactor> void reduce(JacobFactor jf)
+    template<typename JacobFactor> void reduce(JacobFactor jf, unsigned int num_equiv_orientations = 1)
     {
-        m_pcf_array.prepare(m_histogram.shape());
-        m_histogram.prepare(m_histogram.shape());
+        const util::ScopedMemoryOwner owner("PMFT");
+        // The normalization is computed in the precision of the accumulation.
+        util::dispatchAccumulator(false, [&](auto zero) {
+            using Accumulator = decltype(zero);
+            Accumulator inv_num_dens = static_cast<Accumulator>(m_box.getVolume())
+                / static_cast<Accumulator>(m_n_query_points);
+            Accumulator norm_factor = Accumulator(1.0)
+                / (static_cast<Accumulator>(m_frame_counter) * static_cast<Accumulator>(m_n_points)
+                   * static_cast<Accumulator>(num_equiv_orientations));
+            Accumulator prefactor = inv_num_dens * norm_factor;
+
+            if (m_sparse)
+            {
+                reduceSparse(prefactor, jf);
+                return;
+            }
+
+            m_pcf_array.prepareForOverwrite(m_histogram.shape());
+            m_histogram.prepare(m_histogram.shape());
 
-        float inv_num_dens = m_box.getVolume() / static_cast<float>(m_n_query_points);
-        float norm_factor
-            = float(1.0) / (static_cast<float>(m_frame_counter) * static_cast<float>(m_n_points));
-        float prefactor = inv_num_dens * norm_factor;
+            m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &jf](size_t i) {
+                m_pcf_array[i] = static_cast<float>(static_cast<Accumulator>(m_histogram[i]) * prefactor
+                                                    * static_cast<Accumulator>(jf(i)));
+            });
+        });
+    }
+
+    //! Reduce the sparse thread local bin counts into the occupied bins and their PCF.
+    template<typename Accumulator, typename JacobFactor>
+    void reduceSparse(Accumulator prefactor, JacobFactor jf)
+    {
+        std::vector<size_t> bins;
+        std::vector<unsigned int> counts;
+        m_local_histograms.reduceIntoSparse(bins, counts);
 
-        m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &jf](size_t i) {
-            m_pcf_array[i] = static_cast<float>(m_histogram[i]) * prefactor * jf(i);
+        const auto axis_sizes = m_histogram.getAxisSizes();
+        const size_t n_axes = axis_sizes.size();
+        m_sparse_bins.prepare({bins.size(), n_axes});
+        m_sparse_bin_counts.prepare(bins.size());
+        m_sparse_pcf.prepare(bins.size());
+        util::forLoopWrapper(0, bins.size(), [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i)
+            {
+                // Split the linear bin into the bins along each axis.
+                size_t bin = bins[i];
+                for (size_t axis = n_axes; axis-- > 0;)
+                {
+                    m_sparse_bins[i * n_axes + axis] = static_cast<unsigned int>(bin % axis_sizes[axis]);
+                    bin /= axis_sizes[axis];
+                }
+                m_sparse_bin_counts[i] = counts[i];
+                m_sparse_pcf[i] = static_cast<float>(static_cast<Accumulator>(counts[i]) * prefactor
+                                                     * static_cast<Accumulator>(jf(bins[i])));
+            }
         });
     }
 
-    util::ManagedArray<float> m_pcf_array; //!< Array of computed pair correlation function.
+    bool m_sparse;                                        //!< Whether only the occupied bins are accumulated.
+    util::ManagedArray<float> m_pcf_array;                //!< Array of computed pair correlation function.
+    util::ManagedArray<unsigned int> m_sparse_bins;       //!< Indices of the occupied bins along each axis.
+    util::ManagedArray<unsigned int> m_sparse_bin_counts; //!< Bin counts of the occupied bins.
+    util::ManagedArray<float> m_sparse_pcf;               //!< Pair correlation function of the occupied bins.
 };
 
 }; }; // end namespace freud::pmft
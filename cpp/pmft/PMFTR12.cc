@@ -1,8 +1,12 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <vector>
 
+#include "AngleBins.h"
 #include "PMFTR12.h"
 #include "utils.h"
 
@@ -12,8 +16,10 @@
 
 namespace freud { namespace pmft {
 
-PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int n_t2) : PMFT()
+PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int n_t2, bool sparse)
+    : PMFT(sparse)
 {
+    const util::ScopedMemoryOwner owner("PMFT");
     if (n_r < 1)
     {
         throw std::invalid_argument("PMFTR12 requires at least 1 bin in R.");
@@ -31,12 +37,17 @@ PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int
         throw std::invalid_argument("PMFTR12 requires that r_max must be positive.");
     }
 
+    // Create the PCF array.
+    if (!m_sparse)
+    {
+        m_pcf_array.prepare({n_r, n_t1, n_t2});
+    }
+
     // Construct the Histogram object that will be used to keep track of counts of bond distances found.
     const auto axes = util::Axes {std::make_shared<util::RegularAxis>(n_r, 0, r_max),
                                   std::make_shared<util::RegularAxis>(n_t1, 0, constants::TWO_PI),
                                   std::make_shared<util::RegularAxis>(n_t2, 0, constants::TWO_PI)};
-    m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    initializeHistograms(axes);
 
     // Note: There is an additional implicit volume factor of 2*pi
     // corresponding to the rotational degree of freedom of the second particle
@@ -46,8 +57,9 @@ PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int
     // this factor for dt1 because it is part of the real space volume for the
     // central particle, see PMFT::reduce for more information.
     //
-    // The array is computed as the inverse for faster use later.
-    m_inv_jacobian_array.prepare({n_r, n_t1, n_t2});
+    // The jacobian only depends on the distance, so it is stored once for
+    // each distance bin. It is computed as the inverse for faster use later.
+    m_inv_jacobians.resize(n_r);
     std::vector<float> bins_r = m_histogram.getBinCenters()[0];
     float dr = r_max / float(n_r);
     float dt1 = constants::TWO_PI / float(n_t1);
@@ -56,22 +68,15 @@ PMFTR12::PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int
     for (unsigned int i = 0; i < n_r; i++)
     {
         float r = bins_r[i];
-        for (unsigned int j = 0; j < n_t1; j++)
-        {
-            for (unsigned int k = 0; k < n_t2; k++)
-            {
-                m_inv_jacobian_array(i, j, k) = (float) 1.0 / (r * product);
-            }
-        }
+        m_inv_jacobians[i] = (float) 1.0 / (r * product);
     }
-
-    // Create the PCF array.
-    m_pcf_array.prepare({n_r, n_t1, n_t2});
 }
 
 void PMFTR12::reduce()
 {
-    PMFT::reduce([this](size_t i) { return m_inv_jacobian_array[i]; });
+    const auto axis_sizes = m_histogram.getAxisSizes();
+    const size_t n_angle_bins = axis_sizes[1] * axis_sizes[2];
+    PMFT::reduce([this, n_angle_bins](size_t i) { return m_inv_jacobians[i / n_angle_bins]; });
 }
 
 void PMFTR12::accumulate(const locality::NeighborQuery* neighbor_query, const float* orientations,
@@ -79,20 +84,70 @@ void PMFTR12::accumulate(const locality::NeighborQuery* neighbor_query, const fl
                          unsigned int n_query_points, const locality::NeighborList* nlist,
                          freud::locality::QueryArgs qargs)
 {
+    const util::ScopedMemoryOwner owner("PMFT");
     neighbor_query->getBox().enforce2D();
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
-                          // calculate angles
-                          float d_theta1 = std::atan2(delta.y, delta.x);
-                          float d_theta2 = std::atan2(-delta.y, -delta.x);
-                          float t1 = orientations[neighbor_bond.point_idx] - d_theta1;
-                          float t2 = query_orientations[neighbor_bond.query_point_idx] - d_theta2;
-                          // make sure that t1, t2 are bounded between 0 and 2PI
-                          t1 = util::modulusPositive(t1, constants::TWO_PI);
-                          t2 = util::modulusPositive(t2, constants::TWO_PI);
-                          m_local_histograms(neighbor_bond.distance, t1, t2);
-                      });
+    const util::StaticAxes<util::RegularAxis, util::RegularAxis, util::RegularAxis> axes(
+        m_histogram.getAxes());
+    const auto r_axis = dynamic_cast<const util::RegularAxis&>(*m_histogram.getAxes()[0]);
+    const auto axis_sizes = m_histogram.getAxisSizes();
+    const util::AzimuthBins t1_bins(axis_sizes[1]);
+    const util::AzimuthBins t2_bins(axis_sizes[2]);
+
+    // The angles t1 and t2 are the angles of the bond direction relative to
+    // the orientations, so their bins are found from the components of the
+    // bond in the frame of each orientation, whose cosine and sine are
+    // computed once per point rather than once per bond.
+    const unsigned int n_points = neighbor_query->getNPoints();
+    std::vector<vec2<double>> point_frames(n_points);
+    std::vector<vec2<double>> query_frames(n_query_points);
+    util::forLoopWrapper(0, std::max(n_points, n_query_points), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (i < n_points)
+            {
+                point_frames[i] = orientationFrame(orientations[i]);
+            }
+            if (i < n_query_points)
+            {
+                query_frames[i] = orientationFrame(query_orientations[i]);
+            }
+        }
+    });
+
+    accumulateGeneral(
+        neighbor_query, query_points, n_query_points, nlist, qargs,
+        [&](const freud::locality::NeighborBond& neighbor_bond) {
+            vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+            const size_t r_bin = r_axis.util::RegularAxis::bin(neighbor_bond.distance);
+            if (r_bin == util::Axis::OVERFLOW_BIN)
+            {
+                return;
+            }
+            const vec2<double>& frame1 = point_frames[neighbor_bond.point_idx];
+            const vec2<double>& frame2 = query_frames[neighbor_bond.query_point_idx];
+            const double dx = delta.x;
+            const double dy = delta.y;
+            size_t t1_bin = 0;
+            size_t t2_bin = 0;
+            if (t1_bins.find(frame1.x * dx + frame1.y * dy, frame1.y * dx - frame1.x * dy,
+                             angleMargin(orientations[neighbor_bond.point_idx]), t1_bin)
+                && t2_bins.find(-frame2.x * dx - frame2.y * dy, frame2.x * dy - frame2.y * dx,
+                                angleMargin(query_orientations[neighbor_bond.query_point_idx]), t2_bin))
+            {
+                m_local_histograms.increment((r_bin * axis_sizes[1] + t1_bin) * axis_sizes[2] + t2_bin);
+                return;
+            }
+
+            // calculate angles
+            float d_theta1 = std::atan2(delta.y, delta.x);
+            float d_theta2 = std::atan2(-delta.y, -delta.x);
+            float t1 = orientations[neighbor_bond.point_idx] - d_theta1;
+            float t2 = query_orientations[neighbor_bond.query_point_idx] - d_theta2;
+            // make sure that t1, t2 are bounded between 0 and 2PI
+            t1 = util::modulusPositive(t1, constants::TWO_PI);
+            t2 = util::modulusPositive(t2, constants::TWO_PI);
+            m_local_histograms.increment(axes.bin(neighbor_bond.distance, t1, t2));
+        });
 }
 
 }; }; // end namespace freud::pmft
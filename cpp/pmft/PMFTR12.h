@@ -4,6 +4,8 @@
 #ifndef PMFTR12_H
 #define PMFTR12_H
 
+#include <vector>
+
 #include "PMFT.h"
 
 /*! \file PMFTR12.h
@@ -16,7 +18,7 @@ class PMFTR12 : public PMFT
 {
 public:
     //! Constructor
-    PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int n_t2);
+    PMFTR12(float r_max, unsigned int n_r, unsigned int n_t1, unsigned int n_t2, bool sparse = false);
 
     /*! Compute the PCF for the passed in set of points. The function will be added to previous values
         of the PCF
@@ -31,7 +33,7 @@ protected:
     //! helper function to reduce the thread specific arrays into one array
     void reduce() override;
 
-    util::ManagedArray<float> m_inv_jacobian_array; //!< Array of inverse jacobians for each bin
+    std::vector<float> m_inv_jacobians; //!< Inverse jacobian of the bins at each distance
 };
 
 }; }; // end namespace freud::pmft
@@ -13,6 +13,7 @@ namespace freud { namespace pmft {
 
 PMFTXY::PMFTXY(float x_max, float y_max, unsigned int n_x, unsigned int n_y) : PMFT()
 {
+    const util::ScopedMemoryOwner owner("PMFT");
     if (n_x < 1)
     {
         throw std::invalid_argument("PMFTXY requires at least 1 bin in X.");
@@ -45,8 +46,7 @@ PMFTXY::PMFTXY(float x_max, float y_max, unsigned int n_x, unsigned int n_y) : P
     // Construct the Histogram object that will be used to keep track of counts of bond distances found.
     const auto axes = util::Axes {std::make_shared<util::RegularAxis>(n_x, -x_max, x_max),
                                   std::make_shared<util::RegularAxis>(n_y, -y_max, y_max)};
-    m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    initializeHistograms(axes);
 }
 
 void PMFTXY::reduce()
@@ -59,7 +59,9 @@ void PMFTXY::accumulate(const locality::NeighborQuery* neighbor_query, const flo
                         const vec3<float>* query_points, unsigned int n_query_points,
                         const locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
 {
+    const util::ScopedMemoryOwner owner("PMFT");
     neighbor_query->getBox().enforce2D();
+    const util::StaticAxes<util::RegularAxis, util::RegularAxis> axes(m_histogram.getAxes());
     accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
                       [&](const freud::locality::NeighborBond& neighbor_bond) {
                           vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
@@ -70,7 +72,7 @@ void PMFTXY::accumulate(const locality::NeighborQuery* neighbor_query, const flo
                               = rotmat2<float>::fromAngle(-query_orientations[neighbor_bond.query_point_idx]);
                           vec2<float> rotVec = myMat * myVec;
 
-                          m_local_histograms(rotVec.x, rotVec.y);
+                          m_local_histograms.increment(axes.bin(rotVec.x, rotVec.y));
                       });
 }
 
@@ -1,8 +1,12 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
+#include <algorithm>
+#include <cmath>
 #include <stdexcept>
+#include <vector>
 
+#include "AngleBins.h"
 #include "PMFTXYT.h"
 #include "utils.h"
 
@@ -14,6 +18,7 @@ namespace freud { namespace pmft {
 
 PMFTXYT::PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, unsigned int n_t) : PMFT()
 {
+    const util::ScopedMemoryOwner owner("PMFT");
     if (n_x < 1)
     {
         throw std::invalid_argument("PMFTXYT requires at least 1 bin in X.");
@@ -52,8 +57,7 @@ PMFTXYT::PMFTXYT(float x_max, float y_max, unsigned int n_x, unsigned int n_y, u
     const auto axes = util::Axes {std::make_shared<util::RegularAxis>(n_x, -x_max, x_max),
                                   std::make_shared<util::RegularAxis>(n_y, -y_max, y_max),
                                   std::make_shared<util::RegularAxis>(n_t, 0, constants::TWO_PI)};
-    m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    initializeHistograms(axes);
 }
 
 void PMFTXYT::reduce()
@@ -67,22 +71,67 @@ void PMFTXYT::accumulate(const locality::NeighborQuery* neighbor_query, const fl
                          unsigned int n_query_points, const locality::NeighborList* nlist,
                          freud::locality::QueryArgs qargs)
 {
+    const util::ScopedMemoryOwner owner("PMFT");
     neighbor_query->getBox().enforce2D();
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+    const util::StaticAxes<util::RegularAxis, util::RegularAxis, util::RegularAxis> axes(
+        m_histogram.getAxes());
 
-                          // rotate interparticle vector
-                          vec2<float> myVec(delta.x, delta.y);
-                          rotmat2<float> myMat
-                              = rotmat2<float>::fromAngle(-query_orientations[neighbor_bond.query_point_idx]);
-                          vec2<float> rotVec = myMat * myVec;
-                          // calculate angle
-                          float d_theta = std::atan2(-delta.y, -delta.x);
-                          float t = orientations[neighbor_bond.point_idx] - d_theta;
-                          // make sure that t is bounded between 0 and 2PI
-                          t = util::modulusPositive(t, constants::TWO_PI);
-                          m_local_histograms(rotVec.x, rotVec.y, t);
-                      });
+    const auto x_axis = dynamic_cast<const util::RegularAxis&>(*m_histogram.getAxes()[0]);
+    const auto y_axis = dynamic_cast<const util::RegularAxis&>(*m_histogram.getAxes()[1]);
+    const auto axis_sizes = m_histogram.getAxisSizes();
+    const util::AzimuthBins t_bins(axis_sizes[2]);
+
+    // Each query point's rotation is computed once and shared by its bonds,
+    // and so are the cosine and sine of each point's orientation, from which
+    // the bin of the angle t is found without evaluating it for most bonds.
+    const unsigned int n_points = neighbor_query->getNPoints();
+    std::vector<rotmat2<float>> query_rotations(n_query_points);
+    std::vector<vec2<double>> point_frames(n_points);
+    util::forLoopWrapper(0, std::max(n_points, n_query_points), [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i)
+        {
+            if (i < n_query_points)
+            {
+                query_rotations[i] = rotmat2<float>::fromAngle(-query_orientations[i]);
+            }
+            if (i < n_points)
+            {
+                point_frames[i] = orientationFrame(orientations[i]);
+            }
+        }
+    });
+
+    accumulateGeneral(
+        neighbor_query, query_points, n_query_points, nlist, qargs,
+        [&](const freud::locality::NeighborBond& neighbor_bond) {
+            vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+
+            // rotate interparticle vector
+            vec2<float> myVec(delta.x, delta.y);
+            vec2<float> rotVec = query_rotations[neighbor_bond.query_point_idx] * myVec;
+            const size_t x_bin = x_axis.util::RegularAxis::bin(rotVec.x);
+            const size_t y_bin = y_axis.util::RegularAxis::bin(rotVec.y);
+            if (x_bin == util::Axis::OVERFLOW_BIN || y_bin == util::Axis::OVERFLOW_BIN)
+            {
+                return;
+            }
+            const vec2<double>& frame = point_frames[neighbor_bond.point_idx];
+            const double dx = delta.x;
+            const double dy = delta.y;
+            size_t t_bin = 0;
+            if (t_bins.find(-frame.x * dx - frame.y * dy, frame.x * dy - frame.y * dx,
+                            angleMargin(orientations[neighbor_bond.point_idx]), t_bin))
+            {
+                m_local_histograms.increment((x_bin * axis_sizes[1] + y_bin) * axis_sizes[2] + t_bin);
+                return;
+            }
+
+            // calculate angle
+            float d_theta = std::atan2(-delta.y, -delta.x);
+            float t = orientations[neighbor_bond.point_idx] - d_theta;
+            // make sure that t is bounded between 0 and 2PI
+            t = util::modulusPositive(t, constants::TWO_PI);
+            m_local_histograms.increment(axes.bin(rotVec.x, rotVec.y, t));
+        });
 }
 }; }; // end namespace freud::pmft
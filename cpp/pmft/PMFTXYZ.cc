@@ -1,8 +1,12 @@
 // Copyright (c) 2010-2023 The Regents of the University of Michigan
 // This file is from the freud project, released under the BSD 3-Clause License.
 
-#include "PMFTXYZ.h"
+#include <algorithm>
+#include <array>
 #include <stdexcept>
+#include <vector>
+
+#include "PMFTXYZ.h"
 
 /*! \file PMFTXYZ.cc
     \brief Routines for computing 3D potential of mean force in XYZ coordinates
@@ -11,9 +15,10 @@
 namespace freud { namespace pmft {
 
 PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsigned int n_y, unsigned int n_z,
-                 const vec3<float>& shiftvec)
-    : PMFT(), m_shiftvec(shiftvec), m_num_equiv_orientations(0xffffffff)
+                 const vec3<float>& shiftvec, bool sparse)
+    : PMFT(sparse), m_shiftvec(shiftvec), m_num_equiv_orientations(0xffffffff)
 {
+    const util::ScopedMemoryOwner owner("PMFT");
     if (n_x < 1)
     {
         throw std::invalid_argument("PMFTXYZ requires at least 1 bin in X.");
@@ -61,33 +66,26 @@ PMFTXYZ::PMFTXYZ(float x_max, float y_max, float z_max, unsigned int n_x, unsign
     m_jacobian = dx * dy * dz;
 
     // Create the PCF array.
-    m_pcf_array.prepare({n_x, n_y, n_z});
+    if (!m_sparse)
+    {
+        m_pcf_array.prepare({n_x, n_y, n_z});
+    }
 
     // Construct the Histogram object that will be used to keep track of counts
     // of bond distances found.
     const auto axes = util::Axes {std::make_shared<util::RegularAxis>(n_x, -x_max, x_max),
                                   std::make_shared<util::RegularAxis>(n_y, -y_max, y_max),
                                   std::make_shared<util::RegularAxis>(n_z, -z_max, z_max)};
-    m_histogram = BondHistogram(axes);
-    m_local_histograms = BondHistogram::ThreadLocalHistogram(m_histogram);
+    initializeHistograms(axes);
 }
 
-// Almost identical to the parent method, except that the normalization factor
-// in this class also includes the number of equivalent orientations.
+// The normalization factor in this class also includes the number of
+// equivalent orientations.
 void PMFTXYZ::reduce()
 {
-    m_pcf_array.prepare(m_histogram.shape());
-    m_histogram.prepare(m_histogram.shape());
-
-    float inv_num_dens = m_box.getVolume() / (float) m_n_query_points;
-    float norm_factor
-        = (float) 1.0 / ((float) m_frame_counter * (float) m_n_points * (float) m_num_equiv_orientations);
-    float prefactor = inv_num_dens * norm_factor;
-
     float jacobian_factor = (float) 1.0 / m_jacobian;
-    m_histogram.reduceOverThreadsPerBin(m_local_histograms, [this, &prefactor, &jacobian_factor](size_t i) {
-        m_pcf_array[i] = static_cast<float>(m_histogram[i]) * prefactor * jacobian_factor;
-    });
+    PMFT::reduce([jacobian_factor](size_t /*i*/) { return jacobian_factor; },
+                 m_num_equiv_orientations);
 }
 
 void PMFTXYZ::reset()
@@ -101,6 +99,7 @@ void PMFTXYZ::accumulate(const locality::NeighborQuery* neighbor_query, const qu
                          const quat<float>* equiv_orientations, unsigned int num_equiv_orientations,
                          const locality::NeighborList* nlist, freud::locality::QueryArgs qargs)
 {
+    const util::ScopedMemoryOwner owner("PMFT");
     // Set the number of equivalent orientations the first time we compute
     // (after a reset), then error on subsequent calls if it changes.
     if (m_num_equiv_orientations == 0xffffffff)
@@ -113,24 +112,65 @@ void PMFTXYZ::accumulate(const locality::NeighborQuery* neighbor_query, const qu
             "The number of equivalent orientations must be constant while accumulating data into PMFTXYZ.");
     }
     neighbor_query->getBox().enforce3D();
-    accumulateGeneral(neighbor_query, query_points, n_query_points, nlist, qargs,
-                      [&](const freud::locality::NeighborBond& neighbor_bond) {
-                          // create the reference point quaternion
-                          quat<float> query_orientation(query_orientations[neighbor_bond.query_point_idx]);
-                          // make sure that the particles are wrapped into the box
-                          vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
-
-                          for (unsigned int k = 0; k < num_equiv_orientations; k++)
-                          {
-                              // create point vector
-                              vec3<float> v(delta);
-                              // rotate the vector
-                              v = rotate(conj(query_orientation), v);
-                              v = rotate(equiv_orientations[k], v);
-
-                              m_local_histograms(v.x, v.y, v.z);
-                          }
-                      });
+    const util::StaticAxes<util::RegularAxis, util::RegularAxis, util::RegularAxis> axes(
+        m_histogram.getAxes());
+
+    // Convert the equivalent orientations to rotation matrices once. Each
+    // matrix element is stored contiguously over the orientations, so the
+    // rotation of a bond vector by a block of orientations vectorizes.
+    std::array<std::vector<float>, 9> equiv_rotations;
+    for (auto& element : equiv_rotations)
+    {
+        element.resize(num_equiv_orientations);
+    }
+    for (unsigned int k = 0; k < num_equiv_orientations; ++k)
+    {
+        const rotmat3<float> rotation(equiv_orientations[k]);
+        const std::array<vec3<float>, 3> rows {rotation.row0, rotation.row1, rotation.row2};
+        for (unsigned int row = 0; row < 3; ++row)
+        {
+            equiv_rotations[3 * row][k] = rows[row].x;
+            equiv_rotations[3 * row + 1][k] = rows[row].y;
+            equiv_rotations[3 * row + 2][k] = rows[row].z;
+        }
+    }
+
+    accumulateGeneral(
+        neighbor_query, query_points, n_query_points, nlist, qargs,
+        [&](const freud::locality::NeighborBond& neighbor_bond) {
+            // make sure that the particles are wrapped into the box
+            const vec3<float> delta(bondVector(neighbor_bond, neighbor_query, query_points));
+            // rotate the vector into the frame of the query point
+            const vec3<float> v(rotate(conj(query_orientations[neighbor_bond.query_point_idx]), delta));
+
+            constexpr unsigned int block_size = 64;
+            std::array<float, block_size> x;
+            std::array<float, block_size> y;
+            std::array<float, block_size> z;
+            for (unsigned int k_begin = 0; k_begin < num_equiv_orientations; k_begin += block_size)
+            {
+                const unsigned int n_block = std::min(block_size, num_equiv_orientations - k_begin);
+                const float* m00 = equiv_rotations[0].data() + k_begin;
+                const float* m01 = equiv_rotations[1].data() + k_begin;
+                const float* m02 = equiv_rotations[2].data() + k_begin;
+                const float* m10 = equiv_rotations[3].data() + k_begin;
+                const float* m11 = equiv_rotations[4].data() + k_begin;
+                const float* m12 = equiv_rotations[5].data() + k_begin;
+                const float* m20 = equiv_rotations[6].data() + k_begin;
+                const float* m21 = equiv_rotations[7].data() + k_begin;
+                const float* m22 = equiv_rotations[8].data() + k_begin;
+                for (unsigned int i = 0; i < n_block; ++i)
+                {
+                    x[i] = m00[i] * v.x + m01[i] * v.y + m02[i] * v.z;
+                    y[i] = m10[i] * v.x + m11[i] * v.y + m12[i] * v.z;
+                    z[i] = m20[i] * v.x + m21[i] * v.y + m22[i] * v.z;
+                }
+                for (unsigned int i = 0; i < n_block; ++i)
+                {
+                    m_local_histograms.increment(axes.bin(x[i], y[i], z[i]));
+                }
+            }
+        });
 }
 
 }; }; // end namespace freud::pmft
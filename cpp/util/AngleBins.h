@@ -0,0 +1,125 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef ANGLE_BINS_H
+#define ANGLE_BINS_H
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+/*! \file AngleBins.h
+    \brief Bins of angles found from the Cartesian components of directions without evaluating the angles.
+*/
+
+namespace freud { namespace util {
+
+//! Lookup of the bin of a value along an axis with monotonically increasing, irregular bin edges.
+class EdgeLookup
+{
+public:
+    //! Constructor
+    /*! \param edges The n_bins + 1 increasing edges of the bins.
+     */
+    explicit EdgeLookup(std::vector<double> edges) : m_edges(std::move(edges))
+    {
+        const size_t n_bins = m_edges.size() - 1;
+        const size_t n_cells = CELLS_PER_BIN * n_bins;
+        m_min = m_edges.front();
+        m_max = m_edges.back();
+        m_cell_scale = static_cast<double>(n_cells) / (m_max - m_min);
+        m_cell_bins.resize(n_cells);
+        size_t bin = 0;
+        for (size_t cell = 0; cell < n_cells; ++cell)
+        {
+            const double lower = m_min + static_cast<double>(cell) / m_cell_scale;
+            while (bin + 1 < n_bins && m_edges[bin + 1] <= lower)
+            {
+                ++bin;
+            }
+            m_cell_bins[cell] = static_cast<unsigned int>(bin);
+        }
+    }
+
+    //! Find the bin of a value, returning false if it is within margin of an edge or out of bounds.
+    bool find(double value, double margin, size_t& bin) const
+    {
+        if (!(value >= m_min && value <= m_max))
+        {
+            return false;
+        }
+        const auto cell = static_cast<size_t>((value - m_min) * m_cell_scale);
+        bin = m_cell_bins[std::min(cell, m_cell_bins.size() - 1)];
+        while (bin + 2 < m_edges.size() && value >= m_edges[bin + 1])
+        {
+            ++bin;
+        }
+        return value - m_edges[bin] >= margin && m_edges[bin + 1] - value >= margin;
+    }
+
+private:
+    //! Number of cells of the lookup table per bin, so that few edges fall into each cell.
+    static constexpr size_t CELLS_PER_BIN = 4;
+
+    std::vector<double> m_edges;           //!< Edges of the bins
+    std::vector<unsigned int> m_cell_bins; //!< Bin containing the lower end of each cell
+    double m_min;                          //!< Lowest edge
+    double m_max;                          //!< Highest edge
+    double m_cell_scale;                   //!< Number of cells per unit of value
+};
+
+//! Bins of the angle of 2D directions on a regular axis of (0, 2pi).
+/*! The angle atan2(y, x) is mapped monotonically to the "diamond angle"
+ *  y / (|x| + |y|) shifted by the quadrant, which is binned with a lookup
+ *  table of the edges of the bins transformed the same way. The derivative
+ *  of the map with respect to the angle is at most one, so directions
+ *  farther than a margin from all transformed edges are farther than the
+ *  margin from the edges of the angles, and get the same bins as the angles
+ *  would if their rounding errors are smaller than the margin.
+ */
+class AzimuthBins
+{
+public:
+    //! Constructor
+    /*! \param n_bins The number of bins of the angle.
+     */
+    explicit AzimuthBins(size_t n_bins) : m_edges(edges(n_bins)) {}
+
+    //! Find the bin of the angle of (x, y), returning false for (0, 0) or within margin of an edge.
+    bool find(double x, double y, double margin, size_t& bin) const
+    {
+        return (x != 0 || y != 0) && m_edges.find(diamondAngle(x, y), margin, bin);
+    }
+
+    //! Monotonic map of the angle of (x, y) in [0, 2pi) to [0, 4).
+    static double diamondAngle(double x, double y)
+    {
+        if (y >= 0)
+        {
+            return (x >= 0) ? y / (x + y) : 1 - x / (y - x);
+        }
+        return (x < 0) ? 2 - y / (-x - y) : 3 + x / (x - y);
+    }
+
+private:
+    //! Diamond angles of the edges of the bins of the angle.
+    static EdgeLookup edges(size_t n_bins)
+    {
+        std::vector<double> edges(n_bins + 1);
+        for (size_t i = 0; i <= n_bins; ++i)
+        {
+            const double theta = 2 * M_PI * static_cast<double>(i) / static_cast<double>(n_bins);
+            edges[i] = diamondAngle(std::cos(theta), std::sin(theta));
+        }
+        edges.front() = 0;
+        edges.back() = 4;
+        return EdgeLookup(edges);
+    }
+
+    EdgeLookup m_edges; //!< Diamond angles of the edges of the bins
+};
+
+}; }; // end namespace freud::util
+
+#endif // ANGLE_BINS_H
@@ -0,0 +1,276 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+#include "BufferPool.h"
+#include "Instrumentation.h"
+
+/*! \file BufferPool.cc
+    \brief Aligned allocation and reuse of the buffers of arrays.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+thread_local const char* thread_owner = nullptr;
+std::atomic<const char*> default_owner {nullptr};
+
+void* alignedAllocate(size_t bytes, size_t alignment)
+{
+    // std::aligned_alloc requires the size to be a multiple of the alignment.
+    return std::aligned_alloc(alignment, (bytes + alignment - 1) / alignment * alignment);
+}
+
+void alignedDeallocate(void* buffer, size_t /*bytes*/)
+{
+    std::free(buffer);
+}
+} // namespace
+
+ScopedMemoryOwner::ScopedMemoryOwner(const char* owner) : m_previous(thread_owner)
+{
+    if (m_previous == nullptr)
+    {
+        const char* expected = nullptr;
+        m_outermost = default_owner.compare_exchange_strong(expected, owner);
+    }
+    thread_owner = owner;
+}
+
+ScopedMemoryOwner::~ScopedMemoryOwner()
+{
+    thread_owner = m_previous;
+    if (m_outermost)
+    {
+        default_owner.store(nullptr);
+    }
+}
+
+const char* ScopedMemoryOwner::current()
+{
+    return (thread_owner != nullptr) ? thread_owner : default_owner.load();
+}
+
+BufferPool::BufferPool() : m_allocator(getDefaultAllocator()) {}
+
+BufferPool& BufferPool::getInstance()
+{
+    // The pool is never destroyed, since arrays may be released by Python
+    // after static objects are destroyed at exit.
+    static auto* pool = new BufferPool();
+    return *pool;
+}
+
+Allocator BufferPool::getDefaultAllocator()
+{
+    return Allocator {alignedAllocate, alignedDeallocate};
+}
+
+size_t BufferPool::sizeClass(size_t bytes)
+{
+    // Multiples of the alignment up to 4 alignments, then four classes per
+    // power of two: 2^k, 1.25 2^k, 1.5 2^k, 1.75 2^k.
+    bytes = std::max(bytes, ALIGNMENT);
+    if (bytes <= 4 * ALIGNMENT)
+    {
+        return (bytes + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT;
+    }
+    size_t power = 4 * ALIGNMENT;
+    while (2 * power < bytes)
+    {
+        power *= 2;
+    }
+    const size_t step = power / 4;
+    return (bytes + step - 1) / step * step;
+}
+
+void* BufferPool::allocate(size_t bytes)
+{
+    recordAllocation(bytes);
+    const size_t size_class = sizeClass(bytes);
+    const char* owner = ScopedMemoryOwner::current();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_budget != 0 && m_total_usage.current + size_class > m_budget)
+    {
+        throw std::bad_alloc();
+    }
+    void* buffer = nullptr;
+    auto cached = m_cached.find(size_class);
+    if (cached != m_cached.end() && !cached->second.empty())
+    {
+        buffer = cached->second.back();
+        cached->second.pop_back();
+        m_cached_bytes -= size_class;
+    }
+    else
+    {
+        const bool huge = size_class >= HUGE_PAGE_SIZE;
+        buffer = m_allocator.allocate(size_class, huge ? HUGE_PAGE_SIZE : ALIGNMENT);
+        if (buffer == nullptr)
+        {
+            // Cached buffers of other sizes may be holding the memory.
+            trim(0);
+            buffer = m_allocator.allocate(size_class, huge ? HUGE_PAGE_SIZE : ALIGNMENT);
+            if (buffer == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+        }
+#ifdef MADV_HUGEPAGE
+        if (huge && m_huge_pages)
+        {
+            // This is only advice, so failures are ignored.
+            madvise(buffer, size_class, MADV_HUGEPAGE);
+        }
+#endif
+    }
+    auto usage = m_usage.find((owner != nullptr) ? owner : "");
+    if (usage == m_usage.end())
+    {
+        usage = m_usage.emplace((owner != nullptr) ? owner : "", Usage()).first;
+    }
+    for (Usage* counted : {&usage->second, &m_total_usage})
+    {
+        counted->current += size_class;
+        counted->peak = std::max(counted->peak, counted->current);
+    }
+    m_in_use[buffer] = Origin {size_class, m_allocator, &usage->second};
+    return buffer;
+}
+
+void BufferPool::release(void* buffer)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto origin = m_in_use.find(buffer);
+    if (origin == m_in_use.end())
+    {
+        return;
+    }
+    const Origin released = origin->second;
+    m_in_use.erase(origin);
+    released.usage->current -= released.size_class;
+    m_total_usage.current -= released.size_class;
+    const bool current_allocator = released.allocator.allocate == m_allocator.allocate
+        && released.allocator.deallocate == m_allocator.deallocate;
+    if (current_allocator && m_cached_bytes + released.size_class <= m_capacity)
+    {
+        m_cached[released.size_class].push_back(buffer);
+        m_cached_bytes += released.size_class;
+    }
+    else
+    {
+        released.allocator.deallocate(buffer, released.size_class);
+    }
+}
+
+void BufferPool::trim(size_t capacity)
+{
+    for (auto& cached : m_cached)
+    {
+        while (m_cached_bytes > capacity && !cached.second.empty())
+        {
+            m_allocator.deallocate(cached.second.back(), cached.first);
+            cached.second.pop_back();
+            m_cached_bytes -= cached.first;
+        }
+    }
+}
+
+void BufferPool::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    trim(0);
+}
+
+void BufferPool::setCapacity(size_t capacity)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_capacity = capacity;
+    trim(capacity);
+}
+
+size_t BufferPool::getCapacity() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_capacity;
+}
+
+size_t BufferPool::getCachedBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_cached_bytes;
+}
+
+std::vector<MemoryUsage> BufferPool::getMemoryUsage() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<MemoryUsage> usages;
+    usages.reserve(m_usage.size());
+    for (const auto& usage : m_usage)
+    {
+        usages.push_back(MemoryUsage {usage.first, usage.second.current, usage.second.peak});
+    }
+    return usages;
+}
+
+size_t BufferPool::getBytesInUse() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_total_usage.current;
+}
+
+size_t BufferPool::getPeakBytesInUse() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_total_usage.peak;
+}
+
+void BufferPool::resetPeakMemory()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& usage : m_usage)
+    {
+        usage.second.peak = usage.second.current;
+    }
+    m_total_usage.peak = m_total_usage.current;
+}
+
+void BufferPool::setMemoryBudget(size_t budget)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_budget = budget;
+}
+
+size_t BufferPool::getMemoryBudget() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget;
+}
+
+bool BufferPool::fitsMemoryBudget(size_t bytes) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_budget == 0 || m_total_usage.current + bytes <= m_budget;
+}
+
+void BufferPool::setHugePages(bool huge_pages)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_huge_pages = huge_pages;
+}
+
+void BufferPool::setAllocator(const Allocator& allocator)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    trim(0);
+    m_allocator = allocator;
+}
+
+}; }; // end namespace freud::util
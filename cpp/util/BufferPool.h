@@ -0,0 +1,193 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef BUFFER_POOL_H
+#define BUFFER_POOL_H
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*! \file BufferPool.h
+    \brief Aligned allocation and reuse of the buffers of arrays.
+*/
+
+namespace freud { namespace util {
+
+//! Functions allocating and freeing the memory of buffers.
+struct Allocator
+{
+    //! Allocate bytes aligned to a power of two alignment, returning nullptr on failure.
+    void* (*allocate)(size_t bytes, size_t alignment);
+    //! Free a buffer of bytes returned by allocate.
+    void (*deallocate)(void* buffer, size_t bytes);
+};
+
+//! Bytes of the buffers in use that were allocated for an owner.
+struct MemoryUsage
+{
+    std::string owner; //!< Name of the owner, or "" for buffers allocated without an owner
+    size_t current;    //!< Number of bytes of the buffers in use
+    size_t peak;       //!< Largest number of bytes in use since the last resetPeakMemory
+};
+
+//! Attribution of the buffers allocated in a scope to a named owner, such as a compute.
+/*! Owners nest, and buffers are attributed to the innermost owner of the
+ *  allocating thread. Threads of parallel loops that have no owner of their
+ *  own, e.g. those creating thread local copies of arrays, attribute their
+ *  buffers to the outermost owner of the thread that entered it first, so
+ *  the attribution of their buffers is only approximate while computes run
+ *  concurrently from several threads.
+ */
+class ScopedMemoryOwner
+{
+public:
+    //! Constructor
+    /*! \param owner Name of the owner, which must be a string literal.
+     */
+    explicit ScopedMemoryOwner(const char* owner);
+
+    //! Destructor, restoring the previous owner.
+    ~ScopedMemoryOwner();
+
+    ScopedMemoryOwner(const ScopedMemoryOwner&) = delete;
+    ScopedMemoryOwner& operator=(const ScopedMemoryOwner&) = delete;
+
+    //! Get the owner of the buffers allocated by the calling thread, or nullptr if there is none.
+    static const char* current();
+
+private:
+    const char* m_previous;   //!< Owner of the calling thread before this one
+    bool m_outermost {false}; //!< Whether this is the owner of threads without an owner
+};
+
+//! Process-wide pool of buffers released by arrays, reused by later allocations of a similar size.
+/*! Computes prepare their output arrays on every call, and reallocate them
+ *  whenever the previous arrays are still referenced, e.g. from Python. The
+ *  buffers of arrays are therefore allocated from this pool, and returned to
+ *  it once the last reference to them is released instead of being freed. A
+ *  later allocation of the same size class, which are spaced by at most 25%,
+ *  reuses a cached buffer, so repeated computes of similar sizes do not go
+ *  through the system allocator. At most getCapacity() bytes are cached, and
+ *  buffers beyond the capacity are freed.
+ *
+ *  Buffers are aligned to ALIGNMENT bytes. Buffers of at least
+ *  HUGE_PAGE_SIZE bytes are aligned to HUGE_PAGE_SIZE and, on Linux,
+ *  advised to be backed by transparent huge pages when enabled with
+ *  setHugePages. The memory itself is obtained from an Allocator, which can
+ *  be replaced, e.g. by an arena.
+ */
+class BufferPool
+{
+public:
+    //! Alignment of all buffers in bytes.
+    static constexpr size_t ALIGNMENT = 64;
+
+    //! Size in bytes above which buffers are aligned to huge pages.
+    static constexpr size_t HUGE_PAGE_SIZE = size_t(2) << 20;
+
+    //! Get the pool used by all arrays.
+    static BufferPool& getInstance();
+
+    //! Allocate a buffer of at least bytes bytes, reusing a cached buffer if possible.
+    void* allocate(size_t bytes);
+
+    //! Return a buffer obtained from allocate to the pool.
+    void release(void* buffer);
+
+    //! Free all cached buffers.
+    void clear();
+
+    //! Set the maximum number of bytes of cached buffers, freeing cached buffers beyond it.
+    void setCapacity(size_t capacity);
+
+    //! Get the maximum number of bytes of cached buffers.
+    size_t getCapacity() const;
+
+    //! Get the number of bytes of cached buffers.
+    size_t getCachedBytes() const;
+
+    //! Get the bytes of the buffers in use of each owner, sorted by owner.
+    /*! Owners are recorded by ScopedMemoryOwner. Buffers are counted by their
+     *  allocated size, which is rounded up to their size class.
+     */
+    std::vector<MemoryUsage> getMemoryUsage() const;
+
+    //! Get the number of bytes of all buffers in use.
+    size_t getBytesInUse() const;
+
+    //! Get the largest number of bytes of all buffers in use since the last resetPeakMemory.
+    size_t getPeakBytesInUse() const;
+
+    //! Reset the peak usage of all owners to their current usage.
+    void resetPeakMemory();
+
+    //! Set the maximum number of bytes of buffers in use, or 0 for no limit.
+    /*! Allocations beyond the budget throw std::bad_alloc. Computes whose
+     *  memory-bound modes would not fit in the budget, checked with
+     *  fitsMemoryBudget, switch to modes using less memory instead.
+     */
+    void setMemoryBudget(size_t budget);
+
+    //! Get the maximum number of bytes of buffers in use, or 0 for no limit.
+    size_t getMemoryBudget() const;
+
+    //! Whether buffers of bytes bytes can be allocated in addition to the buffers in use within the budget.
+    bool fitsMemoryBudget(size_t bytes) const;
+
+    //! Set whether buffers of at least HUGE_PAGE_SIZE bytes are advised to use transparent huge pages.
+    void setHugePages(bool huge_pages);
+
+    //! Replace the allocator of new buffers, freeing all cached buffers.
+    /*! Buffers that are still in use are freed by the allocator that
+     *  allocated them once they are released.
+     */
+    void setAllocator(const Allocator& allocator);
+
+    //! Get the default allocator, which uses aligned allocations of the C++ runtime.
+    static Allocator getDefaultAllocator();
+
+private:
+    //! Constructor
+    BufferPool();
+
+    //! Bytes of the buffers in use of an owner.
+    struct Usage
+    {
+        size_t current {0}; //!< Number of bytes in use
+        size_t peak {0};    //!< Largest number of bytes in use
+    };
+
+    //! Size class, allocator and owner of a buffer in use.
+    struct Origin
+    {
+        size_t size_class;   //!< Size class of the buffer in bytes
+        Allocator allocator; //!< Allocator of the buffer
+        Usage* usage;        //!< Usage of the owner of the buffer
+    };
+
+    //! Size class of an allocation of bytes bytes.
+    static size_t sizeClass(size_t bytes);
+
+    //! Free cached buffers until at most capacity bytes are cached. Requires m_mutex to be held.
+    void trim(size_t capacity);
+
+    mutable std::mutex m_mutex;                              //!< Guard of all members
+    std::unordered_map<size_t, std::vector<void*>> m_cached; //!< Cached buffers of each size class
+    std::unordered_map<void*, Origin> m_in_use;              //!< Buffers allocated and not released
+    std::map<std::string, Usage, std::less<>> m_usage;       //!< Usage of each owner, never erased
+    Usage m_total_usage;                                     //!< Usage of all owners
+    size_t m_budget {0};                                     //!< Maximum number of bytes in use
+    size_t m_cached_bytes {0};                               //!< Number of bytes of cached buffers
+    size_t m_capacity {size_t(256) << 20};                   //!< Maximum number of cached bytes
+    bool m_huge_pages {true};                                //!< Whether to advise huge pages
+    Allocator m_allocator;                                   //!< Allocator of new buffers
+};
+
+}; }; // end namespace freud::util
+
+#endif // BUFFER_POOL_H
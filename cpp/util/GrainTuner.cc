@@ -0,0 +1,181 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "GrainTuner.h"
+
+/*! \file GrainTuner.cc
+    \brief Tuning of the grain sizes of parallel loops from the measured run times of their calls.
+*/
+
+namespace freud { namespace util {
+
+struct GrainTuner::Group
+{
+    std::vector<size_t> candidates; //!< Candidate grain sizes
+    std::vector<double> best_times; //!< Smallest run time per item of each candidate
+    unsigned int started {0};       //!< Number of timed calls begun
+    unsigned int finished {0};      //!< Number of timed calls ended
+    size_t grain_size {0};          //!< Tuned grain size, or 0 while tuning
+};
+
+struct GrainTuner::Table
+{
+    //! Groups by the power of two of the number of items and the number of threads
+    std::map<std::pair<unsigned int, unsigned int>, Group> groups;
+};
+
+namespace {
+std::atomic<bool> grain_tuning {true};
+
+//! Guard of the registry and of all its tables.
+std::mutex& registryMutex()
+{
+    static auto* mutex = new std::mutex();
+    return *mutex;
+}
+
+//! Tables of all loops by name, which are never destroyed since tuners are static objects.
+std::map<std::string, GrainTuner::Table>& registry()
+{
+    static auto* tables = new std::map<std::string, GrainTuner::Table>();
+    return *tables;
+}
+
+//! Index of the highest set bit of n > 0.
+unsigned int log2Floor(size_t n)
+{
+    unsigned int log2 = 0;
+    while ((n >>= 1) != 0)
+    {
+        ++log2;
+    }
+    return log2;
+}
+} // namespace
+
+GrainTuner::GrainTuner(const std::string& loop)
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    m_table = &registry()[loop];
+}
+
+GrainTuner::Call GrainTuner::begin(size_t n) const
+{
+    if (n < MIN_TUNED_SIZE)
+    {
+        return {n, 1, nullptr, 0};
+    }
+    const unsigned int log2_size = log2Floor(n);
+    const unsigned int concurrency = getThreadConcurrency();
+    std::lock_guard<std::mutex> lock(registryMutex());
+    Group& group = m_table->groups[{log2_size, concurrency}];
+    if (group.grain_size != 0)
+    {
+        return {n, group.grain_size, nullptr, 0};
+    }
+    if (!getGrainTuning())
+    {
+        return {n, 1, nullptr, 0};
+    }
+    if (group.candidates.empty())
+    {
+        // Powers of four up to the grain size of one range per thread.
+        for (size_t grain_size = 1; grain_size * concurrency <= (size_t(1) << log2_size); grain_size *= 4)
+        {
+            group.candidates.push_back(grain_size);
+        }
+        group.best_times.assign(group.candidates.size(), std::numeric_limits<double>::infinity());
+    }
+    if (group.started >= group.candidates.size() * TRIALS)
+    {
+        // The last timed calls have not ended yet.
+        return {n, 1, nullptr, 0};
+    }
+    // The candidates are interleaved so that changes of the load of the
+    // machine during tuning affect all of them.
+    const auto candidate = static_cast<unsigned int>(group.started % group.candidates.size());
+    ++group.started;
+    return {n, group.candidates[candidate], &group, candidate};
+}
+
+void GrainTuner::end(const Call& call, double seconds) const
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    Group& group = *call.group;
+    // The group may have been reset by setTunedGrainSizes since the call began.
+    if (group.grain_size != 0 || call.candidate >= group.best_times.size() || group.finished >= group.started)
+    {
+        return;
+    }
+    double& best_time = group.best_times[call.candidate];
+    best_time = std::min(best_time, seconds / static_cast<double>(call.size));
+    ++group.finished;
+    if (group.finished == group.candidates.size() * TRIALS)
+    {
+        const auto best = std::min_element(group.best_times.begin(), group.best_times.end());
+        group.grain_size = group.candidates[best - group.best_times.begin()];
+    }
+}
+
+std::vector<TunedGrainSize> getTunedGrainSizes()
+{
+    std::lock_guard<std::mutex> lock(registryMutex());
+    std::vector<TunedGrainSize> grain_sizes;
+    for (const auto& table : registry())
+    {
+        for (const auto& group : table.second.groups)
+        {
+            if (group.second.grain_size != 0)
+            {
+                grain_sizes.push_back(
+                    {table.first, group.first.first, group.first.second, group.second.grain_size});
+            }
+        }
+    }
+    return grain_sizes;
+}
+
+void setTunedGrainSizes(const std::vector<TunedGrainSize>& grain_sizes)
+{
+    for (const auto& grain_size : grain_sizes)
+    {
+        if (grain_size.grain_size == 0 || grain_size.concurrency == 0)
+        {
+            throw std::invalid_argument("Tuned grain sizes and numbers of threads must be positive.");
+        }
+    }
+    std::lock_guard<std::mutex> lock(registryMutex());
+    // Groups are reset rather than erased, since timed calls may point to them.
+    for (auto& table : registry())
+    {
+        for (auto& group : table.second.groups)
+        {
+            group.second = GrainTuner::Group();
+        }
+    }
+    for (const auto& grain_size : grain_sizes)
+    {
+        registry()[grain_size.loop].groups[{grain_size.log2_size, grain_size.concurrency}].grain_size
+            = grain_size.grain_size;
+    }
+}
+
+bool getGrainTuning()
+{
+    return grain_tuning.load(std::memory_order_relaxed);
+}
+
+void setGrainTuning(bool tune)
+{
+    grain_tuning.store(tune, std::memory_order_relaxed);
+}
+
+}; }; // end namespace freud::util
@@ -0,0 +1,113 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef GRAIN_TUNER_H
+#define GRAIN_TUNER_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "utils.h"
+
+/*! \file GrainTuner.h
+    \brief Tuning of the grain sizes of parallel loops from the measured run times of their calls.
+*/
+
+namespace freud { namespace util {
+
+//! Grain size tuned for the calls of a loop with a range of sizes and a number of threads.
+struct TunedGrainSize
+{
+    std::string loop;         //!< Name of the loop
+    unsigned int log2_size;   //!< Calls have between 2^log2_size and 2^(log2_size + 1) items
+    unsigned int concurrency; //!< Number of threads of the calls
+    size_t grain_size;        //!< Tuned grain size
+};
+
+//! Get the grain sizes tuned so far, e.g. to restore them with setTunedGrainSizes in another process.
+std::vector<TunedGrainSize> getTunedGrainSizes();
+
+//! Replace all tuned grain sizes with grain_sizes.
+void setTunedGrainSizes(const std::vector<TunedGrainSize>& grain_sizes);
+
+//! Get whether loops without a tuned grain size for their size and number of threads are tuned.
+bool getGrainTuning();
+
+//! Set whether loops without a tuned grain size for their size and number of threads are tuned.
+void setGrainTuning(bool tune);
+
+//! Tuner of the grain size of a parallel loop of items of cheap and uniform cost.
+/*! The chunking of such loops strongly affects their run time, which is
+ *  dominated by the overhead of scheduling for too small ranges and by the
+ *  imbalance of the threads for too large ones. A tuner is a static object
+ *  of a loop, used with the forLoopWrapper overload below. The calls of a
+ *  loop are grouped by the power of two of their number of items and by the
+ *  number of threads, and the first calls of each group are run with grain
+ *  sizes of increasing powers of four, each a few times. The grain size with
+ *  the smallest run time is then used by all later calls of the group.
+ *  Calls of fewer than MIN_TUNED_SIZE items are not timed.
+ */
+class GrainTuner
+{
+public:
+    //! Number of items below which calls are not tuned.
+    static constexpr size_t MIN_TUNED_SIZE = 1024;
+
+    //! Number of timed calls of each candidate grain size.
+    static constexpr unsigned int TRIALS = 3;
+
+    //! Candidate grain sizes and run times of the calls of a group.
+    struct Group;
+
+    //! Groups of the calls of a loop.
+    struct Table;
+
+    //! Constructor
+    /*! \param loop Unique name of the loop, used as the key of its tuned grain sizes.
+     */
+    explicit GrainTuner(const std::string& loop);
+
+    //! A call of the loop, which is timed if its grain size is being tuned.
+    struct Call
+    {
+        size_t size;            //!< Number of items of the call
+        size_t grain_size;      //!< Grain size of the call
+        Group* group;           //!< Group of the timed call, or nullptr if it is not timed
+        unsigned int candidate; //!< Index of the candidate grain size of the call
+    };
+
+    //! Get the grain size of a call of n items.
+    Call begin(size_t n) const;
+
+    //! Record the run time of a call returned by begin.
+    void end(const Call& call, double seconds) const;
+
+private:
+    Table* m_table; //!< Groups of the calls of the loop, owned by the registry of all loops
+};
+
+//! Wrapper for for-loop with a tuned grain size.
+/*! \param begin Beginning index.
+ *  \param end Ending index.
+ *  \param body An object with operator(size_t begin, size_t end).
+ *  \param tuner Tuner of the grain size of the loop.
+ */
+template<typename Body>
+inline void forLoopWrapper(size_t begin, size_t end, const Body& body, const GrainTuner& tuner)
+{
+    const GrainTuner::Call call = tuner.begin(end - begin);
+    if (call.group == nullptr)
+    {
+        forLoopWrapper(begin, end, body, LoopSchedule {call.grain_size});
+        return;
+    }
+    const auto start = std::chrono::steady_clock::now();
+    forLoopWrapper(begin, end, body, LoopSchedule {call.grain_size});
+    tuner.end(call, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+}
+
+}; }; // end namespace freud::util
+
+#endif // GRAIN_TUNER_H
@@ -4,17 +4,24 @@
 #ifndef HISTOGRAM_H
 #define HISTOGRAM_H
 
+#include <atomic>
 #include <memory>
+#include <tuple>
 #include <utility>
 #include <vector>
 #ifdef __SSE2__
 #include <emmintrin.h>
 #endif
 #include <sstream>
+#include <stdexcept>
 #include <tbb/enumerable_thread_specific.h>
-#include <utility>
+#include <tbb/parallel_sort.h>
+#include <type_traits>
+#include <unordered_map>
 
+#include "Instrumentation.h"
 #include "ManagedArray.h"
+#include "ThreadStorage.h"
 #include "utils.h"
 
 namespace freud { namespace util {
@@ -177,6 +184,98 @@ protected:
 
 using Axes = std::vector<std::shared_ptr<Axis>>;
 
+//! Storage of the bin counts accumulated by a ThreadLocalHistogram.
+enum class BinStorage
+{
+    copies, //!< A full copy of the histogram on each thread.
+    shared, //!< A single array of bin counts shared by all threads and incremented atomically.
+    sparse, //!< A hash map of the occupied bins on each thread.
+    blocks  //!< A copy of the bin counts on each thread that tracks its written blocks of bins.
+};
+
+//! Concrete copies of the axes of a histogram whose types are known at compile time.
+/*! Histogram stores its axes behind pointers to the Axis base class and bins
+ * a set of values through virtual calls and temporary vectors, since its
+ * dimensionality is only known at runtime. Computes that know the types of
+ * their axes can instead bin through a StaticAxes object, for example
+ * StaticAxes<RegularAxis, RegularAxis> for a 2D histogram of regular axes.
+ * The bin along each axis is then computed with non-virtual calls that can be
+ * inlined, and the linear bin is combined without any heap allocation. The
+ * linear bins are identical to those of Histogram::bin and can be passed to
+ * Histogram::increment.
+ */
+template<typename... AxisTypes> class StaticAxes
+{
+public:
+    //! Constructor copying the axes of a histogram.
+    /*! \param axes The axes of the histogram, which must have the types AxisTypes.
+     */
+    explicit StaticAxes(const Axes& axes) : StaticAxes(axes, std::index_sequence_for<AxisTypes...>()) {}
+
+    //! Find the linear bin of a value with one component for each axis.
+    /*! \return The linear index of the bin, or Axis::OVERFLOW_BIN if any
+     *          component is out of the bounds of its axis.
+     */
+    template<typename... Floats> size_t bin(Floats... values) const
+    {
+        static_assert(sizeof...(Floats) == sizeof...(AxisTypes),
+                      "StaticAxes::bin requires one value for each axis.");
+        return binAxes(std::index_sequence_for<AxisTypes...>(), static_cast<float>(values)...);
+    }
+
+private:
+    //! Construct the copies of the axes given the index of each axis.
+    template<size_t... I>
+    StaticAxes(const Axes& axes, std::index_sequence<I...> /*indices*/)
+        : m_axes(castAxis<AxisTypes>(axes, I)...)
+    {}
+
+    //! Cast an axis of a histogram to its concrete type.
+    template<typename AxisType> static const AxisType& castAxis(const Axes& axes, size_t index)
+    {
+        if (axes.size() != sizeof...(AxisTypes))
+        {
+            std::ostringstream msg;
+            msg << "StaticAxes has " << sizeof...(AxisTypes) << " axes, but the histogram has "
+                << axes.size() << " axes." << std::endl;
+            throw std::invalid_argument(msg.str());
+        }
+        const auto* axis = dynamic_cast<const AxisType*>(axes[index].get());
+        if (axis == nullptr)
+        {
+            throw std::invalid_argument("The axes of the histogram do not match the types of StaticAxes.");
+        }
+        return *axis;
+    }
+
+    //! Combine the bins along all axes into a linear bin in row-major order.
+    template<size_t... I, typename... Floats>
+    size_t binAxes(std::index_sequence<I...> /*indices*/, Floats... values) const
+    {
+        size_t value_bin = 0;
+        // The fold stops at the first value that is out of bounds.
+        const bool in_bounds = (binAxis<I>(values, value_bin) && ...);
+        return in_bounds ? value_bin : Axis::OVERFLOW_BIN;
+    }
+
+    //! Add the bin of a value along axis I to a linear bin, returning false if it is out of bounds.
+    template<size_t I> bool binAxis(float value, size_t& value_bin) const
+    {
+        using AxisType = std::tuple_element_t<I, std::tuple<AxisTypes...>>;
+        const AxisType& axis = std::get<I>(m_axes);
+        // The qualified call is not dispatched virtually.
+        const size_t axis_bin = axis.AxisType::bin(value);
+        if (axis_bin == Axis::OVERFLOW_BIN)
+        {
+            return false;
+        }
+        value_bin = value_bin * axis.size() + axis_bin;
+        return true;
+    }
+
+    std::tuple<AxisTypes...> m_axes; //!< Copies of the axes.
+};
+
 //! An n-dimensional histogram class.
 /*! The Histogram is designed to simplify the most common use of histograms in
  * C++ code, which is looping over a series of values and then binning them. To
@@ -200,15 +299,57 @@ public:
      * local copies all share the same axes (because the axes are stored as
      * arrays of shared_ptrs in the Histogram class). This should cause no
      * problems, but can be refactored if needed.
+     *
+     * Since the memory used by the copies grows with the number of threads,
+     * histograms with many bins may instead be accumulated into a single
+     * array of bin counts shared by all threads, whose bins are incremented
+     * atomically. Bonds rarely fall into the same bin at the same time in
+     * large histograms, so the atomic increments are cheap, and the reduction
+     * is a copy of the shared array. Histograms whose bins are mostly empty
+     * may be accumulated into a hash map of the occupied bins on each thread
+     * instead, which are reduced into the sorted occupied bins by
+     * reduceIntoSparse. Histograms whose bonds only reach a part of the bins
+     * from each thread may be accumulated into copies of the bin counts that
+     * record their written blocks of bins, so that reset() and reduceInto()
+     * skip the blocks that no thread wrote and join the threads pairwise. In
+     * these modes, local() may not be used.
      */
     class ThreadLocalHistogram
     {
     public:
         ThreadLocalHistogram() = default;
 
-        explicit ThreadLocalHistogram(const Histogram& histogram)
-            : m_local_histograms([histogram]() { return Histogram(histogram.m_axes); })
-        {}
+        //! Constructor
+        /*! \param histogram The histogram to accumulate.
+         *  \param storage The storage of the accumulated bin counts. Shared
+         *         storage is only supported for arithmetic types T.
+         */
+        explicit ThreadLocalHistogram(const Histogram& histogram, BinStorage storage = BinStorage::copies)
+            : m_local_histograms([axes = histogram.m_axes]() { return Histogram(axes); }), m_storage(storage)
+        {
+            // Only the axes are captured, since a copy of the histogram would
+            // keep its bin counts alive and force their reallocation on reduction.
+            if (m_storage != BinStorage::copies)
+            {
+                m_axes = histogram.m_axes;
+            }
+            if (m_storage == BinStorage::blocks)
+            {
+                m_block_counts = ThreadStorage<T>(histogram.getAxisSizes(), true);
+            }
+            if (m_storage == BinStorage::shared)
+            {
+                if constexpr (std::is_arithmetic<T>::value)
+                {
+                    m_shared_counts = std::make_shared<std::vector<std::atomic<T>>>(histogram.size());
+                }
+                else
+                {
+                    throw std::invalid_argument(
+                        "Shared bin counts are only supported for histograms of arithmetic types.");
+                }
+            }
+        }
 
         using const_iterator = typename tbb::enumerable_thread_specific<Histogram<T>>::const_iterator;
         using iterator = typename tbb::enumerable_thread_specific<Histogram>::iterator;
@@ -236,33 +377,157 @@ public:
 
         reference local()
         {
+            if (m_storage != BinStorage::copies)
+            {
+                throw std::runtime_error(
+                    "This ThreadLocalHistogram does not store a copy of the histogram on each thread.");
+            }
             return m_local_histograms.local();
         }
 
+        //! Accumulate the contributions of the items in [begin, end) into the local histograms in parallel.
+        /*! This is the analog of ThreadStorage::accumulate for histograms
+         *  stored as copies, whose result of reduceInto does not depend on
+         *  the scheduling or the number of threads with deterministic
+         *  reductions.
+         *
+         *  \param begin Beginning index.
+         *  \param end Ending index.
+         *  \param body An object with operator(size_t begin, size_t end, Histogram& histogram) adding the
+         *         contributions of the items in [begin, end) to histogram.
+         *  \param grain_size Maximum number of items of the ranges of deterministic reductions.
+         */
+        template<typename Body>
+        void accumulate(size_t begin, size_t end, const Body& body,
+                        size_t grain_size = util::DETERMINISTIC_GRAIN_SIZE)
+        {
+            if (!util::getDeterministicReductions())
+            {
+                util::forLoopWrapper(begin, end, [&](size_t range_begin, size_t range_end) {
+                    body(range_begin, range_end, local());
+                });
+                return;
+            }
+
+            Histogram& total = local();
+            const Histogram sum = util::deterministicReduce(
+                begin, end, [&total]() { return Histogram(total.getAxes()); }, body,
+                [](Histogram& left, const Histogram& right) { left.add(right); }, grain_size);
+            total.add(sum);
+        }
+
+        //! Get the storage of the accumulated bin counts.
+        BinStorage getStorage() const
+        {
+            return m_storage;
+        }
+
         void reset()
         {
             for (auto hist = m_local_histograms.begin(); hist != m_local_histograms.end(); ++hist)
             {
                 hist->reset();
             }
+            for (auto counts = m_sparse_counts.begin(); counts != m_sparse_counts.end(); ++counts)
+            {
+                counts->clear();
+            }
+            if (m_storage == BinStorage::blocks)
+            {
+                m_block_counts.reset();
+            }
+            if constexpr (std::is_arithmetic<T>::value)
+            {
+                if (m_storage == BinStorage::shared)
+                {
+                    auto& shared_counts = *m_shared_counts;
+                    util::forLoopWrapper(0, shared_counts.size(), [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            shared_counts[i].store(0, std::memory_order_relaxed);
+                        }
+                    });
+                }
+            }
         }
 
         //! Dispatch to thread local histogram.
         template<typename... FloatsOrWeight> void operator()(FloatsOrWeight... values)
         {
+            if (m_storage != BinStorage::copies)
+            {
+                const auto value_bin = Histogram::binValues(m_axes, values...);
+                increment(value_bin.first, value_bin.second.value);
+                return;
+            }
             m_local_histograms.local()(values...);
         }
 
         //! Dispatch to thread local histogram.
         void increment(size_t value_bin, T weight = 1)
         {
+            if (m_storage != BinStorage::copies)
+            {
+                // Check for sentinel to avoid overflow.
+                if (value_bin == Axis::OVERFLOW_BIN)
+                {
+                    return;
+                }
+                if constexpr (std::is_arithmetic<T>::value)
+                {
+                    if (m_storage == BinStorage::shared)
+                    {
+                        incrementShared((*m_shared_counts)[value_bin], weight);
+                        return;
+                    }
+                }
+                if (m_storage == BinStorage::blocks)
+                {
+                    m_block_counts.localTracked()[value_bin] += weight;
+                    return;
+                }
+                m_sparse_counts.local()[value_bin] += weight;
+                return;
+            }
             m_local_histograms.local().increment(value_bin, weight);
         }
 
         // Reduce over histograms into the result array.
         void reduceInto(ManagedArray<T>& result)
         {
+            // The shared bin counts only exist for arithmetic types, and
+            // atomic operations on other types may require libatomic.
+            if constexpr (std::is_arithmetic<T>::value)
+            {
+                if (m_storage == BinStorage::shared)
+                {
+                    const auto& shared_counts = *m_shared_counts;
+                    util::forLoopWrapper(0, result.size(), [&](size_t begin, size_t end) {
+                        for (size_t i = begin; i < end; ++i)
+                        {
+                            result[i] = shared_counts[i].load(std::memory_order_relaxed);
+                        }
+                    });
+                    return;
+                }
+            }
             result.reset();
+            if (m_storage == BinStorage::blocks)
+            {
+                m_block_counts.reduceInto(result);
+                return;
+            }
+            if (m_storage == BinStorage::sparse)
+            {
+                for (auto counts = m_sparse_counts.begin(); counts != m_sparse_counts.end(); ++counts)
+                {
+                    for (const auto& bin_count : *counts)
+                    {
+                        result[bin_count.first] += bin_count.second;
+                    }
+                }
+                return;
+            }
             util::forLoopWrapper(0, result.size(), [&](size_t begin, size_t end) {
                 for (size_t i = begin; i < end; ++i)
                 {
@@ -274,21 +539,86 @@ public:
             });
         }
 
+        //! Reduce the sparse bin counts of all threads into the occupied bins.
+        /*! \param bins The linear indices of the occupied bins in increasing order.
+         *  \param counts The bin counts of the occupied bins.
+         */
+        void reduceIntoSparse(std::vector<size_t>& bins, std::vector<T>& counts)
+        {
+            if (m_storage != BinStorage::sparse)
+            {
+                throw std::runtime_error("This ThreadLocalHistogram does not store sparse bin counts.");
+            }
+            std::vector<std::pair<size_t, T>> bin_counts;
+            for (auto local_counts = m_sparse_counts.begin(); local_counts != m_sparse_counts.end();
+                 ++local_counts)
+            {
+                bin_counts.insert(bin_counts.end(), local_counts->begin(), local_counts->end());
+            }
+            util::executeInThreadArena([&]() {
+                tbb::parallel_sort(bin_counts.begin(), bin_counts.end(),
+                                   [](const auto& a, const auto& b) { return a.first < b.first; });
+            });
+
+            // Bins occupied on several threads are adjacent after sorting.
+            bins.clear();
+            counts.clear();
+            for (const auto& bin_count : bin_counts)
+            {
+                if (!bins.empty() && bins.back() == bin_count.first)
+                {
+                    counts.back() += bin_count.second;
+                }
+                else
+                {
+                    bins.push_back(bin_count.first);
+                    counts.push_back(bin_count.second);
+                }
+            }
+        }
+
     protected:
         tbb::enumerable_thread_specific<Histogram<T>>
             m_local_histograms; //!< The thread-local copies of m_histogram.
+        BinStorage m_storage {BinStorage::copies}; //!< Storage of the accumulated bin counts.
+        std::vector<std::shared_ptr<Axis>> m_axes; //!< The axes, used to bin values without local copies.
+        std::shared_ptr<std::vector<std::atomic<T>>>
+            m_shared_counts; //!< Bin counts shared by all threads for shared storage.
+        tbb::enumerable_thread_specific<std::unordered_map<size_t, T>>
+            m_sparse_counts; //!< Occupied bins on each thread for sparse storage.
+        ThreadStorage<T> m_block_counts; //!< Bin counts on each thread for block storage.
+
+        //! Atomically add a weight to a shared bin count.
+        static void incrementShared(std::atomic<T>& count, T weight)
+        {
+            if constexpr (std::is_integral<T>::value)
+            {
+                count.fetch_add(weight, std::memory_order_relaxed);
+            }
+            else
+            {
+                T expected = count.load(std::memory_order_relaxed);
+                while (!count.compare_exchange_weak(expected, expected + weight, std::memory_order_relaxed))
+                {}
+            }
+        }
     };
 
     //! Default constructor
     Histogram() = default;
 
     //! Constructor
-    explicit Histogram(std::vector<std::shared_ptr<Axis>> axes) : m_axes(std::move(axes))
+    /*! \param axes The axes of the histogram.
+     *  \param allocate Whether to allocate the bin counts. Histograms that are
+     *         only accumulated with sparse storage do not need them.
+     */
+    explicit Histogram(std::vector<std::shared_ptr<Axis>> axes, bool allocate = true)
+        : m_axes(std::move(axes))
     {
-        std::vector<size_t> sizes(m_axes.size());
-        std::transform(m_axes.begin(), m_axes.end(), sizes.begin(),
-                       [](const auto& ax) { return ax->size(); });
-        m_bin_counts = ManagedArray<T>(sizes);
+        if (allocate)
+        {
+            m_bin_counts = ManagedArray<T>(getAxisSizes());
+        }
     }
 
     //! Simple convenience for 1D arrays that calls through to the shape based `prepare` function.
@@ -313,15 +643,13 @@ public:
     ~Histogram() = default;
 
     //! Bin value and update the histogram count.
+    /*! The values are binned one axis at a time into a linear bin, so no
+     *  temporary vectors are created.
+     */
     template<typename... FloatsOrWeight> void operator()(FloatsOrWeight... values)
     {
-        std::pair<std::vector<float>, Weight<T>> value_vector = getValueVector(values...);
-        size_t value_bin = bin(value_vector.first);
-        // Check for sentinel to avoid overflow.
-        if (value_bin != Axis::OVERFLOW_BIN)
-        {
-            m_bin_counts[value_bin] += value_vector.second.value;
-        }
+        const auto value_bin = binValues(m_axes, values...);
+        increment(value_bin.first, value_bin.second.value);
     }
 
     //! Increment specified linear bin (with a specified weight if desired).
@@ -334,6 +662,17 @@ public:
         }
     }
 
+    //! Add the bin counts of a histogram with the same axes to this histogram.
+    void add(const Histogram& other)
+    {
+        T* counts = m_bin_counts.get();
+        const T* other_counts = other.m_bin_counts.get();
+        for (size_t i = 0; i < m_bin_counts.size(); ++i)
+        {
+            counts[i] += other_counts[i];
+        }
+    }
+
     //! Find the bin of a value.
     /*! Bins are first computed along each axis of the histogram. These bins
      *  are then combined into a single linear index using the underlying
@@ -447,6 +786,7 @@ public:
     template<typename ComputeFunction>
     void reduceOverThreadsPerBin(ThreadLocalHistogram& local_histograms, const ComputeFunction& cf)
     {
+        const ScopedPhase phase("reduceOverThreads");
         local_histograms.reduceInto(m_bin_counts);
         util::forLoopWrapper(0, m_bin_counts.size(), [&](size_t begin, size_t end) {
             for (size_t i = begin; i < end; ++i)
@@ -492,42 +832,57 @@ protected:
     std::vector<std::shared_ptr<Axis>> m_axes; //!< The axes.
     ManagedArray<T> m_bin_counts;              //!< Counts for each bin
 
-    //! The base case for type float when constructing a vector of values provided to operator().
-    /*! This function and the accompanying recursive function below employ
-     * variadic templating to accept an arbitrary set of float values and
-     * construct a vector out of them.
+    //! Find the linear bin and weight of the values provided to operator().
+    /*! \return The linear bin, or Axis::OVERFLOW_BIN if any value is out of
+     *          bounds, and the weight.
      */
-    std::pair<std::vector<float>, Weight<T>> getValueVector(float value) const
-    {
-        return {{value}, Weight<T>()};
+    template<typename... FloatsOrWeight>
+    static std::pair<size_t, Weight<T>> binValues(const std::vector<std::shared_ptr<Axis>>& axes,
+                                                  FloatsOrWeight... values)
+    {
+        size_t value_bin = 0;
+        unsigned int n_values = 0;
+        bool in_bounds = true;
+        Weight<T> weight;
+        (binValue(axes, values, value_bin, n_values, in_bounds, weight), ...);
+        if (n_values != axes.size())
+        {
+            std::ostringstream msg;
+            msg << "This Histogram is " << axes.size() << "-dimensional, but " << n_values
+                << " values were provided in bin" << std::endl;
+            throw std::invalid_argument(msg.str());
+        }
+        return {in_bounds ? value_bin : Axis::OVERFLOW_BIN, weight};
     }
 
-    //! The base case for type Weight when constructing a vector of values provided to operator().
-    /*! This function and the accompanying recursive function below employ
-     * variadic templating to accept an arbitrary set of float values and
-     * construct a vector out of them.
+    //! Add the bin of a value along the next axis to a linear bin in row-major order.
+    /*! This function and the overload for Weight below are applied to each
+     *  argument of operator() in order.
      */
-    std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight) const
+    static void binValue(const std::vector<std::shared_ptr<Axis>>& axes, float value, size_t& value_bin,
+                         unsigned int& n_values, bool& in_bounds, Weight<T>& /*weight*/)
     {
-        return {{}, weight};
-    }
-
-    //! The recursive case for constructing a vector of values (see base-case function docs).
-    template<typename... FloatsOrWeight>
-    std::pair<std::vector<float>, Weight<T>> getValueVector(float value, FloatsOrWeight... values) const
-    {
-        std::pair<std::vector<float>, Weight<T>> tmp = getValueVector(values...);
-        tmp.first.insert(tmp.first.begin(), value);
-        return tmp;
+        if (in_bounds && n_values < axes.size())
+        {
+            const size_t axis_bin = axes[n_values]->bin(value);
+            if (axis_bin == Axis::OVERFLOW_BIN)
+            {
+                in_bounds = false;
+            }
+            else
+            {
+                value_bin = value_bin * axes[n_values]->size() + axis_bin;
+            }
+        }
+        ++n_values;
     }
 
-    //! The recursive case for constructing a vector of values (see base-case function docs).
-    template<typename... FloatsOrWeight>
-    std::pair<std::vector<float>, Weight<T>> getValueVector(Weight<T> weight, FloatsOrWeight... values) const
+    //! Set the weight of a value provided to operator() (see the float overload).
+    static void binValue(const std::vector<std::shared_ptr<Axis>>& /*axes*/, Weight<T> value_weight,
+                         size_t& /*value_bin*/, unsigned int& /*n_values*/, bool& /*in_bounds*/,
+                         Weight<T>& weight)
     {
-        std::pair<std::vector<float>, Weight<T>> tmp = getValueVector(values...);
-        tmp.second = weight;
-        return tmp;
+        weight = value_weight;
     }
 };
 
@@ -0,0 +1,120 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef INDEX_BIMAP_H
+#define INDEX_BIMAP_H
+
+#include <climits>
+#include <map>
+
+#include "SmallVector.h"
+
+/*! \file IndexBiMap.h
+    \brief A one-to-one mapping between two sets of indices stored in flat arrays.
+*/
+
+namespace freud { namespace util {
+
+//! A one-to-one mapping between left and right indices.
+/*! The mapping is stored as two flat arrays indexed by the left and right
+ *  indices, so lookups in either direction are constant time. The arrays
+ *  hold up to INLINE_SIZE indices inline, so mappings between the vectors of
+ *  small local environments are created and copied without heap allocations.
+ *  Larger mappings fall back to heap storage.
+ */
+class IndexBiMap
+{
+public:
+    //! Value returned for indices that are not mapped.
+    static constexpr unsigned int INVALID_INDEX = UINT_MAX;
+
+    //! Number of indices on each side stored without heap allocations.
+    static constexpr size_t INLINE_SIZE = 32;
+
+    //! Constructor
+    IndexBiMap() = default;
+
+    //! Add the pair (left, right) if neither index is mapped yet.
+    /*! \return Whether the pair was added.
+     */
+    bool emplace(unsigned int left, unsigned int right)
+    {
+        if (getRight(left) != INVALID_INDEX || getLeft(right) != INVALID_INDEX)
+        {
+            return false;
+        }
+        if (left >= m_right_of_left.size())
+        {
+            m_right_of_left.resize(left + 1, INVALID_INDEX);
+        }
+        if (right >= m_left_of_right.size())
+        {
+            m_left_of_right.resize(right + 1, INVALID_INDEX);
+        }
+        m_right_of_left[left] = right;
+        m_left_of_right[right] = left;
+        ++m_size;
+        return true;
+    }
+
+    //! Get the right index mapped to a left index, or INVALID_INDEX.
+    unsigned int getRight(unsigned int left) const
+    {
+        return (left < m_right_of_left.size()) ? m_right_of_left[left] : INVALID_INDEX;
+    }
+
+    //! Get the left index mapped to a right index, or INVALID_INDEX.
+    unsigned int getLeft(unsigned int right) const
+    {
+        return (right < m_left_of_right.size()) ? m_left_of_right[right] : INVALID_INDEX;
+    }
+
+    //! Get one more than the largest left index that may be mapped.
+    size_t getLeftExtent() const
+    {
+        return m_right_of_left.size();
+    }
+
+    //! Remove all pairs.
+    void clear()
+    {
+        m_right_of_left.clear();
+        m_left_of_right.clear();
+        m_size = 0;
+    }
+
+    //! Whether no pairs are mapped.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    //! Get the number of mapped pairs.
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    //! Return a std::map from left to right indices equivalent to this object.
+    std::map<unsigned int, unsigned int> asMap() const
+    {
+        std::map<unsigned int, unsigned int> ret;
+        for (unsigned int left = 0; left < m_right_of_left.size(); ++left)
+        {
+            if (m_right_of_left[left] != INVALID_INDEX)
+            {
+                ret[left] = m_right_of_left[left];
+            }
+        }
+        return ret;
+    }
+
+private:
+    SmallVector<unsigned int, INLINE_SIZE> m_right_of_left; //!< Right index of each left index
+    SmallVector<unsigned int, INLINE_SIZE> m_left_of_right; //!< Left index of each right index
+    size_t m_size {0};                                      //!< Number of mapped pairs
+};
+
+}; }; // end namespace freud::util
+
+#endif // INDEX_BIMAP_H
@@ -0,0 +1,120 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <atomic>
+#include <map>
+#include <mutex>
+#ifdef FREUD_ITT
+#include <ittnotify.h>
+#endif
+
+#include "Instrumentation.h"
+
+/*! \file Instrumentation.cc
+    \brief Timers of the phases of computes.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+std::atomic<bool> instrumentation {false};
+std::atomic<size_t> allocated_bytes {0};
+thread_local ScopedPhase* current_phase = nullptr;
+
+//! Statistics of all phases, indexed by their path.
+struct PhaseRegistry
+{
+    std::mutex mutex;
+    std::map<std::string, PhaseStatistics> phases;
+};
+
+PhaseRegistry& getRegistry()
+{
+    // The registry is never destroyed, since phases may end during exit.
+    static auto* registry = new PhaseRegistry();
+    return *registry;
+}
+
+#ifdef FREUD_ITT
+__itt_domain* getIttDomain()
+{
+    static __itt_domain* domain = __itt_domain_create("freud");
+    return domain;
+}
+#endif
+} // namespace
+
+bool getInstrumentation()
+{
+    return instrumentation.load(std::memory_order_relaxed);
+}
+
+void setInstrumentation(bool enable)
+{
+    instrumentation.store(enable, std::memory_order_relaxed);
+}
+
+std::vector<PhaseStatistics> getPhaseStatistics()
+{
+    PhaseRegistry& registry = getRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    std::vector<PhaseStatistics> statistics;
+    statistics.reserve(registry.phases.size());
+    for (const auto& phase : registry.phases)
+    {
+        statistics.push_back(phase.second);
+    }
+    return statistics;
+}
+
+void resetPhaseStatistics()
+{
+    PhaseRegistry& registry = getRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.phases.clear();
+}
+
+void recordAllocation(size_t bytes)
+{
+    if (getInstrumentation())
+    {
+        allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+}
+
+void ScopedPhase::begin(const char* name)
+{
+    m_active = true;
+    m_parent = current_phase;
+    m_path = (m_parent == nullptr) ? std::string(name) : m_parent->m_path + "/" + name;
+    current_phase = this;
+#ifdef FREUD_ITT
+    __itt_task_begin(getIttDomain(), __itt_null, __itt_null, __itt_string_handle_create(name));
+#endif
+    m_bytes = allocated_bytes.load(std::memory_order_relaxed);
+    m_start = std::chrono::steady_clock::now();
+}
+
+void ScopedPhase::end()
+{
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_start).count();
+    const size_t bytes = allocated_bytes.load(std::memory_order_relaxed) - m_bytes;
+#ifdef FREUD_ITT
+    __itt_task_end(getIttDomain());
+#endif
+    current_phase = m_parent;
+
+    PhaseRegistry& registry = getRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    auto phase = registry.phases.find(m_path);
+    if (phase == registry.phases.end())
+    {
+        phase = registry.phases.emplace(m_path, PhaseStatistics {m_path, 0, 0, 0, 0}).first;
+    }
+    phase->second.calls += 1;
+    phase->second.seconds += seconds;
+    phase->second.bonds += m_bonds;
+    phase->second.bytes += bytes;
+}
+
+}; }; // end namespace freud::util
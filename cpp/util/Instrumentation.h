@@ -0,0 +1,118 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/*! \file Instrumentation.h
+    \brief Timers of the phases of computes.
+*/
+
+namespace freud { namespace util {
+
+//! Accumulated statistics of a phase of the computes.
+struct PhaseStatistics
+{
+    std::string phase; //!< Names of the enclosing phases and of the phase, separated by '/'
+    size_t calls;      //!< Number of runs of the phase
+    double seconds;    //!< Total wall time of the runs in seconds
+    size_t bonds;      //!< Number of neighbor bonds found or looped over in the runs
+    size_t bytes;      //!< Number of bytes of arrays allocated by all threads during the runs
+};
+
+//! Get whether the phases of computes are timed.
+bool getInstrumentation();
+
+//! Set whether the phases of computes are timed.
+/*! Instrumentation is disabled by default. Builds with
+ *  FREUD_DISABLE_INSTRUMENTATION never time phases, and builds with FREUD_ITT
+ *  also annotate the timed phases as ITT tasks, e.g. for VTune.
+ */
+void setInstrumentation(bool enable);
+
+//! Get the statistics of all phases timed since the last resetPhaseStatistics, sorted by phase.
+std::vector<PhaseStatistics> getPhaseStatistics();
+
+//! Discard the statistics of all phases.
+void resetPhaseStatistics();
+
+//! Count an allocation of bytes bytes towards the phases running while instrumentation is enabled.
+void recordAllocation(size_t bytes);
+
+//! Timer of a run of a phase, from its construction to its destruction.
+/*! A phase constructed while another phase is running on the same thread is
+ *  nested in it, and its statistics are recorded under the names of both.
+ *  Phases should be constructed on the calling thread of a compute rather
+ *  than in the bodies of parallel loops, since every run locks the
+ *  statistics of all phases. If instrumentation is disabled, a phase only
+ *  checks whether it is enabled.
+ */
+class ScopedPhase
+{
+public:
+    //! Constructor
+    /*! \param name Name of the phase, which must outlive the phase.
+     */
+    explicit ScopedPhase(const char* name)
+    {
+#ifndef FREUD_DISABLE_INSTRUMENTATION
+        if (getInstrumentation())
+        {
+            begin(name);
+        }
+#endif
+    }
+
+    //! Destructor, recording the run of the phase.
+    ~ScopedPhase()
+    {
+#ifndef FREUD_DISABLE_INSTRUMENTATION
+        if (m_active)
+        {
+            end();
+        }
+#endif
+    }
+
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    //! Whether the phase is timed, so that its bonds should be counted.
+    bool isActive() const
+    {
+#ifdef FREUD_DISABLE_INSTRUMENTATION
+        return false;
+#else
+        return m_active;
+#endif
+    }
+
+    //! Add bonds found or looped over in the phase.
+    void addBonds(size_t bonds)
+    {
+        m_bonds += bonds;
+    }
+
+private:
+    //! Start timing the phase.
+    void begin(const char* name);
+
+    //! Record the run of the phase.
+    void end();
+
+    bool m_active {false};                         //!< Whether the phase is timed
+    size_t m_bonds {0};                            //!< Number of bonds of the run
+    size_t m_bytes {0};                            //!< Allocated bytes at the start of the run
+    std::chrono::steady_clock::time_point m_start; //!< Start of the run
+    std::string m_path;                            //!< Names of the enclosing phases and of the phase
+    ScopedPhase* m_parent {nullptr};               //!< Enclosing phase on the same thread
+};
+
+}; }; // end namespace freud::util
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,23 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <atomic>
+
+#include "ManagedArray.h"
+
+/*! \file ManagedArray.cc
+    \brief Generations of the data of arrays.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+std::atomic<uint64_t> array_generation {0};
+} // namespace
+
+uint64_t nextArrayGeneration()
+{
+    return ++array_generation;
+}
+
+}; }; // end namespace freud::util
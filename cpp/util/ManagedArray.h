@@ -4,19 +4,33 @@
 #ifndef MANAGED_ARRAY_H
 #define MANAGED_ARRAY_H
 
+#include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <functional>
 #include <memory>
 #include <numeric>
 #include <sstream>
+#include <tbb/task_arena.h>
+#include <type_traits>
 #include <vector>
 
+#include "BufferPool.h"
+#include "utils.h"
+
 /*! \file ManagedArray.h
     \brief Defines the standard array class to be used throughout freud.
 */
 
 namespace freud { namespace util {
 
+//! Get a new generation of the data of a ManagedArray.
+/*! The generations are counted in the library rather than in the header, so
+ *  that they are unique among the arrays of all types and of all modules
+ *  including this header, whose arrays are exported through the same cache.
+ */
+uint64_t nextArrayGeneration();
+
 //! Class to handle the storage of all arrays of numerical data used in freud.
 /*! The purpose of this class is to handle standard memory management, and to
  *  provide an abstraction around the implementation-specific choice of
@@ -67,6 +81,23 @@ public:
      */
     explicit ManagedArray(size_t size) : ManagedArray(std::vector<size_t> {size}) {}
 
+    //! Constructor managing existing data.
+    /*! No memory is allocated or initialized. The array shares ownership of
+     *  the data, which is released by the deleter of the provided pointer once
+     *  no array refers to it anymore, e.g. to unmap a memory-mapped file. The
+     *  data must remain writeable because the array may be modified in place.
+     *
+     *  \param data Pointer to the data, which must hold at least as many elements as the shape.
+     *  \param shape Shape of the array.
+     */
+    ManagedArray(std::shared_ptr<T> data, const std::vector<size_t>& shape)
+        : m_data(std::make_shared<std::shared_ptr<T>>(std::move(data))),
+          m_shape(std::make_shared<std::vector<size_t>>(shape)),
+          m_size(std::make_shared<size_t>(
+              std::accumulate(shape.cbegin(), shape.cend(), size_t(1), std::multiplies<>()))),
+          m_generation(nextGeneration())
+    {}
+
     //! Destructor (currently empty because data is managed by shared pointer).
     ~ManagedArray() = default;
 
@@ -89,37 +120,73 @@ public:
      */
     void prepare(const std::vector<size_t>& new_shape, bool force = false)
     {
-        // If we resized, or if there are outstanding references, we create a new array. No matter what,
-        // reset.
-        if (force || (m_data.use_count() > 1) || (new_shape != shape()))
-        {
-            m_shape = std::make_shared<std::vector<size_t>>(new_shape);
+        reallocate(new_shape, force);
+        reset();
+    }
 
-            m_size = std::make_shared<size_t>(1);
-            for (unsigned int i = m_shape->size() - 1; i != static_cast<unsigned int>(-1); --i)
-            {
-                (*m_size) *= (*m_shape)[i];
-            }
+    //! Simple convenience for 1D arrays that calls through to the shape based `prepareForOverwrite`.
+    /*! \param new_size Size of the 1D array to allocate.
+     */
+    void prepareForOverwrite(size_t new_size)
+    {
+        prepareForOverwrite(std::vector<size_t> {new_size});
+    }
 
-            // We make use of C-style arrays here rather than any alternative
-            // because we need the underlying data representation to be
-            // compatible with numpy on the Python side. We _could_ do this
-            // with a different data structure like std::vector, but it would
-            // require writing additional gymnastics to ensure proper reference
-            // management and should be carefully considered before any rewrite.
-            m_data = std::shared_ptr<std::shared_ptr<T>>(new std::shared_ptr<T>(
-                new T[size()], std::default_delete<T[]>())); // NOLINT(modernize-avoid-c-arrays)
-        }
-        reset();
+    //! Prepare for writing new data to every element of the array.
+    /*! This function reallocates in the same cases as prepare, but leaves the
+     * contents unspecified instead of resetting them, so it may only be used
+     * by computes that assign every element afterwards. Besides saving a pass
+     * over the array, the pages of a newly allocated array are then first
+     * touched, and placed on the NUMA node of, the threads writing them.
+     *
+     *  \param new_shape Shape of the array to allocate.
+     */
+    void prepareForOverwrite(const std::vector<size_t>& new_shape)
+    {
+        reallocate(new_shape, false);
     }
 
     //! Reset the contents of array to be 0.
+    /*! Large arrays are reset in parallel over pages, so that the pages of
+     *  newly allocated arrays are spread over the NUMA nodes of the threads
+     *  of subsequent parallel loops instead of all being placed on the node
+     *  of the calling thread.
+     */
     void reset()
     {
-        if (size() != 0)
+        m_generation = nextGeneration();
+        const size_t bytes = sizeof(T) * size();
+        if (bytes == 0)
         {
-            memset((void*) get(), 0, sizeof(T) * size());
+            return;
         }
+        auto* data = reinterpret_cast<char*>(get());
+        if (bytes < PARALLEL_RESET_BYTES)
+        {
+            memset((void*) data, 0, bytes);
+            return;
+        }
+        // The threads waiting for the reset must not pick up other tasks of
+        // an enclosing parallel loop, e.g. one creating thread local arrays.
+        const size_t n_pages = (bytes + PAGE_BYTES - 1) / PAGE_BYTES;
+        tbb::this_task_arena::isolate([&]() {
+            util::forLoopWrapper(0, n_pages, [&](size_t begin, size_t end) {
+                const size_t end_byte = std::min(end * PAGE_BYTES, bytes);
+                memset((void*) (data + begin * PAGE_BYTES), 0, end_byte - begin * PAGE_BYTES);
+            });
+        });
+    }
+
+    //! Return the generation of the data of this array.
+    /*! The generation changes whenever the data is reallocated, reset or
+     *  prepared for overwriting, and it is unique among all arrays,
+     *  so that the Python API can reuse the NumPy array exported for a
+     *  generation until the data changes. Copies of an array share its
+     *  generation as long as they share its data.
+     */
+    uint64_t getGeneration() const
+    {
+        return m_generation;
     }
 
     //! Return a constant pointer to the underlying data (requires two levels of indirection).
@@ -347,6 +414,61 @@ public:
     }
 
 private:
+    //! Size in bytes of the pages of memory placed on NUMA nodes.
+    static constexpr size_t PAGE_BYTES = 4096;
+
+    //! Size in bytes from which arrays are reset in parallel.
+    static constexpr size_t PARALLEL_RESET_BYTES = size_t(1) << 20;
+
+    //! Reallocate the data if the shape changed or other arrays refer to it, without initializing it.
+    /*! \param new_shape Shape of the array to allocate.
+     *  \param force Reallocate regardless of whether anything changed or needs to be persisted.
+     */
+    void reallocate(const std::vector<size_t>& new_shape, bool force)
+    {
+        // If we resized, or if there are outstanding references, we create a new array.
+        if (force || (m_data.use_count() > 1) || (new_shape != shape()))
+        {
+            m_shape = std::make_shared<std::vector<size_t>>(new_shape);
+
+            m_size = std::make_shared<size_t>(1);
+            for (unsigned int i = m_shape->size() - 1; i != static_cast<unsigned int>(-1); --i)
+            {
+                (*m_size) *= (*m_shape)[i];
+            }
+
+            m_data = std::make_shared<std::shared_ptr<T>>(allocate(size()));
+        }
+        m_generation = nextGeneration();
+    }
+
+    //! Get a new generation, unique among all arrays.
+    static uint64_t nextGeneration()
+    {
+        return nextArrayGeneration();
+    }
+
+    //! Allocate the data of an array of size elements.
+    /*! We make use of C-style arrays here rather than any alternative
+     *  because we need the underlying data representation to be compatible
+     *  with numpy on the Python side. Arrays of trivial types are allocated
+     *  from the BufferPool, which aligns them and recycles the buffers of
+     *  released arrays, since new arrays are always reset or overwritten.
+     */
+    static std::shared_ptr<T> allocate(size_t size)
+    {
+        if constexpr (std::is_trivial<T>::value)
+        {
+            T* data = static_cast<T*>(BufferPool::getInstance().allocate(size * sizeof(T)));
+            return std::shared_ptr<T>(data, [](T* buffer) { BufferPool::getInstance().release(buffer); });
+        }
+        else
+        {
+            // NOLINTNEXTLINE(modernize-avoid-c-arrays)
+            return std::shared_ptr<T>(new T[size], std::default_delete<T[]>());
+        }
+    }
+
     //! The base case for building up the index.
     /*! These argument building functions are templated on two types, one that
      *  encapsulates the current object being operated on and the other being
@@ -372,6 +494,7 @@ private:
     std::shared_ptr<std::shared_ptr<T>> m_data;   //!< Pointer to array.
     std::shared_ptr<std::vector<size_t>> m_shape; //!< Shape of array.
     std::shared_ptr<size_t> m_size;               //!< Size of array.
+    uint64_t m_generation {0};                    //!< Generation of the data of the array.
 };
 
 }; }; // end namespace freud::util
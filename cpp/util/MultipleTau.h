@@ -0,0 +1,178 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef MULTIPLE_TAU_H
+#define MULTIPLE_TAU_H
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+/*! \file MultipleTau.h
+    \brief Pairs of frames of a trajectory at logarithmically spaced lags.
+*/
+
+namespace freud { namespace util {
+
+//! Multiple-tau bookkeeping of the frames of a trajectory for time correlations.
+/*! Frames are added one at a time and kept in a hierarchy of levels of
+ *  points_per_level frames each. Level 0 keeps the latest frames, and level
+ *  k keeps the latest frames whose index is a multiple of 2^k. Each new frame
+ *  is paired with the frames of the levels it belongs to, which yields the
+ *  lags 0 to points_per_level - 1 from level 0 and the lags j 2^k for
+ *  points_per_level / 2 <= j < points_per_level from level k.
+ *
+ *  Frames are sampled rather than averaged, so every pair consists of two
+ *  actual frames and any function of a pair of frames, including nonlinear
+ *  ones, can be correlated exactly. Longer lags are computed from fewer time
+ *  origins. The memory is bounded by points_per_level frames per level,
+ *  independently of the length of the trajectory beyond the lags that are
+ *  resolved.
+ */
+template<typename T> class MultipleTau
+{
+public:
+    //! A previous frame paired with the latest frame.
+    struct Pair
+    {
+        unsigned int lag_index; //!< Index of the lag of the pair
+        const T* earlier;       //!< Values of the earlier frame
+    };
+
+    //! Maximum number of levels, which bounds the lags to points_per_level 2^(MAX_LEVELS - 1).
+    static constexpr unsigned int MAX_LEVELS = 32;
+
+    //! Default constructor for Cython.
+    MultipleTau() = default;
+
+    //! Constructor
+    /*! \param points_per_level Number of frames kept in each level, which must be even and at least 2.
+     */
+    explicit MultipleTau(unsigned int points_per_level) : m_points_per_level(points_per_level)
+    {
+        if (points_per_level < 2 || points_per_level % 2 != 0)
+        {
+            throw std::invalid_argument(
+                "MultipleTau requires an even number of points per level of at least 2.");
+        }
+    }
+
+    //! Remove all frames and set the number of values of each frame.
+    void reset(unsigned int n_values)
+    {
+        m_n_values = n_values;
+        m_n_frames = 0;
+        m_levels.clear();
+        m_counts.assign(getNumLags(), 0);
+    }
+
+    //! Number of lags that can be resolved.
+    unsigned int getNumLags() const
+    {
+        return m_points_per_level + (MAX_LEVELS - 1) * (m_points_per_level / 2);
+    }
+
+    //! Number of lags that have at least one pair of frames, which are the first lags.
+    unsigned int getNumResolvedLags() const
+    {
+        return static_cast<unsigned int>(
+            std::find(m_counts.begin(), m_counts.end(), size_t(0)) - m_counts.begin());
+    }
+
+    //! Lag in frames of a lag index.
+    size_t getLag(unsigned int lag_index) const
+    {
+        if (lag_index < m_points_per_level)
+        {
+            return lag_index;
+        }
+        const unsigned int half = m_points_per_level / 2;
+        const unsigned int level = (lag_index - m_points_per_level) / half + 1;
+        const unsigned int j = (lag_index - m_points_per_level) % half + half;
+        return size_t(j) << level;
+    }
+
+    //! Number of pairs of frames of each lag.
+    const std::vector<size_t>& getCounts() const
+    {
+        return m_counts;
+    }
+
+    //! Number of values of each frame.
+    unsigned int getNumValues() const
+    {
+        return m_n_values;
+    }
+
+    //! Number of frames added since the last reset.
+    size_t getNumFrames() const
+    {
+        return m_n_frames;
+    }
+
+    //! Add a frame and correlate it with the previous frames.
+    /*! \param values The m_n_values values of the frame, which are copied.
+     *  \param correlate Function called once with the pairs of previous
+     *         frames (including the frame itself at lag 0) and the values of
+     *         the new frame, as correlate(const std::vector<Pair>&, const T*).
+     */
+    template<typename Correlate> void addFrame(const T* values, const Correlate& correlate)
+    {
+        std::vector<Pair> pairs;
+        const T* latest = nullptr;
+        for (unsigned int level = 0; level < MAX_LEVELS; ++level)
+        {
+            if (level > 0 && (m_n_frames & ((size_t(1) << level) - 1)) != 0)
+            {
+                break;
+            }
+            if (level == m_levels.size())
+            {
+                m_levels.emplace_back();
+                m_levels.back().frames.resize(size_t(m_points_per_level) * m_n_values);
+            }
+            Level& current = m_levels[level];
+            current.head = (current.head + 1) % m_points_per_level;
+            current.count = std::min(current.count + 1, m_points_per_level);
+            T* slot = current.frames.data() + size_t(current.head) * m_n_values;
+            std::copy(values, values + m_n_values, slot);
+            if (level == 0)
+            {
+                latest = slot;
+            }
+
+            // Lags of this level that are not resolved by the level below
+            const unsigned int first = (level == 0) ? 0 : m_points_per_level / 2;
+            const unsigned int first_lag_index
+                = (level == 0) ? 0 : m_points_per_level + (level - 1) * (m_points_per_level / 2);
+            for (unsigned int j = first; j < current.count; ++j)
+            {
+                const unsigned int offset = (current.head + m_points_per_level - j) % m_points_per_level;
+                const unsigned int lag_index = first_lag_index + j - first;
+                pairs.push_back({lag_index, current.frames.data() + size_t(offset) * m_n_values});
+                ++m_counts[lag_index];
+            }
+        }
+        ++m_n_frames;
+        correlate(pairs, latest);
+    }
+
+private:
+    //! The latest frames sampled every 2^k frames.
+    struct Level
+    {
+        std::vector<T> frames;  //!< Circular buffer of m_points_per_level frames
+        unsigned int head {0};  //!< Slot of the latest frame
+        unsigned int count {0}; //!< Number of frames in the buffer
+    };
+
+    unsigned int m_points_per_level {16}; //!< Number of frames kept in each level
+    unsigned int m_n_values {0};          //!< Number of values of each frame
+    size_t m_n_frames {0};                //!< Number of frames added since the last reset
+    std::vector<Level> m_levels;          //!< Levels of the hierarchy
+    std::vector<size_t> m_counts;         //!< Number of pairs of frames of each lag
+};
+
+}; }; // end namespace freud::util
+
+#endif // MULTIPLE_TAU_H
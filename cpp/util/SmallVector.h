@@ -0,0 +1,146 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+/*! \file SmallVector.h
+    \brief A vector that stores a small number of elements without allocating.
+*/
+
+namespace freud { namespace util {
+
+//! A vector that stores up to N elements inline.
+/*! Elements are stored in an inline array until the size exceeds N, after
+ *  which they are moved to a std::vector on the heap. Containers of small,
+ *  commonly sized objects such as the neighbor vectors of a local environment
+ *  can therefore be created, copied, and filled without heap allocations.
+ *
+ *  The elements are stored on the heap exactly when the heap vector is not
+ *  empty, in which case it holds all elements.
+ */
+template<typename T, size_t N> class SmallVector
+{
+public:
+    //! Constructor
+    SmallVector() = default;
+
+    //! Construct a vector of size copies of value.
+    SmallVector(size_t size, const T& value)
+    {
+        resize(size, value);
+    }
+
+    //! Get the number of elements.
+    size_t size() const
+    {
+        return m_size;
+    }
+
+    //! Whether the vector holds no elements.
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    //! Remove all elements.
+    void clear()
+    {
+        m_size = 0;
+        m_heap.clear();
+    }
+
+    //! Append an element.
+    void push_back(const T& value)
+    {
+        if (m_heap.empty())
+        {
+            if (m_size < N)
+            {
+                m_inline[m_size++] = value;
+                return;
+            }
+            m_heap.assign(m_inline.begin(), m_inline.end());
+        }
+        m_heap.push_back(value);
+        ++m_size;
+    }
+
+    //! Change the number of elements, filling new elements with value.
+    void resize(size_t size, const T& value = T())
+    {
+        if (m_heap.empty() && size <= N)
+        {
+            if (size > m_size)
+            {
+                std::fill(m_inline.begin() + m_size, m_inline.begin() + size, value);
+            }
+            m_size = size;
+            return;
+        }
+        if (m_heap.empty())
+        {
+            m_heap.assign(m_inline.begin(), m_inline.begin() + m_size);
+        }
+        m_heap.resize(size, value);
+        m_size = size;
+    }
+
+    //! Get a pointer to the elements.
+    T* data()
+    {
+        return m_heap.empty() ? m_inline.data() : m_heap.data();
+    }
+
+    //! Get a const pointer to the elements.
+    const T* data() const
+    {
+        return m_heap.empty() ? m_inline.data() : m_heap.data();
+    }
+
+    //! Writeable access to an element.
+    T& operator[](size_t i)
+    {
+        return data()[i];
+    }
+
+    //! Read-only access to an element.
+    const T& operator[](size_t i) const
+    {
+        return data()[i];
+    }
+
+    T* begin()
+    {
+        return data();
+    }
+
+    T* end()
+    {
+        return data() + m_size;
+    }
+
+    const T* begin() const
+    {
+        return data();
+    }
+
+    const T* end() const
+    {
+        return data() + m_size;
+    }
+
+private:
+    std::array<T, N> m_inline {}; //!< Inline storage used for up to N elements
+    std::vector<T> m_heap;        //!< Heap storage used for more than N elements
+    size_t m_size {0};            //!< Number of elements
+};
+
+}; }; // end namespace freud::util
+
+#endif // SMALL_VECTOR_H
@@ -6,6 +6,9 @@
 
 #include "ManagedArray.h"
 #include "utils.h"
+#include <algorithm>
+#include <memory>
+#include <stdexcept>
 #include <tbb/enumerable_thread_specific.h>
 #include <vector>
 
@@ -13,6 +16,17 @@ namespace freud { namespace util {
 
 //! Wrapper class for enumerable_thread_specific<T*>
 /*! It is expected that default value for T is 0.
+ *
+ *  The thread local arrays are attributed to the ScopedMemoryOwner of the
+ *  thread constructing or resizing the storage, if it has one, rather than
+ *  to the owners of the threads creating them.
+ *
+ *  Storage constructed with track_blocks records which blocks of BLOCK_SIZE
+ *  elements each thread has written through localTracked(). Only those
+ *  blocks are zeroed by reset() and summed by reduceInto(), which joins the
+ *  threads pairwise in a tree instead of looping over every thread for every
+ *  element. This pays off when each thread writes a small part of a large
+ *  array, such as the occupied bins of a fine histogram.
  */
 template<typename T> class ThreadStorage
 {
@@ -25,14 +39,16 @@ public:
     //! Constructor with specific size for thread local arrays
     /*! \param size Size of the thread local arrays
      */
-    explicit ThreadStorage(size_t size) : ThreadStorage(std::vector<size_t> {size}) {}
+    explicit ThreadStorage(size_t size, bool track_blocks = false)
+        : ThreadStorage(std::vector<size_t> {size}, track_blocks)
+    {}
 
     //! Constructor with specific shape for thread local arrays
     /*! \param shape Vector of sizes in each dimension of the thread local arrays
+     *  \param track_blocks Whether the arrays are written through localTracked().
      */
-    explicit ThreadStorage(const std::vector<size_t>& shape)
-        : arrays(
-            tbb::enumerable_thread_specific<ManagedArray<T>>([shape]() { return ManagedArray<T>(shape); }))
+    explicit ThreadStorage(const std::vector<size_t>& shape, bool track_blocks = false)
+        : arrays(makeArrays(shape)), m_track_blocks(track_blocks), m_size(arraySize(shape))
     {}
 
     //! Destructor
@@ -51,13 +67,19 @@ public:
      */
     void resize(std::vector<size_t> shape)
     {
-        arrays
-            = tbb::enumerable_thread_specific<ManagedArray<T>>([shape]() { return ManagedArray<T>(shape); });
+        arrays = makeArrays(shape);
+        m_written_blocks.clear();
+        m_size = arraySize(shape);
     }
 
     //! Reset the contents of thread local arrays to be 0
     void reset()
     {
+        if (m_track_blocks)
+        {
+            resetWrittenBlocks();
+            return;
+        }
         for (auto array = arrays.begin(); array != arrays.end(); ++array)
         {
             array->reset();
@@ -90,12 +112,97 @@ public:
 
     reference local()
     {
+        if (m_track_blocks)
+        {
+            throw std::runtime_error(
+                "This ThreadStorage tracks the blocks written on each thread, use localTracked().");
+        }
         return arrays.local();
     }
 
+    //! Number of elements of the blocks tracked by localTracked().
+    static constexpr size_t BLOCK_SIZE = 256;
+
+    //! Thread local array recording the blocks written through operator[].
+    class TrackedArray
+    {
+    public:
+        TrackedArray(T* data, unsigned char* written) : m_data(data), m_written(written) {}
+
+        //! Writeable index into the array, marking the block of the element as written.
+        T& operator[](size_t i)
+        {
+            m_written[i / BLOCK_SIZE] = 1;
+            return m_data[i];
+        }
+
+    private:
+        T* m_data;               //!< Data of the thread local array.
+        unsigned char* m_written; //!< Whether each block of the array has been written.
+    };
+
+    //! Get the thread local array of storage constructed with track_blocks.
+    TrackedArray localTracked()
+    {
+        if (!m_track_blocks)
+        {
+            throw std::runtime_error("This ThreadStorage does not track the blocks written on each thread.");
+        }
+        bool exists = false;
+        WrittenBlocks& local_blocks = m_written_blocks.local(exists);
+        if (!exists)
+        {
+            // The copy shares the data of the thread local array.
+            local_blocks.array = arrays.local();
+            local_blocks.written.assign(numBlocks(), 0);
+        }
+        return TrackedArray(local_blocks.array.get(), local_blocks.written.data());
+    }
+
+    //! Accumulate the contributions of the items in [begin, end) into the local arrays in parallel.
+    /*! By default, the items are processed as with forLoopWrapper and each
+     *  range is accumulated into the array of the thread processing it. With
+     *  deterministic reductions, fixed ranges of items are accumulated into
+     *  their own arrays, which are summed with deterministicReduce and added
+     *  to the array of the calling thread, so that the result of reduceInto
+     *  does not depend on the scheduling or the number of threads.
+     *
+     *  \param begin Beginning index.
+     *  \param end Ending index.
+     *  \param body An object with operator(size_t begin, size_t end, ManagedArray<T>& array) adding the
+     *         contributions of the items in [begin, end) to array.
+     *  \param grain_size Maximum number of items of the ranges of deterministic reductions.
+     *
+     *  The local arrays are written as with local(), so storage tracking
+     *  its written blocks may not be accumulated this way.
+     */
+    template<typename Body>
+    void accumulate(size_t begin, size_t end, const Body& body,
+                    size_t grain_size = util::DETERMINISTIC_GRAIN_SIZE)
+    {
+        if (!util::getDeterministicReductions())
+        {
+            util::forLoopWrapper(begin, end, [&](size_t range_begin, size_t range_end) {
+                body(range_begin, range_end, local());
+            });
+            return;
+        }
+
+        ManagedArray<T>& total = local();
+        const std::vector<size_t> shape = total.shape();
+        const ManagedArray<T> sum = util::deterministicReduce(
+            begin, end, [&shape]() { return ManagedArray<T>(shape); }, body,
+            [](ManagedArray<T>& left, const ManagedArray<T>& right) { addInto(left, right); }, grain_size);
+        addInto(total, sum);
+    }
+
     void reduceInto(ManagedArray<T>& result)
     {
-        if (arrays.size() == 0)
+        if (m_track_blocks && m_written_blocks.size() != 0)
+        {
+            reduceWrittenBlocksInto(result);
+        }
+        else if (arrays.size() == 0)
         {
             // If no local arrays have been created, then no data can be reduced
             // and an error will occur if we attempt to iterate over arrays.
@@ -118,7 +225,183 @@ public:
     }
 
 private:
+    //! Create thread local arrays of a shape, attributed to the current owner of buffers.
+    static tbb::enumerable_thread_specific<ManagedArray<T>> makeArrays(const std::vector<size_t>& shape)
+    {
+        const char* owner = ScopedMemoryOwner::current();
+        return tbb::enumerable_thread_specific<ManagedArray<T>>([shape, owner]() {
+            if (owner == nullptr)
+            {
+                return ManagedArray<T>(shape);
+            }
+            const ScopedMemoryOwner scoped_owner(owner);
+            return ManagedArray<T>(shape);
+        });
+    }
+
+    //! Add the elements of an array to an array of the same size.
+    static void addInto(ManagedArray<T>& left, const ManagedArray<T>& right)
+    {
+        T* left_data = left.get();
+        const T* right_data = right.get();
+        for (size_t i = 0; i < left.size(); ++i)
+        {
+            left_data[i] += right_data[i];
+        }
+    }
+
+    //! Number of elements of arrays of a shape.
+    static size_t arraySize(const std::vector<size_t>& shape)
+    {
+        size_t size = 1;
+        for (const size_t dim : shape)
+        {
+            size *= dim;
+        }
+        return size;
+    }
+
+    //! Number of blocks of the thread local arrays.
+    size_t numBlocks() const
+    {
+        return (m_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    }
+
+    //! Number of elements of a block of the thread local arrays.
+    size_t blockSize(size_t block) const
+    {
+        return std::min(BLOCK_SIZE, m_size - block * BLOCK_SIZE);
+    }
+
+    //! Zero the written blocks of all thread local arrays and clear their flags.
+    void resetWrittenBlocks()
+    {
+        std::vector<WrittenBlocks*> local_blocks;
+        for (auto blocks = m_written_blocks.begin(); blocks != m_written_blocks.end(); ++blocks)
+        {
+            local_blocks.push_back(&(*blocks));
+        }
+        util::forLoopWrapper(0, local_blocks.size(), [&](size_t begin, size_t end) {
+            for (size_t t = begin; t < end; ++t)
+            {
+                T* data = local_blocks[t]->array.get();
+                std::vector<unsigned char>& written = local_blocks[t]->written;
+                for (size_t block = 0; block < written.size(); ++block)
+                {
+                    if (written[block] != 0)
+                    {
+                        std::fill_n(data + block * BLOCK_SIZE, blockSize(block), T());
+                        written[block] = 0;
+                    }
+                }
+            }
+        });
+    }
+
+    //! Sums of the written blocks of a range of threads.
+    /*! A block is null if no thread of the range has written it. Otherwise it
+     *  points to the array of the only thread that wrote it, or to a buffer
+     *  of its sum over several threads. Buffers owned by a single BlockSums
+     *  are added to in place, and shared buffers are copied before writing.
+     */
+    struct BlockSums
+    {
+        std::vector<const T*> blocks;
+        std::vector<std::shared_ptr<std::vector<T>>> buffers;
+    };
+
+    //! Add a block of a thread or of another BlockSums to a BlockSums.
+    void addBlock(BlockSums& sums, size_t block, const T* data,
+                  const std::shared_ptr<std::vector<T>>& buffer) const
+    {
+        if (sums.blocks[block] == nullptr)
+        {
+            sums.blocks[block] = data;
+            sums.buffers[block] = buffer;
+            return;
+        }
+        std::shared_ptr<std::vector<T>>& sum = sums.buffers[block];
+        if (sum == nullptr || sum.use_count() != 1)
+        {
+            sum = std::make_shared<std::vector<T>>(sums.blocks[block], sums.blocks[block] + blockSize(block));
+            sums.blocks[block] = sum->data();
+        }
+        T* sum_data = sum->data();
+        for (size_t i = 0; i < sum->size(); ++i)
+        {
+            sum_data[i] += data[i];
+        }
+    }
+
+    //! Add the written blocks of all threads to an array, joining the threads pairwise.
+    void reduceWrittenBlocksInto(ManagedArray<T>& result)
+    {
+        std::vector<const WrittenBlocks*> local_blocks;
+        for (auto blocks = m_written_blocks.begin(); blocks != m_written_blocks.end(); ++blocks)
+        {
+            local_blocks.push_back(&(*blocks));
+        }
+        const size_t num_blocks = numBlocks();
+        const BlockSums sums = util::deterministicReduce(
+            0, local_blocks.size(),
+            [num_blocks]() {
+                return BlockSums {std::vector<const T*>(num_blocks, nullptr),
+                                  std::vector<std::shared_ptr<std::vector<T>>>(num_blocks)};
+            },
+            [&](size_t begin, size_t end, BlockSums& sums) {
+                for (size_t t = begin; t < end; ++t)
+                {
+                    const T* data = local_blocks[t]->array.get();
+                    const std::vector<unsigned char>& written = local_blocks[t]->written;
+                    for (size_t block = 0; block < num_blocks; ++block)
+                    {
+                        if (written[block] != 0)
+                        {
+                            addBlock(sums, block, data + block * BLOCK_SIZE, nullptr);
+                        }
+                    }
+                }
+            },
+            [&](BlockSums& left, const BlockSums& right) {
+                for (size_t block = 0; block < num_blocks; ++block)
+                {
+                    if (right.blocks[block] != nullptr)
+                    {
+                        addBlock(left, block, right.blocks[block], right.buffers[block]);
+                    }
+                }
+            },
+            1);
+
+        T* result_data = result.get();
+        util::forLoopWrapper(0, num_blocks, [&](size_t begin, size_t end) {
+            for (size_t block = begin; block < end; ++block)
+            {
+                const T* sum = sums.blocks[block];
+                if (sum != nullptr)
+                {
+                    T* result_block = result_data + block * BLOCK_SIZE;
+                    for (size_t i = 0; i < blockSize(block); ++i)
+                    {
+                        result_block[i] += sum[i];
+                    }
+                }
+            }
+        });
+    }
+
+    //! Thread local array of storage tracking its written blocks.
+    struct WrittenBlocks
+    {
+        ManagedArray<T> array;              //!< Shares the data of the thread local array.
+        std::vector<unsigned char> written; //!< Whether each block of the array has been written.
+    };
+
     tbb::enumerable_thread_specific<ManagedArray<T>> arrays; //!< thread local arrays
+    bool m_track_blocks {false};                               //!< Whether the written blocks are tracked.
+    size_t m_size {0};                                         //!< Number of elements of the arrays.
+    tbb::enumerable_thread_specific<WrittenBlocks>
+        m_written_blocks; //!< Written blocks of the arrays of the threads that used localTracked().
 };
 
 }; }; // end namespace freud::util
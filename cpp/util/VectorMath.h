@@ -5,7 +5,11 @@
 #define VECTOR_MATH_H
 
 #include <cmath>
+#include <cstddef>
 #include <utility>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 /*! \file VectorMath.h
     \brief Vector and quaternion math operations
@@ -1087,4 +1091,225 @@ template<class Vec> inline Vec project(const Vec& a, const Vec& b)
     return dot(a, b) / dot(b, b) * b;
 }
 
+/////////////////////////////// batch operations /////////////////////////////////
+
+/*! The batch operations apply rotate and quaternion multiplication to arrays
+    of single precision vectors and quaternions. The elements are processed four
+    at a time with SSE2 when available, with the components of four elements
+    transposed into one register each. The operations are evaluated in the same
+    order as the scalar versions, so that the results are the same unless the
+    compiler fuses the multiplications and additions of the scalar versions.
+*/
+
+#ifdef __SSE2__
+//! The components of four vec3<float>, each in a register.
+struct sse_vec3x4
+{
+    __m128 x; //!< x components
+    __m128 y; //!< y components
+    __m128 z; //!< z components
+};
+
+//! The components of four quat<float>, each in a register.
+struct sse_quat4
+{
+    __m128 s;     //!< scalar components
+    sse_vec3x4 v; //!< vector components
+};
+
+//! Load four consecutive vec3<float>.
+inline sse_vec3x4 sse_load_vec3x4(const vec3<float>* v)
+{
+    // a = x0 y0 z0 x1, b = y1 z1 x2 y2, c = z2 x3 y3 z3
+    const float* f = &v->x;
+    const __m128 a = _mm_loadu_ps(f);
+    const __m128 b = _mm_loadu_ps(f + 4);
+    const __m128 c = _mm_loadu_ps(f + 8);
+    const __m128 x2x3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 y0y1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const __m128 y2y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    const __m128 z0z1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    return {_mm_shuffle_ps(a, x2x3, _MM_SHUFFLE(2, 0, 3, 0)),
+            _mm_shuffle_ps(y0y1, y2y3, _MM_SHUFFLE(2, 0, 2, 0)),
+            _mm_shuffle_ps(z0z1, c, _MM_SHUFFLE(3, 0, 2, 0))};
+}
+
+//! Store four vectors as consecutive vec3<float>.
+inline void sse_store_vec3x4(const sse_vec3x4& v, vec3<float>* out)
+{
+    float* f = &out->x;
+    const __m128 x0y0 = _mm_shuffle_ps(v.x, v.y, _MM_SHUFFLE(0, 0, 0, 0));
+    const __m128 z0x1 = _mm_shuffle_ps(v.z, v.x, _MM_SHUFFLE(1, 1, 0, 0));
+    const __m128 y1z1 = _mm_shuffle_ps(v.y, v.z, _MM_SHUFFLE(1, 1, 1, 1));
+    const __m128 x2y2 = _mm_shuffle_ps(v.x, v.y, _MM_SHUFFLE(2, 2, 2, 2));
+    const __m128 z2x3 = _mm_shuffle_ps(v.z, v.x, _MM_SHUFFLE(3, 3, 2, 2));
+    const __m128 y3z3 = _mm_shuffle_ps(v.y, v.z, _MM_SHUFFLE(3, 3, 3, 3));
+    _mm_storeu_ps(f, _mm_shuffle_ps(x0y0, z0x1, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(f + 4, _mm_shuffle_ps(y1z1, x2y2, _MM_SHUFFLE(2, 0, 2, 0)));
+    _mm_storeu_ps(f + 8, _mm_shuffle_ps(z2x3, y3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+//! Load four consecutive quat<float>.
+inline sse_quat4 sse_load_quat4(const quat<float>* q)
+{
+    __m128 s = _mm_loadu_ps(&q[0].s);
+    __m128 x = _mm_loadu_ps(&q[1].s);
+    __m128 y = _mm_loadu_ps(&q[2].s);
+    __m128 z = _mm_loadu_ps(&q[3].s);
+    _MM_TRANSPOSE4_PS(s, x, y, z);
+    return {s, {x, y, z}};
+}
+
+//! Store four quaternions as consecutive quat<float>.
+inline void sse_store_quat4(sse_quat4 q, quat<float>* out)
+{
+    _MM_TRANSPOSE4_PS(q.s, q.v.x, q.v.y, q.v.z);
+    _mm_storeu_ps(&out[0].s, q.s);
+    _mm_storeu_ps(&out[1].s, q.v.x);
+    _mm_storeu_ps(&out[2].s, q.v.y);
+    _mm_storeu_ps(&out[3].s, q.v.z);
+}
+
+//! Broadcast a vector to the four lanes.
+inline sse_vec3x4 sse_set1_vec3x4(const vec3<float>& v)
+{
+    return {_mm_set1_ps(v.x), _mm_set1_ps(v.y), _mm_set1_ps(v.z)};
+}
+
+//! Broadcast a quaternion to the four lanes.
+inline sse_quat4 sse_set1_quat4(const quat<float>& q)
+{
+    return {_mm_set1_ps(q.s), sse_set1_vec3x4(q.v)};
+}
+
+//! dot product of four pairs of vectors, as dot.
+inline __m128 sse_dot(const sse_vec3x4& a, const sse_vec3x4& b)
+{
+    return _mm_add_ps(_mm_add_ps(_mm_mul_ps(a.x, b.x), _mm_mul_ps(a.y, b.y)), _mm_mul_ps(a.z, b.z));
+}
+
+//! cross product of four pairs of vectors, as cross.
+inline sse_vec3x4 sse_cross(const sse_vec3x4& a, const sse_vec3x4& b)
+{
+    return {_mm_sub_ps(_mm_mul_ps(a.y, b.z), _mm_mul_ps(a.z, b.y)),
+            _mm_sub_ps(_mm_mul_ps(a.z, b.x), _mm_mul_ps(a.x, b.z)),
+            _mm_sub_ps(_mm_mul_ps(a.x, b.y), _mm_mul_ps(a.y, b.x))};
+}
+
+//! Compute a * b + c * d + e * f for the components of four vectors, in the order of the scalar operators.
+inline sse_vec3x4 sse_sum_of_products(__m128 a, const sse_vec3x4& b, __m128 c, const sse_vec3x4& d, __m128 e,
+                                      const sse_vec3x4& f)
+{
+    return {_mm_add_ps(_mm_add_ps(_mm_mul_ps(b.x, a), _mm_mul_ps(d.x, c)), _mm_mul_ps(f.x, e)),
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(b.y, a), _mm_mul_ps(d.y, c)), _mm_mul_ps(f.y, e)),
+            _mm_add_ps(_mm_add_ps(_mm_mul_ps(b.z, a), _mm_mul_ps(d.z, c)), _mm_mul_ps(f.z, e))};
+}
+
+//! rotate four vectors by four quaternions, as rotate.
+inline sse_vec3x4 sse_rotate(const sse_quat4& a, const sse_vec3x4& b)
+{
+    const __m128 two = _mm_set1_ps(2.0F);
+    const __m128 k = _mm_sub_ps(_mm_mul_ps(a.s, a.s), sse_dot(a.v, a.v));
+    const __m128 two_s = _mm_mul_ps(two, a.s);
+    const __m128 two_dot = _mm_mul_ps(two, sse_dot(a.v, b));
+    return sse_sum_of_products(k, b, two_s, sse_cross(a.v, b), two_dot, a.v);
+}
+
+//! Multiply four pairs of quaternions, as operator*.
+inline sse_quat4 sse_multiply(const sse_quat4& a, const sse_quat4& b)
+{
+    const sse_vec3x4 c = sse_cross(a.v, b.v);
+    return {_mm_sub_ps(_mm_mul_ps(a.s, b.s), sse_dot(a.v, b.v)),
+            {_mm_add_ps(_mm_add_ps(_mm_mul_ps(b.v.x, a.s), _mm_mul_ps(a.v.x, b.s)), c.x),
+             _mm_add_ps(_mm_add_ps(_mm_mul_ps(b.v.y, a.s), _mm_mul_ps(a.v.y, b.s)), c.y),
+             _mm_add_ps(_mm_add_ps(_mm_mul_ps(b.v.z, a.s), _mm_mul_ps(a.v.z, b.s)), c.z)}};
+}
+#endif
+
+//! rotate many vectors by a quaternion
+/*! \param a quat
+    \param b vectors to rotate
+    \param n number of vectors
+    \param out array in which to place rotate(a, b[i]), which may be b
+*/
+inline void rotateBatch(const quat<float>& a, const vec3<float>* b, size_t n, vec3<float>* out)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    const sse_quat4 a4 = sse_set1_quat4(a);
+    for (; i + 4 <= n; i += 4)
+    {
+        sse_store_vec3x4(sse_rotate(a4, sse_load_vec3x4(&b[i])), &out[i]);
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        out[i] = rotate(a, b[i]);
+    }
+}
+
+//! rotate a vector by many quaternions
+/*! \param a quats
+    \param b vector to rotate
+    \param n number of quats
+    \param out array in which to place rotate(a[i], b)
+*/
+inline void rotateBatch(const quat<float>* a, const vec3<float>& b, size_t n, vec3<float>* out)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    const sse_vec3x4 b4 = sse_set1_vec3x4(b);
+    for (; i + 4 <= n; i += 4)
+    {
+        sse_store_vec3x4(sse_rotate(sse_load_quat4(&a[i]), b4), &out[i]);
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        out[i] = rotate(a[i], b);
+    }
+}
+
+//! rotate each vector by the quaternion with the same index
+/*! \param a quats
+    \param b vectors to rotate
+    \param n number of quats and vectors
+    \param out array in which to place rotate(a[i], b[i]), which may be b
+*/
+inline void rotateBatch(const quat<float>* a, const vec3<float>* b, size_t n, vec3<float>* out)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 4 <= n; i += 4)
+    {
+        sse_store_vec3x4(sse_rotate(sse_load_quat4(&a[i]), sse_load_vec3x4(&b[i])), &out[i]);
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        out[i] = rotate(a[i], b[i]);
+    }
+}
+
+//! Multiply each quaternion by the quaternion with the same index
+/*! \param a first quats
+    \param b second quats
+    \param n number of pairs of quats
+    \param out array in which to place a[i] * b[i], which may be a or b
+*/
+inline void multiplyBatch(const quat<float>* a, const quat<float>* b, size_t n, quat<float>* out)
+{
+    size_t i = 0;
+#ifdef __SSE2__
+    for (; i + 4 <= n; i += 4)
+    {
+        sse_store_quat4(sse_multiply(sse_load_quat4(&a[i]), sse_load_quat4(&b[i])), &out[i]);
+    }
+#endif
+    for (; i < n; ++i)
+    {
+        out[i] = a[i] * b[i];
+    }
+}
+
 #endif // VECTOR_MATH_H
@@ -0,0 +1,60 @@
+// Copyright (c) 2010-2023 The Regents of the University of Michigan
+// This file is from the freud project, released under the BSD 3-Clause License.
+
+#include <algorithm>
+#include <atomic>
+#include <tbb/global_control.h>
+
+#include "utils.h"
+
+/*! \file utils.cc
+    \brief Global settings of the parallel utilities.
+*/
+
+namespace freud { namespace util {
+
+namespace {
+std::atomic<bool> deterministic_reductions {false};
+std::atomic<AccumulatorPrecision> accumulator_precision {AccumulatorPrecision::automatic};
+thread_local tbb::task_arena* thread_arena = nullptr;
+} // namespace
+
+bool getDeterministicReductions()
+{
+    return deterministic_reductions.load(std::memory_order_relaxed);
+}
+
+void setDeterministicReductions(bool deterministic)
+{
+    deterministic_reductions.store(deterministic, std::memory_order_relaxed);
+}
+
+AccumulatorPrecision getAccumulatorPrecision()
+{
+    return accumulator_precision.load(std::memory_order_relaxed);
+}
+
+void setAccumulatorPrecision(AccumulatorPrecision precision)
+{
+    accumulator_precision.store(precision, std::memory_order_relaxed);
+}
+
+tbb::task_arena* getThreadArena()
+{
+    return thread_arena;
+}
+
+void setThreadArena(tbb::task_arena* arena)
+{
+    thread_arena = arena;
+}
+
+unsigned int getThreadConcurrency()
+{
+    const int arena_concurrency = (thread_arena != nullptr) ? thread_arena->max_concurrency()
+                                                            : tbb::this_task_arena::max_concurrency();
+    const size_t allowed = tbb::global_control::active_value(tbb::global_control::max_allowed_parallelism);
+    return static_cast<unsigned int>(std::min(static_cast<size_t>(arena_concurrency), allowed));
+}
+
+}; }; // end namespace freud::util
@@ -9,6 +9,9 @@
 #include <tbb/blocked_range.h>
 #include <tbb/blocked_range2d.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
 
 namespace freud { namespace util {
 
@@ -43,6 +46,32 @@ template<typename Scalar> inline Scalar sinc(Scalar x)
     return std::sin(x) / x;
 }
 
+//! Get the task arena running the parallel loops of the calling thread, or nullptr for the default arena.
+tbb::task_arena* getThreadArena();
+
+//! Set the task arena in which the parallel loops of the calling thread run.
+/*! The arena is specific to the calling thread, so that computes called
+ *  concurrently from several threads can each be limited to the threads of
+ *  their own arena instead of competing for the threads of the default
+ *  arena. Loops nested in the tasks of an arena run in that arena. The
+ *  default arena is restored by passing nullptr.
+ */
+void setThreadArena(tbb::task_arena* arena);
+
+//! Get the number of threads that a parallel loop started by the calling thread may use.
+unsigned int getThreadConcurrency();
+
+//! Run function in the task arena of the calling thread and return its result.
+template<typename Function> inline auto executeInThreadArena(const Function& function) -> decltype(function())
+{
+    tbb::task_arena* arena = getThreadArena();
+    if (arena == nullptr)
+    {
+        return function();
+    }
+    return arena->execute(function);
+}
+
 //! Wrapper for for-loop to allow the execution in parallel or not.
 /*! \param begin Beginning index.
  *  \param end Ending index.
@@ -54,8 +83,10 @@ inline void forLoopWrapper(size_t begin, size_t end, const Body& body, bool para
 {
     if (parallel)
     {
-        tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
-                          [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); });
+        executeInThreadArena([&]() {
+            tbb::parallel_for(tbb::blocked_range<size_t>(begin, end),
+                              [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); });
+        });
     }
     else
     {
@@ -63,6 +94,54 @@ inline void forLoopWrapper(size_t begin, size_t end, const Body& body, bool para
     }
 }
 
+//! Partitioners splitting the ranges of parallel loops.
+enum class Partitioner
+{
+    automatic, //!< Split adaptively as threads steal work, but not below the grain size
+    simple,    //!< Split down to the grain size, for items of very uneven cost
+    fixed      //!< Split evenly among the threads once, for items of equal cost
+};
+
+//! Hints of how a parallel loop splits its range among the threads.
+struct LoopSchedule
+{
+    size_t grain_size {1};                            //!< Minimum number of items of a range
+    Partitioner partitioner {Partitioner::automatic}; //!< Partitioner of the range
+};
+
+//! Wrapper for for-loop with a grain size and partitioner.
+/*! \param begin Beginning index.
+ *  \param end Ending index.
+ *  \param body An object with operator(size_t begin, size_t end).
+ *  \param schedule Grain size and partitioner of the loop.
+ *  \param parallel If true, run body in parallel.
+ */
+template<typename Body>
+inline void forLoopWrapper(size_t begin, size_t end, const Body& body, const LoopSchedule& schedule,
+                           bool parallel = true)
+{
+    if (!parallel)
+    {
+        body(begin, end);
+        return;
+    }
+    const tbb::blocked_range<size_t> range(begin, end, std::max(schedule.grain_size, size_t(1)));
+    const auto range_body = [&body](const tbb::blocked_range<size_t>& r) { body(r.begin(), r.end()); };
+    executeInThreadArena([&]() {
+        switch (schedule.partitioner)
+        {
+        case Partitioner::simple:
+            tbb::parallel_for(range, range_body, tbb::simple_partitioner());
+            break;
+        case Partitioner::fixed:
+            tbb::parallel_for(range, range_body, tbb::static_partitioner());
+            break;
+        default:
+            tbb::parallel_for(range, range_body, tbb::auto_partitioner());
+        }
+    });
+}
+
 //! Wrapper for 2D nested for loops to allow the execution in parallel or not.
 /*! \param begin_row Beginning index of outer loop.
  *  \param end_row Ending index of outer loop.
@@ -77,10 +156,12 @@ inline void forLoopWrapper2D(size_t begin_row, size_t end_row, size_t begin_col,
 {
     if (parallel)
     {
-        tbb::parallel_for(tbb::blocked_range2d<size_t>(begin_row, end_row, begin_col, end_col),
-                          [&body](const tbb::blocked_range2d<size_t>& r) {
-                              body(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
-                          });
+        executeInThreadArena([&]() {
+            tbb::parallel_for(tbb::blocked_range2d<size_t>(begin_row, end_row, begin_col, end_col),
+                              [&body](const tbb::blocked_range2d<size_t>& r) {
+                                  body(r.rows().begin(), r.rows().end(), r.cols().begin(), r.cols().end());
+                              });
+        });
     }
     else
     {
@@ -88,6 +169,125 @@ inline void forLoopWrapper2D(size_t begin_row, size_t end_row, size_t begin_col,
     }
 }
 
+//! Get whether parallel sums are computed in an order independent of the scheduling of threads.
+bool getDeterministicReductions();
+
+//! Set whether parallel sums are computed in an order independent of the scheduling of threads.
+/*! By default, each thread accumulates the items that it happens to process
+ *  into its own partial sum, so floating point sums depend on the dynamic
+ *  partitioning of the work and on the number of threads. In deterministic
+ *  mode, the computes that support it accumulate fixed ranges of items and
+ *  sum the partial sums of the ranges pairwise in a fixed order instead.
+ */
+void setDeterministicReductions(bool deterministic);
+
+//! Default number of items of the fixed ranges of deterministic reductions.
+constexpr size_t DETERMINISTIC_GRAIN_SIZE = 64;
+
+//! Sum the contributions of the items in [begin, end) in a fixed order.
+/*! The range is halved recursively until the ranges have at most grain_size
+ *  items, independently of the number of threads. The contributions of each
+ *  range are added to a new value, and the values of the ranges are joined
+ *  pairwise in the order of the ranges.
+ *
+ *  \param begin Beginning index.
+ *  \param end Ending index.
+ *  \param make_value A function returning a new zero value.
+ *  \param body An object with operator(size_t begin, size_t end, Value& value) adding the contributions
+ *         of the items in [begin, end) to value.
+ *  \param join An object with operator(Value& left, const Value& right) adding right to left.
+ *  \param grain_size Maximum number of items of the ranges.
+ */
+template<typename MakeValue, typename Body, typename Join>
+inline auto deterministicReduce(size_t begin, size_t end, const MakeValue& make_value, const Body& body,
+                                const Join& join, size_t grain_size = DETERMINISTIC_GRAIN_SIZE)
+{
+    using Value = decltype(make_value());
+
+    // The imperative form is used because values such as ManagedArrays share
+    // their data when they are copied.
+    class Reduction
+    {
+    public:
+        Reduction(const MakeValue& make_value, const Body& body, const Join& join)
+            : m_make_value(make_value), m_body(body), m_join(join), m_value(make_value())
+        {}
+
+        Reduction(Reduction& other, tbb::split)
+            : m_make_value(other.m_make_value), m_body(other.m_body), m_join(other.m_join),
+              m_value(other.m_make_value())
+        {}
+
+        void operator()(const tbb::blocked_range<size_t>& r)
+        {
+            m_body(r.begin(), r.end(), m_value);
+        }
+
+        void join(Reduction& other)
+        {
+            m_join(m_value, other.m_value);
+        }
+
+        Value& value()
+        {
+            return m_value;
+        }
+
+    private:
+        const MakeValue& m_make_value;
+        const Body& m_body;
+        const Join& m_join;
+        Value m_value;
+    };
+
+    Reduction reduction(make_value, body, join);
+    executeInThreadArena([&]() {
+        tbb::parallel_deterministic_reduce(tbb::blocked_range<size_t>(begin, end, grain_size), reduction,
+                                           tbb::simple_partitioner());
+    });
+    return reduction.value();
+}
+
+//! Precision of the floating point sums of computes.
+enum class AccumulatorPrecision
+{
+    automatic, //!< Each compute sums in the precision that it uses by default
+    single,    //!< Sums are accumulated in single precision, for throughput
+    mixed      //!< Sums are accumulated in double precision, and outputs are stored in single precision
+};
+
+//! Get the precision of the floating point sums of computes.
+AccumulatorPrecision getAccumulatorPrecision();
+
+//! Set the precision of the floating point sums of computes.
+/*! Outputs are stored in the same types in all modes. Sums of many terms,
+ *  such as the normalization of histograms of many bonds or the averages of
+ *  many particles, lose accuracy in single precision, while double precision
+ *  sums take twice the memory and bandwidth and vectorize half as wide.
+ */
+void setAccumulatorPrecision(AccumulatorPrecision precision);
+
+//! Check if the sums of a compute are accumulated in double precision.
+/*! \param default_double Whether the compute sums in double precision with AccumulatorPrecision::automatic.
+ */
+inline bool accumulateInDouble(bool default_double)
+{
+    const AccumulatorPrecision precision = getAccumulatorPrecision();
+    return precision == AccumulatorPrecision::mixed
+        || (precision == AccumulatorPrecision::automatic && default_double);
+}
+
+//! Call a function with a zero of the floating point type in which the sums of a compute are accumulated.
+/*! \param default_double Whether the compute sums in double precision with AccumulatorPrecision::automatic.
+ *  \param function An object with a templated operator(Accumulator zero), such as a generic lambda,
+ *         which is instantiated for float and double.
+ *  \returns The result of function.
+ */
+template<typename Function> inline auto dispatchAccumulator(bool default_double, const Function& function)
+{
+    return accumulateInDouble(default_double) ? function(double(0)) : function(float(0));
+}
+
 }; }; // namespace freud::util
 
 #endif
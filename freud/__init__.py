@@ -1,27 +1,39 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
-from . import (
-    box,
-    cluster,
-    data,
-    density,
-    diffraction,
-    environment,
-    interface,
-    locality,
-    msd,
-    order,
-    parallel,
-    pmft,
-)
+import importlib
+
+from . import box, locality, parallel
 from .box import Box
 from .locality import AABBQuery, LinkCell, NeighborList
 from .parallel import NumThreads, get_num_threads, set_num_threads
 
-# Override TBB's default autoselection. This is necessary because once the
-# automatic selection runs, the user cannot change it.
-set_num_threads(0)
+# The other submodules are imported on first access, so that importing freud
+# only loads the compiled modules that are used. TBB is initialized by the
+# first parallel computation, with all threads available to the process unless
+# set_num_threads is called.
+_lazy_submodules = {
+    "cluster",
+    "data",
+    "density",
+    "diffraction",
+    "environment",
+    "interface",
+    "msd",
+    "order",
+    "pmft",
+}
+
+
+def __getattr__(name):
+    if name in _lazy_submodules:
+        return importlib.import_module("." + name, __name__)
+    raise AttributeError(f"module {__name__!r} has no attribute {name!r}")
+
+
+def __dir__():
+    return sorted(set(globals()) | _lazy_submodules)
+
 
 __version__ = "2.13.0"
 
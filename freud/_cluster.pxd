@@ -1,6 +1,7 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp cimport bool
 from libcpp.vector cimport vector
 
 cimport freud._locality
@@ -14,19 +15,34 @@ cdef extern from "Cluster.h" namespace "freud::cluster":
         void compute(const freud._locality.NeighborQuery*,
                      const freud._locality.NeighborList*,
                      freud._locality.QueryArgs,
-                     const unsigned int*) except +
+                     const unsigned int*) nogil except +
         unsigned int getNumClusters() const
         const freud.util.ManagedArray[unsigned int] &getClusterIdx() const
         const vector[vector[uint]] getClusterKeys() const
 
 cdef extern from "ClusterProperties.h" namespace "freud::cluster":
     cdef cppclass ClusterProperties:
-        ClusterProperties()
+        ClusterProperties(bool)
+        bool getComputeTensors() const
         void compute(const freud._locality.NeighborQuery*,
-                     const unsigned int*, const float*) except +
+                     const unsigned int*, const float*) nogil except +
         const freud.util.ManagedArray[vec3[float]] &getClusterCenters() const
         const freud.util.ManagedArray[vec3[float]] &getClusterCentersOfMass() const
         const freud.util.ManagedArray[float] &getClusterMomentsOfInertia() const
         const freud.util.ManagedArray[float] &getClusterGyrations() const
         const freud.util.ManagedArray[unsigned int] &getClusterSizes() const
         const freud.util.ManagedArray[float] &getClusterMasses() const
+
+cdef extern from "ClusterTracker.h" namespace "freud::cluster":
+    cdef cppclass ClusterTracker:
+        ClusterTracker() except +
+        void compute(const freud._locality.NeighborQuery*,
+                     const freud._locality.NeighborList*,
+                     freud._locality.QueryArgs) nogil except +
+        void reset()
+        unsigned int getNumClusters() const
+        unsigned int getFrameCounter() const
+        const freud.util.ManagedArray[unsigned int] &getClusterIdx() const
+        const freud.util.ManagedArray[unsigned int] &getClusterIds() const
+        const freud.util.ManagedArray[unsigned int] &getMerges() const
+        const freud.util.ManagedArray[unsigned int] &getSplits() const
@@ -6,7 +6,7 @@ from libcpp cimport bool
 cimport freud._box
 cimport freud._locality
 cimport freud.util
-from freud._locality cimport BondHistogramCompute
+from freud._locality cimport BondHistogramCompute, BondStage
 from freud.util cimport vec3
 
 ctypedef unsigned int uint
@@ -18,7 +18,10 @@ cdef extern from "CorrelationFunction.h" namespace "freud::density":
                         const vec3[float]*,
                         const T*,
                         unsigned int, const freud._locality.NeighborList*,
-                        freud._locality.QueryArgs) except +
+                        freud._locality.QueryArgs) nogil except +
+        void accumulateBinned(const freud._box.Box &, const T*,
+                              const unsigned int*, unsigned int,
+                              unsigned int) nogil except +
         const freud.util.ManagedArray[T] &getCorrelation()
 
 cdef extern from "GaussianDensity.h" namespace "freud::density":
@@ -27,44 +30,72 @@ cdef extern from "GaussianDensity.h" namespace "freud::density":
         const freud._box.Box & getBox() const
         void reset()
         void compute(const freud._locality.NeighborQuery*,
-                     const float*) except +
+                     const float*) nogil except +
         const freud.util.ManagedArray[float] &getDensity() const
         vec3[unsigned int] getWidth() const
         float getSigma() const
         float getRMax() const
 
 cdef extern from "LocalDensity.h" namespace "freud::density":
-    cdef cppclass LocalDensity:
+    cdef cppclass LocalDensity(BondStage):
         LocalDensity(float, float) except +
         const freud._box.Box & getBox() const
         void compute(
             const freud._locality.NeighborQuery*,
             const vec3[float]*,
             unsigned int, const freud._locality.NeighborList *,
-            freud._locality.QueryArgs) except +
+            freud._locality.QueryArgs, bool) nogil except +
         const freud.util.ManagedArray[float] &getDensity() const
         const freud.util.ManagedArray[float] &getNumNeighbors() const
         float getRMax() const
         float getDiameter() const
 
 cdef extern from "RDF.h" namespace "freud::density":
-    cdef cppclass RDF(BondHistogramCompute):
+    cdef cppclass RDF(BondHistogramCompute, BondStage):
         RDF(float, float, float, bool) except +
         const freud._box.Box & getBox() const
         void accumulate(const freud._locality.NeighborQuery*,
                         const vec3[float]*,
                         unsigned int,
                         const freud._locality.NeighborList*,
-                        freud._locality.QueryArgs) except +
+                        freud._locality.QueryArgs, bool) nogil except +
+        unsigned int accumulateFrames(const freud._locality.FrameReader &,
+                                      freud._locality.QueryArgs) \
+            nogil except +
+        void accumulateSlabs(const freud._locality.SlabDecomposition &,
+                             freud._locality.QueryArgs) nogil except +
+        void accumulateSystems(const freud._locality.SystemBatch &,
+                               freud._locality.QueryArgs) nogil except +
+        const freud.util.ManagedArray[float] &getRDF()
+        const freud.util.ManagedArray[float] &getNr()
+        const freud.util.ManagedArray[float] &getSystemRDF() const
+        const freud.util.ManagedArray[float] &getSystemNr() const
+        const freud.util.ManagedArray[unsigned int] &getSystemBinCounts() \
+            const
+
+cdef extern from "PartialRDF.h" namespace "freud::density":
+    cdef cppclass PartialRDF(BondHistogramCompute):
+        PartialRDF(unsigned int, unsigned int, float, float, bool) except +
+        const freud._box.Box & getBox() const
+        void accumulate(const freud._locality.NeighborQuery*,
+                        const unsigned int*,
+                        const vec3[float]*,
+                        const unsigned int*,
+                        unsigned int,
+                        const freud._locality.NeighborList*,
+                        freud._locality.QueryArgs) nogil except +
+        unsigned int getNumTypes() const
         const freud.util.ManagedArray[float] &getRDF()
         const freud.util.ManagedArray[float] &getNr()
 
 cdef extern from "SphereVoxelization.h" namespace "freud::density":
     cdef cppclass SphereVoxelization:
-        SphereVoxelization(vec3[unsigned int], float) except +
+        SphereVoxelization(vec3[unsigned int], float, bool) except +
         const freud._box.Box & getBox() const
         void reset()
-        void compute(const freud._locality.NeighborQuery*) except +
+        void compute(const freud._locality.NeighborQuery*) nogil except +
         const freud.util.ManagedArray[unsigned int] &getVoxels() const
+        const freud.util.ManagedArray[unsigned char] &getPackedVoxels() const
+        bool isPacked() const
         vec3[unsigned int] getWidth() const
         float getRMax() const
@@ -15,19 +15,27 @@ cdef extern from "StaticStructureFactor.h" namespace "freud::diffraction":
         const vector[float] getBinEdges() const
         const vector[float] getBinCenters() const
         float getMinValidK() const
+        unsigned int accumulateFrames(const freud._locality.FrameReader &) \
+            nogil except +
 
 cdef extern from "StaticStructureFactorDebye.h" namespace "freud::diffraction":
     cdef cppclass StaticStructureFactorDebye(StaticStructureFactor):
-        StaticStructureFactorDebye(unsigned int, float, float) except +
+        StaticStructureFactorDebye(unsigned int, float, float,
+                                   unsigned int) except +
         void accumulate(const freud._locality.NeighborQuery*,
-                        const vec3[float]*, unsigned int, unsigned int) except +
+                        const vec3[float]*, unsigned int,
+                        unsigned int) nogil except +
         void reset()
+        unsigned int getNumDistanceBins() const
 
 cdef extern from "StaticStructureFactorDirect.h" namespace "freud::diffraction":
     cdef cppclass StaticStructureFactorDirect(StaticStructureFactor):
-        StaticStructureFactorDirect(unsigned int, float, float, unsigned int) except +
+        StaticStructureFactorDirect(unsigned int, float, float, unsigned int,
+                                    unsigned int) except +
         void accumulate(const freud._locality.NeighborQuery*,
-                        const vec3[float]*, unsigned int, unsigned int) except +
+                        const vec3[float]*, unsigned int,
+                        unsigned int) nogil except +
         void reset()
         unsigned int getNumSampledKPoints() const
+        unsigned int getSeed() const
         vector[vec3[float]] getKPoints() const
@@ -0,0 +1,40 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from libc.stdint cimport uint64_t
+from libcpp.vector cimport vector
+from mpi4py.libmpi cimport MPI_Comm
+
+cimport freud._box
+cimport freud._cluster
+cimport freud._density
+cimport freud._locality
+cimport freud._order
+from freud.util cimport vec3
+
+
+cdef extern from "DomainDecomposition.h" namespace "freud::distributed":
+    cdef cppclass DomainDecomposition:
+        DomainDecomposition(MPI_Comm, const freud._box.Box &, float) except +
+        void distribute(const vec3[float]*, unsigned int,
+                        const uint64_t*) nogil except +
+        int getRank() const
+        int getNumRanks() const
+        const freud._box.Box & getBox() const
+        float getGhostWidth() const
+        const vector[vec3[float]] & getPoints() const
+        const vector[uint64_t] & getTags() const
+        unsigned int getNOwned() const
+        unsigned int getNGhosts() const
+        uint64_t getNTotal() const
+
+cdef extern from "DistributedCompute.h" namespace "freud::distributed":
+    void accumulateRDF(freud._density.RDF &, const DomainDecomposition &,
+                       freud._locality.QueryArgs) nogil except +
+    void computeSteinhardt(freud._order.Steinhardt &,
+                           const DomainDecomposition &,
+                           freud._locality.QueryArgs) nogil except +
+    uint64_t computeClusters(freud._cluster.Cluster &,
+                             const DomainDecomposition &,
+                             freud._locality.QueryArgs,
+                             vector[uint64_t] &) nogil except +
@@ -9,7 +9,7 @@ from libcpp.vector cimport vector
 cimport freud._box
 cimport freud._locality
 cimport freud.util
-from freud._locality cimport BondHistogramCompute
+from freud._locality cimport BondHistogramCompute, BondStage
 from freud.util cimport quat, vec3
 
 
@@ -20,7 +20,7 @@ cdef extern from "BondOrder.h" namespace "freud::environment":
         obcd
         oocd
 
-    cdef cppclass BondOrder(BondHistogramCompute):
+    cdef cppclass BondOrder(BondHistogramCompute, BondStage):
         BondOrder(unsigned int, unsigned int, BondOrderMode) except +
         void accumulate(
             const freud._locality.NeighborQuery*,
@@ -29,7 +29,8 @@ cdef extern from "BondOrder.h" namespace "freud::environment":
             quat[float]*,
             unsigned int,
             const freud._locality.NeighborList*,
-            freud._locality.QueryArgs) except +
+            freud._locality.QueryArgs) nogil except +
+        void setOrientations(const quat[float]*, const quat[float]*)
         const freud.util.ManagedArray[float] &getBondOrder()
         BondOrderMode getMode() const
 
@@ -41,7 +42,7 @@ cdef extern from "LocalDescriptors.h" namespace "freud::environment":
 
     cdef cppclass LocalDescriptors:
         LocalDescriptors(unsigned int,
-                         bool, LocalDescriptorOrientation)
+                         bool, LocalDescriptorOrientation, bool) except +
         unsigned int getNSphs() const
         unsigned int getLMax() const
         unsigned int getSphWidth() const
@@ -51,11 +52,18 @@ cdef extern from "LocalDescriptors.h" namespace "freud::environment":
             const quat[float]*,
             const freud._locality.NeighborList*,
             freud._locality.QueryArgs,
-            unsigned int) except +
+            unsigned int) nogil except +
+        void computeSystems(
+            const freud._locality.SystemBatch &,
+            const quat[float]*,
+            freud._locality.QueryArgs,
+            unsigned int) nogil except +
         const freud.util.ManagedArray[float complex] &getSph() const
+        const freud.util.ManagedArray[float] &getPackedSph() const
         freud._locality.NeighborList * getNList()
         LocalDescriptorOrientation getMode() const
         bool getNegativeM() const
+        bool getPacked() const
 
 cdef extern from "MatchEnv.h" namespace "freud::environment":
     map[unsigned int, unsigned int] minimizeRMSD(
@@ -81,7 +89,7 @@ cdef extern from "MatchEnv.h" namespace "freud::environment":
                      const vec3[float]*,
                      unsigned int,
                      float,
-                     bool) except +
+                     bool) nogil except +
         const freud.util.ManagedArray[bool] &getMatches()
 
     cdef cppclass EnvironmentRMSDMinimizer(MatchEnv):
@@ -92,7 +100,7 @@ cdef extern from "MatchEnv.h" namespace "freud::environment":
             freud._locality.QueryArgs,
             const vec3[float]*,
             unsigned int,
-            bool) except +
+            bool) nogil except +
         const freud.util.ManagedArray[float] &getRMSDs()
 
     cdef cppclass EnvironmentCluster(MatchEnv):
@@ -104,7 +112,7 @@ cdef extern from "MatchEnv.h" namespace "freud::environment":
                      freud._locality.QueryArgs,
                      float,
                      bool,
-                     bool) except +
+                     bool) nogil except +
         unsigned int getNumClusters()
         const freud.util.ManagedArray[unsigned int] &getClusters()
         vector[vector[vec3[float]]] &getClusterEnvironments()
@@ -117,7 +125,7 @@ cdef extern from "AngularSeparation.h" namespace "freud::environment":
                      quat[float]*,
                      unsigned int,
                      quat[float]*,
-                     unsigned int) except +
+                     unsigned int) nogil except +
         const freud.util.ManagedArray[float] &getAngles() const
 
     cdef cppclass AngularSeparationNeighbor:
@@ -129,7 +137,7 @@ cdef extern from "AngularSeparation.h" namespace "freud::environment":
             const quat[float]*, unsigned int,
             const quat[float]*, unsigned int,
             const freud._locality.NeighborList*,
-            freud._locality.QueryArgs) except +
+            freud._locality.QueryArgs) nogil except +
         const freud.util.ManagedArray[float] &getAngles() const
         freud._locality.NeighborList * getNList()
 
@@ -140,7 +148,7 @@ cdef extern from "LocalBondProjection.h" namespace "freud::environment":
                      vec3[float]*, unsigned int, vec3[float]*, unsigned int,
                      quat[float]*, unsigned int, const
                      freud._locality.NeighborList*,
-                     freud._locality.QueryArgs) except +
+                     freud._locality.QueryArgs) nogil except +
 
         const freud.util.ManagedArray[float] &getProjections() const
         const freud.util.ManagedArray[float] &getNormedProjections() const
@@ -1,9 +1,11 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libc.stddef cimport ptrdiff_t
 from libcpp cimport bool
 from libcpp.memory cimport shared_ptr
 from libcpp.pair cimport pair
+from libcpp.string cimport string
 from libcpp.vector cimport vector
 
 cimport freud._box
@@ -36,6 +38,8 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         float r_guess
         float scale
         bool exclude_ii
+        bool half_list
+        bool all_images
 
     cdef cppclass NeighborQuery:
         NeighborQuery() except +
@@ -48,6 +52,7 @@ cdef extern from "NeighborQuery.h" namespace "freud::locality":
         const vec3[float]* getPoints const
         const unsigned int getNPoints const
         const vec3[float] operator[](unsigned int) const
+        bool isSpatiallySorted() const
 
     NeighborBond ITERATOR_TERMINATOR \
         "freud::locality::ITERATOR_TERMINATOR"
@@ -67,11 +72,21 @@ cdef extern from "RawPoints.h" namespace "freud::locality":
                   const vec3[float]*,
                   unsigned int) except +
 
+cdef extern from "StridedPoints.h" namespace "freud::locality":
+
+    cdef cppclass StridedPoints:
+        StridedPoints(const void*,
+                      unsigned int,
+                      ptrdiff_t,
+                      ptrdiff_t,
+                      bool) except +
+        void copyTo(vec3[float]*) const
+
 cdef extern from "NeighborList.h" namespace "freud::locality":
     cdef cppclass NeighborList:
         NeighborList()
-        NeighborList(unsigned int)
-        NeighborList(unsigned int, const unsigned int*, unsigned int,
+        NeighborList(size_t)
+        NeighborList(size_t, const unsigned int*, unsigned int,
                      const unsigned int*, unsigned int, const float*,
                      const float*) except +
         NeighborList(const vec3[float]*, const vec3[float]*,
@@ -81,22 +96,27 @@ cdef extern from "NeighborList.h" namespace "freud::locality":
         freud.util.ManagedArray[unsigned int] &getNeighbors()
         freud.util.ManagedArray[float] &getDistances()
         freud.util.ManagedArray[float] &getWeights()
-        freud.util.ManagedArray[float] &getSegments()
-        freud.util.ManagedArray[float] &getCounts()
+        freud.util.ManagedArray[size_t] &getSegments()
+        freud.util.ManagedArray[unsigned int] &getCounts()
 
-        unsigned int getNumBonds() const
+        size_t getNumBonds() const
         unsigned int getNumPoints() const
         unsigned int getNumQueryPoints() const
-        void setNumBonds(unsigned int, unsigned int, unsigned int)
-        unsigned int filter[Iterator](const Iterator) except +
-        unsigned int filter_r(float, float) except +
+        void setNumBonds(size_t, unsigned int, unsigned int)
+        bool isHalfList() const
+        size_t filter[Iterator](const Iterator) except +
+        size_t filter_r(float, float) except +
 
-        unsigned int find_first_index(unsigned int)
+        size_t find_first_index(unsigned int)
 
-        void resize(unsigned int)
+        void resize(size_t)
         void copy(const NeighborList &)
         void validate(unsigned int, unsigned int) except +
         void sort(bool)
+        void save(const string&) except +
+
+        @staticmethod
+        NeighborList *load(const string&) except +
 
 cdef extern from "LinkCell.h" namespace "freud::locality":
     cdef cppclass LinkCell(NeighborQuery):
@@ -104,15 +124,30 @@ cdef extern from "LinkCell.h" namespace "freud::locality":
         LinkCell(const freud._box.Box &,
                  const vec3[float]*,
                  unsigned int,
-                 float) except +
+                 float,
+                 bool) except +
         float getCellWidth() const
+        void updateCellList(const vec3[float]*, unsigned int) except +
 
 cdef extern from "AABBQuery.h" namespace "freud::locality":
     cdef cppclass AABBQuery(NeighborQuery):
         AABBQuery() except +
         AABBQuery(const freud._box.Box,
                   const vec3[float]*,
-                  unsigned int) except +
+                  unsigned int,
+                  bool,
+                  bool) except +
+        void update(const vec3[float]*, unsigned int) except +
+        void setRadii(const float*) except +
+        bool hasRadii() const
+        NeighborList * queryContacts(
+            const vec3[float]*, const float*, unsigned int, float,
+            bool) nogil except +
+
+cdef extern from "NeighborComputeFunctional.h" namespace "freud::locality":
+    vector[NeighborList*] makeBatchNlists(
+        const NeighborQuery*, const vec3[float]*, unsigned int,
+        vector[QueryArgs]) nogil except +
 
 cdef extern from "BondHistogramCompute.h" namespace "freud::locality":
     cdef cppclass BondHistogramCompute:
@@ -126,6 +161,26 @@ cdef extern from "BondHistogramCompute.h" namespace "freud::locality":
         vector[pair[float, float]] getBounds() const
         vector[size_t] getAxisSizes() const
 
+cdef extern from "BondPipeline.h" namespace "freud::locality":
+    cdef cppclass BondStage:
+        pass
+
+    void computeBondStages(
+        const vector[BondStage*] &,
+        const NeighborQuery*,
+        const vec3[float]*,
+        unsigned int,
+        const NeighborList*,
+        QueryArgs) nogil except +
+
+    void computeBondStagesFrames(
+        const vector[BondStage*] &,
+        const freud._box.Box &,
+        const vec3[float]*,
+        unsigned int,
+        unsigned int,
+        QueryArgs) nogil except +
+
 cdef extern from "PeriodicBuffer.h" namespace "freud::locality":
     cdef cppclass PeriodicBuffer:
         PeriodicBuffer()
@@ -135,15 +190,19 @@ cdef extern from "PeriodicBuffer.h" namespace "freud::locality":
             const NeighborQuery*,
             const vec3[float],
             const bool,
-            const bool) except +
-        vector[vec3[float]] getBufferPoints() const
-        vector[uint] getBufferIds() const
+            const bool,
+            const bool) nogil except +
+        const freud.util.ManagedArray[vec3[float]] &getBufferPoints() const
+        const freud.util.ManagedArray[uint] &getBufferIds() const
+        const freud.util.ManagedArray[vec3[int]] &getBufferImages() const
+        bool getComputePoints() const
 
 cdef extern from "Voronoi.h" namespace "freud::locality":
     cdef cppclass Voronoi:
-        Voronoi()
+        Voronoi(bool)
         void compute(const NeighborQuery*) nogil except +
-        vector[vector[vec3[double]]] getPolytopes() const
+        const vector[vector[vec3[double]]] &getPolytopes() const
+        bool getComputePolytopes() const
         const freud.util.ManagedArray[double] &getVolumes() const
         shared_ptr[NeighborList] getNeighborList() const
 
@@ -154,7 +213,7 @@ cdef extern from "Filter.h" namespace "freud::locality":
                      const vec3[float] *,
                      unsigned int,
                      const NeighborList *,
-                     QueryArgs) except +
+                     QueryArgs) nogil except +
         shared_ptr[NeighborList] getFilteredNlist() const
         shared_ptr[NeighborList] getUnfilteredNlist() const
 
@@ -165,3 +224,57 @@ cdef extern from "FilterSANN.h" namespace "freud::locality":
 cdef extern from "FilterRAD.h" namespace "freud::locality":
     cdef cppclass FilterRAD(Filter):
         FilterRAD(bool, bool)
+
+cdef extern from "VerletList.h" namespace "freud::locality":
+    cdef cppclass VerletList:
+        VerletList(float) except +
+        void compute(const NeighborQuery *,
+                     const vec3[float] *,
+                     unsigned int,
+                     QueryArgs) nogil except +
+        void reset()
+        shared_ptr[NeighborList] getNeighborList() const
+        float getSkin() const
+        bool getRebuilt() const
+        unsigned int getNumRebuilds() const
+
+cdef extern from "FramePipeline.h" namespace "freud::locality":
+    cdef cppclass Frame:
+        void assign(const freud._box.Box &, const vec3[float]*, unsigned int)
+
+    cdef cppclass FrameReader:
+        FrameReader()
+
+    ctypedef bool (*FrameReadFunction)(void*, Frame&)
+    FrameReader makeFrameReader(FrameReadFunction, void*)
+
+cdef extern from "SlabDecomposition.h" namespace "freud::locality":
+    cdef cppclass PointReader:
+        PointReader()
+
+    ctypedef bool (*PointReadFunction)(void*, size_t, size_t, vec3[float]*)
+    PointReader makePointReader(PointReadFunction, void*)
+
+    cdef cppclass Slab:
+        vector[vec3[float]] points
+        vector[size_t] indices
+        unsigned int n_core
+
+    cdef cppclass SlabDecomposition:
+        SlabDecomposition(const freud._box.Box &, size_t, PointReader,
+                          unsigned int, float, size_t) except +
+        const freud._box.Box & getBox() const
+        size_t getNPoints() const
+        unsigned int getNumSlabs() const
+        float getHalo() const
+        void readSlab(unsigned int, Slab &) except +
+
+cdef extern from "SystemBatch.h" namespace "freud::locality":
+    cdef cppclass SystemBatch:
+        SystemBatch(vector[freud._box.Box], const vec3[float]*,
+                    vector[unsigned int]) nogil except +
+        unsigned int getNumSystems() const
+        unsigned int getNPoints() const
+        const vector[freud._box.Box] & getBoxes() const
+        const vector[unsigned int] & getOffsets() const
+        NeighborList * query(QueryArgs) nogil except +
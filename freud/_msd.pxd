@@ -0,0 +1,35 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+from libcpp cimport bool
+
+cimport freud._box
+cimport freud.util
+from freud.util cimport vec3
+
+
+cdef extern from "MultipleTauMSD.h" namespace "freud::msd":
+    cdef cppclass MultipleTauMSD:
+        MultipleTauMSD(unsigned int) except +
+        void reset()
+        void accumulate(const vec3[float]*, unsigned int,
+                        unsigned int) nogil except +
+        unsigned int getPointsPerLevel() const
+        const freud.util.ManagedArray[unsigned int] &getLags() const
+        const freud.util.ManagedArray[double] &getMSD() const
+
+
+cdef extern from "MSD.h" namespace "freud::msd":
+    ctypedef enum MSDMode:
+        Window
+        Direct
+
+    cdef cppclass MSD:
+        MSD(MSDMode) except +
+        void reset()
+        void compute(const freud._box.Box*, const vec3[float]*,
+                     const vec3[int]*, unsigned int, unsigned int,
+                     bool) nogil except +
+        MSDMode getMode() const
+        const freud.util.ManagedArray[double] &getMSD() const
+        const freud.util.ManagedArray[double] &getParticleMSD() const
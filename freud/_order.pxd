@@ -13,15 +13,20 @@ from freud.util cimport quat, vec3
 ctypedef float complex fcomplex
 
 cdef extern from "Cubatic.h" namespace "freud::order":
+    ctypedef enum CubaticOptimizer:
+        Annealing
+        GradientAscent
+
     cdef cppclass Cubatic:
         Cubatic(float,
                 float,
                 float,
                 unsigned int,
-                unsigned int) except +
+                unsigned int,
+                CubaticOptimizer) except +
         void reset()
         void compute(quat[float]*,
-                     unsigned int) except +
+                     unsigned int) nogil except +
         unsigned int getNumParticles() const
         float getCubaticOrderParameter() const
         const freud.util.ManagedArray[float] &getParticleOrderParameter() const
@@ -33,6 +38,7 @@ cdef extern from "Cubatic.h" namespace "freud::order":
         float getScale() const
         unsigned int getNReplicates() const
         unsigned int getSeed() const
+        CubaticOptimizer getOptimizer() const
 
 
 cdef extern from "Nematic.h" namespace "freud::order":
@@ -40,21 +46,22 @@ cdef extern from "Nematic.h" namespace "freud::order":
         Nematic(vec3[float])
         void reset()
         void compute(quat[float]*,
-                     unsigned int) except +
+                     unsigned int, bool) nogil except +
         unsigned int getNumParticles() const
         float getNematicOrderParameter() const
         const freud.util.ManagedArray[float] &getParticleTensor() const
+        bool hasParticleTensor() const
         const freud.util.ManagedArray[float] &getNematicTensor() const
         vec3[float] getNematicDirector() const
         vec3[float] getU() const
 
 
 cdef extern from "HexaticTranslational.h" namespace "freud::order":
-    cdef cppclass Hexatic:
+    cdef cppclass Hexatic(freud._locality.BondStage):
         Hexatic(unsigned int, bool)
         void compute(const freud._locality.NeighborList*,
                      const freud._locality.NeighborQuery*,
-                     freud._locality.QueryArgs) except +
+                     freud._locality.QueryArgs) nogil except +
         const freud.util.ManagedArray[fcomplex] &getOrder()
         unsigned int getK()
         bool isWeighted() const
@@ -63,23 +70,27 @@ cdef extern from "HexaticTranslational.h" namespace "freud::order":
         Translational(float, bool)
         void compute(const freud._locality.NeighborList*,
                      const freud._locality.NeighborQuery*,
-                     freud._locality.QueryArgs) except +
+                     freud._locality.QueryArgs) nogil except +
         const freud.util.ManagedArray[fcomplex] &getOrder() const
         float getK() const
         bool isWeighted() const
 
 
 cdef extern from "Steinhardt.h" namespace "freud::order":
-    cdef cppclass Steinhardt:
+    cdef cppclass Steinhardt(freud._locality.BondStage):
         Steinhardt(vector[unsigned int], bool, bool, bool, bool) except +
         unsigned int getNP() const
         void compute(const freud._locality.NeighborList*,
                      const freud._locality.NeighborQuery*,
-                     freud._locality.QueryArgs) except +
+                     freud._locality.QueryArgs) nogil except +
+        void computeSystems(const freud._locality.SystemBatch &,
+                            freud._locality.QueryArgs) nogil except +
         const freud.util.ManagedArray[float] &getQl() const
-        const vector[freud.util.ManagedArray[fcomplex]] &getQlm() const
+        const freud.util.ManagedArray[fcomplex] &getQlm() const
+        vector[unsigned int] getMOffsets() const
         const freud.util.ManagedArray[float] &getParticleOrder() const
         vector[float] getOrder() const
+        const freud.util.ManagedArray[float] &getSystemOrder() const
         bool isAverage() const
         bool isWl() const
         bool isWeighted() const
@@ -98,6 +109,9 @@ cdef extern from "SolidLiquid.h" namespace "freud::order":
                      const freud._locality.NeighborQuery*,
                      freud._locality.QueryArgs) nogil except +
         unsigned int getLargestClusterSize() const
+        vector[unsigned int] computeLargestClusterSizes(
+            const vector[float] &,
+            const vector[unsigned int] &) const except +
         vector[unsigned int] getClusterSizes() const
         const freud.util.ManagedArray[unsigned int] &getClusterIdx() const
         const freud.util.ManagedArray[unsigned int] &getNumberOfConnections() \
@@ -115,4 +129,9 @@ cdef extern from "RotationalAutocorrelation.h" namespace "freud::order":
         unsigned int getL() const
         const freud.util.ManagedArray[fcomplex] &getRAArray() const
         float getRotationalAutocorrelation() const
-        void compute(quat[float]*, quat[float]*, unsigned int) except +
+        void compute(quat[float]*, quat[float]*, unsigned int) nogil except +
+        void resetFrames(unsigned int) except +
+        void accumulateFrames(quat[float]*, unsigned int,
+                              unsigned int) nogil except +
+        const freud.util.ManagedArray[unsigned int] &getLags() const
+        const freud.util.ManagedArray[float] &getLagAutocorrelation() const
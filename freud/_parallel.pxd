@@ -1,5 +1,66 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp cimport bool
+from libcpp.string cimport string
+from libcpp.vector cimport vector
+
+
 cdef extern from "tbb_config.h" namespace "freud::parallel":
     void setNumThreads(unsigned int)
+    void pushThreadArena(unsigned int, int, int) except +
+    void popThreadArena()
+    vector[int] getNumaNodes()
+
+cdef extern from "utils.h" namespace "freud::util":
+    bool getDeterministicReductions()
+    void setDeterministicReductions(bool)
+
+    ctypedef enum AccumulatorPrecision "freud::util::AccumulatorPrecision":
+        accumulate_automatic "freud::util::AccumulatorPrecision::automatic"
+        accumulate_single "freud::util::AccumulatorPrecision::single"
+        accumulate_mixed "freud::util::AccumulatorPrecision::mixed"
+
+    AccumulatorPrecision getAccumulatorPrecision()
+    void setAccumulatorPrecision(AccumulatorPrecision)
+
+cdef extern from "GrainTuner.h" namespace "freud::util":
+    cdef struct TunedGrainSize:
+        string loop
+        unsigned int log2_size
+        unsigned int concurrency
+        size_t grain_size
+
+    vector[TunedGrainSize] getTunedGrainSizes()
+    void setTunedGrainSizes(const vector[TunedGrainSize]&) except +
+    bool getGrainTuning()
+    void setGrainTuning(bool)
+
+cdef extern from "Instrumentation.h" namespace "freud::util":
+    cdef struct PhaseStatistics:
+        string phase
+        size_t calls
+        double seconds
+        size_t bonds
+        size_t bytes
+
+    bool getInstrumentation()
+    void setInstrumentation(bool)
+    vector[PhaseStatistics] getPhaseStatistics()
+    void resetPhaseStatistics()
+
+cdef extern from "BufferPool.h" namespace "freud::util":
+    cdef struct MemoryUsage:
+        string owner
+        size_t current
+        size_t peak
+
+    cdef cppclass BufferPool:
+        @staticmethod
+        BufferPool& getInstance()
+        vector[MemoryUsage] getMemoryUsage() const
+        size_t getBytesInUse() const
+        size_t getPeakBytesInUse() const
+        void resetPeakMemory()
+        void setMemoryBudget(size_t)
+        size_t getMemoryBudget() const
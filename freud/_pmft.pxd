@@ -1,6 +1,8 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+from libcpp cimport bool
+
 cimport freud._locality
 cimport freud.util
 from freud._locality cimport BondHistogramCompute
@@ -11,10 +13,14 @@ cdef extern from "PMFT.h" namespace "freud::pmft":
     cdef cppclass PMFT(BondHistogramCompute):
         PMFT() except +
         const freud.util.ManagedArray[float] &getPCF()
+        bool isSparse() const
+        const freud.util.ManagedArray[unsigned int] &getSparseBins()
+        const freud.util.ManagedArray[unsigned int] &getSparseBinCounts()
+        const freud.util.ManagedArray[float] &getSparsePCF()
 
 cdef extern from "PMFTR12.h" namespace "freud::pmft":
     cdef cppclass PMFTR12(PMFT):
-        PMFTR12(float, unsigned int, unsigned int, unsigned int) except +
+        PMFTR12(float, unsigned int, unsigned int, unsigned int, bool) except +
 
         void accumulate(const freud._locality.NeighborQuery*,
                         const float*,
@@ -22,7 +28,7 @@ cdef extern from "PMFTR12.h" namespace "freud::pmft":
                         const float*,
                         unsigned int,
                         const freud._locality.NeighborList*,
-                        freud._locality.QueryArgs) except +
+                        freud._locality.QueryArgs) nogil except +
 
 cdef extern from "PMFTXYT.h" namespace "freud::pmft":
     cdef cppclass PMFTXYT(PMFT):
@@ -35,7 +41,7 @@ cdef extern from "PMFTXYT.h" namespace "freud::pmft":
                         const float*,
                         unsigned int,
                         const freud._locality.NeighborList*,
-                        freud._locality.QueryArgs) except +
+                        freud._locality.QueryArgs) nogil except +
 
 cdef extern from "PMFTXY.h" namespace "freud::pmft":
     cdef cppclass PMFTXY(PMFT):
@@ -46,12 +52,12 @@ cdef extern from "PMFTXY.h" namespace "freud::pmft":
                         const vec3[float]*,
                         unsigned int,
                         const freud._locality.NeighborList*,
-                        freud._locality.QueryArgs) except +
+                        freud._locality.QueryArgs) nogil except +
 
 cdef extern from "PMFTXYZ.h" namespace "freud::pmft":
     cdef cppclass PMFTXYZ(PMFT):
         PMFTXYZ(float, float, float, unsigned int, unsigned int,
-                unsigned int, vec3[float]) except +
+                unsigned int, vec3[float], bool) except +
 
         void accumulate(const freud._locality.NeighborQuery*,
                         const quat[float]*,
@@ -60,4 +66,4 @@ cdef extern from "PMFTXYZ.h" namespace "freud::pmft":
                         const quat[float]*,
                         unsigned int,
                         const freud._locality.NeighborList*,
-                        freud._locality.QueryArgs) except +
+                        freud._locality.QueryArgs) nogil except +
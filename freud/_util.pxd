@@ -2,6 +2,7 @@
 # This file is from the freud project, released under the BSD 3-Clause License.
 
 cimport numpy
+from libc.stdint cimport uint64_t
 from libcpp cimport bool
 from libcpp.vector cimport vector
 
@@ -27,6 +28,7 @@ cdef extern from "ManagedArray.h" namespace "freud::util":
         T *get()
         size_t size() const
         vector[size_t] shape() const
+        uint64_t getGeneration() const
 
 
 cdef extern from "numpy/arrayobject.h":
@@ -94,11 +94,12 @@ cdef class Cluster(_PairCompute):
                 keys, shape=(num_query_points, ), dtype=np.uint32)
             l_keys_ptr = &l_keys[0]
 
-        self.thisptr.compute(
-            nq.get_ptr(),
-            nlist.get_ptr(),
-            dereference(qargs.thisptr),
-            l_keys_ptr)
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                nlist.get_ptr(),
+                dereference(qargs.thisptr),
+                l_keys_ptr)
         return self
 
     @_Compute._computed_property
@@ -167,16 +168,34 @@ cdef class ClusterProperties(_Compute):
     Note:
         The center of mass and geometric center for each cluster are computed
         using the minimum image convention
+
+    Args:
+        compute_tensors (bool, optional):
+            Whether to compute the gyration and moment of inertia tensors. If
+            :code:`False`, only the centers, sizes, and masses of the clusters
+            are computed (Default value = :code:`True`).
     """
 
     cdef freud._cluster.ClusterProperties * thisptr
 
-    def __cinit__(self):
-        self.thisptr = new freud._cluster.ClusterProperties()
+    def __cinit__(self, compute_tensors=True):
+        self.thisptr = new freud._cluster.ClusterProperties(compute_tensors)
 
-    def __init__(self):
+    def __init__(self, compute_tensors=True):
         pass
 
+    def _check_compute_tensors(self):
+        if not self.thisptr.getComputeTensors():
+            raise AttributeError(
+                "Tensors are only available if this ClusterProperties object "
+                "was constructed with compute_tensors=True.")
+
+    @property
+    def compute_tensors(self):
+        """bool: Whether the gyration and moment of inertia tensors are
+        computed."""
+        return self.thisptr.getComputeTensors()
+
     def __dealloc__(self):
         del self.thisptr
 
@@ -198,7 +217,7 @@ cdef class ClusterProperties(_Compute):
             >>> # Compute cluster properties based on identified clusters
             >>> cl_props = freud.cluster.ClusterProperties()
             >>> cl_props.compute((box, points), cl.cluster_idx)
-            freud.cluster.ClusterProperties()
+            freud.cluster.ClusterProperties(compute_tensors=True)
 
         Args:
             system:
@@ -222,9 +241,10 @@ cdef class ClusterProperties(_Compute):
             l_masses = freud.util._convert_array(masses, shape=(len(masses), ))
             l_masses_ptr = &l_masses[0]
 
-        self.thisptr.compute(nq.get_ptr(),
-                             <unsigned int*> &l_cluster_idx[0],
-                             l_masses_ptr)
+        with nogil:
+            self.thisptr.compute(nq.get_ptr(),
+                                 <unsigned int*> &l_cluster_idx[0],
+                                 l_masses_ptr)
         return self
 
     @_Compute._computed_property
@@ -276,8 +296,9 @@ cdef class ClusterProperties(_Compute):
             \end{bmatrix}
 
         where :math:`\mathbf{S}_k` is the gyration tensor of the :math:`k` th
-        cluster.
+        cluster. Only available if :code:`compute_tensors` is :code:`True`.
         """
+        self._check_compute_tensors()
         return freud.util.make_managed_numpy_array(
             &self.thisptr.getClusterGyrations(),
             freud.util.arr_type_t.FLOAT)
@@ -296,8 +317,9 @@ cdef class ClusterProperties(_Compute):
             \end{bmatrix}
 
         where :math:`\mathbf{I}_k` is the inertia tensor of the :math:`k` th
-        cluster.
+        cluster. Only available if :code:`compute_tensors` is :code:`True`.
         """
+        self._check_compute_tensors()
         return freud.util.make_managed_numpy_array(
             &self.thisptr.getClusterMomentsOfInertia(),
             freud.util.arr_type_t.FLOAT)
@@ -328,11 +350,142 @@ cdef class ClusterProperties(_Compute):
             R_g^k = \left(\frac{1}{M} \sum_{i=0}^{N_k} m_i s_i^2 \right)^{1/2}
 
         where :math:`s_i` is the distance of particle :math:`i` from
-        the center of mass.
+        the center of mass. Only available if :code:`compute_tensors` is
+        :code:`True`.
 
         """
         return np.sqrt(np.trace(self.inertia_tensors, axis1=-2, axis2=-1)
                        /(2*self.cluster_masses))
 
+    def __repr__(self):
+        return "freud.cluster.{cls}(compute_tensors={compute_tensors})".format(
+            cls=type(self).__name__, compute_tensors=self.compute_tensors)
+
+
+cdef class ClusterTracker(_PairCompute):
+    r"""Tracks clusters of points across frames with persistent IDs.
+
+    Each call to :meth:`~.compute` finds the clusters of a frame like
+    :class:`~.Cluster`, then matches them to the clusters of the previous
+    frame by the number of points they share. A cluster of the current frame
+    and a cluster of the previous frame are matched if each shares more points
+    with the other than with any other cluster. A matched cluster keeps the ID
+    of the previous cluster, and all other clusters are given new IDs, so IDs
+    persist while clusters grow, shrink, or move.
+
+    Clusters that are not matched are reported as events. A previous cluster
+    that is not matched has merged into the current cluster holding most of
+    its points, and a current cluster that is not matched has split from the
+    previous cluster holding most of its points.
+
+    Note:
+        The points must be the same, in the same order, in every frame. Call
+        :meth:`~.reset` before tracking a different system.
+    """
+
+    cdef freud._cluster.ClusterTracker * thisptr
+
+    def __cinit__(self):
+        self.thisptr = new freud._cluster.ClusterTracker()
+
+    def __init__(self):
+        pass
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system, neighbors=None):
+        r"""Compute the clusters of the next frame and match them to the
+        clusters of the previous frame.
+
+        Example::
+
+            >>> box = freud.box.Box.cube(10)
+            >>> points = np.array([[0, 0, 0], [1, 0, 0], [4, 0, 0]])
+            >>> tracker = freud.cluster.ClusterTracker()
+            >>> tracker.compute((box, points), {'r_max': 1.5}).cluster_idx
+            array([0, 0, 1], dtype=uint32)
+            >>> points[2] = [2, 0, 0]
+            >>> tracker.compute((box, points), {'r_max': 1.5}).merges
+            array([[1, 0]], dtype=uint32)
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+        """
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, neighbors=neighbors)
+
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                nlist.get_ptr(),
+                dereference(qargs.thisptr))
+        return self
+
+    def reset(self):
+        r"""Forget the previous frame, so that the next frame assigns new
+        IDs."""
+        self.thisptr.reset()
+
+    @_Compute._computed_property
+    def num_clusters(self):
+        """int: The number of clusters in the last frame."""
+        return self.thisptr.getNumClusters()
+
+    @property
+    def frame_counter(self):
+        """int: The number of frames computed since the last reset."""
+        return self.thisptr.getFrameCounter()
+
+    @_Compute._computed_property
+    def cluster_idx(self):
+        """(:math:`N_{points}`) :class:`numpy.ndarray`: The persistent
+        cluster ID of each point."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getClusterIdx(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def cluster_ids(self):
+        """(:math:`N_{clusters}`) :class:`numpy.ndarray`: The persistent ID
+        of each cluster of the last frame, with clusters ordered from largest
+        to smallest like :attr:`Cluster.cluster_idx <.Cluster.cluster_idx>`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getClusterIds(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def merges(self):
+        """(:math:`N_{merges}`, 2) :class:`numpy.ndarray`: The ID of each
+        previous cluster that merged in the last frame, and the ID of the
+        cluster it merged into."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getMerges(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def splits(self):
+        """(:math:`N_{splits}`, 2) :class:`numpy.ndarray`: The ID of the
+        previous cluster of each cluster that split from it in the last frame,
+        and the new ID of the cluster that split."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getSplits(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
     def __repr__(self):
         return "freud.cluster.{cls}()".format(cls=type(self).__name__)
@@ -14,8 +14,9 @@ import numpy as np
 import freud.locality
 
 from cython.operator cimport dereference
+from libcpp cimport bool
 
-from freud.locality cimport _PairCompute, _SpatialHistogram1D
+from freud.locality cimport _PairCompute, _SpatialHistogram, _SpatialHistogram1D
 from freud.util cimport _Compute, vec3
 
 from collections.abc import Sequence
@@ -23,6 +24,7 @@ from collections.abc import Sequence
 cimport numpy as np
 
 cimport freud._density
+cimport freud._locality
 cimport freud.box
 cimport freud.locality
 cimport freud.util
@@ -33,6 +35,21 @@ np.import_array()
 
 ctypedef unsigned int uint
 
+def _mesh_cell_indices(box, positions, mesh):
+    """Get the flat indices of the mesh cells containing positions."""
+    fractions = box.make_fractional(box.wrap(positions))[:, :len(mesh)]
+    cells = np.floor(fractions * mesh).astype(np.intp) % mesh
+    return np.ravel_multi_index(cells.T, mesh)
+
+
+def _mesh_deposit(cells, weights, mesh):
+    """Sum complex weights into the mesh cells with the given flat indices."""
+    n_cells = int(np.prod(mesh))
+    return (np.bincount(cells, weights=weights.real, minlength=n_cells)
+            + 1j * np.bincount(cells, weights=weights.imag,
+                               minlength=n_cells)).reshape(mesh)
+
+
 cdef class CorrelationFunction(_SpatialHistogram1D):
     r"""Computes the complex pairwise correlation function.
 
@@ -60,24 +77,58 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
             The number of bins in the correlation function.
         r_max (float):
             Maximum pointwise distance to include in the calculation.
+        dtype (:class:`numpy.dtype`, optional):
+            Precision of the values and of the correlation function, either
+            :code:`np.complex128` or :code:`np.complex64`. In single
+            precision, the products are summed in each bin with Kahan
+            compensation, which preserves the accuracy of the sums while
+            halving the memory of the values (Default value =
+            :code:`np.complex128`).
     """  # noqa E501
     cdef freud._density.CorrelationFunction[np.complex128_t] * thisptr
+    cdef freud._density.CorrelationFunction[np.complex64_t] * single_thisptr
     cdef is_complex
-
-    def __cinit__(self, unsigned int bins, float r_max):
-        self.thisptr = self.histptr = new \
-            freud._density.CorrelationFunction[np.complex128_t](bins, r_max)
+    cdef _dtype
+
+    def __cinit__(self, unsigned int bins, float r_max, dtype=np.complex128):
+        self._dtype = np.dtype(dtype)
+        if self._dtype == np.complex128:
+            self.thisptr = self.histptr = new \
+                freud._density.CorrelationFunction[np.complex128_t](
+                    bins, r_max)
+        elif self._dtype == np.complex64:
+            self.single_thisptr = self.histptr = new \
+                freud._density.CorrelationFunction[np.complex64_t](
+                    bins, r_max)
+        else:
+            raise ValueError(
+                "The dtype must be either np.complex128 or np.complex64.")
         self.r_max = r_max
         self.is_complex = False
 
     def __dealloc__(self):
-        del self.thisptr
+        if self.thisptr != NULL:
+            del self.thisptr
+        if self.single_thisptr != NULL:
+            del self.single_thisptr
 
     def compute(self, system, values, query_points=None,
-                query_values=None, neighbors=None, reset=True):
+                query_values=None, neighbors=None, reset=True, mesh=None):
         r"""Calculates the correlation function and adds to the current
         histogram.
 
+        If :code:`mesh` is provided, the correlation function is computed
+        from the values deposited on a mesh of the box instead of from
+        neighbor pairs. Each value is assigned to the mesh cell containing its
+        point, the correlations between all mesh cells are computed with fast
+        Fourier transforms, and each pair of mesh cells is binned by the
+        distance between their centers. The cost is independent of
+        :code:`r_max`, which makes long-range correlations of large systems
+        feasible, but distances are only resolved up to the size of a mesh
+        cell. The mesh cells should be much smaller than the bin width
+        :code:`r_max / bins`. The box must be periodic, and pairs are
+        counted at their minimum image distance.
+
         Args:
             system:
                 Any object that is a valid argument to
@@ -103,11 +154,26 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
                 value: True).
+            mesh (int or Sequence[int], optional):
+                The number of mesh cells in each dimension (identical in all
+                dimensions if a single integer value is provided) used to
+                compute the correlation function by fast Fourier transforms,
+                or :code:`None` to compute it from neighbor pairs. Cannot be
+                combined with :code:`neighbors` (Default value: None).
         """  # noqa E501
         if reset:
             self.is_complex = False
             self._reset()
 
+        if mesh is not None:
+            if neighbors is not None:
+                raise ValueError(
+                    "Neighbors cannot be specified when the correlation "
+                    "function is computed on a mesh.")
+            self._compute_mesh(system, values, query_points, query_values,
+                               mesh)
+            return self
+
         cdef:
             freud.locality.NeighborQuery nq
             freud.locality.NeighborList nlist
@@ -123,38 +189,165 @@ cdef class CorrelationFunction(_SpatialHistogram1D):
             np.any(np.iscomplex(query_values))
 
         values = freud.util._convert_array(
-            values, shape=(nq.points.shape[0], ), dtype=np.complex128)
+            values, shape=(nq.points.shape[0], ), dtype=self._dtype)
         if query_values is None:
             query_values = values
         else:
             query_values = freud.util._convert_array(
                 query_values, shape=(l_query_points.shape[0], ),
-                dtype=np.complex128)
+                dtype=self._dtype)
+
+        cdef np.complex128_t[::1] l_values
+        cdef np.complex128_t[::1] l_query_values
+        cdef np.complex64_t[::1] l_single_values
+        cdef np.complex64_t[::1] l_single_query_values
+
+        if self.thisptr != NULL:
+            l_values = values
+            l_query_values = query_values
+            with nogil:
+                self.thisptr.accumulate(
+                    nq.get_ptr(),
+                    <np.complex128_t*> &l_values[0],
+                    <vec3[float]*> &l_query_points[0, 0],
+                    <np.complex128_t*> &l_query_values[0],
+                    num_query_points, nlist.get_ptr(),
+                    dereference(qargs.thisptr))
+        else:
+            l_single_values = values
+            l_single_query_values = query_values
+            with nogil:
+                self.single_thisptr.accumulate(
+                    nq.get_ptr(),
+                    <np.complex64_t*> &l_single_values[0],
+                    <vec3[float]*> &l_query_points[0, 0],
+                    <np.complex64_t*> &l_single_query_values[0],
+                    num_query_points, nlist.get_ptr(),
+                    dereference(qargs.thisptr))
+        return self
 
-        cdef np.complex128_t[::1] l_values = values
-        cdef np.complex128_t[::1] l_query_values = query_values
+    def _compute_mesh(self, system, values, query_points, query_values,
+                      mesh):
+        r"""Accumulate the correlation function from the Fourier transforms
+        of the values deposited on a mesh."""
+        cdef freud.locality.NeighborQuery nq = \
+            freud.locality.NeighborQuery.from_system(system)
+        cdef freud.box.Box b = nq.box
+        dimensions = b.dimensions
+        if not all(b.periodic[:dimensions]):
+            raise ValueError(
+                "The correlation function can only be computed on a mesh in "
+                "periodic boxes.")
+        if isinstance(mesh, int):
+            mesh = (mesh,) * dimensions
+        elif isinstance(mesh, Sequence) and len(mesh) == dimensions:
+            mesh = tuple(int(m) for m in mesh)
+        else:
+            raise ValueError("The mesh must be either a number of cells or a "
+                             "sequence indicating the number of cells in each "
+                             "spatial dimension.")
+
+        # Self pairs are excluded like in the neighbor query of the points
+        # with themselves.
+        points = nq.points
+        exclude_ii = query_points is None
+        if exclude_ii:
+            query_points = points
+        else:
+            query_points = freud.util._convert_array(
+                query_points, shape=(None, 3))
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            <np.complex128_t*> &l_values[0],
-            <vec3[float]*> &l_query_points[0, 0],
-            <np.complex128_t*> &l_query_values[0],
-            num_query_points, nlist.get_ptr(),
-            dereference(qargs.thisptr))
-        return self
+        self.is_complex = self.is_complex or np.any(np.iscomplex(values)) or \
+            np.any(np.iscomplex(query_values))
+        values = freud.util._convert_array(
+            values, shape=(points.shape[0], ), dtype=np.complex128)
+        if query_values is None:
+            query_values = values
+        else:
+            query_values = freud.util._convert_array(
+                query_values, shape=(query_points.shape[0], ),
+                dtype=np.complex128)
+
+        n_cells = int(np.prod(mesh))
+        cells = _mesh_cell_indices(b, points, mesh)
+        query_cells = _mesh_cell_indices(b, query_points, mesh)
+
+        # Cross-correlations sum_x conj(a(x)) b(x + d) over the mesh
+        correlation_grid = np.fft.ifftn(
+            np.conj(np.fft.fftn(_mesh_deposit(cells, values, mesh)))
+            * np.fft.fftn(_mesh_deposit(query_cells, query_values, mesh)))
+        count_grid = np.fft.irfftn(
+            np.conj(np.fft.rfftn(
+                np.bincount(cells, minlength=n_cells).reshape(mesh)))
+            * np.fft.rfftn(
+                np.bincount(query_cells, minlength=n_cells).reshape(mesh)),
+            s=mesh)
+        if exclude_ii:
+            correlation_grid.flat[0] -= np.sum(np.conj(values) * query_values)
+            count_grid.flat[0] -= points.shape[0]
+
+        # Minimum image distances between the centers of mesh cells
+        fractions = np.meshgrid(*[np.fft.fftfreq(m) for m in mesh],
+                                indexing='ij')
+        fractions = np.stack(
+            [f.ravel() for f in fractions]
+            + [np.zeros(n_cells)] * (3 - dimensions), axis=-1)
+        distances = np.linalg.norm(fractions @ b.to_matrix().T, axis=-1)
+
+        in_range = distances < self.r_max
+        bins = np.minimum((distances[in_range] * (self.nbins / self.r_max))
+                          .astype(np.intp), self.nbins - 1)
+        correlation_grid = correlation_grid.ravel()[in_range]
+        correlation_sums = (
+            np.bincount(bins, weights=correlation_grid.real,
+                        minlength=self.nbins)
+            + 1j * np.bincount(bins, weights=correlation_grid.imag,
+                               minlength=self.nbins))
+        cdef unsigned int[::1] l_bin_counts = np.rint(
+            np.bincount(bins, weights=count_grid.ravel()[in_range],
+                        minlength=self.nbins)).astype(np.uint32)
+
+        cdef np.complex128_t[::1] l_correlation_sums
+        cdef np.complex64_t[::1] l_single_correlation_sums
+        cdef unsigned int num_points = points.shape[0]
+        cdef unsigned int num_query_points = query_points.shape[0]
+        if self.thisptr != NULL:
+            l_correlation_sums = correlation_sums.astype(np.complex128)
+            with nogil:
+                self.thisptr.accumulateBinned(
+                    dereference(b.thisptr), &l_correlation_sums[0],
+                    &l_bin_counts[0], num_points, num_query_points)
+        else:
+            l_single_correlation_sums = correlation_sums.astype(np.complex64)
+            with nogil:
+                self.single_thisptr.accumulateBinned(
+                    dereference(b.thisptr), &l_single_correlation_sums[0],
+                    &l_bin_counts[0], num_points, num_query_points)
 
     @_Compute._computed_property
     def correlation(self):
         """(:math:`N_{bins}`) :class:`numpy.ndarray`: Expected (average)
         product of all values at a given radial distance."""
-        output = freud.util.make_managed_numpy_array(
-            &self.thisptr.getCorrelation(),
-            freud.util.arr_type_t.COMPLEX_DOUBLE)
+        if self.thisptr != NULL:
+            output = freud.util.make_managed_numpy_array(
+                &self.thisptr.getCorrelation(),
+                freud.util.arr_type_t.COMPLEX_DOUBLE)
+        else:
+            output = freud.util.make_managed_numpy_array(
+                &self.single_thisptr.getCorrelation(),
+                freud.util.arr_type_t.COMPLEX_FLOAT)
         return output if self.is_complex else np.real(output)
 
+    @property
+    def dtype(self):
+        """:class:`numpy.dtype`: Precision of the correlation function."""
+        return self._dtype
+
     def __repr__(self):
-        return ("freud.density.{cls}(bins={bins}, r_max={r_max})").format(
-            cls=type(self).__name__, bins=self.nbins, r_max=self.r_max)
+        return ("freud.density.{cls}(bins={bins}, r_max={r_max}, "
+                "dtype='{dtype}')").format(
+                    cls=type(self).__name__, bins=self.nbins,
+                    r_max=self.r_max, dtype=self._dtype)
 
     def plot(self, ax=None):
         """Plot complex correlation function.
@@ -261,8 +454,9 @@ cdef class GaussianDensity(_Compute):
                 values, shape=(nq.points.shape[0], ))
             l_values_ptr = &l_values[0]
 
-        self.thisptr.compute(nq.get_ptr(),
-                             l_values_ptr)
+        with nogil:
+            self.thisptr.compute(nq.get_ptr(),
+                                 l_values_ptr)
         return self
 
     @_Compute._computed_property
@@ -340,10 +534,14 @@ cdef class SphereVoxelization(_Compute):
             in all dimensions if a single integer value is provided).
         r_max (float):
             Sphere radius.
+        packed (bool, optional):
+            If :code:`True`, store the voxels with one bit per voxel instead of
+            computing a dense array of voxels. The packed voxels are available
+            from :attr:`packed_voxels`. (Default value = :code:`False`).
     """
     cdef freud._density.SphereVoxelization * thisptr
 
-    def __cinit__(self, width, r_max):
+    def __cinit__(self, width, r_max, packed=False):
         cdef vec3[uint] width_vector
         if isinstance(width, int):
             width_vector = vec3[uint](width, width, width)
@@ -357,7 +555,7 @@ cdef class SphereVoxelization(_Compute):
                              "dimension (length 2 in 2D, length 3 in 3D).")
 
         self.thisptr = new freud._density.SphereVoxelization(width_vector,
-                                                             r_max)
+                                                             r_max, packed)
 
     def __dealloc__(self):
         del self.thisptr
@@ -377,20 +575,51 @@ cdef class SphereVoxelization(_Compute):
         """
         cdef freud.locality.NeighborQuery nq = \
             freud.locality.NeighborQuery.from_system(system)
-        self.thisptr.compute(nq.get_ptr())
+        with nogil:
+            self.thisptr.compute(nq.get_ptr())
         return self
 
     @_Compute._computed_property
     def voxels(self):
         """(:math:`w_x`, :math:`w_y`, :math:`w_z`) :class:`numpy.ndarray`: The
-        voxel grid indicating overlap with the computed spheres."""
-        data = freud.util.make_managed_numpy_array(
-            &self.thisptr.getVoxels(), freud.util.arr_type_t.UNSIGNED_INT)
+        voxel grid indicating overlap with the computed spheres.
+
+        If the voxels are packed, they are unpacked into a new array."""
+        if self.packed:
+            width = self.width
+            data = np.unpackbits(
+                self.packed_voxels, axis=-1,
+                count=width[1] * width[2]).astype(np.uint32).reshape(width)
+        else:
+            data = freud.util.make_managed_numpy_array(
+                &self.thisptr.getVoxels(), freud.util.arr_type_t.UNSIGNED_INT)
         if self.box.is2D:
             return np.squeeze(data)
         else:
             return data
 
+    @_Compute._computed_property
+    def packed_voxels(self):
+        """(:math:`w_x`, :math:`\\lceil w_y w_z / 8 \\rceil`) :class:`numpy.ndarray`:
+        The voxels of each slab of the grid along :math:`x` packed into bits
+        in row-major order, as returned by :func:`numpy.packbits`. Only
+        available if the voxels are packed.
+
+        The dense voxel grid is recovered with
+        :code:`np.unpackbits(packed_voxels, axis=-1, count=w_y * w_z)`."""
+        if not self.packed:
+            raise AttributeError(
+                "The voxels are only packed if packed=True is passed to the "
+                "constructor.")
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getPackedVoxels(),
+            freud.util.arr_type_t.UNSIGNED_CHAR)
+
+    @property
+    def packed(self):
+        """bool: Whether the voxels are stored packed into bits."""
+        return self.thisptr.isPacked()
+
     @property
     def r_max(self):
         """float: Sphere radius used for voxelization."""
@@ -404,10 +633,11 @@ cdef class SphereVoxelization(_Compute):
         return (width.x, width.y, width.z)
 
     def __repr__(self):
-        return ("freud.density.{cls}({width}, {r_max})").format(
-            cls=type(self).__name__,
-            width=self.width,
-            r_max=self.r_max)
+        return ("freud.density.{cls}({width}, {r_max}, packed={packed})"
+                ).format(cls=type(self).__name__,
+                         width=self.width,
+                         r_max=self.r_max,
+                         packed=self.packed)
 
     def plot(self, ax=None):
         """Plot voxelization.
@@ -489,9 +719,19 @@ cdef class LocalDensity(_PairCompute):
         """:class:`freud.box.Box`: Box used in the calculation."""
         return freud.box.BoxFromCPP(self.thisptr.getBox())
 
-    def compute(self, system, query_points=None, neighbors=None):
+    def compute(self, system, query_points=None, neighbors=None,
+                aggregate=False):
         r"""Calculates the local density for the specified points.
 
+        With :code:`aggregate=True`, the neighbors of a ball query of a
+        :class:`freud.locality.AABBQuery` are found in groups of the nodes of
+        its tree, and every group whose points are all a diameter inside of
+        :code:`r_max` is counted without computing its distances, which is
+        faster for :code:`r_max` much larger than the spacing of the points.
+        The number of neighbors only changes by the rounding of the sum. It
+        has no effect with a
+        :class:`NeighborList <freud.locality.NeighborList>` or other queries.
+
         Example::
 
             >>> import freud
@@ -515,6 +755,9 @@ cdef class LocalDensity(_PairCompute):
                 `query arguments
                 <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
                 (Default value: None).
+            aggregate (bool):
+                Whether to count the neighbors in groups fully inside of
+                :code:`r_max` (Default value: False).
         """  # noqa E501
         cdef:
             freud.locality.NeighborQuery nq
@@ -522,16 +765,24 @@ cdef class LocalDensity(_PairCompute):
             freud.locality._QueryArgs qargs
             const float[:, ::1] l_query_points
             unsigned int num_query_points
+            bool c_aggregate = aggregate
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, query_points, neighbors)
-        self.thisptr.compute(
-            nq.get_ptr(),
-            <vec3[float]*> &l_query_points[0, 0],
-            num_query_points, nlist.get_ptr(),
-            dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points, nlist.get_ptr(),
+                dereference(qargs.thisptr), c_aggregate)
         return self
 
+    cdef freud._locality.BondStage * _bond_stage(
+            self, freud.locality.NeighborQuery nq,
+            unsigned int num_query_points, dict inputs,
+            list keep_alive) except NULL:
+        return self.thisptr
+
     @property
     def default_query_args(self):
         """The default query arguments are
@@ -625,9 +876,18 @@ cdef class RDF(_SpatialHistogram1D):
             del self.thisptr
 
     def compute(self, system, query_points=None, neighbors=None,
-                reset=True):
+                reset=True, aggregate=False):
         r"""Calculates the RDF and adds to the current RDF histogram.
 
+        With :code:`aggregate=True`, the neighbors of a ball query of a
+        :class:`freud.locality.AABBQuery` are found in groups of the nodes of
+        its tree, and every group whose distances from a query point all fall
+        into one bin is added to that bin without computing its distances.
+        The bin counts are the same, but this is faster for large
+        :code:`r_max` with bins that are wide compared to the spacing of the
+        points. It has no effect with a
+        :class:`NeighborList <freud.locality.NeighborList>` or other queries.
+
         Args:
             system:
                 Any object that is a valid argument to
@@ -646,6 +906,9 @@ cdef class RDF(_SpatialHistogram1D):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
                 value: True).
+            aggregate (bool):
+                Whether to add the neighbors in groups that fall into one bin
+                (Default value: False).
         """  # noqa E501
         if reset:
             self._reset()
@@ -656,16 +919,167 @@ cdef class RDF(_SpatialHistogram1D):
             freud.locality._QueryArgs qargs
             const float[:, ::1] l_query_points
             unsigned int num_query_points
+            bool c_aggregate = aggregate
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, query_points, neighbors)
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            <vec3[float]*> &l_query_points[0, 0],
-            num_query_points, nlist.get_ptr(),
-            dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points, nlist.get_ptr(),
+                dereference(qargs.thisptr), c_aggregate)
+        return self
+
+    cdef freud._locality.BondStage * _bond_stage(
+            self, freud.locality.NeighborQuery nq,
+            unsigned int num_query_points, dict inputs,
+            list keep_alive) except NULL:
+        return self.thisptr
+
+    def compute_frames(self, frames, neighbors=None, reset=True):
+        r"""Calculates the RDF of each frame of a trajectory and adds them to
+        the current RDF histogram.
+
+        All frames are accumulated in a single call. Each frame is read and
+        converted, and its neighbor query data structure is built, while the
+        previous frame is accumulated. This is equivalent to calling
+        :meth:`compute` with ``reset=False`` for each frame.
+
+        Args:
+            frames (iterable):
+                Iterable of objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, such as a
+                trajectory.
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """
+        if isinstance(neighbors, freud.locality.NeighborList):
+            raise ValueError("compute_frames requires query arguments rather "
+                             "than a NeighborList.")
+        if reset:
+            self._reset()
+
+        cdef freud.locality._QueryArgs qargs
+        _, qargs = self._resolve_neighbors(neighbors)
+        cdef freud.locality._FrameSource source = \
+            freud.locality._FrameSource(frames)
+        cdef freud._locality.FrameReader reader = source.reader()
+        cdef freud._locality.QueryArgs c_qargs = dereference(qargs.thisptr)
+        with nogil:
+            self.thisptr.accumulateFrames(reader, c_qargs)
+        source.check()
         return self
 
+    def compute_slabs(self, slabs, neighbors=None, reset=True):
+        r"""Calculates the RDF of a point set that does not fit in memory
+        and adds it to the current RDF histogram.
+
+        The slabs are accumulated one after the other, with the points of
+        each slab as query points, and each slab is read while the previous
+        one is accumulated. The result is the same as that of
+        :meth:`compute` on the whole point set.
+
+        Args:
+            slabs (:class:`freud.locality.SlabDecomposition`):
+                The decomposition of the point set into slabs, whose halo
+                must be at least :code:`r_max`.
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                of a ball query (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """
+        if isinstance(neighbors, freud.locality.NeighborList):
+            raise ValueError("compute_slabs requires query arguments rather "
+                             "than a NeighborList.")
+        if reset:
+            self._reset()
+
+        cdef freud.locality.SlabDecomposition slab_decomposition = slabs
+        cdef freud.locality._QueryArgs qargs
+        _, qargs = self._resolve_neighbors(neighbors)
+        cdef freud._locality.QueryArgs c_qargs = dereference(qargs.thisptr)
+        try:
+            with nogil:
+                self.thisptr.accumulateSlabs(
+                    dereference(slab_decomposition.thisptr), c_qargs)
+        finally:
+            slab_decomposition.source.check()
+        return self
+
+    def compute_systems(self, batch, neighbors=None, reset=True):
+        r"""Calculates the RDF of every system of a batch and adds them to
+        the current RDF histogram.
+
+        The systems are computed in a single parallel loop, with the points of
+        each system as query points. Every system is accumulated as a frame,
+        so that :attr:`rdf` is the same as that of calling :meth:`compute`
+        with :code:`reset=False` on each system, while the RDF of each
+        system is :attr:`system_rdf`.
+
+        Args:
+            batch (:class:`freud.locality.SystemBatch`):
+                The systems to compute.
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                of every system (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """
+        if isinstance(neighbors, freud.locality.NeighborList):
+            raise ValueError("compute_systems requires query arguments rather "
+                             "than a NeighborList.")
+        if reset:
+            self._reset()
+
+        cdef freud.locality.SystemBatch system_batch = batch
+        cdef freud.locality._QueryArgs qargs
+        _, qargs = self._resolve_neighbors(neighbors)
+        cdef freud._locality.QueryArgs c_qargs = dereference(qargs.thisptr)
+        with nogil:
+            self.thisptr.accumulateSystems(
+                dereference(system_batch.thisptr), c_qargs)
+        return self
+
+    @_Compute._computed_property
+    def system_rdf(self):
+        """(:math:`N_{systems}`, :math:`N_{bins}`) :class:`numpy.ndarray`:
+        The RDF of each system of the last call to :meth:`compute_systems`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getSystemRDF(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def system_n_r(self):
+        """(:math:`N_{systems}`, :math:`N_{bins}`) :class:`numpy.ndarray`:
+        The cumulative bin counts :attr:`n_r` of each system of the last call
+        to :meth:`compute_systems`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getSystemNr(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def system_bin_counts(self):
+        """(:math:`N_{systems}`, :math:`N_{bins}`) :class:`numpy.ndarray`:
+        The bin counts of each system of the last call to
+        :meth:`compute_systems`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getSystemBinCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
     @_Compute._computed_property
     def rdf(self):
         """(:math:`N_{bins}`,) :class:`numpy.ndarray`: Histogram of RDF
@@ -716,3 +1130,183 @@ cdef class RDF(_SpatialHistogram1D):
             return freud.plot._ax_to_bytes(self.plot())
         except (AttributeError, ImportError):
             return None
+
+
+cdef class PartialRDF(_SpatialHistogram):
+    r"""Computes the partial RDFs :math:`g_{ab} \left( r \right)` of all
+    pairs of point types in a single pass over the bonds.
+
+    Each bond from a query point of type :math:`a` to a point of type
+    :math:`b` is counted in the partial RDF :math:`g_{ab}(r)`, so the partial
+    RDFs of all pairs of types are computed with one neighbor query instead of
+    one :class:`freud.density.RDF` computation per pair. The partial RDF
+    :math:`g_{ab}(r)` is normalized by the number of query points of type
+    :math:`a` and the number density of points of type :math:`b`, so it tends
+    to :math:`1` at large :math:`r` in homogeneous systems. With a single
+    type, the partial RDF is identical to :class:`freud.density.RDF`.
+
+    .. note::
+        **2D:** :class:`freud.density.PartialRDF` properly handles 2D boxes.
+        The points must be passed in as :code:`[x, y, 0]`.
+
+    Args:
+        num_types (unsigned int):
+            The number of point types. Types must be integers in
+            :code:`[0, num_types)`.
+        bins (unsigned int):
+            The number of bins in the RDFs.
+        r_max (float):
+            Maximum interparticle distance to include in the calculation.
+        r_min (float, optional):
+            Minimum interparticle distance to include in the calculation
+            (Default value = :code:`0`).
+        normalize (bool, optional):
+            Scale the partial RDFs of identical types by
+            :math:`\frac{N_a}{N_a-1}`, where :math:`N_a` is the number of
+            points of that type, as :code:`normalize` does for
+            :class:`freud.density.RDF` (Default value = :code:`False`).
+    """
+    cdef freud._density.PartialRDF * thisptr
+
+    def __cinit__(self, unsigned int num_types, unsigned int bins, float r_max,
+                  float r_min=0, normalize=False):
+        if type(self) == PartialRDF:
+            self.thisptr = self.histptr = new freud._density.PartialRDF(
+                num_types, bins, r_max, r_min, normalize)
+            self.r_max = r_max
+
+    def __dealloc__(self):
+        if type(self) == PartialRDF:
+            del self.thisptr
+
+    def compute(self, system, types, query_points=None, query_types=None,
+                neighbors=None, reset=True):
+        r"""Calculates the partial RDFs and adds to the current histograms.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            types ((:math:`N_{points}`) :class:`numpy.ndarray`):
+                Type of each point.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points used to calculate the RDFs. Uses the system's
+                points if :code:`None` (Default value =
+                :code:`None`).
+            query_types ((:math:`N_{query\_points}`) :class:`numpy.ndarray`, optional):
+                Type of each query point. Uses :code:`types` if
+                :code:`None` (Default value = :code:`None`).
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """  # noqa E501
+        if reset:
+            self._reset()
+
+        cdef:
+            freud.locality.NeighborQuery nq
+            freud.locality.NeighborList nlist
+            freud.locality._QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, query_points, neighbors)
+
+        types = freud.util._convert_array(
+            types, shape=(nq.points.shape[0], ), dtype=np.uint32)
+        if query_types is None:
+            query_types = types
+        else:
+            query_types = freud.util._convert_array(
+                query_types, shape=(l_query_points.shape[0], ),
+                dtype=np.uint32)
+
+        cdef const unsigned int[::1] l_types = types
+        cdef const unsigned int[::1] l_query_types = query_types
+
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                &l_types[0],
+                <vec3[float]*> &l_query_points[0, 0],
+                &l_query_types[0],
+                num_query_points, nlist.get_ptr(),
+                dereference(qargs.thisptr))
+        return self
+
+    @property
+    def num_types(self):
+        """unsigned int: The number of point types."""
+        return self.thisptr.getNumTypes()
+
+    @property
+    def bin_centers(self):
+        """:math:`(N_{bins}, )` :class:`numpy.ndarray`: The centers of each
+        distance bin."""
+        vec = self.histptr.getBinCenters()
+        return np.array(vec[2], copy=True)
+
+    @property
+    def bin_edges(self):
+        """:math:`(N_{bins}+1, )` :class:`numpy.ndarray`: The edges of each
+        distance bin. It is one element larger because each bin has a lower
+        and an upper bound."""
+        vec = self.histptr.getBinEdges()
+        return np.array(vec[2], copy=True)
+
+    @property
+    def bounds(self):
+        """tuple: A tuple indicating upper and lower bounds of the distance
+        bins."""
+        vec = self.histptr.getBounds()
+        return vec[2]
+
+    @property
+    def nbins(self):
+        """int: The number of distance bins."""
+        return self.histptr.getAxisSizes()[2]
+
+    @_Compute._computed_property
+    def bin_counts(self):
+        """(:math:`N_{types}`, :math:`N_{types}`, :math:`N_{bins}`)
+        :class:`numpy.ndarray`: The bond counts of each pair of query point
+        type and point type in each distance bin."""
+        return freud.util.make_managed_numpy_array(
+            &self.histptr.getBinCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def rdf(self):
+        """(:math:`N_{types}`, :math:`N_{types}`, :math:`N_{bins}`)
+        :class:`numpy.ndarray`: The partial RDF of each pair of query point
+        type and point type."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getRDF(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def n_r(self):
+        """(:math:`N_{types}`, :math:`N_{types}`, :math:`N_{bins}`)
+        :class:`numpy.ndarray`: Cumulative bin counts of each pair of types.
+        More precisely, :code:`n_r[a, b, i]` is the average number of points
+        of type :code:`b` contained within a ball of radius
+        :code:`bin_edges[i+1]` centered at a query point of type :code:`a`,
+        averaged over all query points of type :code:`a` in the last call to
+        :meth:`~.compute`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getNr(),
+            freud.util.arr_type_t.FLOAT)
+
+    def __repr__(self):
+        return ("freud.density.{cls}(num_types={num_types}, bins={bins}, "
+                "r_max={r_max}, r_min={r_min})").format(
+                    cls=type(self).__name__, num_types=self.num_types,
+                    bins=self.nbins, r_max=self.bounds[1],
+                    r_min=self.bounds[0])
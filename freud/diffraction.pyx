@@ -18,6 +18,7 @@ from libcpp.vector cimport vector
 from freud.util cimport _Compute, vec3
 
 import logging
+import time
 
 import numpy as np
 import rowan
@@ -28,6 +29,7 @@ import freud.locality
 cimport numpy as np
 
 cimport freud._diffraction
+cimport freud._locality
 cimport freud.locality
 cimport freud.util
 
@@ -66,6 +68,36 @@ cdef class _StaticStructureFactor(_Compute):
     def min_valid_k(self):
         return self.ssfptr.getMinValidK()
 
+    def compute_frames(self, frames, reset=True):
+        r"""Computes the static structure factor of each frame of a trajectory
+        and adds them to the current average.
+
+        All frames are accumulated in a single call. Each frame is read and
+        converted while the previous frame is accumulated. This is equivalent
+        to calling :meth:`compute` without ``query_points`` and with
+        ``reset=False`` for each frame.
+
+        Args:
+            frames (iterable):
+                Iterable of objects that are valid arguments to
+                :class:`freud.locality.NeighborQuery.from_system`, such as a
+                trajectory.
+            reset (bool, optional):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """
+        if reset:
+            self._reset()
+
+        cdef freud.locality._FrameSource source = \
+            freud.locality._FrameSource(frames)
+        cdef freud._locality.FrameReader reader = source.reader()
+        with nogil:
+            self.ssfptr.accumulateFrames(reader)
+        source.check()
+        return self
+
     def _repr_png_(self):
         try:
             import freud.plot
@@ -115,6 +147,16 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
     results than :py:attr:`freud.diffraction.StaticStructureFactorDirect`
     at low :math:`k` values.
 
+    By default, the sum above is evaluated for every pair of points, which
+    takes time proportional to :math:`N^2` times the number of :math:`k`
+    values. If ``num_distance_bins`` is nonzero, the pair distances are instead
+    accumulated into a histogram with that many bins, spanning all possible
+    distances, and the sum is evaluated once per bin at the mean distance of
+    its pairs. The cost of evaluating :math:`S(k)` then no longer depends on
+    :math:`N`, which makes large systems tractable. The approximation is
+    accurate as long as the bin width is small compared to
+    :math:`1/k_{max}`.
+
     .. note::
         This code assumes all particles have a form factor :math:`f` of 1.
 
@@ -140,15 +182,19 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
             are practical restrictions on the validity of the calculation in the
             long wavelength regime, see :py:attr:`min_valid_k` (Default value =
             0).
+        num_distance_bins (unsigned int, optional):
+            Number of bins of the pair distance histogram used to evaluate the
+            Debye equation. If 0, the equation is evaluated exactly for every
+            pair of points (Default value = 0).
     """
     cdef freud._diffraction.StaticStructureFactorDebye * thisptr
 
-    def __cinit__(self, unsigned int num_k_values, float k_max, float k_min=0):
+    def __cinit__(self, unsigned int num_k_values, float k_max, float k_min=0,
+                  unsigned int num_distance_bins=0):
         if type(self) == StaticStructureFactorDebye:
             self.thisptr = self.ssfptr = new \
-                freud._diffraction.StaticStructureFactorDebye(num_k_values,
-                                                              k_max,
-                                                              k_min)
+                freud._diffraction.StaticStructureFactorDebye(
+                    num_k_values, k_max, k_min, num_distance_bins)
 
     def __dealloc__(self):
         if type(self) == StaticStructureFactorDebye:
@@ -159,6 +205,12 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
         """int: The number of k values used."""
         return len(self.k_values)
 
+    @property
+    def num_distance_bins(self):
+        """int: The number of bins of the pair distance histogram, or 0 if the
+        Debye equation is evaluated exactly."""
+        return self.thisptr.getNumDistanceBins()
+
     @property
     def k_values(self):
         """:class:`numpy.ndarray`: The :math:`k` values for the calculation."""
@@ -251,11 +303,13 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
 
         if N_total is None:
             N_total = num_query_points
+        cdef unsigned int l_N_total = N_total
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            <vec3[float]*> &l_query_points[0, 0],
-            num_query_points, N_total)
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points, l_N_total)
         return self
 
     def _reset(self):
@@ -270,11 +324,13 @@ cdef class StaticStructureFactorDebye(_StaticStructureFactor):
 
     def __repr__(self):
         return ("freud.diffraction.{cls}(num_k_values={num_k_values}, "
-                "k_max={k_max}, k_min={k_min})").format(
+                "k_max={k_max}, k_min={k_min}, "
+                "num_distance_bins={num_distance_bins})").format(
                     cls=type(self).__name__,
                     num_k_values=self.num_k_values,
                     k_max=self.k_max,
-                    k_min=self.k_min)
+                    k_min=self.k_min,
+                    num_distance_bins=self.num_distance_bins)
 
     def plot(self, ax=None, **kwargs):
         r"""Plot static structure factor.
@@ -365,16 +421,24 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
             from the full grid with uniform radial density, resulting in a
             sample of ``num_sampled_k_points`` vectors on average (Default
             value = 0).
+        seed (unsigned int, optional):
+            Random seed used to sample :math:`\vec{k}` vectors. Whether a
+            :math:`\vec{k}` vector is sampled only depends on the seed and its
+            reciprocal lattice indices, so the same seed and box always give
+            the same :math:`\vec{k}` vectors. If :code:`None`, system time is
+            used (Default value = :code:`None`).
     """
 
     cdef freud._diffraction.StaticStructureFactorDirect * thisptr
 
     def __cinit__(self, unsigned int bins, float k_max, float k_min=0,
-                  unsigned int num_sampled_k_points=0):
+                  unsigned int num_sampled_k_points=0, seed=None):
+        if seed is None:
+            seed = int(time.time())
         if type(self) == StaticStructureFactorDirect:
             self.thisptr = self.ssfptr = \
                 new freud._diffraction.StaticStructureFactorDirect(
-                    bins, k_max, k_min, num_sampled_k_points)
+                    bins, k_max, k_min, num_sampled_k_points, seed)
 
     def __dealloc__(self):
         if type(self) == StaticStructureFactorDirect:
@@ -485,11 +549,13 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
 
         if N_total is None:
             N_total = num_points
+        cdef unsigned int l_N_total = N_total
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            l_query_points_ptr, num_query_points, N_total
-        )
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                l_query_points_ptr, num_query_points, l_N_total
+            )
         return self
 
     def _reset(self):
@@ -508,6 +574,12 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
         constructing :math:`k` space grid."""
         return self.thisptr.getNumSampledKPoints()
 
+    @property
+    def seed(self):
+        r"""unsigned int: Random seed used to sample :math:`\vec{k}`
+        vectors."""
+        return self.thisptr.getSeed()
+
     @_Compute._computed_property
     def k_points(self):
         r""":class:`numpy.ndarray`: The :math:`\vec{k}` points used in the
@@ -518,12 +590,14 @@ cdef class StaticStructureFactorDirect(_StaticStructureFactor):
     def __repr__(self):
         return ("freud.diffraction.{cls}(bins={bins}, "
                 "k_max={k_max}, k_min={k_min}, "
-                "num_sampled_k_points={num_sampled_k_points})").format(
+                "num_sampled_k_points={num_sampled_k_points}, "
+                "seed={seed})").format(
                     cls=type(self).__name__,
                     bins=self.nbins,
                     k_max=self.k_max,
                     k_min=self.k_min,
-                    num_sampled_k_points=self.num_sampled_k_points)
+                    num_sampled_k_points=self.num_sampled_k_points,
+                    seed=self.seed)
 
     def plot(self, ax=None, **kwargs):
         r"""Plot static structure factor.
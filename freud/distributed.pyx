@@ -0,0 +1,386 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+r"""
+The :class:`freud.distributed` module contains computes of point sets that
+are distributed over the ranks of an MPI communicator, so that every rank
+holds only the points of its domain of the box. This module is only built
+with MPI support, see :ref:`installation`, and requires :mod:`mpi4py`.
+"""
+
+import numpy as np
+
+import freud.locality
+
+from cython.operator cimport dereference
+from libc.stdint cimport uint64_t
+from libc.string cimport memcpy
+from libcpp.vector cimport vector
+from mpi4py cimport MPI
+
+from freud.locality cimport _SpatialHistogram1D
+from freud.util cimport _Compute, vec3
+
+cimport numpy as np
+
+cimport freud._cluster
+cimport freud._density
+cimport freud._distributed
+cimport freud._locality
+cimport freud._order
+cimport freud.box
+cimport freud.locality
+cimport freud.util
+
+# numpy must be initialized. When using numpy from C or Cython you must
+# _always_ do that, or you will have segfaults
+np.import_array()
+
+
+cdef class DomainDecomposition:
+    r"""Decomposition of a point set into domains of the box owned by the
+    ranks of an MPI communicator.
+
+    The box is split into one slab per rank along its first lattice vector,
+    as in :class:`freud.locality.SlabDecomposition`. Every rank passes the
+    points it holds, which may lie anywhere in the box, and the points are
+    migrated to the ranks owning their domains. Every rank also receives as
+    ghosts the points of other ranks within :code:`ghost_width` of its
+    domain, so that its points have all their neighbors within
+    :code:`ghost_width` among its points and ghosts. The point set is never
+    gathered on a single rank.
+
+    The constructor is collective and must be called on all ranks.
+
+    Args:
+        comm (:class:`mpi4py.MPI.Comm`):
+            Communicator of the ranks.
+        box (:class:`freud.box.Box`):
+            Simulation box.
+        points ((:math:`N_{local}`, 3) :class:`numpy.ndarray`):
+            The points held by this rank.
+        ghost_width (float):
+            Width of the ghost layers, which must be at least the largest
+            distance of the neighbors to be found.
+        tags ((:math:`N_{local}`) :class:`numpy.ndarray`, optional):
+            Global tags of the points held by this rank. By default, points
+            are tagged by their index in the concatenation of the points of
+            all ranks in rank order (Default value = :code:`None`).
+    """
+    cdef freud._distributed.DomainDecomposition * thisptr
+    cdef MPI.Comm comm
+
+    def __cinit__(self, MPI.Comm comm, box, points, ghost_width, tags=None):
+        cdef:
+            freud.box.Box b = freud.util._convert_box(box)
+            const float[:, ::1] l_points
+            const uint64_t[::1] l_tags
+            const vec3[float]* points_ptr = NULL
+            const uint64_t* tags_ptr = NULL
+            unsigned int n_points
+
+        points = freud.util._convert_array(points, shape=(None, 3))
+        l_points = points
+        n_points = l_points.shape[0]
+        if n_points > 0:
+            points_ptr = <const vec3[float]*> &l_points[0, 0]
+        if tags is not None:
+            tags = freud.util._convert_array(
+                tags, shape=(n_points, ), dtype=np.uint64)
+            l_tags = tags
+            if n_points > 0:
+                tags_ptr = &l_tags[0]
+
+        self.comm = comm
+        self.thisptr = new freud._distributed.DomainDecomposition(
+            comm.ob_mpi, dereference(b.thisptr), ghost_width)
+        with nogil:
+            self.thisptr.distribute(points_ptr, n_points, tags_ptr)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def box(self):
+        """:class:`freud.box.Box`: The box of the point set."""
+        return freud.box.BoxFromCPP(self.thisptr.getBox())
+
+    @property
+    def ghost_width(self):
+        """float: The width of the ghost layers."""
+        return self.thisptr.getGhostWidth()
+
+    @property
+    def n_owned(self):
+        """int: The number of points owned by this rank."""
+        return self.thisptr.getNOwned()
+
+    @property
+    def n_total(self):
+        """int: The number of points of all ranks."""
+        return self.thisptr.getNTotal()
+
+    @property
+    def points(self):
+        """(:math:`N_{owned} + N_{ghosts}`, 3) :class:`numpy.ndarray`: The
+        points owned by this rank, followed by its ghosts."""
+        cdef size_t n_points = self.thisptr.getPoints().size()
+        points = np.empty((n_points, 3), dtype=np.float32)
+        cdef float[:, ::1] l_points = points
+        if n_points > 0:
+            memcpy(&l_points[0, 0], self.thisptr.getPoints().data(),
+                   n_points * 3 * sizeof(float))
+        return points
+
+    @property
+    def tags(self):
+        """(:math:`N_{owned} + N_{ghosts}`) :class:`numpy.ndarray`: The
+        global tags of the points owned by this rank, followed by those of
+        its ghosts."""
+        cdef size_t n_points = self.thisptr.getTags().size()
+        tags = np.empty(n_points, dtype=np.uint64)
+        cdef np.uint64_t[::1] l_tags = tags
+        if n_points > 0:
+            memcpy(&l_tags[0], self.thisptr.getTags().data(),
+                   n_points * sizeof(np.uint64_t))
+        return tags
+
+    def __repr__(self):
+        return ("freud.distributed.{cls}(box={box}, "
+                "ghost_width={ghost_width})").format(
+                    cls=type(self).__name__, box=repr(self.box),
+                    ghost_width=self.ghost_width)
+
+
+cdef _ball_query_args(neighbors):
+    """Convert query arguments of a distributed compute."""
+    if not isinstance(neighbors, dict):
+        raise ValueError("Distributed computes require query arguments "
+                         "rather than a NeighborList.")
+    query_args = dict(neighbors)
+    query_args.setdefault('mode', 'ball')
+    query_args.setdefault('exclude_ii', True)
+    return freud.locality._QueryArgs.from_dict(query_args)
+
+
+cdef class RDF(_SpatialHistogram1D):
+    r"""Computes the RDF :math:`g \left( r \right)` of a distributed point
+    set.
+
+    Every rank accumulates the bonds of the points it owns, and the bin
+    counts are summed over all ranks, so that all ranks hold the RDF of the
+    whole point set, which is the same as that of
+    :class:`freud.density.RDF`.
+
+    Args:
+        bins (unsigned int):
+            The number of bins in the RDF.
+        r_max (float):
+            Maximum interparticle distance to include in the calculation.
+        r_min (float, optional):
+            Minimum interparticle distance to include in the calculation
+            (Default value = :code:`0`).
+        normalize (bool, optional):
+            Scale the RDF values as in :class:`freud.density.RDF`
+            (Default value = :code:`False`).
+    """
+    cdef freud._density.RDF * thisptr
+
+    def __cinit__(self, unsigned int bins, float r_max, float r_min=0,
+                  normalize=False):
+        self.thisptr = self.histptr = new freud._density.RDF(
+            bins, r_max, r_min, normalize)
+        self.r_max = r_max
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, DomainDecomposition decomposition, neighbors=None,
+                reset=True):
+        r"""Calculates the RDF of the points of all ranks and adds it to the
+        current RDF histogram. Collective.
+
+        Args:
+            decomposition (:class:`DomainDecomposition`):
+                The decomposition of the points, whose ghost width must be
+                at least :code:`r_max`.
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                of a ball query (Default value: None).
+            reset (bool):
+                Whether to erase the previously computed values before adding
+                the new computation; if False, will accumulate data (Default
+                value: True).
+        """
+        if reset:
+            self._reset()
+        cdef freud.locality._QueryArgs qargs = _ball_query_args(
+            self.default_query_args if neighbors is None else neighbors)
+        cdef freud._locality.QueryArgs c_qargs = dereference(qargs.thisptr)
+        with nogil:
+            freud._distributed.accumulateRDF(
+                dereference(self.thisptr), dereference(decomposition.thisptr),
+                c_qargs)
+        self._called_compute = True
+        return self
+
+    @_Compute._computed_property
+    def rdf(self):
+        """(:math:`N_{bins}`,) :class:`numpy.ndarray`: Histogram of RDF
+        values."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getRDF(),
+            freud.util.arr_type_t.FLOAT)
+
+    @_Compute._computed_property
+    def n_r(self):
+        """(:math:`N_{bins}`,) :class:`numpy.ndarray`: Histogram of cumulative
+        bin_counts values, as in :class:`freud.density.RDF`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getNr(),
+            freud.util.arr_type_t.FLOAT)
+
+    def __repr__(self):
+        return ("freud.distributed.{cls}(bins={bins}, r_max={r_max}, "
+                "r_min={r_min})").format(cls=type(self).__name__,
+                                         bins=len(self.bin_centers),
+                                         r_max=self.bounds[1],
+                                         r_min=self.bounds[0])
+
+
+cdef class Steinhardt(_Compute):
+    r"""Computes the Steinhardt order parameters of the points owned by this
+    rank of a distributed point set.
+
+    The order parameters of the points owned by a rank are computed from
+    their neighbors among all points and are the same as those of
+    :class:`freud.order.Steinhardt`. The system-wide order is not computed.
+
+    Args:
+        l (unsigned int or sequence of unsigned int):
+            One or more spherical harmonic numbers.
+        average (bool, optional):
+            Whether to average over the neighbors of neighbors, which requires
+            a ghost width of at least twice :code:`r_max`
+            (Default value = :code:`False`).
+        wl (bool, optional):
+            Whether to compute the third-order invariant :math:`w_l`
+            (Default value = :code:`False`).
+        wl_normalize (bool, optional):
+            Whether to normalize :math:`w_l` (Default value = :code:`False`).
+    """
+    cdef freud._order.Steinhardt * thisptr
+    cdef unsigned int _n_owned
+
+    def __cinit__(self, l, average=False, wl=False, wl_normalize=False):
+        if not isinstance(l, (list, tuple, np.ndarray)):
+            l = [l]
+        cdef vector[unsigned int] ls = l
+        self.thisptr = new freud._order.Steinhardt(
+            ls, average, wl, False, wl_normalize)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, DomainDecomposition decomposition, neighbors):
+        r"""Calculates the order parameters of the points owned by this rank.
+
+        Args:
+            decomposition (:class:`DomainDecomposition`):
+                The decomposition of the points.
+            neighbors (dict):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                of a ball query whose :code:`r_max` is at most the ghost
+                width.
+        """
+        cdef freud.locality._QueryArgs qargs = _ball_query_args(neighbors)
+        cdef freud._locality.QueryArgs c_qargs = dereference(qargs.thisptr)
+        with nogil:
+            freud._distributed.computeSteinhardt(
+                dereference(self.thisptr), dereference(decomposition.thisptr),
+                c_qargs)
+        self._n_owned = decomposition.thisptr.getNOwned()
+        return self
+
+    @_Compute._computed_property
+    def particle_order(self):
+        """(:math:`N_{owned}`, :math:`N_l`) :class:`numpy.ndarray`: The order
+        parameters of the points owned by this rank, in the order of
+        :attr:`DomainDecomposition.points`."""
+        array = freud.util.make_managed_numpy_array(
+            &self.thisptr.getParticleOrder(),
+            freud.util.arr_type_t.FLOAT)[:self._n_owned]
+        if array.shape[1] == 1:
+            return np.ravel(array)
+        return array
+
+    def __repr__(self):
+        return ("freud.distributed.{cls}(l={l}, average={average}, wl={wl}, "
+                "wl_normalize={wl_normalize})").format(
+                    cls=type(self).__name__, l=list(self.thisptr.getL()),
+                    average=self.thisptr.isAverage(),
+                    wl=self.thisptr.isWl(),
+                    wl_normalize=self.thisptr.isWlNormalized())
+
+
+cdef class Cluster(_Compute):
+    r"""Finds the clusters of a distributed point set.
+
+    Every rank finds the clusters of its points and ghosts, and the clusters
+    that share points across the boundaries of the domains are merged with a
+    union-find over all ranks. Clusters are numbered consecutively from zero,
+    but unlike in :class:`freud.cluster.Cluster` they are not sorted by
+    size.
+    """
+    cdef freud._cluster.Cluster * thisptr
+    cdef vector[uint64_t] _cluster_idx
+    cdef uint64_t _num_clusters
+
+    def __cinit__(self):
+        self.thisptr = new freud._cluster.Cluster()
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, DomainDecomposition decomposition, neighbors):
+        r"""Finds the clusters of the points of all ranks. Collective.
+
+        Args:
+            decomposition (:class:`DomainDecomposition`):
+                The decomposition of the points.
+            neighbors (dict):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                of a ball query whose :code:`r_max` is at most the ghost
+                width.
+        """
+        cdef freud.locality._QueryArgs qargs = _ball_query_args(neighbors)
+        cdef freud._locality.QueryArgs c_qargs = dereference(qargs.thisptr)
+        with nogil:
+            self._num_clusters = freud._distributed.computeClusters(
+                dereference(self.thisptr), dereference(decomposition.thisptr),
+                c_qargs, self._cluster_idx)
+        return self
+
+    @_Compute._computed_property
+    def num_clusters(self):
+        """int: The number of clusters of all points."""
+        return self._num_clusters
+
+    @_Compute._computed_property
+    def cluster_idx(self):
+        """(:math:`N_{owned}`,) :class:`numpy.ndarray`: The cluster of each
+        point owned by this rank, in the order of
+        :attr:`DomainDecomposition.points`."""
+        cdef size_t n_points = self._cluster_idx.size()
+        cluster_idx = np.empty(n_points, dtype=np.uint64)
+        cdef np.uint64_t[::1] l_cluster_idx = cluster_idx
+        if n_points > 0:
+            memcpy(&l_cluster_idx[0], self._cluster_idx.data(),
+                   n_points * sizeof(np.uint64_t))
+        return cluster_idx
+
+    def __repr__(self):
+        return "freud.distributed.{cls}()".format(cls=type(self).__name__)
@@ -12,6 +12,7 @@ from freud.errors import NO_DEFAULT_QUERY_ARGS_MESSAGE
 
 from cython.operator cimport dereference
 from libcpp.map cimport map
+from libcpp cimport bool as cbool
 
 from freud.locality cimport _PairCompute, _SpatialHistogram
 from freud.util cimport _Compute, quat, vec3
@@ -25,6 +26,7 @@ import freud.locality
 cimport numpy as np
 
 cimport freud._environment
+cimport freud._locality
 cimport freud.box
 cimport freud.locality
 cimport freud.util
@@ -192,15 +194,40 @@ cdef class BondOrder(_SpatialHistogram):
         cdef const float[:, ::1] l_orientations = orientations
         cdef const float[:, ::1] l_query_orientations = query_orientations
 
-        self.thisptr.accumulate(
-            nq.get_ptr(),
-            <quat[float]*> &l_orientations[0, 0],
-            <vec3[float]*> &l_query_points[0, 0],
-            <quat[float]*> &l_query_orientations[0, 0],
-            num_query_points,
-            nlist.get_ptr(), dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.accumulate(
+                nq.get_ptr(),
+                <quat[float]*> &l_orientations[0, 0],
+                <vec3[float]*> &l_query_points[0, 0],
+                <quat[float]*> &l_query_orientations[0, 0],
+                num_query_points,
+                nlist.get_ptr(), dereference(qargs.thisptr))
         return self
 
+    cdef freud._locality.BondStage * _bond_stage(
+            self, freud.locality.NeighborQuery nq,
+            unsigned int num_query_points, dict inputs,
+            list keep_alive) except NULL:
+        orientations = inputs.get('orientations')
+        query_orientations = inputs.get('query_orientations')
+        if orientations is None:
+            orientations = np.array([[1, 0, 0, 0]] * nq.points.shape[0])
+        if query_orientations is None:
+            query_orientations = orientations
+
+        orientations = freud.util._convert_array(
+            orientations, shape=(nq.points.shape[0], 4))
+        query_orientations = freud.util._convert_array(
+            query_orientations, shape=(num_query_points, 4))
+        keep_alive.extend([orientations, query_orientations])
+
+        cdef const float[:, ::1] l_orientations = orientations
+        cdef const float[:, ::1] l_query_orientations = query_orientations
+        self.thisptr.setOrientations(
+            <quat[float]*> &l_orientations[0, 0],
+            <quat[float]*> &l_query_orientations[0, 0])
+        return self.thisptr
+
     @_Compute._computed_property
     def bond_order(self):
         """:math:`\\left(N_{\\phi}, N_{\\theta} \\right)` :class:`numpy.ndarray`: Bond order."""  # noqa: E501
@@ -233,7 +260,15 @@ cdef class LocalDescriptors(_PairCompute):
     local environment.
 
     The resulting spherical harmonic array will be a complex-valued
-    array of shape :code:`(num_bonds, num_sphs)`. Spherical harmonic
+    array of shape :code:`(num_bonds, num_sphs)`. If :code:`packed` is
+    :code:`True`, the harmonics of nonnegative :math:`m` are instead stored
+    as a real-valued array of shape :code:`(num_bonds, (l_max + 1)**2)`,
+    which holds for each :math:`l` the real part of :math:`Y_{l0}` followed
+    by the real and imaginary parts of :math:`Y_{lm}` for
+    :math:`m = 1, \ldots, l`. The harmonics of negative :math:`m` are the
+    complex conjugates of these, so the packed array holds all harmonics in
+    half the memory of the complex array including negative :math:`m`.
+    Spherical harmonic
     calculation can be restricted to some number of nearest neighbors
     through the :code:`max_num_neighbors` argument; if a particle has more
     bonds than this number, the last one or more rows of bond spherical
@@ -256,6 +291,10 @@ cdef class LocalDescriptors(_PairCompute):
             neighborhood, :code:`'particle_local'` to use the given
             particle orientations, or :code:`'global'` to not rotate
             environments (Default value = :code:`'neighborhood'`).
+        packed (bool, optional):
+            True to store the harmonics of nonnegative :math:`m` as a packed
+            real-valued array. Requires :code:`negative_m=False`.
+            (Default value = :code:`False`)
     """  # noqa: E501
     cdef freud._environment.LocalDescriptors * thisptr
 
@@ -263,7 +302,8 @@ cdef class LocalDescriptors(_PairCompute):
                    'global': freud._environment.Global,
                    'particle_local': freud._environment.ParticleLocal}
 
-    def __cinit__(self, l_max, negative_m=True, mode='neighborhood'):
+    def __cinit__(self, l_max, negative_m=True, mode='neighborhood',
+                  packed=False):
         cdef freud._environment.LocalDescriptorOrientation l_mode
         try:
             l_mode = self.known_modes[mode]
@@ -272,7 +312,7 @@ cdef class LocalDescriptors(_PairCompute):
                 'Unknown LocalDescriptors orientation mode: {}'.format(mode))
 
         self.thisptr = new freud._environment.LocalDescriptors(
-            l_max, negative_m, l_mode)
+            l_max, negative_m, l_mode, packed)
 
     def __dealloc__(self):
         del self.thisptr
@@ -329,12 +369,71 @@ cdef class LocalDescriptors(_PairCompute):
             l_orientations = orientations
             l_orientations_ptr = <quat[float]*> &l_orientations[0, 0]
 
-        self.thisptr.compute(
-            nq.get_ptr(),
-            <vec3[float]*> &l_query_points[0, 0], num_query_points,
-            l_orientations_ptr,
-            nlist.get_ptr(), dereference(qargs.thisptr),
-            max_num_neighbors)
+        cdef unsigned int l_max_num_neighbors = max_num_neighbors
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                <vec3[float]*> &l_query_points[0, 0], num_query_points,
+                l_orientations_ptr,
+                nlist.get_ptr(), dereference(qargs.thisptr),
+                l_max_num_neighbors)
+        return self
+
+    def compute_systems(self, batch, neighbors, orientations=None,
+                        max_num_neighbors=0):
+        r"""Calculates the local descriptors of the bonds of every system of a
+        batch.
+
+        The systems are computed in a single parallel loop, with the points of
+        each system as query points. The neighbor list and the harmonics hold
+        the bonds of all systems in the order of the batch, and are the same
+        as those of :meth:`compute` on each system, with the indices of the
+        points of all systems.
+
+        Args:
+            batch (:class:`freud.locality.SystemBatch`):
+                The systems to compute.
+            neighbors (dict):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                of every system.
+            orientations ((:math:`N_{points}`, 4) :class:`numpy.ndarray`):
+                Orientations of the points of all systems, which are used to
+                calculate bonds.
+            max_num_neighbors (unsigned int, optional):
+                Hard limit on the maximum number of neighbors to use for each
+                particle for the given neighbor-finding algorithm. Uses
+                all neighbors if set to 0 (Default value = 0).
+        """
+        if isinstance(neighbors, freud.locality.NeighborList):
+            raise ValueError("compute_systems requires query arguments rather "
+                             "than a NeighborList.")
+        cdef freud.locality.SystemBatch system_batch = batch
+        cdef freud.locality._QueryArgs qargs
+        _, qargs = self._resolve_neighbors(neighbors)
+        cdef freud._locality.QueryArgs c_qargs = dereference(qargs.thisptr)
+
+        # The l_orientations_ptr is only used for 'particle_local' mode.
+        cdef const float[:, ::1] l_orientations
+        cdef quat[float] *l_orientations_ptr = NULL
+        if self.mode == 'particle_local':
+            if orientations is None:
+                raise RuntimeError(
+                    ('Orientations must be given to orient LocalDescriptors '
+                        'with particles\' orientations'))
+
+            orientations = freud.util._convert_array(
+                orientations, shape=(system_batch.points.shape[0], 4))
+
+            l_orientations = orientations
+            if l_orientations.shape[0] > 0:
+                l_orientations_ptr = <quat[float]*> &l_orientations[0, 0]
+
+        cdef unsigned int l_max_num_neighbors = max_num_neighbors
+        with nogil:
+            self.thisptr.computeSystems(
+                dereference(system_batch.thisptr), l_orientations_ptr,
+                c_qargs, l_max_num_neighbors)
         return self
 
     @_Compute._computed_property
@@ -348,7 +447,12 @@ cdef class LocalDescriptors(_PairCompute):
     @_Compute._computed_property
     def sph(self):
         """:math:`\\left(N_{bonds}, \\text{SphWidth} \\right)`
-        :class:`numpy.ndarray`: The last computed spherical harmonic array."""
+        :class:`numpy.ndarray`: The last computed spherical harmonic array,
+        which is real-valued if :code:`packed` is :code:`True`."""
+        if self.packed:
+            return freud.util.make_managed_numpy_array(
+                &self.thisptr.getPackedSph(),
+                freud.util.arr_type_t.FLOAT)
         return freud.util.make_managed_numpy_array(
             &self.thisptr.getSph(),
             freud.util.arr_type_t.COMPLEX_FLOAT)
@@ -375,6 +479,12 @@ cdef class LocalDescriptors(_PairCompute):
         :math:`m`."""
         return self.thisptr.getNegativeM()
 
+    @property
+    def packed(self):
+        """bool: True if the harmonics of nonnegative :math:`m` are stored as
+        a packed real-valued array."""
+        return self.thisptr.getPacked()
+
     @property
     def mode(self):
         """str: Orientation mode to use for environments, either
@@ -388,9 +498,11 @@ cdef class LocalDescriptors(_PairCompute):
 
     def __repr__(self):
         return ("freud.environment.{cls}(l_max={l_max}, "
-                "negative_m={negative_m}, mode='{mode}')").format(
+                "negative_m={negative_m}, mode='{mode}', "
+                "packed={packed})").format(
                     cls=type(self).__name__, l_max=self.l_max,
-                    negative_m=self.negative_m, mode=self.mode)
+                    negative_m=self.negative_m, mode=self.mode,
+                    packed=self.packed)
 
 
 def _minimize_RMSD(box, ref_points, points, registration=False):
@@ -670,10 +782,14 @@ cdef class EnvironmentCluster(_MatchEnv):
                 FutureWarning
             )
 
-        self.thisptr.compute(
-            nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
-            env_nlist.get_ptr(), dereference(env_qargs.thisptr), threshold,
-            registration, global_search)
+        cdef float l_threshold = threshold
+        cdef cbool l_registration = registration
+        cdef cbool l_global_search = global_search
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
+                env_nlist.get_ptr(), dereference(env_qargs.thisptr),
+                l_threshold, l_registration, l_global_search)
         return self
 
     @_Compute._computed_property
@@ -807,12 +923,15 @@ cdef class EnvironmentMotifMatch(_MatchEnv):
 
         cdef const float[:, ::1] l_motif = motif
         cdef unsigned int nRef = l_motif.shape[0]
-
-        self.thisptr.compute(
-            nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
-            <vec3[float]*>
-            <vec3[float]*> &l_motif[0, 0], nRef,
-            threshold, registration)
+        cdef float l_threshold = threshold
+        cdef cbool l_registration = registration
+
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
+                <vec3[float]*>
+                <vec3[float]*> &l_motif[0, 0], nRef,
+                l_threshold, l_registration)
         return self
 
     @_Compute._computed_property
@@ -888,12 +1007,14 @@ cdef class _EnvironmentRMSDMinimizer(_MatchEnv):
         motif = freud.util._convert_array(motif, shape=(None, 3))
         cdef const float[:, ::1] l_motif = motif
         cdef unsigned int nRef = l_motif.shape[0]
+        cdef cbool l_registration = registration
 
-        self.thisptr.compute(
-            nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
-            <vec3[float]*>
-            <vec3[float]*> &l_motif[0, 0], nRef,
-            registration)
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(), nlist.get_ptr(), dereference(qargs.thisptr),
+                <vec3[float]*>
+                <vec3[float]*> &l_motif[0, 0], nRef,
+                l_registration)
 
         return self
 
@@ -986,16 +1107,17 @@ cdef class AngularSeparationNeighbor(_PairCompute):
 
         cdef unsigned int n_equiv_orientations = l_equiv_orientations.shape[0]
 
-        self.thisptr.compute(
-            nq.get_ptr(),
-            <quat[float]*> &l_orientations[0, 0],
-            <vec3[float]*> &l_query_points[0, 0],
-            <quat[float]*> &l_query_orientations[0, 0],
-            num_query_points,
-            <quat[float]*> &l_equiv_orientations[0, 0],
-            n_equiv_orientations,
-            nlist.get_ptr(),
-            dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                <quat[float]*> &l_orientations[0, 0],
+                <vec3[float]*> &l_query_points[0, 0],
+                <quat[float]*> &l_query_orientations[0, 0],
+                num_query_points,
+                <quat[float]*> &l_equiv_orientations[0, 0],
+                n_equiv_orientations,
+                nlist.get_ptr(),
+                dereference(qargs.thisptr))
         return self
 
     @_Compute._computed_property
@@ -1071,13 +1193,14 @@ cdef class AngularSeparationGlobal(_Compute):
         cdef unsigned int n_points = l_orientations.shape[0]
         cdef unsigned int n_equiv_orientations = l_equiv_orientations.shape[0]
 
-        self.thisptr.compute(
-            <quat[float]*> &l_global_orientations[0, 0],
-            n_global,
-            <quat[float]*> &l_orientations[0, 0],
-            n_points,
-            <quat[float]*> &l_equiv_orientations[0, 0],
-            n_equiv_orientations)
+        with nogil:
+            self.thisptr.compute(
+                <quat[float]*> &l_global_orientations[0, 0],
+                n_global,
+                <quat[float]*> &l_orientations[0, 0],
+                n_points,
+                <quat[float]*> &l_equiv_orientations[0, 0],
+                n_equiv_orientations)
         return self
 
     @_Compute._computed_property
@@ -1174,13 +1297,14 @@ cdef class LocalBondProjection(_PairCompute):
         cdef unsigned int n_equiv = l_equiv_orientations.shape[0]
         cdef unsigned int n_proj = l_proj_vecs.shape[0]
 
-        self.thisptr.compute(
-            nq.get_ptr(),
-            <quat[float]*> &l_orientations[0, 0],
-            <vec3[float]*> &l_query_points[0, 0], num_query_points,
-            <vec3[float]*> &l_proj_vecs[0, 0], n_proj,
-            <quat[float]*> &l_equiv_orientations[0, 0], n_equiv,
-            nlist.get_ptr(), dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(
+                nq.get_ptr(),
+                <quat[float]*> &l_orientations[0, 0],
+                <vec3[float]*> &l_query_points[0, 0], num_query_points,
+                <vec3[float]*> &l_proj_vecs[0, 0], n_proj,
+                <quat[float]*> &l_equiv_orientations[0, 0], n_equiv,
+                nlist.get_ptr(), dereference(qargs.thisptr))
         return self
 
     @_Compute._computed_property
@@ -35,21 +35,23 @@ cdef class NeighborQueryResult:
 cdef class NeighborQuery:
     cdef freud._locality.NeighborQuery * nqptr
     cdef const float[:, ::1] points
-    cdef freud._locality.NeighborQuery * get_ptr(self)
+    cdef freud._locality.NeighborQuery * get_ptr(self) nogil
 
 cdef class NeighborList:
     cdef freud._locality.NeighborList * thisptr
     cdef char _managed
     cdef freud.util._Compute _compute
 
-    cdef freud._locality.NeighborList * get_ptr(self)
+    cdef freud._locality.NeighborList * get_ptr(self) nogil
     cdef void copy_c(self, NeighborList other)
 
 cdef class LinkCell(NeighborQuery):
     cdef freud._locality.LinkCell * thisptr
+    cdef bint _copy
 
 cdef class AABBQuery(NeighborQuery):
     cdef freud._locality.AABBQuery * thisptr
+    cdef bint _copy
 
 cdef class _RawPoints(NeighborQuery):
     cdef freud._locality.RawPoints * thisptr
@@ -57,8 +59,28 @@ cdef class _RawPoints(NeighborQuery):
 cdef class _QueryArgs:
     cdef freud._locality.QueryArgs * thisptr
 
+cdef class _FrameSource:
+    cdef object frames
+    cdef object error
+    cdef freud._locality.FrameReader reader(self)
+
+cdef class _PointSource:
+    cdef object points
+    cdef object error
+    cdef freud._locality.PointReader reader(self)
+
+cdef class SlabDecomposition:
+    cdef freud._locality.SlabDecomposition * thisptr
+    cdef _PointSource source
+
+cdef class SystemBatch:
+    cdef freud._locality.SystemBatch * thisptr
+    cdef object _points
+
 cdef class _PairCompute(_Compute):
-    pass
+    cdef freud._locality.BondStage * _bond_stage(
+        self, NeighborQuery nq, unsigned int num_query_points, dict inputs,
+        list keep_alive) except NULL
 
 cdef class _SpatialHistogram(_PairCompute):
     cdef float r_max
@@ -67,6 +89,9 @@ cdef class _SpatialHistogram(_PairCompute):
 cdef class _SpatialHistogram1D(_SpatialHistogram):
     pass
 
+cdef class BondPipeline(_PairCompute):
+    cdef list _stages
+
 cdef class PeriodicBuffer(_Compute):
     cdef freud._locality.PeriodicBuffer * thisptr
 
@@ -77,9 +102,14 @@ cdef class Voronoi(_Compute):
 
 cdef class Filter(_PairCompute):
     cdef freud._locality.Filter *_filterptr
+    cdef object _unfiltered_query
+    cdef object _unfiltered_nlist
 
 cdef class FilterSANN(Filter):
     cdef freud._locality.FilterSANN *_thisptr
 
 cdef class FilterRAD(Filter):
     cdef freud._locality.FilterRAD *_thisptr
+
+cdef class VerletList(_PairCompute):
+    cdef freud._locality.VerletList *thisptr
@@ -8,6 +8,7 @@ locate points based on their proximity to other points.
 from freud.errors import NO_DEFAULT_QUERY_ARGS_MESSAGE
 
 from cython.operator cimport dereference
+from libc.string cimport memcpy
 from libcpp cimport bool as cbool
 from libcpp.memory cimport shared_ptr
 from libcpp.vector cimport vector
@@ -15,7 +16,9 @@ from libcpp.vector cimport vector
 from freud._locality cimport ITERATOR_TERMINATOR
 from freud.util cimport _Compute, vec3
 
+import contextlib
 import inspect
+import os
 
 import numpy as np
 
@@ -23,6 +26,7 @@ import freud.util
 
 cimport numpy as np
 
+cimport freud._box
 cimport freud._locality
 cimport freud.box
 
@@ -42,7 +46,7 @@ cdef class _QueryArgs:
 
     def __cinit__(self, mode=None, r_min=None, r_max=None, r_guess=None,
                   num_neighbors=None, exclude_ii=None,
-                  scale=None, **kwargs):
+                  scale=None, half_list=None, all_images=None, **kwargs):
         if type(self) == _QueryArgs:
             self.thisptr = new freud._locality.QueryArgs()
             self.mode = mode
@@ -58,6 +62,10 @@ cdef class _QueryArgs:
                 self.exclude_ii = exclude_ii
             if scale is not None:
                 self.scale = scale
+            if half_list is not None:
+                self.half_list = half_list
+            if all_images is not None:
+                self.all_images = all_images
             if len(kwargs):
                 err_str = ", ".join(
                     "{} = {}".format(k, v) for k, v in kwargs.items())
@@ -154,6 +162,22 @@ cdef class _QueryArgs:
     def scale(self, value):
         self.thisptr.scale = value
 
+    @property
+    def half_list(self):
+        return self.thisptr.half_list
+
+    @half_list.setter
+    def half_list(self, value):
+        self.thisptr.half_list = value
+
+    @property
+    def all_images(self):
+        return self.thisptr.all_images
+
+    @all_images.setter
+    def all_images(self, value):
+        self.thisptr.all_images = value
+
     def __repr__(self):
         return ("freud.locality.{cls}(mode={mode}, r_max={r_max}, "
                 "num_neighbors={num_neighbors}, exclude_ii={exclude_ii}, "
@@ -390,6 +414,12 @@ cdef class NeighborQuery:
         """:class:`np.ndarray`: The array of points in this data structure."""
         return np.asarray(self.points)
 
+    @property
+    def spatially_sorted(self):
+        """bool: Whether this data structure searches a copy of the points
+        reordered along a space-filling curve."""
+        return self.nqptr.isSpatiallySorted()
+
     def query(self, query_points, query_args):
         r"""Query for nearest neighbors of the provided point.
 
@@ -405,13 +435,58 @@ cdef class NeighborQuery:
             :class:`~.NeighborQueryResult`: Results object containing the
             output of this query.
         """
-        query_points = freud.util._convert_array(
-            np.atleast_2d(query_points), shape=(None, 3))
+        query_points = _convert_points(np.atleast_2d(query_points))
 
         cdef _QueryArgs args = _QueryArgs.from_dict(query_args)
         return NeighborQueryResult.init(self, query_points, args)
 
-    cdef freud._locality.NeighborQuery * get_ptr(self):
+    def query_batch(self, query_points, query_args):
+        r"""Build the neighbor lists of several queries with a single search.
+
+        All queries are answered from one search of the data structure that
+        finds the bonds of every query, e.g. a ball query with the largest
+        ``r_max``, instead of searching once per query. Nearest neighbor
+        queries are repeated only for query points whose neighbors cannot be
+        determined from that search.
+
+        Args:
+            query_points ((:math:`N`, 3) :class:`numpy.ndarray`):
+                Points to query for.
+            query_args (list[dict]):
+                Query arguments of each query. For information on valid query
+                arguments, see the `Query API
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_.
+
+        Returns:
+            list[:class:`~.NeighborList`]: The neighbor list of each query,
+            equal to :code:`self.query(query_points, args).toNeighborList()`.
+        """
+        query_points = _convert_points(np.atleast_2d(query_points))
+
+        cdef vector[freud._locality.QueryArgs] c_query_args
+        cdef _QueryArgs args
+        for qargs in query_args:
+            args = _QueryArgs.from_dict(qargs)
+            c_query_args.push_back(dereference(args.thisptr))
+
+        cdef const float[:, ::1] l_query_points = query_points
+        cdef unsigned int num_query_points = l_query_points.shape[0]
+        cdef vector[freud._locality.NeighborList*] cnlists = \
+            freud._locality.makeBatchNlists(
+                self.nqptr, <vec3[float]*> &l_query_points[0, 0],
+                num_query_points, c_query_args)
+
+        cdef NeighborList nl
+        nlists = []
+        for i in range(cnlists.size()):
+            nl = _nlist_from_cnlist(cnlists[i])
+            # Explicitly manage a manually created nlist so that it will be
+            # deleted when the Python object is.
+            nl._managed = True
+            nlists.append(nl)
+        return nlists
+
+    cdef freud._locality.NeighborQuery * get_ptr(self) nogil:
         r"""Returns a pointer to the raw C++ object we are wrapping."""
         return self.nqptr
 
@@ -545,7 +620,7 @@ cdef class NeighborList:
         cdef const unsigned int[::1] l_point_indices = point_indices
         cdef const float[::1] l_distances = distances
         cdef const float[::1] l_weights = weights
-        cdef unsigned int l_num_bonds = l_query_point_indices.shape[0]
+        cdef size_t l_num_bonds = l_query_point_indices.shape[0]
         cdef unsigned int l_num_query_points = num_query_points
         cdef unsigned int l_num_points = num_points
 
@@ -601,6 +676,43 @@ cdef class NeighborList:
 
         return result
 
+    @classmethod
+    def load(cls, filename):
+        r"""Load a NeighborList from a file written by :meth:`save`.
+
+        On Linux and macOS the file is memory-mapped rather than read: bonds
+        are only read from disk when they are accessed, and analyses running
+        in separate processes that load the same file share its pages in
+        memory. Modifying the loaded neighbor list (for example with
+        :meth:`filter`) never changes the file. The file must not be
+        overwritten while neighbor lists loaded from it, or arrays obtained
+        from them, are in use.
+
+        Example::
+
+            # Compute the neighbors of a frame once
+            nlist = aq.query(positions, {'r_max': 3}).toNeighborList()
+            nlist.save('neighbors.nlist')
+
+            # Reuse them in a separate analysis
+            nlist = freud.locality.NeighborList.load('neighbors.nlist')
+            ql = freud.order.Steinhardt(6).compute(system, neighbors=nlist)
+
+        Args:
+            filename (str or :class:`os.PathLike`):
+                The file to load.
+
+        Returns:
+            :class:`freud.locality.NeighborList`: The loaded neighbor list.
+        """
+        cdef freud._locality.NeighborList *c_nlist = \
+            freud._locality.NeighborList.load(os.fsencode(filename))
+        cdef NeighborList result
+        result = cls()
+        del result.thisptr
+        result.thisptr = c_nlist
+        return result
+
     def __cinit__(self, _null=False):
         # Setting _null to True will create a NeighborList with no underlying
         # C++ object. This is useful for passing NULL pointers to C++ to
@@ -615,7 +727,7 @@ cdef class NeighborList:
         if self._managed:
             del self.thisptr
 
-    cdef freud._locality.NeighborList * get_ptr(self):
+    cdef freud._locality.NeighborList * get_ptr(self) nogil:
         r"""Returns a pointer to the raw C++ object we are wrapping."""
         return self.thisptr
 
@@ -685,7 +797,7 @@ cdef class NeighborList:
         indicating the first bond index for each query point."""
         return freud.util.make_managed_numpy_array(
             &self.thisptr.getSegments(),
-            freud.util.arr_type_t.UNSIGNED_INT)
+            freud.util.arr_type_t.SIZE_T)
 
     @property
     def neighbor_counts(self):
@@ -715,6 +827,14 @@ cdef class NeighborList:
         """
         return self.thisptr.getNumPoints()
 
+    @property
+    def half_list(self):
+        """bool: Whether this neighbor list was generated with the
+        ``half_list`` query argument, so that it contains only bonds
+        :math:`\left(i, j\right)` with :math:`i < j` from a query of a set
+        of points against itself."""
+        return self.thisptr.isHalfList()
+
     def find_first_index(self, unsigned int i):
         r"""Returns the lowest bond index corresponding to a query particle
         with an index :math:`\geq i`.
@@ -772,6 +892,25 @@ cdef class NeighborList:
         self.thisptr.sort(by_distance)
         return self
 
+    def save(self, filename):
+        r"""Save this NeighborList to a binary file.
+
+        The bonds are written together with their segments and counts in a
+        versioned format that :meth:`load` memory-maps without any
+        deserialization, so that neighbor lists can be computed once per
+        trajectory and shared by many analyses. Files can only be loaded on
+        machines with the same byte order and pointer size.
+
+        Args:
+            filename (str or :class:`os.PathLike`):
+                The file to write, which is overwritten if it exists.
+
+        Returns:
+            :class:`freud.locality.NeighborList`: This object.
+        """
+        self.thisptr.save(os.fsencode(filename))
+        return self
+
 
 cdef NeighborList _nlist_from_cnlist(freud._locality.NeighborList *c_nlist):
     """Create a Python NeighborList object that points to an existing C++
@@ -796,6 +935,59 @@ cdef NeighborList _nlist_from_cnlist(freud._locality.NeighborList *c_nlist):
     return result
 
 
+def _convert_points(points, num_points=None, copy=False):
+    r"""Helper function to convert points to a contiguous single precision
+    array with minimal copying.
+
+    Points that are already stored as a C-contiguous :attr:`numpy.float32`
+    array are used directly unless a copy is requested. Copies are also made
+    of read-only arrays, since a read-only view does not prevent its base
+    array from being modified. Double precision or strided arrays, such as a
+    view of the position field of a structured array, are converted in a
+    single parallel pass directly from their original memory layout.
+
+    Args:
+        points ((:math:`N`, 3) :class:`numpy.ndarray`):
+            Points to convert.
+        num_points (int, optional):
+            The expected number of points, or :code:`None` to accept any
+            number of points (Default value = :code:`None`).
+        copy (bool, optional):
+            Whether the result must not share memory with the input
+            (Default value = :code:`False`).
+
+    Returns:
+        :class:`numpy.ndarray`: The points as a (:math:`N`, 3) C-contiguous
+        :attr:`numpy.float32` array.
+    """
+    cdef np.ndarray array = np.asarray(points)
+    cdef float[:, ::1] l_converted
+    cdef freud._locality.StridedPoints *strided
+    if (array.ndim == 2 and array.shape[0] > 0 and array.shape[1] == 3
+            and (num_points is None or array.shape[0] == num_points)
+            and array.dtype.isnative
+            and array.dtype in (np.float32, np.float64)):
+        if array.dtype == np.float32 and array.flags.c_contiguous:
+            if copy:
+                return array.copy()
+            return array
+        converted = np.empty((array.shape[0], 3), dtype=np.float32)
+        l_converted = converted
+        strided = new freud._locality.StridedPoints(
+            np.PyArray_DATA(array), array.shape[0], array.strides[0],
+            array.strides[1], array.dtype == np.float64)
+        try:
+            strided.copyTo(<vec3[float]*> &l_converted[0, 0])
+        finally:
+            del strided
+        return converted
+
+    converted = freud.util._convert_array(points, shape=(num_points, 3))
+    if copy and np.may_share_memory(converted, array):
+        converted = converted.copy()
+    return converted
+
+
 def _make_default_nq(neighbor_query):
     r"""Helper function to return a NeighborQuery object.
 
@@ -866,6 +1058,319 @@ def _make_default_nlist(system, neighbors, query_points=None):
         return nq.query(qp, query_args).toNeighborList()
 
 
+cdef cbool _read_frame(void* source, freud._locality.Frame& frame) with gil:
+    """Read the next frame of a :class:`_FrameSource` for the C++ frame
+    pipeline, storing any error in the source."""
+    cdef _FrameSource frame_source = <_FrameSource> source
+    cdef NeighborQuery nq
+    cdef const float[:, ::1] l_points
+    try:
+        system = next(frame_source.frames)
+    except StopIteration:
+        return False
+    except BaseException as e:
+        frame_source.error = e
+        return False
+    try:
+        nq = NeighborQuery.from_system(system)
+        l_points = nq.points
+        frame.assign(nq.nqptr.getBox(), <vec3[float]*> &l_points[0, 0],
+                     l_points.shape[0])
+    except BaseException as e:
+        frame_source.error = e
+        return False
+    return True
+
+
+cdef class _FrameSource:
+    r"""Source of the frames of a trajectory for the C++ frame pipeline.
+
+    The frames are read from an iterable of system-like objects, which are
+    converted while the previous frame is accumulated. Errors raised while
+    reading frames end the trajectory and are raised again by :meth:`check`.
+
+    Args:
+        frames (iterable):
+            Iterable of objects that are valid arguments to
+            :meth:`freud.locality.NeighborQuery.from_system`.
+    """
+
+    def __cinit__(self, frames):
+        self.frames = iter(frames)
+        self.error = None
+
+    cdef freud._locality.FrameReader reader(self):
+        return freud._locality.makeFrameReader(_read_frame, <void*> self)
+
+    def check(self):
+        """Raise the error that ended reading the frames, if any."""
+        if self.error is not None:
+            raise self.error
+
+
+cdef cbool _read_points(void* source, size_t begin, size_t end,
+                        vec3[float]* points) with gil:
+    """Read a range of the points of a :class:`_PointSource` for the C++ slab
+    decomposition, storing any error in the source."""
+    cdef _PointSource point_source = <_PointSource> source
+    cdef const float[:, ::1] l_points
+    try:
+        l_points = np.ascontiguousarray(point_source.points[begin:end],
+                                        dtype=np.float32)
+        if l_points.shape[0] != end - begin or l_points.shape[1] != 3:
+            raise ValueError("The points must be an array of shape (N, 3).")
+        memcpy(points, &l_points[0, 0], (end - begin) * 3 * sizeof(float))
+    except BaseException as e:
+        point_source.error = e
+        return False
+    return True
+
+
+cdef class _PointSource:
+    r"""Source of the points of a point set for the C++ slab decomposition.
+
+    Ranges of points are read by slicing an array-like object, such as a
+    :class:`numpy.memmap` or an HDF5 dataset, so that the point set is never
+    loaded into memory at once. Errors raised while reading points are raised
+    again by :meth:`check`.
+
+    Args:
+        points ((:math:`N`, 3) array-like):
+            The points.
+    """
+
+    def __cinit__(self, points):
+        if len(points.shape) != 2 or points.shape[1] != 3:
+            raise ValueError("The points must be an array of shape (N, 3).")
+        self.points = points
+        self.error = None
+
+    cdef freud._locality.PointReader reader(self):
+        return freud._locality.makePointReader(_read_points, <void*> self)
+
+    def check(self):
+        """Raise the error that stopped reading the points, if any."""
+        if self.error is not None:
+            error, self.error = self.error, None
+            raise error
+
+
+cdef class SlabDecomposition:
+    r"""Decomposition of a point set that does not fit in memory into slabs
+    of the box.
+
+    The box is split into slabs of equal width along its first lattice
+    vector. Each slab also holds the points within a halo of the slab,
+    including the periodic images across the boundaries of the box, so that
+    the neighbors within the halo width of the points of the slab are the
+    same as in the whole point set. Every point of the point set is a point
+    of exactly one slab.
+
+    Only the points of one or two slabs are held in memory at once. The
+    point set is read in chunks by slicing ``points``, e.g. a
+    :class:`numpy.memmap` of a file, once for every slab.
+
+    Computes such as :meth:`freud.density.RDF.compute_slabs` accumulate all
+    slabs directly. Per-particle quantities of other computes are obtained by
+    iterating over the slabs, which yields for each slab a tuple of its
+    points, followed by those of its halo, the indices of these points in
+    the point set and the number of points of the slab, e.g.::
+
+        >>> slabs = freud.locality.SlabDecomposition(box, points, 2, 16)
+        >>> density = np.empty(len(points))
+        >>> ld = freud.density.LocalDensity(r_max=2, diameter=0)
+        >>> for slab_points, indices, n_core in slabs:
+        ...     ld.compute((box, slab_points), query_points=slab_points[:n_core],
+        ...                neighbors=dict(r_max=2, exclude_ii=True))
+        ...     density[indices[:n_core]] = ld.density
+
+    Since the points of the slab come first, they keep their indices among
+    the query points, so that :code:`exclude_ii` excludes the same bonds as
+    in the whole point set.
+
+    Args:
+        box (:class:`freud.box.Box`):
+            Simulation box.
+        points ((:math:`N`, 3) array-like):
+            The points, which may be any array-like object whose slices are
+            convertible to arrays, such as a :class:`numpy.memmap`.
+        halo (float):
+            Width of the halos, which must be at least the largest distance
+            of the neighbors to be found.
+        slabs (int):
+            Number of slabs.
+        chunk_size (int, optional):
+            Number of points read at once (Default value = :code:`2**20`).
+    """  # noqa: E501
+
+    def __cinit__(self, box, points, halo, slabs, chunk_size=2**20):
+        cdef freud.box.Box b = freud.util._convert_box(box)
+        self.source = _PointSource(points)
+        self.thisptr = new freud._locality.SlabDecomposition(
+            dereference(b.thisptr), points.shape[0], self.source.reader(),
+            slabs, halo, chunk_size)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def box(self):
+        """:class:`freud.box.Box`: The box of the point set."""
+        return freud.box.BoxFromCPP(self.thisptr.getBox())
+
+    @property
+    def halo(self):
+        """float: The width of the halos."""
+        return self.thisptr.getHalo()
+
+    def __len__(self):
+        return self.thisptr.getNumSlabs()
+
+    def __iter__(self):
+        for slab in range(self.thisptr.getNumSlabs()):
+            yield self._read_slab(slab)
+
+    def _read_slab(self, unsigned int index):
+        cdef freud._locality.Slab slab
+        cdef size_t n_points
+        cdef float[:, ::1] l_points
+        cdef np.uint64_t[::1] l_indices
+        try:
+            self.thisptr.readSlab(index, slab)
+        finally:
+            self.source.check()
+        n_points = slab.points.size()
+        points = np.empty((n_points, 3), dtype=np.float32)
+        indices = np.empty(n_points, dtype=np.uint64)
+        l_points = points
+        l_indices = indices
+        if n_points > 0:
+            memcpy(&l_points[0, 0], slab.points.data(),
+                   n_points * 3 * sizeof(float))
+            memcpy(&l_indices[0], slab.indices.data(),
+                   n_points * sizeof(np.uint64_t))
+        return points, indices, slab.n_core
+
+    def __repr__(self):
+        return ("freud.locality.{cls}(box={box}, halo={halo}, "
+                "slabs={slabs})").format(cls=type(self).__name__,
+                                         box=repr(self.box), halo=self.halo,
+                                         slabs=len(self))
+
+
+cdef class SystemBatch:
+    r"""Batch of many small independent systems, each in its own box.
+
+    The points of all systems are concatenated in the order of the systems,
+    and the points of system :code:`i` are
+    :code:`points[offsets[i]:offsets[i + 1]]`. The neighbors of the points of
+    each system are only found among the points of the same system. Spatial
+    data structures of all systems are built in parallel when the batch is
+    constructed, and computes such as
+    :meth:`freud.order.Steinhardt.compute_systems` compute all systems in a
+    single parallel loop, which avoids the overhead of a separate compute
+    for every small system, e.g.::
+
+        >>> batch = freud.locality.SystemBatch(boxes, points, offsets)
+        >>> ql = freud.order.Steinhardt(6)
+        >>> ql.compute_systems(batch, neighbors=dict(num_neighbors=12))
+        >>> ql.system_order  # The order parameter of each system
+
+    Args:
+        boxes (sequence of :class:`freud.box.Box`):
+            Box of each system.
+        points ((:math:`N`, 3) :class:`numpy.ndarray`):
+            Points of all systems.
+        offsets ((:math:`N_{systems} + 1`,) :class:`numpy.ndarray`):
+            Index of the first point of each system, starting with zero,
+            followed by the number of points :math:`N`.
+    """
+
+    def __cinit__(self, boxes, points, offsets):
+        cdef vector[freud._box.Box] c_boxes
+        cdef freud.box.Box b
+        for box in boxes:
+            b = freud.util._convert_box(box)
+            c_boxes.push_back(dereference(b.thisptr))
+
+        self._points = _convert_points(points, copy=True)
+        offsets = freud.util._convert_array(
+            offsets, shape=(c_boxes.size() + 1,), dtype=np.uint32)
+        if offsets[-1] != self._points.shape[0]:
+            raise ValueError("The last offset must be the number of points.")
+        cdef const float[:, ::1] l_points = self._points
+        cdef vec3[float]* c_points = NULL
+        if l_points.shape[0] > 0:
+            c_points = <vec3[float]*> &l_points[0, 0]
+        cdef vector[unsigned int] c_offsets = offsets
+        self.thisptr = new freud._locality.SystemBatch(
+            c_boxes, c_points, c_offsets)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    @property
+    def num_systems(self):
+        """int: The number of systems."""
+        return self.thisptr.getNumSystems()
+
+    def __len__(self):
+        return self.thisptr.getNumSystems()
+
+    @property
+    def points(self):
+        """(:math:`N`, 3) :class:`numpy.ndarray`: The points of all
+        systems."""
+        return np.asarray(self._points)
+
+    @property
+    def offsets(self):
+        """(:math:`N_{systems} + 1`,) :class:`numpy.ndarray`: The index of the
+        first point of each system, followed by the number of points."""
+        return np.asarray(self.thisptr.getOffsets(), dtype=np.uint32)
+
+    @property
+    def boxes(self):
+        """list[:class:`freud.box.Box`]: The box of each system."""
+        cdef unsigned int system
+        return [freud.box.BoxFromCPP(self.thisptr.getBoxes()[system])
+                for system in range(self.thisptr.getNumSystems())]
+
+    def query(self, query_args):
+        r"""Find the neighbors of the points of each system among the points
+        of the same system.
+
+        Args:
+            query_args (dict):
+                Query arguments of every system. For more information on
+                the query arguments, see the `Query API
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_.
+
+        Returns:
+            :class:`~.NeighborList`: The bonds of all systems in the order of
+            the systems, whose indices are those of the points of all
+            systems.
+        """  # noqa: E501
+        query_args = dict(query_args)
+        query_args.setdefault('exclude_ii', True)
+        cdef _QueryArgs args = _QueryArgs.from_dict(query_args)
+        cdef freud._locality.QueryArgs c_qargs = dereference(args.thisptr)
+        cdef freud._locality.NeighborList *cnlist
+        with nogil:
+            cnlist = self.thisptr.query(c_qargs)
+        cdef NeighborList nl = _nlist_from_cnlist(cnlist)
+        # Explicitly manage a manually created nlist so that it will be
+        # deleted when the Python object is.
+        nl._managed = True
+        return nl
+
+    def __repr__(self):
+        return ("freud.locality.{cls}(num_systems={num_systems}, "
+                "num_points={num_points})").format(
+                    cls=type(self).__name__, num_systems=len(self),
+                    num_points=self.thisptr.getNPoints())
+
+
 cdef class _RawPoints(NeighborQuery):
     r"""Class containing :class:`~.box.Box` and points with no spatial data
     structures for accelerating neighbor queries."""
@@ -876,7 +1381,7 @@ cdef class _RawPoints(NeighborQuery):
         if type(self) is _RawPoints:
             # Assume valid set of arguments is passed
             b = freud.util._convert_box(box)
-            self.points = freud.util._convert_array(points, shape=(None, 3))
+            self.points = _convert_points(points)
             l_points = self.points
             self.thisptr = self.nqptr = new freud._locality.RawPoints(
                 dereference(b.thisptr),
@@ -898,27 +1403,140 @@ cdef class AABBQuery(NeighborQuery):
         box (:class:`freud.box.Box`):
             Simulation box.
         points ((:math:`N`, 3) :class:`numpy.ndarray`):
-            The points to use to build the tree.
+            The points to use to build the tree. Double precision or strided
+            arrays are converted in a single pass.
+        spatial_sort (bool, optional):
+            If ``True``, build the tree from a copy of the points reordered
+            along a space-filling (Morton) curve, so that points that are close
+            in space are also close in memory. This speeds up queries on
+            points given in a spatially random order. Neighbor lists and
+            compute results still use the original point indices
+            (Default value = :code:`False`).
+        parallel_build (bool, optional):
+            If ``True``, build the tree using multiple threads. The resulting
+            tree and all query results are identical to those of the serial
+            build. This is beneficial for large systems, in particular when a
+            new tree is built every frame (Default value = :code:`False`).
+        radii ((:math:`N`) :class:`numpy.ndarray`, optional):
+            The radius of each point, which enables :meth:`~.query_contacts`
+            (Default value = :code:`None`).
+        copy (bool, optional):
+            If ``False``, C-contiguous single precision points, such as
+            memory-mapped trajectory frames, are used without copying them.
+            The tree then refers to the memory of the points, which must not
+            be modified while this object is used, including through the base
+            array of a read-only view. The points passed to :meth:`~.update`
+            are used the same way (Default value = :code:`True`).
     """
 
-    def __cinit__(self, box, points):
+    def __cinit__(self, box, points, spatial_sort=False, parallel_build=False,
+                  radii=None, copy=True):
         cdef const float[:, ::1] l_points
+        cdef const float[::1] l_radii
         cdef freud.box.Box b
         if type(self) is AABBQuery:
             # Assume valid set of arguments is passed
             b = freud.util._convert_box(box)
-            self.points = freud.util._convert_array(
-                points, shape=(None, 3)).copy()
+            self._copy = copy
+            self.points = _convert_points(points, copy=copy)
             l_points = self.points
             self.thisptr = self.nqptr = new freud._locality.AABBQuery(
                 dereference(b.thisptr),
                 <vec3[float]*> &l_points[0, 0],
-                self.points.shape[0])
+                self.points.shape[0], spatial_sort, parallel_build)
+            if radii is not None:
+                l_radii = freud.util._convert_array(
+                    radii, shape=(self.points.shape[0], ))
+                if l_radii.shape[0] != 0:
+                    self.thisptr.setRadii(&l_radii[0])
 
     def __dealloc__(self):
         if type(self) is AABBQuery:
             del self.thisptr
 
+    def update(self, points):
+        r"""Update the tree with new positions of the same points.
+
+        Instead of building a new tree, the bounding boxes of the existing
+        tree are refit to the new positions. This is much faster than
+        constructing a new :class:`~.AABBQuery` for each frame of a
+        trajectory in which points move little between frames. Refitting
+        does not change the structure of the tree, which becomes less
+        efficient to query as points move away from the positions it was
+        built with, so the tree is rebuilt when its quality degrades too far.
+        Queries find the same neighbors as with a newly constructed tree.
+
+        Args:
+            points ((:math:`N`, 3) :class:`numpy.ndarray`):
+                The new point coordinates. The number of points must match
+                the number of points used to construct this object.
+
+        Returns:
+            :class:`~.AABBQuery`: This object.
+        """
+        cdef const float[:, ::1] l_points
+        new_points = _convert_points(
+            points, self.points.shape[0], copy=self._copy)
+        l_points = new_points
+        self.thisptr.update(<vec3[float]*> &l_points[0, 0], l_points.shape[0])
+        self.points = new_points
+        return self
+
+    def query_contacts(self, query_points, query_radii, delta=0,
+                       exclude_ii=False):
+        r"""Find the pairs of spheres that are in contact.
+
+        A query point :math:`i` and a point :math:`j` are neighbors if
+        :math:`r_{ij} < a_i + a_j + \delta`, where :math:`a_i` and
+        :math:`a_j` are their radii. Unlike a ball query with the largest
+        contact distance followed by a filter, the tree of the spheres of the
+        points is searched around each query point only as far as its own
+        radius reaches, which is much faster for polydisperse systems.
+        Requires that this object was constructed with :code:`radii`.
+
+        Args:
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`):
+                The points to find contacts for.
+            query_radii ((:math:`N_{query\_points}`) :class:`numpy.ndarray`):
+                The radius of each query point.
+            delta (float, optional):
+                The distance between the surfaces of spheres within which
+                they are in contact (Default value = 0).
+            exclude_ii (bool, optional):
+                Whether to exclude bonds between query points and points with
+                the same index (Default value = :code:`False`).
+
+        Returns:
+            :class:`~.NeighborList`: The contacts, sorted by query point and
+            point.
+        """  # noqa: E501
+        if not self.thisptr.hasRadii() and self.points.shape[0] != 0:
+            raise ValueError(
+                "query_contacts requires that this AABBQuery was constructed "
+                "with radii.")
+        cdef const float[:, ::1] l_query_points = _convert_points(
+            np.atleast_2d(query_points))
+        cdef unsigned int n_query_points = l_query_points.shape[0]
+        cdef const float[::1] l_query_radii = freud.util._convert_array(
+            query_radii, shape=(n_query_points, ))
+        cdef const vec3[float] *query_points_ptr = NULL
+        cdef const float *query_radii_ptr = NULL
+        if n_query_points != 0:
+            query_points_ptr = <vec3[float]*> &l_query_points[0, 0]
+            query_radii_ptr = &l_query_radii[0]
+        cdef float c_delta = delta
+        cdef bool c_exclude_ii = exclude_ii
+        cdef freud._locality.NeighborList *cnlist
+        with nogil:
+            cnlist = self.thisptr.queryContacts(
+                query_points_ptr, query_radii_ptr, n_query_points, c_delta,
+                c_exclude_ii)
+        cdef NeighborList nl = _nlist_from_cnlist(cnlist)
+        # Explicitly manage a manually created nlist so that it will be
+        # deleted when the Python object is.
+        nl._managed = True
+        return nl
+
 
 cdef class LinkCell(NeighborQuery):
     r"""Supports efficiently finding all points in a set within a certain
@@ -930,32 +1548,79 @@ cdef class LinkCell(NeighborQuery):
         box (:class:`freud.box.Box`):
             Simulation box.
         points ((:math:`N`, 3) :class:`numpy.ndarray`):
-            The points to bin into the cell list.
+            The points to bin into the cell list. Double precision or strided
+            arrays are converted in a single pass.
         cell_width (float, optional):
-            Width of cells. If not provided, :class:`~.LinkCell` will
-            estimate a cell width based on the number of points and the box
-            size, assuming a constant density of points in the box.
+            Width of cells. If not provided, :class:`~.LinkCell` will choose
+            the number of cells along each dimension from the distances
+            between the box planes and the number of points, so that cells
+            are close to cubic and hold about 10 points on average. Dimensions
+            of the box thinner than such a cell, such as the thickness of a
+            film, are covered by a single layer of cells.
+        spatial_sort (bool, optional):
+            If ``True``, bin a copy of the points reordered along a
+            space-filling (Morton) curve, so that points that are close in
+            space are also close in memory. This speeds up queries on points
+            given in a spatially random order. Neighbor lists and compute
+            results still use the original point indices (Default value =
+            :code:`False`).
+        copy (bool, optional):
+            If ``False``, C-contiguous single precision points, such as
+            memory-mapped trajectory frames, are used without copying them.
+            The cell list then refers to the memory of the points, which must
+            not be modified while this object is used, including through the
+            base array of a read-only view. The points passed to
+            :meth:`~.update` are used the same way (Default value =
+            :code:`True`).
     """
 
-    def __cinit__(self, box, points, cell_width=0):
+    def __cinit__(self, box, points, cell_width=0, spatial_sort=False,
+                  copy=True):
         cdef freud.box.Box b = freud.util._convert_box(box)
         cdef const float[:, ::1] l_points
-        self.points = freud.util._convert_array(
-            points, shape=(None, 3)).copy()
+        self._copy = copy
+        self.points = _convert_points(points, copy=copy)
         l_points = self.points
         self.thisptr = self.nqptr = new freud._locality.LinkCell(
             dereference(b.thisptr),
             <vec3[float]*> &l_points[0, 0],
-            self.points.shape[0], cell_width)
+            self.points.shape[0], cell_width, spatial_sort)
 
     def __dealloc__(self):
         del self.thisptr
 
     @property
     def cell_width(self):
-        """float: Cell width."""
+        """float: Cell width. Cells may be wider along some dimensions, but
+        no cell is narrower than this width."""
         return self.thisptr.getCellWidth()
 
+    def update(self, points):
+        r"""Update the cell list with new positions of the same points.
+
+        The box and cell width are unchanged, so only points that have moved
+        to a different cell are relinked and the cached cell neighbors are
+        reused. This is much faster than constructing a new
+        :class:`~.LinkCell` for each frame of a trajectory in which few points
+        change cells between frames.
+
+        Args:
+            points ((:math:`N`, 3) :class:`numpy.ndarray`):
+                The new point coordinates. The number of points must match
+                the number of points used to construct this object.
+
+        Returns:
+            :class:`~.LinkCell`: This object.
+        """
+        cdef const float[:, ::1] l_points
+        new_points = _convert_points(
+            points, self.points.shape[0], copy=self._copy)
+        l_points = new_points
+        self.thisptr.updateCellList(
+            <vec3[float]*> &l_points[0, 0], l_points.shape[0])
+        self.points = new_points
+        return self
+
 
 cdef class _PairCompute(_Compute):
     r"""Parent class for all compute classes in freud that depend on finding
@@ -1003,8 +1668,7 @@ cdef class _PairCompute(_Compute):
         if query_points is None:
             query_points = nq.points
         else:
-            query_points = freud.util._convert_array(
-                query_points, shape=(None, 3))
+            query_points = _convert_points(query_points)
         cdef const float[:, ::1] l_query_points = query_points
         cdef unsigned int num_query_points = l_query_points.shape[0]
         return (nq, nlist, qargs, l_query_points, num_query_points)
@@ -1036,6 +1700,15 @@ cdef class _PairCompute(_Compute):
         raise NotImplementedError(
             NO_DEFAULT_QUERY_ARGS_MESSAGE.format(type(self).__name__))
 
+    cdef freud._locality.BondStage * _bond_stage(
+            self, NeighborQuery nq, unsigned int num_query_points,
+            dict inputs, list keep_alive) except NULL:
+        # Computes that can consume the bonds of a BondPipeline return their
+        # C++ stage, after converting any per-point inputs and appending them
+        # to keep_alive so that they outlive the computation.
+        raise TypeError("{} cannot be computed in a BondPipeline.".format(
+            type(self).__name__))
+
 
 cdef class _SpatialHistogram(_PairCompute):
     r"""Parent class for all compute classes in freud that perform a spatial
@@ -1152,9 +1825,13 @@ cdef class PeriodicBuffer(_Compute):
     def __dealloc__(self):
         del self.thisptr
 
-    def compute(self, system, buffer, cbool images=False, include_input_points=False):
+    def compute(self, system, buffer, cbool images=False,
+                include_input_points=False, compute_points=True):
         r"""Compute the periodic buffer.
 
+        The buffer points of all points are counted and then written in
+        parallel, in the order of the points.
+
         Args:
             system:
                 Any object that is a valid argument to
@@ -1171,6 +1848,11 @@ cdef class PeriodicBuffer(_Compute):
             include_input_points (bool, optional):
                 Whether the original points provided by ``system`` are
                 included in the buffer, (Default value = :code:`False`).
+            compute_points (bool, optional):
+                Whether the positions of the buffer points are stored. If
+                ``False``, only :attr:`buffer_ids` and :attr:`buffer_images`
+                are computed, which describe the buffer without storing a copy
+                of each point (Default value = :code:`True`).
         """
         cdef NeighborQuery nq = _make_default_nq(system)
         cdef vec3[float] buffer_vec
@@ -1182,21 +1864,42 @@ cdef class PeriodicBuffer(_Compute):
         else:
             raise ValueError('buffer must be a scalar or have length 3.')
 
-        self.thisptr.compute(nq.get_ptr(), buffer_vec, images, include_input_points)
+        cdef cbool l_images = images
+        cdef cbool l_include_input_points = include_input_points
+        cdef cbool l_compute_points = compute_points
+        with nogil:
+            self.thisptr.compute(nq.get_ptr(), buffer_vec, l_images,
+                                 l_include_input_points, l_compute_points)
         return self
 
     @_Compute._computed_property
     def buffer_points(self):
         """:math:`\\left(N_{buffer}, 3\\right)` :class:`numpy.ndarray`: The
         buffer point positions."""
-        points = self.thisptr.getBufferPoints()
-        return np.asarray([[p.x, p.y, p.z] for p in points])
+        if not self.thisptr.getComputePoints():
+            raise ValueError("The buffer points were not computed because "
+                             "compute was called with compute_points=False.")
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getBufferPoints(),
+            freud.util.arr_type_t.FLOAT, 3)
 
     @_Compute._computed_property
     def buffer_ids(self):
         """:math:`\\left(N_{buffer}\\right)` :class:`numpy.ndarray`: The buffer
         point ids."""
-        return np.asarray(self.thisptr.getBufferIds())
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getBufferIds(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def buffer_images(self):
+        """:math:`\\left(N_{buffer}, 3\\right)` :class:`numpy.ndarray`: The
+        image of each buffer point in multiples of the lattice vectors of the
+        box. Each buffer point is the point :attr:`buffer_ids` shifted by its
+        image, wrapped into :attr:`buffer_box` if ``images`` was ``True``."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getBufferImages(),
+            freud.util.arr_type_t.INT, 3)
 
     @_Compute._computed_property
     def buffer_box(self):
@@ -1225,10 +1928,19 @@ cdef class Voronoi(_Compute):
 
     The voro++ library :cite:`Rycroft2009` is used for fast computations of the
     Voronoi diagram.
+
+    Args:
+        compute_polytopes (bool, optional):
+            Whether to compute the vertices of each cell. If :code:`False`,
+            only the neighbor list (weighted by face areas) and the cell
+            volumes are computed, which saves the time and memory needed to
+            store a polytope for every point. This is useful when only the
+            neighbors are needed, in particular for large systems
+            (Default value = :code:`True`).
     """
 
-    def __cinit__(self):
-        self.thisptr = new freud._locality.Voronoi()
+    def __cinit__(self, compute_polytopes=True):
+        self.thisptr = new freud._locality.Voronoi(compute_polytopes)
         self._nlist = NeighborList()
 
     def __dealloc__(self):
@@ -1243,30 +1955,41 @@ cdef class Voronoi(_Compute):
                 :class:`freud.locality.NeighborQuery.from_system`.
         """
         cdef NeighborQuery nq = NeighborQuery.from_system(system)
-        self.thisptr.compute(nq.get_ptr())
+        with nogil:
+            self.thisptr.compute(nq.get_ptr())
         self._box = nq.box
         return self
 
+    @property
+    def compute_polytopes(self):
+        """bool: Whether the vertices of each cell are computed."""
+        return self.thisptr.getComputePolytopes()
+
     @_Compute._computed_property
     def polytopes(self):
         """list[:class:`numpy.ndarray`]: A list of :class:`numpy.ndarray`
-        defining Voronoi polytope vertices for each cell."""
+        defining Voronoi polytope vertices for each cell. Only available if
+        :code:`compute_polytopes` is :code:`True`."""
+        if not self.thisptr.getComputePolytopes():
+            raise AttributeError(
+                "Polytopes are only available if this Voronoi object was "
+                "constructed with compute_polytopes=True.")
         polytopes = []
-        cdef vector[vector[vec3[double]]] raw_polytopes = \
-            self.thisptr.getPolytopes()
+        cdef const vector[vector[vec3[double]]] *raw_polytopes = \
+            &self.thisptr.getPolytopes()
         cdef size_t i
         cdef size_t j
         cdef size_t num_verts
-        cdef vector[vec3[double]] raw_vertices
+        cdef const vector[vec3[double]] *raw_vertices
         cdef double[:, ::1] polytope_vertices
         for i in range(raw_polytopes.size()):
-            raw_vertices = raw_polytopes[i]
+            raw_vertices = &dereference(raw_polytopes)[i]
             num_verts = raw_vertices.size()
             polytope_vertices = np.empty((num_verts, 3), dtype=np.float64)
             for j in range(num_verts):
-                polytope_vertices[j, 0] = raw_vertices[j].x
-                polytope_vertices[j, 1] = raw_vertices[j].y
-                polytope_vertices[j, 2] = raw_vertices[j].z
+                polytope_vertices[j, 0] = dereference(raw_vertices)[j].x
+                polytope_vertices[j, 1] = dereference(raw_vertices)[j].y
+                polytope_vertices[j, 2] = dereference(raw_vertices)[j].z
             polytopes.append(np.asarray(polytope_vertices))
         return polytopes
 
@@ -1302,8 +2025,8 @@ cdef class Voronoi(_Compute):
         return self._nlist
 
     def __repr__(self):
-        return "freud.locality.{cls}()".format(
-            cls=type(self).__name__)
+        return "freud.locality.{cls}(compute_polytopes={compute_polytopes})".format(
+            cls=type(self).__name__, compute_polytopes=self.compute_polytopes)
 
     def __str__(self):
         return repr(self)
@@ -1357,6 +2080,11 @@ cdef class Filter(_PairCompute):
     filter class. After the calculation, the filtered neighborlist will be
     available as the property ``filtered_nlist`` .
 
+    When ``neighbors`` is a dictionary of query arguments, the candidate
+    neighbors of each point are filtered as they are found, so the unfiltered
+    neighborlist is never stored in full. It is recomputed from the query
+    arguments the first time the ``unfiltered_nlist`` property is accessed.
+
     Warning:
         This class is abstract and should not be instantiated directly.
     """
@@ -1401,10 +2129,23 @@ cdef class Filter(_PairCompute):
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, query_points, neighbors)
 
-        self._filterptr.compute(nq.get_ptr(),
-                                <vec3[float]*> &l_query_points[0, 0],
-                                num_query_points, nlist.get_ptr(),
-                                dereference(qargs.thisptr))
+        with nogil:
+            self._filterptr.compute(nq.get_ptr(),
+                                    <vec3[float]*> &l_query_points[0, 0],
+                                    num_query_points, nlist.get_ptr(),
+                                    dereference(qargs.thisptr))
+
+        # Bonds found from query arguments are not stored by the filter, so
+        # keep what is needed to find them again if they are requested.
+        self._unfiltered_nlist = None
+        if nlist.get_ptr() == NULL:
+            query_args = neighbors.copy()
+            query_args.setdefault('exclude_ii', query_points is None)
+            self._unfiltered_query = (
+                nq, None if query_points is None else np.array(l_query_points),
+                query_args)
+        else:
+            self._unfiltered_query = None
         return self
 
     @_Compute._computed_property
@@ -1417,6 +2158,14 @@ cdef class Filter(_PairCompute):
     @_Compute._computed_property
     def unfiltered_nlist(self):
         """:class:`.NeighborList`: The unfiltered neighbor list."""
+        if self._unfiltered_query is not None:
+            if self._unfiltered_nlist is None:
+                nq, query_points, query_args = self._unfiltered_query
+                if query_points is None:
+                    query_points = nq.points
+                self._unfiltered_nlist = nq.query(
+                    query_points, query_args).toNeighborList()
+            return self._unfiltered_nlist
         nlist = _nlist_from_cnlist(self._filterptr.getUnfilteredNlist().get())
         nlist._compute = self
         return nlist
@@ -1525,3 +2274,328 @@ cdef class FilterRAD(Filter):
     def __dealloc__(self):
         if type(self) == FilterRAD:
             del self._thisptr
+
+
+cdef class VerletList(_PairCompute):
+    r"""Reuse a ball query :class:`.NeighborList` across frames.
+
+    A :class:`.VerletList` finds all neighbors within a distance of
+    ``r_max + skin`` and stores them together with the positions of the points
+    and query points at that time. On subsequent calls to :meth:`compute`, the
+    largest displacement of any point and of any query point since that
+    reference frame is measured. If the sum of the two does not exceed
+    ``skin`` (i.e. when the points and query points are the same, if no point
+    has moved more than ``skin / 2``), no pair currently closer than ``r_max``
+    can be missing from the stored list. The stored bonds are then updated
+    with the current distances and filtered to the requested range via
+    :meth:`.NeighborList.filter_r` instead of performing a new query.
+
+    A new query is performed whenever the displacement criterion is violated,
+    or when the box, the number of points or query points, ``r_max``, or
+    ``exclude_ii`` differ from the reference frame.
+
+    Note:
+        Only ball queries are supported, since the set of :math:`k` nearest
+        neighbors is not guaranteed to be contained in a cached ball query.
+        Queries with ``all_images`` are not supported either, since the
+        distances of the cached bonds are updated with the minimum image
+        convention.
+
+    Args:
+        skin (float):
+            Extra distance added to ``r_max`` when building the cached
+            neighbor list.
+    """
+
+    def __cinit__(self, float skin):
+        self.thisptr = new freud._locality.VerletList(skin)
+
+    def __dealloc__(self):
+        del self.thisptr
+
+    def compute(self, system, neighbors, query_points=None):
+        r"""Compute the neighbor list for the current positions.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            neighbors (dict):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`__
+                describing a ball query.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points used to calculate the neighbor list. Uses the
+                system's points if :code:`None` (Default value = :code:`None`).
+        """  # noqa E501
+        if type(neighbors) != dict:
+            raise ValueError("VerletList requires a dict of query arguments.")
+        cdef:
+            NeighborQuery nq
+            NeighborList nlist
+            _QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, query_points, neighbors)
+
+        with nogil:
+            self.thisptr.compute(nq.get_ptr(),
+                                 <vec3[float]*> &l_query_points[0, 0],
+                                 num_query_points, dereference(qargs.thisptr))
+        return self
+
+    def reset(self):
+        r"""Discard the cached neighbor list, forcing the next call to
+        :meth:`compute` to perform a new query."""
+        self.thisptr.reset()
+        self._called_compute = False
+
+    @_Compute._computed_property
+    def nlist(self):
+        """:class:`.NeighborList`: The neighbor list for the most recent
+        frame."""
+        nlist = _nlist_from_cnlist(self.thisptr.getNeighborList().get())
+        nlist._compute = self
+        return nlist
+
+    @_Compute._computed_property
+    def rebuilt(self):
+        """bool: Whether the most recent call to :meth:`compute` performed a
+        new query."""
+        return self.thisptr.getRebuilt()
+
+    @property
+    def num_rebuilds(self):
+        """int: The number of queries performed since construction or the
+        last call to :meth:`reset`."""
+        return self.thisptr.getNumRebuilds()
+
+    @property
+    def skin(self):
+        """float: The skin distance."""
+        return self.thisptr.getSkin()
+
+    def __repr__(self):
+        return "freud.locality.{cls}(skin={skin})".format(
+            cls=type(self).__name__, skin=self.skin)
+
+
+cdef class BondPipeline(_PairCompute):
+    r"""Compute several pair computes from a single traversal of the bonds.
+
+    Computing several quantities of the same bonds, such as an
+    :class:`freud.density.RDF` and a :class:`freud.order.Steinhardt` order
+    parameter, normally finds the neighbors once per compute and streams all
+    bonds through memory once per compute. A :class:`BondPipeline` finds the
+    bonds once and walks them once in blocks of whole query points, and every
+    compute consumes each block while its bonds are still in cache.
+
+    The computes that can be added to a pipeline are
+    :class:`freud.density.RDF`, :class:`freud.density.LocalDensity`,
+    :class:`freud.order.Steinhardt`, :class:`freud.order.Hexatic` and
+    :class:`freud.environment.BondOrder`. After :meth:`compute`, each compute
+    holds the same results as if its own :code:`compute` method had been
+    called with the same system, query points and neighbors. Since the
+    computes share the bonds, the neighbors must be given explicitly unless
+    all computes have the same default query arguments.
+
+    .. note::
+        :class:`freud.order.Steinhardt` and :class:`freud.order.Hexatic`
+        require the query points to be the points of the system.
+
+    Example::
+
+        >>> box, points = freud.data.make_random_system(10, 100, seed=0)
+        >>> rdf = freud.density.RDF(bins=50, r_max=3)
+        >>> ql = freud.order.Steinhardt(l=6)
+        >>> pipeline = freud.locality.BondPipeline([rdf, ql])
+        >>> pipeline.compute((box, points), neighbors={'r_max': 3})
+        freud.locality.BondPipeline(...)
+
+    Args:
+        computes (sequence, optional):
+            Computes to add to the pipeline without inputs
+            (Default value = :code:`()`).
+    """
+
+    def __cinit__(self, computes=()):
+        self._stages = []
+        for compute in computes:
+            self.add(compute)
+
+    def add(self, _PairCompute compute, **inputs):
+        r"""Add a compute to the pipeline.
+
+        Args:
+            compute:
+                The compute consuming the bonds.
+            \*\*inputs:
+                Per-point inputs of the compute, i.e. :code:`orientations` and
+                :code:`query_orientations` of a
+                :class:`freud.environment.BondOrder`.
+
+        Returns:
+            :class:`BondPipeline`: This pipeline.
+        """
+        if any(compute is c for c in self.computes):
+            raise ValueError("{} is already in the pipeline.".format(compute))
+        self._stages.append((compute, inputs))
+        return self
+
+    @property
+    def computes(self):
+        """list: The computes of the pipeline, in the order they consume the
+        bonds."""
+        return [compute for compute, _ in self._stages]
+
+    @property
+    def default_query_args(self):
+        """The default query arguments shared by all computes."""
+        defaults = [compute.default_query_args for compute in self.computes]
+        if not defaults or any(d != defaults[0] for d in defaults):
+            raise NotImplementedError(
+                NO_DEFAULT_QUERY_ARGS_MESSAGE.format(type(self).__name__))
+        return defaults[0]
+
+    def compute(self, system, query_points=None, neighbors=None, reset=True):
+        r"""Compute all computes of the pipeline from the same bonds.
+
+        Args:
+            system:
+                Any object that is a valid argument to
+                :class:`freud.locality.NeighborQuery.from_system`.
+            query_points ((:math:`N_{query\_points}`, 3) :class:`numpy.ndarray`, optional):
+                Query points used to find the bonds. Uses the system's points
+                if :code:`None` (Default value = :code:`None`).
+            neighbors (:class:`freud.locality.NeighborList` or dict, optional):
+                Either a :class:`NeighborList <freud.locality.NeighborList>` of
+                neighbor pairs to use in the calculation, or a dictionary of
+                `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                (Default value: None).
+            reset (bool):
+                Whether histogram computes erase their previously computed
+                values before adding the new computation; if False, they
+                accumulate data (Default value: True).
+        """  # noqa E501
+        cdef:
+            NeighborQuery nq
+            NeighborList nlist
+            _QueryArgs qargs
+            const float[:, ::1] l_query_points
+            unsigned int num_query_points
+            _PairCompute compute
+            vector[freud._locality.BondStage*] stages
+        nq, nlist, qargs, l_query_points, num_query_points = \
+            self._preprocess_arguments(system, query_points, neighbors)
+
+        # Computes are locked in a fixed order so that pipelines sharing
+        # computes cannot deadlock.
+        cdef list keep_alive = []
+        with contextlib.ExitStack() as locks:
+            for compute in sorted(self.computes, key=id):
+                locks.enter_context(compute._lock)
+            for compute, inputs in self._stages:
+                stages.push_back(compute._bond_stage(
+                    nq, num_query_points, inputs, keep_alive))
+            # Histograms are only reset once every compute has accepted its
+            # inputs, so that a failed call keeps their accumulated data.
+            if reset:
+                for compute in self.computes:
+                    if isinstance(compute, _SpatialHistogram):
+                        compute._reset()
+            with nogil:
+                freud._locality.computeBondStages(
+                    stages, nq.get_ptr(),
+                    <vec3[float]*> &l_query_points[0, 0], num_query_points,
+                    nlist.get_ptr(), dereference(qargs.thisptr))
+            for compute, _ in self._stages:
+                compute._called_compute = True
+        return self
+
+    def compute_frames(self, box, frames, neighbors=None, reset=True):
+        r"""Compute all computes of the pipeline from every frame of a
+        trajectory.
+
+        All frames are processed in a single call without returning to
+        Python, and the neighbor search structure of the first frame is
+        updated for every following frame rather than rebuilt (see
+        :meth:`AABBQuery.update`). Histogram computes such as
+        :class:`freud.density.RDF` accumulate all frames, and the other
+        computes hold the results of the last frame. The query points are the
+        points of each frame, and per-point inputs of computes, such as the
+        orientations of a :class:`freud.environment.BondOrder`, are used for
+        all frames.
+
+        Example::
+
+            >>> box, points = freud.data.make_random_system(10, 100, seed=0)
+            >>> frames = np.stack([points, box.wrap(points + 0.1)])
+            >>> rdf = freud.density.RDF(bins=50, r_max=3)
+            >>> pipeline = freud.locality.BondPipeline([rdf])
+            >>> pipeline.compute_frames(box, frames, neighbors={'r_max': 3})
+            freud.locality.BondPipeline(...)
+
+        Args:
+            box (:class:`freud.box.Box`):
+                Simulation box of all frames.
+            frames ((:math:`N_{frames}`, :math:`N_{points}`, 3) :class:`numpy.ndarray`):
+                The points of each frame. A contiguous single precision array,
+                such as a memory-mapped trajectory, is used without copying.
+            neighbors (dict, optional):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                used to find the bonds of every frame (Default value: None).
+            reset (bool):
+                Whether histogram computes erase their previously computed
+                values before adding the frames; if False, they accumulate
+                data (Default value: True).
+        """  # noqa E501
+        if type(neighbors) == NeighborList:
+            raise ValueError(
+                "compute_frames requires query arguments, since the bonds of "
+                "every frame are different.")
+        cdef freud.box.Box b = freud.util._convert_box(box)
+        cdef const float[:, :, ::1] l_frames = freud.util._convert_array(
+            frames, shape=(None, None, 3))
+        cdef unsigned int n_frames = l_frames.shape[0]
+        cdef unsigned int n_points = l_frames.shape[1]
+        cdef NeighborList nlist
+        cdef _QueryArgs qargs
+        nlist, qargs = self._resolve_neighbors(neighbors)
+        cdef _PairCompute compute
+        cdef vector[freud._locality.BondStage*] stages
+        cdef const vec3[float] *frames_ptr = NULL
+        if n_frames != 0 and n_points != 0:
+            frames_ptr = <vec3[float]*> &l_frames[0, 0, 0]
+
+        # The stages are prepared from the points of the first frame, which
+        # provide the number of points of the per-point inputs.
+        cdef NeighborQuery nq = NeighborQuery.from_system(
+            (b, np.asarray(l_frames[0]) if n_frames != 0
+             else np.empty((0, 3), dtype=np.float32)))
+        cdef list keep_alive = []
+        with contextlib.ExitStack() as locks:
+            for compute in sorted(self.computes, key=id):
+                locks.enter_context(compute._lock)
+            for compute, inputs in self._stages:
+                stages.push_back(compute._bond_stage(
+                    nq, n_points, inputs, keep_alive))
+            # Histograms are only reset once every compute has accepted its
+            # inputs, so that a failed call keeps their accumulated data.
+            if reset:
+                for compute in self.computes:
+                    if isinstance(compute, _SpatialHistogram):
+                        compute._reset()
+            with nogil:
+                freud._locality.computeBondStagesFrames(
+                    stages, dereference(b.thisptr), frames_ptr, n_frames,
+                    n_points, dereference(qargs.thisptr))
+            for compute, _ in self._stages:
+                compute._called_compute = True
+        return self
+
+    def __repr__(self):
+        return "freud.locality.{cls}(computes={computes})".format(
+            cls=type(self).__name__, computes=self.computes)
@@ -6,60 +6,17 @@ The :class:`freud.msd` module provides functions for computing the
 mean-squared-displacement (MSD) of particles in periodic systems.
 """
 
-from freud.util cimport _Compute
-import logging
+from freud.util cimport _Compute, vec3
+from libcpp cimport bool
 
 import numpy as np
 
-import freud.parallel
-
 cimport numpy as np
 
+cimport freud._box
+cimport freud._msd
 cimport freud.box
-
-logger = logging.getLogger(__name__)
-
-# Use fastest available fft library
-try:
-    import pyfftw
-    logger.info("Using PyFFTW for FFTs")
-
-    pyfftw.config.NUM_THREADS = min(1, freud.parallel.get_num_threads())
-    logger.info("Setting number of threads to {}".format(
-        freud.parallel.get_num_threads()))
-
-    # Note that currently these functions are defined to match only the parts
-    # of the numpy/scipy API that are actually used below. There is no promise
-    # that other aspects of the API will be preserved.
-    def fft(x, n, axis):
-        a = pyfftw.empty_aligned(x.shape, 'complex64')
-        a[:] = x
-        fft_object = pyfftw.builders.fft(a, n=n, axis=axis)
-        return fft_object()
-
-    def ifft(x, axis):
-        a = pyfftw.empty_aligned(x.shape, 'complex64')
-        a[:] = x
-        fft_object = pyfftw.builders.ifft(a, axis=axis)
-        return fft_object()
-except ImportError:
-    try:
-        from scipy.fftpack import fft, ifft
-        logger.info("Using SciPy's fftpack for FFTs")
-    except ImportError:
-        from numpy.fft import fft, ifft
-        logger.info("Using NumPy for FFTs")
-
-
-def _autocorrelation(x):
-    r"""Compute the autocorrelation of a sequence"""
-    N = x.shape[0]
-    F = fft(x, n=2*N, axis=0)
-    PSD = F * F.conjugate()
-    res = ifft(PSD, axis=0)
-    res = (res[:N]).real
-    n = np.arange(1, N+1)[::-1]  # N to 1
-    return res/n[:, np.newaxis]
+cimport freud.util
 
 
 cdef class MSD(_Compute):
@@ -71,7 +28,7 @@ cdef class MSD(_Compute):
     diffusion alone or if there are other forces contributing. There are a
     number of definitions for the mean squared displacement. This function
     provides access to the two most common definitions through the mode
-    argument.
+    argument, as well as a streaming variant of the windowed definition.
 
     * :code:`'window'` (*default*):
       This mode calculates the most common form of the MSD, which is defined as
@@ -92,23 +49,11 @@ cdef class MSD(_Compute):
       perform this calculation efficiently, we use the algorithm described in
       :cite:`calandrini2011nmoldyn` as described in `this StackOverflow thread
       <https://stackoverflow.com/questions/34222272/computing-mean-square-displacement-using-python-and-fft>`_.
-
-      .. note::
-          The most intensive part of this calculation is computing an FFT. To
-          maximize performance, freud attempts to use the fastest FFT library
-          available. By default, the order of preference is `pyFFTW
-          <https://github.com/pyFFTW/pyFFTW>`_, SciPy, and then NumPy. If you
-          are experiencing significant slowdowns in calculating the MSD, you
-          may benefit from installing a faster FFT library, which freud will
-          automatically detect. The performance change will be especially
-          noticeable if the length of your trajectory is a number whose prime
-          factorization consists of extremely large prime factors. The
-          standard Cooley-Tukey FFT algorithm performs very poorly in this
-          case, so installing pyFFTW will significantly improve performance.
-
-          Note that while pyFFTW is released under the BSD 3-Clause license,
-          the FFTW library is available under either GPL or a commercial
-          license.
+      The trajectories of the particles are processed in parallel, and the
+      correlation of the positions of each particle is computed by an FFT of
+      its zero padded trajectory, so the memory used beyond the positions and
+      the results is a few buffers of the length of the trajectory per
+      thread.
 
     * :code:`'direct'`:
       Under some circumstances, however, we may be more interested in
@@ -127,6 +72,19 @@ cdef class MSD(_Compute):
       see `the Wikipedia page
       <https://en.wikipedia.org/wiki/Mean_squared_displacement>`_.
 
+    * :code:`'multiple_tau'`:
+      This mode computes the windowed MSD at logarithmically spaced window
+      lengths with a multiple-tau correlator, so that long trajectories can
+      be processed in chunks of frames with bounded memory. The latest
+      :code:`points_per_level` frames give the lags 0 to
+      :code:`points_per_level - 1`, and the latest frames at every :math:`2^k`
+      frames give the lags :math:`j 2^k` for
+      :code:`points_per_level / 2` :math:`\le j <` :code:`points_per_level`.
+      The MSD at each lag is averaged over all pairs of these frames and
+      over all particles, which are the windows of the definition above
+      starting at multiples of :math:`2^k`. The lags are given by
+      :attr:`lags`, and per-particle values are not stored.
+
     .. note::
         The MSD is only well-defined when the box is constant over the
         course of the simulation. Additionally, the number of particles must be
@@ -138,14 +96,20 @@ cdef class MSD(_Compute):
             in calls to :meth:`~compute` are already unwrapped. (Default value
             = :code:`None`).
         mode (str, optional):
-            Mode of calculation. Options are :code:`'window'` and
-            :code:`'direct'`.  (Default value = :code:`'window'`).
+            Mode of calculation. Options are :code:`'window'`,
+            :code:`'direct'` and :code:`'multiple_tau'`.
+            (Default value = :code:`'window'`).
+        points_per_level (unsigned int, optional):
+            Even number of frames kept per level of the correlator in
+            :code:`'multiple_tau'` mode (Default value = :code:`16`).
     """   # noqa: E501
     cdef freud.box.Box _box
     cdef _particle_msd
     cdef str mode
+    cdef freud._msd.MSD * thisptr
+    cdef freud._msd.MultipleTauMSD * multiple_tau_ptr
 
-    def __cinit__(self, box=None, mode='window'):
+    def __cinit__(self, box=None, mode='window', points_per_level=16):
         if box is not None:
             self._box = freud.util._convert_box(box)
         else:
@@ -153,11 +117,24 @@ cdef class MSD(_Compute):
 
         self._particle_msd = []
 
-        if mode not in ['window', 'direct']:
+        if mode not in ['window', 'direct', 'multiple_tau']:
             raise ValueError("Invalid mode")
         self.mode = mode
+        if points_per_level < 2 or points_per_level % 2:
+            raise ValueError(
+                "points_per_level must be an even integer of at least 2.")
+        if mode == 'direct':
+            self.thisptr = new freud._msd.MSD(freud._msd.Direct)
+        else:
+            self.thisptr = new freud._msd.MSD(freud._msd.Window)
+        self.multiple_tau_ptr = new freud._msd.MultipleTauMSD(
+            points_per_level)
 
-    def compute(self, positions, images=None, reset=True):
+    def __dealloc__(self):
+        del self.thisptr
+        del self.multiple_tau_ptr
+
+    def compute(self, positions, images=None, reset=True, particle_msd=True):
         """Calculate the MSD for the positions provided.
 
         .. note::
@@ -172,6 +149,10 @@ cdef class MSD(_Compute):
             the trajectory is so large that computing an MSD on all particles
             at once is prohibitively expensive.
 
+            In :code:`'multiple_tau'` mode, accumulation is instead split over
+            frames: with ``reset=False``, the positions continue the
+            trajectory of the previous call and must be of the same points.
+
         Args:
             positions ((:math:`N_{frames}`, :math:`N_{particles}`, 3) :class:`numpy.ndarray`):
                 The particle positions over a trajectory. If neither box nor images
@@ -186,9 +167,17 @@ cdef class MSD(_Compute):
                 Whether to erase the previously computed values before adding
                 the new computation; if False, will accumulate data (Default
                 value: True).
+            particle_msd (bool, optional):
+                Whether to store the per-particle MSD in
+                :attr:`particle_msd`. Disabling it avoids allocating an array
+                of the size of the trajectory when only :attr:`msd` is needed.
+                Ignored in :code:`'multiple_tau'` mode. (Default value =
+                :code:`True`).
         """  # noqa: E501
         if reset:
             self._particle_msd = []
+            self.thisptr.reset()
+            self.multiple_tau_ptr.reset()
 
         self._called_compute = True
 
@@ -198,57 +187,113 @@ cdef class MSD(_Compute):
             images = freud.util._convert_array(
                 images, shape=positions.shape, dtype=np.int32)
 
-        # Make sure we aren't modifying the provided array
-        if self._box is not None and images is not None:
-            unwrapped_positions = positions.copy()
-            for i in range(positions.shape[0]):
-                unwrapped_positions[i, :, :] = self._box.unwrap(
-                    unwrapped_positions[i, :, :], images[i, :, :])
-            positions = unwrapped_positions
-
-        if self.mode == 'window':
-            # First compute the first term r^2(k+m) - r^2(k)
-            N = positions.shape[0]
-            D = np.square(positions).sum(axis=2)
-            D = np.append(D, np.zeros(positions.shape[:2]), axis=0)
-            Q = 2*D.sum(axis=0)
-            S1 = np.zeros(positions.shape[:2])
-            for m in range(N):
-                Q -= (D[m-1, :] + D[N-m, :])
-                S1[m, :] = Q/(N-m)
-
-            # The second term can be computed via autocorrelation
-            corrs = []
-            for i in range(positions.shape[2]):
-                corrs.append(_autocorrelation(positions[:, :, i]))
-            S2 = np.sum(corrs, axis=0)
-
-            self._particle_msd.append(S1 - 2*S2)
-        elif self.mode == 'direct':
-            self._particle_msd.append(
-                np.linalg.norm(
-                    positions - positions[[0], :, :], axis=-1)**2)
+        if self.mode == 'multiple_tau':
+            # Make sure we aren't modifying the provided array
+            if self._box is not None and images is not None:
+                unwrapped_positions = positions.copy()
+                for i in range(positions.shape[0]):
+                    unwrapped_positions[i, :, :] = self._box.unwrap(
+                        unwrapped_positions[i, :, :], images[i, :, :])
+                positions = unwrapped_positions
+            self._accumulate_multiple_tau(positions)
+        else:
+            self._compute_trajectories(positions, images, particle_msd)
 
         return self
 
+    def _compute_trajectories(self, positions, images, particle_msd):
+        cdef const float[:, :, ::1] l_positions = positions
+        cdef const int[:, :, ::1] l_images
+        cdef unsigned int n_frames = l_positions.shape[0]
+        cdef unsigned int n_points = l_positions.shape[1]
+        cdef bool l_particle_msd = particle_msd
+        cdef const freud._box.Box * l_box = NULL
+        cdef const vec3[int] * l_images_ptr = NULL
+        if n_frames == 0 or n_points == 0:
+            raise ValueError("The trajectory must contain at least one frame "
+                             "of at least one particle.")
+        if self._box is not None and images is not None:
+            l_images = images
+            l_box = self._box.thisptr
+            l_images_ptr = <vec3[int]*> &l_images[0, 0, 0]
+        with nogil:
+            self.thisptr.compute(
+                l_box, <vec3[float]*> &l_positions[0, 0, 0], l_images_ptr,
+                n_frames, n_points, l_particle_msd)
+        if particle_msd:
+            self._particle_msd.append(freud.util.make_managed_numpy_array(
+                &self.thisptr.getParticleMSD(),
+                freud.util.arr_type_t.DOUBLE))
+        else:
+            self._particle_msd.append(None)
+
+    def _accumulate_multiple_tau(self, positions):
+        cdef const float[:, :, ::1] l_positions = positions
+        cdef unsigned int n_frames = l_positions.shape[0]
+        cdef unsigned int n_points = l_positions.shape[1]
+        if n_frames > 0:
+            with nogil:
+                self.multiple_tau_ptr.accumulate(
+                    <vec3[float]*> &l_positions[0, 0, 0], n_frames, n_points)
+
     @property
     def box(self):
         """:class:`freud.box.Box`: Box used in the calculation."""
         return self._box
 
+    @property
+    def points_per_level(self):
+        """unsigned int: Number of frames kept per level of the correlator in
+        :code:`'multiple_tau'` mode."""
+        return self.multiple_tau_ptr.getPointsPerLevel()
+
+    @_Compute._computed_property
+    def lags(self):
+        """:math:`\\left(N_{lags}, \\right)` :class:`numpy.ndarray`: The lags
+        in frames of each value of :attr:`msd`, which are the window lengths
+        in :code:`'window'` and :code:`'multiple_tau'` mode and the frame
+        numbers in :code:`'direct'` mode."""
+        if self.mode == 'multiple_tau':
+            return freud.util.make_managed_numpy_array(
+                &self.multiple_tau_ptr.getLags(),
+                freud.util.arr_type_t.UNSIGNED_INT)
+        return np.arange(len(self.msd))
+
     @_Compute._computed_property
     def msd(self):
         """:math:`\\left(N_{frames}, \\right)` :class:`numpy.ndarray`: The mean
-        squared displacement."""
-        return np.concatenate(self._particle_msd, axis=1).mean(axis=-1)
+        squared displacement. In :code:`'multiple_tau'` mode, there is one
+        value for each of the :attr:`lags`."""
+        if self.mode == 'multiple_tau':
+            return freud.util.make_managed_numpy_array(
+                &self.multiple_tau_ptr.getMSD(),
+                freud.util.arr_type_t.DOUBLE)
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getMSD(),
+            freud.util.arr_type_t.DOUBLE)
 
     @_Compute._computed_property
     def particle_msd(self):
         """:math:`\\left(N_{frames}, N_{particles} \\right)` :class:`numpy.ndarray`: The per
-        particle based mean squared displacement."""  # noqa: E501
+        particle based mean squared displacement. Not available in
+        :code:`'multiple_tau'` mode or if any accumulated call to
+        :meth:`compute` was made with :code:`particle_msd=False`."""  # noqa: E501
+        if self.mode == 'multiple_tau':
+            raise AttributeError(
+                "Per-particle MSDs are not stored in 'multiple_tau' mode.")
+        if any(msd is None for msd in self._particle_msd):
+            raise AttributeError(
+                "Per-particle MSDs were not stored; call compute with "
+                "particle_msd=True.")
         return np.concatenate(self._particle_msd, axis=1)
 
     def __repr__(self):
+        if self.mode == 'multiple_tau':
+            return ("freud.msd.{cls}(box={box}, mode={mode}, "
+                    "points_per_level={points_per_level})").format(
+                        cls=type(self).__name__, box=self._box,
+                        mode=repr(self.mode),
+                        points_per_level=self.points_per_level)
         return "freud.msd.{cls}(box={box}, mode={mode})".format(
             cls=type(self).__name__, box=self._box, mode=repr(self.mode))
 
@@ -264,11 +309,11 @@ cdef class MSD(_Compute):
             (:class:`matplotlib.axes.Axes`): Axis with the plot.
         """
         import freud.plot
-        if self.mode == "window":
+        if self.mode in ("window", "multiple_tau"):
             xlabel = "Window size"
         else:
             xlabel = "Frame number"
-        return freud.plot.line_plot(list(range(len(self.msd))), self.msd,
+        return freud.plot.line_plot(list(self.lags), self.msd,
                                     title="MSD",
                                     xlabel=xlabel,
                                     ylabel="MSD",
@@ -15,6 +15,8 @@ from freud.util cimport _Compute, quat, vec3
 from freud.errors import FreudDeprecationWarning
 
 from cython.operator cimport dereference
+from libcpp cimport bool as cbool
+from libcpp.vector cimport vector
 
 from freud.locality cimport _PairCompute
 
@@ -29,6 +31,7 @@ import freud.locality
 
 cimport numpy as np
 
+cimport freud._locality
 cimport freud._order
 cimport freud.locality
 cimport freud.util
@@ -41,7 +44,14 @@ np.import_array()
 
 cdef class Cubatic(_Compute):
     r"""Compute the cubatic order parameter :cite:`Haji_Akbari_2015` for a system of
-    particles using simulated annealing instead of Newton-Raphson root finding.
+    particles using simulated annealing or gradient ascent instead of
+    Newton-Raphson root finding.
+
+    The gradient ascent follows the analytic gradient of the order parameter
+    with respect to rotations of the cubatic orientation from the starting
+    orientation of each replicate until it converges. It is deterministic for
+    a given seed and much faster than simulated annealing, but the
+    temperatures and scale are not used.
 
     Args:
         t_initial (float):
@@ -56,15 +66,30 @@ cdef class Cubatic(_Compute):
         seed (unsigned int, optional):
             Random seed to use in calculations. If :code:`None`, system time is used.
             (Default value = :code:`None`).
+        optimizer (str, optional):
+            Method used to maximize the order parameter, either
+            :code:`'annealing'` or :code:`'gradient'`
+            (Default value = :code:`'annealing'`).
     """  # noqa: E501
     cdef freud._order.Cubatic * thisptr
 
-    def __cinit__(self, t_initial, t_final, scale, n_replicates=1, seed=None):
+    known_optimizers = {'annealing': freud._order.Annealing,
+                        'gradient': freud._order.GradientAscent}
+
+    def __cinit__(self, t_initial, t_final, scale, n_replicates=1, seed=None,
+                  optimizer='annealing'):
         if seed is None:
             seed = int(time.time())
 
+        cdef freud._order.CubaticOptimizer l_optimizer
+        try:
+            l_optimizer = self.known_optimizers[optimizer]
+        except KeyError:
+            raise ValueError(
+                'Unknown Cubatic optimizer: {}'.format(optimizer))
+
         self.thisptr = new freud._order.Cubatic(
-            t_initial, t_final, scale, n_replicates, seed)
+            t_initial, t_final, scale, n_replicates, seed, l_optimizer)
 
     def __dealloc__(self):
         del self.thisptr
@@ -82,8 +107,9 @@ cdef class Cubatic(_Compute):
         cdef const float[:, ::1] l_orientations = orientations
         cdef unsigned int num_particles = l_orientations.shape[0]
 
-        self.thisptr.compute(
-            <quat[float]*> &l_orientations[0, 0], num_particles)
+        with nogil:
+            self.thisptr.compute(
+                <quat[float]*> &l_orientations[0, 0], num_particles)
         return self
 
     @property
@@ -111,6 +137,15 @@ cdef class Cubatic(_Compute):
         """unsigned int: Random seed to use in calculations."""
         return self.thisptr.getSeed()
 
+    @property
+    def optimizer(self):
+        """str: Method used to maximize the order parameter, either
+        :code:`'annealing'` or :code:`'gradient'`."""
+        optimizer = self.thisptr.getOptimizer()
+        for key, value in self.known_optimizers.items():
+            if value == optimizer:
+                return key
+
     @_Compute._computed_property
     def order(self):
         """float: Cubatic order parameter of the system."""
@@ -151,12 +186,14 @@ cdef class Cubatic(_Compute):
     def __repr__(self):
         return ("freud.order.{cls}(t_initial={t_initial}, t_final={t_final}, "
                 "scale={scale}, n_replicates={n_replicates}, "
-                "seed={seed})").format(cls=type(self).__name__,
-                                       t_initial=self.t_initial,
-                                       t_final=self.t_final,
-                                       scale=self.scale,
-                                       n_replicates=self.n_replicates,
-                                       seed=self.seed)
+                "seed={seed}, optimizer='{optimizer}')").format(
+                    cls=type(self).__name__,
+                    t_initial=self.t_initial,
+                    t_final=self.t_final,
+                    scale=self.scale,
+                    n_replicates=self.n_replicates,
+                    seed=self.seed,
+                    optimizer=self.optimizer)
 
 
 cdef class Nematic(_Compute):
@@ -180,7 +217,7 @@ cdef class Nematic(_Compute):
     def __dealloc__(self):
         del self.thisptr
 
-    def compute(self, orientations):
+    def compute(self, orientations, particle_tensor=True):
         r"""Calculates the per-particle and global order parameter.
 
         Example::
@@ -194,15 +231,23 @@ cdef class Nematic(_Compute):
         Args:
             orientations (:math:`\left(N_{particles}, 4 \right)` :class:`numpy.ndarray`):
                 Orientations to calculate the order parameter.
+            particle_tensor (bool, optional):
+                Whether to store the tensor of each particle. The nematic
+                tensor is reduced directly from the orientations, so passing
+                :code:`False` saves the memory of the per-particle tensors
+                when only the global order parameter is needed
+                (Default value = :code:`True`).
         """   # noqa: E501
         orientations = freud.util._convert_array(
             orientations, shape=(None, 4))
 
         cdef const float[:, ::1] l_orientations = orientations
         cdef unsigned int num_particles = l_orientations.shape[0]
+        cdef cbool l_particle_tensor = particle_tensor
 
-        self.thisptr.compute(<quat[float]*> &l_orientations[0, 0],
-                             num_particles)
+        with nogil:
+            self.thisptr.compute(<quat[float]*> &l_orientations[0, 0],
+                                 num_particles, l_particle_tensor)
         return self
 
     @_Compute._computed_property
@@ -221,7 +266,12 @@ cdef class Nematic(_Compute):
     def particle_tensor(self):
         """:math:`\\left(N_{particles}, 3, 3 \\right)` :class:`numpy.ndarray`:
             One 3x3 matrix per-particle corresponding to each individual
-            particle orientation."""
+            particle orientation. Only available if :code:`particle_tensor`
+            was :code:`True` in the last call to :meth:`~.compute`."""
+        if not self.thisptr.hasParticleTensor():
+            raise AttributeError(
+                "The per-particle tensors are only stored if "
+                "particle_tensor=True is passed to compute.")
         return freud.util.make_managed_numpy_array(
             &self.thisptr.getParticleTensor(),
             freud.util.arr_type_t.FLOAT)
@@ -338,10 +388,17 @@ cdef class Hexatic(_PairCompute):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, neighbors=neighbors)
-        self.thisptr.compute(nlist.get_ptr(),
-                             nq.get_ptr(), dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(nlist.get_ptr(),
+                                 nq.get_ptr(), dereference(qargs.thisptr))
         return self
 
+    cdef freud._locality.BondStage * _bond_stage(
+            self, freud.locality.NeighborQuery nq,
+            unsigned int num_query_points, dict inputs,
+            list keep_alive) except NULL:
+        return self.thisptr
+
     @property
     def default_query_args(self):
         """The default query arguments are
@@ -461,8 +518,9 @@ cdef class Translational(_PairCompute):
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, neighbors=neighbors)
 
-        self.thisptr.compute(nlist.get_ptr(),
-                             nq.get_ptr(), dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(nlist.get_ptr(),
+                                 nq.get_ptr(), dereference(qargs.thisptr))
         return self
 
     @property
@@ -661,7 +719,9 @@ cdef class Steinhardt(_PairCompute):
     def particle_order(self):
         """:math:`\\left(N_{particles}, N_l \\right)` :class:`numpy.ndarray`:
         Variant of the Steinhardt order parameter for each particle (filled with
-        :code:`nan` for particles with no neighbors)."""
+        :code:`nan` for particles with no neighbors). If :code:`wl` is
+        :code:`True`, the values are computed on the first access after each
+        compute."""
         array = freud.util.make_managed_numpy_array(
             &self.thisptr.getParticleOrder(), freud.util.arr_type_t.FLOAT)
         if array.shape[1] == 1:
@@ -686,13 +746,17 @@ cdef class Steinhardt(_PairCompute):
     def particle_harmonics(self):
         """:math:`\\left(N_{particles}, 2l+1\\right)` :class:`numpy.ndarray`:
         The raw array of :math:`q_{lm}(i)`. The array is provided in the
-        order given by fsph: :math:`m = 0, 1, ..., l, -1, ..., -l`."""
-        qlm_arrays = self.thisptr.getQlm()
-        # Since Cython does not really support const iteration, we must iterate
-        # using range and not use the for array in qlm_arrays style for loop.
-        qlm_list = [freud.util.make_managed_numpy_array(
-            &qlm_arrays[i], freud.util.arr_type_t.COMPLEX_FLOAT)
-            for i in range(qlm_arrays.size())]
+        order :math:`m = 0, 1, ..., l, -1, ..., -l`. If multiple :math:`l`
+        are computed, a list with one array per :math:`l` is returned. The
+        harmonics of all :math:`l` of each particle are stored contiguously,
+        so with multiple :math:`l` each returned array is a C-contiguous copy
+        of the columns of its :math:`l`."""
+        qlm_array = freud.util.make_managed_numpy_array(
+            &self.thisptr.getQlm(), freud.util.arr_type_t.COMPLEX_FLOAT)
+        qlm_list = [
+            np.ascontiguousarray(qlm_array[:, offset:offset + 2 * l + 1])
+            for offset, l in zip(self.thisptr.getMOffsets(),
+                                 self.thisptr.getL())]
         return qlm_list if len(qlm_list) > 1 else qlm_list[0]
 
     def compute(self, system, neighbors=None):
@@ -726,11 +790,59 @@ cdef class Steinhardt(_PairCompute):
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, neighbors=neighbors)
 
-        self.thisptr.compute(nlist.get_ptr(),
-                             nq.get_ptr(),
-                             dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(nlist.get_ptr(),
+                                 nq.get_ptr(),
+                                 dereference(qargs.thisptr))
+        return self
+
+    cdef freud._locality.BondStage * _bond_stage(
+            self, freud.locality.NeighborQuery nq,
+            unsigned int num_query_points, dict inputs,
+            list keep_alive) except NULL:
+        return self.thisptr
+
+    def compute_systems(self, batch, neighbors):
+        r"""Compute the order parameter of every system of a batch.
+
+        The systems are computed in a single parallel loop. The per-particle
+        arrays hold the points of all systems in the order of the batch, and
+        are the same as those of :meth:`compute` on each system. The order
+        parameter of each system is :attr:`system_order`, while
+        :attr:`order` is that of the points of all systems.
+
+        Args:
+            batch (:class:`freud.locality.SystemBatch`):
+                The systems to compute.
+            neighbors (dict):
+                Dictionary of `query arguments
+                <https://freud.readthedocs.io/en/stable/topics/querying.html>`_
+                of every system.
+        """
+        if isinstance(neighbors, freud.locality.NeighborList):
+            raise ValueError("compute_systems requires query arguments rather "
+                             "than a NeighborList.")
+        cdef freud.locality.SystemBatch system_batch = batch
+        cdef freud.locality._QueryArgs qargs
+        _, qargs = self._resolve_neighbors(neighbors)
+        cdef freud._locality.QueryArgs c_qargs = dereference(qargs.thisptr)
+        with nogil:
+            self.thisptr.computeSystems(dereference(system_batch.thisptr),
+                                        c_qargs)
         return self
 
+    @_Compute._computed_property
+    def system_order(self):
+        """:math:`\\left(N_{systems}, N_l \\right)` :class:`numpy.ndarray`:
+        The system wide normalization of the order parameter of each system
+        of the last call to :meth:`compute_systems` (filled with :code:`nan`
+        for systems without points)."""
+        array = freud.util.make_managed_numpy_array(
+            &self.thisptr.getSystemOrder(), freud.util.arr_type_t.FLOAT)
+        if array.shape[1] == 1:
+            return np.ravel(array)
+        return array
+
     def __repr__(self):
         return ("freud.order.{cls}(l={l}, average={average}, wl={wl}, "
                 "weighted={weighted}, wl_normalize={wl_normalize})").format(
@@ -858,9 +970,10 @@ cdef class SolidLiquid(_PairCompute):
 
         nq, nlist, qargs, l_query_points, num_query_points = \
             self._preprocess_arguments(system, neighbors=neighbors)
-        self.thisptr.compute(nlist.get_ptr(),
-                             nq.get_ptr(),
-                             dereference(qargs.thisptr))
+        with nogil:
+            self.thisptr.compute(nlist.get_ptr(),
+                                 nq.get_ptr(),
+                                 dereference(qargs.thisptr))
         return self
 
     @property
@@ -920,6 +1033,48 @@ cdef class SolidLiquid(_PairCompute):
         """unsigned int: The largest cluster size."""
         return self.thisptr.getLargestClusterSize()
 
+    def compute_largest_cluster_sizes(self, q_thresholds, solid_thresholds):
+        r"""Compute the largest cluster sizes for several pairs of thresholds.
+
+        The bond parameters :math:`q_l(i, j)` of the last call to
+        :meth:`~.compute` are reused, so threshold sweeps do not recompute the
+        spherical harmonics. The solid-like bonds for all thresholds are
+        counted in a single pass over the bonds. The thresholds of this
+        object are not changed.
+
+        Example::
+
+            >>> box, points = freud.data.UnitCell.fcc().generate_system(4)
+            >>> sl = freud.order.SolidLiquid(6, 0.7, 6)
+            >>> sl.compute((box, points), {'num_neighbors': 12})
+            freud.order.SolidLiquid(...)
+            >>> sl.compute_largest_cluster_sizes([0.5, 0.7], [6, 8])
+            array([256, 256], dtype=uint32)
+
+        Args:
+            q_thresholds ((:math:`N_{pairs}`) :class:`numpy.ndarray`):
+                Dot product thresholds of each pair.
+            solid_thresholds ((:math:`N_{pairs}`) :class:`numpy.ndarray`):
+                Solid-like bond count thresholds of each pair.
+
+        Returns:
+            (:math:`N_{pairs}`) :class:`numpy.ndarray`:
+                The largest cluster size for each pair of thresholds.
+        """
+        cdef:
+            vector[float] l_q_thresholds
+            vector[unsigned int] l_solid_thresholds
+
+        if not self._called_compute:
+            raise AttributeError(
+                "The compute method must be called before computing "
+                "cluster sizes for other thresholds.")
+        l_q_thresholds = np.atleast_1d(q_thresholds).astype(np.float32)
+        l_solid_thresholds = np.atleast_1d(solid_thresholds).astype(np.uint32)
+        with self._lock:
+            return np.asarray(self.thisptr.computeLargestClusterSizes(
+                l_q_thresholds, l_solid_thresholds), dtype=np.uint32)
+
     @_Compute._computed_property
     def nlist(self):
         """:class:`freud.locality.NeighborList`: Neighbor list of solid-like
@@ -996,7 +1151,9 @@ cdef class RotationalAutocorrelation(_Compute):
     correlation with an initial state. As such, the output can be treated as an
     order parameter measuring degrees of rotational (de)correlation. For
     analysis of a trajectory, the compute call needs to be
-    done at each trajectory frame.
+    done at each trajectory frame. Alternatively, :meth:`compute_frames`
+    computes the autocorrelation of a whole trajectory at logarithmically
+    spaced lags.
 
     Args:
         l (int):
@@ -1032,12 +1189,69 @@ cdef class RotationalAutocorrelation(_Compute):
         cdef const float[:, ::1] l_orientations = orientations
         cdef unsigned int nP = orientations.shape[0]
 
-        self.thisptr.compute(
-            <quat[float]*> &l_ref_orientations[0, 0],
-            <quat[float]*> &l_orientations[0, 0],
-            nP)
+        with nogil:
+            self.thisptr.compute(
+                <quat[float]*> &l_ref_orientations[0, 0],
+                <quat[float]*> &l_orientations[0, 0],
+                nP)
         return self
 
+    def compute_frames(self, orientations, reset=True, points_per_level=16):
+        r"""Calculates the rotational autocorrelation function of a trajectory
+        at all lags.
+
+        Each frame is correlated with previous frames with a multiple-tau
+        scheme: the latest :code:`points_per_level` frames give the lags 0 to
+        :code:`points_per_level - 1`, and the latest frames at every :math:`2^k`
+        frames give the lags :math:`j 2^k` for
+        :code:`points_per_level / 2` :math:`\le j <` :code:`points_per_level`.
+        The autocorrelation at each lag is averaged over all pairs of these
+        frames, which are not averaged over time, so long trajectories can be
+        accumulated in chunks with memory that only grows logarithmically
+        with their length.
+
+        Args:
+            orientations ((:math:`N_{frames}`, :math:`N_{orientations}`, 4) :class:`numpy.ndarray`):
+                Orientations of consecutive frames of a trajectory.
+            reset (bool):
+                Whether to erase the previously accumulated frames; if False,
+                the frames continue the trajectory of the previous call
+                (Default value: True).
+            points_per_level (unsigned int, optional):
+                Even number of frames kept per level, used when the frames
+                are reset (Default value = :code:`16`).
+        """  # noqa: E501
+        if reset:
+            self.thisptr.resetFrames(points_per_level)
+
+        orientations = freud.util._convert_array(
+            orientations, shape=(None, None, 4))
+        cdef const float[:, :, ::1] l_orientations = orientations
+        cdef unsigned int n_frames = l_orientations.shape[0]
+        cdef unsigned int nP = l_orientations.shape[1]
+        if n_frames > 0:
+            with nogil:
+                self.thisptr.accumulateFrames(
+                    <quat[float]*> &l_orientations[0, 0, 0], n_frames, nP)
+        return self
+
+    @_Compute._computed_property
+    def lags(self):
+        """(:math:`N_{lags}`) :class:`numpy.ndarray`: The lags in frames
+        resolved by :meth:`compute_frames`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getLags(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def lag_order(self):
+        """(:math:`N_{lags}`) :class:`numpy.ndarray`: Autocorrelation of the
+        system at each of the :attr:`lags` computed by
+        :meth:`compute_frames`."""
+        return freud.util.make_managed_numpy_array(
+            &self.thisptr.getLagAutocorrelation(),
+            freud.util.arr_type_t.FLOAT)
+
     @_Compute._computed_property
     def order(self):
         """float: Autocorrelation of the system."""
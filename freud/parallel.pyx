@@ -5,12 +5,30 @@ r"""
 The :class:`freud.parallel` module controls the parallelization behavior of
 freud, determining how many threads the TBB-enabled parts of freud will use.
 freud uses all available threads for parallelization unless directed otherwise.
+Computes called within a :class:`ThreadArena` are limited to the threads of
+their own task arena, so that computes running concurrently in several Python
+threads do not oversubscribe the cores. Computes release the GIL, so that
+different compute objects, which may share the same
+:class:`freud.locality.NeighborQuery` and :class:`freud.locality.NeighborList`,
+run concurrently in different Python threads, while concurrent calls on the
+same compute object are serialized. The module also determines whether the
+floating point sums of computes over threads are reproducible and in which
+precision they are accumulated. It can also time the phases of computes and
+report and limit the memory of their arrays.
 """
 
+from libcpp.vector cimport vector
+
 cimport freud._parallel
 
 _num_threads = 0
 
+_accumulator_precisions = {
+    "automatic": freud._parallel.accumulate_automatic,
+    "single": freud._parallel.accumulate_single,
+    "mixed": freud._parallel.accumulate_mixed,
+}
+
 
 def get_num_threads():
     r"""Get the number of threads for parallel computation.
@@ -40,6 +58,368 @@ def set_num_threads(nthreads=None):
     freud._parallel.setNumThreads(cNthreads)
 
 
+def get_deterministic_reductions():
+    r"""Get whether parallel sums are independent of the scheduling of threads.
+
+    Returns:
+        bool: Whether deterministic reductions are enabled.
+    """
+    return freud._parallel.getDeterministicReductions()
+
+
+def set_deterministic_reductions(deterministic=True):
+    r"""Set whether parallel sums are independent of the scheduling of threads.
+
+    By default, each thread sums the contributions of the items that it
+    happens to process, so floating point results of computes that sum over
+    particles, bonds, or wave vectors may differ in the last digits between
+    runs and numbers of threads. With deterministic reductions, these
+    computes sum fixed ranges of items and add the partial sums of the ranges
+    pairwise in a fixed order, which makes the results reproducible for any
+    number of threads at the cost of a small overhead. This affects
+    :class:`freud.order.Steinhardt`, :class:`freud.order.Nematic`,
+    :class:`freud.order.Cubatic`,
+    :class:`freud.order.RotationalAutocorrelation`,
+    :class:`freud.msd.MSD`, and the static structure factors in
+    :mod:`freud.diffraction`. Integer counts, such as those of histograms,
+    are always deterministic.
+
+    Args:
+        deterministic (bool, optional):
+            Whether to enable deterministic reductions.
+            (Default value = :code:`True`).
+    """
+    freud._parallel.setDeterministicReductions(deterministic)
+
+
+def get_accumulator_precision():
+    r"""Get the precision in which the floating point sums of computes are
+    accumulated.
+
+    Returns:
+        str: One of :code:`'automatic'`, :code:`'single'` or :code:`'mixed'`.
+    """
+    precision = freud._parallel.getAccumulatorPrecision()
+    for name, value in _accumulator_precisions.items():
+        if value == precision:
+            return name
+
+
+def set_accumulator_precision(precision="automatic"):
+    r"""Set the precision in which the floating point sums of computes are
+    accumulated.
+
+    Outputs are stored in the same types in all modes. With
+    :code:`'automatic'`, each compute sums in the precision it uses by
+    default. With :code:`'single'`, sums are accumulated in single precision,
+    which is faster but loses accuracy for sums of many terms. With
+    :code:`'mixed'`, sums are accumulated in double precision and the results
+    are stored in single precision. This affects the normalization of the
+    histograms of :class:`freud.density.RDF`,
+    :class:`freud.density.PartialRDF`, :class:`freud.environment.BondOrder`
+    and the PMFTs in :mod:`freud.pmft`, the averages over particles of
+    :class:`freud.order.Steinhardt`, and the sums over pairs of
+    :class:`freud.diffraction.StaticStructureFactorDebye`, which accumulates
+    in double precision by default. The precision of
+    :class:`freud.density.CorrelationFunction` is that of its values.
+
+    Args:
+        precision (str, optional):
+            One of :code:`'automatic'`, :code:`'single'` or :code:`'mixed'`.
+            (Default value = :code:`'automatic'`).
+    """
+    if precision not in _accumulator_precisions:
+        raise ValueError(
+            "precision must be one of {}.".format(
+                ", ".join(map(repr, _accumulator_precisions))))
+    freud._parallel.setAccumulatorPrecision(
+        _accumulator_precisions[precision])
+
+
+def get_grain_tuning():
+    r"""Get whether the grain sizes of parallel loops are tuned.
+
+    Returns:
+        bool: Whether grain sizes are tuned.
+    """
+    return freud._parallel.getGrainTuning()
+
+
+def set_grain_tuning(tune=True):
+    r"""Set whether the grain sizes of parallel loops are tuned.
+
+    Some parallel loops over many items of cheap work, such as the methods of
+    :class:`freud.box.Box` on arrays of points, measure the run times of their
+    first calls with several grain sizes, i.e. minimum numbers of items
+    processed by a thread at once. Later calls with a similar number of items
+    and the same number of threads use the fastest grain size. Tuning is
+    enabled by default. Grain sizes that are already tuned are used even if
+    tuning is disabled.
+
+    Args:
+        tune (bool, optional):
+            Whether to tune grain sizes. (Default value = :code:`True`).
+    """
+    freud._parallel.setGrainTuning(tune)
+
+
+def get_grain_sizes():
+    r"""Get the tuned grain sizes of parallel loops.
+
+    The grain sizes can be saved, e.g. as JSON, and restored in later
+    processes with :func:`set_grain_sizes` to skip tuning.
+
+    Returns:
+        list[dict]: The tuned grain sizes, each a dictionary with keys
+        :code:`"loop"` (the name of the loop), :code:`"log2_size"` (calls
+        have between :math:`2^{log2\_size}` and :math:`2^{log2\_size + 1}`
+        items), :code:`"concurrency"` (the number of threads) and
+        :code:`"grain_size"`.
+    """
+    grain_sizes = freud._parallel.getTunedGrainSizes()
+    return [dict(grain_size, loop=grain_size["loop"].decode())
+            for grain_size in grain_sizes]
+
+
+def set_grain_sizes(grain_sizes):
+    r"""Replace the tuned grain sizes of parallel loops.
+
+    Args:
+        grain_sizes (list[dict]):
+            Grain sizes as returned by :func:`get_grain_sizes`. An empty list
+            restarts tuning from scratch.
+    """
+    cdef vector[freud._parallel.TunedGrainSize] c_grain_sizes
+    cdef freud._parallel.TunedGrainSize c_grain_size
+    for grain_size in grain_sizes:
+        c_grain_size.loop = grain_size["loop"].encode()
+        c_grain_size.log2_size = grain_size["log2_size"]
+        c_grain_size.concurrency = grain_size["concurrency"]
+        c_grain_size.grain_size = grain_size["grain_size"]
+        c_grain_sizes.push_back(c_grain_size)
+    freud._parallel.setTunedGrainSizes(c_grain_sizes)
+
+
+def get_instrumentation():
+    r"""Get whether the phases of computes are timed.
+
+    Returns:
+        bool: Whether instrumentation is enabled.
+    """
+    return freud._parallel.getInstrumentation()
+
+
+def set_instrumentation(enable=True):
+    r"""Set whether the phases of computes are timed.
+
+    While instrumentation is enabled, the main phases of computes such as
+    :class:`freud.density.RDF`, :class:`freud.order.Steinhardt`,
+    :class:`freud.density.GaussianDensity` and the static structure factors
+    in :mod:`freud.diffraction`, as well as the neighbor queries, the loops
+    over neighbors and the reductions of histograms of all computes, record
+    their wall time, the number of neighbor bonds they process and the number
+    of bytes of arrays allocated while they run. The statistics are read with
+    :func:`get_phase_statistics`. Instrumentation is disabled by default, and
+    builds configured with :code:`-DENABLE_INSTRUMENTATION=OFF` never record
+    statistics. Builds configured with :code:`-DENABLE_ITT=ON` also annotate
+    the timed phases as ITT tasks, which are shown by profilers such as
+    Intel VTune.
+
+    Args:
+        enable (bool, optional):
+            Whether to enable instrumentation. (Default value = :code:`True`).
+    """
+    freud._parallel.setInstrumentation(enable)
+
+
+def get_phase_statistics():
+    r"""Get the statistics of the phases timed since the last call to
+    :func:`reset_phase_statistics`.
+
+    Phases that run within other phases are named by the names of the
+    enclosing phases and of the phase, separated by :code:`"/"`, e.g.
+    :code:`"Steinhardt::compute/harmonics/loopOverNeighbors"`. The time of a
+    phase includes the times of the phases within it. The bytes of a phase
+    are those of the arrays allocated by all threads while the phase runs,
+    including those of computes in other threads.
+
+    Returns:
+        list[dict]: The statistics of each phase, sorted by phase, each a
+        dictionary with keys :code:`"phase"`, :code:`"calls"`,
+        :code:`"seconds"` (the total wall time), :code:`"bonds"` and
+        :code:`"bytes"`.
+    """
+    statistics = freud._parallel.getPhaseStatistics()
+    return [dict(phase, phase=phase["phase"].decode())
+            for phase in statistics]
+
+
+def reset_phase_statistics():
+    r"""Discard the statistics of all timed phases."""
+    freud._parallel.resetPhaseStatistics()
+
+
+def get_memory_usage():
+    r"""Get the memory of the arrays in use, by the object that allocated them.
+
+    The arrays of computes and neighbor lists, including the thread local
+    copies of the arrays of computes, are attributed to their owner, such as
+    :code:`"RDF"`, :code:`"PMFT"` or :code:`"NeighborList"`. Arrays
+    allocated outside of the computes, e.g. neighbor lists created from
+    arrays, have the owner :code:`""`. Only the arrays of results and of
+    thread local accumulators are counted, not temporary data structures
+    such as the trees of neighbor queries.
+
+    Returns:
+        list[dict]: The usage of each owner, sorted by owner, each a
+        dictionary with keys :code:`"owner"`, :code:`"current"` (the number
+        of bytes in use) and :code:`"peak"` (the largest number of bytes in
+        use since the last call to :func:`reset_peak_memory`).
+    """
+    usages = freud._parallel.BufferPool.getInstance().getMemoryUsage()
+    return [dict(usage, owner=usage["owner"].decode()) for usage in usages]
+
+
+def get_bytes_in_use():
+    r"""Get the number of bytes of all arrays in use.
+
+    Returns:
+        tuple[int, int]: The number of bytes in use and the largest number of
+        bytes in use since the last call to :func:`reset_peak_memory`.
+    """
+    cdef freud._parallel.BufferPool* pool = &freud._parallel.BufferPool.getInstance()
+    return pool.getBytesInUse(), pool.getPeakBytesInUse()
+
+
+def reset_peak_memory():
+    r"""Reset the peak memory of all owners to their current memory."""
+    freud._parallel.BufferPool.getInstance().resetPeakMemory()
+
+
+def get_memory_budget():
+    r"""Get the maximum number of bytes of arrays in use.
+
+    Returns:
+        int: The budget in bytes, or 0 if the memory is not limited.
+    """
+    return freud._parallel.BufferPool.getInstance().getMemoryBudget()
+
+
+def set_memory_budget(budget=0):
+    r"""Set the maximum number of bytes of arrays in use.
+
+    Computes whose memory-bound modes would exceed the budget switch to modes
+    using less memory. In particular, the PMFTs accumulate into a single
+    histogram shared by all threads instead of a copy per thread. Computes
+    that still need more memory than the budget raise :class:`MemoryError`.
+
+    Args:
+        budget (int, optional):
+            The budget in bytes, or 0 to not limit the memory.
+            (Default value = 0).
+    """
+    if budget < 0:
+        raise ValueError("The memory budget must be nonnegative.")
+    freud._parallel.BufferPool.getInstance().setMemoryBudget(budget)
+
+
+def get_numa_nodes():
+    r"""Get the NUMA nodes that a :class:`ThreadArena` can be pinned to.
+
+    Returns:
+        list[int]: Indices of the NUMA nodes, which are :code:`[-1]` if the
+        topology of the machine cannot be detected.
+    """
+    return list(freud._parallel.getNumaNodes())
+
+
+class ThreadArena:
+    r"""Context manager running the computes of the calling thread in their
+    own task arena.
+
+    By default, all computes share the threads of one global task arena. When
+    several computes run concurrently, e.g. in the threads of a Dask worker,
+    each of them would use all of these threads. Within this context, the
+    parallel loops of computes called from the current Python thread run on at
+    most :code:`max_concurrency` threads, optionally pinned to the cores of a
+    NUMA node, while computes in other threads are unaffected. Contexts may be
+    nested, and the number of threads of an arena is further limited by
+    :func:`set_num_threads`.
+
+    Args:
+        max_concurrency (int, optional):
+            Maximum number of threads of the arena, including the calling
+            thread. If :code:`None`, use the number of threads allowed by
+            :func:`set_num_threads`. (Default value = :code:`None`).
+        numa_node (int, optional):
+            NUMA node to whose cores the threads are pinned, one of
+            :func:`get_numa_nodes`. If :code:`None`, the threads may run on
+            any core. (Default value = :code:`None`).
+        max_threads_per_core (int, optional):
+            Maximum number of threads on each core, e.g. 1 to avoid sharing
+            cores between hyperthreads. If :code:`None`, there is no limit.
+            (Default value = :code:`None`).
+    """
+
+    def __init__(self, max_concurrency=None, numa_node=None,
+                 max_threads_per_core=None):
+        if max_concurrency is not None and max_concurrency < 1:
+            raise ValueError("max_concurrency must be at least 1.")
+        self.max_concurrency = max_concurrency
+        self.numa_node = numa_node
+        self.max_threads_per_core = max_threads_per_core
+
+    def __enter__(self):
+        cdef unsigned int c_max_concurrency = 0
+        cdef int c_numa_node = -1
+        cdef int c_max_threads_per_core = -1
+        if self.max_concurrency is not None:
+            c_max_concurrency = self.max_concurrency
+        if self.numa_node is not None:
+            c_numa_node = self.numa_node
+        if self.max_threads_per_core is not None:
+            c_max_threads_per_core = self.max_threads_per_core
+        freud._parallel.pushThreadArena(
+            c_max_concurrency, c_numa_node, c_max_threads_per_core)
+        return self
+
+    def __exit__(self, *args):
+        freud._parallel.popThreadArena()
+
+
+class PhaseTimers:
+    r"""Context manager timing the phases of the computes called within it.
+
+    On entry, the statistics of all phases are discarded and instrumentation
+    is enabled. On exit, instrumentation is restored to its previous state
+    and the statistics are stored in :attr:`statistics`.
+
+    Example::
+
+        >>> with freud.parallel.PhaseTimers() as timers:
+        ...     ql = freud.order.Steinhardt(6).compute(system, neighbors)
+        >>> for phase in timers.statistics:
+        ...     print(phase["phase"], phase["seconds"])
+
+    Attributes:
+        statistics (list[dict]):
+            The statistics of the phases, see :func:`get_phase_statistics`.
+    """
+
+    def __init__(self):
+        self.statistics = []
+
+    def __enter__(self):
+        self._restore = get_instrumentation()
+        reset_phase_statistics()
+        set_instrumentation(True)
+        return self
+
+    def __exit__(self, *args):
+        set_instrumentation(self._restore)
+        self.statistics = get_phase_statistics()
+
+
 class NumThreads:
     r"""Context manager for managing the number of threads to use.
 
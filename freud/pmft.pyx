@@ -109,6 +109,27 @@ cdef class _PMFT(_SpatialHistogram):
         if type(self) is _PMFT:
             del self.pmftptr
 
+    @property
+    def sparse(self):
+        """bool: Whether only the occupied bins are accumulated and
+        output."""
+        return self.pmftptr.isSparse()
+
+    def _check_sparse(self, sparse):
+        if self.sparse != sparse:
+            if sparse:
+                raise ValueError("Sparse outputs are only available when "
+                                 "the PMFT is constructed with sparse=True.")
+            raise ValueError("Dense outputs are not available when the PMFT "
+                             "is constructed with sparse=True; use the "
+                             "sparse outputs instead.")
+
+    @_Compute._computed_property
+    def bin_counts(self):
+        """:class:`numpy.ndarray`: The bin counts in the histogram."""
+        self._check_sparse(False)
+        return super(_PMFT, self).bin_counts
+
     @_Compute._computed_property
     def pmft(self):
         """:class:`np.ndarray`: The discrete potential of mean force and
@@ -120,10 +141,46 @@ cdef class _PMFT(_SpatialHistogram):
     @_Compute._computed_property
     def _pcf(self):
         """:class:`np.ndarray`: The discrete pair correlation function."""
+        self._check_sparse(False)
         return freud.util.make_managed_numpy_array(
             &self.pmftptr.getPCF(),
             freud.util.arr_type_t.FLOAT)
 
+    @_Compute._computed_property
+    def sparse_bins(self):
+        """:math:`(N_{occupied}, N_{axes})` :class:`numpy.ndarray`: The
+        indices along each axis of the occupied bins, in row-major order.
+        Only available in sparse mode."""
+        self._check_sparse(True)
+        return freud.util.make_managed_numpy_array(
+            &self.pmftptr.getSparseBins(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def sparse_bin_counts(self):
+        """:math:`(N_{occupied},)` :class:`numpy.ndarray`: The bin counts of
+        the occupied bins. Only available in sparse mode."""
+        self._check_sparse(True)
+        return freud.util.make_managed_numpy_array(
+            &self.pmftptr.getSparseBinCounts(),
+            freud.util.arr_type_t.UNSIGNED_INT)
+
+    @_Compute._computed_property
+    def sparse_pmft(self):
+        """:math:`(N_{occupied},)` :class:`numpy.ndarray`: The potential of
+        mean force and torque of the occupied bins. Only available in sparse
+        mode."""
+        return -np.log(np.copy(self._sparse_pcf))
+
+    @_Compute._computed_property
+    def _sparse_pcf(self):
+        """:class:`np.ndarray`: The pair correlation function of the occupied
+        bins."""
+        self._check_sparse(True)
+        return freud.util.make_managed_numpy_array(
+            &self.pmftptr.getSparsePCF(),
+            freud.util.arr_type_t.FLOAT)
+
 
 cdef class PMFTR12(_PMFT):
     r"""Computes the PMFT :cite:`vanAnders:2014aa,van_Anders_2013` in a 2D
@@ -141,17 +198,23 @@ cdef class PMFTR12(_PMFT):
             :math:`\theta_1`, and :math:`\theta_2`. If a sequence of three
             integers, interpreted as :code:`(num_bins_r, num_bins_t1,
             num_bins_t2)`.
+        sparse (bool):
+            If True, only the occupied bins are accumulated and output through
+            :attr:`sparse_bins`, :attr:`sparse_bin_counts` and
+            :attr:`sparse_pmft`, and the dense outputs are not available. This
+            reduces memory use for fine grids with mostly empty bins (Default
+            value = :code:`False`).
     """  # noqa: E501
     cdef freud._pmft.PMFTR12 * pmftr12ptr
 
-    def __cinit__(self, r_max, bins):
+    def __cinit__(self, r_max, bins, sparse=False):
         if type(self) is PMFTR12:
             try:
                 n_r, n_t1, n_t2 = bins
             except TypeError:
                 n_r = n_t1 = n_t2 = bins
             self.pmftr12ptr = self.pmftptr = self.histptr = \
-                new freud._pmft.PMFTR12(r_max, n_r, n_t1, n_t2)
+                new freud._pmft.PMFTR12(r_max, n_r, n_t1, n_t2, sparse)
             self.r_max = r_max
 
     def __dealloc__(self):
@@ -216,20 +279,23 @@ cdef class PMFTR12(_PMFT):
         cdef const float[::1] l_orientations = orientations
         cdef const float[::1] l_query_orientations = query_orientations
 
-        self.pmftr12ptr.accumulate(nq.get_ptr(),
-                                   <float*> &l_orientations[0],
-                                   <vec3[float]*> &l_query_points[0, 0],
-                                   <float*> &l_query_orientations[0],
-                                   num_query_points, nlist.get_ptr(),
-                                   dereference(qargs.thisptr))
+        with nogil:
+            self.pmftr12ptr.accumulate(nq.get_ptr(),
+                                       <float*> &l_orientations[0],
+                                       <vec3[float]*> &l_query_points[0, 0],
+                                       <float*> &l_query_orientations[0],
+                                       num_query_points, nlist.get_ptr(),
+                                       dereference(qargs.thisptr))
         return self
 
     def __repr__(self):
         bounds = self.bounds
-        return ("freud.pmft.{cls}(r_max={r_max}, bins=({bins}))").format(
+        return ("freud.pmft.{cls}(r_max={r_max}, bins=({bins}), "
+                "sparse={sparse})").format(
             cls=type(self).__name__,
             r_max=self.r_max,
-            bins=', '.join([str(b) for b in self.nbins]))
+            bins=', '.join([str(b) for b in self.nbins]),
+            sparse=self.sparse)
 
 
 cdef class PMFTXYT(_PMFT):
@@ -325,12 +391,13 @@ cdef class PMFTXYT(_PMFT):
         cdef const float[::1] l_orientations = orientations
         cdef const float[::1] l_query_orientations = query_orientations
 
-        self.pmftxytptr.accumulate(nq.get_ptr(),
-                                   <float*> &l_orientations[0],
-                                   <vec3[float]*> &l_query_points[0, 0],
-                                   <float*> &l_query_orientations[0],
-                                   num_query_points, nlist.get_ptr(),
-                                   dereference(qargs.thisptr))
+        with nogil:
+            self.pmftxytptr.accumulate(nq.get_ptr(),
+                                       <float*> &l_orientations[0],
+                                       <vec3[float]*> &l_query_points[0, 0],
+                                       <float*> &l_query_orientations[0],
+                                       num_query_points, nlist.get_ptr(),
+                                       dereference(qargs.thisptr))
         return self
 
     def __repr__(self):
@@ -434,11 +501,12 @@ cdef class PMFTXY(_PMFT):
             query_orientations, shape=(num_query_points, ))
         cdef const float[::1] l_query_orientations = query_orientations
 
-        self.pmftxyptr.accumulate(nq.get_ptr(),
-                                  <float*> &l_query_orientations[0],
-                                  <vec3[float]*> &l_query_points[0, 0],
-                                  num_query_points, nlist.get_ptr(),
-                                  dereference(qargs.thisptr))
+        with nogil:
+            self.pmftxyptr.accumulate(nq.get_ptr(),
+                                      <float*> &l_query_orientations[0],
+                                      <vec3[float]*> &l_query_points[0, 0],
+                                      num_query_points, nlist.get_ptr(),
+                                      dereference(qargs.thisptr))
         return self
 
     @_Compute._computed_property
@@ -502,12 +570,18 @@ cdef class PMFTXYZ(_PMFT):
             :code:`(num_bins_x, num_bins_y, num_bins_z)`.
         shiftvec (list):
             Vector pointing from ``[0, 0, 0]`` to the center of the PMFT.
+        sparse (bool):
+            If True, only the occupied bins are accumulated and output through
+            :attr:`sparse_bins`, :attr:`sparse_bin_counts` and
+            :attr:`sparse_pmft`, and the dense outputs are not available. This
+            reduces memory use for fine grids with mostly empty bins (Default
+            value = :code:`False`).
     """  # noqa: E501
     cdef freud._pmft.PMFTXYZ * pmftxyzptr
     cdef shiftvec
 
     def __cinit__(self, x_max, y_max, z_max, bins,
-                  shiftvec=[0, 0, 0]):
+                  shiftvec=[0, 0, 0], sparse=False):
         cdef vec3[float] c_shiftvec
 
         try:
@@ -520,7 +594,7 @@ cdef class PMFTXYZ(_PMFT):
                 shiftvec[0], shiftvec[1], shiftvec[2])
             self.pmftxyzptr = self.pmftptr = self.histptr = \
                 new freud._pmft.PMFTXYZ(
-                    x_max, y_max, z_max, n_x, n_y, n_z, c_shiftvec)
+                    x_max, y_max, z_max, n_x, n_y, n_z, c_shiftvec, sparse)
             self.shiftvec = np.array(shiftvec, dtype=np.float32)
             self.r_max = np.sqrt(x_max**2 + y_max**2 + z_max**2)
 
@@ -598,24 +672,26 @@ cdef class PMFTXYZ(_PMFT):
         cdef const float[:, ::1] l_equiv_orientations = equiv_orientations
         cdef unsigned int num_equiv_orientations = \
             l_equiv_orientations.shape[0]
-        self.pmftxyzptr.accumulate(
-            nq.get_ptr(),
-            <quat[float]*> &l_query_orientations[0, 0],
-            <vec3[float]*> &l_query_points[0, 0],
-            num_query_points,
-            <quat[float]*> &l_equiv_orientations[0, 0],
-            num_equiv_orientations, nlist.get_ptr(),
-            dereference(qargs.thisptr))
+        with nogil:
+            self.pmftxyzptr.accumulate(
+                nq.get_ptr(),
+                <quat[float]*> &l_query_orientations[0, 0],
+                <vec3[float]*> &l_query_points[0, 0],
+                num_query_points,
+                <quat[float]*> &l_equiv_orientations[0, 0],
+                num_equiv_orientations, nlist.get_ptr(),
+                dereference(qargs.thisptr))
         return self
 
     def __repr__(self):
         bounds = self.bounds
         return ("freud.pmft.{cls}(x_max={x_max}, y_max={y_max}, "
                 "z_max={z_max}, bins=({bins}), "
-                "shiftvec={shiftvec})").format(
+                "shiftvec={shiftvec}, sparse={sparse})").format(
                     cls=type(self).__name__,
                     x_max=bounds[0][1],
                     y_max=bounds[1][1],
                     z_max=bounds[2][1],
                     bins=', '.join([str(b) for b in self.nbins]),
-                    shiftvec=self.shiftvec.tolist())
+                    shiftvec=self.shiftvec.tolist(),
+                    sparse=self.sparse)
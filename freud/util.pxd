@@ -5,8 +5,10 @@
 # arguments to interface with the C++ implementations of all methods.
 from cpython cimport Py_INCREF
 from cython.operator cimport dereference
+from libc.stdint cimport uint64_t
 from libcpp cimport bool
 from libcpp.complex cimport complex
+from libcpp.vector cimport vector
 
 from freud._util cimport ManagedArray, PyArray_SetBaseObject, quat, vec3
 import numpy as np
@@ -14,6 +16,7 @@ import numpy as np
 cimport numpy as np
 
 ctypedef unsigned int uint
+ctypedef unsigned char uchar
 ctypedef float complex fcomplex
 ctypedef double complex dcomplex
 
@@ -24,6 +27,9 @@ ctypedef enum arr_type_t:
     COMPLEX_DOUBLE
     UNSIGNED_INT
     BOOL
+    SIZE_T
+    UNSIGNED_CHAR
+    INT
 
 
 ctypedef union arr_ptr_t:
@@ -34,6 +40,9 @@ ctypedef union arr_ptr_t:
     ManagedArray[double complex] *complex_double_ptr
     ManagedArray[uint] *uint_ptr
     ManagedArray[bool] *bool_ptr
+    ManagedArray[size_t] *size_t_ptr
+    ManagedArray[uchar] *uchar_ptr
+    ManagedArray[int] *int_ptr
 
 
 cdef class _ManagedArrayContainer:
@@ -41,9 +50,12 @@ cdef class _ManagedArrayContainer:
     cdef int var_typenum
     cdef arr_ptr_t thisptr
     cdef arr_type_t data_type
+    cdef vector[Py_ssize_t] _buffer_shape
+    cdef vector[Py_ssize_t] _buffer_strides
 
     cdef void set_as_base(self, arr)
     cdef void *get(self)
+    cdef Py_ssize_t itemsize(self)
 
     @staticmethod
     cdef inline _ManagedArrayContainer init(
@@ -80,17 +92,32 @@ cdef class _ManagedArrayContainer:
                                          element_size)
             obj.thisptr.bool_ptr = new ManagedArray[bool](
                 dereference(<const ManagedArray[bool] *>array))
+        elif arr_type == arr_type_t.SIZE_T:
+            obj = _ManagedArrayContainer(arr_type, np.NPY_UINTP,
+                                         element_size)
+            obj.thisptr.size_t_ptr = new ManagedArray[size_t](
+                dereference(<const ManagedArray[size_t] *>array))
+        elif arr_type == arr_type_t.UNSIGNED_CHAR:
+            obj = _ManagedArrayContainer(arr_type, np.NPY_UINT8,
+                                         element_size)
+            obj.thisptr.uchar_ptr = new ManagedArray[uchar](
+                dereference(<const ManagedArray[uchar] *>array))
+        elif arr_type == arr_type_t.INT:
+            obj = _ManagedArrayContainer(arr_type, np.NPY_INT32,
+                                         element_size)
+            obj.thisptr.int_ptr = new ManagedArray[int](
+                dereference(<const ManagedArray[int] *>array))
 
         return obj
 
 
-cdef inline make_managed_numpy_array(
-        const void *array, arr_type_t arr_type, uint element_size=1):
-    """Make a _ManagedArrayContainer and return an array pointing to its
-    data."""
-    return np.asarray(
-        _ManagedArrayContainer.init(array, arr_type, element_size))
+cdef uint64_t get_generation(const void *array, arr_type_t arr_type)
+
+
+cdef make_managed_numpy_array(
+    const void *array, arr_type_t arr_type, uint element_size=*)
 
 
 cdef class _Compute:
     cdef public bool _called_compute
+    cdef readonly object _lock
@@ -1,18 +1,83 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+import threading
+import weakref
 from functools import wraps
 
 import numpy as np
 
 import freud.box
 
+from cpython cimport Py_DECREF
+from cpython.buffer cimport PyBUF_FORMAT, PyBUF_WRITABLE
+from cpython.pycapsule cimport (
+    PyCapsule_GetPointer,
+    PyCapsule_IsValid,
+    PyCapsule_New,
+)
+from libc.stdint cimport int32_t, int64_t, uint8_t, uint16_t, uint64_t
+from libc.stdlib cimport free, malloc
+
 cimport numpy as np
 
 # numpy must be initialized. When using numpy from C or Cython you must
 # _always_ do that, or you will have segfaults
 np.import_array()
 
+# The arrays exported for the generations of the data of ManagedArrays, which
+# are reused for as long as they are referenced.
+_exported_arrays = weakref.WeakValueDictionary()
+
+# The structs of the DLPack (https://dmlc.github.io/dlpack) ABI.
+cdef enum:
+    kDLInt = 0
+    kDLUInt = 1
+    kDLFloat = 2
+    kDLComplex = 5
+    kDLBool = 6
+    kDLCPU = 1
+
+cdef struct DLDevice:
+    int32_t device_type
+    int32_t device_id
+
+cdef struct DLDataType:
+    uint8_t code
+    uint8_t bits
+    uint16_t lanes
+
+cdef struct DLTensor:
+    void *data
+    DLDevice device
+    int32_t ndim
+    DLDataType dtype
+    int64_t *shape
+    int64_t *strides
+    uint64_t byte_offset
+
+cdef struct DLManagedTensor:
+    DLTensor dl_tensor
+    void *manager_ctx
+    void (*deleter)(DLManagedTensor *)
+
+
+cdef void _dlpack_deleter(DLManagedTensor *tensor) with gil:
+    """Release the container exported by a DLPack tensor."""
+    Py_DECREF(<object> tensor.manager_ctx)
+    free(tensor.dl_tensor.shape)
+    free(tensor)
+
+
+cdef void _dlpack_capsule_destructor(object capsule):
+    """Delete DLPack tensors whose capsules were never consumed, which
+    consumers would have renamed to used_dltensor."""
+    cdef DLManagedTensor *tensor
+    if PyCapsule_IsValid(capsule, b"dltensor"):
+        tensor = <DLManagedTensor *> PyCapsule_GetPointer(
+            capsule, b"dltensor")
+        tensor.deleter(tensor)
+
 
 cdef class _ManagedArrayContainer:
     """Class responsible for synchronizing ownership between two ManagedArray
@@ -37,6 +102,10 @@ cdef class _ManagedArrayContainer:
     :meth:`~_ManagedArrayContainer.init` method, which creates the Python copy
     of a ManagedArray provided the instance member of the underlying C++
     compute class.
+
+    Besides the NumPy array interface, the data is exported read-only through
+    the buffer protocol and DLPack, so that other libraries can use it without
+    a copy. :func:`export_array` returns the container of a freud array.
     """
 
     def __cinit__(self, arr_type, typenum, element_size):
@@ -61,11 +130,21 @@ cdef class _ManagedArrayContainer:
             return tuple(self.thisptr.complex_double_ptr.shape())
         elif self.data_type == arr_type_t.BOOL:
             return tuple(self.thisptr.bool_ptr.shape())
+        elif self.data_type == arr_type_t.SIZE_T:
+            return tuple(self.thisptr.size_t_ptr.shape())
+        elif self.data_type == arr_type_t.UNSIGNED_CHAR:
+            return tuple(self.thisptr.uchar_ptr.shape())
+        elif self.data_type == arr_type_t.INT:
+            return tuple(self.thisptr.int_ptr.shape())
 
     @property
     def element_size(self):
         return self._element_size
 
+    @property
+    def generation(self):
+        return get_generation(self.thisptr.null_ptr, self.data_type)
+
     def __dealloc__(self):
         if self.data_type == arr_type_t.UNSIGNED_INT:
             del self.thisptr.uint_ptr
@@ -79,6 +158,12 @@ cdef class _ManagedArrayContainer:
             del self.thisptr.complex_double_ptr
         elif self.data_type == arr_type_t.BOOL:
             del self.thisptr.bool_ptr
+        elif self.data_type == arr_type_t.SIZE_T:
+            del self.thisptr.size_t_ptr
+        elif self.data_type == arr_type_t.UNSIGNED_CHAR:
+            del self.thisptr.uchar_ptr
+        elif self.data_type == arr_type_t.INT:
+            del self.thisptr.int_ptr
 
     cdef void set_as_base(self, arr):
         """Sets the base of arr to be this object and increases the
@@ -100,6 +185,117 @@ cdef class _ManagedArrayContainer:
             return self.thisptr.complex_double_ptr.get()
         elif self.data_type == arr_type_t.BOOL:
             return self.thisptr.bool_ptr.get()
+        elif self.data_type == arr_type_t.SIZE_T:
+            return self.thisptr.size_t_ptr.get()
+        elif self.data_type == arr_type_t.UNSIGNED_CHAR:
+            return self.thisptr.uchar_ptr.get()
+        elif self.data_type == arr_type_t.INT:
+            return self.thisptr.int_ptr.get()
+
+    cdef Py_ssize_t itemsize(self):
+        """Return the size in bytes of the elements of the data array."""
+        if self.data_type == arr_type_t.UNSIGNED_INT:
+            return sizeof(uint)
+        elif self.data_type == arr_type_t.FLOAT:
+            return sizeof(float)
+        elif self.data_type == arr_type_t.DOUBLE:
+            return sizeof(double)
+        elif self.data_type == arr_type_t.COMPLEX_FLOAT:
+            return sizeof(fcomplex)
+        elif self.data_type == arr_type_t.COMPLEX_DOUBLE:
+            return sizeof(dcomplex)
+        elif self.data_type == arr_type_t.BOOL:
+            return sizeof(bool)
+        elif self.data_type == arr_type_t.SIZE_T:
+            return sizeof(size_t)
+        elif self.data_type == arr_type_t.UNSIGNED_CHAR:
+            return sizeof(uchar)
+        elif self.data_type == arr_type_t.INT:
+            return sizeof(int)
+
+    @property
+    def _full_shape(self):
+        return (self.shape if self.element_size == 1
+                else self.shape + (self.element_size, ))
+
+    def __getbuffer__(self, Py_buffer *buffer, int flags):
+        """Export the data array as a read-only C-contiguous buffer."""
+        if flags & PyBUF_WRITABLE:
+            raise BufferError("The arrays computed by freud are read-only.")
+        cdef Py_ssize_t itemsize = self.itemsize()
+        cdef Py_ssize_t size = 1
+        cdef int i
+        # The shape and strides are only set on the first export, since the
+        # buffers exported before point to them.
+        if self._buffer_strides.empty():
+            self._buffer_shape = self._full_shape
+            self._buffer_strides.resize(self._buffer_shape.size())
+            for i in reversed(range(self._buffer_shape.size())):
+                self._buffer_strides[i] = size * itemsize
+                size *= self._buffer_shape[i]
+        else:
+            for i in range(self._buffer_shape.size()):
+                size *= self._buffer_shape[i]
+
+        buffer.buf = self.get()
+        buffer.obj = self
+        buffer.len = size * itemsize
+        buffer.readonly = 1
+        buffer.itemsize = itemsize
+        buffer.format = NULL
+        if flags & PyBUF_FORMAT:
+            buffer.format = _buffer_format(self.data_type)
+        buffer.ndim = self._buffer_shape.size()
+        buffer.shape = self._buffer_shape.data()
+        buffer.strides = self._buffer_strides.data()
+        buffer.suboffsets = NULL
+        buffer.internal = NULL
+
+    def __releasebuffer__(self, Py_buffer *buffer):
+        pass
+
+    def __dlpack_device__(self):
+        return (kDLCPU, 0)
+
+    def __dlpack__(self, stream=None):
+        """Export the data array as a DLPack capsule. Consumers must not
+        write to the tensor, since DLPack cannot mark it read-only."""
+        if stream is not None:
+            raise BufferError("The arrays computed by freud are on the CPU, "
+                              "which has no streams.")
+        full_shape = self._full_shape
+        cdef int32_t ndim = len(full_shape)
+        cdef DLManagedTensor *tensor = <DLManagedTensor *> malloc(
+            sizeof(DLManagedTensor))
+        cdef int64_t *shape = <int64_t *> malloc(
+            2 * max(ndim, 1) * sizeof(int64_t))
+        if tensor == NULL or shape == NULL:
+            free(tensor)
+            free(shape)
+            raise MemoryError()
+
+        cdef int64_t stride = 1
+        cdef int i
+        for i in reversed(range(ndim)):
+            shape[i] = full_shape[i]
+            shape[ndim + i] = stride
+            stride *= shape[i]
+
+        code, bits = _dlpack_types[self.data_type]
+        tensor.dl_tensor.data = self.get()
+        tensor.dl_tensor.device.device_type = kDLCPU
+        tensor.dl_tensor.device.device_id = 0
+        tensor.dl_tensor.ndim = ndim
+        tensor.dl_tensor.dtype.code = code
+        tensor.dl_tensor.dtype.bits = bits
+        tensor.dl_tensor.dtype.lanes = 1
+        tensor.dl_tensor.shape = shape
+        tensor.dl_tensor.strides = shape + ndim
+        tensor.dl_tensor.byte_offset = 0
+        tensor.manager_ctx = <void *> self
+        tensor.deleter = _dlpack_deleter
+        Py_INCREF(self)
+        return PyCapsule_New(tensor, b"dltensor", _dlpack_capsule_destructor)
 
     def __array__(self):
         """Convert the underlying data array into a read-only numpy array.
@@ -123,6 +319,120 @@ cdef class _ManagedArrayContainer:
             else self.shape + (self.element_size, ))
 
 
+
+cdef char *_buffer_format(arr_type_t arr_type):
+    """Return the struct module format of the elements of an array type."""
+    if arr_type == arr_type_t.UNSIGNED_INT:
+        return b"I"
+    elif arr_type == arr_type_t.FLOAT:
+        return b"f"
+    elif arr_type == arr_type_t.DOUBLE:
+        return b"d"
+    elif arr_type == arr_type_t.COMPLEX_FLOAT:
+        return b"Zf"
+    elif arr_type == arr_type_t.COMPLEX_DOUBLE:
+        return b"Zd"
+    elif arr_type == arr_type_t.BOOL:
+        return b"?"
+    elif arr_type == arr_type_t.SIZE_T:
+        return b"N"
+    elif arr_type == arr_type_t.UNSIGNED_CHAR:
+        return b"B"
+    elif arr_type == arr_type_t.INT:
+        return b"i"
+
+
+# The DLPack type codes and bits of the array types.
+_dlpack_types = {
+    arr_type_t.FLOAT: (kDLFloat, 8 * sizeof(float)),
+    arr_type_t.DOUBLE: (kDLFloat, 8 * sizeof(double)),
+    arr_type_t.COMPLEX_FLOAT: (kDLComplex, 8 * sizeof(fcomplex)),
+    arr_type_t.COMPLEX_DOUBLE: (kDLComplex, 8 * sizeof(dcomplex)),
+    arr_type_t.UNSIGNED_INT: (kDLUInt, 8 * sizeof(uint)),
+    arr_type_t.BOOL: (kDLBool, 8 * sizeof(bool)),
+    arr_type_t.SIZE_T: (kDLUInt, 8 * sizeof(size_t)),
+    arr_type_t.UNSIGNED_CHAR: (kDLUInt, 8 * sizeof(uchar)),
+    arr_type_t.INT: (kDLInt, 8 * sizeof(int)),
+}
+
+
+cdef uint64_t get_generation(const void *array, arr_type_t arr_type):
+    """Return the generation of the data of a ManagedArray."""
+    if arr_type == arr_type_t.UNSIGNED_INT:
+        return (<const ManagedArray[uint] *> array).getGeneration()
+    elif arr_type == arr_type_t.FLOAT:
+        return (<const ManagedArray[float] *> array).getGeneration()
+    elif arr_type == arr_type_t.DOUBLE:
+        return (<const ManagedArray[double] *> array).getGeneration()
+    elif arr_type == arr_type_t.COMPLEX_FLOAT:
+        return (<const ManagedArray[fcomplex] *> array).getGeneration()
+    elif arr_type == arr_type_t.COMPLEX_DOUBLE:
+        return (<const ManagedArray[dcomplex] *> array).getGeneration()
+    elif arr_type == arr_type_t.BOOL:
+        return (<const ManagedArray[bool] *> array).getGeneration()
+    elif arr_type == arr_type_t.SIZE_T:
+        return (<const ManagedArray[size_t] *> array).getGeneration()
+    elif arr_type == arr_type_t.UNSIGNED_CHAR:
+        return (<const ManagedArray[uchar] *> array).getGeneration()
+    elif arr_type == arr_type_t.INT:
+        return (<const ManagedArray[int] *> array).getGeneration()
+
+
+cdef make_managed_numpy_array(
+        const void *array, arr_type_t arr_type, uint element_size=1):
+    """Return a read-only array pointing to the data of a ManagedArray.
+
+    The array exported for a generation of the data is returned again for as
+    long as it is referenced, so that repeated accesses of a property neither
+    copy the ManagedArray nor create a new array. Once no array refers to the
+    data, the next compute may overwrite it in place instead of reallocating
+    it, since any change of the data also changes its generation.
+    """
+    key = (get_generation(array, arr_type), arr_type, element_size)
+    arr = _exported_arrays.get(key)
+    if arr is None:
+        arr = np.asarray(
+            _ManagedArrayContainer.init(array, arr_type, element_size))
+        _exported_arrays[key] = arr
+    return arr
+
+
+def export_array(array):
+    r"""Get the object exporting the data of an array computed by freud.
+
+    The returned object supports the buffer protocol and DLPack, so that
+    e.g. :code:`torch.from_dlpack(freud.util.export_array(rdf.rdf))` shares
+    the data of the array without a copy. The data is read-only and remains
+    valid for as long as the returned object or any tensor created from it
+    is referenced.
+
+    Args:
+        array (:class:`numpy.ndarray`): An array returned by a computed
+            property.
+
+    Returns:
+        :class:`_ManagedArrayContainer`: The object exporting the data.
+    """
+    base = array
+    while isinstance(base, np.ndarray):
+        base = base.base
+    cdef _ManagedArrayContainer container
+    if isinstance(base, _ManagedArrayContainer):
+        container = base
+        if (array.shape == container._full_shape
+                and array.flags.c_contiguous
+                and array.ctypes.data == <size_t> container.get()):
+            return container
+    raise ValueError("The array is not the data of an array computed by "
+                     "freud, e.g. because it was sliced or copied.")
+
+
+# The methods of computes that compute their properties, which are wrapped to
+# hold the lock of the compute and record that it has been computed.
+_COMPUTE_METHODS = frozenset(
+    ('compute', 'compute_frames', 'compute_slabs', 'compute_systems'))
+
+
 cdef class _Compute(object):
     r"""Parent class for all compute classes in freud.
 
@@ -131,6 +441,11 @@ cdef class _Compute(object):
     the compute method in a class has been called and decorating class
     properties that rely on compute having been called.
 
+    Calls of compute methods and accesses of computed properties of the same
+    object are serialized by a lock, since the C++ computes release the GIL
+    and their results may be reduced lazily. Different objects are computed
+    concurrently by different Python threads.
+
     To use this class, one would write, for example,
 
     .. code-block:: python
@@ -150,20 +465,22 @@ cdef class _Compute(object):
 
     def __cinit__(self):
         self._called_compute = False
+        self._lock = threading.RLock()
 
     def __getattribute__(self, attr):
         """Compute methods set a flag to indicate that quantities have been
         computed. Compute must be called before plotting."""
         attribute = object.__getattribute__(self, attr)
-        if attr == 'compute':
+        if attr in _COMPUTE_METHODS:
             # Set the attribute *after* computing. This enables
             # self._called_compute to be used in the compute method itself.
             compute = attribute
 
             @wraps(compute)
             def compute_wrapper(*args, **kwargs):
-                return_value = compute(*args, **kwargs)
-                self._called_compute = True
+                with self._lock:
+                    return_value = compute(*args, **kwargs)
+                    self._called_compute = True
                 return return_value
             return compute_wrapper
         elif attr == 'plot':
@@ -189,7 +506,8 @@ cdef class _Compute(object):
             if not self._called_compute:
                 raise AttributeError(
                     "Property not computed. Call compute first.")
-            return prop(self, *args, **kwargs)
+            with self._lock:
+                return prop(self, *args, **kwargs)
         return wrapper
 
     def __str__(self):
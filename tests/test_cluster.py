@@ -150,6 +150,44 @@ class TestCluster:
 
         npt.assert_allclose(clp.centers, [[-1.4, 0, 0]], rtol=1e-5, atol=1e-5)
 
+    def test_cluster_props_unsorted_masses(self):
+        # Points of different clusters are interleaved, so the masses of each
+        # cluster are not contiguous.
+        box = freud.box.Box.cube(10)
+        points = np.array(
+            [[0, 0, 0], [3, 0, 0], [1, 0, 0], [4, 0, 0], [2, 0, 0]], dtype=np.float32
+        )
+        cluster_idx = np.array([0, 1, 0, 1, 0])
+        masses = np.array([1, 1, 2, 1, 1], dtype=np.float32)
+        props = freud.cluster.ClusterProperties()
+        props.compute((box, points), cluster_idx, masses=masses)
+        npt.assert_allclose(
+            props.centers_of_mass, [[1, 0, 0], [3.5, 0, 0]], rtol=1e-5, atol=1e-5
+        )
+        npt.assert_allclose(props.cluster_masses, [4, 2])
+
+    def test_cluster_props_no_tensors(self):
+        box, positions = freud.data.make_random_system(10, 100, seed=0)
+        clust = freud.cluster.Cluster().compute(
+            (box, positions), neighbors={"r_max": 1.0}
+        )
+        props = freud.cluster.ClusterProperties()
+        props.compute((box, positions), clust.cluster_idx)
+        props_no_tensors = freud.cluster.ClusterProperties(compute_tensors=False)
+        assert not props_no_tensors.compute_tensors
+        props_no_tensors.compute((box, positions), clust.cluster_idx)
+
+        npt.assert_allclose(props_no_tensors.centers, props.centers)
+        npt.assert_allclose(props_no_tensors.centers_of_mass, props.centers_of_mass)
+        npt.assert_equal(props_no_tensors.sizes, props.sizes)
+        npt.assert_allclose(props_no_tensors.cluster_masses, props.cluster_masses)
+        with pytest.raises(AttributeError):
+            props_no_tensors.gyrations
+        with pytest.raises(AttributeError):
+            props_no_tensors.inertia_tensors
+        with pytest.raises(AttributeError):
+            props_no_tensors.radii_of_gyration
+
     def test_cluster_keys(self):
         Nlattice = 4
         Nrep = 5
@@ -186,11 +224,25 @@ class TestCluster:
 
         assert np.all(ckeys == check_values)
 
+    def test_half_list(self):
+        """Half neighbor lists find the same clusters as full lists."""
+        box, positions = freud.data.make_random_system(10, 200, seed=0)
+        full = freud.cluster.Cluster().compute(
+            (box, positions), neighbors={"r_max": 1.0}
+        )
+        half = freud.cluster.Cluster().compute(
+            (box, positions),
+            neighbors={"r_max": 1.0, "exclude_ii": True, "half_list": True},
+        )
+        npt.assert_array_equal(half.cluster_idx, full.cluster_idx)
+
     def test_repr(self):
         clust = freud.cluster.Cluster()
         assert str(clust) == str(eval(repr(clust)))
         props = freud.cluster.ClusterProperties()
         assert str(props) == str(eval(repr(props)))
+        props = freud.cluster.ClusterProperties(compute_tensors=False)
+        assert str(props) == str(eval(repr(props)))
 
     def test_repr_png(self):
         box = freud.box.Box.square(L=5)
@@ -206,6 +258,83 @@ class TestCluster:
         plt.close("all")
 
 
+class TestClusterTracker:
+    @staticmethod
+    def chain(gap):
+        """Two chains of points separated by a gap and an isolated point."""
+        points = [[i, 0, 0] for i in range(4)]
+        points += [[3 + gap + i, 0, 0] for i in range(3)]
+        points.append([10, 10, 10])
+        return np.array(points, dtype=np.float32)
+
+    def compute(self, tracker, gap):
+        box = freud.box.Box.cube(40)
+        return tracker.compute((box, self.chain(gap)), neighbors={"r_max": 1.1})
+
+    def test_persistent_ids(self):
+        tracker = freud.cluster.ClusterTracker()
+        with pytest.raises(AttributeError):
+            tracker.cluster_idx
+        assert tracker.frame_counter == 0
+
+        self.compute(tracker, 5)
+        npt.assert_equal(tracker.cluster_idx, [0, 0, 0, 0, 1, 1, 1, 2])
+        npt.assert_equal(tracker.cluster_ids, [0, 1, 2])
+        assert tracker.merges.shape == (0, 2)
+        assert tracker.splits.shape == (0, 2)
+
+        # Moving clusters keep their IDs.
+        self.compute(tracker, 4)
+        npt.assert_equal(tracker.cluster_idx, [0, 0, 0, 0, 1, 1, 1, 2])
+        assert tracker.frame_counter == 2
+
+    def test_merge_and_split(self):
+        tracker = freud.cluster.ClusterTracker()
+        self.compute(tracker, 5)
+
+        self.compute(tracker, 1)
+        assert tracker.num_clusters == 2
+        npt.assert_equal(tracker.cluster_idx, [0, 0, 0, 0, 0, 0, 0, 2])
+        npt.assert_equal(tracker.merges, [[1, 0]])
+        assert tracker.splits.shape == (0, 2)
+
+        # The smaller chain gets a new ID when it splits off again.
+        self.compute(tracker, 5)
+        npt.assert_equal(tracker.cluster_idx, [0, 0, 0, 0, 3, 3, 3, 2])
+        npt.assert_equal(tracker.splits, [[0, 3]])
+        assert tracker.merges.shape == (0, 2)
+
+    def test_matches_cluster(self):
+        box, points = freud.data.make_random_system(10, 500, seed=0)
+        tracker = freud.cluster.ClusterTracker()
+        clust = freud.cluster.Cluster()
+        rng = np.random.default_rng(0)
+        for _ in range(3):
+            points = box.wrap(points + rng.normal(scale=0.1, size=points.shape))
+            tracker.compute((box, points), neighbors={"r_max": 0.8})
+            clust.compute((box, points), neighbors={"r_max": 0.8})
+            # The tracked IDs are a relabeling of the clusters of each frame.
+            npt.assert_equal(
+                tracker.cluster_ids[clust.cluster_idx], tracker.cluster_idx
+            )
+            assert len(np.unique(tracker.cluster_ids)) == clust.num_clusters
+
+    def test_reset(self):
+        tracker = freud.cluster.ClusterTracker()
+        self.compute(tracker, 5)
+        box, points = freud.data.make_random_system(10, 10, seed=0)
+        with pytest.raises(ValueError):
+            tracker.compute((box, points), neighbors={"r_max": 1})
+        tracker.reset()
+        assert tracker.frame_counter == 0
+        tracker.compute((box, points), neighbors={"r_max": 1})
+        assert tracker.cluster_ids[0] == 0
+
+    def test_repr(self):
+        tracker = freud.cluster.ClusterTracker()
+        assert str(tracker) == str(eval(repr(tracker)))
+
+
 class TestClusterManagedArray(ManagedArrayTestBase):
     def build_object(self):
         self.obj = freud.cluster.Cluster()
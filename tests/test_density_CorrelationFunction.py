@@ -86,6 +86,59 @@ class TestCorrelationFunction:
             ocf.compute(nq, comp, neighbors=neighbors)
             npt.assert_allclose(ocf.correlation, expected, atol=absolute_tolerance)
 
+    def test_single_precision(self):
+        r_max = 3.0
+        bins = 15
+        num_points = 2000
+        box, points = freud.data.make_random_system(20, num_points, is2D=True)
+        values = np.exp(6j * np.random.random_sample(num_points) * 2 * np.pi)
+
+        with pytest.raises(ValueError):
+            freud.density.CorrelationFunction(bins, r_max, dtype=np.float64)
+
+        ocf = freud.density.CorrelationFunction(bins, r_max)
+        single_ocf = freud.density.CorrelationFunction(bins, r_max, dtype=np.complex64)
+        assert ocf.dtype == np.complex128
+        assert single_ocf.dtype == np.complex64
+        for reset in (True, False):
+            ocf.compute((box, points), values, reset=reset)
+            single_ocf.compute((box, points), values.astype(np.complex64), reset=reset)
+            assert single_ocf.correlation.dtype == np.complex64
+            npt.assert_array_equal(single_ocf.bin_counts, ocf.bin_counts)
+            npt.assert_allclose(
+                single_ocf.correlation, ocf.correlation, rtol=1e-4, atol=1e-6
+            )
+
+    def test_half_list(self):
+        r_max = 3.0
+        bins = 10
+        num_points = 1000
+        box, points = freud.data.make_random_system(10, num_points, seed=2)
+        ang = np.random.default_rng(3).random(num_points) * 2.0 * np.pi
+        values = np.exp(1j * ang)
+        query_values = np.exp(2j * ang)
+        nq = freud.locality.AABBQuery(box, points)
+
+        full = freud.density.CorrelationFunction(bins, r_max)
+        full.compute(
+            nq,
+            values,
+            query_values=query_values,
+            neighbors=dict(r_max=r_max, exclude_ii=True),
+        )
+        half = freud.density.CorrelationFunction(bins, r_max)
+        half.compute(
+            nq,
+            values,
+            query_values=query_values,
+            neighbors=dict(r_max=r_max, half_list=True),
+        )
+        # Rounding can make the distances of the bonds (i, j) and (j, i)
+        # differ slightly, so a few bonds near bin edges may be binned
+        # differently.
+        npt.assert_allclose(half.bin_counts, full.bin_counts, atol=4)
+        npt.assert_allclose(half.correlation, full.correlation, atol=1e-2)
+
     def test_random_points_real(self):
         r_max = 10.0
         bins = 10
@@ -204,9 +257,59 @@ class TestCorrelationFunction:
         npt.assert_allclose(f1, f2)
         npt.assert_array_equal(c1, c2)
 
+    @pytest.mark.parametrize("use_query_points", [False, True])
+    def test_mesh(self, use_query_points):
+        # Points at the centers of distinct mesh cells have exact distances
+        # on the mesh, so both methods find the same pairs.
+        L = 10
+        mesh = 50
+        r_max = 3.1
+        bins = 7
+        box = freud.box.Box.square(L)
+        rng = np.random.default_rng(42)
+
+        def make_points(n):
+            cells = rng.choice(mesh * mesh, size=n, replace=False)
+            fractions = np.zeros((n, 3))
+            fractions[:, 0] = (cells // mesh + 0.5) / mesh
+            fractions[:, 1] = (cells % mesh + 0.5) / mesh
+            points = box.make_absolute(fractions).astype(np.float32)
+            values = rng.random(n) + 1j * rng.random(n)
+            return points, values
+
+        points, values = make_points(400)
+        query_points, query_values = (
+            make_points(300) if use_query_points else (None, None)
+        )
+
+        ocf = freud.density.CorrelationFunction(bins, r_max)
+        ocf.compute((box, points), values, query_points, query_values)
+        mesh_ocf = freud.density.CorrelationFunction(bins, r_max)
+        with pytest.raises(ValueError):
+            mesh_ocf.compute(
+                (box, points), values, neighbors={"r_max": r_max}, mesh=mesh
+            )
+        mesh_ocf.compute((box, points), values, query_points, query_values, mesh=mesh)
+        npt.assert_array_equal(mesh_ocf.bin_counts, ocf.bin_counts)
+        npt.assert_allclose(mesh_ocf.correlation, ocf.correlation, rtol=1e-5)
+
+        # Accumulating a second frame doubles the counts
+        mesh_ocf.compute(
+            (box, points), values, query_points, query_values, reset=False, mesh=mesh
+        )
+        npt.assert_array_equal(mesh_ocf.bin_counts, 2 * ocf.bin_counts)
+        npt.assert_allclose(mesh_ocf.correlation, ocf.correlation, rtol=1e-5)
+
+        aperiodic_box = freud.box.Box.square(L)
+        aperiodic_box.periodic = False
+        with pytest.raises(ValueError):
+            mesh_ocf.compute((aperiodic_box, points), values, mesh=mesh)
+
     def test_repr(self):
         cf = freud.density.CorrelationFunction(1000, 40)
         assert str(cf) == str(eval(repr(cf)))
+        cf = freud.density.CorrelationFunction(1000, 40, dtype=np.complex64)
+        assert str(cf) == str(eval(repr(cf)))
 
     def test_repr_png(self):
         r_max = 10.0
@@ -75,6 +75,15 @@ class TestLocalDensity:
         neighbors = self.ld.num_neighbors
         npt.assert_array_less(np.fabs(neighbors - 1130.973355292), 200)
 
+    def test_aggregate(self):
+        nq = freud.locality.AABBQuery(self.box, self.pos)
+        neighbors = {"mode": "ball", "r_max": self.r_max, "exclude_ii": True}
+        ref = freud.density.LocalDensity(self.r_max, self.diameter)
+        ref.compute(nq, neighbors=neighbors)
+        self.ld.compute(nq, neighbors=neighbors, aggregate=True)
+        npt.assert_allclose(self.ld.num_neighbors, ref.num_neighbors, rtol=1e-5)
+        npt.assert_allclose(self.ld.density, ref.density, rtol=1e-5)
+
     def test_repr(self):
         assert str(self.ld) == str(eval(repr(self.ld)))
 
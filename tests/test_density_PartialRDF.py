@@ -0,0 +1,122 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+
+class TestPartialRDF:
+    def test_attribute_access(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        types = np.arange(len(points)) % 2
+        prdf = freud.density.PartialRDF(2, 10, 3.0)
+        assert prdf.num_types == 2
+        assert prdf.nbins == 10
+        assert prdf.bin_centers.shape == (10,)
+        assert prdf.bin_edges.shape == (11,)
+        npt.assert_allclose(prdf.bounds, (0, 3.0))
+
+        with pytest.raises(AttributeError):
+            prdf.rdf
+        with pytest.raises(AttributeError):
+            prdf.n_r
+        with pytest.raises(AttributeError):
+            prdf.bin_counts
+
+        prdf.compute((box, points), types)
+        assert prdf.rdf.shape == (2, 2, 10)
+        assert prdf.n_r.shape == (2, 2, 10)
+        assert prdf.bin_counts.shape == (2, 2, 10)
+
+    def test_invalid_partial_rdf(self):
+        with pytest.raises(ValueError):
+            freud.density.PartialRDF(0, 10, 1)
+        with pytest.raises(ValueError):
+            freud.density.PartialRDF(2, 0, 1)
+        with pytest.raises(ValueError):
+            freud.density.PartialRDF(2, 10, -1)
+        with pytest.raises(ValueError):
+            freud.density.PartialRDF(2, 10, 1, r_min=2)
+
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        prdf = freud.density.PartialRDF(2, 10, 3.0)
+        with pytest.raises(ValueError):
+            prdf.compute((box, points), np.full(len(points), 2))
+
+    @pytest.mark.parametrize("normalize", [False, True])
+    def test_single_type(self, normalize):
+        r_max = 3.0
+        bins = 20
+        box, points = freud.data.make_random_system(10, 1000, seed=1)
+        neighbors = dict(r_max=r_max, exclude_ii=True)
+
+        rdf = freud.density.RDF(bins, r_max, normalize=normalize)
+        rdf.compute((box, points), neighbors=neighbors)
+        prdf = freud.density.PartialRDF(1, bins, r_max, normalize=normalize)
+        prdf.compute((box, points), np.zeros(len(points)), neighbors=neighbors)
+
+        npt.assert_array_equal(prdf.bin_counts[0, 0], rdf.bin_counts)
+        npt.assert_allclose(prdf.rdf[0, 0], rdf.rdf, rtol=1e-6)
+        npt.assert_allclose(prdf.n_r[0, 0], rdf.n_r, rtol=1e-6)
+
+    @pytest.mark.parametrize("half_list", [False, True])
+    def test_type_pairs(self, half_list):
+        r_max = 3.0
+        bins = 20
+        num_types = 3
+        box, points = freud.data.make_random_system(10, 2000, seed=2)
+        types = np.random.default_rng(2).integers(num_types, size=len(points))
+        neighbors = dict(r_max=r_max, exclude_ii=True)
+        if half_list:
+            neighbors["half_list"] = True
+
+        prdf = freud.density.PartialRDF(num_types, bins, r_max)
+        prdf.compute((box, points), types, neighbors=neighbors)
+
+        # The bond counts of each pair of types match a histogram of the bonds
+        # between points of those types, and they sum to the total RDF.
+        nq = freud.locality.AABBQuery(box, points)
+        nlist = nq.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+        for a in range(num_types):
+            for b in range(num_types):
+                pair_bonds = (types[nlist.query_point_indices] == a) & (
+                    types[nlist.point_indices] == b
+                )
+                counts, _ = np.histogram(
+                    nlist.distances[pair_bonds], bins=prdf.bin_edges
+                )
+                npt.assert_allclose(prdf.bin_counts[a, b], counts, atol=4)
+        npt.assert_array_equal(prdf.bin_counts, prdf.bin_counts.transpose(1, 0, 2))
+        npt.assert_allclose(prdf.rdf[:, :, bins // 2 :], 1, atol=0.15)
+
+        rdf = freud.density.RDF(bins, r_max)
+        rdf.compute((box, points), neighbors=neighbors)
+        npt.assert_array_equal(prdf.bin_counts.sum(axis=(0, 1)), rdf.bin_counts)
+
+    def test_query_types(self):
+        r_max = 2.0
+        bins = 10
+        box, points = freud.data.make_random_system(10, 500, seed=3)
+        query_points = np.random.default_rng(3).uniform(-5, 5, (50, 3))
+        types = np.zeros(len(points))
+        query_types = np.ones(len(query_points))
+
+        prdf = freud.density.PartialRDF(2, bins, r_max)
+        prdf.compute((box, points), types, query_points, query_types)
+        rdf = freud.density.RDF(bins, r_max)
+        rdf.compute((box, points), query_points)
+
+        npt.assert_array_equal(prdf.bin_counts[1, 0], rdf.bin_counts)
+        npt.assert_allclose(prdf.rdf[1, 0], rdf.rdf, rtol=1e-6)
+        assert np.all(prdf.bin_counts[0] == 0)
+        assert np.all(prdf.bin_counts[1, 1] == 0)
+        # No query points of type 0 and no points of type 1 give zeros.
+        assert np.all(prdf.rdf[0] == 0)
+        assert np.all(prdf.rdf[1, 1] == 0)
+
+    def test_repr(self):
+        prdf = freud.density.PartialRDF(3, 100, 10, r_min=0.5)
+        assert str(prdf) == str(eval(repr(prdf)))
@@ -111,6 +111,71 @@ class TestRDF:
         avg_counts = rdf.rdf * ndens * bin_volumes
         npt.assert_allclose(rdf.n_r, np.cumsum(avg_counts), rtol=tolerance)
 
+    @pytest.mark.parametrize("nq_type", ["aabb", "linkcell"])
+    def test_half_list(self, nq_type):
+        r_max = 3.0
+        bins = 20
+        box, points = freud.data.make_random_system(10, 2000, seed=1)
+        if nq_type == "aabb":
+            nq = freud.locality.AABBQuery(box, points)
+        else:
+            nq = freud.locality.LinkCell(box, points, r_max)
+
+        full = freud.density.RDF(bins, r_max)
+        full.compute(nq, neighbors=dict(r_max=r_max, exclude_ii=True))
+
+        # Half lists are counted twice, whether passed as query arguments
+        # or as a neighbor list. Rounding can make the distances of the bonds
+        # (i, j) and (j, i) differ slightly, so a few bonds near bin edges may
+        # be binned differently.
+        half_qargs = dict(r_max=r_max, half_list=True)
+        half = freud.density.RDF(bins, r_max)
+        half.compute(nq, neighbors=half_qargs)
+        npt.assert_allclose(half.bin_counts, full.bin_counts, atol=4)
+        npt.assert_allclose(half.rdf, full.rdf, rtol=1e-3)
+        npt.assert_allclose(half.n_r, full.n_r, rtol=1e-3)
+
+        nlist = nq.query(points, half_qargs).toNeighborList()
+        half_nlist = freud.density.RDF(bins, r_max)
+        half_nlist.compute(nq, neighbors=nlist)
+        npt.assert_array_equal(half_nlist.bin_counts, half.bin_counts)
+
+        # Half lists only describe self-queries, so distinct query points are
+        # rejected even when there are as many of them as points.
+        query_points = box.wrap(points + 0.5)
+        with pytest.raises(ValueError):
+            freud.density.RDF(bins, r_max).compute(
+                nq, query_points, neighbors=half_qargs
+            )
+        with pytest.raises(ValueError):
+            freud.density.RDF(bins, r_max).compute(nq, query_points, neighbors=nlist)
+
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_aggregate(self, is2D):
+        box, points = freud.data.make_random_system(
+            20, 4000 if is2D else 8000, is2D=is2D, seed=2
+        )
+        nq = freud.locality.AABBQuery(box, points)
+        query_args = dict(r_max=9, r_min=0.5, exclude_ii=True)
+        for bins in [3, 9, 90]:
+            ref = freud.density.RDF(bins, 9, r_min=0.5)
+            ref.compute(nq, neighbors=query_args)
+            rdf = freud.density.RDF(bins, 9, r_min=0.5)
+            rdf.compute(nq, neighbors=query_args, aggregate=True)
+            npt.assert_array_equal(rdf.bin_counts, ref.bin_counts)
+            npt.assert_allclose(rdf.rdf, ref.rdf, rtol=1e-6)
+
+        # Half lists and neighbor lists are counted bond by bond.
+        half_args = dict(r_max=9, half_list=True)
+        half = freud.density.RDF(9, 9, r_min=0.5)
+        half.compute(nq, neighbors=half_args, aggregate=True)
+        ref_half = freud.density.RDF(9, 9, r_min=0.5).compute(nq, neighbors=half_args)
+        npt.assert_array_equal(half.bin_counts, ref_half.bin_counts)
+        nlist = nq.query(points, query_args).toNeighborList()
+        rdf = freud.density.RDF(90, 9, r_min=0.5)
+        rdf.compute(nq, neighbors=nlist, aggregate=True)
+        npt.assert_array_equal(rdf.bin_counts, ref.bin_counts)
+
     def test_compute_reset(self):
         # This test is to check whether rdf.compute accumulates the data correctly
         # when reset is set to False
@@ -149,6 +214,92 @@ class TestRDF:
             avg_counts = rdf.rdf * ndens * bin_volumes
             npt.assert_allclose(rdf.n_r, np.cumsum(avg_counts), rtol=tolerance)
 
+    def test_compute_frames(self):
+        r_max = 3.0
+        bins = 20
+        frames = [
+            freud.data.make_random_system(10, 500, seed=seed) for seed in range(4)
+        ]
+
+        rdf = freud.density.RDF(bins, r_max)
+        for frame in frames:
+            rdf.compute(frame, reset=False)
+        rdf_frames = freud.density.RDF(bins, r_max)
+        rdf_frames.compute_frames(iter(frames))
+        npt.assert_array_equal(rdf_frames.bin_counts, rdf.bin_counts)
+        npt.assert_allclose(rdf_frames.rdf, rdf.rdf, rtol=1e-6)
+        npt.assert_allclose(rdf_frames.n_r, rdf.n_r, rtol=1e-6)
+
+        def failing_frames():
+            yield frames[0]
+            raise RuntimeError("Unable to read frame.")
+
+        with pytest.raises(RuntimeError):
+            rdf_frames.compute_frames(failing_frames())
+        with pytest.raises(ValueError):
+            nlist = freud.AABBQuery(*frames[0]).query(
+                frames[0][1], dict(r_max=r_max)
+            ).toNeighborList()
+            rdf_frames.compute_frames(frames, neighbors=nlist)
+
+    def test_compute_slabs(self, tmp_path):
+        r_max = 3.0
+        bins = 20
+        box, points = freud.data.make_random_system(20, 2000, seed=0)
+        rdf = freud.density.RDF(bins, r_max).compute((box, points))
+
+        # The points are read from a file rather than kept in memory.
+        points_file = np.memmap(
+            tmp_path / "points.bin", dtype=np.float32, mode="w+", shape=points.shape
+        )
+        points_file[:] = points
+        slabs = freud.locality.SlabDecomposition(box, points_file, r_max, 5, 300)
+        rdf_slabs = freud.density.RDF(bins, r_max).compute_slabs(slabs)
+        npt.assert_array_equal(rdf_slabs.bin_counts, rdf.bin_counts)
+        npt.assert_allclose(rdf_slabs.rdf, rdf.rdf, rtol=1e-5)
+        npt.assert_allclose(rdf_slabs.n_r, rdf.n_r, rtol=1e-5)
+
+        with pytest.raises(ValueError):
+            rdf_slabs.compute_slabs(slabs, neighbors=dict(r_max=2 * r_max))
+        with pytest.raises(ValueError):
+            rdf_slabs.compute_slabs(slabs, neighbors=dict(num_neighbors=4))
+
+    def test_compute_systems(self):
+        r_max = 2.0
+        bins = 10
+        systems = [
+            freud.data.make_random_system(6 + i, n, seed=i)
+            for i, n in enumerate([60, 0, 90, 40])
+        ]
+        offsets = np.cumsum([0] + [len(points) for _, points in systems])
+        batch = freud.locality.SystemBatch(
+            [box for box, _ in systems],
+            np.concatenate([points for _, points in systems]),
+            offsets,
+        )
+        rdf_systems = freud.density.RDF(bins, r_max).compute_systems(batch)
+        assert rdf_systems.system_rdf.shape == (4, bins)
+        npt.assert_array_equal(rdf_systems.system_bin_counts[1], 0)
+
+        # Every system is accumulated as a frame.
+        rdf = freud.density.RDF(bins, r_max)
+        for i, system in enumerate(systems):
+            if len(system[1]) == 0:
+                continue
+            rdf.compute(system, reset=False)
+            system_rdf = freud.density.RDF(bins, r_max).compute(system)
+            npt.assert_array_equal(
+                rdf_systems.system_bin_counts[i], system_rdf.bin_counts
+            )
+            npt.assert_allclose(rdf_systems.system_rdf[i], system_rdf.rdf, rtol=1e-5)
+            npt.assert_allclose(rdf_systems.system_n_r[i], system_rdf.n_r, rtol=1e-5)
+        npt.assert_array_equal(rdf_systems.bin_counts, rdf.bin_counts)
+        npt.assert_allclose(rdf_systems.rdf, rdf.rdf, rtol=1e-5)
+        npt.assert_allclose(rdf_systems.n_r, rdf.n_r, rtol=1e-5)
+
+        with pytest.raises(ValueError):
+            rdf_systems.compute_systems(batch, neighbors=batch.query(dict(r_max=1)))
+
     def test_repr(self):
         rdf = freud.density.RDF(r_max=10, bins=100, r_min=0.5)
         assert str(rdf) == str(eval(repr(rdf)))
@@ -4,6 +4,7 @@
 import matplotlib
 import matplotlib.pyplot as plt
 import numpy as np
+import numpy.testing as npt
 import pytest
 from SphereVoxelization_fft import compute_2d, compute_3d
 
@@ -104,6 +105,29 @@ class TestSphereVoxelization:
             assert num_ones > 0
             assert num_zeros + num_ones == np.prod(vox.voxels.shape)
 
+    @pytest.mark.parametrize("is2D", [True, False])
+    def test_packed(self, is2D):
+        width = (30, 21, 1) if is2D else (30, 21, 11)
+        r_max = 3.0
+        box, points = freud.data.make_random_system(20.0, 50, is2D=is2D)
+        vox = freud.density.SphereVoxelization(width, r_max)
+        vox.compute(system=(box, points))
+        packed_vox = freud.density.SphereVoxelization(width, r_max, packed=True)
+        assert packed_vox.packed
+        with pytest.raises(AttributeError):
+            packed_vox.packed_voxels
+        packed_vox.compute(system=(box, points))
+        with pytest.raises(AttributeError):
+            vox.packed_voxels
+
+        # Each slab along x is packed into whole bytes
+        slab_size = width[1] * width[2]
+        assert packed_vox.packed_voxels.dtype == np.uint8
+        assert packed_vox.packed_voxels.shape == (width[0], (slab_size + 7) // 8)
+        dense = vox.voxels.reshape(width[0], slab_size).astype(np.uint8)
+        npt.assert_array_equal(packed_vox.packed_voxels, np.packbits(dense, axis=-1))
+        npt.assert_array_equal(packed_vox.voxels, vox.voxels)
+
     def test_change_box_dimension(self):
         width = 100
         r_max = 10.0
@@ -140,6 +164,9 @@ class TestSphereVoxelization:
         vox3 = freud.density.SphereVoxelization((98, 99, 100), 10.0)
         assert str(vox3) == str(eval(repr(vox3)))
 
+        vox_packed = freud.density.SphereVoxelization(100, 10.0, packed=True)
+        assert str(vox_packed) == str(eval(repr(vox_packed)))
+
     def test_repr_png(self):
         width = 100
         r_max = 10.0
@@ -210,6 +210,17 @@ class StaticStructureFactorTest:
         sf.compute(system)
         assert np.isclose(sf.S_k[0], N)
 
+    def test_compute_frames(self, sf_params_kmin_zero):
+        L = 10
+        N = 100
+        sf = self.build_structure_factor_object(*sf_params_kmin_zero)
+        frames = [freud.data.make_random_system(L, N, seed=i) for i in range(3)]
+        for frame in frames:
+            sf.compute(frame, reset=False)
+        S_k = sf.S_k
+        sf.compute_frames(frames)
+        npt.assert_allclose(sf.S_k, S_k, rtol=1e-5, atol=1e-5)
+
     def test_accumulation(self, sf_params_kmin_zero):
         L = 10
         N = 100
@@ -387,6 +398,20 @@ class TestStaticStructureFactorDebye(StaticStructureFactorTest):
         # compare
         npt.assert_allclose(sf.S_k, sf2, rtol=1e-5, atol=1e-5)
 
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_distance_histogram(self, is2D):
+        """Validate the distance histogram against the exact Debye sum."""
+        box, points = freud.data.make_random_system(10, 500, is2D=is2D, seed=0)
+        sf = freud.diffraction.StaticStructureFactorDebye(100, 10)
+        sf.compute((box, points))
+        sf_hist = freud.diffraction.StaticStructureFactorDebye(
+            100, 10, num_distance_bins=10000
+        )
+        sf_hist.compute((box, points))
+        assert sf_hist.num_distance_bins == 10000
+        npt.assert_allclose(sf_hist.S_k[0], len(points), rtol=1e-6)
+        npt.assert_allclose(sf_hist.S_k, sf.S_k, rtol=1e-3, atol=1e-3)
+
 
 class TestStaticStructureFactorDirect(StaticStructureFactorTest):
     @pytest.fixture
@@ -464,6 +489,32 @@ class TestStaticStructureFactorDirect(StaticStructureFactorTest):
             bins, k_max, k_min, num_sampled_k_points
         )
 
+    def test_seed(self):
+        """Ensure that the sampled k points are determined by the seed."""
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        sf1 = freud.diffraction.StaticStructureFactorDirect(
+            100, 10, num_sampled_k_points=2000, seed=1
+        )
+        sf2 = freud.diffraction.StaticStructureFactorDirect(
+            100, 10, num_sampled_k_points=2000, seed=1
+        )
+        sf1.compute((box, points))
+        sf2.compute((box, points))
+        assert sf1.seed == 1
+        npt.assert_array_equal(sf1.k_points, sf2.k_points)
+        npt.assert_array_equal(sf1.S_k, sf2.S_k)
+
+        # The k points are reused when computing again with the same box.
+        k_points = sf1.k_points
+        sf1.compute((box, points))
+        npt.assert_array_equal(sf1.k_points, k_points)
+
+        sf3 = freud.diffraction.StaticStructureFactorDirect(
+            100, 10, num_sampled_k_points=2000, seed=2
+        )
+        sf3.compute((box, points))
+        assert not np.array_equal(sf1.k_points, sf3.k_points)
+
     def test_against_dynasor(self, sf_params_kmin_zero):
         """Validate the direct method agains dynasor package."""
         dsf_reciprocal = pytest.importorskip("dsf.reciprocal")
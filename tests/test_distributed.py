@@ -0,0 +1,83 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+# The distributed computes are only built with MPI. These tests run on any
+# number of ranks, e.g. with mpirun -np 4 python -m pytest test_distributed.py.
+distributed = pytest.importorskip("freud.distributed")
+MPI = pytest.importorskip("mpi4py.MPI")
+
+
+class TestDistributed:
+    def setup_method(self):
+        # Every rank holds a disjoint part of the same points.
+        self.comm = MPI.COMM_WORLD
+        self.box, self.points = freud.data.make_random_system(20, 8000, seed=0)
+        rank, size = self.comm.Get_rank(), self.comm.Get_size()
+        self.local_points = self.points[rank::size]
+        self.decomposition = distributed.DomainDecomposition(
+            self.comm, self.box, self.local_points, 3
+        )
+
+    def test_decomposition(self):
+        dd = self.decomposition
+        assert dd.n_total == len(self.points)
+        assert self.comm.allreduce(dd.n_owned) == len(self.points)
+        npt.assert_array_equal(dd.points, self.points[dd.tags])
+
+        # Every point is owned by exactly one rank.
+        owned = np.concatenate(self.comm.allgather(dd.tags[: dd.n_owned]))
+        npt.assert_array_equal(np.sort(owned), np.arange(len(self.points)))
+
+    def test_rdf(self):
+        expected = freud.density.RDF(50, 3).compute((self.box, self.points))
+        rdf = distributed.RDF(50, 3).compute(self.decomposition)
+        npt.assert_array_equal(rdf.bin_counts, expected.bin_counts)
+        npt.assert_allclose(rdf.rdf, expected.rdf, rtol=1e-5)
+        npt.assert_allclose(rdf.n_r, expected.n_r, rtol=1e-5)
+
+    @pytest.mark.parametrize("average", [False, True])
+    def test_steinhardt(self, average):
+        neighbors = dict(r_max=1.5, exclude_ii=True)
+        expected = freud.order.Steinhardt(6, average=average).compute(
+            (self.box, self.points), neighbors=neighbors
+        )
+        ql = distributed.Steinhardt(6, average=average).compute(
+            self.decomposition, neighbors
+        )
+        owned = self.decomposition.tags[: self.decomposition.n_owned]
+        npt.assert_allclose(
+            ql.particle_order, expected.particle_order[owned], atol=1e-6
+        )
+
+    def test_cluster(self):
+        neighbors = dict(r_max=1)
+        expected = freud.cluster.Cluster().compute(
+            (self.box, self.points), neighbors=neighbors
+        )
+        cl = distributed.Cluster().compute(self.decomposition, neighbors)
+        assert cl.num_clusters == expected.num_clusters
+
+        # The clusters are the same up to their numbering.
+        owned = self.decomposition.tags[: self.decomposition.n_owned]
+        labels = np.concatenate(self.comm.allgather(cl.cluster_idx))
+        expected_labels = expected.cluster_idx[
+            np.concatenate(self.comm.allgather(owned))
+        ]
+        pairs = np.unique(np.stack([labels, expected_labels]), axis=1)
+        assert pairs.shape[1] == expected.num_clusters
+
+    def test_errors(self):
+        with pytest.raises(ValueError):
+            distributed.DomainDecomposition(self.comm, self.box, self.local_points, -1)
+        with pytest.raises(ValueError):
+            distributed.RDF(50, 4).compute(self.decomposition)
+        with pytest.raises(ValueError):
+            distributed.Steinhardt(6, average=True).compute(
+                self.decomposition, dict(r_max=2)
+            )
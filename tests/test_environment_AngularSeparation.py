@@ -52,6 +52,18 @@ class TestAngularSeparationGlobal:
             for j in [0, 1]:
                 npt.assert_allclose(ang.angles[i][j], np.pi / 16, atol=1e-6)
 
+    def test_small_angles(self):
+        # Small angles are resolved from single precision orientations.
+        angles = np.array([1e-4, 1e-3, 1e-2, 1e-1])
+        ors = np.zeros((len(angles), 4), dtype=np.float32)
+        ors[:, 0] = np.cos(angles / 2)
+        ors[:, 3] = np.sin(angles / 2)
+        ang = freud.environment.AngularSeparationGlobal()
+        ang.compute(
+            np.array([[1, 0, 0, 0]]), ors, np.array([[1, 0, 0, 0], [-1, 0, 0, 0]])
+        )
+        npt.assert_allclose(ang.angles[:, 0], angles, rtol=1e-5)
+
     def test_nlist_lifetime(self):
         def _get_nlist(sys):
             asn = freud.environment.AngularSeparationNeighbor()
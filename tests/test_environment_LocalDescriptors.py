@@ -209,9 +209,80 @@ class TestLocalDescriptors:
         sphs = comp.sph
         assert sphs.shape[0] == N // 3 * num_neighbors
 
+    @pytest.mark.parametrize("mode", ["neighborhood", "global", "particle_local"])
+    def test_compute_systems(self, mode):
+        """Test that a batch of systems equals computing each system."""
+        systems = [
+            freud.data.make_random_system(6 + i, n, seed=i)
+            for i, n in enumerate([30, 0, 45, 20])
+        ]
+        offsets = np.cumsum([0] + [len(points) for _, points in systems])
+        points = np.concatenate([points for _, points in systems])
+        orientations = np.random.default_rng(0).normal(size=(len(points), 4))
+        orientations /= np.linalg.norm(orientations, axis=1)[:, np.newaxis]
+        batch = freud.locality.SystemBatch(
+            [box for box, _ in systems], points, offsets
+        )
+        neighbors = dict(num_neighbors=4)
+        ld = freud.environment.LocalDescriptors(4, mode=mode)
+        ld.compute_systems(batch, neighbors, orientations=orientations)
+        nlist = ld.nlist
+        query_point_indices = np.array(nlist.query_point_indices)
+        point_indices = np.array(nlist.point_indices)
+        sph = np.array(ld.sph)
+        assert ld.num_sphs == len(sph) == len(query_point_indices)
+
+        first_bond = 0
+        for i, (box, system_points) in enumerate(systems):
+            if len(system_points) == 0:
+                continue
+            ld.compute(
+                (box, system_points),
+                orientations=orientations[offsets[i] : offsets[i + 1]],
+                neighbors=neighbors,
+            )
+            bonds = slice(first_bond, first_bond + ld.num_sphs)
+            npt.assert_array_equal(
+                query_point_indices[bonds], ld.nlist.query_point_indices + offsets[i]
+            )
+            npt.assert_array_equal(
+                point_indices[bonds], ld.nlist.point_indices + offsets[i]
+            )
+            npt.assert_allclose(sph[bonds], ld.sph, atol=1e-5)
+            first_bond += ld.num_sphs
+        assert first_bond == len(sph)
+
     def test_repr(self):
         comp = freud.environment.LocalDescriptors(8, True)
         assert str(comp) == str(eval(repr(comp)))
+        comp = freud.environment.LocalDescriptors(8, False, packed=True)
+        assert str(comp) == str(eval(repr(comp)))
+
+    @pytest.mark.parametrize("mode", ["neighborhood", "global"])
+    def test_packed(self, mode):
+        l_max = 6
+        box, points = freud.data.make_random_system(10, 200, seed=0)
+        neighbors = dict(num_neighbors=80, exclude_ii=True)
+
+        ld = freud.environment.LocalDescriptors(l_max, False, mode=mode)
+        ld.compute((box, points), neighbors=neighbors)
+        packed = freud.environment.LocalDescriptors(
+            l_max, False, mode=mode, packed=True
+        )
+        packed.compute((box, points), neighbors=neighbors)
+        assert packed.packed
+        assert packed.sph.dtype == np.float32
+        assert packed.sph.shape == (ld.num_sphs, (l_max + 1) ** 2)
+
+        for l in range(l_max + 1):
+            ylm = ld.sph[:, l * (l + 1) // 2 : (l + 1) * (l + 2) // 2]
+            packed_ylm = packed.sph[:, l**2 : (l + 1) ** 2]
+            npt.assert_allclose(packed_ylm[:, 0], ylm[:, 0].real, atol=1e-6)
+            npt.assert_allclose(packed_ylm[:, 1::2], ylm[:, 1:].real, atol=1e-6)
+            npt.assert_allclose(packed_ylm[:, 2::2], ylm[:, 1:].imag, atol=1e-6)
+
+        with pytest.raises(ValueError):
+            freud.environment.LocalDescriptors(l_max, True, packed=True)
 
     unit_cell = [
         "unit_cell",
@@ -0,0 +1,43 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import subprocess
+import sys
+
+import pytest
+
+import freud
+
+
+def run_python(code):
+    """Run code in a new interpreter, in which freud has not been imported."""
+    subprocess.run([sys.executable, "-c", code], check=True)
+
+
+class TestImport:
+    def test_lazy_submodules(self):
+        """Importing freud does not import the submodules it does not need."""
+        run_python(
+            "import sys, freud\n"
+            "for name in freud._lazy_submodules:\n"
+            "    assert 'freud.' + name not in sys.modules, name\n"
+            "assert 'freud.locality' in sys.modules\n"
+        )
+
+    @pytest.mark.parametrize("name", sorted(freud._lazy_submodules))
+    def test_access_submodule(self, name):
+        """Submodules are imported on first access."""
+        run_python(
+            "import sys, freud\n"
+            f"module = freud.{name}\n"
+            f"assert sys.modules['freud.{name}'] is module\n"
+            f"assert freud.{name} is module\n"
+        )
+
+    def test_dir_and_all(self):
+        assert set(freud.__all__) <= set(dir(freud))
+        run_python("from freud import *\nassert order.Steinhardt\n")
+
+    def test_missing_attribute(self):
+        with pytest.raises(AttributeError):
+            freud.not_a_submodule
@@ -0,0 +1,159 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+import rowan
+
+import freud
+
+
+class TestBondPipeline:
+    def test_matches_individual_computes(self):
+        box, points = freud.data.make_random_system(10, 200, seed=0)
+        orientations = rowan.random.rand(len(points))
+        query_args = dict(r_max=2.5, exclude_ii=True)
+
+        rdf = freud.density.RDF(bins=20, r_max=2.5)
+        ld = freud.density.LocalDensity(r_max=2, diameter=1)
+        ql = freud.order.Steinhardt(l=[4, 6])
+        ql_avg = freud.order.Steinhardt(l=6, average=True, wl=True)
+        bod = freud.environment.BondOrder(bins=(8, 6), mode="lbod")
+        pipeline = freud.locality.BondPipeline([rdf, ld, ql, ql_avg])
+        pipeline.add(bod, orientations=orientations)
+        assert pipeline.computes == [rdf, ld, ql, ql_avg, bod]
+        pipeline.compute((box, points), neighbors=query_args)
+
+        npt.assert_allclose(
+            rdf.rdf,
+            freud.density.RDF(bins=20, r_max=2.5)
+            .compute((box, points), neighbors=query_args)
+            .rdf,
+            rtol=1e-6,
+        )
+        ref_ld = freud.density.LocalDensity(r_max=2, diameter=1).compute(
+            (box, points), neighbors=query_args
+        )
+        npt.assert_allclose(ld.density, ref_ld.density, rtol=1e-6)
+        npt.assert_allclose(ld.num_neighbors, ref_ld.num_neighbors, rtol=1e-6)
+        npt.assert_allclose(
+            ql.particle_order,
+            freud.order.Steinhardt(l=[4, 6])
+            .compute((box, points), neighbors=query_args)
+            .particle_order,
+            atol=1e-6,
+        )
+        ref_avg = freud.order.Steinhardt(l=6, average=True, wl=True).compute(
+            (box, points), neighbors=query_args
+        )
+        npt.assert_allclose(ql_avg.particle_order, ref_avg.particle_order, atol=1e-5)
+        npt.assert_allclose(ql_avg.order, ref_avg.order, atol=1e-5)
+        npt.assert_allclose(
+            bod.bond_order,
+            freud.environment.BondOrder(bins=(8, 6), mode="lbod")
+            .compute((box, points), orientations, neighbors=query_args)
+            .bond_order,
+            rtol=1e-5,
+        )
+
+    def test_hexatic(self):
+        box, points = freud.data.make_random_system(10, 100, is2D=True, seed=1)
+        hexatic = freud.order.Hexatic(k=6)
+        pipeline = freud.locality.BondPipeline([hexatic])
+        pipeline.compute((box, points))
+        ref = freud.order.Hexatic(k=6).compute((box, points))
+        npt.assert_allclose(hexatic.particle_order, ref.particle_order, atol=1e-6)
+
+    def test_reset(self):
+        box, points = freud.data.make_random_system(10, 100, seed=2)
+        rdf = freud.density.RDF(bins=10, r_max=2)
+        pipeline = freud.locality.BondPipeline([rdf])
+        pipeline.compute((box, points))
+        counts = rdf.bin_counts.copy()
+        pipeline.compute((box, points), reset=False)
+        npt.assert_array_equal(rdf.bin_counts, 2 * counts)
+        pipeline.compute((box, points))
+        npt.assert_array_equal(rdf.bin_counts, counts)
+
+    def test_query_points(self):
+        box, points = freud.data.make_random_system(10, 100, seed=3)
+        query_points = points[:10]
+        query_args = dict(r_max=2)
+        ql = freud.order.Steinhardt(l=6)
+        pipeline = freud.locality.BondPipeline([ql])
+        with pytest.raises(ValueError):
+            pipeline.compute((box, points), query_points, query_args)
+
+        rdf = freud.density.RDF(bins=10, r_max=2)
+        freud.locality.BondPipeline([rdf]).compute(
+            (box, points), query_points, query_args
+        )
+        ref = freud.density.RDF(bins=10, r_max=2).compute(
+            (box, points), query_points, query_args
+        )
+        npt.assert_array_equal(rdf.bin_counts, ref.bin_counts)
+
+    def test_compute_frames(self):
+        box, points = freud.data.make_random_system(10, 100, seed=6)
+        rng = np.random.default_rng(6)
+        frames = np.array(
+            [
+                box.wrap(points + rng.normal(scale=0.2, size=points.shape))
+                for _ in range(4)
+            ],
+            dtype=np.float32,
+        )
+        query_args = dict(r_max=2, exclude_ii=True)
+        rdf = freud.density.RDF(bins=10, r_max=2)
+        ql = freud.order.Steinhardt(l=6)
+        freud.locality.BondPipeline([rdf, ql]).compute_frames(
+            box, frames, neighbors=query_args
+        )
+
+        ref = freud.density.RDF(bins=10, r_max=2)
+        for frame in frames:
+            ref.compute((box, frame), neighbors=query_args, reset=False)
+        npt.assert_array_equal(rdf.bin_counts, ref.bin_counts)
+        npt.assert_allclose(
+            ql.particle_order,
+            freud.order.Steinhardt(l=6)
+            .compute((box, frames[-1]), neighbors=query_args)
+            .particle_order,
+            atol=1e-6,
+        )
+
+        nlist = (
+            freud.locality.AABBQuery(box, frames[0])
+            .query(frames[0], query_args)
+            .toNeighborList()
+        )
+        with pytest.raises(ValueError):
+            freud.locality.BondPipeline([rdf]).compute_frames(
+                box, frames, neighbors=nlist
+            )
+
+    def test_invalid_computes(self):
+        rdf = freud.density.RDF(bins=10, r_max=2)
+        pipeline = freud.locality.BondPipeline([rdf])
+        with pytest.raises(ValueError):
+            pipeline.add(rdf)
+        pipeline.add(freud.locality.FilterSANN())
+        box, points = freud.data.make_random_system(10, 100, seed=4)
+        rdf.compute((box, points), neighbors=dict(r_max=2))
+        bin_counts = np.copy(rdf.bin_counts)
+        with pytest.raises(TypeError):
+            pipeline.compute((box, points), neighbors=dict(r_max=2))
+        # The failed compute does not reset the other computes.
+        npt.assert_array_equal(rdf.bin_counts, bin_counts)
+
+    def test_default_query_args(self):
+        pipeline = freud.locality.BondPipeline(
+            [freud.density.RDF(bins=10, r_max=2), freud.order.Steinhardt(l=6)]
+        )
+        with pytest.raises(NotImplementedError):
+            pipeline.compute(freud.data.make_random_system(10, 100, seed=5))
+
+    def test_repr(self):
+        pipeline = freud.locality.BondPipeline([freud.order.Steinhardt(l=6)])
+        assert str(pipeline) == str(eval(str(pipeline)))
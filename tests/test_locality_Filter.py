@@ -119,6 +119,31 @@ class FilterTest:
         npt.assert_allclose(nlist_1.point_indices, nlist_2.point_indices)
         npt.assert_allclose(nlist_1.query_point_indices, nlist_2.query_point_indices)
 
+    @pytest.mark.parametrize("terminate_after_blocked", [False, True])
+    def test_query_args_match_nlist(self, terminate_after_blocked):
+        """Filtering from query arguments matches filtering a NeighborList."""
+        N = 100
+        L = 10
+        query_args = dict(r_max=4.5, exclude_ii=True)
+
+        sys = freud.data.make_random_system(L, N)
+        aq = freud.locality.AABBQuery(*sys)
+        nlist = aq.query(sys[1], query_args).toNeighborList()
+
+        filt_1 = self.get_filter_object(terminate_after_blocked=terminate_after_blocked)
+        filt_1.compute(sys, nlist)
+        filt_2 = self.get_filter_object(terminate_after_blocked=terminate_after_blocked)
+        filt_2.compute(sys, query_args)
+
+        for prop in ["filtered_nlist", "unfiltered_nlist"]:
+            nlist_1 = getattr(filt_1, prop)
+            nlist_2 = getattr(filt_2, prop)
+            npt.assert_array_equal(
+                nlist_1.query_point_indices, nlist_2.query_point_indices
+            )
+            npt.assert_array_equal(nlist_1.point_indices, nlist_2.point_indices)
+            npt.assert_allclose(nlist_1.distances, nlist_2.distances)
+
     @pytest.mark.parametrize("nlist_property", ["filtered_nlist", "unfiltered_nlist"])
     def test_nlist_lifetime(self, nlist_property):
         def _get_nlist(sys):
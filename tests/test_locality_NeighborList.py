@@ -128,6 +128,37 @@ class TestNeighborList:
         # should be able to further filter
         self.nlist.filter_r(2.5)
 
+    @pytest.mark.parametrize("use_filter_r", [False, True])
+    def test_filter_many_blocks(self, use_filter_r):
+        # Lists of many blocks of bonds are compacted in parallel, and the
+        # segments and counts must match those of the kept bonds.
+        box, points = freud.data.make_random_system(20, 4000, seed=1)
+        nlist = (
+            freud.locality.AABBQuery(box, points)
+            .query(points, dict(r_max=2, exclude_ii=True))
+            .toNeighborList()
+        )
+        assert len(nlist) > 2**15
+        if use_filter_r:
+            filt = np.logical_and(nlist.distances >= 0.5, nlist.distances < 1.5)
+        else:
+            filt = np.random.default_rng(0).random(len(nlist)) < 0.3
+        kept = nlist[filt]
+        kept_distances = nlist.distances[filt]
+        if use_filter_r:
+            nlist.filter_r(1.5, 0.5)
+        else:
+            nlist.filter(filt)
+
+        npt.assert_array_equal(nlist[:], kept)
+        npt.assert_array_equal(nlist.distances, kept_distances)
+        counts = np.bincount(nlist.query_point_indices, minlength=len(points))
+        npt.assert_array_equal(nlist.neighbor_counts, counts)
+        nonempty = counts > 0
+        npt.assert_array_equal(
+            nlist.segments[nonempty], (np.cumsum(counts) - counts)[nonempty]
+        )
+
     def test_find_first_index(self):
         nlist = self.nlist
         for idx, i in enumerate(nlist.query_point_indices):
@@ -137,6 +168,14 @@ class TestNeighborList:
         ones = np.ones(len(self.nlist), dtype=np.float32)
         assert np.allclose(np.add.reduceat(ones, self.nlist.segments), 6)
         assert np.allclose(self.nlist.neighbor_counts, 6)
+        # Bond indices are 64-bit so that very large lists can be indexed.
+        assert self.nlist.segments.dtype == np.uintp
+        npt.assert_array_equal(
+            self.nlist.segments,
+            np.searchsorted(
+                self.nlist.query_point_indices, np.arange(self.nlist.num_query_points)
+            ),
+        )
 
     def test_from_arrays(self):
         query_point_indices = [0, 0, 1, 2, 3]
@@ -351,3 +390,61 @@ class TestNeighborList:
         npt.assert_allclose(nlist.query_point_indices, qp_indices)
         npt.assert_allclose(nlist.point_indices, np.array([1, 3, 0, 2]))
         npt.assert_allclose(nlist.distances, np.array([1, 2, 3, 4]))
+
+    def test_save_load(self, tmp_path):
+        filename = tmp_path / "neighbors.nlist"
+        self.nlist.save(filename)
+        nlist = freud.locality.NeighborList.load(filename)
+
+        assert nlist.num_query_points == self.nlist.num_query_points
+        assert nlist.num_points == self.nlist.num_points
+        assert nlist.half_list == self.nlist.half_list
+        npt.assert_array_equal(nlist[:], self.nlist[:])
+        npt.assert_array_equal(nlist.distances, self.nlist.distances)
+        npt.assert_array_equal(nlist.weights, self.nlist.weights)
+        npt.assert_array_equal(nlist.segments, self.nlist.segments)
+        npt.assert_array_equal(nlist.neighbor_counts, self.nlist.neighbor_counts)
+
+        # Arrays remain valid after the loaded list is destroyed, and
+        # modifying a loaded list does not change the file.
+        distances = nlist.distances
+        nlist.filter_r(r_max=1)
+        del nlist
+        npt.assert_array_equal(distances, self.nlist.distances)
+        nlist = freud.locality.NeighborList.load(str(filename))
+        npt.assert_array_equal(nlist.distances, self.nlist.distances)
+
+    def test_save_load_empty(self, tmp_path):
+        filename = tmp_path / "empty.nlist"
+        freud.locality.NeighborList().save(filename)
+        nlist = freud.locality.NeighborList.load(filename)
+        assert len(nlist) == 0
+
+    def test_load_invalid(self, tmp_path):
+        with pytest.raises(RuntimeError):
+            freud.locality.NeighborList.load(tmp_path / "missing.nlist")
+
+        filename = tmp_path / "invalid.nlist"
+        filename.write_bytes(b"not a neighbor list")
+        with pytest.raises(RuntimeError):
+            freud.locality.NeighborList.load(filename)
+
+        self.nlist.save(filename)
+        truncated = filename.read_bytes()[:-4]
+        filename.write_bytes(truncated)
+        with pytest.raises(RuntimeError):
+            freud.locality.NeighborList.load(filename)
+
+        # The offsets of the arrays follow the first 48 bytes of the header,
+        # starting with the bond indices.
+        self.nlist.save(filename)
+        contents = bytearray(filename.read_bytes())
+        neighbors_offset = int(np.frombuffer(contents, np.uint64, 1, 48)[0])
+        # Out of range query point and point indices, and unsorted bonds.
+        last_query_point = int(self.nlist.query_point_indices[-1])
+        for index, value in [(0, 2**20), (1, 2**20), (0, last_query_point)]:
+            corrupted = contents.copy()
+            np.frombuffer(corrupted, np.uint32, 2, neighbors_offset)[index] = value
+            filename.write_bytes(bytes(corrupted))
+            with pytest.raises(RuntimeError):
+                freud.locality.NeighborList.load(filename)
@@ -46,7 +46,7 @@ def nlist_equal(nlist1, nlist2):
 
 class NeighborQueryTest:
     @classmethod
-    def build_query_object(cls, box, ref_points, r_max=None):
+    def build_query_object(cls, box, ref_points, r_max=None, copy=True):
         raise RuntimeError(
             "The build_query_object function must be defined for every "
             "subclass of NeighborQuery in a separate test subclass."
@@ -90,6 +90,49 @@ class NeighborQueryTest:
         box = freud.box.Box.cube(L)
         self.build_query_object(box, points, r_max)
 
+    @pytest.mark.parametrize("layout", ["float64", "fortran", "structured"])
+    def test_strided_points(self, layout):
+        L = 10
+        N = 100
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        if layout == "float64":
+            strided = points.astype(np.float64)
+        elif layout == "fortran":
+            strided = np.asfortranarray(points)
+        else:
+            records = np.zeros(N, dtype=[("id", np.int32), ("pos", np.float64, 3)])
+            records["pos"] = points
+            strided = records["pos"]
+
+        nq = self.build_query_object(box, strided, 3)
+        npt.assert_allclose(nq.points, points)
+        query_args = dict(r_max=3, exclude_ii=True)
+        nlist = nq.query(strided[::-1], query_args).toNeighborList()
+        ref_nq = self.build_query_object(box, points, 3)
+        ref_nlist = ref_nq.query(points[::-1], query_args).toNeighborList()
+        assert nlist_equal(nlist, ref_nlist)
+
+    def test_copy_points(self):
+        L = 10
+        N = 100
+        box, points = freud.data.make_random_system(L, N, seed=0)
+
+        # A read-only view does not prevent changes through its base array,
+        # so the points are copied unless the caller opts out.
+        view = points.view()
+        view.flags.writeable = False
+        nq = self.build_query_object(box, view, 3)
+        npt.assert_array_equal(nq.points, points)
+        assert not np.shares_memory(nq.points, points)
+        query_args = dict(r_max=3, exclude_ii=True)
+        ref_nlist = nq.query(points, query_args).toNeighborList()
+        points[:] = 0
+        nlist = nq.query(nq.points, query_args).toNeighborList()
+        assert nlist_equal(nlist, ref_nlist)
+
+        nq = self.build_query_object(box, view, 3, copy=False)
+        assert np.shares_memory(nq.points, points)
+
     def test_query_ball(self):
         L = 10  # Box Dimensions
         r_max = 2.01  # Cutoff radius
@@ -390,6 +433,55 @@ class NeighborQueryTest:
 
         assert ij1 == ij2
 
+    def test_half_list(self):
+        L, r_max, N = (10, 2.01, 1024)
+
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        nq = self.build_query_object(box, points, r_max)
+        full = nq.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+        half = nq.query(points, dict(r_max=r_max, half_list=True)).toNeighborList()
+
+        assert half.half_list
+        assert not full.half_list
+        assert np.all(half.query_point_indices < half.point_indices)
+        ij_full = {(i, j) for i, j in full[:] if i < j}
+        ij_half = {(i, j) for i, j in half[:]}
+        assert ij_full == ij_half
+
+        # The flag survives filtering.
+        assert half.copy().filter_r(r_max / 2).half_list
+
+        # Half lists are only defined for ball queries.
+        with pytest.raises(RuntimeError):
+            nq.query(points, dict(num_neighbors=4, half_list=True))
+
+    def test_query_batch(self):
+        L, N = 10, 1000
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        nq = self.build_query_object(box, points, 3.0)
+        query_args = [
+            dict(r_max=1.5, exclude_ii=True),
+            dict(r_max=3.0, r_min=0.5),
+            dict(num_neighbors=8, exclude_ii=True),
+            dict(num_neighbors=40, exclude_ii=False),
+            dict(r_max=2.0, half_list=True),
+        ]
+        nlists = nq.query_batch(points, query_args)
+        assert len(nlists) == len(query_args)
+        for nlist, qargs in zip(nlists, query_args):
+            expected = nq.query(points, qargs).toNeighborList()
+            assert nlist.half_list == expected.half_list
+            npt.assert_equal(nlist[:], expected[:])
+            npt.assert_allclose(nlist.distances, expected.distances)
+
+        # Nearest neighbor queries alone are answered from a single search too.
+        query_args = [dict(num_neighbors=4), dict(num_neighbors=12, exclude_ii=True)]
+        for nlist, qargs in zip(nq.query_batch(points, query_args), query_args):
+            expected = nq.query(points, qargs).toNeighborList()
+            npt.assert_equal(nlist[:], expected[:])
+
+        assert nq.query_batch(points, []) == []
+
     @pytest.mark.parametrize("seed", range(10))
     def test_exhaustive_search(self, seed):
         L, r_max, N = (10, 1.999, 32)
@@ -600,8 +692,8 @@ class NeighborQueryTest:
 
 class TestNeighborQueryAABB(NeighborQueryTest):
     @classmethod
-    def build_query_object(cls, box, ref_points, r_max=None):
-        return freud.locality.AABBQuery(box, ref_points)
+    def build_query_object(cls, box, ref_points, r_max=None, copy=True):
+        return freud.locality.AABBQuery(box, ref_points, copy=copy)
 
     def test_too_large_r_max_raises(self):
         """Test that specifying too large an r_max value raises an error."""
@@ -613,6 +705,54 @@ class TestNeighborQueryAABB(NeighborQueryTest):
         with pytest.raises(RuntimeError):
             list(aq.query(points, dict(r_max=L)))
 
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_all_images(self, is2D):
+        """Test finding bonds to all periodic images for r_max above L/2."""
+        L, N, r_max = 3, 40, 4.1
+        box, points = freud.data.make_random_system(L, N, is2D=is2D, seed=0)
+        aq = freud.locality.AABBQuery(box, points)
+        nlist = aq.query(
+            points, dict(r_max=r_max, exclude_ii=True, all_images=True)
+        ).toNeighborList()
+
+        # Replicate the points explicitly to find the expected distances.
+        image_range = range(-2, 3)
+        images = np.array(
+            [
+                [i, j, k]
+                for i in image_range
+                for j in image_range
+                for k in ([0] if is2D else image_range)
+            ]
+        )
+        image_vectors = images @ box.to_matrix().T
+        for i, point in enumerate(points):
+            vectors = points[np.newaxis, :, :] + image_vectors[:, np.newaxis, :] - point
+            distances = np.linalg.norm(vectors, axis=-1)
+            distances[np.all(images == 0, axis=-1), i] = np.inf
+            npt.assert_allclose(
+                np.sort(nlist.distances[nlist.query_point_indices == i]),
+                np.sort(distances[distances < r_max]),
+                rtol=1e-5,
+            )
+
+        # Bonds to all images are only found by ball queries of full lists.
+        with pytest.raises(RuntimeError):
+            aq.query(points, dict(r_max=r_max, all_images=True, half_list=True))
+        with pytest.raises(RuntimeError):
+            aq.query(points, dict(num_neighbors=4, all_images=True))
+
+    def test_all_images_small_r_max(self):
+        """Test that all images give the default bonds for r_max below L/2."""
+        L, N, r_max = 10, 500, 2
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        aq = freud.locality.AABBQuery(box, points)
+        nlist1 = aq.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+        nlist2 = aq.query(
+            points, dict(r_max=r_max, exclude_ii=True, all_images=True)
+        ).toNeighborList()
+        assert nlist_equal(nlist1, nlist2)
+
     def test_chaining(self):
         N = 500
         L = 10
@@ -627,6 +767,106 @@ class TestNeighborQueryAABB(NeighborQueryTest):
         nlist2 = abq.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
         assert nlist_equal(nlist1, nlist2)
 
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_parallel_build(self, is2D):
+        """Ensure that the parallel tree build gives identical query results."""
+        L, N = 40, 20000
+        box, points = freud.data.make_random_system(L, N, is2D=is2D, seed=0)
+        serial_aq = freud.locality.AABBQuery(box, points)
+        parallel_aq = freud.locality.AABBQuery(box, points, parallel_build=True)
+        for query_args in [dict(r_max=1.5), dict(num_neighbors=6)]:
+            query_args["exclude_ii"] = True
+            nlist = parallel_aq.query(points, query_args).toNeighborList()
+            ref_nlist = serial_aq.query(points, query_args).toNeighborList()
+            npt.assert_array_equal(nlist[:], ref_nlist[:])
+            npt.assert_array_equal(nlist.distances, ref_nlist.distances)
+
+    @pytest.mark.parametrize("query_args", [dict(r_max=1.2), dict(num_neighbors=8)])
+    def test_default_cell_width_thin_box(self, query_args):
+        """Check that default cells adapt to boxes thinner than a cubic cell."""
+        N = 1000
+        box = freud.box.Box(20, 20, 3)
+        points = box.wrap(np.random.default_rng(0).uniform(-10, 10, (N, 3)))
+        query_args["exclude_ii"] = True
+        lc = freud.locality.LinkCell(box, points)
+        assert lc.cell_width > 0
+        nlist1 = lc.query(points, query_args).toNeighborList()
+        nlist2 = (
+            freud.locality.LinkCell(box, points, 1.2)
+            .query(points, query_args)
+            .toNeighborList()
+        )
+        assert nlist_equal(nlist1, nlist2)
+
+    @pytest.mark.parametrize("displacement", [0.01, 0.1, 5.0])
+    def test_update(self, displacement):
+        """Check that updating an AABBQuery matches building a new one."""
+        N = 500
+        L = 10
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        aq = freud.locality.AABBQuery(box, points)
+
+        np.random.seed(1)
+        for _ in range(3):
+            points = box.wrap(
+                points + np.random.normal(scale=displacement, size=points.shape)
+            )
+            aq.update(points)
+            npt.assert_allclose(aq.points, points)
+
+            for query_args in [dict(r_max=1.0), dict(num_neighbors=6)]:
+                query_args["exclude_ii"] = True
+                nlist1 = (
+                    freud.locality.AABBQuery(box, points)
+                    .query(points, query_args)
+                    .toNeighborList()
+                )
+                nlist2 = aq.query(points, query_args).toNeighborList()
+                assert nlist_equal(nlist1, nlist2)
+
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_query_contacts(self, is2D):
+        """Check contacts against a ball query filtered by the radii."""
+        L, N = 10, 1000
+        box, points = freud.data.make_random_system(L, N, is2D=is2D, seed=0)
+        rng = np.random.default_rng(1)
+        radii = np.where(rng.random(N) < 0.1, 1.0, 0.1 * rng.random(N))
+        delta = 0.05
+        aq = freud.locality.AABBQuery(box, points, radii=radii)
+        nlist = aq.query_contacts(points, radii, delta=delta, exclude_ii=True)
+
+        r_max = 2 * radii.max() + delta
+        ref_nlist = aq.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
+        contact = radii[ref_nlist.query_point_indices] + radii[ref_nlist.point_indices]
+        ref_nlist.filter(ref_nlist.distances < contact + delta)
+        npt.assert_array_equal(nlist[:], ref_nlist[:])
+        npt.assert_allclose(nlist.distances, ref_nlist.distances)
+
+        # Contacts follow updates of the points.
+        points = box.wrap(points + rng.normal(scale=0.1, size=points.shape))
+        aq.update(points)
+        new_aq = freud.locality.AABBQuery(box, points, radii=radii)
+        npt.assert_array_equal(
+            aq.query_contacts(points, radii, delta=delta)[:],
+            new_aq.query_contacts(points, radii, delta=delta)[:],
+        )
+
+    def test_query_contacts_requires_radii(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        aq = freud.locality.AABBQuery(box, points)
+        with pytest.raises(ValueError):
+            aq.query_contacts(points, np.ones(len(points)))
+        with pytest.raises(ValueError):
+            freud.locality.AABBQuery(box, points, radii=-np.ones(len(points)))
+
+    def test_update_invalid_points(self):
+        N = 500
+        L = 10
+        box, points = freud.data.make_random_system(L, N)
+        aq = freud.locality.AABBQuery(box, points)
+        with pytest.raises(ValueError):
+            aq.update(points[:-1])
+
     @pytest.mark.parametrize(
         "r_guess, scale",
         [(r_guess, scale) for r_guess in [0.5, 1, 2] for scale in [1.01, 1.1, 1.3]],
@@ -657,10 +897,10 @@ class TestNeighborQueryAABB(NeighborQueryTest):
 
 class TestNeighborQueryLinkCell(NeighborQueryTest):
     @classmethod
-    def build_query_object(cls, box, ref_points, r_max=None):
+    def build_query_object(cls, box, ref_points, r_max=None, copy=True):
         if r_max is None:
             raise ValueError("Building LinkCells requires passing an r_max.")
-        return freud.locality.LinkCell(box, ref_points, r_max)
+        return freud.locality.LinkCell(box, ref_points, r_max, copy=copy)
 
     def test_chaining(self):
         N = 500
@@ -676,6 +916,13 @@ class TestNeighborQueryLinkCell(NeighborQueryTest):
         nlist2 = lc.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
         assert nlist_equal(nlist1, nlist2)
 
+    def test_all_images_raises(self):
+        """Test that LinkCell does not find bonds to all periodic images."""
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        lc = freud.locality.LinkCell(box, points, 1.0)
+        with pytest.raises(RuntimeError):
+            lc.query(points, dict(r_max=1, all_images=True))
+
     def test_default_cell_width(self):
         """Check that using a default cell width works."""
         N = 500
@@ -691,6 +938,74 @@ class TestNeighborQueryLinkCell(NeighborQueryTest):
         nlist2 = lc.query(points, dict(r_max=r_max, exclude_ii=True)).toNeighborList()
         assert nlist_equal(nlist1, nlist2)
 
+    @pytest.mark.parametrize("query_args", [dict(r_max=1.2), dict(num_neighbors=8)])
+    def test_default_cell_width_thin_box(self, query_args):
+        """Check that default cells adapt to boxes thinner than a cubic cell."""
+        N = 1000
+        box = freud.box.Box(20, 20, 3)
+        points = box.wrap(np.random.default_rng(0).uniform(-10, 10, (N, 3)))
+        query_args["exclude_ii"] = True
+        lc = freud.locality.LinkCell(box, points)
+        assert lc.cell_width > 0
+        nlist1 = lc.query(points, query_args).toNeighborList()
+        nlist2 = (
+            freud.locality.LinkCell(box, points, 1.2)
+            .query(points, query_args)
+            .toNeighborList()
+        )
+        assert nlist_equal(nlist1, nlist2)
+
+    @pytest.mark.parametrize("displacement", [0.01, 0.1, 5.0])
+    def test_update(self, displacement):
+        """Check that updating a LinkCell matches building a new one."""
+        N = 500
+        L = 10
+        r_max = 1
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        lc = freud.locality.LinkCell(box, points, 1.0)
+
+        np.random.seed(1)
+        new_points = box.wrap(
+            points + np.random.normal(scale=displacement, size=points.shape)
+        )
+        lc.update(new_points)
+        npt.assert_allclose(lc.points, new_points)
+
+        nlist1 = (
+            freud.locality.LinkCell(box, new_points, 1.0)
+            .query(new_points, dict(r_max=r_max, exclude_ii=True))
+            .toNeighborList()
+        )
+        nlist2 = lc.query(
+            new_points, dict(r_max=r_max, exclude_ii=True)
+        ).toNeighborList()
+        assert nlist_equal(nlist1, nlist2)
+
+    def test_update_invalid_points(self):
+        N = 500
+        L = 10
+        box, points = freud.data.make_random_system(L, N)
+        lc = freud.locality.LinkCell(box, points, 1.0)
+        with pytest.raises(ValueError):
+            lc.update(points[:-1])
+
+    @pytest.mark.parametrize("num_neighbors", [1, 12])
+    def test_nearest_compute(self, num_neighbors):
+        """Check that computes find the same nearest neighbors as a query."""
+        L, N = 10, 1000
+        r_max = 3
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        lc = freud.locality.LinkCell(box, points, 1.0)
+        query_args = dict(num_neighbors=num_neighbors, exclude_ii=True)
+        nlist = lc.query(points, query_args).toNeighborList()
+        npt.assert_array_equal(nlist.neighbor_counts, num_neighbors)
+
+        rdf = freud.density.RDF(bins=50, r_max=r_max)
+        rdf.compute(lc, neighbors=query_args, reset=False)
+        ref_rdf = freud.density.RDF(bins=50, r_max=r_max)
+        ref_rdf.compute(lc, neighbors=nlist, reset=False)
+        npt.assert_array_equal(rdf.bin_counts, ref_rdf.bin_counts)
+
 
 class TestMultipleMethods:
     """Check that different methods of making a NeighborList give the same
@@ -715,6 +1030,76 @@ class TestMultipleMethods:
             assert nlist_equal(nlist, check_nlist)
 
 
+class TestNeighborQueryAABBSpatialSort(TestNeighborQueryAABB):
+    @classmethod
+    def build_query_object(cls, box, ref_points, r_max=None, copy=True):
+        return freud.locality.AABBQuery(
+            box, ref_points, spatial_sort=True, copy=copy
+        )
+
+    def test_spatial_sort(self):
+        L, N = 10, 1000
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        sorted_nq = self.build_query_object(box, points, 1.5)
+        assert sorted_nq.spatially_sorted
+        assert not freud.locality.AABBQuery(box, points).spatially_sorted
+        npt.assert_array_equal(sorted_nq.points, points)
+
+        # Neighbor lists and compute results use the original point indices.
+        for query_args in [dict(r_max=1.5), dict(num_neighbors=6)]:
+            query_args["exclude_ii"] = True
+            nlist = sorted_nq.query(points, query_args).toNeighborList()
+            ref_nlist = (
+                freud.locality.AABBQuery(box, points)
+                .query(points, query_args)
+                .toNeighborList()
+            )
+            npt.assert_array_equal(nlist[:], ref_nlist[:])
+            npt.assert_allclose(nlist.distances, ref_nlist.distances)
+
+        ql = freud.order.Steinhardt(6)
+        ql.compute(sorted_nq, dict(num_neighbors=6, exclude_ii=True))
+        ref_ql = freud.order.Steinhardt(6).compute(
+            (box, points), dict(num_neighbors=6, exclude_ii=True)
+        )
+        npt.assert_allclose(ql.particle_order, ref_ql.particle_order, rtol=1e-5)
+
+
+class TestNeighborQueryLinkCellSpatialSort(TestNeighborQueryLinkCell):
+    @classmethod
+    def build_query_object(cls, box, ref_points, r_max=None, copy=True):
+        if r_max is None:
+            raise ValueError("Building LinkCells requires passing an r_max.")
+        return freud.locality.LinkCell(
+            box, ref_points, r_max, spatial_sort=True, copy=copy
+        )
+
+    def test_spatial_sort(self):
+        L, N = 10, 1000
+        r_max = 1.5
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        sorted_nq = self.build_query_object(box, points, r_max)
+        assert sorted_nq.spatially_sorted
+
+        rdf = freud.density.RDF(bins=50, r_max=r_max)
+        rdf.compute(sorted_nq, reset=False)
+        ref_rdf = freud.density.RDF(bins=50, r_max=r_max)
+        ref_rdf.compute(freud.locality.LinkCell(box, points, r_max), reset=False)
+        npt.assert_allclose(rdf.bin_counts, ref_rdf.bin_counts)
+
+        # Updating keeps the spatial ordering and the original indices.
+        points = box.wrap(points + np.random.uniform(-0.1, 0.1, points.shape))
+        sorted_nq.update(points)
+        query_args = dict(r_max=r_max, exclude_ii=True)
+        nlist = sorted_nq.query(points, query_args).toNeighborList()
+        ref_nlist = (
+            freud.locality.LinkCell(box, points, r_max)
+            .query(points, query_args)
+            .toNeighborList()
+        )
+        npt.assert_array_equal(nlist[:], ref_nlist[:])
+
+
 def _from_system_inputs():
     """Each list value is a tuple (system_name, system)."""
     list_systems = []
@@ -223,6 +223,37 @@ class TestPeriodicBuffer:
 
         assert len(pbuff.buffer_points) == points_fac * N
 
+    @pytest.mark.parametrize("images, buffer", [(False, 2.5), (True, [1, 2, 1])])
+    def test_buffer_images(self, images, buffer):
+        box = freud.box.Box(8, 9, 10, 0.1, 0.2, 0.3)
+        _, positions = freud.data.make_random_system(8, 2000, seed=0)
+        positions = box.wrap(positions)
+
+        pbuff = freud.locality.PeriodicBuffer()
+        pbuff.compute((box, positions), buffer=buffer, images=images)
+        buffer_points = pbuff.buffer_points.copy()
+        buffer_ids = pbuff.buffer_ids.copy()
+        buffer_images = pbuff.buffer_images.copy()
+        assert buffer_points.dtype == np.float32
+        assert buffer_ids.dtype == np.uint32
+
+        # The buffer points are ordered by point, and each one is its point
+        # shifted by its image.
+        assert np.all(np.diff(buffer_ids.astype(np.int64)) >= 0)
+        shifted = positions[buffer_ids] + buffer_images @ box.to_matrix().T
+        if images:
+            shifted = pbuff.buffer_box.wrap(shifted)
+        npt.assert_allclose(buffer_points, shifted, atol=1e-4)
+
+        # The ids and images do not depend on whether the points are stored.
+        pbuff.compute(
+            (box, positions), buffer=buffer, images=images, compute_points=False
+        )
+        npt.assert_array_equal(pbuff.buffer_ids, buffer_ids)
+        npt.assert_array_equal(pbuff.buffer_images, buffer_images)
+        with pytest.raises(ValueError):
+            pbuff.buffer_points
+
     def test_repr(self):
         pbuff = freud.locality.PeriodicBuffer()
         assert str(pbuff) == str(eval(repr(pbuff)))
@@ -0,0 +1,103 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+
+class TestSlabDecomposition:
+    @pytest.mark.parametrize(
+        "box",
+        [
+            freud.box.Box.cube(10),
+            freud.box.Box(10, 12, 8, 0.3, -0.2, 0.1),
+            freud.box.Box(10, 10, 10, periodic=(False, True, True)),
+        ],
+    )
+    def test_slabs(self, box):
+        """Test that the slabs and their halos hold all neighbors of their
+        points."""
+        r_max = 1.5
+        points = box.wrap(
+            np.random.default_rng(0).uniform(-5, 5, size=(1000, 3)).astype(np.float32)
+        )
+        nlist = (
+            freud.AABBQuery(box, points)
+            .query(points, dict(r_max=r_max, exclude_ii=True))
+            .toNeighborList()
+        )
+
+        slabs = freud.locality.SlabDecomposition(box, points, r_max, 4, chunk_size=128)
+        assert len(slabs) == 4
+        assert slabs.halo == r_max
+        core_indices = []
+        for slab_points, indices, n_core in slabs:
+            assert len(slab_points) == len(indices)
+            npt.assert_array_equal(slab_points, points[indices])
+            core_indices.append(indices[:n_core])
+
+            # The neighbors of the points of the slab are all in the slab.
+            in_slab = np.isin(nlist.query_point_indices, indices[:n_core])
+            assert np.all(np.isin(nlist.point_indices[in_slab], indices))
+            slab_nlist = (
+                freud.AABBQuery(box, slab_points)
+                .query(slab_points[:n_core], dict(r_max=r_max, exclude_ii=True))
+                .toNeighborList()
+            )
+            assert len(slab_nlist) == np.count_nonzero(in_slab)
+
+        # Every point is a point of exactly one slab.
+        npt.assert_array_equal(np.sort(np.concatenate(core_indices)), np.arange(1000))
+
+    def test_per_particle(self):
+        """Test merging the per-particle results of the slabs."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        ld = freud.density.LocalDensity(r_max=2, diameter=1)
+        neighbors = dict(r_max=2.5, exclude_ii=True)
+        expected = np.array(ld.compute((box, points), neighbors=neighbors).density)
+
+        # The first points of each slab are its query points, so that the
+        # query points are excluded as in the whole point set.
+        density = np.empty(len(points))
+        slabs = freud.locality.SlabDecomposition(box, points, 2.5, 3)
+        for slab_points, indices, n_core in slabs:
+            ld.compute(
+                (box, slab_points),
+                query_points=slab_points[:n_core],
+                neighbors=neighbors,
+            )
+            density[indices[:n_core]] = ld.density
+        npt.assert_allclose(density, expected, rtol=1e-5)
+
+    def test_errors(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        with pytest.raises(ValueError):
+            freud.locality.SlabDecomposition(box, points, 1, 0)
+        with pytest.raises(ValueError):
+            freud.locality.SlabDecomposition(box, points, -1, 2)
+        with pytest.raises(ValueError):
+            freud.locality.SlabDecomposition(box, points[:, :2], 1, 2)
+
+        class FailingPoints:
+            shape = points.shape
+
+            def __getitem__(self, index):
+                raise OSError("Unable to read points.")
+
+        slabs = freud.locality.SlabDecomposition(box, FailingPoints(), 1, 2)
+        with pytest.raises(OSError):
+            next(iter(slabs))
+        with pytest.raises(OSError):
+            freud.density.RDF(10, 1).compute_slabs(slabs)
+
+    def test_repr(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        slabs = freud.locality.SlabDecomposition(box, points, 1, 2)
+        assert repr(slabs) == (
+            "freud.locality.SlabDecomposition(box={}, halo=1.0, slabs=2)".format(
+                repr(box)
+            )
+        )
@@ -0,0 +1,74 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+
+def make_systems(num_points=(20, 0, 35, 12), seed=0):
+    systems = [
+        freud.data.make_random_system(5 + i, n, seed=seed + i)
+        for i, n in enumerate(num_points)
+    ]
+    boxes = [box for box, _ in systems]
+    points = np.concatenate([points for _, points in systems])
+    offsets = np.concatenate([[0], np.cumsum(num_points)])
+    return systems, freud.locality.SystemBatch(boxes, points, offsets)
+
+
+class TestSystemBatch:
+    def test_attributes(self):
+        systems, batch = make_systems()
+        assert batch.num_systems == len(batch) == 4
+        npt.assert_array_equal(batch.offsets, [0, 20, 20, 55, 67])
+        assert batch.points.shape == (67, 3)
+        for box, (system_box, _) in zip(batch.boxes, systems):
+            assert box == system_box
+
+    @pytest.mark.parametrize(
+        "query_args", [dict(r_max=2), dict(num_neighbors=4, r_max=3)]
+    )
+    def test_query(self, query_args):
+        systems, batch = make_systems()
+        nlist = batch.query(query_args)
+        offsets = batch.offsets
+        first_bond = 0
+        for i, (box, points) in enumerate(systems):
+            if len(points) == 0:
+                continue
+            system_nlist = (
+                freud.AABBQuery(box, points)
+                .query(points, dict(query_args, exclude_ii=True))
+                .toNeighborList()
+            )
+            bonds = slice(first_bond, first_bond + len(system_nlist))
+            npt.assert_array_equal(
+                nlist.query_point_indices[bonds],
+                system_nlist.query_point_indices + offsets[i],
+            )
+            npt.assert_array_equal(
+                nlist.point_indices[bonds], system_nlist.point_indices + offsets[i]
+            )
+            npt.assert_allclose(nlist.distances[bonds], system_nlist.distances)
+            first_bond += len(system_nlist)
+        assert len(nlist) == first_bond
+
+    def test_errors(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        with pytest.raises(ValueError):
+            freud.locality.SystemBatch([box, box], points, [0, 50])
+        with pytest.raises(ValueError):
+            freud.locality.SystemBatch([box, box], points, [0, 50, 90])
+        with pytest.raises(ValueError):
+            freud.locality.SystemBatch([box, box, box], points, [0, 60, 50, 100])
+        with pytest.raises(ValueError):
+            freud.locality.SystemBatch([box, box], points, [10, 50, 100])
+
+    def test_repr(self):
+        _, batch = make_systems()
+        assert repr(batch) == (
+            "freud.locality.SystemBatch(num_systems=4, num_points=67)"
+        )
@@ -0,0 +1,120 @@
+# Copyright (c) 2010-2023 The Regents of the University of Michigan
+# This file is from the freud project, released under the BSD 3-Clause License.
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
+import freud
+
+
+def assert_nlist_equal(nlist, ref_nlist):
+    npt.assert_array_equal(nlist.query_point_indices, ref_nlist.query_point_indices)
+    npt.assert_array_equal(nlist.point_indices, ref_nlist.point_indices)
+    npt.assert_allclose(nlist.distances, ref_nlist.distances, rtol=1e-5, atol=1e-6)
+
+
+class TestVerletList:
+    def test_matches_query(self):
+        L, N = 10, 1000
+        skin = 0.4
+        query_args = dict(r_max=1.5, r_min=0.2, exclude_ii=True)
+        box, points = freud.data.make_random_system(L, N, seed=0)
+        np.random.seed(0)
+
+        verlet = freud.locality.VerletList(skin)
+        assert verlet.skin == pytest.approx(skin)
+        for frame in range(10):
+            points = box.wrap(points + np.random.uniform(-0.05, 0.05, points.shape))
+            aq = freud.locality.AABBQuery(box, points)
+            verlet.compute(aq, neighbors=query_args)
+            ref_nlist = aq.query(points, query_args).toNeighborList()
+            assert_nlist_equal(verlet.nlist, ref_nlist)
+            if frame == 0:
+                assert verlet.rebuilt
+
+        # Small displacements should allow the cached list to be reused.
+        assert 1 <= verlet.num_rebuilds < 10
+
+    def test_query_points(self):
+        L, N = 10, 500
+        skin = 0.3
+        query_args = dict(r_max=2.0)
+        box, points = freud.data.make_random_system(L, N, seed=1)
+        query_points = box.wrap(points[: N // 2] + 0.5)
+
+        verlet = freud.locality.VerletList(skin)
+        verlet.compute((box, points), query_args, query_points)
+
+        # Moving only the query points by less than the skin reuses the cache.
+        query_points = box.wrap(query_points + [0.1, 0, 0])
+        verlet.compute((box, points), query_args, query_points)
+        assert not verlet.rebuilt
+        ref_nlist = (
+            freud.locality.AABBQuery(box, points)
+            .query(query_points, query_args)
+            .toNeighborList()
+        )
+        assert_nlist_equal(verlet.nlist, ref_nlist)
+
+    def test_rebuild(self):
+        L, N = 10, 200
+        query_args = dict(r_max=1.5, exclude_ii=True)
+        box, points = freud.data.make_random_system(L, N, seed=2)
+
+        verlet = freud.locality.VerletList(0.2)
+        verlet.compute((box, points), query_args)
+        verlet.compute((box, points), query_args)
+        assert not verlet.rebuilt
+        assert verlet.num_rebuilds == 1
+
+        # Moving a single point by more than half the skin forces a rebuild.
+        points[0] = box.wrap(points[0] + [0.15, 0, 0])
+        verlet.compute((box, points), query_args)
+        assert verlet.rebuilt
+        assert verlet.num_rebuilds == 2
+
+        # Changing the box or the query arguments forces a rebuild.
+        new_box = freud.box.Box.cube(L + 0.1)
+        verlet.compute((new_box, points), query_args)
+        assert verlet.rebuilt
+        verlet.compute((new_box, points), dict(r_max=1.0, exclude_ii=True))
+        assert verlet.rebuilt
+
+        verlet.reset()
+        assert verlet.num_rebuilds == 0
+        with pytest.raises(AttributeError):
+            verlet.nlist
+        verlet.compute((new_box, points), query_args)
+        assert verlet.rebuilt
+
+    def test_invalid(self):
+        box, points = freud.data.make_random_system(10, 100, seed=3)
+        with pytest.raises(ValueError):
+            freud.locality.VerletList(-1)
+        verlet = freud.locality.VerletList(0.5)
+        with pytest.raises(ValueError):
+            verlet.compute((box, points), dict(num_neighbors=4))
+        with pytest.raises(ValueError):
+            nlist = (
+                freud.locality.AABBQuery(box, points)
+                .query(points, dict(r_max=1))
+                .toNeighborList()
+            )
+            verlet.compute((box, points), nlist)
+
+    def test_all_images(self):
+        # With r_max beyond half of the box, bonds to farther images than the
+        # minimum image cannot be refreshed from the current positions.
+        L, N = 4, 20
+        box, points = freud.data.make_random_system(L, N, seed=4)
+        query_args = dict(r_max=0.6 * L, all_images=True)
+        aq = freud.locality.AABBQuery(box, points)
+        assert aq.query(points, query_args).toNeighborList().num_bonds > 0
+        verlet = freud.locality.VerletList(0.1)
+        with pytest.raises(ValueError):
+            verlet.compute(aq, query_args)
+
+    def test_repr(self):
+        verlet = freud.locality.VerletList(0.5)
+        assert str(verlet) == str(eval(repr(verlet)))
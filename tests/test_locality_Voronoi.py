@@ -346,9 +346,52 @@ class TestVoronoi:
         )
         npt.assert_allclose(wrapped_distances, vor.nlist.distances)
 
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_parallel(self, is2D):
+        # Test that the tessellation does not depend on the number of threads
+        L = 10  # Box length
+        N = 5000  # Number of particles
+        box, points = freud.data.make_random_system(L, N, is2D=is2D, seed=100)
+        vor = freud.locality.Voronoi()
+
+        freud.parallel.set_num_threads(1)
+        vor.compute((box, points))
+        nlist = vor.nlist.copy()
+        volumes = vor.volumes.copy()
+        polytopes = [polytope.copy() for polytope in vor.polytopes]
+
+        freud.parallel.set_num_threads(0)
+        vor.compute((box, points))
+        npt.assert_array_equal(vor.nlist[:], nlist[:])
+        npt.assert_array_equal(vor.nlist.distances, nlist.distances)
+        npt.assert_array_equal(vor.nlist.weights, nlist.weights)
+        npt.assert_array_equal(vor.volumes, volumes)
+        for polytope, reference_polytope in zip(vor.polytopes, polytopes):
+            npt.assert_array_equal(polytope, reference_polytope)
+
+    @pytest.mark.parametrize("is2D", [False, True])
+    def test_no_polytopes(self, is2D):
+        # Test that neighbors and volumes do not depend on computing polytopes
+        L = 10  # Box length
+        N = 1000  # Number of particles
+        box, points = freud.data.make_random_system(L, N, is2D=is2D, seed=100)
+        vor = freud.locality.Voronoi().compute((box, points))
+        vor_no_polytopes = freud.locality.Voronoi(compute_polytopes=False)
+        assert not vor_no_polytopes.compute_polytopes
+        vor_no_polytopes.compute((box, points))
+
+        npt.assert_array_equal(vor_no_polytopes.nlist[:], vor.nlist[:])
+        npt.assert_array_equal(vor_no_polytopes.nlist.distances, vor.nlist.distances)
+        npt.assert_array_equal(vor_no_polytopes.nlist.weights, vor.nlist.weights)
+        npt.assert_array_equal(vor_no_polytopes.volumes, vor.volumes)
+        with pytest.raises(AttributeError):
+            vor_no_polytopes.polytopes
+
     def test_repr(self):
         vor = freud.locality.Voronoi()
         assert str(vor) == str(eval(repr(vor)))
+        vor = freud.locality.Voronoi(compute_polytopes=False)
+        assert str(vor) == str(eval(repr(vor)))
 
     def test_attributes(self):
         # Test that the class attributes are protected
@@ -81,8 +81,73 @@ class TestMSD:
             npt.assert_allclose(solution, simple, atol=1e-6)
             npt.assert_allclose(solution_particle, simple_particle, atol=1e-5)
 
+    def test_unwrap_and_particle_msd(self):
+        np.random.seed(0)
+        box = freud.box.Box.cube(10)
+        unwrapped = np.cumsum(np.random.normal(size=(30, 8, 3)), axis=0)
+        images = np.floor((unwrapped + 5) / 10).astype(np.int32)
+        positions = unwrapped - 10 * images
+        for mode in ["window", "direct"]:
+            expected = freud.msd.MSD(mode=mode).compute(unwrapped)
+            msd = freud.msd.MSD(box, mode=mode)
+            msd.compute(positions, images, particle_msd=False)
+            npt.assert_allclose(msd.msd, expected.msd, rtol=1e-5, atol=1e-5)
+            with pytest.raises(AttributeError):
+                msd.particle_msd
+
+            # Accumulation over subsets of the particles
+            msd.compute(positions[:, :3], images[:, :3])
+            npt.assert_allclose(
+                msd.particle_msd, expected.particle_msd[:, :3], rtol=1e-5, atol=1e-4
+            )
+            msd.compute(positions[:, 3:], images[:, 3:], reset=False)
+            npt.assert_allclose(
+                msd.particle_msd, expected.particle_msd, rtol=1e-5, atol=1e-4
+            )
+            npt.assert_allclose(msd.msd, expected.msd, rtol=1e-5, atol=1e-5)
+            with pytest.raises(ValueError):
+                msd.compute(positions[:10], images[:10], reset=False)
+
+    def test_multiple_tau(self):
+        np.random.seed(0)
+        positions = np.cumsum(np.random.normal(size=(50, 20, 3)), axis=0)
+
+        # All lags are windows of the MSD if the first level keeps every frame.
+        window = freud.msd.MSD().compute(positions).msd
+        msd = freud.msd.MSD(mode="multiple_tau", points_per_level=50)
+        msd.compute(positions)
+        npt.assert_equal(msd.lags, np.arange(50))
+        npt.assert_allclose(msd.msd, window, rtol=1e-5, atol=1e-5)
+        with pytest.raises(AttributeError):
+            msd.particle_msd
+
+        # Chunks of the trajectory continue the previous frames.
+        msd = freud.msd.MSD(mode="multiple_tau", points_per_level=4)
+        msd.compute(positions)
+        msd_chunks = freud.msd.MSD(mode="multiple_tau", points_per_level=4)
+        msd_chunks.compute(positions[:13])
+        msd_chunks.compute(positions[13:], reset=False)
+        npt.assert_equal(msd_chunks.lags, msd.lags)
+        npt.assert_allclose(msd_chunks.msd, msd.msd, rtol=1e-6)
+
+        # The lags beyond the first level are windows starting at multiples
+        # of their level's stride.
+        for lag, value in zip(msd.lags, msd.msd):
+            stride = max(1, 2 ** int(np.log2(max(lag, 1)) - 1))
+            origins = np.arange(0, 50 - lag)
+            origins = origins[(origins + lag) % stride == 0]
+            expected = np.mean(
+                np.sum((positions[origins + lag] - positions[origins]) ** 2, axis=-1)
+            )
+            npt.assert_allclose(value, expected, rtol=1e-5)
+
+        with pytest.raises(ValueError):
+            freud.msd.MSD(mode="multiple_tau", points_per_level=3)
+
     def test_repr(self):
         msd = freud.msd.MSD()
         assert str(msd) == str(eval(repr(msd)))
         msd2 = freud.msd.MSD(box=freud.box.Box(1, 2, 3, 4, 5, 6), mode="direct")
         assert str(msd2) == str(eval(repr(msd2)))
+        msd3 = freud.msd.MSD(mode="multiple_tau", points_per_level=8)
+        assert str(msd3) == str(eval(repr(msd3)))
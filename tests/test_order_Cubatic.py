@@ -129,6 +129,43 @@ class TestCubatic:
             # scale must be greater than 0
             freud.order.Cubatic(t_initial=5.0, t_final=0.001, scale=0, n_replicates=10)
 
+    def test_gradient(self):
+        """Test that gradient ascent finds the maximum found by annealing."""
+        N = 1000
+        np.random.seed(1030)
+        base = rowan.random.rand(1)[0]
+        orientations = rowan.multiply(
+            base,
+            rowan.from_axis_angle(
+                np.random.normal(size=(N, 3)), np.random.normal(scale=0.2, size=N)
+            ),
+        )
+
+        annealing = freud.order.Cubatic(5.0, 0.001, 0.95, 10, seed=0)
+        annealing.compute(orientations)
+        gradient = freud.order.Cubatic(
+            5.0, 0.001, 0.95, 10, seed=0, optimizer="gradient"
+        )
+        gradient.compute(orientations)
+        assert gradient.optimizer == "gradient"
+        assert gradient.order >= annealing.order - 1e-3
+        npt.assert_allclose(gradient.global_tensor, annealing.global_tensor)
+        npt.assert_allclose(
+            gradient.particle_order, annealing.particle_order, atol=1e-5
+        )
+
+        # The result only depends on the seed
+        order = gradient.order
+        orientation = gradient.orientation
+        gradient.compute(orientations)
+        npt.assert_allclose(gradient.order, order, rtol=1e-5)
+        npt.assert_allclose(gradient.orientation, orientation, atol=1e-5)
+
+        with pytest.raises(ValueError):
+            freud.order.Cubatic(5.0, 0.001, 0.95, 10, optimizer="newton")
+
     def test_repr(self):
         cubatic = freud.order.Cubatic(5.0, 0.001, 0.95, 10)
         assert str(cubatic) == str(eval(repr(cubatic)))
+        cubatic = freud.order.Cubatic(5.0, 0.001, 0.95, 10, optimizer="gradient")
+        assert str(cubatic) == str(eval(repr(cubatic)))
@@ -94,6 +94,26 @@ class TestNematicOrder:
         npt.assert_allclose(op_perp.nematic_tensor, np.diag([-0.5, 1, -0.5]), atol=1e-1)
         assert not np.all(op_perp.nematic_tensor == np.diag([-0.5, 1, -0.5]))
 
+    def test_no_particle_tensor(self):
+        """Test that the tensors do not depend on storing the per-particle tensors."""
+        np.random.seed(0)
+        orientations = rowan.normalize(np.random.rand(1000, 4))
+        u = np.array([1, 0, 0])
+        op = freud.order.Nematic(u)
+        op.compute(orientations)
+        particle_tensor = op.particle_tensor
+        nematic_tensor = op.nematic_tensor
+        order = op.order
+
+        op.compute(orientations, particle_tensor=False)
+        with pytest.raises(AttributeError):
+            op.particle_tensor
+        npt.assert_allclose(op.nematic_tensor, nematic_tensor, atol=1e-6)
+        npt.assert_allclose(op.order, order, atol=1e-6)
+        npt.assert_allclose(
+            op.nematic_tensor, np.mean(particle_tensor, axis=0), atol=1e-6
+        )
+
     def test_repr(self):
         u = np.array([1, 0, 0])
         op = freud.order.Nematic(u)
@@ -83,6 +83,43 @@ class TestRotationalAutocorrelation:
         npt.assert_allclose(ra2.compute(orientations, orientations).order, 1, rtol=1e-6)
         npt.assert_allclose(ra6.compute(orientations, orientations).order, 1, rtol=1e-6)
 
+    def test_compute_frames(self):
+        np.random.seed(0)
+        n_frames, N = 20, 50
+        steps = rowan.from_axis_angle(
+            np.random.normal(size=(n_frames, N, 3)),
+            np.random.normal(scale=0.1, size=(n_frames, N)),
+        )
+        orientations = np.empty((n_frames, N, 4))
+        orientations[0] = rowan.random.rand(N)
+        for i in range(1, n_frames):
+            orientations[i] = rowan.multiply(steps[i], orientations[i - 1])
+
+        # All lags are resolved exactly if the first level keeps every frame.
+        ra = freud.order.RotationalAutocorrelation(4)
+        ra.compute_frames(orientations, points_per_level=n_frames)
+        npt.assert_equal(ra.lags, np.arange(n_frames))
+        expected = [
+            np.mean(
+                [
+                    ra.compute(orientations[t - lag], orientations[t]).order
+                    for t in range(lag, n_frames)
+                ]
+            )
+            for lag in range(n_frames)
+        ]
+        npt.assert_allclose(ra.lag_order, expected, atol=1e-6)
+
+        # Chunks of the trajectory continue the previous frames.
+        ra_chunks = freud.order.RotationalAutocorrelation(4)
+        ra_chunks.compute_frames(orientations[:7], points_per_level=4)
+        ra_chunks.compute_frames(orientations[7:], reset=False)
+        ra_full = freud.order.RotationalAutocorrelation(4)
+        ra_full.compute_frames(orientations, points_per_level=4)
+        npt.assert_equal(ra_chunks.lags, ra_full.lags)
+        npt.assert_allclose(ra_chunks.lag_order, ra_full.lag_order, atol=1e-6)
+        assert ra_full.lags[-1] > 4
+
     def test_repr(self):
         ra2 = freud.order.RotationalAutocorrelation(2)
         assert str(ra2) == str(eval(repr(ra2)))
@@ -156,7 +193,7 @@ class TestRotationalAutocorrelationReference:
     """Test against a reference Python implementation."""
 
     @pytest.mark.parametrize(
-        "seed, l", [(seed, l) for seed in range(5) for l in [4, 6, 8]]
+        "seed, l", [(seed, l) for seed in range(5) for l in [4, 6, 8, 12, 16]]
     )
     def test_reference_implementation(self, seed, l):
         N = 100
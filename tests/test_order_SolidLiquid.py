@@ -74,6 +74,33 @@ class TestSolidLiquid:
             assert comp_default.cluster_sizes[0] == len(positions)
             npt.assert_array_equal(comp_default.num_connections, 12)
 
+    def test_compute_largest_cluster_sizes(self):
+        box, positions = freud.data.make_random_system(10, 1000, seed=0)
+        query_args = dict(r_max=2.0, exclude_ii=True)
+        q_thresholds = [0.2, 0.5, 0.5, 0.7]
+        solid_thresholds = [2, 2, 4, 1]
+
+        comp = freud.order.SolidLiquid(6, q_threshold=0.7, solid_threshold=6)
+        with pytest.raises(AttributeError):
+            comp.compute_largest_cluster_sizes(q_thresholds, solid_thresholds)
+        comp.compute((box, positions), neighbors=query_args)
+        sizes = comp.compute_largest_cluster_sizes(q_thresholds, solid_thresholds)
+
+        for q_threshold, solid_threshold, size in zip(
+            q_thresholds, solid_thresholds, sizes
+        ):
+            single = freud.order.SolidLiquid(
+                6, q_threshold=q_threshold, solid_threshold=solid_threshold
+            ).compute((box, positions), neighbors=query_args)
+            assert size == single.largest_cluster_size
+
+        # The thresholds of the object are unchanged.
+        npt.assert_allclose(comp.q_threshold, 0.7)
+        assert comp.solid_threshold == 6
+
+        with pytest.raises(ValueError):
+            comp.compute_largest_cluster_sizes([0.5, 0.7], [2])
+
     def test_nlist_lifetime(self):
         def _get_nlist(sys):
             sl = freud.order.SolidLiquid(2, 0.5, 0.2)
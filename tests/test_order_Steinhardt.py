@@ -188,6 +188,41 @@ class TestSteinhardt:
             npt.assert_allclose(comp.particle_order, comp.particle_order[0], atol=1e-5)
             assert abs(comp.order - PERFECT_FCC_W6) < 1e-5
 
+    def test_wl_particle_order_recomputed(self):
+        # The particle wl are computed on access, so they must follow the
+        # last compute even if they were read after an earlier one.
+        box, positions = freud.data.make_random_system(10, 100, seed=0)
+        _, other_positions = freud.data.make_random_system(10, 100, seed=1)
+        neighbors = {"num_neighbors": 12, "exclude_ii": True}
+        comp = freud.order.Steinhardt(6, wl=True)
+        comp.compute((box, positions), neighbors=neighbors)
+        first_order = np.copy(comp.particle_order)
+        comp.compute((box, other_positions), neighbors=neighbors)
+        expected = freud.order.Steinhardt(6, wl=True)
+        expected.compute((box, other_positions), neighbors=neighbors)
+        npt.assert_allclose(comp.particle_order, expected.particle_order)
+        assert not np.allclose(comp.particle_order, first_order)
+
+    def test_wl_high_l_rotation_invariant(self):
+        # Wigner 3j coefficients are computed for any l, not only up to 20.
+        box = freud.box.Box.cube(100)
+        # The twelve nearest neighbors of a particle in an fcc crystal
+        shell = np.array(
+            [np.roll([a, b, 0], i) for i in range(3) for a in (-1, 1) for b in (-1, 1)],
+            dtype=np.float32,
+        ) / np.sqrt(2)
+        shell = np.concatenate([[[0, 0, 0]], shell])
+        rotated = rowan.rotate(rowan.random.rand(1), shell).astype(np.float32)
+        neighbors = {"r_max": 1.1, "exclude_ii": True}
+        for l in [22, 24, 32]:
+            comp = freud.order.Steinhardt(l, wl=True, wl_normalize=True)
+            order = comp.compute((box, shell), neighbors=neighbors).particle_order[0]
+            rotated_order = comp.compute(
+                (box, rotated), neighbors=neighbors
+            ).particle_order[0]
+            assert np.isfinite(order)
+            npt.assert_allclose(rotated_order, order, atol=1e-4)
+
     def test_identical_environments_wl_near(self):
         box, positions = freud.data.UnitCell.fcc().generate_system(4)
         r_max = 1.5
@@ -367,6 +402,26 @@ class TestSteinhardt:
         assert np.all(np.isnan(comp.particle_order))
         npt.assert_allclose(np.nan_to_num(comp.particle_order), 0)
 
+    def test_half_list(self):
+        """Half neighbor lists are rejected, since each particle needs every
+        neighbor."""
+        box, positions = freud.data.make_random_system(10, 100, seed=0)
+        half_args = {"r_max": 1.5, "exclude_ii": True, "half_list": True}
+        comp = freud.order.Steinhardt(6)
+        with pytest.raises(ValueError):
+            comp.compute((box, positions), neighbors=half_args)
+        nlist = (
+            freud.locality.AABBQuery(box, positions)
+            .query(positions, half_args)
+            .toNeighborList()
+        )
+        with pytest.raises(ValueError):
+            comp.compute((box, positions), neighbors=nlist)
+        with pytest.raises(ValueError):
+            freud.density.LocalDensity(1.5, 1).compute(
+                (box, positions), neighbors=half_args
+            )
+
     def test_multiple_l(self):
         """Test the raw calculated qlmi."""
         special = pytest.importorskip("scipy.special")
@@ -416,3 +471,41 @@ class TestSteinhardt:
             np.allclose(comp.particle_harmonics[i], qlmis[i], atol=atol)
             for i in range(len(sph_l))
         )
+        # The harmonics of each l are returned as C-contiguous arrays even
+        # though they are stored interleaved per particle.
+        assert all(qlm.flags["C_CONTIGUOUS"] for qlm in comp.particle_harmonics)
+
+    @pytest.mark.parametrize("average", [False, True])
+    def test_compute_systems(self, average):
+        """Test that a batch of systems equals computing each system."""
+        systems = [
+            freud.data.make_random_system(6 + i, n, seed=i)
+            for i, n in enumerate([30, 0, 45, 20])
+        ]
+        offsets = np.cumsum([0] + [len(points) for _, points in systems])
+        batch = freud.locality.SystemBatch(
+            [box for box, _ in systems],
+            np.concatenate([points for _, points in systems]),
+            offsets,
+        )
+        neighbors = dict(num_neighbors=6)
+        comp = freud.order.Steinhardt([4, 6], average=average, wl=True)
+        comp.compute_systems(batch, neighbors)
+        particle_order = np.array(comp.particle_order)
+        ql = np.array(comp.ql)
+        system_order = np.array(comp.system_order)
+        assert system_order.shape == (4, 2)
+        assert particle_order.shape == (offsets[-1], 2)
+
+        for i, system in enumerate(systems):
+            if len(system[1]) == 0:
+                assert np.all(np.isnan(system_order[i]))
+                continue
+            comp.compute(system, neighbors)
+            points = slice(offsets[i], offsets[i + 1])
+            npt.assert_allclose(particle_order[points], comp.particle_order, atol=1e-5)
+            npt.assert_allclose(ql[points], comp.ql, atol=1e-5)
+            npt.assert_allclose(system_order[i], comp.order, atol=1e-5)
+
+        with pytest.raises(ValueError):
+            comp.compute_systems(batch, batch.query(neighbors))
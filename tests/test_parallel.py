@@ -1,6 +1,12 @@
 # Copyright (c) 2010-2023 The Regents of the University of Michigan
 # This file is from the freud project, released under the BSD 3-Clause License.
 
+import concurrent.futures
+
+import numpy as np
+import numpy.testing as npt
+import pytest
+
 import freud
 
 
@@ -10,9 +16,16 @@ class TestParallel:
     # The setup and teardown ensure that these tests don't affect others.
     def setup_method(self):
         freud.parallel.set_num_threads(0)
+        freud.parallel.set_deterministic_reductions(False)
 
     def teardown_method(self):
         freud.parallel.set_num_threads(0)
+        freud.parallel.set_deterministic_reductions(False)
+        freud.parallel.set_grain_tuning()
+        freud.parallel.set_accumulator_precision()
+        freud.parallel.set_instrumentation(False)
+        freud.parallel.reset_phase_statistics()
+        freud.parallel.set_memory_budget()
 
     def test_set(self):
         """Test setting the number of threads."""
@@ -33,3 +46,291 @@ class TestParallel:
         # After the context manager, the number of threads should revert
         # to its previous value.
         assert freud.parallel.get_num_threads() == 1
+
+    def test_set_deterministic_reductions(self):
+        """Test enabling deterministic reductions."""
+        assert not freud.parallel.get_deterministic_reductions()
+        freud.parallel.set_deterministic_reductions()
+        assert freud.parallel.get_deterministic_reductions()
+        freud.parallel.set_deterministic_reductions(False)
+        assert not freud.parallel.get_deterministic_reductions()
+
+    def test_deterministic_reductions(self):
+        """Test that sums do not depend on the number of threads."""
+        freud.parallel.set_deterministic_reductions()
+        box, points = freud.data.make_random_system(10, 2000, seed=0)
+        orientations = np.random.default_rng(0).normal(size=(len(points), 4))
+        orientations /= np.linalg.norm(orientations, axis=1)[:, np.newaxis]
+        results = []
+        for num_threads in [1, 2, 5]:
+            with freud.parallel.NumThreads(num_threads):
+                ql = freud.order.Steinhardt(6, average=True)
+                ql.compute((box, points), {"num_neighbors": 12})
+                nematic = freud.order.Nematic([1, 0, 0])
+                nematic.compute(orientations)
+                results.append((ql.order, nematic.nematic_tensor))
+        for ql_order, nematic_tensor in results[1:]:
+            npt.assert_array_equal(ql_order, results[0][0])
+            npt.assert_array_equal(nematic_tensor, results[0][1])
+
+    def test_set_accumulator_precision(self):
+        """Test setting the precision of sums."""
+        assert freud.parallel.get_accumulator_precision() == "automatic"
+        for precision in ["single", "mixed", "automatic"]:
+            freud.parallel.set_accumulator_precision(precision)
+            assert freud.parallel.get_accumulator_precision() == precision
+        with pytest.raises(ValueError):
+            freud.parallel.set_accumulator_precision("double")
+
+    def test_accumulator_precision(self):
+        """Test that sums in all precisions agree."""
+        box, points = freud.data.make_random_system(10, 2000, seed=0)
+        results = []
+        for precision in ["automatic", "single", "mixed"]:
+            freud.parallel.set_accumulator_precision(precision)
+            rdf = freud.density.RDF(bins=50, r_max=4)
+            rdf.compute((box, points))
+            ql = freud.order.Steinhardt(6, average=True)
+            ql.compute((box, points), {"num_neighbors": 12})
+            sf = freud.diffraction.StaticStructureFactorDebye(20, 10, 1)
+            sf.compute((box, points))
+            results.append((rdf.rdf, ql.order, sf.S_k))
+        for rdf, ql_order, S_k in results[1:]:
+            npt.assert_allclose(rdf, results[0][0], rtol=1e-5, atol=1e-6)
+            npt.assert_allclose(ql_order, results[0][1], rtol=1e-5)
+            npt.assert_allclose(S_k, results[0][2], rtol=1e-3, atol=1e-3)
+
+    def test_ThreadArena(self):
+        """Test that computes in thread arenas match computes without them."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        rdf = freud.density.RDF(bins=50, r_max=4)
+        rdf.compute((box, points))
+        expected = rdf.rdf.copy()
+        with freud.parallel.ThreadArena(2):
+            with freud.parallel.ThreadArena(1, max_threads_per_core=1):
+                rdf.compute((box, points))
+                npt.assert_allclose(rdf.rdf, expected, rtol=1e-6)
+            rdf.compute((box, points))
+            npt.assert_allclose(rdf.rdf, expected, rtol=1e-6)
+
+    def test_ThreadArena_concurrent(self):
+        """Test computes running concurrently in separate thread arenas."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        expected = freud.density.RDF(bins=50, r_max=4).compute((box, points)).rdf
+
+        def compute_rdf(numa_node):
+            with freud.parallel.ThreadArena(2, numa_node=numa_node):
+                rdf = freud.density.RDF(bins=50, r_max=4)
+                return rdf.compute((box, points)).rdf
+
+        numa_nodes = freud.parallel.get_numa_nodes()
+        if numa_nodes == [-1]:
+            numa_nodes = [None]
+        with concurrent.futures.ThreadPoolExecutor(4) as executor:
+            results = list(executor.map(compute_rdf, numa_nodes * 4))
+        for result in results:
+            npt.assert_allclose(result, expected, rtol=1e-6)
+
+    def test_concurrent_computes(self):
+        """Test computes called concurrently from several Python threads."""
+        box, points = freud.data.make_random_system(10, 1000, seed=0)
+        aq = freud.locality.AABBQuery(box, points)
+        nlist = aq.query(points, dict(r_max=2, exclude_ii=True)).toNeighborList()
+        expected_rdf = freud.density.RDF(bins=50, r_max=4).compute(aq).rdf
+        expected_ql = freud.order.Steinhardt(6).compute(aq, nlist).particle_order
+
+        # Different objects share the same neighbor query and neighbor list.
+        def compute(i):
+            if i % 2:
+                return freud.density.RDF(bins=50, r_max=4).compute(aq).rdf
+            return freud.order.Steinhardt(6).compute(aq, nlist).particle_order
+
+        with concurrent.futures.ThreadPoolExecutor(4) as executor:
+            results = list(executor.map(compute, range(8)))
+        for i, result in enumerate(results):
+            expected = expected_rdf if i % 2 else expected_ql
+            npt.assert_allclose(result, expected, rtol=1e-5)
+
+        # The segments and counts of a neighbor list built from arrays are
+        # computed lazily by the first of the threads using it.
+        for _ in range(4):
+            lazy_nlist = freud.locality.NeighborList.from_arrays(
+                len(points),
+                len(points),
+                nlist.query_point_indices,
+                nlist.point_indices,
+                nlist.distances,
+            )
+
+            def compute_lazy(i, lazy_nlist=lazy_nlist):
+                ql = freud.order.Steinhardt(6)
+                return ql.compute(aq, lazy_nlist).particle_order
+
+            with concurrent.futures.ThreadPoolExecutor(4) as executor:
+                results = list(executor.map(compute_lazy, range(4)))
+            for result in results:
+                npt.assert_allclose(result, expected_ql, rtol=1e-5)
+
+        # Calls on the same object are serialized.
+        rdf = freud.density.RDF(bins=50, r_max=4)
+
+        def accumulate(i):
+            rdf.compute(aq, reset=False)
+
+        with concurrent.futures.ThreadPoolExecutor(4) as executor:
+            list(executor.map(accumulate, range(8)))
+        npt.assert_allclose(rdf.rdf, expected_rdf, rtol=1e-5)
+
+    def test_concurrent_compute_systems(self):
+        """Test that batch computes on the same object are serialized."""
+        systems = [
+            freud.data.make_random_system(8, 50, seed=i) for i in range(4)
+        ]
+        batch = freud.locality.SystemBatch(
+            [box for box, _ in systems],
+            np.concatenate([points for _, points in systems]),
+            np.arange(0, 201, 50),
+        )
+        expected = freud.density.RDF(bins=50, r_max=3)
+        for i in range(8):
+            expected.compute_systems(batch, reset=i == 0)
+        ql = freud.order.Steinhardt(6)
+        expected_ql = ql.compute_systems(batch, dict(r_max=2)).particle_order
+
+        rdf = freud.density.RDF(bins=50, r_max=3)
+
+        def compute(i):
+            rdf.compute_systems(batch, reset=False)
+            return ql.compute_systems(batch, dict(r_max=2)).particle_order
+
+        with concurrent.futures.ThreadPoolExecutor(4) as executor:
+            results = list(executor.map(compute, range(8)))
+        npt.assert_allclose(rdf.rdf, expected.rdf, rtol=1e-5)
+        for result in results:
+            npt.assert_allclose(result, expected_ql, rtol=1e-5)
+
+    def test_ThreadArena_invalid(self):
+        """Test that invalid arenas raise errors."""
+        with pytest.raises(ValueError):
+            freud.parallel.ThreadArena(0)
+        with pytest.raises(ValueError):
+            with freud.parallel.ThreadArena(2, numa_node=1 << 20):
+                pass
+
+    def test_grain_sizes(self):
+        """Test tuning, saving and restoring the grain sizes of loops."""
+        freud.parallel.set_grain_sizes([])
+        assert freud.parallel.get_grain_tuning()
+        box = freud.box.Box.cube(10)
+        points = np.random.default_rng(0).uniform(-20, 20, size=(2**14, 3))
+        expected = box.wrap(points)
+        for _ in range(100):
+            npt.assert_array_equal(box.wrap(points), expected)
+        grain_sizes = freud.parallel.get_grain_sizes()
+        assert any(
+            grain_size["loop"] == "Box::wrap" and grain_size["log2_size"] == 14
+            for grain_size in grain_sizes
+        )
+
+        freud.parallel.set_grain_sizes([])
+        assert freud.parallel.get_grain_sizes() == []
+        freud.parallel.set_grain_sizes(grain_sizes)
+        assert freud.parallel.get_grain_sizes() == grain_sizes
+
+        freud.parallel.set_grain_tuning(False)
+        assert not freud.parallel.get_grain_tuning()
+        freud.parallel.set_grain_tuning()
+        invalid = dict(loop="Box::wrap", log2_size=14, concurrency=1, grain_size=0)
+        with pytest.raises(ValueError):
+            freud.parallel.set_grain_sizes([invalid])
+
+    def test_set_instrumentation(self):
+        """Test enabling and disabling the timers of phases."""
+        assert not freud.parallel.get_instrumentation()
+        freud.parallel.set_instrumentation()
+        assert freud.parallel.get_instrumentation()
+        freud.parallel.set_instrumentation(False)
+        assert not freud.parallel.get_instrumentation()
+
+    def test_PhaseTimers(self):
+        """Test the statistics of the phases of computes."""
+        box, points = freud.data.make_random_system(10, 200, seed=0)
+        rdf = freud.density.RDF(10, 3)
+        rdf.compute((box, points), neighbors=dict(r_max=3, exclude_ii=True))
+        assert freud.parallel.get_phase_statistics() == []
+
+        with freud.parallel.PhaseTimers() as timers:
+            rdf.compute((box, points), neighbors=dict(r_max=3, exclude_ii=True))
+            # The histogram of an RDF is reduced when it is first accessed.
+            assert np.all(rdf.rdf >= 0)
+            nlist = (
+                freud.locality.AABBQuery(box, points)
+                .query(points, dict(num_neighbors=6, exclude_ii=True))
+                .toNeighborList()
+            )
+        assert not freud.parallel.get_instrumentation()
+        phases = {phase["phase"]: phase for phase in timers.statistics}
+        assert phases["RDF::accumulate"]["calls"] == 1
+        assert phases["RDF::accumulate"]["seconds"] > 0
+        assert phases["RDF::accumulate/loopOverNeighbors"]["bonds"] > 0
+        assert phases["RDF::reduce/reduceOverThreads"]["calls"] == 1
+        assert phases["NeighborQuery::query"]["bonds"] == len(nlist)
+
+        freud.parallel.reset_phase_statistics()
+        assert freud.parallel.get_phase_statistics() == []
+
+    def test_memory_usage(self):
+        """Test the attribution of the memory of arrays to their owners."""
+        box, points = freud.data.make_random_system(10, 200, seed=0)
+        orientations = np.zeros(len(points))
+        freud.parallel.reset_peak_memory()
+        pmft = freud.pmft.PMFTXY(3, 3, 100)
+        pmft.compute((box, points), orientations, neighbors=dict(r_max=3))
+        nlist = (
+            freud.locality.AABBQuery(box, points)
+            .query(points, dict(num_neighbors=6, exclude_ii=True))
+            .toNeighborList()
+        )
+        assert np.all(np.isfinite(pmft.pmft))
+        usages = {usage["owner"]: usage for usage in freud.parallel.get_memory_usage()}
+        # The bin counts and the PCF of the PMFT are 100 x 100 bins.
+        assert usages["PMFT"]["current"] >= 2 * 100 * 100 * 4
+        assert usages["PMFT"]["peak"] >= usages["PMFT"]["current"]
+        assert usages["NeighborList"]["current"] >= len(nlist) * 4 * 4
+        current, peak = freud.parallel.get_bytes_in_use()
+        assert peak >= current >= usages["PMFT"]["current"]
+
+        pmft_bytes = usages["PMFT"]["current"]
+        del pmft
+        usages = {usage["owner"]: usage for usage in freud.parallel.get_memory_usage()}
+        assert usages["PMFT"]["current"] < pmft_bytes
+        freud.parallel.reset_peak_memory()
+        usages = {usage["owner"]: usage for usage in freud.parallel.get_memory_usage()}
+        assert usages["PMFT"]["peak"] == usages["PMFT"]["current"]
+
+    def test_memory_budget(self):
+        """Test that computes within a memory budget give the same results."""
+        box, points = freud.data.make_random_system(10, 200, seed=0)
+        orientations = np.zeros(len(points))
+        pmft = freud.pmft.PMFTXY(3, 3, 200)
+        pmft.compute((box, points), orientations, neighbors=dict(r_max=3))
+        expected = np.array(pmft.bin_counts)
+        del pmft
+
+        # The budget fits the bin counts, the PCF and a single thread local
+        # copy of the bin counts of the PMFT, with some room for the rounding
+        # of the sizes of arrays.
+        current, _ = freud.parallel.get_bytes_in_use()
+        budget = current + 7 * 200 * 200 * 2
+        freud.parallel.set_memory_budget(budget)
+        assert freud.parallel.get_memory_budget() == budget
+        pmft = freud.pmft.PMFTXY(3, 3, 200)
+        pmft.compute((box, points), orientations, neighbors=dict(r_max=3))
+        npt.assert_array_equal(pmft.bin_counts, expected)
+        del pmft
+
+        freud.parallel.set_memory_budget(current + 1)
+        with pytest.raises(MemoryError):
+            freud.pmft.PMFTXY(3, 3, 200)
+        with pytest.raises(ValueError):
+            freud.parallel.set_memory_budget(-1)
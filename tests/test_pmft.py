@@ -270,6 +270,27 @@ class TestPMFTR12(PMFT2DTestBase):
             assert np.count_nonzero(np.isinf(pmft.pmft) == 0) == 12
             assert len(np.unique(pmft.pmft)) == 3
 
+    def test_sparse(self):
+        box, points = freud.data.make_random_system(self.L, 200, is2D=True, seed=1)
+        angles = np.random.default_rng(1).random(len(points)) * 2 * np.pi
+        dense = freud.pmft.PMFTR12(*self.limits, bins=self.bins)
+        sparse = freud.pmft.PMFTR12(*self.limits, bins=self.bins, sparse=True)
+        for pmft in (dense, sparse):
+            pmft.compute((box, points), angles)
+            pmft.compute((box, points), angles, reset=False)
+        assert sparse.sparse and not dense.sparse
+
+        occupied = np.nonzero(dense.bin_counts)
+        npt.assert_equal(sparse.sparse_bins, np.transpose(occupied))
+        npt.assert_equal(sparse.sparse_bin_counts, dense.bin_counts[occupied])
+        npt.assert_allclose(sparse.sparse_pmft, dense.pmft[occupied], rtol=1e-6)
+        with pytest.raises(ValueError):
+            sparse.bin_counts
+        with pytest.raises(ValueError):
+            sparse.pmft
+        with pytest.raises(ValueError):
+            dense.sparse_bins
+
 
 class TestPMFTXYT(PMFT2DTestBase):
     limits = (3.6, 4.2)
@@ -925,6 +946,27 @@ class TestPMFTXYZ(PMFTTestBase):
         )
         npt.assert_array_equal(points_to_set(pmft.bin_counts), bins)
 
+    def test_sparse(self):
+        box, points = freud.data.make_random_system(self.L, 200, seed=1)
+        orientations = rowan.random.rand(len(points))
+        equiv_orientations = rowan.from_axis_angle([0, 0, 1], [0, np.pi / 2])
+        dense = freud.pmft.PMFTXYZ(*self.limits, bins=self.bins)
+        sparse = freud.pmft.PMFTXYZ(*self.limits, bins=self.bins, sparse=True)
+        for pmft in (dense, sparse):
+            pmft.compute(
+                (box, points), orientations, equiv_orientations=equiv_orientations
+            )
+        assert sparse.sparse and not dense.sparse
+
+        occupied = np.nonzero(dense.bin_counts)
+        npt.assert_equal(sparse.sparse_bins, np.transpose(occupied))
+        npt.assert_equal(sparse.sparse_bin_counts, dense.bin_counts[occupied])
+        npt.assert_allclose(sparse.sparse_pmft, dense.pmft[occupied], rtol=1e-6)
+        with pytest.raises(ValueError):
+            sparse.bin_counts
+        with pytest.raises(ValueError):
+            sparse.pmft
+
 
 class TestPMFTR12ManagedArray(ManagedArrayTestBase):
     def build_object(self):
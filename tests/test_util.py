@@ -120,3 +120,63 @@ class TestCommon:
         npt.assert_allclose(box.xz, 5, rtol=1e-6, err_msg="TiltXZFail")
         npt.assert_allclose(box.yz, 6, rtol=1e-6, err_msg="TiltYZFail")
         assert box.dimensions == 3
+
+    def test_exported_arrays_reused(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        rdf = freud.density.RDF(50, 3).compute((box, points))
+        rdf_values = rdf.rdf
+        # The array is reused until the data changes.
+        assert rdf.rdf is rdf_values
+        expected = np.copy(rdf_values)
+        rdf.compute((box, points[:50]))
+        assert rdf.rdf is not rdf_values
+        npt.assert_array_equal(rdf_values, expected)
+
+    @pytest.mark.parametrize("keep_reference", [True, False])
+    def test_exported_arrays_not_reused_after_compute(self, keep_reference):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        rdf = freud.density.RDF(50, 3).compute((box, points))
+        rdf_values = rdf.rdf
+        before = np.copy(rdf_values)
+        if not keep_reference:
+            del rdf_values
+
+        # Neither a new system nor an accumulated frame may return the array
+        # exported before the compute, whose data would then be stale.
+        expected = freud.density.RDF(50, 3).compute((box, points[:50])).rdf
+        rdf.compute((box, points[:50]))
+        npt.assert_array_equal(rdf.rdf, expected)
+        assert not np.array_equal(rdf.rdf, before)
+        accumulated = rdf.rdf
+        rdf.compute((box, points), reset=False)
+        assert rdf.rdf is not accumulated
+        assert not np.array_equal(rdf.rdf, expected)
+        if keep_reference:
+            npt.assert_array_equal(rdf_values, before)
+
+    def test_export_array_buffer(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        rdf = freud.density.RDF(50, 3).compute((box, points))
+        view = memoryview(freud.util.export_array(rdf.bin_counts))
+        assert view.readonly
+        assert view.format == "I"
+        npt.assert_array_equal(np.asarray(view), rdf.bin_counts)
+
+    def test_export_array_dlpack(self):
+        if not hasattr(np, "from_dlpack"):
+            pytest.skip("NumPy does not support DLPack.")
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        ld = freud.environment.LocalDescriptors(4).compute(
+            (box, points), neighbors=dict(num_neighbors=4)
+        )
+        sph = np.from_dlpack(freud.util.export_array(ld.sph))
+        assert np.shares_memory(sph, ld.sph)
+        npt.assert_array_equal(sph, ld.sph)
+
+    def test_export_array_invalid(self):
+        box, points = freud.data.make_random_system(10, 100, seed=0)
+        rdf = freud.density.RDF(50, 3).compute((box, points))
+        with pytest.raises(ValueError):
+            freud.util.export_array(rdf.rdf[1:])
+        with pytest.raises(ValueError):
+            freud.util.export_array(np.copy(rdf.rdf))